@@ -0,0 +1,58 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_GraphicsObjectPool.inl
+	Inline definitions for generational graphics object pool.
+*/
+
+#ifdef __ANIMAL3D_GRAPHICSOBJECTPOOL_H
+#ifndef __ANIMAL3D_GRAPHICSOBJECTPOOL_INL
+#define __ANIMAL3D_GRAPHICSOBJECTPOOL_INL
+
+
+//-----------------------------------------------------------------------------
+
+A3_INLINE a3ret a3graphicsPoolValidate(const a3_GraphicsObjectPool *pool, const a3_GraphicsPoolHandle handle)
+{
+	if (pool)
+	{
+		const a3ui32 type = (handle >> a3pool_typeShift) & a3pool_typeMask;
+		const a3ui32 index = handle & a3pool_indexMask;
+		const a3ui32 generation = (handle >> a3pool_generationShift) & a3pool_generationMask;
+		const a3_GraphicsObjectTable *table = pool->table + type;
+		return (handle && type < a3pool_typeMax && index < table->capacity &&
+			table->generation[index] == generation && table->name[index]);
+	}
+	return -1;
+}
+
+A3_INLINE a3ui32 a3graphicsPoolGetName(const a3_GraphicsObjectPool *pool, const a3_GraphicsPoolHandle handle)
+{
+	if (a3graphicsPoolValidate(pool, handle) > 0)
+		return pool->table[handle >> a3pool_typeShift].name[handle & a3pool_indexMask];
+	return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+#endif	// !__ANIMAL3D_GRAPHICSOBJECTPOOL_INL
+#endif	// __ANIMAL3D_GRAPHICSOBJECTPOOL_H
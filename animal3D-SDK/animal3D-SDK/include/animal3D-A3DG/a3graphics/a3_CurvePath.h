@@ -0,0 +1,151 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_CurvePath.h
+	Arc-length tables for closed curves: lengths are integrated once when 
+		the curve changes, then inverted into a table of parameters at 
+		uniform distances, so moving along the curve at constant speed is 
+		a table lookup instead of an integration per query.
+*/
+
+#ifndef __ANIMAL3D_CURVEPATH_H
+#define __ANIMAL3D_CURVEPATH_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+#include "animal3D-A3DG/a3graphics/a3_CurveTessellation.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_CurvePath				a3_CurvePath;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Curve path table resolution.
+	//	a3curvePath_samplesPerSegment: length samples per segment; each 
+	//		interval between samples is integrated with 3-point 
+	//		Gauss-Legendre quadrature
+	enum a3_CurvePathLimits
+	{
+		a3curvePath_samplesPerSegment = 64,
+	};
+
+
+	// A3: Arc-length parameterized closed curve. The global parameter of a 
+	//		point is its segment index plus its local parameter in [0, 1).
+	//	member control: cubic Bezier control points of each segment
+	//	member arcLength: distance from the start of the curve at uniform 
+	//		parameter steps; sampleCount + 1 entries
+	//	member param: global parameter at uniform distance steps; 
+	//		sampleCount + 1 entries
+	//	member paramSlope: change in param over one distance step at each 
+	//		entry; sampleCount + 1 entries
+	//	member length: total length of curve
+	//	member sampleStep: distance between entries of param
+	//	member sampleStepInv: reciprocal of sampleStep
+	//	member segmentCount: number of segments in use
+	//	member segmentCapacity: maximum number of segments
+	//	member sampleCount: number of intervals in both tables
+	//	member type: segment type used to build the controls
+	struct a3_CurvePath
+	{
+		a3f32(*control)[4][4];
+		a3f32 *arcLength;
+		a3f32 *param;
+		a3f32 *paramSlope;
+		a3f32 length;
+		a3f32 sampleStep, sampleStepInv;
+		a3ui32 segmentCount, segmentCapacity;
+		a3ui32 sampleCount;
+		a3_CurveSegmentType type;
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Allocate curve path tables.
+	//	param path_out: non-null pointer to uninitialized curve path
+	//	param segmentCapacity: non-zero maximum number of segments
+	//	return: 1 if success
+	//	return: 0 if allocation failed
+	//	return: -1 if invalid params or already initialized
+	a3ret a3curvePathCreate(a3_CurvePath *path_out, const a3ui32 segmentCapacity);
+
+	// A3: Rebuild controls and tables from waypoints; only needed when the 
+	//		waypoints, handles or segment type change.
+	//	param path: non-null pointer to initialized curve path
+	//	param waypoint, handle, count, type: see a3curveSegmentControl; 
+	//		count is clamped to capacity
+	//	return: number of segments if success
+	//	return: -1 if invalid params or not initialized
+	a3ret a3curvePathUpdate(a3_CurvePath *path, const a3f32 waypoint[][4], const a3f32 handle[][4], const a3ui32 count, const a3_CurveSegmentType type);
+
+	// A3: Release curve path tables.
+	//	param path: non-null pointer to initialized curve path
+	//	return: 1 if success
+	//	return: -1 if invalid params or not initialized
+	a3ret a3curvePathRelease(a3_CurvePath *path);
+
+
+	// A3: Global parameter at a distance along the curve by direct lookup 
+	//		in the uniform-distance table; constant time.
+	//	param path: non-null pointer to updated curve path
+	//	param distance: distance from start; wraps around the closed curve
+	//	return: global parameter in [0, segmentCount)
+	a3f32 a3curvePathParam(const a3_CurvePath *path, const a3f32 distance);
+
+	// A3: Global parameter at a distance along the curve by binary search 
+	//		in the arc-length table; slower but exact at every sample.
+	//	param path: non-null pointer to updated curve path
+	//	param distance: distance from start; wraps around the closed curve
+	//	return: global parameter in [0, segmentCount)
+	a3f32 a3curvePathParamBinary(const a3_CurvePath *path, const a3f32 distance);
+
+	// A3: Evaluate many points at given distances along the curve; meant 
+	//		for followers moving at constant speed. Any contiguous slice of 
+	//		the arrays may be evaluated independently of the rest.
+	//	param position_out: non-null array of count positions (xyz written, 
+	//		w set to one)
+	//	param tangent_out_opt: optional array of count unit tangents (xyz 
+	//		written, w set to zero)
+	//	param path: non-null pointer to updated curve path
+	//	param distance: non-null array of count distances; each wraps
+	//	param count: number of points
+	//	return: count if success
+	//	return: -1 if invalid params or path is empty
+	a3ret a3curvePathEvaluate(a3f32 position_out[][4], a3f32 tangent_out_opt[][4], const a3_CurvePath *path, const a3f32 distance[], const a3ui32 count);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_CURVEPATH_H
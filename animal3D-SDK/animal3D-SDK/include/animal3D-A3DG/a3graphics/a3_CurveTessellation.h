@@ -0,0 +1,189 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_CurveTessellation.h
+	Adaptive curve tessellation: every segment is converted to a cubic 
+		Bezier and split into as many lines as its projected length needs. 
+		Hardware tessellation stages do this per patch on the GPU; the CPU 
+		fallback uses the same math and writes lines into a dynamic vertex 
+		buffer.
+*/
+
+#ifndef __ANIMAL3D_CURVETESSELLATION_H
+#define __ANIMAL3D_CURVETESSELLATION_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+#include "animal3D-A3DG/a3graphics/a3_VertexDrawable.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef enum a3_CurveSegmentType		a3_CurveSegmentType;
+	typedef struct a3_CurveTessellation		a3_CurveTessellation;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Curve tessellation limits; the tessellation control shader must 
+	//		use the same values so both paths produce the same lines.
+	//	a3curveTess_levelMax: most lines per segment (minimum GL limit)
+	//	a3curveTess_pixelsPerLevel: target on-screen length of one line
+	enum a3_CurveTessellationLimits
+	{
+		a3curveTess_levelMax = 64,
+		a3curveTess_pixelsPerLevel = 8,
+	};
+
+
+	// A3: How a segment is built from the waypoints around it; matches the 
+	//		order of the curve interpolation functions in the math library.
+	//	a3curve_linear: straight line between waypoints
+	//	a3curve_bezier: waypoints i, i+1, i+2 and i-1 are control points
+	//	a3curve_catmullRom: waypoints i-1 and i+2 shape the tangents
+	//	a3curve_cubicHermite: handles are tangent control points
+	enum a3_CurveSegmentType
+	{
+		a3curve_linear,
+		a3curve_bezier,
+		a3curve_catmullRom,
+		a3curve_cubicHermite,
+	};
+
+
+	// A3: Dynamic line buffer for CPU-tessellated curves.
+	//	member vertexBuffer: vertex storage, rewritten every update
+	//	member vertexArray: position-only vertex format
+	//	member drawable: line list covering the whole buffer
+	//	member capacity: maximum number of vertices
+	//	member count: number of vertices written by last update
+	struct a3_CurveTessellation
+	{
+		a3_VertexBuffer vertexBuffer[1];
+		a3_VertexArrayDescriptor vertexArray[1];
+		a3_VertexDrawable drawable[1];
+		a3ui32 capacity;
+		a3ui32 count;
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Create curve tessellation buffer.
+	//	param tess_out: non-null pointer to uninitialized curve tessellation
+	//	param name_opt: optional cstring for short name/description; max 31 
+	//		chars + null terminator; pass null for default name
+	//	param segmentCapacity: non-zero maximum number of segments
+	//	return: 1 if success
+	//	return: 0 if creation failed
+	//	return: -1 if invalid params or already initialized
+	a3ret a3curveTessellationCreate(a3_CurveTessellation *tess_out, const a3byte name_opt[32], const a3ui32 segmentCapacity);
+
+	// A3: Check for hardware tessellation stages (GL 4.0).
+	//	return: 1 if supported
+	//	return: 0 if not supported
+	a3ret a3curveTessellationHardwareSupported();
+
+	// A3: Tessellate curve on the CPU and store the lines in the buffer.
+	//	param tess: non-null pointer to initialized curve tessellation
+	//	param waypoint: non-null array of count waypoints (xyz used)
+	//	param handle: non-null array of count handles (xyz used)
+	//	param count: number of waypoints, also number of segments (closed)
+	//	param type: segment type
+	//	param viewProjection: non-null column-major 4x4 matrix
+	//	param viewportWidth, viewportHeight: target size in pixels
+	//	return: number of vertices stored if success
+	//	return: -1 if invalid params or not initialized
+	a3ret a3curveTessellationUpdate(a3_CurveTessellation *tess, const a3f32 waypoint[][4], const a3f32 handle[][4], const a3ui32 count, const a3_CurveSegmentType type, const a3f32 *viewProjection, const a3f32 viewportWidth, const a3f32 viewportHeight);
+
+	// A3: Draw lines stored by the last update with the active program.
+	//	param tess: non-null pointer to initialized curve tessellation
+	//	return: 1 if success
+	//	return: -1 if invalid params or not initialized
+	a3ret a3curveTessellationRender(const a3_CurveTessellation *tess);
+
+	// A3: Draw one single-vertex patch per segment with the active program, 
+	//		which must have tessellation stages; the vertex shader gets the 
+	//		segment index as the instance index.
+	//	param tess: non-null pointer to initialized curve tessellation
+	//	param count: number of segments
+	//	return: 1 if success
+	//	return: 0 if hardware tessellation is not supported
+	//	return: -1 if invalid params or not initialized
+	a3ret a3curveTessellationRenderHardware(const a3_CurveTessellation *tess, const a3ui32 count);
+
+	// A3: Release curve tessellation buffer.
+	//	param tess: non-null pointer to initialized curve tessellation
+	//	return: 1 if success
+	//	return: -1 if invalid params or not initialized
+	a3ret a3curveTessellationRelease(a3_CurveTessellation *tess);
+
+	// A3: Update release callbacks of the buffer and array after hotload.
+	//	param tess: non-null pointer to curve tessellation
+	//	return: 1 if success
+	//	return: -1 if invalid params
+	a3ret a3curveTessellationHandleUpdateReleaseCallbacks(a3_CurveTessellation *tess);
+
+
+	// A3: Convert one segment of a closed curve to cubic Bezier form.
+	//	param control_out: non-null array of 4 control points (xyz written)
+	//	param waypoint: non-null array of count waypoints
+	//	param handle: non-null array of count handles
+	//	param count: non-zero number of waypoints
+	//	param index: segment index
+	//	param type: segment type
+	//	return: 1 if success
+	//	return: -1 if invalid params
+	a3ret a3curveSegmentControl(a3f32 control_out[4][4], const a3f32 waypoint[][4], const a3f32 handle[][4], const a3ui32 count, const a3ui32 index, const a3_CurveSegmentType type);
+
+	// A3: Number of lines a segment needs from its projected control hull; 
+	//		segments entirely outside one clip plane get none, and segments 
+	//		crossing the eye plane get the most.
+	//	param control: non-null array of 4 Bezier control points
+	//	param viewProjection: non-null column-major 4x4 matrix
+	//	param viewportWidth, viewportHeight: target size in pixels
+	//	return: lines for segment in [0, a3curveTess_levelMax]
+	a3ui32 a3curveSegmentLevel(const a3f32 control[4][4], const a3f32 *viewProjection, const a3f32 viewportWidth, const a3f32 viewportHeight);
+
+	// A3: Tessellate closed curve into a line list.
+	//	param vertex_out: non-null array of capacity xyz vertices
+	//	param capacity: size of array; segments that do not fit are skipped
+	//	param waypoint, handle, count, type: see a3curveSegmentControl
+	//	param viewProjection, viewportWidth, viewportHeight: see 
+	//		a3curveSegmentLevel
+	//	return: number of vertices written if success
+	//	return: -1 if invalid params
+	a3ret a3curveTessellate(a3f32 vertex_out[][3], const a3ui32 capacity, const a3f32 waypoint[][4], const a3f32 handle[][4], const a3ui32 count, const a3_CurveSegmentType type, const a3f32 *viewProjection, const a3f32 viewportWidth, const a3f32 viewportHeight);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_CURVETESSELLATION_H
@@ -0,0 +1,88 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_FramebufferMixed.h
+	Framebuffers whose color targets each have their own storage format, 
+		for packed g-buffers that mix narrow and wide targets. The result 
+		is a regular framebuffer: activate, bind and release it as usual.
+*/
+
+#ifndef __ANIMAL3D_FRAMEBUFFERMIXED_H
+#define __ANIMAL3D_FRAMEBUFFERMIXED_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D-A3DG/a3graphics/a3_Framebuffer.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef enum a3_FramebufferTargetType	a3_FramebufferTargetType;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Storage format of a single color target; all are renderable.
+	enum a3_FramebufferTargetType
+	{
+		a3fbo_targetRGBA8,				// 4 channels, 8 bits each (unorm)
+		a3fbo_targetRGB10A2,			// 3 channels, 10 bits each, 2-bit alpha
+		a3fbo_targetRGBA16,				// 4 channels, 16 bits each (unorm)
+		a3fbo_targetRGBA16F,			// 4 channels, 16 bits each (half)
+		a3fbo_targetRG8,				// 2 channels, 8 bits each (unorm)
+		a3fbo_targetRG16,				// 2 channels, 16 bits each (unorm)
+		a3fbo_targetRG16F,				// 2 channels, 16 bits each (half)
+		a3fbo_targetR32F,				// 1 channel, 32 bits (float)
+		a3fbo_targetR11G11B10F,			// 3 channels, packed unsigned float
+
+		a3fbo_target_max
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Create framebuffer with per-target color formats.
+	//	param framebuffer_out: non-null pointer to uninitialized framebuffer
+	//	param name_opt: optional cstring for short name/description; max 31 
+	//		chars + null terminator; pass null for default name
+	//	param colorTargets: number of color targets
+	//	param targetType: non-null array of colorTargets formats (relevant 
+	//		if colorTargets is not zero)
+	//	param depthType: depth type to use
+	//	params frameWidth, frameHeight: positive framebuffer dimensions
+	//	return: 1 if success
+	//	return: 0 if failed
+	//	return: -1 if invalid params (null pointer or already initialized)
+	a3ret a3framebufferCreateMixed(a3_Framebuffer *framebuffer_out, const a3byte name_opt[32], a3ui32 colorTargets, const a3_FramebufferTargetType *targetType, const a3_FramebufferDepthType depthType, const a3ui16 frameWidth, const a3ui16 frameHeight);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_FRAMEBUFFERMIXED_H
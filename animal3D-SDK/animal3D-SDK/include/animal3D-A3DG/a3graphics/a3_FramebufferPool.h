@@ -0,0 +1,177 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_FramebufferPool.h
+	Pool of transient framebuffers keyed by format and size. Targets are 
+		handed out per frame and returned after their last reader, so 
+		passes whose lifetimes do not overlap share the same memory.
+*/
+
+#ifndef __ANIMAL3D_FRAMEBUFFERPOOL_H
+#define __ANIMAL3D_FRAMEBUFFERPOOL_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D-A3DG/a3graphics/a3_Framebuffer.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_FramebufferPool			a3_FramebufferPool;
+	typedef struct a3_FramebufferPoolEntry		a3_FramebufferPoolEntry;
+	typedef struct a3_FramebufferPoolRequest	a3_FramebufferPoolRequest;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Maximum number of framebuffers held by a pool.
+	enum a3_FramebufferPoolMax
+	{
+		a3fbo_poolMax = 16
+	};
+
+
+	// A3: Description of a transient target needed by one pass.
+	//	member colorTargets, colorType, depthType: format of target
+	//	members frameWidth, frameHeight: size of target; zero if the pass 
+	//		does not need a pooled target
+	//	member lastUse: index of the last request that reads this target; 
+	//		negative to hold the target until the next frame
+	struct a3_FramebufferPoolRequest
+	{
+		a3ui32 colorTargets;
+		a3_FramebufferColorType colorType;
+		a3_FramebufferDepthType depthType;
+		a3ui16 frameWidth, frameHeight;
+		a3i32 lastUse;
+	};
+
+	// A3: Framebuffer owned by a pool.
+	//	member framebuffer: pooled framebuffer; uninitialized if slot is free
+	//	member colorTargets, colorType, depthType: format of framebuffer
+	//	member size: storage in bytes
+	//	member frameUsed: frame on which the framebuffer was last acquired
+	//	member inUse: non-zero if handed out this frame
+	struct a3_FramebufferPoolEntry
+	{
+		a3_Framebuffer framebuffer[1];
+		a3ui32 colorTargets;
+		a3_FramebufferColorType colorType;
+		a3_FramebufferDepthType depthType;
+		a3ui32 size;
+		a3ui32 frameUsed;
+		a3boolean inUse;
+	};
+
+	// A3: Pool of framebuffers; zero-initialized is a valid empty pool.
+	//	member entry: framebuffer slots
+	//	member frame: current frame index
+	//	member count: number of framebuffers allocated
+	//	member sizeAllocated: storage in bytes of all allocated framebuffers
+	//	member sizeRequested: storage in bytes the targets acquired this 
+	//		frame would need without aliasing
+	//	member sizeInUse, sizePeak: storage in bytes handed out now and at 
+	//		most at once this frame
+	struct a3_FramebufferPool
+	{
+		a3_FramebufferPoolEntry entry[a3fbo_poolMax];
+		a3ui32 frame, count;
+		a3ui32 sizeAllocated, sizeRequested, sizeInUse, sizePeak;
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Start a new frame; all framebuffers are returned to the pool.
+	//	param pool: non-null pointer to pool
+	//	return: new frame index if success
+	//	return: -1 if invalid params
+	a3ret a3framebufferPoolBeginFrame(a3_FramebufferPool *pool);
+
+	// A3: Acquire a framebuffer matching the requested format, reusing a 
+	//		returned one if possible or creating one otherwise.
+	//	param pool: non-null pointer to pool
+	//	param name_opt: optional cstring for short name/description of new 
+	//		framebuffers; max 31 chars + null terminator
+	//	param colorTargets, colorType, depthType: format of framebuffer
+	//	params frameWidth, frameHeight: positive framebuffer dimensions
+	//	return: pointer to framebuffer if success
+	//	return: null if invalid params, pool is full or creation failed
+	const a3_Framebuffer *a3framebufferPoolAcquire(a3_FramebufferPool *pool, const a3byte name_opt[32], const a3ui32 colorTargets, const a3_FramebufferColorType colorType, const a3_FramebufferDepthType depthType, const a3ui16 frameWidth, const a3ui16 frameHeight);
+
+	// A3: Return a framebuffer so later acquisitions this frame may alias it.
+	//	param pool: non-null pointer to pool
+	//	param framebuffer: non-null pointer to framebuffer acquired from pool
+	//	return: number of framebuffers still in use if success
+	//	return: -1 if invalid params or framebuffer is not in use
+	a3ret a3framebufferPoolReturn(a3_FramebufferPool *pool, const a3_Framebuffer *framebuffer);
+
+	// A3: Return all framebuffers acquired this frame.
+	//	param pool: non-null pointer to pool
+	//	return: number of framebuffers returned if success
+	//	return: -1 if invalid params
+	a3ret a3framebufferPoolReturnAll(a3_FramebufferPool *pool);
+
+	// A3: Acquire targets for a sequence of passes in order, returning each 
+	//		after its last reader so that later passes can alias it.
+	//	param pool: non-null pointer to pool
+	//	param framebuffer_out: non-null array of requestCount pointers; 
+	//		receives target per request, null if none was requested
+	//	param request: non-null array of requestCount requests
+	//	param requestCount: number of requests
+	//	param name_opt: optional cstring for short name/description of new 
+	//		framebuffers; max 31 chars + null terminator
+	//	return: number of targets acquired if success
+	//	return: -1 if invalid params or any acquisition failed
+	a3ret a3framebufferPoolAcquireSequence(a3_FramebufferPool *pool, const a3_Framebuffer *framebuffer_out[], const a3_FramebufferPoolRequest *request, const a3ui32 requestCount, const a3byte name_opt[32]);
+
+	// A3: Release framebuffers that have not been acquired recently.
+	//	param pool: non-null pointer to pool
+	//	param idleFrames: number of frames a framebuffer may go unused
+	//	return: number of framebuffers released if success
+	//	return: -1 if invalid params
+	a3ret a3framebufferPoolTrim(a3_FramebufferPool *pool, const a3ui32 idleFrames);
+
+	// A3: Release all framebuffers (e.g. when the window is resized).
+	//	param pool: non-null pointer to pool
+	//	return: number of framebuffers released if success
+	//	return: -1 if invalid params
+	a3ret a3framebufferPoolReleaseAll(a3_FramebufferPool *pool);
+
+	// A3: Update release functions of pooled framebuffers (hotload quick-fix).
+	//	param pool: non-null pointer to pool
+	//	return: number of framebuffers updated if success
+	//	return: -1 if invalid params
+	a3ret a3framebufferPoolHandleUpdateReleaseCallbacks(a3_FramebufferPool *pool);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_FRAMEBUFFERPOOL_H
@@ -0,0 +1,201 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_GraphicsObjectPool.h
+	Central table of graphics objects addressed by generational handles.
+		Each object type is stored densely in its own table; a handle packs
+		type, slot index and generation into 32 bits so that validation is a
+		single compare and stale handles are caught instead of resolving to
+		a freed or recycled object name.
+*/
+
+#ifndef __ANIMAL3D_GRAPHICSOBJECTPOOL_H
+#define __ANIMAL3D_GRAPHICSOBJECTPOOL_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D-A3DG/a3graphics/a3_GraphicsObjectHandle.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_GraphicsObjectPool		a3_GraphicsObjectPool;
+	typedef struct a3_GraphicsObjectTable		a3_GraphicsObjectTable;
+	typedef enum a3_GraphicsObjectType			a3_GraphicsObjectType;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Generational graphics object handle; zero is never valid.
+	//	bits  0-15: slot index in type table
+	//	bits 16-27: generation of slot when handle was issued
+	//	bits 28-31: object type
+	typedef a3ui32 a3_GraphicsPoolHandle;
+
+	// A3: Handle bit layout.
+	enum
+	{
+		a3pool_indexBits = 16,
+		a3pool_generationBits = 12,
+		a3pool_typeBits = 4,
+		a3pool_indexMask = (1 << a3pool_indexBits) - 1,
+		a3pool_generationMask = (1 << a3pool_generationBits) - 1,
+		a3pool_typeMask = (1 << a3pool_typeBits) - 1,
+		a3pool_generationShift = a3pool_indexBits,
+		a3pool_typeShift = a3pool_indexBits + a3pool_generationBits,
+		a3pool_slotMax = a3pool_indexMask,
+	};
+
+	// A3: Object types stored in a pool; one table per type.
+	enum a3_GraphicsObjectType
+	{
+		a3pool_buffer,
+		a3pool_texture,
+		a3pool_program,
+		a3pool_framebuffer,
+		a3pool_vertexArray,
+
+		a3pool_typeMax
+	};
+
+
+	// A3: Dense table of objects of one type.
+	//	member name: graphics API object name per slot (zero if free)
+	//	member generation: current generation per slot
+	//	member nextFree: free list link per slot
+	//	member capacity: number of slots allocated
+	//	member count: number of live objects
+	//	member freeHead: first free slot (capacity if none)
+	//	member releaseFunc: function used to delete object names; receives
+	//		an array of names, of which zeros are ignored
+	struct a3_GraphicsObjectTable
+	{
+		a3ui32 *name;
+		a3ui16 *generation;
+		a3ui16 *nextFree;
+		a3ui32 capacity, count, freeHead;
+		a3_GraphicsObjectReleaseFunc releaseFunc;
+	};
+
+	// A3: Pool of graphics objects, one table per type.
+	//	member table: per-type object tables
+	struct a3_GraphicsObjectPool
+	{
+		a3_GraphicsObjectTable table[a3pool_typeMax];
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Allocate pool tables; release functions are not set.
+	//	param pool_out: non-null pointer to uninitialized pool
+	//	param capacity: slots per type table; non-zero, max a3pool_slotMax
+	//	return: total number of slots allocated if success
+	//	return: -1 if invalid params or already allocated
+	a3ret a3graphicsPoolCreate(a3_GraphicsObjectPool *pool_out, const a3ui32 capacity);
+
+	// A3: Allocate pool tables with the renderer's release functions set.
+	//	param pool_out: non-null pointer to uninitialized pool
+	//	param capacity: slots per type table; non-zero, max a3pool_slotMax
+	//	return: total number of slots allocated if success
+	//	return: -1 if invalid params or already allocated
+	a3ret a3graphicsPoolCreateDefault(a3_GraphicsObjectPool *pool_out, const a3ui32 capacity);
+
+	// A3: Update pool release functions to the renderer's (hotload quick-fix).
+	//	param pool: non-null pointer to allocated pool
+	//	return: 1 if success
+	//	return: -1 if invalid params
+	a3ret a3graphicsPoolHandleUpdateReleaseCallbacks(a3_GraphicsObjectPool *pool);
+
+	// A3: Set the release function used for a type.
+	//	param pool: non-null pointer to allocated pool
+	//	param type: object type
+	//	param releaseFunc_opt: release function; pass null to leak names
+	//		back to the caller on release
+	//	return: 1 if success
+	//	return: -1 if invalid params
+	a3ret a3graphicsPoolSetReleaseFunc(a3_GraphicsObjectPool *pool, const a3_GraphicsObjectType type, const a3_GraphicsObjectReleaseFunc releaseFunc_opt);
+
+	// A3: Register an existing object name in the pool.
+	//	param pool: non-null pointer to allocated pool
+	//	param type: object type
+	//	param name: non-zero graphics API object name
+	//	return: handle to object if success
+	//	return: 0 if table is full or invalid params
+	a3_GraphicsPoolHandle a3graphicsPoolAdd(a3_GraphicsObjectPool *pool, const a3_GraphicsObjectType type, const a3ui32 name);
+
+	// A3: Validate a handle.
+	//	param pool: non-null pointer to allocated pool
+	//	param handle: handle to test
+	//	return: 1 if handle refers to a live object
+	//	return: 0 if handle is stale or null
+	//	return: -1 if invalid params
+	a3ret a3graphicsPoolValidate(const a3_GraphicsObjectPool *pool, const a3_GraphicsPoolHandle handle);
+
+	// A3: Get the object name referenced by a handle.
+	//	param pool: non-null pointer to allocated pool
+	//	param handle: handle to resolve
+	//	return: object name if handle is live
+	//	return: 0 if handle is stale, null or invalid
+	a3ui32 a3graphicsPoolGetName(const a3_GraphicsObjectPool *pool, const a3_GraphicsPoolHandle handle);
+
+	// A3: Release a single object; the slot's generation is advanced so all
+	//		outstanding copies of the handle become stale.
+	//	param pool: non-null pointer to allocated pool
+	//	param handle: handle to release
+	//	return: remaining live objects of handle's type if success
+	//	return: -1 if invalid params or handle is stale
+	a3ret a3graphicsPoolRemove(a3_GraphicsObjectPool *pool, const a3_GraphicsPoolHandle handle);
+
+	// A3: Release all objects of one type with a single release call.
+	//	param pool: non-null pointer to allocated pool
+	//	param type: object type
+	//	return: number of objects released if success
+	//	return: -1 if invalid params
+	a3ret a3graphicsPoolRemoveAllType(a3_GraphicsObjectPool *pool, const a3_GraphicsObjectType type);
+
+	// A3: Release all objects of every type.
+	//	param pool: non-null pointer to allocated pool
+	//	return: number of objects released if success
+	//	return: -1 if invalid params
+	a3ret a3graphicsPoolRemoveAll(a3_GraphicsObjectPool *pool);
+
+	// A3: Release all objects and free pool tables.
+	//	param pool: non-null pointer to allocated pool
+	//	return: number of objects released if success
+	//	return: -1 if invalid params
+	a3ret a3graphicsPoolRelease(a3_GraphicsObjectPool *pool);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#include "_inl/a3_GraphicsObjectPool.inl"
+
+
+#endif	// !__ANIMAL3D_GRAPHICSOBJECTPOOL_H
@@ -0,0 +1,153 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_InstanceBatch.h
+	Instance batching: items sharing a pair of keys (e.g. drawable and
+		material) are gathered into groups, each group's per-instance
+		records are written to one uniform buffer per pass, and every
+		group is drawn with one instanced call per chunk of records.
+*/
+
+#ifndef __ANIMAL3D_INSTANCEBATCH_H
+#define __ANIMAL3D_INSTANCEBATCH_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D-A3DG/a3graphics/a3_VertexDrawable.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_InstanceBatchGroup	a3_InstanceBatchGroup;
+	typedef struct a3_InstanceBuffer		a3_InstanceBuffer;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Instance batching limits and shader interface.
+	//	a3instance_countMax: instances per draw; shaders size their record
+	//		arrays to this; blocks of records up to 256 bytes each fit the 
+	//		16 KB every implementation allows, and span a multiple of 1 KB, 
+	//		so the chunks of a group stay offset-aligned
+	//	a3instance_keyCount: keys compared to group items
+	enum a3_InstanceBatchLimits
+	{
+		a3instance_countMax = 64,
+		a3instance_keyCount = 2,
+	};
+
+
+	// A3: Group of items sharing keys.
+	//	member key: keys shared by every item in the group
+	//	member first, count: range of the group's items in the order list
+	struct a3_InstanceBatchGroup
+	{
+		const void *key[a3instance_keyCount];
+		a3ui32 first, count;
+	};
+
+
+	// A3: Instance record buffer, refilled from the start for every pass.
+	//	member buffer: uniform buffer handle
+	//	member size: capacity in bytes
+	//	member alignment: offset alignment of bound ranges
+	struct a3_InstanceBuffer
+	{
+		a3ui32 buffer;
+		a3ui32 size;
+		a3ui32 alignment;
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Gather items into groups of equal keys; groups are in order of
+	//		their first item and items keep their order within a group.
+	//	param group_out: non-null array of up to count groups
+	//	param order_out: non-null array of up to count item indices, group
+	//		after group
+	//	param key: non-null keys of count items
+	//	param include_opt: optional flags; items not set are left out
+	//	param count: number of items
+	//	return: number of groups if success
+	//	return: -1 if invalid params
+	a3ret a3instanceBatchGroup(a3_InstanceBatchGroup *group_out, a3ui32 *order_out, const void *const(*key)[a3instance_keyCount], const a3boolean *include_opt, const a3ui32 count);
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Create instance buffer.
+	//	param buffer_out: non-null pointer to uninitialized buffer
+	//	param size: non-zero capacity in bytes; leave room for a full chunk
+	//		of records after the last group's first record, since every
+	//		draw binds a whole block
+	//	return: 1 if success
+	//	return: -1 if invalid params or buffer already initialized
+	a3ret a3instanceBufferCreate(a3_InstanceBuffer *buffer_out, const a3ui32 size);
+
+	// A3: Round an offset up to where a group's records may start.
+	//	param buffer: non-null pointer to initialized buffer
+	//	param offset: offset in bytes
+	//	return: aligned offset
+	a3ui32 a3instanceBufferAlign(const a3_InstanceBuffer *buffer, const a3ui32 offset);
+
+	// A3: Replace the buffer's contents for a pass; the previous contents
+	//		are orphaned, so draws still reading them are not waited on.
+	//		Does not change the buffer, so it can run in render.
+	//	param buffer: non-null pointer to initialized buffer
+	//	param data: non-null records, groups starting on aligned offsets
+	//	param size: non-zero number of bytes, up to capacity
+	//	return: size if success
+	//	return: -1 if invalid params or buffer not initialized
+	a3ret a3instanceBufferUpload(const a3_InstanceBuffer *buffer, const void *data, const a3ui32 size);
+
+	// A3: Draw a group's instances in chunks of up to count max, binding
+	//		each chunk's records to a uniform block; the program that reads
+	//		them must be active.
+	//	param buffer: non-null pointer to initialized buffer
+	//	param drawable: non-null pointer to drawable
+	//	param blockBinding: uniform block binding of the record array
+	//	param offset: aligned offset of the group's first record
+	//	param stride: non-zero record size in bytes (std140 array stride)
+	//	param count: number of instances
+	//	return: number of draws if success
+	//	return: -1 if invalid params or buffer not initialized
+	a3ret a3instanceBufferRender(const a3_InstanceBuffer *buffer, const a3_VertexDrawable *drawable, const a3ui32 blockBinding, const a3ui32 offset, const a3ui32 stride, const a3ui32 count);
+
+	// A3: Release instance buffer.
+	//	param buffer: non-null pointer to initialized buffer
+	//	return: 1 if success
+	//	return: -1 if invalid params or buffer not initialized
+	a3ret a3instanceBufferRelease(a3_InstanceBuffer *buffer);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_INSTANCEBATCH_H
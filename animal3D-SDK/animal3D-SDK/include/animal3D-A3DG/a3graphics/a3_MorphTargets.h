@@ -0,0 +1,293 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_MorphTargets.h
+	Morph targets (blend shapes): each target is stored as a sparse list of 
+		quantized position and normal deltas from a shared base mesh, 
+		grouped by vertex so that a vertex shader (or the CPU fallback) 
+		only visits the targets that actually move that vertex. Weights 
+		are per instance, so every instance of the base drawable can wear 
+		a different blend.
+*/
+
+#ifndef __ANIMAL3D_MORPHTARGETS_H
+#define __ANIMAL3D_MORPHTARGETS_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+#include "animal3D/a3utility/a3_Stream.h"
+#include "animal3D-A3DG/a3graphics/a3_BufferObject.h"
+#include "animal3D-A3DG/a3graphics/a3_VertexDrawable.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_MorphDelta			a3_MorphDelta;
+	typedef struct a3_MorphTargetData		a3_MorphTargetData;
+	typedef struct a3_MorphTargets			a3_MorphTargets;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Morph target limits and shader interface; shaders must use the 
+	//		same storage bindings and uniform locations.
+	//	a3morph_targetMax: maximum targets per base mesh
+	//	a3morph_threadMax: maximum threads used by the parallel CPU blend
+	//	a3morph_binding*: storage buffer binding points
+	//	a3morph_uniform*: explicit uniform locations
+	enum a3_MorphTargetLimits
+	{
+		a3morph_targetMax = 8,
+		a3morph_threadMax = 8,
+
+		a3morph_bindingRange = 0,
+		a3morph_bindingDelta,
+		a3morph_bindingStep,
+		a3morph_bindingWeight,
+
+		a3morph_uniformTargetCount = 0,
+	};
+
+
+	// A3: One vertex moved by one target, laid out to match a uvec4 in the 
+	//		storage buffer; deltas are multiples of the target's step.
+	//	member position: quantized position delta
+	//	member normal: quantized normal delta
+	//	member target: index of target
+	//	member reserved: unused, keeps entries 16 bytes
+	struct a3_MorphDelta
+	{
+		a3i16 position[3];
+		a3i16 normal[3];
+		a3ui16 target;
+		a3ui16 reserved;
+	};
+
+	// A3: Base mesh and sparse deltas of all targets, kept on the CPU.
+	//	member basePosition, baseNormal: base mesh, one per vertex
+	//	member range: first delta of each vertex; the deltas of vertex v are 
+	//		delta[range[v]] up to (excluding) delta[range[v + 1]]
+	//	member delta: all deltas, grouped by vertex
+	//	member step: per target, x is position step and y is normal step 
+	//		(value of one quantization unit)
+	//	member vertexCount: number of base vertices
+	//	member targetCount: number of targets
+	//	member deltaCount: number of stored deltas
+	struct a3_MorphTargetData
+	{
+		a3f32(*basePosition)[3];
+		a3f32(*baseNormal)[3];
+		a3ui32 *range;
+		a3_MorphDelta *delta;
+		a3f32 step[a3morph_targetMax][4];
+		a3ui32 vertexCount;
+		a3ui32 targetCount;
+		a3ui32 deltaCount;
+	};
+
+	// A3: Morph targets on the GPU.
+	//	member range, delta, step: storage copies of the data's arrays
+	//	member weight: per-instance weights; weight of target t for instance 
+	//		i is at i * targetCount + t
+	//	member vertexCount: number of base vertices
+	//	member targetCount: number of targets
+	//	member instanceCapacity: maximum instances with their own weights
+	struct a3_MorphTargets
+	{
+		a3_BufferObject range[1];
+		a3_BufferObject delta[1];
+		a3_BufferObject step[1];
+		a3_BufferObject weight[1];
+		a3ui32 vertexCount;
+		a3ui32 targetCount;
+		a3ui32 instanceCapacity;
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Create morph target data from a base mesh and the full pose of 
+	//		each target; per target, the largest delta sets the step, and 
+	//		vertex deltas that quantize to zero or are within threshold 
+	//		are not stored.
+	//	param data_out: non-null pointer to uninitialized morph target data
+	//	param basePosition, baseNormal: non-null arrays of vertexCount base 
+	//		positions and normals, 3 floats each
+	//	param vertexCount: non-zero number of vertices
+	//	param targetPosition: non-null array of targetCount non-null arrays 
+	//		of vertexCount target positions
+	//	param targetNormal_opt: optional array of targetCount non-null 
+	//		arrays of vertexCount target normals; pass null to keep normals
+	//	param targetCount: non-zero number of targets, up to max
+	//	param threshold: largest delta component ignored
+	//	return: number of deltas stored if success
+	//	return: -1 if invalid params or data already initialized
+	a3ret a3morphTargetDataCreate(a3_MorphTargetData *data_out, const a3f32 *basePosition, const a3f32 *baseNormal, const a3ui32 vertexCount, const a3f32 *const *targetPosition, const a3f32 *const *targetNormal_opt, const a3ui32 targetCount, const a3f32 threshold);
+
+	// A3: Release morph target data.
+	//	param data: non-null pointer to initialized morph target data
+	//	return: 1 if success
+	//	return: -1 if invalid params or data not initialized
+	a3ret a3morphTargetDataRelease(a3_MorphTargetData *data);
+
+	// A3: Blend a range of vertices on the CPU, same math as the shader; 
+	//		normals are renormalized.
+	//	param data: non-null pointer to initialized morph target data
+	//	param weight: non-null array of targetCount weights
+	//	param position_out: non-null array of vertexCount positions
+	//	param normal_out_opt: optional array of vertexCount normals
+	//	param first: first vertex to blend
+	//	param count: number of vertices to blend
+	//	return: number of vertices blended if success
+	//	return: -1 if invalid params or data not initialized
+	a3ret a3morphTargetDataBlend(const a3_MorphTargetData *data, const a3f32 *weight, a3f32(*position_out)[3], a3f32(*normal_out_opt)[3], const a3ui32 first, const a3ui32 count);
+
+	// A3: Blend all vertices on the CPU, split into equal ranges across 
+	//		threads; the calling thread blends the last range and waits.
+	//	param data: non-null pointer to initialized morph target data
+	//	param weight: non-null array of targetCount weights
+	//	param position_out: non-null array of vertexCount positions
+	//	param normal_out_opt: optional array of vertexCount normals
+	//	param threadCount: number of threads, including caller, up to max
+	//	return: number of vertices blended if success
+	//	return: -1 if invalid params or data not initialized
+	a3ret a3morphTargetDataBlendParallel(const a3_MorphTargetData *data, const a3f32 *weight, a3f32(*position_out)[3], a3f32(*normal_out_opt)[3], const a3ui32 threadCount);
+
+	// A3: Save morph target data to file.
+	//	param data: non-null pointer to initialized morph target data
+	//	param fileStream: non-null pointer to file stream opened in write mode
+	//	return: number of bytes written if success
+	//	return: -1 if invalid params or data not initialized
+	a3ret a3morphTargetDataSaveBinary(const a3_MorphTargetData *data, const a3_FileStream *fileStream);
+
+	// A3: Load morph target data from file.
+	//	param data_out: non-null pointer to uninitialized morph target data
+	//	param fileStream: non-null pointer to file stream opened in read mode
+	//	return: number of bytes read if success
+	//	return: -1 if invalid params or data already initialized
+	a3ret a3morphTargetDataLoadBinary(a3_MorphTargetData *data_out, const a3_FileStream *fileStream);
+
+
+	// A3: Read only the vertex positions ('v' lines) of a Wavefront OBJ file, 
+	//		in file order; targets exported from the same mesh share this 
+	//		order even though a model loader may split and reorder them.
+	//	param position_out_opt: optional array to receive positions; pass 
+	//		null to count them
+	//	param capacity: maximum positions stored
+	//	param filePath: non-null cstring of file location
+	//	param transform_opt: optional column-major 4x4 matrix applied to 
+	//		each position
+	//	return: number of positions in file if success
+	//	return: 0 if file could not be opened
+	//	return: -1 if invalid params
+	a3ret a3morphTargetLoadPositionsOBJ(a3f32(*position_out_opt)[3], const a3ui32 capacity, const a3byte *filePath, const a3f32 *transform_opt);
+
+	// A3: Find, for each mesh vertex, the source position it came from, 
+	//		e.g. the OBJ position of a vertex split by a model loader.
+	//	param map_out: non-null array of vertexCount source indices; 
+	//		vertices without a match get sourceCount
+	//	param position: non-null array of vertexCount mesh positions, 3 
+	//		floats each
+	//	param vertexCount: non-zero number of mesh vertices
+	//	param sourcePosition: non-null array of sourceCount positions, 3 
+	//		floats each
+	//	param sourceCount: non-zero number of source positions
+	//	param tolerance: largest distance considered a match
+	//	return: number of vertices matched if success
+	//	return: -1 if invalid params
+	a3ret a3morphTargetMapVertices(a3ui32 *map_out, const a3f32 *position, const a3ui32 vertexCount, const a3f32 *sourcePosition, const a3ui32 sourceCount, const a3f32 tolerance);
+
+	// A3: Calculate smooth area-weighted normals of source positions using 
+	//		the mesh's triangles, so that vertices split at seams still 
+	//		share one normal per source position.
+	//	param normal_out: non-null array of sourceCount normals
+	//	param sourcePosition: non-null array of sourceCount positions, 3 
+	//		floats each
+	//	param sourceCount: non-zero number of source positions
+	//	param map: non-null array mapping mesh vertices to sources
+	//	param index_opt: optional triangle list indices; pass null if not 
+	//		indexed
+	//	param indexSize: size of one index in bytes (1, 2 or 4)
+	//	param count: number of indices, or vertices if not indexed
+	//	return: number of triangles used if success
+	//	return: -1 if invalid params
+	a3ret a3morphTargetCalculateNormals(a3f32(*normal_out)[3], const a3f32 *sourcePosition, const a3ui32 sourceCount, const a3ui32 *map, const void *index_opt, const a3ui32 indexSize, const a3ui32 count);
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Create morph targets on the GPU from morph target data; requires 
+	//		storage buffers (GL 4.3). Weights start at zero.
+	//	param morph_out: non-null pointer to uninitialized morph targets
+	//	param name_opt: optional cstring for short name/description; max 31 
+	//		chars + null terminator; pass null for default name
+	//	param data: non-null pointer to initialized morph target data
+	//	param instanceCapacity: non-zero maximum instances
+	//	return: 1 if success
+	//	return: 0 if not supported or creation failed
+	//	return: -1 if invalid params or morph targets already initialized
+	a3ret a3morphTargetsCreate(a3_MorphTargets *morph_out, const a3byte name_opt[32], const a3_MorphTargetData *data, const a3ui32 instanceCapacity);
+
+	// A3: Upload per-instance weights.
+	//	param morph: non-null pointer to initialized morph targets
+	//	param weight: non-null array of instanceCount * targetCount weights
+	//	param instanceCount: number of instances, up to capacity
+	//	return: number of instances updated if success
+	//	return: -1 if invalid params or morph targets not initialized
+	a3ret a3morphTargetsUpdateWeights(a3_MorphTargets *morph, const a3f32 *weight, const a3ui32 instanceCount);
+
+	// A3: Draw instances of the base drawable; the active program reads 
+	//		deltas and weights from the storage bindings using the vertex 
+	//		and instance index, so the drawable must be the base mesh with 
+	//		its own vertex buffer (indices start at zero).
+	//	param morph: non-null pointer to initialized morph targets
+	//	param drawable: non-null pointer to base mesh drawable
+	//	param instanceCount: number of instances, up to capacity
+	//	return: 1 if success
+	//	return: -1 if invalid params or morph targets not initialized
+	a3ret a3morphTargetsRender(const a3_MorphTargets *morph, const a3_VertexDrawable *drawable, const a3ui32 instanceCount);
+
+	// A3: Release morph targets.
+	//	param morph: non-null pointer to initialized morph targets
+	//	return: 1 if success
+	//	return: -1 if invalid params or morph targets not initialized
+	a3ret a3morphTargetsRelease(a3_MorphTargets *morph);
+
+	// A3: Update release callbacks of the morph target buffers after hotload.
+	//	param morph: non-null pointer to morph targets
+	//	return: 1 if success
+	//	return: -1 if invalid params
+	a3ret a3morphTargetsHandleUpdateReleaseCallbacks(a3_MorphTargets *morph);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_MORPHTARGETS_H
@@ -0,0 +1,234 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_OcclusionCulling.h
+	Hierarchical depth occlusion culling: a scene depth buffer is reduced
+		into a pyramid of farthest depths, then object boxes are tested
+		against the smallest level that covers them in two texels. Tests
+		run on the GPU and results are read back a frame or more later
+		without waiting. A CPU reference builds and tests with the same
+		math as the compute shaders.
+*/
+
+#ifndef __ANIMAL3D_OCCLUSIONCULLING_H
+#define __ANIMAL3D_OCCLUSIONCULLING_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D-A3DG/a3graphics/a3_Framebuffer.h"
+#include "animal3D-A3DG/a3graphics/a3_ShaderProgram.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_OcclusionCuller		a3_OcclusionCuller;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Occlusion culling limits and shader interface; shaders must use
+	//		the same group sizes, bindings and uniform locations.
+	//	a3occlusion_tileSize: reduce work group is tileSize x tileSize
+	//	a3occlusion_groupSize: test work group size
+	//	a3occlusion_slotMax: maximum result slots in flight
+	//	a3occlusion_binding*: storage buffer bindings of test
+	//	a3occlusion_unitSource: texture unit of reduce source and of the
+	//		pyramid during test
+	//	a3occlusion_imageTarget: image unit of the reduce target level
+	//	a3occlusion_uniform*: explicit uniform locations; view-projection
+	//		takes four
+	enum a3_OcclusionCullingLimits
+	{
+		a3occlusion_tileSize = 8,
+		a3occlusion_groupSize = 64,
+		a3occlusion_slotMax = 4,
+
+		a3occlusion_bindingBounds = 0,
+		a3occlusion_bindingVisible,
+
+		a3occlusion_unitSource = 0,
+		a3occlusion_imageTarget = 0,
+
+		a3occlusion_uniformSourceLevel = 0,
+		a3occlusion_uniformViewProjection,
+		a3occlusion_uniformDepthSize = a3occlusion_uniformViewProjection + 4,
+		a3occlusion_uniformLevelCount,
+		a3occlusion_uniformObjectCount,
+	};
+
+
+	// A3: Occlusion culler: depth pyramid, box storage and a ring of result
+	//		buffers, each fenced after the test that writes it.
+	//	member pyramid: single-channel float texture; level 0 is half the
+	//		depth size (rounded down), each texel holds the farthest depth
+	//		it covers; the last texel of an odd row or column also covers
+	//		the one left over
+	//	member bounds: storage buffer of capacity boxes (min, max)
+	//	member result: storage buffers of capacity visibility words
+	//	member resultFence: fence per result slot, null once read
+	//	member resultCount: boxes tested into each slot
+	//	members depthWidth, depthHeight: size of depth the pyramid is built
+	//		from; levelCount: levels of the pyramid
+	//	members capacity, slotCount, slotIndex: box limit, result ring
+	//		layout and slot written by the next test
+	//	member pyramidFrames: frames the pyramid has been built in a row;
+	//		tests are only meaningful once it has been built at least once
+	struct a3_OcclusionCuller
+	{
+		a3ui32 pyramid;
+		a3ui32 bounds;
+		a3ui32 result[a3occlusion_slotMax];
+		void *resultFence[a3occlusion_slotMax];
+		a3ui32 resultCount[a3occlusion_slotMax];
+		a3ui32 depthWidth, depthHeight, levelCount;
+		a3ui32 capacity, slotCount, slotIndex;
+		a3ui32 pyramidFrames;
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Create culler; requires compute shaders, storage buffers and
+	//		immutable textures (GL 4.3). The pyramid is allocated by the
+	//		first begin frame.
+	//	param culler_out: non-null pointer to uninitialized culler
+	//	param capacity: non-zero maximum number of boxes per test
+	//	param slotCount: number of result slots, between 1 and max; use one
+	//		more than the frames the GPU may lag behind
+	//	return: 1 if success
+	//	return: 0 if not supported
+	//	return: -1 if invalid params or culler already initialized
+	a3ret a3occlusionCullerCreate(a3_OcclusionCuller *culler_out, const a3ui32 capacity, const a3ui32 slotCount);
+
+	// A3: Prepare for this frame: reallocate the pyramid if the depth size
+	//		changed (forgetting the old one), then count on it being built
+	//		again after the scene is drawn.
+	//	param culler: non-null pointer to initialized culler
+	//	param depthWidth, depthHeight: non-zero size of depth buffer
+	//	return: 1 if the pyramid holds a previous frame and may be tested
+	//	return: 0 if there is nothing to test against yet
+	//	return: -1 if invalid params or culler not initialized
+	a3ret a3occlusionCullerBeginFrame(a3_OcclusionCuller *culler, const a3ui32 depthWidth, const a3ui32 depthHeight);
+
+	// A3: Forget the pyramid and any results in flight, e.g. when culling
+	//		is switched off and the pyramid stops being built.
+	//	param culler: non-null pointer to initialized culler
+	//	return: 1 if success
+	//	return: -1 if invalid params or culler not initialized
+	a3ret a3occlusionCullerReset(a3_OcclusionCuller *culler);
+
+	// A3: Build the pyramid from a framebuffer's depth, one dispatch per
+	//		level; does not change the culler, so it can run in render.
+	//	param culler: non-null pointer to initialized culler
+	//	param reduceProgram: non-null pointer to linked reduce program
+	//	param framebuffer: non-null pointer to framebuffer with a depth
+	//		texture of the size passed to begin frame
+	//	return: number of levels built if success
+	//	return: 0 if the framebuffer size does not match
+	//	return: -1 if invalid params or culler not initialized
+	a3ret a3occlusionCullerBuildPyramid(const a3_OcclusionCuller *culler, const a3_ShaderProgram *reduceProgram, const a3_Framebuffer *framebuffer);
+
+	// A3: Test boxes against the pyramid with one thread each and fence
+	//		the results; nothing is read back.
+	//	param culler: non-null pointer to initialized culler
+	//	param testProgram: non-null pointer to linked test program
+	//	param boundsMin, boundsMax: non-null world-space box corners (xyz
+	//		used) of count objects
+	//	param count: number of boxes, up to capacity
+	//	param viewProjectionMat: non-null column-major 4x4 matrix of the
+	//		view the pyramid is tested from (usually this frame's camera)
+	//	return: number of boxes tested if success
+	//	return: -1 if invalid params or culler not initialized
+	a3ret a3occlusionCullerTest(a3_OcclusionCuller *culler, const a3_ShaderProgram *testProgram, const a3f32(*boundsMin)[4], const a3f32(*boundsMax)[4], const a3ui32 count, const a3f32 *viewProjectionMat);
+
+	// A3: Read the newest finished test without waiting; older results
+	//		still in flight are dropped.
+	//	param culler: non-null pointer to initialized culler
+	//	param visible_out: non-null array of count flags, written only if
+	//		a result was ready
+	//	param count: number of flags to read, up to capacity
+	//	param wait: non-zero to wait for the newest test instead (for
+	//		validation)
+	//	return: number of flags written if a result was ready
+	//	return: 0 if no result was ready
+	//	return: -1 if invalid params or culler not initialized
+	a3ret a3occlusionCullerReadback(a3_OcclusionCuller *culler, a3boolean *visible_out, const a3ui32 count, const a3boolean wait);
+
+	// A3: Read the pyramid levels back, in the layout of the reference;
+	//		stalls until the GPU is done, so use for validation only.
+	//	param culler: non-null pointer to initialized culler
+	//	param pyramid_out: non-null array of reference size
+	//	return: number of levels read if success
+	//	return: -1 if invalid params or culler not initialized
+	a3ret a3occlusionCullerReadPyramid(const a3_OcclusionCuller *culler, a3f32 *pyramid_out);
+
+	// A3: Release culler.
+	//	param culler: non-null pointer to initialized culler
+	//	return: 1 if success
+	//	return: -1 if invalid params or culler not initialized
+	a3ret a3occlusionCullerRelease(a3_OcclusionCuller *culler);
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Size of the pyramid built from a depth buffer.
+	//	param depthWidth, depthHeight: size of depth buffer
+	//	param levelCount_out_opt: optional pointer to receive level count
+	//	return: number of texels across all levels
+	a3ui32 a3occlusionPyramidSize(const a3ui32 depthWidth, const a3ui32 depthHeight, a3ui32 *levelCount_out_opt);
+
+	// A3: Reference pyramid build on the CPU; levels are stored one after
+	//		another, rows bottom to top.
+	//	param pyramid_out: non-null array of reference size
+	//	param depth: non-null array of window depths, rows bottom to top
+	//	param depthWidth, depthHeight: non-zero size of depth buffer
+	//	return: number of levels if success
+	//	return: -1 if invalid params
+	a3ret a3occlusionBuildPyramidReference(a3f32 *pyramid_out, const a3f32 *depth, const a3ui32 depthWidth, const a3ui32 depthHeight);
+
+	// A3: Reference test on the CPU, same math as the compute shader: a box
+	//		crossing the near plane is visible; otherwise its screen rect
+	//		picks a level where it spans at most 2x2 texels, and it is
+	//		visible if its nearest depth is not behind the farthest of
+	//		them. Boxes entirely off screen are not visible.
+	//	param visible_out: non-null array of count flags
+	//	param pyramid: non-null pyramid in reference layout
+	//	param depthWidth, depthHeight: non-zero size of depth buffer
+	//	param boundsMin, boundsMax: non-null box corners of count objects
+	//	param count: number of boxes
+	//	param viewProjectionMat: non-null column-major 4x4 matrix
+	//	return: number of visible boxes if success
+	//	return: -1 if invalid params
+	a3ret a3occlusionTestReference(a3boolean *visible_out, const a3f32 *pyramid, const a3ui32 depthWidth, const a3ui32 depthHeight, const a3f32(*boundsMin)[4], const a3f32(*boundsMax)[4], const a3ui32 count, const a3f32 *viewProjectionMat);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_OCCLUSIONCULLING_H
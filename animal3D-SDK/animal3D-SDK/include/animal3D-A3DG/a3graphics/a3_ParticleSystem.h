@@ -0,0 +1,234 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_ParticleSystem.h
+	GPU particle system: particles live in a pair of storage buffers and 
+		are simulated, emitted and compacted by compute shaders; the live 
+		count never comes back to the CPU, since the next dispatch and the 
+		instanced draw both read their sizes from a state buffer. A CPU 
+		reference simulation using the same math is provided to validate 
+		the GPU path.
+*/
+
+#ifndef __ANIMAL3D_PARTICLESYSTEM_H
+#define __ANIMAL3D_PARTICLESYSTEM_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D-A3DG/a3graphics/a3_BufferObject.h"
+#include "animal3D-A3DG/a3graphics/a3_ShaderProgram.h"
+#include "animal3D-A3DG/a3graphics/a3_VertexDrawable.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_Particle				a3_Particle;
+	typedef struct a3_ParticleEmitter		a3_ParticleEmitter;
+	typedef struct a3_ParticleSystem		a3_ParticleSystem;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Particle system limits and shader interface; shaders must use 
+	//		the same group size, storage bindings and uniform locations.
+	//	a3particle_groupSize: compute work group size of simulate and emit
+	//	a3particle_binding*: storage buffer binding points
+	//	a3particle_uniform*: explicit uniform locations
+	//	a3particle_state*: offsets into the state buffer, in 32-bit words
+	enum a3_ParticleSystemLimits
+	{
+		a3particle_groupSize = 256,
+
+		a3particle_bindingSource = 0,
+		a3particle_bindingTarget,
+		a3particle_bindingState,
+
+		a3particle_uniformEmitPosition = 0,
+		a3particle_uniformEmitVelocity,
+		a3particle_uniformEmitColor,
+		a3particle_uniformEmitLife,
+		a3particle_uniformGravity,
+		a3particle_uniformTimeStep,
+		a3particle_uniformEmitCount,
+		a3particle_uniformEmitIndex,
+		a3particle_uniformSeed,
+		a3particle_uniformCapacity,
+
+		a3particle_stateDraw = 0,
+		a3particle_stateDispatch = 8,
+		a3particle_stateAlive = 12,
+		a3particle_stateCounter,
+		a3particle_stateCount = 16,
+	};
+
+
+	// A3: Single particle, laid out to match the storage buffer (std430).
+	//	member position: position; w is remaining life in seconds
+	//	member velocity: velocity; w is billboard size
+	//	member color: color; w is reciprocal of initial life, used to fade
+	struct a3_Particle
+	{
+		a3f32 position[4];
+		a3f32 velocity[4];
+		a3f32 color[4];
+	};
+
+	// A3: Description of how particles are spawned and moved.
+	//	member position: spawn center; w is spawn radius
+	//	member velocity: initial velocity; w is random spread
+	//	member color: particle color
+	//	member life: x is life in seconds, y is random spread, z is size
+	//	member gravity: acceleration; w is linear drag
+	//	member rate: particles spawned per second
+	//	member seed: random seed
+	struct a3_ParticleEmitter
+	{
+		a3f32 position[4];
+		a3f32 velocity[4];
+		a3f32 color[4];
+		a3f32 life[4];
+		a3f32 gravity[4];
+		a3f32 rate;
+		a3ui32 seed;
+	};
+
+	// A3: GPU particle system.
+	//	member pool: particle storage; one is read and the other written 
+	//		each update, then they swap
+	//	member state: indirect draw and dispatch commands, live count and 
+	//		append counter (see a3particle_state*)
+	//	member capacity: maximum number of live particles
+	//	member source: index of pool holding the current particles
+	//	member emitted: total particles emitted; also the random stream 
+	//		index of the next one
+	//	member emitCarry: fraction of a particle left over from last update
+	struct a3_ParticleSystem
+	{
+		a3_BufferObject pool[2];
+		a3_BufferObject state[1];
+		a3ui32 capacity;
+		a3ui32 source;
+		a3ui32 emitted;
+		a3f32 emitCarry;
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Create particle system; requires storage buffers, compute 
+	//		shaders and indirect dispatch (GL 4.3).
+	//	param system_out: non-null pointer to uninitialized particle system
+	//	param name_opt: optional cstring for short name/description; max 31 
+	//		chars + null terminator; pass null for default name
+	//	param capacity: non-zero maximum number of live particles
+	//	param drawable: non-null pointer to drawable used as the billboard; 
+	//		its vertex or index range is stored in the draw command
+	//	return: 1 if success
+	//	return: 0 if not supported or creation failed
+	//	return: -1 if invalid params or system already initialized
+	a3ret a3particleSystemCreate(a3_ParticleSystem *system_out, const a3byte name_opt[32], const a3ui32 capacity, const a3_VertexDrawable *drawable);
+
+	// A3: Advance particles: simulate and compact the live ones, append new 
+	//		ones from the emitter, then write the next dispatch and draw 
+	//		sizes; nothing is read back.
+	//	param system: non-null pointer to initialized particle system
+	//	param simulateProgram, emitProgram, finalizeProgram: non-null 
+	//		pointers to linked compute programs for each step
+	//	param emitter: non-null pointer to emitter description
+	//	param dt: positive time step in seconds
+	//	return: number of particles emitted (some may not fit) if success
+	//	return: -1 if invalid params or system not initialized
+	a3ret a3particleSystemUpdate(a3_ParticleSystem *system, const a3_ShaderProgram *simulateProgram, const a3_ShaderProgram *emitProgram, const a3_ShaderProgram *finalizeProgram, const a3_ParticleEmitter *emitter, const a3f32 dt);
+
+	// A3: Draw one instance of the billboard per live particle using the 
+	//		indirect draw command; the active program reads the particles 
+	//		from the source binding using the instance index.
+	//	param system: non-null pointer to initialized particle system
+	//	param drawable: non-null pointer to same billboard used to create
+	//	return: 1 if success
+	//	return: -1 if invalid params or system not initialized
+	a3ret a3particleSystemRender(const a3_ParticleSystem *system, const a3_VertexDrawable *drawable);
+
+	// A3: Read back the live count and optionally the particles; stalls 
+	//		until the GPU is done, so use for validation only.
+	//	param system: non-null pointer to initialized particle system
+	//	param particle_out_opt: optional array of capacity particles to 
+	//		receive the live ones
+	//	return: number of live particles if success
+	//	return: -1 if invalid params or system not initialized
+	a3ret a3particleSystemReadback(const a3_ParticleSystem *system, a3_Particle *particle_out_opt);
+
+	// A3: Kill all particles.
+	//	param system: non-null pointer to initialized particle system
+	//	return: 1 if success
+	//	return: -1 if invalid params or system not initialized
+	a3ret a3particleSystemReset(a3_ParticleSystem *system);
+
+	// A3: Release particle system.
+	//	param system: non-null pointer to initialized particle system
+	//	return: 1 if success
+	//	return: -1 if invalid params or system not initialized
+	a3ret a3particleSystemRelease(a3_ParticleSystem *system);
+
+	// A3: Update release callbacks of the system's buffers after hotload.
+	//	param system: non-null pointer to particle system
+	//	return: 1 if success
+	//	return: -1 if invalid params
+	a3ret a3particleSystemHandleUpdateReleaseCallbacks(a3_ParticleSystem *system);
+
+
+	// A3: Reference simulation of one update on the CPU, matching the 
+	//		compute shaders step for step: live particles are integrated 
+	//		and compacted in place, then new ones are appended. Only the 
+	//		order of particles may differ from the GPU, since compaction 
+	//		there uses an atomic counter.
+	//	param particle: non-null array of capacity particles
+	//	param count: number of live particles in array
+	//	param capacity: non-zero size of array
+	//	param emitter: non-null pointer to emitter description
+	//	param emitIndex: random stream index of first new particle
+	//	param emitCount: number of particles to emit
+	//	param dt: positive time step in seconds
+	//	return: new number of live particles if success
+	//	return: -1 if invalid params
+	a3ret a3particleSimulateReference(a3_Particle *particle, const a3ui32 count, const a3ui32 capacity, const a3_ParticleEmitter *emitter, const a3ui32 emitIndex, const a3ui32 emitCount, const a3f32 dt);
+
+	// A3: Number of particles to emit over a time step, carrying the 
+	//		fraction over to the next step.
+	//	param emitCarry: non-null pointer to fraction carried between steps
+	//	param rate: particles per second
+	//	param dt: time step in seconds
+	//	return: number of particles to emit
+	a3ui32 a3particleEmitCount(a3f32 *emitCarry, const a3f32 rate, const a3f32 dt);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_PARTICLESYSTEM_H
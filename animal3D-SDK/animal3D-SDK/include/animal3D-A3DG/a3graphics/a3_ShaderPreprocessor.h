@@ -0,0 +1,101 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_ShaderPreprocessor.h
+	GLSL source preprocessing before compile: '#include' directives are 
+		expanded (each file at most once) and a block of defines is 
+		injected after the version line, so that one source file can be 
+		compiled as several variants.
+*/
+
+#ifndef __ANIMAL3D_SHADERPREPROCESSOR_H
+#define __ANIMAL3D_SHADERPREPROCESSOR_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_ShaderSource				a3_ShaderSource;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Preprocessor limits.
+	enum
+	{
+		a3shaderSource_fileMax = 12,
+		a3shaderSource_pathMax = 128,
+		a3shaderSource_depthMax = 8,
+	};
+
+
+	// A3: Expanded shader source and the files it was built from.
+	//	member text: expanded source string (owned)
+	//	member length: length of expanded source, not including terminator
+	//	member fileCount: number of files read; file index is also the 
+	//		source string number in '#line' directives and compile logs
+	//	member filePath: paths of files read, root file first
+	struct a3_ShaderSource
+	{
+		a3byte *text;
+		a3ui32 length;
+		a3ui32 fileCount;
+		a3byte filePath[a3shaderSource_fileMax][a3shaderSource_pathMax];
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Load and expand shader source file.
+	//		Include paths are relative to the including file: 
+	//			#include "common/lighting.glsl"
+	//		A file already included is skipped; version lines in included 
+	//		files are dropped.
+	//	param source_out: non-null pointer to unused source
+	//	param filePath: non-null, non-empty cstring of root file location
+	//	param defines_opt: optional lines of defines (e.g. "#define A 1\n") 
+	//		injected after the root file's version line
+	//	return: length of expanded source if success
+	//	return: 0 if root file could not be read
+	//	return: -1 if invalid params or source already used
+	a3ret a3shaderSourcePreprocessFile(a3_ShaderSource *source_out, const a3byte *filePath, const a3byte *defines_opt);
+
+	// A3: Release expanded source.
+	//	param source: non-null pointer to source
+	//	return: 1 if released
+	//	return: 0 if source was not used
+	//	return: -1 if invalid params
+	a3ret a3shaderSourceRelease(a3_ShaderSource *source);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_SHADERPREPROCESSOR_H
@@ -0,0 +1,132 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_ShaderProgramParallel.h
+	Deferred shader compile and program link: requests are issued without 
+		waiting on the driver so that a threaded compiler can work on all 
+		of them at once; results are checked only after completion. 
+		Without driver support every request still completes in order, so 
+		the same submit-then-finish sequence works everywhere.
+*/
+
+#ifndef __ANIMAL3D_SHADERPROGRAMPARALLEL_H
+#define __ANIMAL3D_SHADERPROGRAMPARALLEL_H
+
+
+#include "animal3D-A3DG/a3graphics/a3_ShaderProgram.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Let the driver choose the number of compiler threads.
+	enum
+	{
+		a3shader_parallelThreadsDefault = -1,
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Set the number of driver threads used for compile and link.
+	//	param threadCount: maximum compiler threads; zero disables parallel 
+	//		compilation, a3shader_parallelThreadsDefault leaves it to driver
+	//	return: 1 if parallel compilation is available
+	//	return: 0 if not; requests complete in order when issued
+	a3ret a3shaderParallelInitialize(const a3ui32 threadCount);
+
+	// A3: Create shader and issue compile from list of source strings 
+	//		without waiting for the result; the shader may be attached 
+	//		right away, but its status is only known after finishing.
+	//	param shader_out: non-null pointer to unused shader
+	//	param name_opt: optional name of shader
+	//	param type: type of shader
+	//	param sourceList: non-null array of source strings
+	//	param count: number of strings in list
+	//	return: number of valid sources issued if success
+	//	return: 0 if no valid sources or shader not created
+	//	return: -1 if invalid params or shader already used
+	a3ret a3shaderCreateFromSourceListDeferred(a3_Shader *shader_out, const a3byte name_opt[32], const a3_ShaderType type, const a3byte **sourceList, const a3ui32 count);
+
+	// A3: Create shader and issue compile from list of files without 
+	//		waiting for the result; file contents are released once issued.
+	//	param shader_out: non-null pointer to unused shader
+	//	param name_opt: optional name of shader
+	//	param type: type of shader
+	//	param filePathList: non-null array of file paths
+	//	param count: number of paths in list
+	//	return: number of valid sources issued if success
+	//	return: 0 if no files loaded or shader not created
+	//	return: -1 if invalid params or shader already used
+	a3ret a3shaderCreateFromFileListDeferred(a3_Shader *shader_out, const a3byte name_opt[32], const a3_ShaderType type, const a3byte **filePathList, const a3ui32 count);
+
+	// A3: Check whether a deferred compile has completed; never blocks.
+	//	param shader: non-null pointer to shader
+	//	return: 1 if complete (or already finished)
+	//	return: 0 if still compiling
+	//	return: -1 if invalid params or shader not created
+	a3ret a3shaderCompileIsComplete(const a3_Shader *shader);
+
+	// A3: Finish a deferred compile, blocking if it is not yet complete; 
+	//		on failure the log is printed and the shader is released.
+	//	param shader: non-null pointer to shader
+	//	return: 1 if compiled
+	//	return: 0 if compile failed
+	//	return: -1 if invalid params or shader not created
+	a3ret a3shaderCompileFinish(a3_Shader *shader);
+
+	// A3: Issue link of program without waiting for the result.
+	//	param program: non-null pointer to program with attached shaders
+	//	return: 1 if issued
+	//	return: 0 if already linked
+	//	return: -1 if invalid params or program not created
+	a3ret a3shaderProgramLinkDeferred(a3_ShaderProgram *program);
+
+	// A3: Check whether a deferred link has completed; never blocks.
+	//	param program: non-null pointer to program
+	//	return: 1 if complete (or already finished)
+	//	return: 0 if still linking
+	//	return: -1 if invalid params or program not created
+	a3ret a3shaderProgramLinkIsComplete(const a3_ShaderProgram *program);
+
+	// A3: Finish a deferred link, blocking if it is not yet complete; on 
+	//		failure the log is printed and the program is kept so that a 
+	//		contingency plan is still possible.
+	//	param program: non-null pointer to program
+	//	return: 1 if linked
+	//	return: 0 if link failed
+	//	return: -1 if invalid params or program not created
+	a3ret a3shaderProgramLinkFinish(a3_ShaderProgram *program);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_SHADERPROGRAMPARALLEL_H
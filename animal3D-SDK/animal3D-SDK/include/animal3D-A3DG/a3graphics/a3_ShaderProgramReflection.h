@@ -0,0 +1,142 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_ShaderProgramReflection.h
+	Uniform reflection: the active uniforms and uniform blocks of a linked 
+		program are queried once into a compact hashed table, so that 
+		locations are looked up without asking the driver by name. The 
+		table is plain data and can be stored next to a program binary.
+*/
+
+#ifndef __ANIMAL3D_SHADERPROGRAMREFLECTION_H
+#define __ANIMAL3D_SHADERPROGRAMREFLECTION_H
+
+
+#include "animal3D-A3DG/a3graphics/a3_ShaderProgram.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_ShaderProgramReflectEntry	a3_ShaderProgramReflectEntry;
+	typedef struct a3_ShaderProgramReflection	a3_ShaderProgramReflection;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Reflection limits; hash slots are twice the uniform limit so 
+	//	probing stays short.
+	enum
+	{
+		a3shaderReflect_uniformMax = 64,
+		a3shaderReflect_blockMax = 8,
+		a3shaderReflect_slotMax = a3shaderReflect_uniformMax * 2,
+		a3shaderReflect_nameMax = 32,
+	};
+
+
+	// A3: Reflected uniform or uniform block.
+	//	member hash: hash of name
+	//	member location: uniform location or uniform block index
+	//	member count: array size of uniform or data size of block
+	//	member sampler: non-zero if uniform is a sampler or image
+	//	member name: name without array subscript
+	struct a3_ShaderProgramReflectEntry
+	{
+		a3ui32 hash;
+		a3i32 location;
+		a3ui32 count;
+		a3ui32 sampler;
+		a3byte name[a3shaderReflect_nameMax];
+	};
+
+	// A3: Reflection table of one program.
+	//	member uniform: uniforms that are not in blocks
+	//	member block: uniform blocks
+	//	member slot: uniform hash slots holding entry index + 1 (0 if empty)
+	//	member uniformCount, blockCount, samplerCount: number of entries
+	struct a3_ShaderProgramReflection
+	{
+		a3_ShaderProgramReflectEntry uniform[a3shaderReflect_uniformMax];
+		a3_ShaderProgramReflectEntry block[a3shaderReflect_blockMax];
+		a3ubyte slot[a3shaderReflect_slotMax];
+		a3ui32 uniformCount, blockCount, samplerCount;
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Query active uniforms and uniform blocks of a linked program.
+	//	param reflection_out: non-null pointer to reflection
+	//	param program: non-null pointer to linked program
+	//	return: number of uniforms and blocks reflected if success
+	//	return: -1 if invalid params or program not linked
+	a3ret a3shaderProgramReflect(a3_ShaderProgramReflection *reflection_out, const a3_ShaderProgram *program);
+
+	// A3: Get location of a uniform from reflection.
+	//	param reflection: non-null pointer to reflection
+	//	param uniformName: non-null, non-empty cstring of uniform name
+	//	return: location of uniform (non-negative) if found
+	//	return: -1 if invalid params or uniform was not found
+	a3ret a3shaderProgramReflectionGetLocation(const a3_ShaderProgramReflection *reflection, const a3byte *uniformName);
+
+	// A3: Get reflected uniform entry.
+	//	param reflection: non-null pointer to reflection
+	//	param uniformName: non-null, non-empty cstring of uniform name
+	//	return: pointer to entry if found
+	//	return: null if invalid params or uniform was not found
+	const a3_ShaderProgramReflectEntry *a3shaderProgramReflectionGetUniform(const a3_ShaderProgramReflection *reflection, const a3byte *uniformName);
+
+	// A3: Get index of a uniform block from reflection.
+	//	param reflection: non-null pointer to reflection
+	//	param blockName: non-null, non-empty cstring of block name
+	//	return: index of block (non-negative) if found
+	//	return: -1 if invalid params or block was not found
+	a3ret a3shaderProgramReflectionGetBlock(const a3_ShaderProgramReflection *reflection, const a3byte *blockName);
+
+	// A3: Save reflection to file.
+	//	param reflection: non-null pointer to reflection
+	//	param filePath: non-null, non-empty cstring of file location
+	//	return: 1 if success
+	//	return: 0 if file could not be written
+	//	return: -1 if invalid params
+	a3ret a3shaderProgramReflectionSaveFile(const a3_ShaderProgramReflection *reflection, const a3byte *filePath);
+
+	// A3: Load reflection from file; only valid for the program binary it 
+	//		was saved with.
+	//	param reflection_out: non-null pointer to reflection
+	//	param filePath: non-null, non-empty cstring of file location
+	//	return: 1 if success
+	//	return: 0 if file could not be read or does not match
+	//	return: -1 if invalid params
+	a3ret a3shaderProgramReflectionLoadFile(a3_ShaderProgramReflection *reflection_out, const a3byte *filePath);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_SHADERPROGRAMREFLECTION_H
@@ -0,0 +1,258 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Skinning.h
+	Skeletal skinning: a joint hierarchy with rigid bind poses, a palette of
+		skinning transforms per character (linear blend as 3x4 matrices or
+		dual quaternions), packed four-influence vertex data and a ring of
+		persistently mapped storage segments that palettes are written to
+		every frame. A CPU reference deforms vertices with the same math as
+		the vertex shader.
+*/
+
+#ifndef __ANIMAL3D_SKINNING_H
+#define __ANIMAL3D_SKINNING_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+#include "animal3D-A3DG/a3graphics/a3_VertexBuffer.h"
+#include "animal3D-A3DG/a3graphics/a3_VertexDrawable.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_Skeleton				a3_Skeleton;
+	typedef struct a3_SkinPaletteRing		a3_SkinPaletteRing;
+	typedef enum a3_SkinningMethod			a3_SkinningMethod;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Skinning limits and shader interface; shaders must use the same
+	//		storage binding and uniform location.
+	//	a3skin_jointMax: maximum joints per skeleton
+	//	a3skin_influenceMax: joints influencing one vertex
+	//	a3skin_segmentMax: maximum segments in a palette ring
+	//	a3skin_bindingPalette: storage buffer binding of palettes
+	//	a3skin_uniformJointCount: explicit uniform location of joint count
+	enum a3_SkinningLimits
+	{
+		a3skin_jointMax = 64,
+		a3skin_influenceMax = 4,
+		a3skin_segmentMax = 4,
+
+		a3skin_bindingPalette = 0,
+
+		a3skin_uniformJointCount = 0,
+	};
+
+	// A3: Palette layouts; the value is the number of vec4 per joint.
+	//	a3skin_linear: first three rows of the skinning matrix; blended
+	//		rows are applied to the vertex (linear blend skinning)
+	//	a3skin_dualQuat: unit rotation quaternion (xyzw) followed by dual
+	//		part; blended and renormalized, so joints twisting far apart
+	//		keep volume (dual quaternion skinning, rigid joints only)
+	enum a3_SkinningMethod
+	{
+		a3skin_linear = 3,
+		a3skin_dualQuat = 2,
+	};
+
+
+	// A3: Joint hierarchy in bind pose.
+	//	member parentIndex: parent of each joint, -1 for a root; parents
+	//		always come before their children
+	//	member bindLocal: bind pose of each joint relative to its parent, 
+	//		column-major; animated poses usually start from it
+	//	member bindInverse: inverse of each joint's bind pose in model
+	//		space, column-major
+	//	member jointCount: number of joints
+	struct a3_Skeleton
+	{
+		a3i32 parentIndex[a3skin_jointMax];
+		a3f32 bindLocal[a3skin_jointMax][16];
+		a3f32 bindInverse[a3skin_jointMax][16];
+		a3ui32 jointCount;
+	};
+
+	// A3: Ring of palette storage in one buffer; each frame writes into its
+	//		own segment, which is reused only once the GPU has read it.
+	//	member buffer: storage buffer handle
+	//	member mapped: persistent mapping of buffer (null if unavailable,
+	//		in which case palettes are sent with buffer sub-data)
+	//	members segmentSize, segmentCount, segmentIndex: ring layout and
+	//		segment being written this frame
+	//	member segmentUsed: bytes allocated from current segment
+	//	member alignment: storage buffer offset alignment of the context
+	//	member segmentFence: fence per segment, placed at end of frame
+	struct a3_SkinPaletteRing
+	{
+		a3ui32 buffer;
+		a3byte *mapped;
+		a3ui32 segmentSize, segmentCount, segmentIndex;
+		a3ui32 segmentUsed;
+		a3ui32 alignment;
+		void *segmentFence[a3skin_segmentMax];
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Create skeleton from its hierarchy and the bind pose of each joint
+	//		relative to its parent; bind poses must be rigid (rotation and
+	//		translation only).
+	//	param skeleton_out: non-null pointer to uninitialized skeleton
+	//	param parentIndex: non-null array of jointCount parent indices;
+	//		each is -1 or less than the joint's own index
+	//	param bindLocal: non-null array of jointCount column-major 4x4
+	//		matrices, 16 floats each
+	//	param jointCount: non-zero number of joints, up to max
+	//	return: number of joints if success
+	//	return: -1 if invalid params or skeleton already initialized
+	a3ret a3skeletonCreate(a3_Skeleton *skeleton_out, const a3i32 *parentIndex, const a3f32 *bindLocal, const a3ui32 jointCount);
+
+	// A3: Solve the palette of one character: concatenate local poses down
+	//		the hierarchy, remove the bind pose and store each joint in the
+	//		requested layout.
+	//	param skeleton: non-null pointer to initialized skeleton
+	//	param palette_out: non-null array of jointCount * method vec4
+	//	param localPose: non-null array of jointCount column-major 4x4
+	//		matrices relative to parent; rigid for dual quaternions
+	//	param root_opt: optional column-major 4x4 matrix placing the
+	//		character; pass null for identity
+	//	param method: palette layout
+	//	return: number of joints if success
+	//	return: -1 if invalid params or skeleton not initialized
+	a3ret a3skeletonSolvePalette(const a3_Skeleton *skeleton, a3f32(*palette_out)[4], const a3f32 *localPose, const a3f32 *root_opt, const a3_SkinningMethod method);
+
+	// A3: Pack four influences per vertex: indices become bytes and weights
+	//		become 16-bit fractions whose sum is exactly one, the rounding
+	//		residual going to the largest weight. Accepts the float weights
+	//		and integer indices of geometry blending data.
+	//	param index_out: non-null array of count packed index sets
+	//	param weight_out: non-null array of count packed weight sets
+	//	param weight: non-null array of count * 4 weights
+	//	param index: non-null array of count * 4 joint indices, each less
+	//		than a3skin_jointMax
+	//	param count: number of vertices
+	//	return: number of vertices with no weight (bound to joint 0)
+	//	return: -1 if invalid params
+	a3ret a3skinPackInfluences(a3ubyte(*index_out)[4], a3ui16(*weight_out)[4], const a3f32 *weight, const a3i32 *index, const a3ui32 count);
+
+	// A3: Deform vertices on the CPU, same math as the vertex shader.
+	//	param palette: non-null palette in the given layout
+	//	param method: palette layout
+	//	param index, weight: non-null packed influences of count vertices
+	//	param position, normal_opt: non-null bind positions and optional
+	//		normals of count vertices
+	//	param position_out, normal_out_opt: non-null deformed positions and
+	//		optional normals (used if both normal arrays are provided)
+	//	param count: number of vertices
+	//	return: number of vertices deformed if success
+	//	return: -1 if invalid params
+	a3ret a3skinDeform(const a3f32(*palette)[4], const a3_SkinningMethod method, const a3ubyte(*index)[4], const a3ui16(*weight)[4], const a3f32(*position)[3], const a3f32(*normal_opt)[3], a3f32(*position_out)[3], a3f32(*normal_out_opt)[3], const a3ui32 count);
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Store packed influences after the vertices of a vertex array and 
+	//		attach them as blend weight (normalized) and blend index (integer)
+	//		attributes; vertex formats only describe 32- and 64-bit elements.
+	//	param vertexArray: non-null pointer to initialized vertex array whose 
+	//		format does not use the blend weight and index attributes; its 
+	//		vertex buffer must have room for count * 12 more bytes
+	//	param index, weight: non-null packed influences of count vertices, 
+	//		in the same order as the vertices
+	//	param count: number of vertices
+	//	return: byte offset of the influences in the vertex buffer if success
+	//	return: -1 if invalid params, vertex array not initialized or buffer 
+	//		is full
+	a3ret a3skinVertexArrayStoreInfluences(a3_VertexArrayDescriptor *vertexArray, const a3ubyte(*index)[4], const a3ui16(*weight)[4], const a3ui32 count);
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Create palette ring; requires storage buffers (GL 4.3).
+	//	param ring_out: non-null pointer to uninitialized ring
+	//	param segmentSize: non-zero size of each segment in bytes, enough for
+	//		every palette uploaded in one frame
+	//	param segmentCount: number of segments, between 1 and max; use one
+	//		more than the frames the GPU may lag behind
+	//	return: 1 if success with persistently mapped ring
+	//	return: 0 if success without mapping (sub-data uploads) or if not
+	//		supported, in which case the ring is not initialized
+	//	return: -1 if invalid params or ring already initialized
+	a3ret a3skinPaletteRingCreate(a3_SkinPaletteRing *ring_out, const a3ui32 segmentSize, const a3ui32 segmentCount);
+
+	// A3: Start writing the next segment, waiting for the GPU to finish
+	//		the frame that last used it.
+	//	param ring: non-null pointer to initialized ring
+	//	return: 1 if the segment was still in use and had to be waited for
+	//	return: 0 if the segment was free
+	//	return: -1 if invalid params or ring not initialized
+	a3ret a3skinPaletteRingBeginFrame(a3_SkinPaletteRing *ring);
+
+	// A3: Copy palettes into the current segment.
+	//	param ring: non-null pointer to initialized ring
+	//	param palette: non-null palette data
+	//	param size: non-zero size of palette data in bytes
+	//	return: byte offset of data in buffer, to be passed to render
+	//	return: -1 if invalid params, ring not initialized or segment full
+	a3ret a3skinPaletteRingUpload(a3_SkinPaletteRing *ring, const void *palette, const a3ui32 size);
+
+	// A3: Fence the current segment after the last draw reading it.
+	//	param ring: non-null pointer to initialized ring
+	//	return: 1 if success
+	//	return: -1 if invalid params or ring not initialized
+	a3ret a3skinPaletteRingEndFrame(a3_SkinPaletteRing *ring);
+
+	// A3: Draw skinned instances; the active program reads the palettes
+	//		of instance i at (i * jointCount) joints from the given offset.
+	//	param ring: non-null pointer to initialized ring
+	//	param drawable: non-null pointer to drawable with packed influences
+	//	param offset: palette offset returned by upload
+	//	param size: size of uploaded palettes in bytes
+	//	param jointCount: joints per palette
+	//	param instanceCount: number of characters
+	//	return: 1 if success
+	//	return: -1 if invalid params or ring not initialized
+	a3ret a3skinPaletteRingRender(const a3_SkinPaletteRing *ring, const a3_VertexDrawable *drawable, const a3ui32 offset, const a3ui32 size, const a3ui32 jointCount, const a3ui32 instanceCount);
+
+	// A3: Release palette ring.
+	//	param ring: non-null pointer to initialized ring
+	//	return: 1 if success
+	//	return: -1 if invalid params or ring not initialized
+	a3ret a3skinPaletteRingRelease(a3_SkinPaletteRing *ring);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_SKINNING_H
@@ -0,0 +1,196 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_TextureAtlasPacker.h
+	Texture atlas baking: packs a set of source images into one atlas 
+		image (MaxRects, best short side fit) with mip-safe gutters, and 
+		produces the cell table used by a3_TextureAtlas.
+*/
+
+#ifndef __ANIMAL3D_TEXTUREATLASPACKER_H
+#define __ANIMAL3D_TEXTUREATLASPACKER_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D-A3DG/a3graphics/a3_TextureAtlas.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_TextureAtlasPacker		a3_TextureAtlasPacker;
+	typedef struct a3_TextureAtlasPackerEntry	a3_TextureAtlasPackerEntry;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Packer limits.
+	enum
+	{
+		a3textureAtlasPacker_nameLength = 32,
+		a3textureAtlasPacker_mipLevelsMax = 8,
+	};
+
+
+	// A3: Source image added to packer.
+	//	member pixels: rgba8 copy of source, bottom row first
+	//	members width, height: source dimensions
+	//	members slotX, slotY, slotW, slotH: aligned slot in atlas holding 
+	//		the image and its gutter; slotW is zero if not packed
+	//	member name: short name (file name without extension)
+	struct a3_TextureAtlasPackerEntry
+	{
+		a3ubyte *pixels;
+		a3ui32 width, height;
+		a3ui32 slotX, slotY, slotW, slotH;
+		a3byte name[a3textureAtlasPacker_nameLength];
+	};
+
+	// A3: Atlas packer.
+	//	member entry: source images, in the order they were added; cell 
+	//		indices follow this order
+	//	members entryCount, entryCapacity: number of images and allocated 
+	//		entries
+	//	members widthMax, heightMax: largest atlas allowed
+	//	member padding: minimum gutter around each image; gutters repeat 
+	//		the image's edge pixels
+	//	member alignment: slot position and size granularity in pixels
+	//	member pixels: baked rgba8 atlas, bottom row first (null until packed)
+	//	members width, height: baked atlas dimensions
+	//	member packedCount: number of images placed in the atlas
+	struct a3_TextureAtlasPacker
+	{
+		a3_TextureAtlasPackerEntry *entry;
+		a3ui32 entryCount, entryCapacity;
+		a3ui32 widthMax, heightMax;
+		a3ui32 padding, alignment;
+		a3ubyte *pixels;
+		a3ui32 width, height;
+		a3ui32 packedCount;
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Initialize packer.
+	//	param packer_out: non-null pointer to uninitialized packer
+	//	params widthMax, heightMax: largest atlas allowed; powers of two
+	//	param padding: minimum gutter around each image in pixels; to keep 
+	//		filtered samples inside the gutter at every safe mip level, use 
+	//		at least 1 << (mipLevelsSafe - 1)
+	//	param mipLevelsSafe: number of mip levels below the base that never 
+	//		mix neighbouring slots (slots are aligned to 1 << mipLevelsSafe 
+	//		pixels); at least 2 keeps each 4x4 compression block to one slot
+	//	return: 1 if success
+	//	return: -1 if invalid params or packer in use
+	a3ret a3textureAtlasPackerCreate(a3_TextureAtlasPacker *packer_out, const a3ui32 widthMax, const a3ui32 heightMax, const a3ui32 padding, const a3ui32 mipLevelsSafe);
+
+	// A3: Add image from memory; pixels are copied.
+	//	param packer: non-null pointer to initialized packer
+	//	param name_opt: optional cstring name; max 31 chars + null terminator
+	//	param pixels: non-null pointer to rgba8 pixels, bottom row first
+	//	params width, height: positive image dimensions
+	//	return: index of image (and its cell) if success
+	//	return: -1 if invalid params or allocation failed
+	a3ret a3textureAtlasPackerAddImage(a3_TextureAtlasPacker *packer, const a3byte *name_opt, const a3ubyte *pixels, const a3ui32 width, const a3ui32 height);
+
+	// A3: Add image file (PNG or TGA); named after the file.
+	//	param packer: non-null pointer to initialized packer
+	//	param filePath: non-null, valid cstring of file path to load from
+	//	return: index of image (and its cell) if success
+	//	return: -1 if invalid params or file could not be decoded
+	a3ret a3textureAtlasPackerAddFile(a3_TextureAtlasPacker *packer, const a3byte *filePath);
+
+	// A3: Add all PNG and TGA files in a directory, in file name order.
+	//	param packer: non-null pointer to initialized packer
+	//	param directoryPath: non-null, valid cstring of directory path
+	//	return: number of images added
+	//	return: -1 if invalid params
+	a3ret a3textureAtlasPackerAddDirectory(a3_TextureAtlasPacker *packer, const a3byte *directoryPath);
+
+	// A3: Pack all images and bake the atlas; the atlas starts at the 
+	//		smallest power-of-two size that could hold every slot and grows 
+	//		until everything fits or the maximum size is reached.
+	//	param packer: non-null pointer to initialized packer with images
+	//	return: number of images packed; less than entryCount if the 
+	//		maximum atlas size is too small
+	//	return: -1 if invalid params
+	a3ret a3textureAtlasPackerPack(a3_TextureAtlasPacker *packer);
+
+	// A3: Find image index by name.
+	//	param packer: non-null pointer to initialized packer
+	//	param name: non-null cstring name
+	//	return: index of image if found
+	//	return: -1 if not found or invalid params
+	a3ret a3textureAtlasPackerFindImage(const a3_TextureAtlasPacker *packer, const a3byte *name);
+
+	// A3: Allocate and fill atlas cells, one per image (unpacked images get 
+	//		empty cells); texture is not set.
+	//	param textureAtlas_out: non-null pointer to texture atlas without cells
+	//	param packer: non-null pointer to packed packer
+	//	return: number of cells if success
+	//	return: -1 if invalid params or not packed
+	a3ret a3textureAtlasPackerGetCells(a3_TextureAtlas *textureAtlas_out, const a3_TextureAtlasPacker *packer);
+
+	// A3: Save baked atlas image as run-length encoded 32-bit TGA.
+	//	param packer: non-null pointer to packed packer
+	//	param filePath: non-null, valid cstring of file path to write to
+	//	return: number of bytes written if success
+	//	return: 0 if file could not be opened
+	//	return: -1 if invalid params or not packed
+	a3ret a3textureAtlasPackerSaveImage(const a3_TextureAtlasPacker *packer, const a3byte *filePath);
+
+	// A3: Save cell table in the binary format read by 
+	//		a3textureAtlasLoadDataBinary.
+	//	param packer: non-null pointer to packed packer
+	//	param filePath: non-null, valid cstring of file path to write to
+	//	return: number of bytes written if success
+	//	return: 0 if file could not be opened
+	//	return: -1 if invalid params or not packed
+	a3ret a3textureAtlasPackerSaveCells(const a3_TextureAtlasPacker *packer, const a3byte *filePath);
+
+	// A3: Save cell table in the ASCII format read by 
+	//		a3textureAtlasLoadCells; each cell line ends with its image name.
+	//	param packer: non-null pointer to packed packer
+	//	param filePath: non-null, valid cstring of file path to write to
+	//	return: number of cells written if success
+	//	return: 0 if file could not be opened
+	//	return: -1 if invalid params or not packed
+	a3ret a3textureAtlasPackerSaveCellsText(const a3_TextureAtlasPacker *packer, const a3byte *filePath);
+
+	// A3: Release images and baked atlas.
+	//	param packer: non-null pointer to packer
+	//	return: 1 if released
+	//	return: 0 if packer was unused
+	//	return: -1 if invalid params
+	a3ret a3textureAtlasPackerRelease(a3_TextureAtlasPacker *packer);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_TEXTUREATLASPACKER_H
@@ -0,0 +1,199 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_TextureCompressed.h
+	Texture conditioning: CPU mip chain generation, block compression 
+		(BC1, BC3, BC5, BC7) and a small container file that stores every 
+		level ready to be uploaded without decoding.
+*/
+
+#ifndef __ANIMAL3D_TEXTURECOMPRESSED_H
+#define __ANIMAL3D_TEXTURECOMPRESSED_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D-A3DG/a3graphics/a3_Texture.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_TextureCompressedImage	a3_TextureCompressedImage;
+	typedef enum a3_TextureBlockFormat			a3_TextureBlockFormat;
+	typedef enum a3_TextureMipFilter			a3_TextureMipFilter;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Compressed image limits.
+	enum
+	{
+		a3textureCompressed_levelMax = 16,
+	};
+
+	// A3: Storage format of compressed image levels.
+	enum a3_TextureBlockFormat
+	{
+		a3tex_blockNone,		// uncompressed rgba8 levels
+		a3tex_bc1,				// rgb (1-bit alpha), 8 bytes per 4x4 block
+		a3tex_bc3,				// rgba, 16 bytes per block
+		a3tex_bc5,				// two channels (normal map xy), 16 bytes per block
+		a3tex_bc7,				// high quality rgba, 16 bytes per block
+	};
+
+	// A3: Filter used to downsample each mip level from the previous one.
+	enum a3_TextureMipFilter
+	{
+		a3tex_mipBox,			// average of source footprint; fastest
+		a3tex_mipKaiser,		// Kaiser-windowed sinc; sharper minification
+	};
+
+
+	// A3: Compressed image with full mip chain in client memory.
+	//	member data: all levels, largest first
+	//	member dataSize: total size of data in bytes
+	//	member format: block format of levels
+	//	members width, height: dimensions of base level
+	//	member levelCount: number of levels stored
+	//	members levelOffset, levelSize: location of each level in data
+	struct a3_TextureCompressedImage
+	{
+		a3ubyte *data;
+		a3ui32 dataSize;
+		a3_TextureBlockFormat format;
+		a3ui32 width, height;
+		a3ui32 levelCount;
+		a3ui32 levelOffset[a3textureCompressed_levelMax];
+		a3ui32 levelSize[a3textureCompressed_levelMax];
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Downsample one rgba8 image level.
+	//	param pixels_out: non-null pointer to destination of at least 
+	//		dstWidth * dstHeight * 4 bytes
+	//	params dstWidth, dstHeight: positive destination dimensions
+	//	param pixels: non-null pointer to source rgba8 pixels
+	//	params width, height: positive source dimensions
+	//	param mipFilter: downsampling filter
+	//	return: 1 if success
+	//	return: -1 if invalid params
+	a3ret a3textureCompressedDownsample(a3ubyte *pixels_out, const a3ui32 dstWidth, const a3ui32 dstHeight, const a3ubyte *pixels, const a3ui32 width, const a3ui32 height, const a3_TextureMipFilter mipFilter);
+
+	// A3: Encode one rgba8 image level into blocks; partial blocks at the 
+	//		right and top edges repeat the edge pixels.
+	//	param blocks_out: non-null pointer to destination of at least 
+	//		a3textureCompressedLevelSize(format, width, height) bytes
+	//	param pixels: non-null pointer to rgba8 pixels
+	//	params width, height: positive image dimensions
+	//	param format: block format; bc5 encodes red and green only
+	//	return: number of bytes written if success
+	//	return: -1 if invalid params
+	a3ret a3textureCompressedEncodeLevel(a3ubyte *blocks_out, const a3ubyte *pixels, const a3ui32 width, const a3ui32 height, const a3_TextureBlockFormat format);
+
+	// A3: Get the storage size of one level.
+	//	param format: block format
+	//	params width, height: positive level dimensions
+	//	return: size of level in bytes
+	//	return: 0 if invalid params
+	a3ui32 a3textureCompressedLevelSize(const a3_TextureBlockFormat format, const a3ui32 width, const a3ui32 height);
+
+	// A3: Build mip chain and encode every level.
+	//	param image_out: non-null pointer to unused compressed image
+	//	param pixels: non-null pointer to rgba8 pixels, bottom row first
+	//	params width, height: positive image dimensions
+	//	param format: block format
+	//	param mipFilter: downsampling filter
+	//	param levelCountMax: maximum number of levels; pass zero for the 
+	//		full chain down to 1x1
+	//	return: number of levels if success
+	//	return: 0 if allocation failed
+	//	return: -1 if invalid params or image in use
+	a3ret a3textureCompressedCreate(a3_TextureCompressedImage *image_out, const a3ubyte *pixels, const a3ui32 width, const a3ui32 height, const a3_TextureBlockFormat format, const a3_TextureMipFilter mipFilter, const a3ui32 levelCountMax);
+
+	// A3: Decode an image file with the image library, then build mip chain 
+	//		and encode every level; the image library is not re-entrant.
+	//	param image_out: non-null pointer to unused compressed image
+	//	param filePath: non-null, valid cstring of source image path
+	//	param format: block format
+	//	param mipFilter: downsampling filter
+	//	return: number of levels if success
+	//	return: 0 if decode or allocation failed
+	//	return: -1 if invalid params or image in use
+	a3ret a3textureCompressedCreateFromFile(a3_TextureCompressedImage *image_out, const a3byte *filePath, const a3_TextureBlockFormat format, const a3_TextureMipFilter mipFilter);
+
+	// A3: Save compressed image to container file.
+	//	param image: non-null pointer to compressed image
+	//	param filePath: non-null, valid cstring of file path to save to
+	//	return: number of bytes written if success
+	//	return: 0 if file could not be written
+	//	return: -1 if invalid params or image unused
+	a3ret a3textureCompressedSaveFile(const a3_TextureCompressedImage *image, const a3byte *filePath);
+
+	// A3: Load compressed image from container file.
+	//	param image_out: non-null pointer to unused compressed image
+	//	param filePath: non-null, valid cstring of file path to load from
+	//	return: number of levels if success
+	//	return: 0 if file is missing or not a valid container
+	//	return: -1 if invalid params or image in use
+	a3ret a3textureCompressedLoadFile(a3_TextureCompressedImage *image_out, const a3byte *filePath);
+
+	// A3: Release compressed image data.
+	//	param image: non-null pointer to compressed image
+	//	return: 1 if released
+	//	return: 0 if image was unused
+	//	return: -1 if invalid params
+	a3ret a3textureCompressedRelease(a3_TextureCompressedImage *image);
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Create texture from compressed image; all levels are uploaded as 
+	//		stored and the texture's level range is limited to them.
+	//	param texture_out: non-null pointer to uninitialized texture
+	//	param name_opt: optional cstring for short name/description; max 31 
+	//		chars + null terminator; pass null for default name
+	//	param image: non-null pointer to compressed image
+	//	return: 1 if successful creation
+	//	return: 0 if creation failed
+	//	return: -1 if invalid params or already initialized
+	a3ret a3textureCreateFromCompressed(a3_Texture *texture_out, const a3byte name_opt[32], const a3_TextureCompressedImage *image);
+
+	// A3: Change filter settings for active texture, blending between mip 
+	//		levels on minification if the texture has more than one.
+	//	param filterOption: which filter mode to use
+	//	return: 1 if mip levels are used
+	//	return: 0 if texture has a single level
+	a3ret a3textureChangeFilterModeMipmap(const a3_TextureFilterOption filterOption);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_TEXTURECOMPRESSED_H
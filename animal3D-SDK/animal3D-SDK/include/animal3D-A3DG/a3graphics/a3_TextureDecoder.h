@@ -0,0 +1,101 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_TextureDecoder.h
+	Built-in image decoder for PNG and TGA files; decodes straight into 
+		the pixel layout textures are created from (rgb/rgba, 8 or 16 bits 
+		per channel, bottom row first) without the image library.
+*/
+
+#ifndef __ANIMAL3D_TEXTUREDECODER_H
+#define __ANIMAL3D_TEXTUREDECODER_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D-A3DG/a3graphics/a3_Texture.h"
+#include "animal3D-A3DG/a3graphics/a3_TextureStream.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Decode PNG or TGA image from memory.
+	//		PNG: all color types and bit depths, not interlaced.
+	//		TGA: 8-bit grey, 24 and 32-bit color, raw or run-length encoded.
+	//	param image_out: non-null pointer to unused image
+	//	param data: non-null pointer to encoded file contents
+	//	param size: size of file contents in bytes
+	//	return: 1 if image was decoded (pixels allocated with malloc)
+	//	return: 0 if format is not supported or data is corrupt
+	//	return: -1 if invalid params or image in use
+	a3ret a3textureDecodeMemory(a3_TextureStreamImage *image_out, const a3ubyte *data, const a3ui32 size);
+
+	// A3: Decode PNG or TGA image file; re-entrant, so it may be used as 
+	//		a texture stream decoder.
+	//	param image_out: non-null pointer to unused image
+	//	param filePath: non-null, valid cstring of file path to load from
+	//	return: 1 if image was decoded (pixels allocated with malloc)
+	//	return: 0 if file is missing, not supported or corrupt
+	//	return: -1 if invalid params or image in use
+	a3ret a3textureDecodeFile(a3_TextureStreamImage *image_out, const a3byte *filePath);
+
+	// A3: Decode image file with the image library (DevIL), converted to 
+	//		the same layout as the built-in decoder; not re-entrant.
+	//	param image_out: non-null pointer to unused image
+	//	param filePath: non-null, valid cstring of file path to load from
+	//	return: 1 if image was decoded (pixels allocated with malloc)
+	//	return: 0 if load failed
+	//	return: -1 if invalid params or image in use
+	a3ret a3textureDecodeFileImageLibrary(a3_TextureStreamImage *image_out, const a3byte *filePath);
+
+	// A3: Release decoded image pixels.
+	//	param image: non-null pointer to image
+	//	return: 1 if released
+	//	return: 0 if image was unused
+	//	return: -1 if invalid params
+	a3ret a3textureDecodeRelease(a3_TextureStreamImage *image);
+
+	// A3: Load texture from image file with the built-in decoder; files it 
+	//		does not support are loaded with the image library instead.
+	//	param texture_out: non-null pointer to uninitialized texture
+	//	param name_opt: optional cstring for short name/description; max 31 
+	//		chars + null terminator; pass null for default name
+	//	param filePath: non-null, valid cstring of file path to load form
+	//	return: 1 if successful load
+	//	return: 0 if load failed
+	//	return: -1 if invalid params or already initialized
+	a3ret a3textureCreateFromFileNative(a3_Texture *texture_out, const a3byte name_opt[32], const a3byte *filePath);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_TEXTUREDECODER_H
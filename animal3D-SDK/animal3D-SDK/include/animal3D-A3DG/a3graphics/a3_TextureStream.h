@@ -0,0 +1,228 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_TextureStream.h
+	Asynchronous texture streaming: images are decoded on a worker thread 
+		and uploaded in time-sliced chunks through a ring of persistently 
+		mapped pixel buffers; textures show a placeholder until resident.
+*/
+
+#ifndef __ANIMAL3D_TEXTURESTREAM_H
+#define __ANIMAL3D_TEXTURESTREAM_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3utility/a3_Thread.h"
+#include "animal3D-A3DG/a3graphics/a3_Texture.h"
+#include "animal3D-A3DG/a3graphics/a3_TextureCompressed.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_TextureStream				a3_TextureStream;
+	typedef struct a3_TextureStreamRequest		a3_TextureStreamRequest;
+	typedef struct a3_TextureStreamImage		a3_TextureStreamImage;
+	typedef enum a3_TextureStreamState			a3_TextureStreamState;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Stream limits.
+	enum
+	{
+		a3textureStream_requestMax = 32,
+		a3textureStream_segmentMax = 4,
+		a3textureStream_pathMax = 256,
+	};
+
+	// A3: Stages of a stream request; each stage is owned by one thread: 
+	//	queued and decoding belong to the worker, the rest to the caller.
+	enum a3_TextureStreamState
+	{
+		a3textureStream_unused,
+		a3textureStream_queued,			// waiting for worker
+		a3textureStream_decoding,		// worker is decoding
+		a3textureStream_decoded,		// pixels or levels ready for upload
+		a3textureStream_uploading,		// rows or levels being uploaded over frames
+		a3textureStream_resident,		// texture swapped in
+		a3textureStream_failed,			// decode failed, placeholder kept
+	};
+
+
+	// A3: Decoded image in client memory.
+	//	member pixels: tightly packed rows, bottom row first
+	//	members width, height: image dimensions
+	//	members channels, bytes: channels per pixel, bytes per channel
+	struct a3_TextureStreamImage
+	{
+		a3byte *pixels;
+		a3ui32 width, height;
+		a3ui32 channels, bytes;
+	};
+
+	// A3: Image decoder alias; called on the worker thread.
+	//	-> returns 1 if image was decoded, otherwise 0
+	//	-> file path parameter, image output (pixels allocated with malloc)
+	typedef a3ret(*a3_TextureStreamDecodeFunc)(a3_TextureStreamImage *, const a3byte *);
+
+
+	// A3: Single texture stream request.
+	//	member texture: texture that receives the image; holds placeholder 
+	//		until resident
+	//	member image: decoded image, released once resident; kept for 
+	//		compressed requests in case the format cannot be uploaded
+	//	member compressed: mip chain built and encoded by the worker if 
+	//		requested compressed, released once resident
+	//	members blockFormat, mipFilter: requested compression
+	//	member compress: request is compressed
+	//	member stagingHandle: texture object rows are uploaded into
+	//	member rowsUploaded: progress of time-sliced upload; counts levels 
+	//		instead of rows if compressed
+	//	member filePath: path of image file
+	//	member state: current stage of request
+	struct a3_TextureStreamRequest
+	{
+		a3_Texture *texture;
+		a3_TextureStreamImage image[1];
+		a3_TextureCompressedImage compressed[1];
+		a3_TextureBlockFormat blockFormat;
+		a3_TextureMipFilter mipFilter;
+		a3boolean compress;
+		a3ui32 stagingHandle;
+		a3ui32 rowsUploaded;
+		a3byte filePath[a3textureStream_pathMax];
+		volatile a3_TextureStreamState state;
+	};
+
+	// A3: Texture streamer.
+	//	member request: fixed array of requests
+	//	member requestCount: number of requests issued
+	//	member worker: decode thread
+	//	member decodeFunc: decoder used by worker; null for default
+	//	member pbo: pixel unpack buffer used as upload ring
+	//	member pboMapped: persistent mapping of ring (null if unavailable, 
+	//		in which case rows are uploaded directly from client memory)
+	//	members segmentSize, segmentCount, segmentIndex: ring layout and 
+	//		next segment to write
+	//	member segmentFence: fence per segment; segment is reused only after 
+	//		the upload reading it has completed
+	//	member bytesUploaded: total bytes uploaded by stream
+	//	member workerExit: flag raised to stop worker early
+	struct a3_TextureStream
+	{
+		a3_TextureStreamRequest request[a3textureStream_requestMax];
+		a3ui32 requestCount;
+		a3_Thread worker[1];
+		a3_TextureStreamDecodeFunc decodeFunc;
+		a3ui32 pbo;
+		a3byte *pboMapped;
+		a3ui32 segmentSize, segmentCount, segmentIndex;
+		void *segmentFence[a3textureStream_segmentMax];
+		a3ui64 bytesUploaded;
+		volatile a3boolean workerExit;
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// A3: Create texture streamer and upload ring.
+	//	param stream_out: non-null pointer to uninitialized streamer
+	//	param segmentSize: non-zero size of each ring segment in bytes
+	//	param segmentCount: number of ring segments; between 1 and 
+	//		a3textureStream_segmentMax
+	//	param decodeFunc_opt: optional image decoder; pass null to use the 
+	//		built-in PNG/TGA decoder, which falls back to the image library 
+	//		for other files; the image library is not re-entrant, so avoid 
+	//		loading such textures synchronously while decodes are pending
+	//	return: 1 if success with persistently mapped ring
+	//	return: 0 if success without ring (direct uploads)
+	//	return: -1 if invalid params or already created
+	a3ret a3textureStreamCreate(a3_TextureStream *stream_out, const a3ui32 segmentSize, const a3ui32 segmentCount, const a3_TextureStreamDecodeFunc decodeFunc_opt);
+
+	// A3: Request texture; a placeholder texture is created immediately and 
+	//		replaced once the image has been decoded and uploaded; the 
+	//		placeholder has two levels, so mipmap filtering applied to it 
+	//		carries over and a mip chain is generated for the image.
+	//	param stream: non-null pointer to initialized streamer
+	//	param texture_out: non-null pointer to uninitialized texture
+	//	param name_opt: optional name for texture
+	//	param filePath: non-null, non-empty cstring of image file path
+	//	return: request index if success
+	//	return: -1 if invalid params or request limit reached
+	a3ret a3textureStreamRequest(a3_TextureStream *stream, a3_Texture *texture_out, const a3byte name_opt[32], const a3byte *filePath);
+
+	// A3: Request block-compressed texture; the worker also builds the mip 
+	//		chain and encodes every level, which are then uploaded one level 
+	//		at a time; falls back to uncompressed if the format is not 
+	//		supported by the driver.
+	//	param stream: non-null pointer to initialized streamer
+	//	param texture_out: non-null pointer to uninitialized texture
+	//	param name_opt: optional name for texture
+	//	param filePath: non-null, non-empty cstring of image file path
+	//	param format: block format
+	//	param mipFilter: downsampling filter
+	//	return: request index if success
+	//	return: -1 if invalid params or request limit reached
+	a3ret a3textureStreamRequestCompressed(a3_TextureStream *stream, a3_Texture *texture_out, const a3byte name_opt[32], const a3byte *filePath, const a3_TextureBlockFormat format, const a3_TextureMipFilter mipFilter);
+
+	// A3: Advance uploads; call once per frame with a rendering context.
+	//	param stream: non-null pointer to initialized streamer
+	//	param byteBudget: max bytes to upload this call; at least one row 
+	//		(or level) of the current request is always uploaded
+	//	return: number of requests not yet resident or failed
+	//	return: -1 if invalid params
+	a3ret a3textureStreamUpdate(a3_TextureStream *stream, const a3ui32 byteBudget);
+
+	// A3: Wait for the worker to finish decoding queued requests; use 
+	//		before hotloading so the worker is not running unloaded code.
+	//	param stream: non-null pointer to initialized streamer
+	//	return: 1 if worker was waited for
+	//	return: 0 if worker was not launched
+	//	return: -1 if invalid params
+	a3ret a3textureStreamWait(a3_TextureStream *stream);
+
+	// A3: Check whether a texture's stream request has completed.
+	//	param stream: non-null pointer to initialized streamer
+	//	param texture: non-null pointer to texture
+	//	return: 1 if texture is resident or was not streamed
+	//	return: 0 if texture still shows placeholder
+	//	return: -1 if invalid params
+	a3ret a3textureStreamIsResident(const a3_TextureStream *stream, const a3_Texture *texture);
+
+	// A3: Release streamer: stop worker, drop pending requests (textures 
+	//		keep their placeholder) and release upload ring.
+	//	param stream: non-null pointer to initialized streamer
+	//	return: number of requests dropped if success
+	//	return: -1 if invalid params
+	a3ret a3textureStreamRelease(a3_TextureStream *stream);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_TEXTURESTREAM_H
@@ -0,0 +1,96 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	bloomBlur_cs4x.glsl
+	9-tap Gaussian blur for bloom along one axis per dispatch, like the 
+		fragment blur: each work group takes a strip of texels on one line 
+		along the axis (row, column or diagonal), loads the strip and its 
+		apron into shared memory once, then each thread sums its taps from 
+		shared memory. Only texels on the line are fetched.
+*/
+
+#version 430
+
+#define STRIP_SIZE	64
+#define RADIUS		4
+#define STRIP_APRON	(STRIP_SIZE + RADIUS * 2)
+
+layout (local_size_x = STRIP_SIZE) in;
+
+// source level, its reciprocal size and the blur axis in texels
+// dispatch: x = strips per line, y = lines along the axis
+uniform sampler2D uImage00;
+uniform vec2 uSize;
+uniform vec2 uAxis;
+
+// blurred result, same size as source
+layout (rgba8, binding = 0) uniform writeonly image2D uImageOut;
+
+shared vec4 sStrip[STRIP_APRON];
+
+// binomial kernel (1 8 28 56 70 56 28 8 1) / 256
+const float kWeight[RADIUS + 1] = float[](
+	70.0 / 256.0, 56.0 / 256.0, 28.0 / 256.0, 8.0 / 256.0, 1.0 / 256.0);
+
+void main()
+{
+	ivec2 size = imageSize(uImageOut), axis = ivec2(sign(uAxis)), start;
+	int local = int(gl_LocalInvocationID.x), line = int(gl_WorkGroupID.y);
+	int first = int(gl_WorkGroupID.x) * STRIP_SIZE, count, i;
+	vec4 color;
+
+	// kernel is symmetric: walk every line left to right (or downward)
+	if (axis.x < 0 || (axis.x == 0 && axis.y < 0))
+		axis = -axis;
+
+	// first texel and length of this line: rows and columns in order; 
+	//	diagonals enter from the left edge, then the top or bottom edge
+	if (axis.y == 0)
+	{
+		start = ivec2(0, line);
+		count = size.x;
+	}
+	else if (axis.x == 0)
+	{
+		start = ivec2(line, 0);
+		count = size.y;
+	}
+	else
+	{
+		start = line < size.y ? ivec2(0, line)
+			: ivec2(line - size.y + 1, axis.y > 0 ? 0 : size.y - 1);
+		count = min(size.x - start.x, axis.y > 0 ? size.y - start.y : start.y + 1);
+	}
+
+	// load strip plus apron, sampling texel centers (edges clamp); 
+	//	strips past the end of a short diagonal load nothing
+	if (first < count)
+		for (i = local; i < STRIP_APRON; i += STRIP_SIZE)
+			sStrip[i] = textureLod(uImage00, 
+				(vec2(start + (first + i - RADIUS) * axis) + 0.5) * uSize, 0.0);
+	barrier();
+
+	// blur along axis
+	color = kWeight[0] * sStrip[local + RADIUS];
+	for (i = 1; i <= RADIUS; ++i)
+		color += kWeight[i] * (sStrip[local + RADIUS + i] + sStrip[local + RADIUS - i]);
+	if (first + local < count)
+		imageStore(uImageOut, start + (first + local) * axis, color);
+}
@@ -0,0 +1,55 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	bloomComposite_cs4x.glsl
+	Upsample blurred bloom levels and accumulate them over the scene 
+		using the screen function.
+*/
+
+#version 430
+
+#define TILE_SIZE	16
+
+layout (local_size_x = TILE_SIZE, local_size_y = TILE_SIZE) in;
+
+// scene, then blurred half-, quarter- and eighth-size levels
+uniform sampler2D uImage00;
+uniform sampler2D uImage01;
+uniform sampler2D uImage02;
+uniform sampler2D uImage03;
+
+// reciprocal of output size
+uniform vec2 uSize;
+
+// final composite
+layout (rgba8, binding = 0) uniform writeonly image2D uImageOut;
+
+void main()
+{
+	ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+	vec2 uv = (vec2(texel) + 0.5) * uSize;
+
+	// screen: 1 - (1 - a)(1 - b)...
+	vec3 inverse = 1.0 - texelFetch(uImage00, texel, 0).rgb;
+	inverse *= 1.0 - textureLod(uImage01, uv, 0.0).rgb;
+	inverse *= 1.0 - textureLod(uImage02, uv, 0.0).rgb;
+	inverse *= 1.0 - textureLod(uImage03, uv, 0.0).rgb;
+	imageStore(uImageOut, texel, vec4(1.0 - inverse, 1.0));
+}
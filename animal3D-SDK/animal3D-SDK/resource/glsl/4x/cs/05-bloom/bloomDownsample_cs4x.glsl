@@ -0,0 +1,58 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	bloomDownsample_cs4x.glsl
+	Bright pass and downsample for one bloom level: each thread produces 
+		one texel from a 2x2 bilinear box of the previous level, matching 
+		the fragment bright pass drawn at the smaller size.
+*/
+
+#version 430
+
+#define TILE_SIZE	16
+
+layout (local_size_x = TILE_SIZE, local_size_y = TILE_SIZE) in;
+
+// previous level (scene composite or blurred level) and its reciprocal size
+uniform sampler2D uImage00;
+uniform vec2 uSize;
+
+// this level's bright pass target
+// format must match post-processing framebuffer color type
+layout (rgba8, binding = 0) uniform writeonly image2D uImageOut;
+
+const vec3 kLuminance = vec3(0.2126, 0.7152, 0.0722);
+
+// keep bright areas, roll off dark areas smoothly
+vec4 brightPass(in vec4 color)
+{
+	float lum = dot(color.rgb, kLuminance);
+	return vec4(color.rgb * smoothstep(0.25, 1.0, lum), 1.0);
+}
+
+void main()
+{
+	ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+
+	// sample at the shared corner of four source texels: 
+	//	one bilinear fetch yields the 2x2 box average
+	if (all(lessThan(texel, imageSize(uImageOut))))
+		imageStore(uImageOut, texel, brightPass(textureLod(uImage00, vec2(texel * 2 + 1) * uSize, 0.0)));
+}
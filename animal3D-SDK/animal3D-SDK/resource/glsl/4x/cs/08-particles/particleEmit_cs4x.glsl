@@ -0,0 +1,79 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	particleEmit_cs4x.glsl
+	Spawn new particles after the survivors in the target pool; each 
+		takes its random stream from its emission number, so the same 
+		particles come out regardless of where they land.
+*/
+
+#version 430
+
+#include "../inc/particle_cs4x.glsl"
+
+layout (local_size_x = GROUP_SIZE) in;
+
+layout (std430, binding = BINDING_TARGET) writeonly buffer ssParticleTarget {
+	sParticle particleTarget[];
+};
+layout (std430, binding = BINDING_STATE) buffer ssParticleState {
+	uint stateDraw[8];
+	uint stateDispatch[4];
+	uint stateAlive;
+	uint stateCounter;
+};
+
+// emitter: center (w is radius), velocity (w is spread), color, 
+//	life (x is life, y is spread, z is size)
+layout (location = 0) uniform vec4 uEmitPosition;
+layout (location = 1) uniform vec4 uEmitVelocity;
+layout (location = 2) uniform vec4 uEmitColor;
+layout (location = 3) uniform vec4 uEmitLife;
+
+// number to emit, emission number of the first, seed and pool size
+layout (location = 6) uniform uint uEmitCount;
+layout (location = 7) uniform uint uEmitIndex;
+layout (location = 8) uniform uint uSeed;
+layout (location = 9) uniform uint uCapacity;
+
+void main()
+{
+	uint i = gl_GlobalInvocationID.x;
+	uint stream, slot;
+	float life;
+	sParticle particle;
+
+	if (i >= uEmitCount)
+		return;
+
+	// drop particles that do not fit; finalize clamps the count
+	slot = atomicAdd(stateCounter, 1u);
+	if (slot >= uCapacity)
+		return;
+
+	stream = (uEmitIndex + i) ^ hashParticle(uSeed);
+	particle.position.xyz = uEmitPosition.xyz + randomSignedParticle(stream) * uEmitPosition.w;
+	particle.velocity.xyz = uEmitVelocity.xyz + randomSignedParticle(stream) * uEmitVelocity.w;
+	life = max(uEmitLife.x + (randomParticle(stream) * 2.0 - 1.0) * uEmitLife.y, 0.001);
+	particle.position.w = life;
+	particle.velocity.w = uEmitLife.z;
+	particle.color = vec4(uEmitColor.rgb, 1.0 / life);
+	particleTarget[slot] = particle;
+}
@@ -0,0 +1,48 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	particleFinalize_cs4x.glsl
+	Turn the append counter into the live count, the next simulate 
+		dispatch size and the draw instance count, then reset it.
+*/
+
+#version 430
+
+#include "../inc/particle_cs4x.glsl"
+
+layout (local_size_x = 1) in;
+
+layout (std430, binding = BINDING_STATE) buffer ssParticleState {
+	uint stateDraw[8];
+	uint stateDispatch[4];
+	uint stateAlive;
+	uint stateCounter;
+};
+
+layout (location = 9) uniform uint uCapacity;
+
+void main()
+{
+	uint alive = min(stateCounter, uCapacity);
+	stateAlive = alive;
+	stateDraw[1] = alive;
+	stateDispatch[0] = (alive + GROUP_SIZE - 1u) / GROUP_SIZE;
+	stateCounter = 0u;
+}
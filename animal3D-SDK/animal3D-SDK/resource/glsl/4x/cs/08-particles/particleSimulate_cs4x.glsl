@@ -0,0 +1,66 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	particleSimulate_cs4x.glsl
+	Integrate live particles and append the survivors to the target 
+		pool; the dispatch size is the live count from the last update.
+*/
+
+#version 430
+
+#include "../inc/particle_cs4x.glsl"
+
+layout (local_size_x = GROUP_SIZE) in;
+
+layout (std430, binding = BINDING_SOURCE) readonly buffer ssParticleSource {
+	sParticle particleSource[];
+};
+layout (std430, binding = BINDING_TARGET) writeonly buffer ssParticleTarget {
+	sParticle particleTarget[];
+};
+layout (std430, binding = BINDING_STATE) buffer ssParticleState {
+	uint stateDraw[8];
+	uint stateDispatch[4];
+	uint stateAlive;
+	uint stateCounter;
+};
+
+// acceleration (w is linear drag) and time step
+layout (location = 4) uniform vec4 uGravity;
+layout (location = 5) uniform float uDt;
+
+void main()
+{
+	uint i = gl_GlobalInvocationID.x;
+	sParticle particle;
+
+	// last group is partial
+	if (i >= stateAlive)
+		return;
+
+	particle = particleSource[i];
+	particle.velocity.xyz += (uGravity.xyz - particle.velocity.xyz * uGravity.w) * uDt;
+	particle.position.xyz += particle.velocity.xyz * uDt;
+	particle.position.w -= uDt;
+
+	// compact: survivors take the next free slot in any order
+	if (particle.position.w > 0.0)
+		particleTarget[atomicAdd(stateCounter, 1u)] = particle;
+}
@@ -0,0 +1,62 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	hizReduce_cs4x.glsl
+	Build one level of the hierarchical depth pyramid: each thread keeps 
+		the farthest depth of a 2x2 block of the level below (the depth 
+		buffer for level 0), taking the leftover row or column as well 
+		when that level is odd. Must match a3_OcclusionCuller and the CPU 
+		reference build.
+*/
+
+#version 430
+
+#define TILE_SIZE	8
+
+layout (local_size_x = TILE_SIZE, local_size_y = TILE_SIZE) in;
+
+// level below: depth buffer or previous pyramid level
+layout (binding = 0) uniform sampler2D uSource;
+layout (location = 0) uniform int uSourceLevel;
+
+// level being built
+layout (r32f, binding = 0) uniform writeonly image2D uTarget;
+
+void main()
+{
+	ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+	ivec2 targetSize = imageSize(uTarget);
+	ivec2 sourceSize = textureSize(uSource, uSourceLevel);
+	ivec2 first, last, s;
+	float depth = 0.0;
+
+	if (any(greaterThanEqual(texel, targetSize)))
+		return;
+
+	// 2x2 block, widened to the edge for the last texel of a row or column
+	first = texel * 2;
+	last.x = texel.x + 1 < targetSize.x ? first.x + 1 : sourceSize.x - 1;
+	last.y = texel.y + 1 < targetSize.y ? first.y + 1 : sourceSize.y - 1;
+	last = max(last, first);
+	for (s.y = first.y; s.y <= last.y; ++s.y)
+		for (s.x = first.x; s.x <= last.x; ++s.x)
+			depth = max(depth, texelFetch(uSource, s, uSourceLevel).r);
+	imageStore(uTarget, texel, vec4(depth));
+}
@@ -0,0 +1,115 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	occlusionTest_cs4x.glsl
+	Test object boxes against the depth pyramid, one thread each: a box 
+		crossing the near plane is visible; otherwise its screen rect 
+		picks the level where it spans at most 2x2 texels, and it is 
+		visible if its nearest depth is not behind the farthest of them. 
+		Must match a3_OcclusionCuller and the CPU reference test.
+*/
+
+#version 430
+
+#define GROUP_SIZE		64
+
+#define BINDING_BOUNDS	0
+#define BINDING_VISIBLE	1
+
+// clip w below which a corner counts as crossing the near plane
+#define NEAR_W			1.0e-5
+
+layout (local_size_x = GROUP_SIZE) in;
+
+// boxes: min and max corner per object
+layout (std430, binding = BINDING_BOUNDS) readonly buffer ssBounds {
+	vec4 bounds[];
+};
+
+// result: non-zero if visible
+layout (std430, binding = BINDING_VISIBLE) writeonly buffer ssVisible {
+	uint visible[];
+};
+
+// pyramid of farthest depths; level texels cover 2^(level + 1) pixels
+layout (binding = 0) uniform sampler2D uPyramid;
+
+layout (location = 1) uniform mat4 uViewProjection;
+layout (location = 5) uniform uvec2 uDepthSize;
+layout (location = 6) uniform int uLevelCount;
+layout (location = 7) uniform uint uObjectCount;
+
+// texel of a level holding a depth pixel coordinate
+ivec2 pyramidTexel(vec2 pixel, int level, ivec2 levelSize)
+{
+	ivec2 i = ivec2(max(pixel / float(2 << level), vec2(0.0)));
+	return min(i, levelSize - 1);
+}
+
+bool testBox(vec3 boxMin, vec3 boxMax)
+{
+	vec3 ndcMin = vec3(+1.0e30), ndcMax = vec3(-1.0e30), corner, ndc;
+	vec4 clip;
+	vec2 size = vec2(uDepthSize), p0, p1;
+	ivec2 levelSize, i0, i1;
+	float extent, z, d;
+	int c, level;
+
+	// project corners; any behind the near plane makes it visible
+	for (c = 0; c < 8; ++c)
+	{
+		corner = vec3((c & 1) != 0 ? boxMax.x : boxMin.x, (c & 2) != 0 ? boxMax.y : boxMin.y, (c & 4) != 0 ? boxMax.z : boxMin.z);
+		clip = uViewProjection * vec4(corner, 1.0);
+		if (clip.w <= NEAR_W)
+			return true;
+		ndc = clip.xyz / clip.w;
+		ndcMin = min(ndcMin, ndc);
+		ndcMax = max(ndcMax, ndc);
+	}
+
+	// screen rect in depth pixels; boxes off screen are not visible
+	p0 = (ndcMin.xy * 0.5 + 0.5) * size;
+	p1 = (ndcMax.xy * 0.5 + 0.5) * size;
+	z = ndcMin.z * 0.5 + 0.5;
+	if (any(lessThan(p1, vec2(0.0))) || any(greaterThan(p0, size)) || z > 1.0)
+		return false;
+	p0 = max(p0, vec2(0.0));
+	p1 = min(p1, size);
+
+	// coarsest level needed for the rect to span 2x2 texels
+	extent = max(p1.x - p0.x, p1.y - p0.y);
+	for (level = 0; level + 1 < uLevelCount && extent > float(2 << level); ++level);
+	levelSize = textureSize(uPyramid, level);
+	i0 = pyramidTexel(p0, level, levelSize);
+	i1 = pyramidTexel(p1, level, levelSize);
+
+	// farthest occluder depth against nearest box depth
+	d = max(
+		max(texelFetch(uPyramid, i0, level).r, texelFetch(uPyramid, ivec2(i1.x, i0.y), level).r),
+		max(texelFetch(uPyramid, ivec2(i0.x, i1.y), level).r, texelFetch(uPyramid, i1, level).r));
+	return z <= d;
+}
+
+void main()
+{
+	uint i = gl_GlobalInvocationID.x;
+	if (i < uObjectCount)
+		visible[i] = testBox(bounds[i * 2u].xyz, bounds[i * 2u + 1u].xyz) ? 1u : 0u;
+}
@@ -0,0 +1,69 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	particle_cs4x.glsl
+	Particle layout and random stream shared by the particle compute 
+		shaders and the draw; must match a3_Particle and the CPU 
+		reference simulation. Include after the version directive.
+*/
+
+#ifndef A3_PARTICLE
+#define A3_PARTICLE
+
+#define GROUP_SIZE		256
+
+#define BINDING_SOURCE	0
+#define BINDING_TARGET	1
+#define BINDING_STATE	2
+
+// position.w: remaining life; velocity.w: size; color.w: 1 / initial life
+struct sParticle
+{
+	vec4 position;
+	vec4 velocity;
+	vec4 color;
+};
+
+// integer hash (PCG output permutation)
+uint hashParticle(uint value)
+{
+	uint state = value * 747796405u + 2891336453u;
+	uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+	return (word >> 22u) ^ word;
+}
+
+// next random value in [0, 1)
+float randomParticle(inout uint stream)
+{
+	stream = hashParticle(stream);
+	return float(stream >> 8u) * (1.0 / 16777216.0);
+}
+
+// random vector in [-1, 1)
+vec3 randomSignedParticle(inout uint stream)
+{
+	vec3 r;
+	r.x = randomParticle(stream);
+	r.y = randomParticle(stream);
+	r.z = randomParticle(stream);
+	return r * 2.0 - 1.0;
+}
+
+#endif	// !A3_PARTICLE
@@ -0,0 +1,125 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	drawPhong_multi_variant_fs4x.glsl
+	Draw Phong shading model for multiple lights; base for variants.
+		A3_SHADOW: cascaded shadow mapping from the shared shadow atlas
+		A3_MRT_COUNT: number of targets written, in MRT layout order
+		A3_LIGHT_COUNT: size of light uniform arrays
+		A3_INSTANCED: color comes from the instance record, not a uniform
+*/
+
+#version 410
+
+#ifndef A3_MRT_COUNT
+#define A3_MRT_COUNT	1
+#endif	// !A3_MRT_COUNT
+
+#include "../inc/lightingPhong_fs4x.glsl"
+#ifdef A3_SHADOW
+#include "../inc/shadowCascade_fs4x.glsl"
+#endif	// A3_SHADOW
+
+in vbLightingData {
+	vec4 vViewPosition;
+	vec4 vViewNormal;
+	vec4 vTexcoord;
+};
+
+#ifdef A3_INSTANCED
+flat in vec4 vColor;
+#else	// !A3_INSTANCED
+uniform vec4 uColor;
+#endif	// A3_INSTANCED
+uniform sampler2D uTex_dm, uTex_sm;
+
+// final color
+layout (location = 0) out vec4 rtFragColor;
+
+// attribute data
+#if A3_MRT_COUNT > 3
+layout (location = 1) out vec4 rtViewPosition;
+layout (location = 2) out vec4 rtViewNormal;
+layout (location = 3) out vec4 rtAtlasTexcoord;
+#endif	// A3_MRT_COUNT > 3
+
+// shadow data
+#if A3_MRT_COUNT > 5
+layout (location = 4) out vec4 rtShadowCoord;
+layout (location = 5) out vec4 rtShadowTest;
+#endif	// A3_MRT_COUNT > 5
+
+// lighting data
+#if A3_MRT_COUNT > 7
+layout (location = 6) out vec4 rtDiffuseLightTotal;
+layout (location = 7) out vec4 rtSpecularLightTotal;
+#endif	// A3_MRT_COUNT > 7
+
+
+void main()
+{
+	vec3 N = normalize(vViewNormal.xyz);
+	vec3 diffuseLightTotal, specularLightTotal;
+#ifdef A3_INSTANCED
+	vec3 ambient = vColor.rgb * 0.1;
+#else	// !A3_INSTANCED
+	vec3 ambient = uColor.rgb * 0.1;
+#endif	// A3_INSTANCED
+	vec4 shadowCoord = vec4(0.0);
+	vec3 shadowTint = vec3(1.0);
+	float shadow = 1.0;
+
+#ifdef A3_SHADOW
+	int cascade;
+	shadow = calcShadow(shadowCoord, cascade, vViewPosition);
+	shadowTint = kCascadeTint[cascade];
+#endif	// A3_SHADOW
+
+	calcPhongLighting(diffuseLightTotal, specularLightTotal, vViewPosition.xyz, N, shadow);
+
+	// textures
+	vec4 sample_dm = texture(uTex_dm, vTexcoord.xy);
+	vec4 sample_sm = texture(uTex_sm, vTexcoord.xy);
+
+	// final color
+	rtFragColor.rgb = ambient
+					+ sample_dm.rgb * diffuseLightTotal
+					+ sample_sm.rgb * specularLightTotal;
+	rtFragColor.a = sample_dm.a;
+
+#if A3_MRT_COUNT > 3
+	// output attributes
+	rtViewPosition = vViewPosition;
+	rtViewNormal = vec4(N * 0.5 + 0.5, 1.0);
+	rtAtlasTexcoord = vTexcoord;
+#endif	// A3_MRT_COUNT > 3
+
+#if A3_MRT_COUNT > 5
+	// output shadow data: test is tinted by cascade
+	rtShadowCoord = shadowCoord;
+	rtShadowTest = vec4(shadowTint * shadow, 1.0);
+#endif	// A3_MRT_COUNT > 5
+
+#if A3_MRT_COUNT > 7
+	// output lighting
+	rtDiffuseLightTotal = vec4(diffuseLightTotal, 1.0);
+	rtSpecularLightTotal = vec4(specularLightTotal, 1.0);
+#endif	// A3_MRT_COUNT > 7
+}
@@ -0,0 +1,65 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	drawGBuffer_packed_fs4x.glsl
+	Write packed g-buffers: albedo with specular intensity in one 8-bit 
+		target and an octahedral normal in one 16-bit two-channel target. 
+		Position is not stored; it is reconstructed from depth.
+*/
+
+#version 410
+
+in vbLightingData {
+	vec4 vViewPosition;
+	vec4 vViewNormal;
+	vec4 vTexcoord;
+};
+
+uniform sampler2D uTex_dm, uTex_sm;
+
+layout (location = 0) out vec4 rtAlbedoSpecular;
+layout (location = 1) out vec2 rtNormal;
+
+
+// fold lower hemisphere over the diagonals of the octahedron
+vec2 octWrap(in vec2 v)
+{
+	return (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+// unit normal to [0, 1] octahedral coordinates
+vec2 encodeNormal(in vec3 n)
+{
+	n /= abs(n.x) + abs(n.y) + abs(n.z);
+	n.xy = n.z >= 0.0 ? n.xy : octWrap(n.xy);
+	return n.xy * 0.5 + 0.5;
+}
+
+
+void main()
+{
+	vec4 sample_dm = texture(uTex_dm, vTexcoord.xy);
+	vec4 sample_sm = texture(uTex_sm, vTexcoord.xy);
+
+	// specular maps are grey; keep luminance only
+	rtAlbedoSpecular = vec4(sample_dm.rgb, dot(sample_sm.rgb, vec3(0.299, 0.587, 0.114)));
+	rtNormal = encodeNormal(normalize(vViewNormal.xyz));
+}
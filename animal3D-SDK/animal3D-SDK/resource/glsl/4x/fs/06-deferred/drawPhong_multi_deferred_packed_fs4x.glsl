@@ -0,0 +1,79 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	drawPhong_multi_deferred_packed_fs4x.glsl
+	Draw Phong shading model for multiple lights from packed g-buffers; 
+		view position is reconstructed from depth and the inverse 
+		projection-bias matrix.
+*/
+
+#version 410
+
+#include "../inc/lightingPhong_fs4x.glsl"
+
+in vec4 vTexcoord;
+
+uniform vec4 uColor;
+uniform mat4 uPB_inv;
+
+// g-buffers: depth, albedo with specular, octahedral normal
+uniform sampler2D uImage00, uImage01, uImage02;
+
+layout (location = 0) out vec4 rtFragColor;
+
+
+// [0, 1] octahedral coordinates to unit normal
+vec3 decodeNormal(in vec2 f)
+{
+	vec3 n;
+	float t;
+	f = f * 2.0 - 1.0;
+	n = vec3(f, 1.0 - abs(f.x) - abs(f.y));
+	t = max(-n.z, 0.0);
+	n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+	return normalize(n);
+}
+
+
+void main()
+{
+	// g-buffers match the frame, so fetch texels directly
+	ivec2 coord = ivec2(gl_FragCoord.xy);
+	float depth = texelFetch(uImage00, coord, 0).r;
+	vec4 albedoSpecular = texelFetch(uImage01, coord, 0);
+	vec3 N = decodeNormal(texelFetch(uImage02, coord, 0).rg);
+	vec4 position;
+	vec3 diffuseLightTotal, specularLightTotal;
+	vec3 ambient = uColor.rgb * 0.1;
+
+	// nothing drawn here; leave for background
+	if (depth >= 1.0)
+		discard;
+
+	// reverse perspective divide
+	position = uPB_inv * vec4(vTexcoord.xy, depth, 1.0);
+	calcPhongLighting(diffuseLightTotal, specularLightTotal, position.xyz / position.w, N, 1.0);
+
+	rtFragColor.rgb = ambient
+					+ albedoSpecular.rgb * diffuseLightTotal
+					+ albedoSpecular.a * specularLightTotal;
+	rtFragColor.a = 1.0;
+}
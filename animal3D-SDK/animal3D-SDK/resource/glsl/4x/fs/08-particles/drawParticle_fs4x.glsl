@@ -0,0 +1,38 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	drawParticle_fs4x.glsl
+	Soft round sprite for additive blending; only the color target is 
+		written.
+*/
+
+#version 430
+
+in vec4 vColor;
+in vec2 vTexcoord;
+
+layout (location = 0) out vec4 rtFragColor;
+
+void main()
+{
+	float falloff = 1.0 - clamp(dot(vTexcoord, vTexcoord), 0.0, 1.0);
+	float alpha = vColor.a * falloff * falloff;
+	rtFragColor = vec4(vColor.rgb * alpha, alpha);
+}
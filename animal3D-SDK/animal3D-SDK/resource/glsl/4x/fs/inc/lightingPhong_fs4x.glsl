@@ -0,0 +1,83 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	lightingPhong_fs4x.glsl
+	Shared Phong lighting for multiple point lights; include after the 
+		version directive. Array sizes come from A3_LIGHT_COUNT.
+*/
+
+#ifndef A3_LIGHTING_PHONG
+#define A3_LIGHTING_PHONG
+
+#ifndef A3_LIGHT_COUNT
+#define A3_LIGHT_COUNT	4
+#endif	// !A3_LIGHT_COUNT
+
+uniform int uLightCt;
+uniform float uLightSz[A3_LIGHT_COUNT];
+uniform float uLightSzInvSq[A3_LIGHT_COUNT];
+uniform vec4 uLightPos[A3_LIGHT_COUNT];
+uniform vec4 uLightCol[A3_LIGHT_COUNT];
+
+
+float pow64(float v)
+{
+	v *= v;	// ^2
+	v *= v;	// ^4
+	v *= v;	// ^8
+	v *= v;	// ^16
+	v *= v;	// ^32
+	v *= v;	// ^64
+	return v;
+}
+
+
+// accumulate diffuse and specular light at view position P with normal N
+//	-> shadow attenuates the first light, which follows the shadow projector
+void calcPhongLighting(out vec3 diffuseLightTotal, out vec3 specularLightTotal, 
+	in vec3 P, in vec3 N, in float shadow)
+{
+	vec3 V = normalize(-P);
+	vec3 L, R;
+	float kd, ks, dist, distSq, atten;
+	int i, count = min(uLightCt, A3_LIGHT_COUNT);
+
+	diffuseLightTotal = specularLightTotal = vec3(0.0);
+	for (i = 0; i < count; ++i)
+	{
+		L = uLightPos[i].xyz - P;
+		distSq = dot(L, L);
+		dist = sqrt(distSq);
+		L /= dist;
+
+		kd = dot(L, N);
+		R = (2.0 * kd) * N - L;
+		ks = pow64(max(0.0, dot(R, V)));
+		kd = max(0.0, kd);
+
+		atten = 1.0 / (1.0 + 2.0 * dist * sqrt(uLightSzInvSq[i]) + distSq * uLightSzInvSq[i]);
+		atten *= (i == 0 ? shadow : 1.0);
+
+		diffuseLightTotal += (atten * kd) * uLightCol[i].rgb;
+		specularLightTotal += (atten * ks) * uLightCol[i].rgb;
+	}
+}
+
+#endif	// !A3_LIGHTING_PHONG
@@ -0,0 +1,66 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	shadowCascade_fs4x.glsl
+	Cascaded shadow lookup in a shared shadow atlas; include after the 
+		version directive.
+*/
+
+#ifndef A3_SHADOW_CASCADE
+#define A3_SHADOW_CASCADE
+
+#define MAX_CASCADES	4
+
+// shadow atlas, cascade count, view -> atlas transforms and far depths
+uniform sampler2D uTex_shadow;
+uniform int uCount;
+uniform mat4 uShadowCascade[MAX_CASCADES];
+uniform vec4 uShadowSplit;
+
+const vec3 kCascadeTint[MAX_CASCADES] = vec3[](
+	vec3(1.0, 0.5, 0.5), vec3(0.5, 1.0, 0.5), vec3(0.5, 0.5, 1.0), vec3(1.0, 1.0, 0.5));
+
+
+// select cascade by view depth and test against atlas with 3x3 PCF
+//	-> fragments beyond the last cascade are treated as lit
+float calcShadow(out vec4 shadowCoord, out int cascade, in vec4 viewPos)
+{
+	float depth = -viewPos.z;
+	float lit = 0.0;
+	vec2 texel;
+	int i, j;
+
+	cascade = 0;
+	while (cascade < uCount - 1 && depth > uShadowSplit[cascade])
+		++cascade;
+
+	// cascades are orthographic, no perspective divide needed
+	shadowCoord = uShadowCascade[cascade] * viewPos;
+	if (uCount <= 0 || depth > uShadowSplit[uCount - 1])
+		return 1.0;
+
+	texel = 1.0 / vec2(textureSize(uTex_shadow, 0));
+	for (j = -1; j <= 1; ++j)
+		for (i = -1; i <= 1; ++i)
+			lit += step(shadowCoord.z - 0.0005, texture(uTex_shadow, shadowCoord.xy + vec2(i, j) * texel).r);
+	return lit / 9.0;
+}
+
+#endif	// !A3_SHADOW_CASCADE
@@ -0,0 +1,106 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	drawCurveSegment_tcs4x.glsl
+	Convert a curve segment to cubic Bezier form and pick its line count 
+		from the projected length of the control hull (matches 
+		a3curveSegmentLevel on the CPU).
+*/
+
+#version 430
+
+// must match a3curveTess_levelMax and a3curveTess_pixelsPerLevel
+#define LEVEL_MAX 64.0
+#define PIXELS_PER_LEVEL 8.0
+
+#define MAX_WAYPOINTS 32
+
+layout (vertices = 1) out;
+
+flat in int vSegment[];
+
+uniform ubCurveWaypoint {
+	vec4 uWaypoint[MAX_WAYPOINTS];
+	vec4 uWaypointHandle[MAX_WAYPOINTS];
+};
+
+// curve type (see a3_Demo_Curves_InterpolationModeName), segment count, 
+//	current segment, view-projection and viewport size in pixels
+uniform int uFlag, uCount, uIndex;
+uniform mat4 uMVP;
+uniform vec2 uSize;
+
+patch out vec4 tcControl[4];
+patch out float tcCurrent;
+
+void main()
+{
+	int k0 = vSegment[0] % uCount;
+	int k1 = (k0 + 1) % uCount;
+	int k2 = (k0 + 2) % uCount;
+	int k3 = (k0 + uCount - 1) % uCount;
+	vec3 p0 = uWaypoint[k0].xyz, p1 = uWaypoint[k1].xyz;
+	vec3 b[4] = vec3[4](p0, mix(p0, p1, 1.0 / 3.0), mix(p0, p1, 2.0 / 3.0), p1);
+
+	switch (uFlag)
+	{
+	case 2:	// Bezier
+		b = vec3[4](p0, p1, uWaypoint[k2].xyz, uWaypoint[k3].xyz);
+		break;
+	case 3:	// Catmull-Rom
+		b[1] = p0 + (p1 - uWaypoint[k3].xyz) / 6.0;
+		b[2] = p1 + (p0 - uWaypoint[k2].xyz) / 6.0;
+		break;
+	case 4:	// cubic Hermite, handles are tangent control points
+		b[1] = p0 + (uWaypointHandle[k0].xyz - p0) / 3.0;
+		b[2] = p1 + (p1 - uWaypointHandle[k1].xyz) / 3.0;
+		break;
+	}
+
+	// a plane culls the segment only if the whole hull is behind it; 
+	//	segments crossing the eye plane get the most lines
+	uint outside = 0x3fu;
+	bool crossing = false;
+	vec2 screen[4];
+	for (int i = 0; i < 4; ++i)
+	{
+		vec4 clip = uMVP * vec4(b[i], 1.0);
+		outside &= uint(clip.x < -clip.w) | uint(clip.x > clip.w) << 1u
+			| uint(clip.y < -clip.w) << 2u | uint(clip.y > clip.w) << 3u
+			| uint(clip.z < -clip.w) << 4u | uint(clip.z > clip.w) << 5u;
+		crossing = crossing || clip.w <= 1.0e-4;
+		screen[i] = clip.xy / max(clip.w, 1.0e-4) * 0.5 * uSize;
+		tcControl[i] = vec4(b[i], 1.0);
+	}
+
+	float level = LEVEL_MAX;
+	if (!crossing)
+	{
+		float len = distance(screen[0], screen[1]) + distance(screen[1], screen[2]) + distance(screen[2], screen[3]);
+		level = clamp(ceil(len / PIXELS_PER_LEVEL), 1.0, LEVEL_MAX);
+	}
+	if (outside != 0u)
+		level = 0.0;
+
+	// isolines: outer 0 is the number of lines, outer 1 the subdivisions
+	gl_TessLevelOuter[0] = 1.0;
+	gl_TessLevelOuter[1] = level;
+	tcCurrent = float(k0 == uIndex);
+}
@@ -0,0 +1,48 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	drawCurveSegment_tes4x.glsl
+	Evaluate the cubic Bezier segment at each tessellated parameter.
+*/
+
+#version 430
+
+layout (isolines, equal_spacing) in;
+
+patch in vec4 tcControl[4];
+patch in float tcCurrent;
+
+uniform mat4 uMVP;
+uniform vec4 uColor;
+
+out vec4 vColor;
+
+void main()
+{
+	float t = gl_TessCoord.x, u = 1.0 - t;
+	vec4 position = tcControl[0] * (u * u * u)
+		+ tcControl[1] * (3.0 * u * u * t)
+		+ tcControl[2] * (3.0 * u * t * t)
+		+ tcControl[3] * (t * t * t);
+	gl_Position = uMVP * position;
+
+	// brighten the segment being animated
+	vColor = mix(uColor, vec4(1.0), tcCurrent * 0.5);
+}
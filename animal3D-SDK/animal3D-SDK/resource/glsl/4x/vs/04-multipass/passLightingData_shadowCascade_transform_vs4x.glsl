@@ -0,0 +1,79 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	passLightingData_shadowCascade_transform_vs4x.glsl
+	Vertex shader that prepares and passes lighting data in view space. 
+		Shadow cascade coordinates are computed per fragment from the 
+		view position, since the cascade depends on view depth.
+		A3_INSTANCED: transforms and color per instance from a block of 
+			records; the atlas transform is shared by the batch
+*/
+
+#version 410
+
+layout (location = 0) in vec4 aPosition;
+layout (location = 2) in vec4 aNormal;
+layout (location = 8) in vec4 aTexcoord;
+
+#ifdef A3_INSTANCED
+#define MAX_INSTANCES	64
+
+// std140 record: 208 bytes, matching the demo's scene instance record
+struct sInstance
+{
+	mat4 modelViewMat;
+	mat4 modelViewNormalMat;
+	mat4 modelViewProjectionMat;
+	vec4 color;
+};
+
+// one record per instance; a draw reads up to a full block
+uniform ubInstance {
+	sInstance uInstance[MAX_INSTANCES];
+};
+
+uniform mat4 uAtlas;
+
+flat out vec4 vColor;
+#else	// !A3_INSTANCED
+uniform mat4 uMV, uMVP, uMV_nrm, uAtlas;
+#endif	// A3_INSTANCED
+
+out vbLightingData {
+	vec4 vViewPosition;
+	vec4 vViewNormal;
+	vec4 vTexcoord;
+};
+
+void main()
+{
+#ifdef A3_INSTANCED
+	vViewPosition = uInstance[gl_InstanceID].modelViewMat * aPosition;
+	vViewNormal = uInstance[gl_InstanceID].modelViewNormalMat * aNormal;
+	vTexcoord = uAtlas * aTexcoord;
+	vColor = uInstance[gl_InstanceID].color;
+	gl_Position = uInstance[gl_InstanceID].modelViewProjectionMat * aPosition;
+#else	// !A3_INSTANCED
+	vViewPosition = uMV * aPosition;
+	vViewNormal = uMV_nrm * aNormal;
+	vTexcoord = uAtlas * aTexcoord;
+	gl_Position = uMVP * aPosition;
+#endif	// A3_INSTANCED
+}
@@ -0,0 +1,34 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	passCurveSegment_vs4x.glsl
+	Start one tessellation patch per curve segment; the segment index is 
+		the instance index and no vertex data is read.
+*/
+
+#version 430
+
+flat out int vSegment;
+
+void main()
+{
+	vSegment = gl_InstanceID;
+	gl_Position = vec4(0.0);
+}
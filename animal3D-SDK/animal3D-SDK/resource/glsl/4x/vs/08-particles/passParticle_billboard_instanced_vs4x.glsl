@@ -0,0 +1,54 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	passParticle_billboard_instanced_vs4x.glsl
+	Expand the unit quad into a camera-facing billboard for the particle 
+		given by the instance index, read straight from the pool.
+*/
+
+#version 430
+
+#include "../../cs/inc/particle_cs4x.glsl"
+
+layout (location = 0) in vec4 aPosition;
+
+layout (std430, binding = BINDING_SOURCE) readonly buffer ssParticleSource {
+	sParticle particleSource[];
+};
+
+// view and projection matrices
+uniform mat4 uMV, uP;
+
+out vec4 vColor;
+out vec2 vTexcoord;
+
+void main()
+{
+	sParticle particle = particleSource[gl_InstanceID];
+	vec4 position = uMV * vec4(particle.position.xyz, 1.0);
+
+	// offset in view space so the quad always faces the camera
+	position.xy += aPosition.xy * particle.velocity.w;
+	gl_Position = uP * position;
+
+	// fade out over life
+	vColor = vec4(particle.color.rgb, clamp(particle.position.w * particle.color.w, 0.0, 1.0));
+	vTexcoord = aPosition.xy;
+}
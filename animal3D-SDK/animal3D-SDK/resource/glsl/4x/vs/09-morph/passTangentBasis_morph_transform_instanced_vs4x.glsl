@@ -0,0 +1,109 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	passTangentBasis_morph_transform_instanced_vs4x.glsl
+	Blends sparse quantized morph target deltas into the base position and 
+		normal using per-instance weights, then sends the full tangent 
+		basis like the other forward passes.
+*/
+
+#version 430
+
+// ****TO-DO: 
+//	0) nothing
+
+layout (location = 8)	in vec4 aTexcoord;
+layout (location = 10)	in vec4 aTangent;
+layout (location = 11)	in vec4 aBitangent;
+layout (location = 2)	in vec4 aNormal;
+layout (location = 0)	in vec4 aPosition;
+
+
+// first delta of each vertex; deltas of vertex v end where v + 1 starts
+layout (std430, binding = 0) readonly buffer ssMorphRange {
+	uint ssRange[];
+};
+
+// delta: xyz position and xyz normal as signed 16-bit pairs, then target
+layout (std430, binding = 1) readonly buffer ssMorphDelta {
+	uvec4 ssDelta[];
+};
+
+// per target: x is position step, y is normal step
+layout (std430, binding = 2) readonly buffer ssMorphStep {
+	vec4 ssStep[];
+};
+
+// per instance, per target
+layout (std430, binding = 3) readonly buffer ssMorphWeight {
+	float ssWeight[];
+};
+
+layout (location = 0) uniform int uTargetCount;
+
+uniform mat4 uMV, uMV_nrm, uP, uAtlas;
+uniform vec2 uSize;
+
+
+out vbVertexData {
+	mat4 vTangentBasis_view;
+	vec4 vTexcoord_atlas;
+	flat int vVertexID, vInstanceID, vModelID;
+};
+
+
+void main()
+{
+	vVertexID = gl_VertexID;
+	vInstanceID = gl_InstanceID;
+	vModelID = 0;
+
+	// sum only the targets that move this vertex
+	int weightBase = gl_InstanceID * uTargetCount;
+	vec3 position = aPosition.xyz, normal = aNormal.xyz;
+	uint i, end = ssRange[gl_VertexID + 1];
+	for (i = ssRange[gl_VertexID]; i < end; ++i)
+	{
+		uvec4 delta = ssDelta[i];
+		ivec3 lo = bitfieldExtract(ivec3(delta.xyz), 0, 16);
+		ivec3 hi = bitfieldExtract(ivec3(delta.xyz), 16, 16);
+		int target = int(delta.w & 0xFFFFu);
+		vec2 w = ssWeight[weightBase + target] * ssStep[target].xy;
+		position += w.x * vec3(lo.x, hi.x, lo.y);
+		normal += w.y * vec3(hi.y, lo.z, hi.z);
+	}
+
+	// keep the tangent frame orthogonal to the blended normal and keep 
+	//	its handedness
+	normal = normalize(normal);
+	vec3 tangent = normalize(aTangent.xyz - normal * dot(normal, aTangent.xyz));
+	vec3 bitangent = cross(normal, tangent);
+	bitangent *= (dot(bitangent, aBitangent.xyz) < 0.0 ? -1.0 : +1.0);
+
+	// instances are lined up along object x
+	vec4 pos = vec4(position, 1.0);
+	pos.x += uSize.x * float(gl_InstanceID);
+
+	mat4 tangentBasis_object = mat4(vec4(tangent, 0.0), vec4(bitangent, 0.0), vec4(normal, 0.0), pos);
+	vTexcoord_atlas = uAtlas * aTexcoord;
+	vTangentBasis_view = uMV_nrm * tangentBasis_object;
+	vTangentBasis_view[3] = uMV * pos;
+	gl_Position = uP * vTangentBasis_view[3];
+}
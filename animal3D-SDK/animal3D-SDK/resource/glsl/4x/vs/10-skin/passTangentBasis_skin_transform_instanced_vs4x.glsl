@@ -0,0 +1,119 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	passTangentBasis_skin_transform_instanced_vs4x.glsl
+	Skins the tangent basis with four packed joint influences from the
+		palette of each instance (character), then sends it like the other
+		forward passes. Linear blend by default; dual quaternions if
+		A3_DUAL_QUAT is defined by the variant.
+*/
+
+#version 430
+
+// ****TO-DO:
+//	0) nothing
+
+layout (location = 8)	in vec4 aTexcoord;
+layout (location = 10)	in vec4 aTangent;
+layout (location = 11)	in vec4 aBitangent;
+layout (location = 7)	in uvec4 aBlendIndices;
+layout (location = 2)	in vec4 aNormal;
+layout (location = 1)	in vec4 aBlendWeights;
+layout (location = 0)	in vec4 aPosition;
+
+
+// per instance, per joint: three matrix rows, or real and dual quaternion
+layout (std430, binding = 0) readonly buffer ssSkinPalette {
+	vec4 ssPalette[];
+};
+
+layout (location = 0) uniform int uJointCount;
+
+uniform mat4 uMV, uMV_nrm, uP, uAtlas;
+
+
+out vbVertexData {
+	mat4 vTangentBasis_view;
+	vec4 vTexcoord_atlas;
+	flat int vVertexID, vInstanceID, vModelID;
+};
+
+
+void main()
+{
+	vVertexID = gl_VertexID;
+	vInstanceID = gl_InstanceID;
+	vModelID = 0;
+
+	int jointBase = gl_InstanceID * uJointCount;
+	vec3 position, normal, tangent, bitangent;
+	int i;
+
+#ifdef A3_DUAL_QUAT
+	// blend in the hemisphere of the first influence, then renormalize
+	vec4 q0 = ssPalette[(jointBase + int(aBlendIndices.x)) * 2];
+	vec4 real = vec4(0.0), dual = vec4(0.0);
+	for (i = 0; i < 4; ++i)
+		if (aBlendWeights[i] > 0.0)
+		{
+			int joint = (jointBase + int(aBlendIndices[i])) * 2;
+			vec4 q = ssPalette[joint];
+			float w = aBlendWeights[i] * (dot(q0, q) < 0.0 ? -1.0 : +1.0);
+			real += w * q;
+			dual += w * ssPalette[joint + 1];
+		}
+	float lenInv = 1.0 / length(real);
+	real *= lenInv;
+	dual *= lenInv;
+
+	// rotate: v + 2 r x (r x v + w v); translate: 2 (w d - dw r + r x d)
+	position = aPosition.xyz + 2.0 * cross(real.xyz, cross(real.xyz, aPosition.xyz) + real.w * aPosition.xyz)
+		+ 2.0 * (real.w * dual.xyz - dual.w * real.xyz + cross(real.xyz, dual.xyz));
+	normal = aNormal.xyz + 2.0 * cross(real.xyz, cross(real.xyz, aNormal.xyz) + real.w * aNormal.xyz);
+	tangent = aTangent.xyz + 2.0 * cross(real.xyz, cross(real.xyz, aTangent.xyz) + real.w * aTangent.xyz);
+#else	// !A3_DUAL_QUAT
+	// blend matrix rows, then transform once
+	mat3x4 skin = mat3x4(0.0);
+	for (i = 0; i < 4; ++i)
+		if (aBlendWeights[i] > 0.0)
+		{
+			int joint = (jointBase + int(aBlendIndices[i])) * 3;
+			skin[0] += aBlendWeights[i] * ssPalette[joint + 0];
+			skin[1] += aBlendWeights[i] * ssPalette[joint + 1];
+			skin[2] += aBlendWeights[i] * ssPalette[joint + 2];
+		}
+	position = vec4(aPosition.xyz, 1.0) * skin;
+	normal = vec4(aNormal.xyz, 0.0) * skin;
+	tangent = vec4(aTangent.xyz, 0.0) * skin;
+#endif	// A3_DUAL_QUAT
+
+	// keep the tangent frame orthogonal and keep its handedness
+	normal = normalize(normal);
+	tangent = normalize(tangent - normal * dot(normal, tangent));
+	bitangent = cross(normal, tangent);
+	bitangent *= (dot(cross(aNormal.xyz, aTangent.xyz), aBitangent.xyz) < 0.0 ? -1.0 : +1.0);
+
+	vec4 pos = vec4(position, 1.0);
+	mat4 tangentBasis_object = mat4(vec4(tangent, 0.0), vec4(bitangent, 0.0), vec4(normal, 0.0), pos);
+	vTexcoord_atlas = uAtlas * aTexcoord;
+	vTangentBasis_view = uMV_nrm * tangentBasis_object;
+	vTangentBasis_view[3] = uMV * pos;
+	gl_Position = uP * vTangentBasis_view[3];
+}
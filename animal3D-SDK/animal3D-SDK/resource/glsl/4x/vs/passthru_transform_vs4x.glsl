@@ -20,6 +20,8 @@
 	
 	passthru_transform_vs4x.glsl
 	Pass-thru GLSL vertex shader. Outputs transformed position attribute.
+		A3_INSTANCED: MVP per instance from a block of records, for 
+			batched depth passes
 */
 
 #version 410
@@ -30,11 +32,24 @@
 
 layout (location = 0) in vec4 aPosition;
 
+#ifdef A3_INSTANCED
+#define MAX_INSTANCES	64
+
+// one record per instance; a draw reads up to a full block
+uniform ubInstance {
+	mat4 uInstanceMVP[MAX_INSTANCES];
+};
+#else	// !A3_INSTANCED
 uniform mat4 uMVP;	// (1)
+#endif	// A3_INSTANCED
 
 void main()
 {
 	// DUMMY OUTPUT: directly assign input position to output position
 //	gl_Position = aPosition;
+#ifdef A3_INSTANCED
+	gl_Position = uInstanceMVP[gl_InstanceID] * aPosition;
+#else	// !A3_INSTANCED
 	gl_Position = uMVP * aPosition;	// (2)
+#endif	// A3_INSTANCED
 }
@@ -0,0 +1,150 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_CurveTessellation-OpenGL.c
+	Definitions for OpenGL curve tessellation: the CPU fallback maps and 
+		rewrites its vertex buffer every update, and the hardware path 
+		draws single-vertex patches.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_CurveTessellation.h"
+
+#include "GL/glew.h"
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3curveTessellationCreate(a3_CurveTessellation *tess_out, const a3byte name_opt[32], const a3ui32 segmentCapacity)
+{
+	a3_VertexAttributeDescriptor attrib[1];
+	a3_VertexFormatDescriptor format[1];
+	const a3ui32 capacity = segmentCapacity * a3curveTess_levelMax * 2;
+
+	if (tess_out && segmentCapacity)
+	{
+		if (!tess_out->vertexBuffer->handle->handle)
+		{
+			a3vertexAttribCreateDescriptor(attrib, a3attrib_position, a3attrib_vec3);
+			a3vertexFormatCreateDescriptor(format, attrib, 1);
+
+			if (a3bufferCreate(tess_out->vertexBuffer, name_opt, a3buffer_vertex, capacity * sizeof(a3f32[3]), 0) > 0)
+			{
+				if (a3vertexArrayCreateDescriptor(tess_out->vertexArray, name_opt, tess_out->vertexBuffer, format, 0) > 0)
+				{
+					a3vertexDrawableCreate(tess_out->drawable, tess_out->vertexArray, a3prim_lines, 0, capacity);
+					tess_out->capacity = capacity;
+					tess_out->count = 0;
+					return 1;
+				}
+				a3bufferRelease(tess_out->vertexBuffer);
+			}
+			return 0;
+		}
+	}
+	return -1;
+}
+
+a3ret a3curveTessellationHardwareSupported()
+{
+	return (glPatchParameteri != 0);
+}
+
+a3ret a3curveTessellationUpdate(a3_CurveTessellation *tess, const a3f32 waypoint[][4], const a3f32 handle[][4], const a3ui32 count, const a3_CurveSegmentType type, const a3f32 *viewProjection, const a3f32 viewportWidth, const a3f32 viewportHeight)
+{
+	a3f32(*vertex)[3];
+	a3i32 result;
+	if (tess && tess->vertexBuffer->handle->handle && waypoint && handle && viewProjection)
+	{
+		// invalidate so the driver can hand out fresh storage instead of 
+		//	waiting for last frame's draw to finish
+		glBindBuffer(GL_ARRAY_BUFFER, tess->vertexBuffer->handle->handle);
+		vertex = glMapBufferRange(GL_ARRAY_BUFFER, 0, tess->capacity * sizeof(a3f32[3]), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+		result = vertex ? a3curveTessellate(vertex, tess->capacity, waypoint, handle, count, type, viewProjection, viewportWidth, viewportHeight) : 0;
+		if (vertex && !glUnmapBuffer(GL_ARRAY_BUFFER))
+			result = 0;
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		tess->count = result > 0 ? result : 0;
+		return tess->count;
+	}
+	return -1;
+}
+
+a3ret a3curveTessellationRender(const a3_CurveTessellation *tess)
+{
+	if (tess && tess->drawable->vertexArray)
+	{
+		if (tess->count)
+		{
+			a3vertexDrawableActivate(tess->drawable);
+			glDrawArrays(tess->drawable->primitive, 0, tess->count);
+		}
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3curveTessellationRenderHardware(const a3_CurveTessellation *tess, const a3ui32 count)
+{
+	if (tess && tess->drawable->vertexArray)
+	{
+		if (!glPatchParameteri)
+			return 0;
+
+		// the patch vertex is never read; the array is only bound because 
+		//	core profile requires one
+		if (count)
+		{
+			a3vertexDrawableActivate(tess->drawable);
+			glPatchParameteri(GL_PATCH_VERTICES, 1);
+			glDrawArraysInstanced(GL_PATCHES, 0, 1, count);
+		}
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3curveTessellationRelease(a3_CurveTessellation *tess)
+{
+	if (tess && tess->vertexBuffer->handle->handle)
+	{
+		a3vertexDrawableRelease(tess->drawable);
+		a3vertexArrayReleaseDescriptor(tess->vertexArray);
+		a3bufferRelease(tess->vertexBuffer);
+		tess->capacity = tess->count = 0;
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3curveTessellationHandleUpdateReleaseCallbacks(a3_CurveTessellation *tess)
+{
+	if (tess)
+	{
+		a3bufferHandleUpdateReleaseCallback(tess->vertexBuffer);
+		a3vertexArrayHandleUpdateReleaseCallback(tess->vertexArray);
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,114 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_FramebufferMixed-OpenGL.c
+	Definitions for OpenGL mixed-format framebuffer object.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_FramebufferMixed.h"
+
+#include <GL/glew.h>
+
+
+//-----------------------------------------------------------------------------
+// internal utilities
+
+// internal creation function (returns new handle if success)
+//	-> same as uniform creation but each color target selects its format
+a3ui32 a3framebufferMixedInternalCreate(a3ui32 *colorHandles, a3ui32 *depthHandle, const a3ui32 colorTargets, const a3_FramebufferTargetType *targetType, const a3_TexturePixelFormatDescriptor *depthPixelFormat, const a3ui16 width, const a3ui16 height)
+{
+	// internal format, format and data type per target type
+	static const a3ui32 targetFormat[a3fbo_target_max][3] = {
+		{ GL_RGBA8,				GL_RGBA,	GL_UNSIGNED_BYTE },
+		{ GL_RGB10_A2,			GL_RGBA,	GL_UNSIGNED_INT_2_10_10_10_REV },
+		{ GL_RGBA16,			GL_RGBA,	GL_UNSIGNED_SHORT },
+		{ GL_RGBA16F,			GL_RGBA,	GL_HALF_FLOAT },
+		{ GL_RG8,				GL_RG,		GL_UNSIGNED_BYTE },
+		{ GL_RG16,				GL_RG,		GL_UNSIGNED_SHORT },
+		{ GL_RG16F,				GL_RG,		GL_HALF_FLOAT },
+		{ GL_R32F,				GL_RED,		GL_FLOAT },
+		{ GL_R11F_G11F_B10F,	GL_RGB,		GL_UNSIGNED_INT_10F_11F_11F_REV },
+	};
+	const a3ui32 *format;
+	a3ui32 target;
+	a3ui32 handle;
+
+	// proceed if using color and/or depth
+	if (colorTargets || depthPixelFormat)
+	{
+		// create FBO
+		glGenFramebuffers(1, &handle);
+		if (handle)
+		{
+			// bind and configure FBO
+			glBindFramebuffer(GL_FRAMEBUFFER, handle);
+
+			// generate texture handles for color
+			if (colorTargets)
+			{
+				glGenTextures(colorTargets, colorHandles);
+				for (target = 0; target < colorTargets; ++target, ++colorHandles)
+				{
+					// bind and initialize texture with default settings
+					format = targetFormat[targetType[target]];
+					glBindTexture(GL_TEXTURE_2D, *colorHandles);
+					glTexImage2D(GL_TEXTURE_2D, 0, format[0], width, height, 0, format[1], format[2], 0);
+					a3textureDefaultSettings();
+
+					// bind color texture to FBO as render target
+					glFramebufferTexture2D(GL_FRAMEBUFFER, (GL_COLOR_ATTACHMENT0 + target), GL_TEXTURE_2D, *colorHandles, 0);
+				}
+			}
+
+			// generate texture handle for depth
+			if (depthPixelFormat)
+			{
+				glGenTextures(1, depthHandle);
+				glBindTexture(GL_TEXTURE_2D, *depthHandle);
+				glTexImage2D(GL_TEXTURE_2D, 0, depthPixelFormat->internalFormatBits, width, height, 0, depthPixelFormat->internalFormat, depthPixelFormat->internalDataType, 0);
+				a3textureDefaultSettings();
+
+				// bind depth texture to FBO
+				target = (depthPixelFormat->internalFormat == GL_DEPTH_STENCIL ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT);
+				glFramebufferTexture2D(GL_FRAMEBUFFER, target, GL_TEXTURE_2D, *depthHandle, 0);
+			}
+
+			// mixed formats are the most likely to be rejected by a driver
+			target = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+			// done, deactivate and return
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			glBindTexture(GL_TEXTURE_2D, 0);
+			if (target == GL_FRAMEBUFFER_COMPLETE)
+				return handle;
+
+			// incomplete: release everything created
+			glDeleteFramebuffers(1, &handle);
+			glDeleteTextures(colorTargets, colorHandles - colorTargets);
+			if (depthPixelFormat)
+				glDeleteTextures(1, depthHandle);
+		}
+	}
+	return 0;
+}
+
+
+//-----------------------------------------------------------------------------
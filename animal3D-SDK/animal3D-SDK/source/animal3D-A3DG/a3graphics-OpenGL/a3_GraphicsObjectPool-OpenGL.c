@@ -0,0 +1,94 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_GraphicsObjectPool-OpenGL.c
+	Release functions for OpenGL objects stored in a graphics object pool.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_GraphicsObjectPool.h"
+
+#include "GL/glew.h"
+
+
+//-----------------------------------------------------------------------------
+
+// auto-release functions; names of zero are silently ignored by GL
+void a3graphicsPoolInternalReleaseBuffers(a3i32 count, a3ui32 *handlePtr)
+{
+	glDeleteBuffers(count, handlePtr);
+}
+
+void a3graphicsPoolInternalReleaseTextures(a3i32 count, a3ui32 *handlePtr)
+{
+	glDeleteTextures(count, handlePtr);
+}
+
+void a3graphicsPoolInternalReleasePrograms(a3i32 count, a3ui32 *handlePtr)
+{
+	// no batch delete for programs
+	const a3ui32 *const end = handlePtr + count;
+	for (; handlePtr < end; ++handlePtr)
+		if (*handlePtr)
+			glDeleteProgram(*handlePtr);
+}
+
+void a3graphicsPoolInternalReleaseFramebuffers(a3i32 count, a3ui32 *handlePtr)
+{
+	glDeleteFramebuffers(count, handlePtr);
+}
+
+void a3graphicsPoolInternalReleaseVertexArrays(a3i32 count, a3ui32 *handlePtr)
+{
+	glDeleteVertexArrays(count, handlePtr);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3graphicsPoolCreateDefault(a3_GraphicsObjectPool *pool_out, const a3ui32 capacity)
+{
+	a3ret ret = a3graphicsPoolCreate(pool_out, capacity);
+	if (ret > 0)
+		a3graphicsPoolHandleUpdateReleaseCallbacks(pool_out);
+	return ret;
+}
+
+a3ret a3graphicsPoolHandleUpdateReleaseCallbacks(a3_GraphicsObjectPool *pool)
+{
+	// indexed by object type
+	const a3_GraphicsObjectReleaseFunc releaseFunc[a3pool_typeMax] = {
+		a3graphicsPoolInternalReleaseBuffers,
+		a3graphicsPoolInternalReleaseTextures,
+		a3graphicsPoolInternalReleasePrograms,
+		a3graphicsPoolInternalReleaseFramebuffers,
+		a3graphicsPoolInternalReleaseVertexArrays,
+	};
+	a3ui32 i;
+	if (pool)
+	{
+		for (i = 0; i < a3pool_typeMax; ++i)
+			pool->table[i].releaseFunc = releaseFunc[i];
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
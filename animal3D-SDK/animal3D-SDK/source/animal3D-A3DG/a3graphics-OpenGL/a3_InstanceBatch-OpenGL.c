@@ -0,0 +1,115 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_InstanceBatch-OpenGL.c
+	Definitions for OpenGL instance batching: records go in one uniform
+		buffer, orphaned for every pass, and each chunk of a group is
+		bound as a range for its draw.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_InstanceBatch.h"
+
+#include "GL/glew.h"
+
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3instanceBufferCreate(a3_InstanceBuffer *buffer_out, const a3ui32 size)
+{
+	GLint alignment = 0;
+	if (buffer_out && size)
+	{
+		if (!buffer_out->buffer)
+		{
+			// ranges start on the offset alignment so each can be bound
+			memset(buffer_out, 0, sizeof(a3_InstanceBuffer));
+			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+			buffer_out->alignment = alignment > 0 ? (a3ui32)alignment : 256;
+			buffer_out->size = size;
+
+			glGenBuffers(1, &buffer_out->buffer);
+			glBindBuffer(GL_UNIFORM_BUFFER, buffer_out->buffer);
+			glBufferData(GL_UNIFORM_BUFFER, size, 0, GL_STREAM_DRAW);
+			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+			return 1;
+		}
+	}
+	return -1;
+}
+
+a3ui32 a3instanceBufferAlign(const a3_InstanceBuffer *buffer, const a3ui32 offset)
+{
+	const a3ui32 alignment = buffer && buffer->alignment ? buffer->alignment : 1;
+	return (offset + alignment - 1) / alignment * alignment;
+}
+
+a3ret a3instanceBufferUpload(const a3_InstanceBuffer *buffer, const void *data, const a3ui32 size)
+{
+	if (buffer && buffer->buffer && data && size && size <= buffer->size)
+	{
+		// orphan: draws from the previous pass keep the old storage
+		glBindBuffer(GL_UNIFORM_BUFFER, buffer->buffer);
+		glBufferData(GL_UNIFORM_BUFFER, buffer->size, 0, GL_STREAM_DRAW);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		return size;
+	}
+	return -1;
+}
+
+a3ret a3instanceBufferRender(const a3_InstanceBuffer *buffer, const a3_VertexDrawable *drawable, const a3ui32 blockBinding, const a3ui32 offset, const a3ui32 stride, const a3ui32 count)
+{
+	a3ui32 first, chunk, start, range;
+	a3ret draws = 0;
+	if (buffer && buffer->buffer && drawable && drawable->vertexArray && stride)
+	{
+		// a full chunk spans a multiple of 1 KB, so the next one stays 
+		//	aligned; the whole block is bound even for a short chunk, 
+		//	since shaders declare it at full size
+		for (first = 0; first < count; first += chunk, ++draws)
+		{
+			chunk = count - first < a3instance_countMax ? count - first : a3instance_countMax;
+			start = offset + first * stride;
+			range = a3instance_countMax * stride;
+			if (start + range > buffer->size)
+				range = buffer->size - start;
+			glBindBufferRange(GL_UNIFORM_BUFFER, blockBinding, buffer->buffer, start, range);
+			a3vertexDrawableActivateAndRenderInstanced(drawable, chunk);
+		}
+		return draws;
+	}
+	return -1;
+}
+
+a3ret a3instanceBufferRelease(a3_InstanceBuffer *buffer)
+{
+	if (buffer && buffer->buffer)
+	{
+		glDeleteBuffers(1, &buffer->buffer);
+		memset(buffer, 0, sizeof(a3_InstanceBuffer));
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
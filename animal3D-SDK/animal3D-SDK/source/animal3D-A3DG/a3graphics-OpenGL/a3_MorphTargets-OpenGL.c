@@ -0,0 +1,127 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_MorphTargets-OpenGL.c
+	Definitions for OpenGL morph targets: sparse deltas, steps and 
+		per-instance weights live in storage buffers read by the vertex 
+		shader.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_MorphTargets.h"
+
+#include "GL/glew.h"
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3morphTargetsCreate(a3_MorphTargets *morph_out, const a3byte name_opt[32], const a3_MorphTargetData *data, const a3ui32 instanceCapacity)
+{
+	// a buffer may not be empty, so a target set that moves nothing still 
+	//	gets one (unused) delta
+	const a3_MorphDelta noDelta[1] = { 0 };
+
+	if (morph_out && data && data->basePosition && instanceCapacity)
+	{
+		if (!morph_out->range->handle->handle)
+		{
+			// storage buffers are GL 4.3
+			if (!glBindBufferBase || !glShaderStorageBlockBinding)
+				return 0;
+
+			if (a3bufferCreate(morph_out->range, name_opt, a3buffer_uniform, (data->vertexCount + 1) * sizeof(a3ui32), data->range) > 0 &&
+				a3bufferCreate(morph_out->delta, name_opt, a3buffer_uniform, (data->deltaCount ? data->deltaCount : 1) * sizeof(a3_MorphDelta), data->deltaCount ? data->delta : noDelta) > 0 &&
+				a3bufferCreate(morph_out->step, name_opt, a3buffer_uniform, data->targetCount * sizeof(*data->step), data->step) > 0 &&
+				a3bufferCreate(morph_out->weight, name_opt, a3buffer_uniform, instanceCapacity * data->targetCount * sizeof(a3f32), 0) > 0)
+			{
+				morph_out->vertexCount = data->vertexCount;
+				morph_out->targetCount = data->targetCount;
+				morph_out->instanceCapacity = instanceCapacity;
+				return 1;
+			}
+
+			// clean up partial creation
+			a3bufferRelease(morph_out->range);
+			a3bufferRelease(morph_out->delta);
+			a3bufferRelease(morph_out->step);
+			a3bufferRelease(morph_out->weight);
+			return 0;
+		}
+	}
+	return -1;
+}
+
+a3ret a3morphTargetsUpdateWeights(a3_MorphTargets *morph, const a3f32 *weight, const a3ui32 instanceCount)
+{
+	a3ui32 count;
+	if (morph && morph->range->handle->handle && weight)
+	{
+		count = instanceCount < morph->instanceCapacity ? instanceCount : morph->instanceCapacity;
+		if (count)
+			a3bufferRefill(morph->weight, 0, count * morph->targetCount * sizeof(a3f32), weight);
+		return count;
+	}
+	return -1;
+}
+
+a3ret a3morphTargetsRender(const a3_MorphTargets *morph, const a3_VertexDrawable *drawable, const a3ui32 instanceCount)
+{
+	if (morph && morph->range->handle->handle && drawable && drawable->vertexArray)
+	{
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, a3morph_bindingRange, morph->range->handle->handle);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, a3morph_bindingDelta, morph->delta->handle->handle);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, a3morph_bindingStep, morph->step->handle->handle);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, a3morph_bindingWeight, morph->weight->handle->handle);
+		glUniform1i(a3morph_uniformTargetCount, (GLint)morph->targetCount);
+		a3vertexDrawableActivateAndRenderInstanced(drawable, instanceCount < morph->instanceCapacity ? instanceCount : morph->instanceCapacity);
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3morphTargetsRelease(a3_MorphTargets *morph)
+{
+	if (morph && morph->range->handle->handle)
+	{
+		a3bufferRelease(morph->range);
+		a3bufferRelease(morph->delta);
+		a3bufferRelease(morph->step);
+		a3bufferRelease(morph->weight);
+		morph->vertexCount = morph->targetCount = morph->instanceCapacity = 0;
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3morphTargetsHandleUpdateReleaseCallbacks(a3_MorphTargets *morph)
+{
+	if (morph)
+	{
+		a3bufferHandleUpdateReleaseCallback(morph->range);
+		a3bufferHandleUpdateReleaseCallback(morph->delta);
+		a3bufferHandleUpdateReleaseCallback(morph->step);
+		a3bufferHandleUpdateReleaseCallback(morph->weight);
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
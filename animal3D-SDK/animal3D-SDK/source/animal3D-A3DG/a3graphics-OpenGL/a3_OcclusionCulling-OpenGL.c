@@ -0,0 +1,300 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_OcclusionCulling-OpenGL.c
+	Definitions for OpenGL occlusion culling: the pyramid is an immutable
+		float texture written one level at a time through image stores, and
+		test results go to a ring of storage buffers read once fenced.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_OcclusionCulling.h"
+
+#include "GL/glew.h"
+
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+// release pyramid texture
+inline void a3occlusionInternalReleasePyramid(a3_OcclusionCuller *culler)
+{
+	if (culler->pyramid)
+		glDeleteTextures(1, &culler->pyramid);
+	culler->pyramid = culler->depthWidth = culler->depthHeight = culler->levelCount = 0;
+	culler->pyramidFrames = 0;
+}
+
+// delete the fences of all slots
+inline void a3occlusionInternalReleaseFences(a3_OcclusionCuller *culler)
+{
+	a3ui32 i;
+	for (i = 0; i < culler->slotCount; ++i)
+		if (culler->resultFence[i])
+		{
+			glDeleteSync((GLsync)culler->resultFence[i]);
+			culler->resultFence[i] = 0;
+		}
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3occlusionCullerCreate(a3_OcclusionCuller *culler_out, const a3ui32 capacity, const a3ui32 slotCount)
+{
+	a3ui32 i;
+	if (culler_out && capacity && slotCount && slotCount <= a3occlusion_slotMax)
+	{
+		if (!culler_out->bounds)
+		{
+			// compute, storage buffers and image stores are GL 4.3
+			if (!glDispatchCompute || !glBindBufferBase || !glBindImageTexture || !glTexStorage2D || !glMemoryBarrier)
+				return 0;
+
+			memset(culler_out, 0, sizeof(a3_OcclusionCuller));
+			culler_out->capacity = capacity;
+			culler_out->slotCount = slotCount;
+
+			// boxes are rewritten every test; results are written by the GPU
+			//	and read back
+			glGenBuffers(1, &culler_out->bounds);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, culler_out->bounds);
+			glBufferData(GL_SHADER_STORAGE_BUFFER, capacity * sizeof(a3f32[2][4]), 0, GL_STREAM_DRAW);
+			glGenBuffers(slotCount, culler_out->result);
+			for (i = 0; i < slotCount; ++i)
+			{
+				glBindBuffer(GL_SHADER_STORAGE_BUFFER, culler_out->result[i]);
+				glBufferData(GL_SHADER_STORAGE_BUFFER, capacity * sizeof(a3ui32), 0, GL_STREAM_READ);
+			}
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+			return 1;
+		}
+	}
+	return -1;
+}
+
+a3ret a3occlusionCullerBeginFrame(a3_OcclusionCuller *culler, const a3ui32 depthWidth, const a3ui32 depthHeight)
+{
+	a3ui32 levelCount;
+	if (culler && culler->bounds && depthWidth && depthHeight)
+	{
+		// immutable storage: a new size needs a new texture
+		if (culler->depthWidth != depthWidth || culler->depthHeight != depthHeight)
+		{
+			a3occlusionInternalReleasePyramid(culler);
+			a3occlusionPyramidSize(depthWidth, depthHeight, &levelCount);
+			glGenTextures(1, &culler->pyramid);
+			glBindTexture(GL_TEXTURE_2D, culler->pyramid);
+			glTexStorage2D(GL_TEXTURE_2D, levelCount, GL_R32F,
+				depthWidth > 1 ? depthWidth / 2 : 1, depthHeight > 1 ? depthHeight / 2 : 1);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glBindTexture(GL_TEXTURE_2D, 0);
+			culler->depthWidth = depthWidth;
+			culler->depthHeight = depthHeight;
+			culler->levelCount = levelCount;
+		}
+
+		// the pyramid is built after the scene each frame from now on
+		return (culler->pyramidFrames++ > 0);
+	}
+	return -1;
+}
+
+a3ret a3occlusionCullerReset(a3_OcclusionCuller *culler)
+{
+	if (culler && culler->bounds)
+	{
+		a3occlusionInternalReleaseFences(culler);
+		culler->pyramidFrames = 0;
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3occlusionCullerBuildPyramid(const a3_OcclusionCuller *culler, const a3_ShaderProgram *reduceProgram, const a3_Framebuffer *framebuffer)
+{
+	a3ui32 level, w, h;
+	if (culler && culler->bounds && reduceProgram && framebuffer && *framebuffer->depthTextureHandle)
+	{
+		if (!culler->pyramid || framebuffer->frameWidth != culler->depthWidth || framebuffer->frameHeight != culler->depthHeight)
+			return 0;
+
+		// each level reads the previous one (depth for the first) through
+		//	the source unit and writes itself through the target image
+		a3shaderProgramActivate(reduceProgram);
+		glActiveTexture(GL_TEXTURE0 + a3occlusion_unitSource);
+		for (level = 0; level < culler->levelCount; ++level)
+		{
+			glBindTexture(GL_TEXTURE_2D, level ? culler->pyramid : *framebuffer->depthTextureHandle);
+			glUniform1i(a3occlusion_uniformSourceLevel, level ? (GLint)level - 1 : 0);
+			glBindImageTexture(a3occlusion_imageTarget, culler->pyramid, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+			w = (culler->depthWidth >> 1) >> level;
+			h = (culler->depthHeight >> 1) >> level;
+			w = w ? w : 1;
+			h = h ? h : 1;
+			glDispatchCompute((w + a3occlusion_tileSize - 1) / a3occlusion_tileSize, (h + a3occlusion_tileSize - 1) / a3occlusion_tileSize, 1);
+			glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+		}
+		glBindImageTexture(a3occlusion_imageTarget, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		return culler->levelCount;
+	}
+	return -1;
+}
+
+a3ret a3occlusionCullerTest(a3_OcclusionCuller *culler, const a3_ShaderProgram *testProgram, const a3f32(*boundsMin)[4], const a3f32(*boundsMax)[4], const a3ui32 count, const a3f32 *viewProjectionMat)
+{
+	a3f32(*bounds)[2][4];
+	a3ui32 const slot = culler ? culler->slotIndex : 0;
+	a3ui32 i;
+	if (culler && culler->bounds && culler->pyramid && testProgram && boundsMin && boundsMax && count && count <= culler->capacity && viewProjectionMat)
+	{
+		// boxes interleaved (min, max) as the shader reads them
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, culler->bounds);
+		bounds = (a3f32(*)[2][4])glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, count * sizeof(*bounds), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+		if (bounds)
+		{
+			for (i = 0; i < count; ++i)
+			{
+				memcpy(bounds[i][0], boundsMin[i], sizeof(bounds[i][0]));
+				memcpy(bounds[i][1], boundsMax[i], sizeof(bounds[i][1]));
+			}
+			glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+		}
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		if (!bounds)
+			return -1;
+
+		// a result not read yet is overwritten
+		if (culler->resultFence[slot])
+		{
+			glDeleteSync((GLsync)culler->resultFence[slot]);
+			culler->resultFence[slot] = 0;
+		}
+
+		a3shaderProgramActivate(testProgram);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, a3occlusion_bindingBounds, culler->bounds);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, a3occlusion_bindingVisible, culler->result[slot]);
+		glActiveTexture(GL_TEXTURE0 + a3occlusion_unitSource);
+		glBindTexture(GL_TEXTURE_2D, culler->pyramid);
+		glUniformMatrix4fv(a3occlusion_uniformViewProjection, 1, GL_FALSE, viewProjectionMat);
+		glUniform2ui(a3occlusion_uniformDepthSize, culler->depthWidth, culler->depthHeight);
+		glUniform1i(a3occlusion_uniformLevelCount, (GLint)culler->levelCount);
+		glUniform1ui(a3occlusion_uniformObjectCount, count);
+		glDispatchCompute((count + a3occlusion_groupSize - 1) / a3occlusion_groupSize, 1, 1);
+		glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		// results are ready once this fence signals
+		culler->resultFence[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		culler->resultCount[slot] = count;
+		culler->slotIndex = (slot + 1) % culler->slotCount;
+		return count;
+	}
+	return -1;
+}
+
+a3ret a3occlusionCullerReadback(a3_OcclusionCuller *culler, a3boolean *visible_out, const a3ui32 count, const a3boolean wait)
+{
+	a3ui32 result[256], i, j, k, c, n, slot;
+	GLenum status;
+	if (culler && culler->bounds && visible_out && count <= culler->capacity)
+	{
+		// newest slot first; once one is ready, older ones are stale
+		for (i = 0; i < culler->slotCount; ++i)
+		{
+			slot = (culler->slotIndex + culler->slotCount - 1 - i) % culler->slotCount;
+			if (!culler->resultFence[slot])
+				continue;
+			status = glClientWaitSync((GLsync)culler->resultFence[slot], GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+			while (wait && status == GL_TIMEOUT_EXPIRED)
+				status = glClientWaitSync((GLsync)culler->resultFence[slot], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+			if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+				continue;
+
+			// copy out in chunks, converting words to flags
+			n = count < culler->resultCount[slot] ? count : culler->resultCount[slot];
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, culler->result[slot]);
+			for (j = 0; j < n; j += k)
+			{
+				k = n - j < 256 ? n - j : 256;
+				glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, j * sizeof(a3ui32), k * sizeof(a3ui32), result);
+				for (c = 0; c < k; ++c)
+					visible_out[j + c] = result[c] != 0;
+			}
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+			// this and older results are done with; newer ones stay pending
+			for (; i < culler->slotCount; ++i)
+			{
+				slot = (culler->slotIndex + culler->slotCount - 1 - i) % culler->slotCount;
+				if (culler->resultFence[slot])
+				{
+					glDeleteSync((GLsync)culler->resultFence[slot]);
+					culler->resultFence[slot] = 0;
+				}
+			}
+			return n;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3occlusionCullerReadPyramid(const a3_OcclusionCuller *culler, a3f32 *pyramid_out)
+{
+	a3ui32 level, w, h;
+	if (culler && culler->pyramid && pyramid_out)
+	{
+		glBindTexture(GL_TEXTURE_2D, culler->pyramid);
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		for (level = 0; level < culler->levelCount; ++level, pyramid_out += w * h)
+		{
+			w = (culler->depthWidth >> 1) >> level;
+			h = (culler->depthHeight >> 1) >> level;
+			w = w ? w : 1;
+			h = h ? h : 1;
+			glGetTexImage(GL_TEXTURE_2D, level, GL_RED, GL_FLOAT, pyramid_out);
+		}
+		glBindTexture(GL_TEXTURE_2D, 0);
+		return culler->levelCount;
+	}
+	return -1;
+}
+
+a3ret a3occlusionCullerRelease(a3_OcclusionCuller *culler)
+{
+	if (culler && culler->bounds)
+	{
+		a3occlusionInternalReleaseFences(culler);
+		a3occlusionInternalReleasePyramid(culler);
+		glDeleteBuffers(culler->slotCount, culler->result);
+		glDeleteBuffers(1, &culler->bounds);
+		memset(culler, 0, sizeof(a3_OcclusionCuller));
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
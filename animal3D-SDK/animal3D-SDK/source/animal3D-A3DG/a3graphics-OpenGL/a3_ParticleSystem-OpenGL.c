@@ -0,0 +1,242 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_ParticleSystem-OpenGL.c
+	Definitions for OpenGL particle system: storage buffers hold the pools, 
+		and the state buffer doubles as the indirect dispatch and draw 
+		buffer so that live counts stay on the GPU.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_ParticleSystem.h"
+
+#include "GL/glew.h"
+
+#include <stddef.h>
+
+
+//-----------------------------------------------------------------------------
+
+// byte offset of a word in the state buffer
+#define a3particleInternalStateOffset(word)	((a3ui32)(word) * sizeof(a3ui32))
+
+// size of one index in bytes
+inline a3ui32 a3particleInternalIndexSize(const a3ui16 indexType)
+{
+	switch (indexType)
+	{
+	case GL_UNSIGNED_BYTE:
+		return 1;
+	case GL_UNSIGNED_SHORT:
+		return 2;
+	}
+	return 4;
+}
+
+// bind pools and state to their storage bindings
+inline void a3particleInternalBind(const a3_ParticleSystem *system)
+{
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, a3particle_bindingSource, system->pool[system->source].handle->handle);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, a3particle_bindingTarget, system->pool[system->source ^ 1].handle->handle);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, a3particle_bindingState, system->state->handle->handle);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3particleSystemCreate(a3_ParticleSystem *system_out, const a3byte name_opt[32], const a3ui32 capacity, const a3_VertexDrawable *drawable)
+{
+	a3ui32 state[a3particle_stateCount] = { 0 };
+	a3ui32 *const draw = state + a3particle_stateDraw;
+	a3ui32 *const dispatch = state + a3particle_stateDispatch;
+
+	if (system_out && capacity && drawable && drawable->count)
+	{
+		if (!system_out->state->handle->handle)
+		{
+			// storage buffers, compute and indirect dispatch are GL 4.3
+			if (!glDispatchComputeIndirect || !glBindBufferBase || !glMemoryBarrier || !glDrawElementsIndirect)
+				return 0;
+
+			// draw command: instance count is written by finalize
+			//	-> elements: count, instances, first index, base vertex, base instance
+			//	-> arrays: count, instances, first vertex, base instance
+			draw[0] = drawable->count;
+			draw[2] = drawable->indexType
+				? (a3ui32)((size_t)drawable->indexing / a3particleInternalIndexSize(drawable->indexType))
+				: drawable->first;
+
+			// dispatch command: no groups until something is emitted
+			dispatch[1] = dispatch[2] = 1;
+
+			if (a3bufferCreate(system_out->pool + 0, name_opt, a3buffer_uniform, capacity * sizeof(a3_Particle), 0) > 0 &&
+				a3bufferCreate(system_out->pool + 1, name_opt, a3buffer_uniform, capacity * sizeof(a3_Particle), 0) > 0 &&
+				a3bufferCreate(system_out->state, name_opt, a3buffer_uniform, sizeof(state), state) > 0)
+			{
+				system_out->capacity = capacity;
+				system_out->source = 0;
+				system_out->emitted = 0;
+				system_out->emitCarry = 0.0f;
+				return 1;
+			}
+
+			// clean up partial creation
+			a3bufferRelease(system_out->pool + 0);
+			a3bufferRelease(system_out->pool + 1);
+			a3bufferRelease(system_out->state);
+			return 0;
+		}
+	}
+	return -1;
+}
+
+a3ret a3particleSystemUpdate(a3_ParticleSystem *system, const a3_ShaderProgram *simulateProgram, const a3_ShaderProgram *emitProgram, const a3_ShaderProgram *finalizeProgram, const a3_ParticleEmitter *emitter, const a3f32 dt)
+{
+	a3ui32 emitCount;
+	if (system && system->state->handle->handle && simulateProgram && emitProgram && finalizeProgram && emitter && dt > 0.0f)
+	{
+		emitCount = a3particleEmitCount(&system->emitCarry, emitter->rate, dt);
+		if (emitCount > system->capacity)
+			emitCount = system->capacity;
+
+		a3particleInternalBind(system);
+
+		// simulate: one thread per live particle, survivors are appended 
+		//	to the target pool; group count comes from the last finalize
+		a3shaderProgramActivate(simulateProgram);
+		glUniform4fv(a3particle_uniformGravity, 1, emitter->gravity);
+		glUniform1f(a3particle_uniformTimeStep, dt);
+		glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, system->state->handle->handle);
+		glDispatchComputeIndirect(a3particleInternalStateOffset(a3particle_stateDispatch));
+		glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+		// emit: append new particles after the survivors
+		if (emitCount)
+		{
+			a3shaderProgramActivate(emitProgram);
+			glUniform4fv(a3particle_uniformEmitPosition, 1, emitter->position);
+			glUniform4fv(a3particle_uniformEmitVelocity, 1, emitter->velocity);
+			glUniform4fv(a3particle_uniformEmitColor, 1, emitter->color);
+			glUniform4fv(a3particle_uniformEmitLife, 1, emitter->life);
+			glUniform1ui(a3particle_uniformEmitCount, emitCount);
+			glUniform1ui(a3particle_uniformEmitIndex, system->emitted);
+			glUniform1ui(a3particle_uniformSeed, emitter->seed);
+			glUniform1ui(a3particle_uniformCapacity, system->capacity);
+			glDispatchCompute((emitCount + a3particle_groupSize - 1) / a3particle_groupSize, 1, 1);
+			glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+		}
+
+		// finalize: live count becomes next dispatch size and instance count
+		a3shaderProgramActivate(finalizeProgram);
+		glUniform1ui(a3particle_uniformCapacity, system->capacity);
+		glDispatchCompute(1, 1, 1);
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+		// target is now current
+		system->source ^= 1;
+		system->emitted += emitCount;
+		return emitCount;
+	}
+	return -1;
+}
+
+a3ret a3particleSystemRender(const a3_ParticleSystem *system, const a3_VertexDrawable *drawable)
+{
+	const void *const command = (const void *)(size_t)a3particleInternalStateOffset(a3particle_stateDraw);
+	if (system && system->state->handle->handle && drawable && drawable->vertexArray)
+	{
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, a3particle_bindingSource, system->pool[system->source].handle->handle);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, system->state->handle->handle);
+		a3vertexDrawableActivate(drawable);
+		if (drawable->indexType)
+			glDrawElementsIndirect(drawable->primitive, drawable->indexType, command);
+		else
+			glDrawArraysIndirect(drawable->primitive, command);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3particleSystemReadback(const a3_ParticleSystem *system, a3_Particle *particle_out_opt)
+{
+	a3ui32 alive = 0;
+	if (system && system->state->handle->handle)
+	{
+		glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, system->state->handle->handle);
+		glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, a3particleInternalStateOffset(a3particle_stateAlive), sizeof(alive), &alive);
+		if (particle_out_opt && alive)
+		{
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, system->pool[system->source].handle->handle);
+			glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, alive * sizeof(a3_Particle), particle_out_opt);
+		}
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		return alive;
+	}
+	return -1;
+}
+
+a3ret a3particleSystemReset(a3_ParticleSystem *system)
+{
+	const a3ui32 zero[2] = { 0 };
+	if (system && system->state->handle->handle)
+	{
+		// no instances, no groups, nothing alive or counted
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, system->state->handle->handle);
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, a3particleInternalStateOffset(a3particle_stateDraw + 1), sizeof(*zero), zero);
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, a3particleInternalStateOffset(a3particle_stateDispatch), sizeof(*zero), zero);
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, a3particleInternalStateOffset(a3particle_stateAlive), sizeof(zero), zero);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		system->emitted = 0;
+		system->emitCarry = 0.0f;
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3particleSystemRelease(a3_ParticleSystem *system)
+{
+	if (system && system->state->handle->handle)
+	{
+		a3bufferRelease(system->pool + 0);
+		a3bufferRelease(system->pool + 1);
+		a3bufferRelease(system->state);
+		system->capacity = 0;
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3particleSystemHandleUpdateReleaseCallbacks(a3_ParticleSystem *system)
+{
+	if (system)
+	{
+		a3bufferHandleUpdateReleaseCallback(system->pool + 0);
+		a3bufferHandleUpdateReleaseCallback(system->pool + 1);
+		a3bufferHandleUpdateReleaseCallback(system->state);
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
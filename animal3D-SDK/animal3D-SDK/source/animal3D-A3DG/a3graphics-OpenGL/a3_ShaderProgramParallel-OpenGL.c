@@ -0,0 +1,208 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_ShaderProgramParallel-OpenGL.c
+	Definitions for deferred GLSL compile and link using the driver's 
+		parallel compiler (KHR_parallel_shader_compile) when available.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_ShaderProgramParallel.h"
+
+#include "GL/glew.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+//-----------------------------------------------------------------------------
+
+void a3shaderInternalPrintLog(const a3boolean isProgram, const a3boolean isLink, const a3ui32 handle, const a3byte *name);
+void a3shaderInternalReleaseFunc(a3i32 count, a3ui32 *handlePtr);
+
+
+// completion status may only be queried if the extension is present; 
+//	without it, every status query simply waits
+static a3boolean a3shaderInternalParallel = 0;
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3shaderParallelInitialize(const a3ui32 threadCount)
+{
+	if (glMaxShaderCompilerThreadsKHR)
+	{
+		glMaxShaderCompilerThreadsKHR(threadCount);
+		a3shaderInternalParallel = (threadCount != 0);
+		return a3shaderInternalParallel;
+	}
+	a3shaderInternalParallel = 0;
+	return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3shaderCreateFromSourceListDeferred(a3_Shader *shader_out, const a3byte name_opt[32], const a3_ShaderType type, const a3byte **sourceList, const a3ui32 count)
+{
+	static const a3ui16 internalShaderType[] = { GL_VERTEX_SHADER, GL_TESS_CONTROL_SHADER, GL_TESS_EVALUATION_SHADER, GL_GEOMETRY_SHADER, GL_FRAGMENT_SHADER, GL_COMPUTE_SHADER };
+
+	a3_Shader ret = { 0 };
+	a3ui32 handle;
+	a3ui32 newCount, i;
+	a3i32 result = 0;
+	const a3byte **itr, **valid;
+
+	if (shader_out && sourceList)
+	{
+		if (!shader_out->handle->handle)
+		{
+			// skip empty sources
+			valid = (const a3byte **)malloc((count + 1) * sizeof(a3byte *));
+			for (i = newCount = 0, itr = sourceList; i < count; ++i, ++itr)
+				if (*itr && **itr)
+					valid[newCount++] = *itr;
+
+			if (newCount)
+			{
+				// create and compile, but do not ask for the status: that 
+				//	is the call that would wait for the compiler
+				handle = glCreateShader(internalShaderType[type]);
+				if (handle)
+				{
+					glShaderSource(handle, newCount, valid, 0);
+					glCompileShader(handle);
+
+					// compiled is set once the result is known
+					a3handleCreateHandle(ret.handle, a3shaderInternalReleaseFunc, name_opt, handle, 0);
+					ret.type = type;
+					*shader_out = ret;
+					a3shaderReference(shader_out);
+					result = newCount;
+				}
+				else
+					printf("\n A3 ERROR (SHDR \'%s\'): \n\t Invalid handle; shader not created.", name_opt);
+			}
+			free((void *)valid);
+			return result;
+		}
+	}
+	return -1;
+}
+
+a3ret a3shaderCompileIsComplete(const a3_Shader *shader)
+{
+	a3i32 status = 1;
+	if (shader && shader->handle->handle)
+	{
+		if (!shader->compiled && a3shaderInternalParallel)
+			glGetShaderiv(shader->handle->handle, GL_COMPLETION_STATUS_KHR, &status);
+		return (status != 0);
+	}
+	return -1;
+}
+
+a3ret a3shaderCompileFinish(a3_Shader *shader)
+{
+	a3ui32 handle;
+	a3i32 status;
+	if (shader && shader->handle->handle)
+	{
+		if (!shader->compiled)
+		{
+			handle = shader->handle->handle;
+			glGetShaderiv(handle, GL_COMPILE_STATUS, &status);
+			if (status)
+			{
+				shader->compiled = 1;
+				return 1;
+			}
+
+			// failed, get log and release, same as an immediate compile
+			a3shaderInternalPrintLog(0, 0, handle, shader->handle->name);
+			a3shaderRelease(shader);
+			return 0;
+		}
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3shaderProgramLinkDeferred(a3_ShaderProgram *program)
+{
+	a3ui32 pHandle;
+	if (program)
+	{
+		pHandle = program->handle->handle;
+		if (pHandle)
+		{
+			if (!program->linked)
+			{
+				glLinkProgram(pHandle);
+				return 1;
+			}
+			printf("\n A3 WARNING (PROG %u \'%s\'): \n\t Program already linked; program not re-linked.", pHandle, program->handle->name);
+			return 0;
+		}
+	}
+	return -1;
+}
+
+a3ret a3shaderProgramLinkIsComplete(const a3_ShaderProgram *program)
+{
+	a3i32 status = 1;
+	if (program && program->handle->handle)
+	{
+		if (!program->linked && a3shaderInternalParallel)
+			glGetProgramiv(program->handle->handle, GL_COMPLETION_STATUS_KHR, &status);
+		return (status != 0);
+	}
+	return -1;
+}
+
+a3ret a3shaderProgramLinkFinish(a3_ShaderProgram *program)
+{
+	a3ui32 pHandle;
+	a3i32 status;
+	if (program && program->handle->handle)
+	{
+		if (!program->linked)
+		{
+			pHandle = program->handle->handle;
+			glGetProgramiv(pHandle, GL_LINK_STATUS, &status);
+			if (status)
+			{
+				program->linked = 1;
+				return 1;
+			}
+
+			// failed, get log; do not delete program
+			a3shaderInternalPrintLog(1, 1, pHandle, program->handle->name);
+			return 0;
+		}
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
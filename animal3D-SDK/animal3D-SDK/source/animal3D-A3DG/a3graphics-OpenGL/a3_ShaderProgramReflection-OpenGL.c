@@ -0,0 +1,154 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_ShaderProgramReflection-OpenGL.c
+	Definitions for uniform reflection using program introspection; the 
+		program interface query is used when available so that locations 
+		come back with everything else, without any lookups by name.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_ShaderProgramReflection.h"
+
+#include "GL/glew.h"
+
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3shaderReflectInternalAddUniform(a3_ShaderProgramReflection *reflection, const a3byte *name, const a3i32 location, const a3ui32 count, const a3ui32 sampler);
+a3ret a3shaderReflectInternalAddBlock(a3_ShaderProgramReflection *reflection, const a3byte *name, const a3i32 index, const a3ui32 size);
+
+
+// samplers and images get texture units rather than values
+a3ui32 a3shaderReflectInternalIsSampler(const GLenum type)
+{
+	switch (type)
+	{
+	case GL_SAMPLER_1D:
+	case GL_SAMPLER_2D:
+	case GL_SAMPLER_3D:
+	case GL_SAMPLER_CUBE:
+	case GL_SAMPLER_1D_SHADOW:
+	case GL_SAMPLER_2D_SHADOW:
+	case GL_SAMPLER_2D_RECT:
+	case GL_SAMPLER_2D_RECT_SHADOW:
+	case GL_SAMPLER_1D_ARRAY:
+	case GL_SAMPLER_2D_ARRAY:
+	case GL_SAMPLER_1D_ARRAY_SHADOW:
+	case GL_SAMPLER_2D_ARRAY_SHADOW:
+	case GL_SAMPLER_CUBE_SHADOW:
+	case GL_SAMPLER_BUFFER:
+	case GL_SAMPLER_2D_MULTISAMPLE:
+	case GL_SAMPLER_2D_MULTISAMPLE_ARRAY:
+	case GL_SAMPLER_CUBE_MAP_ARRAY:
+	case GL_SAMPLER_CUBE_MAP_ARRAY_SHADOW:
+	case GL_INT_SAMPLER_2D:
+	case GL_INT_SAMPLER_2D_ARRAY:
+	case GL_INT_SAMPLER_BUFFER:
+	case GL_UNSIGNED_INT_SAMPLER_2D:
+	case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY:
+	case GL_UNSIGNED_INT_SAMPLER_BUFFER:
+	case GL_IMAGE_2D:
+	case GL_IMAGE_2D_ARRAY:
+	case GL_IMAGE_3D:
+	case GL_IMAGE_BUFFER:
+	case GL_INT_IMAGE_2D:
+	case GL_UNSIGNED_INT_IMAGE_2D:
+		return 1;
+	}
+	return 0;
+}
+
+// remove array subscript so arrays are found by their plain name
+void a3shaderReflectInternalTrimName(a3byte *name)
+{
+	a3byte *const subscript = strchr(name, '[');
+	if (subscript)
+		*subscript = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3shaderProgramReflect(a3_ShaderProgramReflection *reflection_out, const a3_ShaderProgram *program)
+{
+	const GLenum uniformProps[] = { GL_BLOCK_INDEX, GL_LOCATION, GL_ARRAY_SIZE, GL_TYPE };
+	const GLenum blockProps[] = { GL_BUFFER_DATA_SIZE };
+	GLint count, i, values[4];
+	GLenum type;
+	GLuint handle;
+	a3byte name[a3shaderReflect_nameMax * 2];
+	if (reflection_out && program && program->handle->handle && program->linked)
+	{
+		memset(reflection_out, 0, sizeof(a3_ShaderProgramReflection));
+		handle = program->handle->handle;
+
+		if (glGetProgramResourceiv)
+		{
+			// everything about a uniform in one call
+			glGetProgramInterfaceiv(handle, GL_UNIFORM, GL_ACTIVE_RESOURCES, &count);
+			for (i = 0; i < count; ++i)
+			{
+				glGetProgramResourceiv(handle, GL_UNIFORM, i, 4, uniformProps, 4, 0, values);
+				if (values[0] >= 0)
+					continue;
+				glGetProgramResourceName(handle, GL_UNIFORM, i, sizeof(name), 0, name);
+				a3shaderReflectInternalTrimName(name);
+				a3shaderReflectInternalAddUniform(reflection_out, name, values[1], values[2], a3shaderReflectInternalIsSampler(values[3]));
+			}
+
+			glGetProgramInterfaceiv(handle, GL_UNIFORM_BLOCK, GL_ACTIVE_RESOURCES, &count);
+			for (i = 0; i < count; ++i)
+			{
+				glGetProgramResourceiv(handle, GL_UNIFORM_BLOCK, i, 1, blockProps, 1, 0, values);
+				glGetProgramResourceName(handle, GL_UNIFORM_BLOCK, i, sizeof(name), 0, name);
+				a3shaderReflectInternalAddBlock(reflection_out, name, i, values[0]);
+			}
+		}
+		else
+		{
+			// older path: location is still one lookup per active uniform
+			glGetProgramiv(handle, GL_ACTIVE_UNIFORMS, &count);
+			for (i = 0; i < count; ++i)
+			{
+				glGetActiveUniformsiv(handle, 1, (const GLuint *)&i, GL_UNIFORM_BLOCK_INDEX, values);
+				if (values[0] >= 0)
+					continue;
+				glGetActiveUniform(handle, i, sizeof(name), 0, values + 2, &type, name);
+				a3shaderReflectInternalTrimName(name);
+				a3shaderReflectInternalAddUniform(reflection_out, name, glGetUniformLocation(handle, name), values[2], a3shaderReflectInternalIsSampler(type));
+			}
+
+			glGetProgramiv(handle, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+			for (i = 0; i < count; ++i)
+			{
+				glGetActiveUniformBlockiv(handle, i, GL_UNIFORM_BLOCK_DATA_SIZE, values);
+				glGetActiveUniformBlockName(handle, i, sizeof(name), 0, name);
+				a3shaderReflectInternalAddBlock(reflection_out, name, i, values[0]);
+			}
+		}
+		return (reflection_out->uniformCount + reflection_out->blockCount);
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
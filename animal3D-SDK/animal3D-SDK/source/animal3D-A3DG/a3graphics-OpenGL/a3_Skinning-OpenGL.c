@@ -0,0 +1,209 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Skinning-OpenGL.c
+	Definitions for OpenGL skinning: palettes are written to a ring of
+		storage buffer segments and bound as a range for each draw.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_Skinning.h"
+
+#include "GL/glew.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+// A3: buffer pointer offset utility: offset a pointer by 'n' bytes
+#define A3_BUFFER_OFFSET(n) ((a3byte *)(0) + (n))
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3skinVertexArrayStoreInfluences(a3_VertexArrayDescriptor *vertexArray, const a3ubyte(*index)[4], const a3ui16(*weight)[4], const a3ui32 count)
+{
+	a3ui32 weightOffset, indexOffset;
+	if (vertexArray && vertexArray->handle->handle && vertexArray->vertexBuffer && index && weight && count)
+	{
+		// weights first so both arrays keep their natural alignment
+		if (a3bufferAppend(vertexArray->vertexBuffer, 0, count * sizeof(*weight), weight, &weightOffset) > 0 &&
+			a3bufferAppend(vertexArray->vertexBuffer, 0, count * sizeof(*index), index, &indexOffset) > 0)
+		{
+			glBindVertexArray(vertexArray->handle->handle);
+			glBindBuffer(GL_ARRAY_BUFFER, vertexArray->vertexBuffer->handle->handle);
+
+			// weights are fractions of the 16-bit range
+			glEnableVertexAttribArray(a3attrib_blendWeights);
+			glVertexAttribPointer(a3attrib_blendWeights, a3skin_influenceMax, GL_UNSIGNED_SHORT, GL_TRUE,
+				sizeof(*weight), A3_BUFFER_OFFSET(weightOffset));
+
+			// indices stay integers
+			glEnableVertexAttribArray(a3attrib_blendIndices);
+			glVertexAttribIPointer(a3attrib_blendIndices, a3skin_influenceMax, GL_UNSIGNED_BYTE,
+				sizeof(*index), A3_BUFFER_OFFSET(indexOffset));
+
+			glBindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+			return weightOffset;
+		}
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3skinPaletteRingCreate(a3_SkinPaletteRing *ring_out, const a3ui32 segmentSize, const a3ui32 segmentCount)
+{
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	GLint alignment = 0;
+	if (ring_out && segmentSize && segmentCount && segmentCount <= a3skin_segmentMax)
+	{
+		if (!ring_out->buffer)
+		{
+			// storage buffers are GL 4.3
+			if (!glBindBufferRange || !glShaderStorageBlockBinding)
+				return 0;
+
+			// segments start on the offset alignment so each can be bound
+			memset(ring_out, 0, sizeof(a3_SkinPaletteRing));
+			glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+			ring_out->alignment = alignment > 0 ? (a3ui32)alignment : 16;
+			ring_out->segmentSize = (segmentSize + ring_out->alignment - 1) / ring_out->alignment * ring_out->alignment;
+			ring_out->segmentCount = segmentCount;
+
+			glGenBuffers(1, &ring_out->buffer);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, ring_out->buffer);
+
+			// persistent mapping requires immutable buffer storage
+			if (glBufferStorage)
+			{
+				glBufferStorage(GL_SHADER_STORAGE_BUFFER, ring_out->segmentSize * segmentCount, 0, flags);
+				ring_out->mapped = (a3byte *)glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, ring_out->segmentSize * segmentCount, flags);
+				glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+				if (ring_out->mapped)
+					return 1;
+
+				// immutable storage cannot be respecified
+				glDeleteBuffers(1, &ring_out->buffer);
+				glGenBuffers(1, &ring_out->buffer);
+				glBindBuffer(GL_SHADER_STORAGE_BUFFER, ring_out->buffer);
+			}
+			glBufferData(GL_SHADER_STORAGE_BUFFER, ring_out->segmentSize * segmentCount, 0, GL_STREAM_DRAW);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+			printf("\n A3 Warning: Skin palette ring is not persistently mapped; using sub-data uploads.");
+			return 0;
+		}
+	}
+	return -1;
+}
+
+a3ret a3skinPaletteRingBeginFrame(a3_SkinPaletteRing *ring)
+{
+	a3ret waited = 0;
+	a3ui32 segment;
+	if (ring && ring->buffer)
+	{
+		// the GPU may still be reading this segment from a previous frame
+		segment = ring->segmentIndex = (ring->segmentIndex + 1) % ring->segmentCount;
+		if (ring->segmentFence[segment])
+		{
+			while (glClientWaitSync((GLsync)ring->segmentFence[segment], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED)
+				waited = 1;
+			glDeleteSync((GLsync)ring->segmentFence[segment]);
+			ring->segmentFence[segment] = 0;
+		}
+		ring->segmentUsed = 0;
+		return waited;
+	}
+	return -1;
+}
+
+a3ret a3skinPaletteRingUpload(a3_SkinPaletteRing *ring, const void *palette, const a3ui32 size)
+{
+	a3ui32 offset;
+	if (ring && ring->buffer && palette && size)
+	{
+		if (ring->segmentUsed + size <= ring->segmentSize)
+		{
+			offset = ring->segmentIndex * ring->segmentSize + ring->segmentUsed;
+			if (ring->mapped)
+				memcpy(ring->mapped + offset, palette, size);
+			else
+			{
+				glBindBuffer(GL_SHADER_STORAGE_BUFFER, ring->buffer);
+				glBufferSubData(GL_SHADER_STORAGE_BUFFER, offset, size, palette);
+				glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+			}
+			ring->segmentUsed = (ring->segmentUsed + size + ring->alignment - 1) / ring->alignment * ring->alignment;
+			return offset;
+		}
+	}
+	return -1;
+}
+
+a3ret a3skinPaletteRingEndFrame(a3_SkinPaletteRing *ring)
+{
+	a3ui32 const segment = ring ? ring->segmentIndex : 0;
+	if (ring && ring->buffer)
+	{
+		if (ring->segmentFence[segment])
+			glDeleteSync((GLsync)ring->segmentFence[segment]);
+		ring->segmentFence[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3skinPaletteRingRender(const a3_SkinPaletteRing *ring, const a3_VertexDrawable *drawable, const a3ui32 offset, const a3ui32 size, const a3ui32 jointCount, const a3ui32 instanceCount)
+{
+	if (ring && ring->buffer && drawable && drawable->vertexArray && size && jointCount)
+	{
+		glBindBufferRange(GL_SHADER_STORAGE_BUFFER, a3skin_bindingPalette, ring->buffer, offset, size);
+		glUniform1i(a3skin_uniformJointCount, (GLint)jointCount);
+		a3vertexDrawableActivateAndRenderInstanced(drawable, instanceCount);
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3skinPaletteRingRelease(a3_SkinPaletteRing *ring)
+{
+	a3ui32 i;
+	if (ring && ring->buffer)
+	{
+		for (i = 0; i < ring->segmentCount; ++i)
+			if (ring->segmentFence[i])
+				glDeleteSync((GLsync)ring->segmentFence[i]);
+		if (ring->mapped)
+		{
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, ring->buffer);
+			glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		}
+		glDeleteBuffers(1, &ring->buffer);
+		memset(ring, 0, sizeof(a3_SkinPaletteRing));
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
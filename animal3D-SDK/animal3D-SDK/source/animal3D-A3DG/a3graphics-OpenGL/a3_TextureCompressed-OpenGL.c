@@ -0,0 +1,209 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_TextureCompressed-OpenGL.c
+	Definitions for OpenGL compressed texture creation.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_TextureCompressed.h"
+#include "animal3D-A3DG/a3graphics/a3_TextureStream.h"
+
+#include "GL/glew.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+// internal utility declarations
+
+void a3textureInternalHandleReleaseFunc(a3i32 count, a3ui32 *handlePtr);
+a3ret a3textureStreamInternalDecodeDefault(a3_TextureStreamImage *image_out, const a3byte *filePath);
+
+
+//-----------------------------------------------------------------------------
+
+// convert decoded rgb/rgba 8/16 image to a new rgba8 buffer
+inline a3ubyte *a3textureCompressedInternalConvertRGBA8(const a3_TextureStreamImage *image)
+{
+	const a3ui32 count = image->width * image->height;
+	a3ubyte *ret = (a3ubyte *)malloc(count * 4), *dst = ret;
+	const a3ubyte *src8 = (const a3ubyte *)image->pixels;
+	const a3ui16 *src16 = (const a3ui16 *)image->pixels;
+	a3ui32 i, c;
+	if (ret)
+	{
+		for (i = 0; i < count; ++i, dst += 4)
+		{
+			for (c = 0; c < image->channels; ++c)
+				dst[c] = image->bytes == 2 ? (a3ubyte)(*(src16++) >> 8) : *(src8++);
+			for (; c < 4; ++c)
+				dst[c] = 0xFF;
+		}
+	}
+	return ret;
+}
+
+
+// build mip chain and encode a decoded image; also used by the streamer's 
+//	worker, so no graphics calls
+a3ret a3textureCompressedInternalCreateFromImage(a3_TextureCompressedImage *image_out, const a3_TextureStreamImage *image, const a3_TextureBlockFormat format, const a3_TextureMipFilter mipFilter)
+{
+	a3ubyte *pixels;
+	a3ret result = 0;
+	if (image->channels == 4 && image->bytes == 1)
+		pixels = (a3ubyte *)image->pixels;
+	else
+		pixels = a3textureCompressedInternalConvertRGBA8(image);
+	if (pixels)
+	{
+		result = a3textureCompressedCreate(image_out, pixels, image->width, image->height, format, mipFilter, 0);
+		if (pixels != (a3ubyte *)image->pixels)
+			free(pixels);
+	}
+	return result;
+}
+
+
+// upload one level of a compressed image to the bound texture
+a3ret a3textureCompressedInternalUploadLevel(const a3_TextureCompressedImage *image, const a3ui32 level)
+{
+	static const a3ui16 blockFormat[] = {
+		GL_RGBA8,
+		GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,
+		GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+		GL_COMPRESSED_RG_RGTC2,
+		GL_COMPRESSED_RGBA_BPTC_UNORM,
+	};
+	const a3ui32 w = image->width >> level, h = image->height >> level;
+	if (image->format == a3tex_blockNone)
+		glTexImage2D(GL_TEXTURE_2D, level, blockFormat[image->format], w ? w : 1, h ? h : 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, image->data + image->levelOffset[level]);
+	else
+		glCompressedTexImage2D(GL_TEXTURE_2D, level, blockFormat[image->format], w ? w : 1, h ? h : 1, 0, image->levelSize[level], image->data + image->levelOffset[level]);
+	return image->levelSize[level];
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3textureCompressedCreateFromFile(a3_TextureCompressedImage *image_out, const a3byte *filePath, const a3_TextureBlockFormat format, const a3_TextureMipFilter mipFilter)
+{
+	if (image_out && filePath && *filePath)
+	{
+		if (!image_out->data)
+		{
+			a3_TextureStreamImage image[1] = { 0 };
+			a3ret result = 0;
+
+			// same decode and conversion the streamer uses
+			a3textureInitializeImageLibrary();
+			if (a3textureStreamInternalDecodeDefault(image, filePath))
+			{
+				result = a3textureCompressedInternalCreateFromImage(image_out, image, format, mipFilter);
+				free(image->pixels);
+			}
+			else
+				printf("\n A3 ERROR: \n\t Could not decode \'%s\' for compression.", filePath);
+			return result;
+		}
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3textureCreateFromCompressed(a3_Texture *texture_out, const a3byte name_opt[32], const a3_TextureCompressedImage *image)
+{
+	a3_Texture ret = { 0 };
+	a3ui32 handle, i;
+
+	if (texture_out && image)
+	{
+		if (!texture_out->handle->handle && image->data)
+		{
+			glGenTextures(1, &handle);
+			if (handle)
+			{
+				// discard errors from earlier calls so upload failures 
+				//	(e.g. unsupported format) are caught below
+				while (glGetError() != GL_NO_ERROR);
+
+				glBindTexture(GL_TEXTURE_2D, handle);
+				for (i = 0; i < image->levelCount; ++i)
+					a3textureCompressedInternalUploadLevel(image, i);
+
+				// limit level range so a partial chain is still complete
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, image->levelCount - 1);
+				a3textureDefaultSettings();
+				glBindTexture(GL_TEXTURE_2D, 0);
+
+				if (glGetError() == GL_NO_ERROR)
+				{
+					a3handleCreateHandle(ret.handle, a3textureInternalHandleReleaseFunc, name_opt, handle, 1);
+					ret.width = image->width;
+					ret.height = image->height;
+					ret.channels = image->format == a3tex_bc5 ? 2 : 4;
+					ret.bytes = 1;
+					ret.internalFormat = image->format == a3tex_bc5 ? GL_RG : GL_RGBA;
+					ret.internalType = GL_UNSIGNED_BYTE;
+
+					*texture_out = ret;
+					a3textureReference(texture_out);
+					return 1;
+				}
+
+				glDeleteTextures(1, &handle);
+				printf("\n A3 ERROR (TEX \'%s\'): \n\t Compressed format not supported; texture not created.", name_opt);
+			}
+			else
+				printf("\n A3 ERROR (TEX \'%s\'): \n\t Invalid handle; texture not created.", name_opt);
+
+			// fail
+			return 0;
+		}
+	}
+	return -1;
+}
+
+a3ret a3textureChangeFilterModeMipmap(const a3_TextureFilterOption filterOption)
+{
+	static const a3ui16 filter[] = { GL_NEAREST, GL_LINEAR, };
+	static const a3ui16 filterMipmap[] = { GL_NEAREST_MIPMAP_NEAREST, GL_LINEAR_MIPMAP_LINEAR, };
+	a3i32 levelWidth = 0, maxLevel = 0;
+
+	// textures created without a chain have no second level
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 1, GL_TEXTURE_WIDTH, &levelWidth);
+	glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, &maxLevel);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter[filterOption]);
+	if (levelWidth && maxLevel > 0)
+	{
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filterMipmap[filterOption]);
+		return 1;
+	}
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter[filterOption]);
+	return 0;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,77 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_TextureDecoder-OpenGL.c
+	Definitions for texture creation with the built-in image decoder.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_TextureDecoder.h"
+
+
+//-----------------------------------------------------------------------------
+// internal utility declarations
+
+a3ret a3textureStreamInternalDecodeImageLibrary(a3_TextureStreamImage *image_out, const a3byte *filePath);
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3textureDecodeFileImageLibrary(a3_TextureStreamImage *image_out, const a3byte *filePath)
+{
+	if (image_out && filePath && *filePath)
+	{
+		if (!image_out->pixels)
+		{
+			a3textureInitializeImageLibrary();
+			return a3textureStreamInternalDecodeImageLibrary(image_out, filePath);
+		}
+	}
+	return -1;
+}
+
+
+a3ret a3textureCreateFromFileNative(a3_Texture *texture_out, const a3byte name_opt[32], const a3byte *filePath)
+{
+	if (texture_out && filePath && *filePath)
+	{
+		if (!texture_out->handle->handle)
+		{
+			a3_TextureStreamImage image[1] = { 0 };
+			a3_TexturePixelFormatDescriptor pixelFormat[1];
+			a3ret result;
+			if (a3textureDecodeFile(image, filePath) > 0)
+			{
+				// pixel types are ordered by channel count, then 8, 16, 32F bits
+				a3textureCreatePixelFormatDescriptor(pixelFormat, (a3_TexturePixelType)((image->channels - 1) * 3 + (image->bytes - 1)));
+				result = a3textureCreateFromData(texture_out, name_opt, pixelFormat, image->width, image->height, image->pixels, 0);
+				a3textureDecodeRelease(image);
+				return result;
+			}
+
+			// not supported by the built-in decoder
+			return a3textureCreateFromFile(texture_out, name_opt, filePath);
+		}
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
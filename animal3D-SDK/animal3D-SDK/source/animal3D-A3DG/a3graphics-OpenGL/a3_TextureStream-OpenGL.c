@@ -0,0 +1,515 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_TextureStream-OpenGL.c
+	Definitions for OpenGL texture streaming through pixel buffer objects.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_TextureStream.h"
+#include "animal3D-A3DG/a3graphics/a3_TextureDecoder.h"
+
+#include "GL/glew.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef UNICODE
+#define A3_UNICODE_UNDEF
+#undef UNICODE
+#endif	// UNICODE
+#ifdef _UNICODE
+#define _A3_UNICODE_UNDEF
+#undef _UNICODE
+#endif	// _UNICODE
+
+#include "IL/ilut.h"
+
+#ifdef A3_UNICODE_UNDEF
+#define UNICODE
+#undef A3_UNICODE_UNDEF
+#endif	// A3_UNICODE_UNDEF
+#ifdef _A3_UNICODE_UNDEF
+#define _UNICODE
+#undef _A3_UNICODE_UNDEF
+#endif	// _A3_UNICODE_UNDEF
+
+
+//-----------------------------------------------------------------------------
+// internal utility declarations
+
+a3ret a3textureCompressedInternalCreateFromImage(a3_TextureCompressedImage *image_out, const a3_TextureStreamImage *image, const a3_TextureBlockFormat format, const a3_TextureMipFilter mipFilter);
+a3ret a3textureCompressedInternalUploadLevel(const a3_TextureCompressedImage *image, const a3ui32 level);
+
+
+//-----------------------------------------------------------------------------
+
+// image library decoder, converted to the same formats that 
+//	a3textureCreateFromFile produces (rgb/rgba, 8 or 16 bits)
+a3ret a3textureStreamInternalDecodeImageLibrary(a3_TextureStreamImage *image_out, const a3byte *filePath)
+{
+	a3ui32 ilHandle = ilGenImage();
+	a3ui32 width, height, channels, bytes, size;
+	a3ret result = 0;
+	if (ilHandle)
+	{
+		ilBindImage(ilHandle);
+		if (ilLoadImage(filePath))
+		{
+			width = ilGetInteger(IL_IMAGE_WIDTH);
+			height = ilGetInteger(IL_IMAGE_HEIGHT);
+			channels = ilGetInteger(IL_IMAGE_CHANNELS);
+			bytes = channels ? ilGetInteger(IL_IMAGE_BYTES_PER_PIXEL) / channels : 0;
+			if (width && height && channels && bytes)
+			{
+				channels = channels >= 3 ? channels <= 4 ? channels : 4 : 3;
+				bytes = bytes >= 1 ? bytes <= 2 ? bytes : 2 : 1;
+				ilConvertImage(channels == 3 ? IL_RGB : IL_RGBA, bytes == 1 ? IL_UNSIGNED_BYTE : IL_UNSIGNED_SHORT);
+
+				size = width * height * channels * bytes;
+				image_out->pixels = (a3byte *)malloc(size);
+				if (image_out->pixels)
+				{
+					memcpy(image_out->pixels, ilGetData(), size);
+					image_out->width = width;
+					image_out->height = height;
+					image_out->channels = channels;
+					image_out->bytes = bytes;
+					result = 1;
+				}
+			}
+		}
+		ilDeleteImage(ilHandle);
+	}
+	return result;
+}
+
+
+// default decoder: built-in decoder, image library for anything else
+a3ret a3textureStreamInternalDecodeDefault(a3_TextureStreamImage *image_out, const a3byte *filePath)
+{
+	a3ret result = a3textureDecodeFile(image_out, filePath);
+	if (result == 0)
+		result = a3textureStreamInternalDecodeImageLibrary(image_out, filePath);
+	return result;
+}
+
+
+// worker: decode queued requests in order until none remain, building and 
+//	encoding the mip chain of compressed requests; the worker exits when 
+//	idle and is relaunched by the update when more are queued
+a3ret a3textureStreamInternalWorker(void *args)
+{
+	a3_TextureStream *stream = (a3_TextureStream *)args;
+	a3_TextureStreamRequest *request = stream->request, *const end = request + stream->requestCount;
+	const a3_TextureStreamDecodeFunc decodeFunc = stream->decodeFunc ? stream->decodeFunc : a3textureStreamInternalDecodeDefault;
+	a3ret count = 0;
+	for (; request < end && !stream->workerExit; ++request)
+	{
+		if (request->state == a3textureStream_queued)
+		{
+			request->state = a3textureStream_decoding;
+			if (decodeFunc(request->image, request->filePath) > 0)
+			{
+				// pixels are kept in case the format cannot be uploaded
+				if (request->compress && a3textureCompressedInternalCreateFromImage(request->compressed, request->image, request->blockFormat, request->mipFilter) <= 0)
+					request->compress = 0;
+				request->state = a3textureStream_decoded;
+			}
+			else
+				request->state = a3textureStream_failed;
+			++count;
+		}
+	}
+	return count;
+}
+
+
+// get format descriptor matching decoded image
+inline void a3textureStreamInternalGetFormat(a3_TexturePixelFormatDescriptor *pixelFormat_out, const a3_TextureStreamImage *image)
+{
+	// pixel types are ordered by channel count, then 8, 16, 32F bits
+	a3textureCreatePixelFormatDescriptor(pixelFormat_out, (a3_TexturePixelType)((image->channels - 1) * 3 + (image->bytes - 1)));
+}
+
+
+// upload the next chunk of rows; returns rows uploaded, 0 if ring is busy
+inline a3ui32 a3textureStreamInternalUploadRows(a3_TextureStream *stream, a3_TextureStreamRequest *request, const a3_TexturePixelFormatDescriptor *pixelFormat, a3ui32 maxRows)
+{
+	const a3_TextureStreamImage *image = request->image;
+	const a3ui32 rowSize = image->width * image->channels * image->bytes;
+	const a3byte *src = image->pixels + request->rowsUploaded * rowSize;
+	a3ui32 rows = image->height - request->rowsUploaded, segment;
+	if (rows > maxRows)
+		rows = maxRows;
+
+	glBindTexture(GL_TEXTURE_2D, request->stagingHandle);
+	if (stream->pboMapped && rowSize <= stream->segmentSize)
+	{
+		// segment can only be rewritten once the upload reading it is done
+		segment = stream->segmentIndex;
+		if (stream->segmentFence[segment])
+		{
+			if (glClientWaitSync((GLsync)stream->segmentFence[segment], GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED)
+				return 0;
+			glDeleteSync((GLsync)stream->segmentFence[segment]);
+			stream->segmentFence[segment] = 0;
+		}
+		if (rows > stream->segmentSize / rowSize)
+			rows = stream->segmentSize / rowSize;
+
+		// copy into mapped ring and upload from buffer offset
+		memcpy(stream->pboMapped + segment * stream->segmentSize, src, rows * rowSize);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stream->pbo);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, request->rowsUploaded, image->width, rows, pixelFormat->internalFormat, pixelFormat->internalDataType, (void *)((size_t)segment * stream->segmentSize));
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		stream->segmentFence[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		stream->segmentIndex = (segment + 1) % stream->segmentCount;
+	}
+	else
+	{
+		// no ring: upload directly from client memory
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, request->rowsUploaded, image->width, rows, pixelFormat->internalFormat, pixelFormat->internalDataType, src);
+	}
+	request->rowsUploaded += rows;
+	stream->bytesUploaded += rows * rowSize;
+	return rows;
+}
+
+
+// upload the next level of a compressed request directly from client 
+//	memory; returns bytes uploaded, 0 if the format is not supported
+inline a3ui32 a3textureStreamInternalUploadLevel(a3_TextureStream *stream, a3_TextureStreamRequest *request)
+{
+	a3ui32 size;
+
+	// discard errors from earlier calls so upload failures are caught
+	while (glGetError() != GL_NO_ERROR);
+
+	glBindTexture(GL_TEXTURE_2D, request->stagingHandle);
+	size = a3textureCompressedInternalUploadLevel(request->compressed, request->rowsUploaded);
+	if (glGetError() != GL_NO_ERROR)
+		return 0;
+	request->rowsUploaded += 1;
+	stream->bytesUploaded += size;
+	return size;
+}
+
+
+// swap completed staging texture in place of placeholder; the placeholder 
+//	has two levels, so a mipmap filter set on it carries over and the chain 
+//	is completed here unless it was uploaded compressed
+inline void a3textureStreamInternalFinalize(a3_TextureStreamRequest *request, const a3_TexturePixelFormatDescriptor *pixelFormat)
+{
+	a3_Texture *texture = request->texture;
+	GLint minFilter, magFilter, wrapS, wrapT;
+
+	// keep whatever settings were applied to the placeholder
+	glBindTexture(GL_TEXTURE_2D, texture->handle->handle);
+	glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, &minFilter);
+	glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, &magFilter);
+	glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, &wrapS);
+	glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, &wrapT);
+	glBindTexture(GL_TEXTURE_2D, request->stagingHandle);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapS);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapT);
+	if (request->compress)
+	{
+		// limit level range so a partial chain is still complete
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, request->compressed->levelCount - 1);
+	}
+	else if (minFilter != GL_NEAREST && minFilter != GL_LINEAR)
+		glGenerateMipmap(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	// replace handle value; reference count and name are unchanged
+	glDeleteTextures(1, texture->handle->handlePtr);
+	texture->handle->handle = request->stagingHandle;
+	texture->width = request->image->width;
+	texture->height = request->image->height;
+	if (request->compress)
+	{
+		texture->channels = request->blockFormat == a3tex_bc5 ? 2 : 4;
+		texture->bytes = 1;
+		texture->internalFormat = request->blockFormat == a3tex_bc5 ? GL_RG : GL_RGBA;
+		texture->internalType = GL_UNSIGNED_BYTE;
+	}
+	else
+	{
+		texture->channels = request->image->channels;
+		texture->bytes = request->image->bytes;
+		texture->internalFormat = pixelFormat->internalFormat;
+		texture->internalType = pixelFormat->internalDataType;
+	}
+
+	request->stagingHandle = 0;
+	free(request->image->pixels);
+	request->image->pixels = 0;
+	a3textureCompressedRelease(request->compressed);
+	request->state = a3textureStream_resident;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3textureStreamCreate(a3_TextureStream *stream_out, const a3ui32 segmentSize, const a3ui32 segmentCount, const a3_TextureStreamDecodeFunc decodeFunc_opt)
+{
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	if (stream_out && segmentSize && segmentCount && segmentCount <= a3textureStream_segmentMax)
+	{
+		if (!stream_out->segmentCount)
+		{
+			memset(stream_out, 0, sizeof(a3_TextureStream));
+			stream_out->decodeFunc = decodeFunc_opt;
+			stream_out->segmentSize = segmentSize;
+			stream_out->segmentCount = segmentCount;
+
+			// image library must be initialized before the worker uses it
+			if (!decodeFunc_opt)
+				a3textureInitializeImageLibrary();
+
+			// persistent mapping requires immutable buffer storage
+			if (glBufferStorage)
+			{
+				glGenBuffers(1, &stream_out->pbo);
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stream_out->pbo);
+				glBufferStorage(GL_PIXEL_UNPACK_BUFFER, segmentSize * segmentCount, 0, flags);
+				stream_out->pboMapped = (a3byte *)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, segmentSize * segmentCount, flags);
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+				if (stream_out->pboMapped)
+					return 1;
+				glDeleteBuffers(1, &stream_out->pbo);
+				stream_out->pbo = 0;
+			}
+			printf("\n A3 Warning: Texture stream has no persistent upload ring; uploading directly.");
+			return 0;
+		}
+	}
+	return -1;
+}
+
+a3ret a3textureStreamRequest(a3_TextureStream *stream, a3_Texture *texture_out, const a3byte name_opt[32], const a3byte *filePath)
+{
+	return a3textureStreamRequestCompressed(stream, texture_out, name_opt, filePath, a3tex_blockNone, a3tex_mipBox);
+}
+
+a3ret a3textureStreamRequestCompressed(a3_TextureStream *stream, a3_Texture *texture_out, const a3byte name_opt[32], const a3byte *filePath, const a3_TextureBlockFormat format, const a3_TextureMipFilter mipFilter)
+{
+	// neutral grey until resident; the second level lets mipmap filtering 
+	//	be applied to the placeholder
+	static const a3byte placeholder[2 * 2 * 4] = {
+		128, 128, 128, 255,		128, 128, 128, 255,
+		128, 128, 128, 255,		128, 128, 128, 255,
+	};
+	a3_TexturePixelFormatDescriptor pixelFormat[1];
+	a3_TextureStreamRequest *request;
+	if (stream && stream->segmentCount && texture_out && filePath && *filePath && format <= a3tex_bc7)
+	{
+		if (stream->requestCount < a3textureStream_requestMax)
+		{
+			a3textureCreatePixelFormatDescriptor(pixelFormat, a3tex_rgba8);
+			if (a3textureCreateFromData(texture_out, name_opt, pixelFormat, 2, 2, placeholder, 0) > 0)
+			{
+				glBindTexture(GL_TEXTURE_2D, texture_out->handle->handle);
+				glTexImage2D(GL_TEXTURE_2D, 1, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1);
+				glBindTexture(GL_TEXTURE_2D, 0);
+
+				request = stream->request + stream->requestCount;
+				memset(request, 0, sizeof(a3_TextureStreamRequest));
+				request->texture = texture_out;
+				request->blockFormat = format;
+				request->mipFilter = mipFilter;
+				request->compress = format != a3tex_blockNone;
+				strncpy(request->filePath, filePath, sizeof(request->filePath) - 1);
+
+				// publish: worker only looks at queued requests below count
+				request->state = a3textureStream_queued;
+				return (stream->requestCount++);
+			}
+		}
+		else
+			printf("\n A3 ERROR: Texture stream request limit reached; \'%s\' not requested.", filePath);
+	}
+	return -1;
+}
+
+a3ret a3textureStreamUpdate(a3_TextureStream *stream, const a3ui32 byteBudget)
+{
+	a3_TexturePixelFormatDescriptor pixelFormat[1];
+	a3_TextureStreamRequest *request, *end;
+	a3ui32 budget = byteBudget, rowSize, rows, maxRows;
+	a3boolean queued = 0, ringBusy = 0, uploaded = 0;
+	a3ret pending = 0;
+	GLint unpackAlignment;
+	if (stream && stream->segmentCount)
+	{
+		glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		for (request = stream->request, end = request + stream->requestCount; request < end; ++request)
+		{
+			switch (request->state)
+			{
+			case a3textureStream_queued:
+				queued = 1;
+				// continue to pending
+			case a3textureStream_decoding:
+				++pending;
+				break;
+			case a3textureStream_decoded:
+				// allocate final storage; placeholder stays bound meanwhile
+				//	compressed levels are allocated as they are uploaded
+				a3textureStreamInternalGetFormat(pixelFormat, request->image);
+				glGenTextures(1, &request->stagingHandle);
+				glBindTexture(GL_TEXTURE_2D, request->stagingHandle);
+				if (!request->compress)
+					glTexImage2D(GL_TEXTURE_2D, 0, pixelFormat->internalFormatBits, request->image->width, request->image->height, 0, pixelFormat->internalFormat, pixelFormat->internalDataType, 0);
+				request->rowsUploaded = 0;
+				request->state = a3textureStream_uploading;
+				// begin uploading immediately
+			case a3textureStream_uploading:
+				// time-slice: spend budget on requests in order
+				a3textureStreamInternalGetFormat(pixelFormat, request->image);
+				if (request->compress)
+				{
+					while (request->rowsUploaded < request->compressed->levelCount && (budget >= request->compressed->levelSize[request->rowsUploaded] || !uploaded))
+					{
+						rows = a3textureStreamInternalUploadLevel(stream, request);
+						uploaded = 1;
+						if (!rows)
+						{
+							// format not supported: upload uncompressed rows next time
+							printf("\n A3 Warning: Compressed format not supported; streaming \'%s\' uncompressed.", request->filePath);
+							glDeleteTextures(1, &request->stagingHandle);
+							request->stagingHandle = 0;
+							a3textureCompressedRelease(request->compressed);
+							request->compress = 0;
+							request->state = a3textureStream_decoded;
+							break;
+						}
+						budget = budget > rows ? budget - rows : 0;
+					}
+					if (request->compress && request->rowsUploaded == request->compressed->levelCount)
+						a3textureStreamInternalFinalize(request, pixelFormat);
+					else
+						++pending;
+					break;
+				}
+				rowSize = request->image->width * request->image->channels * request->image->bytes;
+				while (!ringBusy && request->rowsUploaded < request->image->height && (budget >= rowSize || !uploaded))
+				{
+					maxRows = budget / rowSize;
+					rows = a3textureStreamInternalUploadRows(stream, request, pixelFormat, maxRows ? maxRows : 1);
+					ringBusy = !rows;
+					uploaded = 1;
+					budget = budget > rows * rowSize ? budget - rows * rowSize : 0;
+				}
+				if (request->rowsUploaded == request->image->height)
+					a3textureStreamInternalFinalize(request, pixelFormat);
+				else
+					++pending;
+				break;
+			default:
+				break;
+			}
+		}
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment);
+
+		// worker exits when it runs out of work; relaunch if needed
+		if (queued && a3threadIsRunning(stream->worker) <= 0)
+		{
+			if (stream->worker->threadID || stream->worker->handle[0])
+				a3threadWait(stream->worker);
+			memset(stream->worker, 0, sizeof(a3_Thread));
+			a3threadLaunch(stream->worker, a3textureStreamInternalWorker, stream, "a3textureStream");
+		}
+		return pending;
+	}
+	return -1;
+}
+
+a3ret a3textureStreamWait(a3_TextureStream *stream)
+{
+	if (stream && stream->segmentCount)
+	{
+		if (stream->worker->threadID || stream->worker->handle[0])
+		{
+			a3threadWait(stream->worker);
+			memset(stream->worker, 0, sizeof(a3_Thread));
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3textureStreamIsResident(const a3_TextureStream *stream, const a3_Texture *texture)
+{
+	const a3_TextureStreamRequest *request, *end;
+	if (stream && texture)
+	{
+		for (request = stream->request, end = request + stream->requestCount; request < end; ++request)
+			if (request->texture == texture)
+				return (request->state == a3textureStream_resident);
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3textureStreamRelease(a3_TextureStream *stream)
+{
+	a3_TextureStreamRequest *request, *end;
+	a3ui32 i;
+	a3ret dropped = 0;
+	if (stream && stream->segmentCount)
+	{
+		// stop worker after its current decode
+		stream->workerExit = 1;
+		if (stream->worker->threadID || stream->worker->handle[0])
+			a3threadWait(stream->worker);
+
+		for (request = stream->request, end = request + stream->requestCount; request < end; ++request)
+		{
+			if (request->state != a3textureStream_resident && request->state != a3textureStream_failed)
+				++dropped;
+			if (request->stagingHandle)
+				glDeleteTextures(1, &request->stagingHandle);
+			free(request->image->pixels);
+			a3textureCompressedRelease(request->compressed);
+		}
+		for (i = 0; i < stream->segmentCount; ++i)
+			if (stream->segmentFence[i])
+				glDeleteSync((GLsync)stream->segmentFence[i]);
+		if (stream->pbo)
+			glDeleteBuffers(1, &stream->pbo);
+
+		memset(stream, 0, sizeof(a3_TextureStream));
+		return dropped;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,265 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_CurvePath.c
+	Definitions for arc-length curve path tables and lookups.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_CurvePath.h"
+
+#include <stdlib.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// internal utilities
+
+// 3-point Gauss-Legendre nodes on [-1, +1] and their weights
+#define a3curvePathInternalGaussNode	0.774596669241483377f
+#define a3curvePathInternalGaussWeight0	0.888888888888888889f
+#define a3curvePathInternalGaussWeight1	0.555555555555555556f
+
+// speed of cubic Bezier: length of derivative
+inline a3f32 a3curvePathInternalSpeed(const a3f32 control[4][4], const a3f32 t)
+{
+	const a3f32 u = 1.0f - t;
+	const a3f32 b0 = 3.0f * u * u, b1 = 6.0f * u * t, b2 = 3.0f * t * t;
+	a3f32 d[3];
+	a3ui32 i;
+	for (i = 0; i < 3; ++i)
+		d[i] = b0 * (control[1][i] - control[0][i]) + b1 * (control[2][i] - control[1][i]) + b2 * (control[3][i] - control[2][i]);
+	return sqrtf(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+}
+
+// length of segment from local parameter t0 to t1; accurate for the 
+//	short spans inside one sample interval
+inline a3f32 a3curvePathInternalLength(const a3f32 control[4][4], const a3f32 t0, const a3f32 t1)
+{
+	const a3f32 h = 0.5f * (t1 - t0), t = t0 + h;
+	return h * (a3curvePathInternalGaussWeight0 * a3curvePathInternalSpeed(control, t)
+		+ a3curvePathInternalGaussWeight1 * a3curvePathInternalSpeed(control, t - h * a3curvePathInternalGaussNode)
+		+ a3curvePathInternalGaussWeight1 * a3curvePathInternalSpeed(control, t + h * a3curvePathInternalGaussNode));
+}
+
+// wrap distance into [0, length)
+inline a3f32 a3curvePathInternalWrap(const a3_CurvePath *path, const a3f32 distance)
+{
+	const a3f32 d = distance - floorf(distance / path->length) * path->length;
+	return d < path->length ? d : 0.0f;
+}
+
+// clamp global parameter to the last segment so rounding at the very end 
+//	of the table does not index past it
+inline a3f32 a3curvePathInternalClamp(const a3_CurvePath *path, const a3f32 param)
+{
+	const a3f32 paramMax = (a3f32)path->segmentCount - 1.0e-6f * (a3f32)path->segmentCount;
+	return param < paramMax ? param : paramMax;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3curvePathCreate(a3_CurvePath *path_out, const a3ui32 segmentCapacity)
+{
+	a3ui32 sampleCapacity;
+	if (path_out && !path_out->control && segmentCapacity)
+	{
+		// one block: controls first (largest alignment), then the tables
+		sampleCapacity = segmentCapacity * a3curvePath_samplesPerSegment + 1;
+		path_out->control = (a3f32(*)[4][4])malloc(segmentCapacity * sizeof(a3f32[4][4]) + sampleCapacity * 3 * sizeof(a3f32));
+		if (path_out->control)
+		{
+			path_out->arcLength = (a3f32 *)(path_out->control + segmentCapacity);
+			path_out->param = path_out->arcLength + sampleCapacity;
+			path_out->paramSlope = path_out->param + sampleCapacity;
+			path_out->length = path_out->sampleStep = path_out->sampleStepInv = 0.0f;
+			path_out->segmentCount = path_out->sampleCount = 0;
+			path_out->segmentCapacity = segmentCapacity;
+			path_out->type = a3curve_linear;
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3curvePathUpdate(a3_CurvePath *path, const a3f32 waypoint[][4], const a3f32 handle[][4], const a3ui32 count, const a3_CurveSegmentType type)
+{
+	const a3f32 dt = 1.0f / (a3f32)a3curvePath_samplesPerSegment;
+	a3f32 t, t0, s, length, f, speed;
+	a3ui32 i, j, k, n;
+	if (path && path->control && waypoint && handle)
+	{
+		path->segmentCount = count < path->segmentCapacity ? count : path->segmentCapacity;
+		path->sampleCount = path->segmentCount * a3curvePath_samplesPerSegment;
+		path->type = type;
+
+		// integrate speed over each sample interval
+		path->arcLength[0] = length = 0.0f;
+		for (i = k = 0; i < path->segmentCount; ++i)
+		{
+			a3curveSegmentControl(path->control[i], waypoint, handle, count, i, type);
+			for (j = 0, t = 0.0f; j < a3curvePath_samplesPerSegment; ++j, t += dt)
+				path->arcLength[++k] = (length += a3curvePathInternalLength(path->control[i], t, t + dt));
+		}
+		path->length = length;
+		path->sampleStep = length / (a3f32)(path->sampleCount ? path->sampleCount : 1);
+		path->sampleStepInv = length > 0.0f ? 1.0f / path->sampleStep : 0.0f;
+
+		// invert: walk both tables together since both are monotonic, then 
+		//	polish the linear guess with Newton steps on the exact length so 
+		//	that every entry lies on the curve's true arc length
+		for (i = j = 0; i <= path->sampleCount; ++i)
+		{
+			s = (a3f32)i * path->sampleStep;
+			while (j + 1 < path->sampleCount && path->arcLength[j + 1] < s)
+				++j;
+			length = path->arcLength[j + 1] - path->arcLength[j];
+			f = length > 0.0f ? (s - path->arcLength[j]) / length : 0.0f;
+			f = f < 1.0f ? f : 1.0f;
+			k = j / a3curvePath_samplesPerSegment;
+			t0 = (a3f32)(j % a3curvePath_samplesPerSegment) * dt;
+			for (n = 0, t = t0 + f * dt; n < 2; ++n)
+			{
+				speed = a3curvePathInternalSpeed(path->control[k], t);
+				if (speed > 0.0f)
+					t -= (path->arcLength[j] + a3curvePathInternalLength(path->control[k], t0, t) - s) / speed;
+				t = t < t0 ? t0 : t > t0 + dt ? t0 + dt : t;
+			}
+			path->param[i] = (a3f32)k + t;
+			path->paramSlope[i] = speed > 0.0f ? path->sampleStep / speed : 0.0f;
+		}
+		return path->segmentCount;
+	}
+	return -1;
+}
+
+a3ret a3curvePathRelease(a3_CurvePath *path)
+{
+	if (path && path->control)
+	{
+		free(path->control);
+		path->control = 0;
+		path->arcLength = path->param = path->paramSlope = 0;
+		path->segmentCount = path->sampleCount = path->segmentCapacity = 0;
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3f32 a3curvePathParam(const a3_CurvePath *path, const a3f32 distance)
+{
+	a3f32 u, u2, u3, p0, p1, p;
+	a3ui32 i;
+	if (path && path->length > 0.0f)
+	{
+		u = a3curvePathInternalWrap(path, distance) * path->sampleStepInv;
+		i = (a3ui32)u;
+		i = i < path->sampleCount ? i : path->sampleCount - 1;
+		u -= (a3f32)i;
+		u2 = u * u;
+		u3 = u2 * u;
+
+		// cubic Hermite through both entries with their exact slopes; the 
+		//	parameter bends sharply where the curve slows down, which a 
+		//	straight line between entries would cut across
+		p0 = path->param[i];
+		p1 = path->param[i + 1];
+		p = p0 * (2.0f * u3 - 3.0f * u2 + 1.0f) + p1 * (3.0f * u2 - 2.0f * u3)
+			+ path->paramSlope[i] * (u3 - 2.0f * u2 + u) + path->paramSlope[i + 1] * (u3 - u2);
+		p = p < p0 ? p0 : p > p1 ? p1 : p;
+		return a3curvePathInternalClamp(path, p);
+	}
+	return 0.0f;
+}
+
+a3f32 a3curvePathParamBinary(const a3_CurvePath *path, const a3f32 distance)
+{
+	a3f32 d, length;
+	a3ui32 lo, hi, mid;
+	if (path && path->length > 0.0f)
+	{
+		// find last sample at or before distance
+		d = a3curvePathInternalWrap(path, distance);
+		for (lo = 0, hi = path->sampleCount; hi - lo > 1; )
+		{
+			mid = (lo + hi) >> 1;
+			if (path->arcLength[mid] <= d)
+				lo = mid;
+			else
+				hi = mid;
+		}
+		length = path->arcLength[hi] - path->arcLength[lo];
+		d = length > 0.0f ? (d - path->arcLength[lo]) / length : 0.0f;
+		return a3curvePathInternalClamp(path, ((a3f32)lo + d) / (a3f32)a3curvePath_samplesPerSegment);
+	}
+	return 0.0f;
+}
+
+a3ret a3curvePathEvaluate(a3f32 position_out[][4], a3f32 tangent_out_opt[][4], const a3_CurvePath *path, const a3f32 distance[], const a3ui32 count)
+{
+	const a3f32(*control)[4];
+	a3f32 p, t, u, b0, b1, b2, b3, d[3], s;
+	a3ui32 i, j, segment;
+	if (position_out && path && path->length > 0.0f && distance)
+	{
+		for (i = 0; i < count; ++i)
+		{
+			p = a3curvePathParam(path, distance[i]);
+			segment = (a3ui32)p;
+			control = path->control[segment];
+			t = p - (a3f32)segment;
+			u = 1.0f - t;
+
+			// Bernstein form
+			b0 = u * u * u;
+			b1 = 3.0f * u * u * t;
+			b2 = 3.0f * u * t * t;
+			b3 = t * t * t;
+			for (j = 0; j < 3; ++j)
+				position_out[i][j] = b0 * control[0][j] + b1 * control[1][j] + b2 * control[2][j] + b3 * control[3][j];
+			position_out[i][3] = 1.0f;
+
+			if (tangent_out_opt)
+			{
+				b0 = u * u;
+				b1 = 2.0f * u * t;
+				b2 = t * t;
+				for (j = 0; j < 3; ++j)
+					d[j] = b0 * (control[1][j] - control[0][j]) + b1 * (control[2][j] - control[1][j]) + b2 * (control[3][j] - control[2][j]);
+				s = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+				s = s > 0.0f ? 1.0f / sqrtf(s) : 0.0f;
+				tangent_out_opt[i][0] = d[0] * s;
+				tangent_out_opt[i][1] = d[1] * s;
+				tangent_out_opt[i][2] = d[2] * s;
+				tangent_out_opt[i][3] = 0.0f;
+			}
+		}
+		return count;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,187 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_CurveTessellation.c
+	Definitions for curve tessellation functions shared by all back ends: 
+		segment conversion, adaptive level and the CPU tessellator.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_CurveTessellation.h"
+
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// internal utilities
+
+// v_out = v0 + (v1 - v2) * s
+inline void a3curveInternalOffset(a3f32 *v_out, const a3f32 *v0, const a3f32 *v1, const a3f32 *v2, const a3f32 s)
+{
+	v_out[0] = v0[0] + (v1[0] - v2[0]) * s;
+	v_out[1] = v0[1] + (v1[1] - v2[1]) * s;
+	v_out[2] = v0[2] + (v1[2] - v2[2]) * s;
+	v_out[3] = 1.0f;
+}
+
+// copy position
+inline void a3curveInternalCopy(a3f32 *v_out, const a3f32 *v)
+{
+	v_out[0] = v[0];
+	v_out[1] = v[1];
+	v_out[2] = v[2];
+	v_out[3] = 1.0f;
+}
+
+// evaluate cubic Bezier in Bernstein form
+inline void a3curveInternalEval(a3f32 *v_out, const a3f32 control[4][4], const a3f32 t)
+{
+	const a3f32 u = 1.0f - t;
+	const a3f32 b0 = u * u * u, b1 = 3.0f * u * u * t, b2 = 3.0f * u * t * t, b3 = t * t * t;
+	v_out[0] = b0 * control[0][0] + b1 * control[1][0] + b2 * control[2][0] + b3 * control[3][0];
+	v_out[1] = b0 * control[0][1] + b1 * control[1][1] + b2 * control[2][1] + b3 * control[3][1];
+	v_out[2] = b0 * control[0][2] + b1 * control[1][2] + b2 * control[2][2] + b3 * control[3][2];
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3curveSegmentControl(a3f32 control_out[4][4], const a3f32 waypoint[][4], const a3f32 handle[][4], const a3ui32 count, const a3ui32 index, const a3_CurveSegmentType type)
+{
+	a3ui32 k0, k1, k2, k3;
+	if (control_out && waypoint && handle && count)
+	{
+		// same key order as the curves demo: current, next, after next, previous
+		k0 = index % count;
+		k1 = (k0 + 1) % count;
+		k2 = (k0 + 2) % count;
+		k3 = (k0 + count - 1) % count;
+
+		switch (type)
+		{
+		case a3curve_bezier:
+			a3curveInternalCopy(control_out[0], waypoint[k0]);
+			a3curveInternalCopy(control_out[1], waypoint[k1]);
+			a3curveInternalCopy(control_out[2], waypoint[k2]);
+			a3curveInternalCopy(control_out[3], waypoint[k3]);
+			break;
+		case a3curve_catmullRom:
+			// tangents are half the distance between neighbours, and a 
+			//	Bezier control point is a third of a tangent away
+			a3curveInternalCopy(control_out[0], waypoint[k0]);
+			a3curveInternalOffset(control_out[1], waypoint[k0], waypoint[k1], waypoint[k3], 1.0f / 6.0f);
+			a3curveInternalOffset(control_out[2], waypoint[k1], waypoint[k0], waypoint[k2], 1.0f / 6.0f);
+			a3curveInternalCopy(control_out[3], waypoint[k1]);
+			break;
+		case a3curve_cubicHermite:
+			// tangent is handle minus waypoint
+			a3curveInternalCopy(control_out[0], waypoint[k0]);
+			a3curveInternalOffset(control_out[1], waypoint[k0], handle[k0], waypoint[k0], 1.0f / 3.0f);
+			a3curveInternalOffset(control_out[2], waypoint[k1], waypoint[k1], handle[k1], 1.0f / 3.0f);
+			a3curveInternalCopy(control_out[3], waypoint[k1]);
+			break;
+		default:
+			a3curveInternalCopy(control_out[0], waypoint[k0]);
+			a3curveInternalOffset(control_out[1], waypoint[k0], waypoint[k1], waypoint[k0], 1.0f / 3.0f);
+			a3curveInternalOffset(control_out[2], waypoint[k1], waypoint[k0], waypoint[k1], 1.0f / 3.0f);
+			a3curveInternalCopy(control_out[3], waypoint[k1]);
+			break;
+		}
+		return 1;
+	}
+	return -1;
+}
+
+a3ui32 a3curveSegmentLevel(const a3f32 control[4][4], const a3f32 *viewProjection, const a3f32 viewportWidth, const a3f32 viewportHeight)
+{
+	const a3f32 *const m = viewProjection;
+	a3f32 clip[4], screen[4][2], length = 0.0f, dx, dy, level;
+	a3ui32 i, outside = 0x3f, crossing = 0;
+
+	for (i = 0; i < 4; ++i)
+	{
+		clip[0] = m[0] * control[i][0] + m[4] * control[i][1] + m[8] * control[i][2] + m[12];
+		clip[1] = m[1] * control[i][0] + m[5] * control[i][1] + m[9] * control[i][2] + m[13];
+		clip[2] = m[2] * control[i][0] + m[6] * control[i][1] + m[10] * control[i][2] + m[14];
+		clip[3] = m[3] * control[i][0] + m[7] * control[i][1] + m[11] * control[i][2] + m[15];
+
+		// a plane culls the segment only if the whole hull is behind it
+		outside &= (clip[0] < -clip[3]) << 0 | (clip[0] > clip[3]) << 1
+			| (clip[1] < -clip[3]) << 2 | (clip[1] > clip[3]) << 3
+			| (clip[2] < -clip[3]) << 4 | (clip[2] > clip[3]) << 5;
+
+		if (clip[3] > 1.0e-4f)
+		{
+			screen[i][0] = clip[0] / clip[3] * 0.5f * viewportWidth;
+			screen[i][1] = clip[1] / clip[3] * 0.5f * viewportHeight;
+		}
+		else
+			crossing = 1;
+	}
+	if (outside)
+		return 0;
+	if (crossing)
+		return a3curveTess_levelMax;
+
+	// the hull is never shorter than the curve it contains
+	for (i = 1; i < 4; ++i)
+	{
+		dx = screen[i][0] - screen[i - 1][0];
+		dy = screen[i][1] - screen[i - 1][1];
+		length += sqrtf(dx * dx + dy * dy);
+	}
+	level = length / (a3f32)a3curveTess_pixelsPerLevel + 0.999f;
+	return level < 1.0f ? 1 : level > (a3f32)a3curveTess_levelMax ? a3curveTess_levelMax : (a3ui32)level;
+}
+
+a3ret a3curveTessellate(a3f32 vertex_out[][3], const a3ui32 capacity, const a3f32 waypoint[][4], const a3f32 handle[][4], const a3ui32 count, const a3_CurveSegmentType type, const a3f32 *viewProjection, const a3f32 viewportWidth, const a3f32 viewportHeight)
+{
+	a3f32 control[4][4], t, dt;
+	a3ui32 i, j, level, vertexCount = 0;
+	if (vertex_out && waypoint && handle && viewProjection)
+	{
+		for (i = 0; i < count; ++i)
+		{
+			a3curveSegmentControl(control, waypoint, handle, count, i, type);
+			level = a3curveSegmentLevel(control, viewProjection, viewportWidth, viewportHeight);
+			if (level && vertexCount + level * 2 <= capacity)
+			{
+				// line list: each sample after the first closes one line and 
+				//	opens the next
+				dt = 1.0f / (a3f32)level;
+				a3curveInternalEval(vertex_out[vertexCount++], control, 0.0f);
+				for (j = 1, t = dt; j < level; ++j, t += dt)
+				{
+					a3curveInternalEval(vertex_out[vertexCount], control, t);
+					vertex_out[vertexCount + 1][0] = vertex_out[vertexCount][0];
+					vertex_out[vertexCount + 1][1] = vertex_out[vertexCount][1];
+					vertex_out[vertexCount + 1][2] = vertex_out[vertexCount][2];
+					vertexCount += 2;
+				}
+				a3curveInternalEval(vertex_out[vertexCount++], control, 1.0f);
+			}
+		}
+		return vertexCount;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
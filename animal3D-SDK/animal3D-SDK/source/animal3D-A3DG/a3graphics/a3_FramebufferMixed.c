@@ -0,0 +1,93 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_FramebufferMixed.c
+	Definitions for common mixed-format framebuffer functions.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_FramebufferMixed.h"
+
+#include <stdio.h>
+
+
+//-----------------------------------------------------------------------------
+// internal utility declarations
+
+void a3framebufferInternalHandleReleaseFunc(a3i32 count, a3ui32 *handlePtr);
+a3ui32 a3framebufferInternalValidateColorTargets(const a3ui32 colorTargets);
+a3ui32 a3framebufferMixedInternalCreate(a3ui32 *colorHandles, a3ui32 *depthHandle, const a3ui32 colorTargets, const a3_FramebufferTargetType *targetType, const a3_TexturePixelFormatDescriptor *depthPixelFormat, const a3ui16 width, const a3ui16 height);
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3framebufferCreateMixed(a3_Framebuffer *framebuffer_out, const a3byte name_opt[32], a3ui32 colorTargets, const a3_FramebufferTargetType *targetType, const a3_FramebufferDepthType depthType, const a3ui16 frameWidth, const a3ui16 frameHeight)
+{
+	a3_Framebuffer ret = { 0 };
+	a3_TexturePixelFormatDescriptor depthPixelFormat[1] = { 0 }, *depthPixelFormatPtr = 0;
+	a3ui32 handle, numHandles, i;
+
+	// validate params
+	if (framebuffer_out && (targetType || !colorTargets) && frameWidth && frameHeight)
+	{
+		// validate unused
+		if (!framebuffer_out->handle->handle)
+		{
+			// validate formats
+			colorTargets = a3framebufferInternalValidateColorTargets(colorTargets);
+			for (i = 0; i < colorTargets; ++i)
+				if ((a3ui32)targetType[i] >= a3fbo_target_max)
+					return -1;
+			if (depthType)
+			{
+				a3textureCreatePixelFormatDescriptor(depthPixelFormat, (a3_TexturePixelType)depthType);
+				depthPixelFormatPtr = depthPixelFormat;
+			}
+
+			// prepare FBO
+			handle = a3framebufferMixedInternalCreate(ret.colorTextureHandle, ret.depthTextureHandle,
+				colorTargets, targetType, depthPixelFormatPtr, frameWidth, frameHeight);
+			if (handle)
+			{
+				// same layout as uniform framebuffers, so same release
+				numHandles = (2 + a3fbo_colorTargetMax);
+				a3handleCreateHandle(ret.handle, a3framebufferInternalHandleReleaseFunc, name_opt, handle, numHandles);
+				ret.color = colorTargets;
+				ret.depthStencil = depthType;
+				ret.frameWidth = frameWidth;
+				ret.frameHeight = frameHeight;
+
+				// done
+				*framebuffer_out = ret;
+				a3framebufferReference(framebuffer_out);
+				return 1;
+			}
+			else
+				printf("\n A3 ERROR (FBO \'%s\'): \n\t Invalid handle; mixed framebuffer not created.", name_opt);
+
+			// fail
+			return 0;
+		}
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
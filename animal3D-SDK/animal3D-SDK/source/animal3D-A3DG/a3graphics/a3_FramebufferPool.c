@@ -0,0 +1,288 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_FramebufferPool.c
+	Definitions for framebuffer pool functions.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_FramebufferPool.h"
+
+
+//-----------------------------------------------------------------------------
+// internal utilities
+
+// storage in bytes of one pixel of a color target; 3-channel formats are 
+//	padded to 4 by the driver
+inline a3ui32 a3framebufferPoolInternalColorSize(const a3_FramebufferColorType colorType)
+{
+	switch (colorType)
+	{
+	case a3fbo_colorRGB8:
+	case a3fbo_colorRGBA8:
+		return 4;
+	case a3fbo_colorRGB16:
+	case a3fbo_colorRGBA16:
+		return 8;
+	case a3fbo_colorRGB32F:
+	case a3fbo_colorRGBA32F:
+		return 16;
+	case a3fbo_colorDisable:
+		return 0;
+	}
+	return 0;
+}
+
+// storage in bytes of one pixel of a depth target
+inline a3ui32 a3framebufferPoolInternalDepthSize(const a3_FramebufferDepthType depthType)
+{
+	switch (depthType)
+	{
+	case a3fbo_depth16:
+		return 2;
+	case a3fbo_depth24:
+	case a3fbo_depth32:
+	case a3fbo_depth24_stencil8:
+		return 4;
+	case a3fbo_depthDisable:
+		return 0;
+	}
+	return 0;
+}
+
+// release the framebuffer in a slot and reset the slot
+inline void a3framebufferPoolInternalReleaseEntry(a3_FramebufferPool *pool, a3_FramebufferPoolEntry *entry)
+{
+	const a3_FramebufferPoolEntry empty = { 0 };
+	a3framebufferRelease(entry->framebuffer);
+	pool->sizeAllocated -= entry->size;
+	--pool->count;
+	*entry = empty;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3framebufferPoolBeginFrame(a3_FramebufferPool *pool)
+{
+	if (pool)
+	{
+		a3framebufferPoolReturnAll(pool);
+		pool->sizeRequested = pool->sizePeak = 0;
+		return ++pool->frame;
+	}
+	return -1;
+}
+
+const a3_Framebuffer *a3framebufferPoolAcquire(a3_FramebufferPool *pool, const a3byte name_opt[32], const a3ui32 colorTargets, const a3_FramebufferColorType colorType, const a3_FramebufferDepthType depthType, const a3ui16 frameWidth, const a3ui16 frameHeight)
+{
+	a3_FramebufferPoolEntry *entry, *freeEntry = 0;
+	a3ui32 i, j;
+	if (pool && frameWidth && frameHeight)
+	{
+		// reuse returned framebuffer with the same format and size
+		for (i = 0, entry = pool->entry; i < a3fbo_poolMax; ++i, ++entry)
+		{
+			if (entry->framebuffer->handle->handle)
+			{
+				if (!entry->inUse &&
+					entry->colorTargets == colorTargets && entry->colorType == colorType &&
+					entry->depthType == depthType &&
+					entry->framebuffer->frameWidth == frameWidth && entry->framebuffer->frameHeight == frameHeight)
+					break;
+			}
+			else if (!freeEntry)
+				freeEntry = entry;
+		}
+
+		// none found: create one in a free slot
+		if (i == a3fbo_poolMax)
+		{
+			entry = freeEntry;
+			if (!entry || a3framebufferCreate(entry->framebuffer, name_opt,
+				colorTargets, colorType, depthType, frameWidth, frameHeight) <= 0)
+				return 0;
+
+			// targets are sampled by later passes, never wrapped or mipped
+			for (j = 0; j < entry->framebuffer->color; ++j)
+			{
+				a3framebufferBindColorTexture(entry->framebuffer, a3tex_unit00, j);
+				a3textureChangeRepeatMode(a3tex_repeatClamp, a3tex_repeatClamp);
+				a3textureChangeFilterMode(a3tex_filterLinear);
+			}
+			if (entry->framebuffer->depthStencil)
+			{
+				a3framebufferBindDepthTexture(entry->framebuffer, a3tex_unit00);
+				a3textureChangeRepeatMode(a3tex_repeatClamp, a3tex_repeatClamp);
+				a3textureChangeFilterMode(a3tex_filterLinear);
+			}
+			a3textureDeactivate(a3tex_unit00);
+
+			entry->colorTargets = colorTargets;
+			entry->colorType = colorType;
+			entry->depthType = depthType;
+			entry->size = (entry->framebuffer->color * a3framebufferPoolInternalColorSize(colorType) +
+				a3framebufferPoolInternalDepthSize(depthType)) * frameWidth * frameHeight;
+			pool->sizeAllocated += entry->size;
+			++pool->count;
+		}
+
+		// hand out
+		entry->inUse = 1;
+		entry->frameUsed = pool->frame;
+		pool->sizeRequested += entry->size;
+		pool->sizeInUse += entry->size;
+		if (pool->sizePeak < pool->sizeInUse)
+			pool->sizePeak = pool->sizeInUse;
+		return entry->framebuffer;
+	}
+	return 0;
+}
+
+a3ret a3framebufferPoolReturn(a3_FramebufferPool *pool, const a3_Framebuffer *framebuffer)
+{
+	a3_FramebufferPoolEntry *entry;
+	a3ui32 i, ret;
+	if (pool && framebuffer)
+	{
+		for (i = ret = 0, entry = pool->entry; i < a3fbo_poolMax; ++i, ++entry)
+			if (entry->inUse)
+			{
+				if (entry->framebuffer == framebuffer)
+				{
+					entry->inUse = 0;
+					pool->sizeInUse -= entry->size;
+					framebuffer = 0;
+				}
+				else
+					++ret;
+			}
+		if (!framebuffer)
+			return ret;
+	}
+	return -1;
+}
+
+a3ret a3framebufferPoolReturnAll(a3_FramebufferPool *pool)
+{
+	a3_FramebufferPoolEntry *entry;
+	a3ui32 i, ret;
+	if (pool)
+	{
+		for (i = ret = 0, entry = pool->entry; i < a3fbo_poolMax; ++i, ++entry)
+			if (entry->inUse)
+			{
+				entry->inUse = 0;
+				++ret;
+			}
+		pool->sizeInUse = 0;
+		return ret;
+	}
+	return -1;
+}
+
+a3ret a3framebufferPoolAcquireSequence(a3_FramebufferPool *pool, const a3_Framebuffer *framebuffer_out[], const a3_FramebufferPoolRequest *request, const a3ui32 requestCount, const a3byte name_opt[32])
+{
+	a3ui32 i, j, ret;
+	if (pool && framebuffer_out && request)
+	{
+		for (i = 0; i < requestCount; ++i)
+			framebuffer_out[i] = 0;
+		for (i = ret = 0; i < requestCount; ++i)
+		{
+			// acquire this pass's target
+			if (request[i].frameWidth && request[i].frameHeight)
+			{
+				framebuffer_out[i] = a3framebufferPoolAcquire(pool, name_opt,
+					request[i].colorTargets, request[i].colorType, request[i].depthType,
+					request[i].frameWidth, request[i].frameHeight);
+				if (!framebuffer_out[i])
+					return -1;
+				++ret;
+			}
+
+			// return targets whose last reader was this pass; a target that 
+			//	is never read is returned as soon as it is written
+			for (j = 0; j <= i; ++j)
+				if (framebuffer_out[j] && request[j].lastUse >= 0 &&
+					(request[j].lastUse == (a3i32)i || (j == i && request[j].lastUse < (a3i32)i)))
+					a3framebufferPoolReturn(pool, framebuffer_out[j]);
+		}
+		return ret;
+	}
+	return -1;
+}
+
+a3ret a3framebufferPoolTrim(a3_FramebufferPool *pool, const a3ui32 idleFrames)
+{
+	a3_FramebufferPoolEntry *entry;
+	a3ui32 i, ret;
+	if (pool)
+	{
+		for (i = ret = 0, entry = pool->entry; i < a3fbo_poolMax; ++i, ++entry)
+			if (entry->framebuffer->handle->handle && !entry->inUse &&
+				pool->frame - entry->frameUsed > idleFrames)
+			{
+				a3framebufferPoolInternalReleaseEntry(pool, entry);
+				++ret;
+			}
+		return ret;
+	}
+	return -1;
+}
+
+a3ret a3framebufferPoolReleaseAll(a3_FramebufferPool *pool)
+{
+	a3_FramebufferPoolEntry *entry;
+	a3ui32 i, ret;
+	if (pool)
+	{
+		for (i = ret = 0, entry = pool->entry; i < a3fbo_poolMax; ++i, ++entry)
+			if (entry->framebuffer->handle->handle)
+			{
+				a3framebufferPoolInternalReleaseEntry(pool, entry);
+				++ret;
+			}
+		pool->sizeRequested = pool->sizeInUse = pool->sizePeak = 0;
+		return ret;
+	}
+	return -1;
+}
+
+a3ret a3framebufferPoolHandleUpdateReleaseCallbacks(a3_FramebufferPool *pool)
+{
+	a3_FramebufferPoolEntry *entry;
+	a3ui32 i, ret;
+	if (pool)
+	{
+		for (i = ret = 0, entry = pool->entry; i < a3fbo_poolMax; ++i, ++entry)
+			if (entry->framebuffer->handle->handle)
+			{
+				a3framebufferHandleUpdateReleaseCallback(entry->framebuffer);
+				++ret;
+			}
+		return ret;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,183 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_GraphicsObjectPool.c
+	Definitions for generational graphics object pool.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_GraphicsObjectPool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+// release every live name in a table with one call; the name array is
+//	dense by slot and free slots hold zero, which release calls ignore
+inline a3ui32 a3graphicsPoolInternalRemoveAll(a3_GraphicsObjectTable *table)
+{
+	const a3ui32 count = table->count;
+	a3ui32 i;
+	if (count)
+	{
+		if (table->releaseFunc)
+			table->releaseFunc(table->capacity, table->name);
+
+		// every slot is invalidated and returned to the free list in order
+		for (i = 0; i < table->capacity; ++i)
+		{
+			if (table->name[i])
+			{
+				table->name[i] = 0;
+				table->generation[i] = (table->generation[i] % a3pool_generationMask) + 1;
+			}
+			table->nextFree[i] = (a3ui16)(i + 1);
+		}
+		table->freeHead = 0;
+		table->count = 0;
+	}
+	return count;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3graphicsPoolCreate(a3_GraphicsObjectPool *pool_out, const a3ui32 capacity)
+{
+	a3_GraphicsObjectTable *table;
+	a3ui32 i;
+	if (pool_out && capacity && capacity <= a3pool_slotMax)
+	{
+		if (!pool_out->table->capacity)
+		{
+			for (table = pool_out->table; table < pool_out->table + a3pool_typeMax; ++table)
+			{
+				// one block per table: names, then generations and links
+				table->name = (a3ui32 *)malloc(capacity * (sizeof(a3ui32) + sizeof(a3ui16) + sizeof(a3ui16)));
+				table->generation = (a3ui16 *)(table->name + capacity);
+				table->nextFree = table->generation + capacity;
+				memset(table->name, 0, capacity * sizeof(a3ui32));
+
+				// generations start at 1 so a zero handle is never valid
+				for (i = 0; i < capacity; ++i)
+				{
+					table->generation[i] = 1;
+					table->nextFree[i] = (a3ui16)(i + 1);
+				}
+				table->capacity = capacity;
+				table->count = 0;
+				table->freeHead = 0;
+				table->releaseFunc = 0;
+			}
+			return (capacity * a3pool_typeMax);
+		}
+	}
+	return -1;
+}
+
+a3ret a3graphicsPoolSetReleaseFunc(a3_GraphicsObjectPool *pool, const a3_GraphicsObjectType type, const a3_GraphicsObjectReleaseFunc releaseFunc_opt)
+{
+	if (pool && type < a3pool_typeMax)
+	{
+		pool->table[type].releaseFunc = releaseFunc_opt;
+		return 1;
+	}
+	return -1;
+}
+
+a3_GraphicsPoolHandle a3graphicsPoolAdd(a3_GraphicsObjectPool *pool, const a3_GraphicsObjectType type, const a3ui32 name)
+{
+	a3_GraphicsObjectTable *table;
+	a3ui32 index;
+	if (pool && type < a3pool_typeMax && name)
+	{
+		table = pool->table + type;
+		index = table->freeHead;
+		if (index < table->capacity)
+		{
+			table->freeHead = table->nextFree[index];
+			table->name[index] = name;
+			++table->count;
+			return ((a3ui32)type << a3pool_typeShift) | ((a3ui32)table->generation[index] << a3pool_generationShift) | index;
+		}
+		printf("\n A3 Warning: Graphics object pool table %u is full (%u objects).", (a3ui32)type, table->capacity);
+	}
+	return 0;
+}
+
+a3ret a3graphicsPoolRemove(a3_GraphicsObjectPool *pool, const a3_GraphicsPoolHandle handle)
+{
+	a3_GraphicsObjectTable *table;
+	a3ui32 index;
+	if (a3graphicsPoolValidate(pool, handle) > 0)
+	{
+		table = pool->table + (handle >> a3pool_typeShift);
+		index = handle & a3pool_indexMask;
+		if (table->releaseFunc)
+			table->releaseFunc(1, table->name + index);
+
+		// advance generation (skipping zero) and push slot to free list
+		table->name[index] = 0;
+		table->generation[index] = (table->generation[index] % a3pool_generationMask) + 1;
+		table->nextFree[index] = (a3ui16)table->freeHead;
+		table->freeHead = index;
+		return --table->count;
+	}
+	return -1;
+}
+
+a3ret a3graphicsPoolRemoveAllType(a3_GraphicsObjectPool *pool, const a3_GraphicsObjectType type)
+{
+	if (pool && type < a3pool_typeMax && pool->table[type].capacity)
+		return a3graphicsPoolInternalRemoveAll(pool->table + type);
+	return -1;
+}
+
+a3ret a3graphicsPoolRemoveAll(a3_GraphicsObjectPool *pool)
+{
+	a3ui32 i, ret = 0;
+	if (pool && pool->table->capacity)
+	{
+		for (i = 0; i < a3pool_typeMax; ++i)
+			ret += a3graphicsPoolInternalRemoveAll(pool->table + i);
+		return ret;
+	}
+	return -1;
+}
+
+a3ret a3graphicsPoolRelease(a3_GraphicsObjectPool *pool)
+{
+	a3ret ret = a3graphicsPoolRemoveAll(pool);
+	a3ui32 i;
+	if (ret >= 0)
+	{
+		for (i = 0; i < a3pool_typeMax; ++i)
+		{
+			free(pool->table[i].name);
+			memset(pool->table + i, 0, sizeof(a3_GraphicsObjectTable));
+		}
+	}
+	return ret;
+}
+
+
+//-----------------------------------------------------------------------------
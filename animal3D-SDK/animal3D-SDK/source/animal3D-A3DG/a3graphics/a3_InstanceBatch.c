@@ -0,0 +1,90 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_InstanceBatch.c
+	Definitions for instance batching shared by all back ends: grouping
+		items by keys.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_InstanceBatch.h"
+
+
+//-----------------------------------------------------------------------------
+// internal utilities
+
+// group holding an item's keys, or group count if there is none yet;
+//	distinct key pairs are few, so a linear search beats sorting
+inline a3ui32 a3instanceInternalFindGroup(const a3_InstanceBatchGroup *group, const a3ui32 groupCount, const void *const *key)
+{
+	a3ui32 g, k;
+	for (g = 0; g < groupCount; ++g)
+	{
+		for (k = 0; k < a3instance_keyCount && group[g].key[k] == key[k]; ++k);
+		if (k == a3instance_keyCount)
+			break;
+	}
+	return g;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3instanceBatchGroup(a3_InstanceBatchGroup *group_out, a3ui32 *order_out, const void *const(*key)[a3instance_keyCount], const a3boolean *include_opt, const a3ui32 count)
+{
+	a3ui32 groupCount = 0, first, i, g, k;
+	if (group_out && order_out && key)
+	{
+		// count items per group
+		for (i = 0; i < count; ++i)
+		{
+			if (include_opt && !include_opt[i])
+				continue;
+			g = a3instanceInternalFindGroup(group_out, groupCount, key[i]);
+			if (g == groupCount)
+			{
+				for (k = 0; k < a3instance_keyCount; ++k)
+					group_out[g].key[k] = key[i][k];
+				group_out[g].count = 0;
+				++groupCount;
+			}
+			++group_out[g].count;
+		}
+
+		// place groups one after another, then items within them
+		for (g = 0, first = 0; g < groupCount; ++g)
+		{
+			group_out[g].first = first;
+			first += group_out[g].count;
+			group_out[g].count = 0;
+		}
+		for (i = 0; i < count; ++i)
+		{
+			if (include_opt && !include_opt[i])
+				continue;
+			g = a3instanceInternalFindGroup(group_out, groupCount, key[i]);
+			order_out[group_out[g].first + group_out[g].count++] = i;
+		}
+		return groupCount;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
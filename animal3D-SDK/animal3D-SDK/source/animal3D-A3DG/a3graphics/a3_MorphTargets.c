@@ -0,0 +1,509 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_MorphTargets.c
+	Definitions for morph target functions shared by all back ends: sparse 
+		delta building, CPU blending and OBJ position utilities.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_MorphTargets.h"
+
+#include "animal3D/a3utility/a3_Thread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// internal utilities
+
+// largest quantized delta component
+#define a3morphInternalQuantizeMax	32767.0f
+
+// source position sorted by x, used to match mesh vertices
+typedef struct a3_MorphTargetInternalKey
+{
+	a3f32 x;
+	a3ui32 index;
+} a3_MorphTargetInternalKey;
+
+// arguments of one parallel blend range
+typedef struct a3_MorphTargetInternalBlendRange
+{
+	const a3_MorphTargetData *data;
+	const a3f32 *weight;
+	a3f32(*position_out)[3];
+	a3f32(*normal_out)[3];
+	a3ui32 first, count;
+} a3_MorphTargetInternalBlendRange;
+
+
+// quantize one delta component; values within threshold are dropped
+inline a3i16 a3morphTargetInternalQuantize(const a3f32 delta, const a3f32 step, const a3f32 threshold)
+{
+	a3f32 q;
+	if (step > 0.0f && fabsf(delta) > threshold)
+	{
+		q = delta / step;
+		q = q < 0.0f ? q - 0.5f : q + 0.5f;
+		q = q < -a3morphInternalQuantizeMax ? -a3morphInternalQuantizeMax : q > +a3morphInternalQuantizeMax ? +a3morphInternalQuantizeMax : q;
+		return (a3i16)q;
+	}
+	return 0;
+}
+
+// quantize the delta of one vertex in one target; returns 1 if it moves
+inline a3boolean a3morphTargetInternalDelta(a3_MorphDelta *delta_out, const a3f32 step[4], const a3f32 *basePosition, const a3f32 *baseNormal, const a3f32 *targetPosition, const a3f32 *targetNormal_opt, const a3f32 threshold)
+{
+	a3ui32 i;
+	for (i = 0; i < 3; ++i)
+	{
+		delta_out->position[i] = a3morphTargetInternalQuantize(targetPosition[i] - basePosition[i], step[0], threshold);
+		delta_out->normal[i] = targetNormal_opt ? a3morphTargetInternalQuantize(targetNormal_opt[i] - baseNormal[i], step[1], threshold) : 0;
+	}
+	return (delta_out->position[0] || delta_out->position[1] || delta_out->position[2] ||
+		delta_out->normal[0] || delta_out->normal[1] || delta_out->normal[2]);
+}
+
+// allocate all arrays in one block: base positions and normals, ranges, 
+//	then deltas
+inline a3boolean a3morphTargetInternalAlloc(a3_MorphTargetData *data, const a3ui32 vertexCount, const a3ui32 deltaCount)
+{
+	const size_t baseSize = vertexCount * sizeof(a3f32[3]);
+	const size_t rangeSize = (vertexCount + 1) * sizeof(a3ui32);
+	const size_t deltaSize = deltaCount * sizeof(a3_MorphDelta);
+	a3byte *const block = (a3byte *)malloc(baseSize * 2 + rangeSize + deltaSize);
+	if (block)
+	{
+		data->basePosition = (a3f32(*)[3])(block);
+		data->baseNormal = (a3f32(*)[3])(block + baseSize);
+		data->range = (a3ui32 *)(block + baseSize * 2);
+		data->delta = (a3_MorphDelta *)(block + baseSize * 2 + rangeSize);
+		data->vertexCount = vertexCount;
+		data->deltaCount = deltaCount;
+		return 1;
+	}
+	return 0;
+}
+
+// sort keys by x
+a3i32 a3morphTargetInternalCompareKey(const void *lh, const void *rh)
+{
+	const a3f32 x0 = ((const a3_MorphTargetInternalKey *)lh)->x, x1 = ((const a3_MorphTargetInternalKey *)rh)->x;
+	return (x0 > x1) - (x0 < x1);
+}
+
+// read one index of any size
+inline a3ui32 a3morphTargetInternalIndex(const void *index_opt, const a3ui32 indexSize, const a3ui32 i)
+{
+	if (index_opt)
+		switch (indexSize)
+		{
+		case 1:
+			return ((const a3ubyte *)index_opt)[i];
+		case 2:
+			return ((const a3ui16 *)index_opt)[i];
+		default:
+			return ((const a3ui32 *)index_opt)[i];
+		}
+	return i;
+}
+
+// parallel blend worker
+a3ret a3morphTargetInternalBlendWorker(void *args)
+{
+	const a3_MorphTargetInternalBlendRange *const range = (const a3_MorphTargetInternalBlendRange *)args;
+	return a3morphTargetDataBlend(range->data, range->weight, range->position_out, range->normal_out, range->first, range->count);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3morphTargetDataCreate(a3_MorphTargetData *data_out, const a3f32 *basePosition, const a3f32 *baseNormal, const a3ui32 vertexCount, const a3f32 *const *targetPosition, const a3f32 *const *targetNormal_opt, const a3ui32 targetCount, const a3f32 threshold)
+{
+	a3_MorphDelta delta[1], *deltaPtr;
+	a3f32 d, positionMax, normalMax;
+	a3ui32 v, t, i, deltaCount;
+
+	if (data_out && basePosition && baseNormal && vertexCount && targetPosition && targetCount && targetCount <= a3morph_targetMax)
+	{
+		if (!data_out->basePosition)
+		{
+			for (t = 0; t < targetCount; ++t)
+				if (!targetPosition[t] || (targetNormal_opt && !targetNormal_opt[t]))
+					return -1;
+
+			// steps: the largest delta of each target uses the full range
+			memset(data_out->step, 0, sizeof(data_out->step));
+			for (t = 0; t < targetCount; ++t)
+			{
+				for (i = 0, positionMax = normalMax = 0.0f; i < vertexCount * 3; ++i)
+				{
+					d = fabsf(targetPosition[t][i] - basePosition[i]);
+					positionMax = d > positionMax ? d : positionMax;
+					d = targetNormal_opt ? fabsf(targetNormal_opt[t][i] - baseNormal[i]) : 0.0f;
+					normalMax = d > normalMax ? d : normalMax;
+				}
+				data_out->step[t][0] = positionMax / a3morphInternalQuantizeMax;
+				data_out->step[t][1] = normalMax / a3morphInternalQuantizeMax;
+			}
+
+			// count deltas that survive quantization, then store them
+			for (v = deltaCount = 0; v < vertexCount; ++v)
+				for (t = 0, i = v * 3; t < targetCount; ++t)
+					deltaCount += a3morphTargetInternalDelta(delta, data_out->step[t], basePosition + i, baseNormal + i,
+						targetPosition[t] + i, targetNormal_opt ? targetNormal_opt[t] + i : 0, threshold);
+			if (!a3morphTargetInternalAlloc(data_out, vertexCount, deltaCount))
+				return -1;
+			memcpy(data_out->basePosition, basePosition, vertexCount * sizeof(a3f32[3]));
+			memcpy(data_out->baseNormal, baseNormal, vertexCount * sizeof(a3f32[3]));
+			data_out->targetCount = targetCount;
+
+			for (v = 0, deltaPtr = data_out->delta; v < vertexCount; ++v)
+			{
+				data_out->range[v] = (a3ui32)(deltaPtr - data_out->delta);
+				for (t = 0, i = v * 3; t < targetCount; ++t)
+					if (a3morphTargetInternalDelta(deltaPtr, data_out->step[t], basePosition + i, baseNormal + i,
+						targetPosition[t] + i, targetNormal_opt ? targetNormal_opt[t] + i : 0, threshold))
+					{
+						deltaPtr->target = (a3ui16)t;
+						deltaPtr->reserved = 0;
+						++deltaPtr;
+					}
+			}
+			data_out->range[vertexCount] = deltaCount;
+			return deltaCount;
+		}
+	}
+	return -1;
+}
+
+a3ret a3morphTargetDataRelease(a3_MorphTargetData *data)
+{
+	if (data && data->basePosition)
+	{
+		// one block holds every array
+		free(data->basePosition);
+		memset(data, 0, sizeof(a3_MorphTargetData));
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3morphTargetDataBlend(const a3_MorphTargetData *data, const a3f32 *weight, a3f32(*position_out)[3], a3f32(*normal_out_opt)[3], const a3ui32 first, const a3ui32 count)
+{
+	a3f32 positionWeight[a3morph_targetMax], normalWeight[a3morph_targetMax];
+	a3f32 p[3], n[3], w, len;
+	const a3_MorphDelta *delta, *deltaEnd;
+	a3ui32 v, vEnd, t;
+
+	if (data && data->basePosition && weight && position_out && first <= data->vertexCount)
+	{
+		// fold weight and step together once per call
+		for (t = 0; t < data->targetCount; ++t)
+		{
+			positionWeight[t] = weight[t] * data->step[t][0];
+			normalWeight[t] = weight[t] * data->step[t][1];
+		}
+
+		vEnd = count < data->vertexCount - first ? first + count : data->vertexCount;
+		for (v = first; v < vEnd; ++v)
+		{
+			p[0] = data->basePosition[v][0];
+			p[1] = data->basePosition[v][1];
+			p[2] = data->basePosition[v][2];
+			n[0] = data->baseNormal[v][0];
+			n[1] = data->baseNormal[v][1];
+			n[2] = data->baseNormal[v][2];
+
+			// only targets that move this vertex are visited
+			for (delta = data->delta + data->range[v], deltaEnd = data->delta + data->range[v + 1]; delta < deltaEnd; ++delta)
+			{
+				w = positionWeight[delta->target];
+				p[0] += w * (a3f32)delta->position[0];
+				p[1] += w * (a3f32)delta->position[1];
+				p[2] += w * (a3f32)delta->position[2];
+				w = normalWeight[delta->target];
+				n[0] += w * (a3f32)delta->normal[0];
+				n[1] += w * (a3f32)delta->normal[1];
+				n[2] += w * (a3f32)delta->normal[2];
+			}
+
+			position_out[v][0] = p[0];
+			position_out[v][1] = p[1];
+			position_out[v][2] = p[2];
+			if (normal_out_opt)
+			{
+				len = n[0] * n[0] + n[1] * n[1] + n[2] * n[2];
+				len = len > 0.0f ? 1.0f / sqrtf(len) : 0.0f;
+				normal_out_opt[v][0] = n[0] * len;
+				normal_out_opt[v][1] = n[1] * len;
+				normal_out_opt[v][2] = n[2] * len;
+			}
+		}
+		return (vEnd - first);
+	}
+	return -1;
+}
+
+a3ret a3morphTargetDataBlendParallel(const a3_MorphTargetData *data, const a3f32 *weight, a3f32(*position_out)[3], a3f32(*normal_out_opt)[3], const a3ui32 threadCount)
+{
+	a3_Thread thread[a3morph_threadMax] = { 0 };
+	a3_MorphTargetInternalBlendRange range[a3morph_threadMax];
+	a3ui32 i, n, first, size, launched = 0;
+
+	if (data && data->basePosition && weight && position_out && threadCount)
+	{
+		// equal ranges, the remainder spread over the first ones
+		n = threadCount < a3morph_threadMax ? threadCount : a3morph_threadMax;
+		n = n < data->vertexCount ? n : data->vertexCount;
+		size = data->vertexCount / n;
+		for (i = first = 0; i < n; ++i)
+		{
+			range[i].data = data;
+			range[i].weight = weight;
+			range[i].position_out = position_out;
+			range[i].normal_out = normal_out_opt;
+			range[i].first = first;
+			range[i].count = size + (i < data->vertexCount % n);
+			first += range[i].count;
+		}
+
+		// ranges do not overlap, so workers write without locking; a 
+		//	range whose thread fails to launch is done here instead
+		for (i = 0; i + 1 < n; ++i)
+			if (a3threadLaunch(thread + i, a3morphTargetInternalBlendWorker, range + i, "a3morphBlend") > 0)
+				launched |= (1u << i);
+			else
+				a3morphTargetInternalBlendWorker(range + i);
+		a3morphTargetInternalBlendWorker(range + i);
+		for (i = 0; i + 1 < n; ++i)
+			if (launched & (1u << i))
+				a3threadWait(thread + i);
+		return data->vertexCount;
+	}
+	return -1;
+}
+
+a3ret a3morphTargetDataSaveBinary(const a3_MorphTargetData *data, const a3_FileStream *fileStream)
+{
+	FILE *fp;
+	a3ui32 ret = 0;
+	if (data && fileStream)
+	{
+		if (data->basePosition)
+		{
+			fp = fileStream->stream;
+			if (fp)
+			{
+				ret += (a3ui32)fwrite(&data->vertexCount, 1, sizeof(a3ui32), fp);
+				ret += (a3ui32)fwrite(&data->targetCount, 1, sizeof(a3ui32), fp);
+				ret += (a3ui32)fwrite(&data->deltaCount, 1, sizeof(a3ui32), fp);
+				ret += (a3ui32)fwrite(data->step, 1, sizeof(data->step), fp);
+				ret += (a3ui32)fwrite(data->basePosition, 1, sizeof(a3f32[3]) * data->vertexCount, fp);
+				ret += (a3ui32)fwrite(data->baseNormal, 1, sizeof(a3f32[3]) * data->vertexCount, fp);
+				ret += (a3ui32)fwrite(data->range, 1, sizeof(a3ui32) * (data->vertexCount + 1), fp);
+				ret += (a3ui32)fwrite(data->delta, 1, sizeof(a3_MorphDelta) * data->deltaCount, fp);
+			}
+			return ret;
+		}
+	}
+	return -1;
+}
+
+a3ret a3morphTargetDataLoadBinary(a3_MorphTargetData *data_out, const a3_FileStream *fileStream)
+{
+	FILE *fp;
+	a3ui32 ret = 0, vertexCount = 0, deltaCount = 0;
+	if (data_out && fileStream)
+	{
+		if (!data_out->basePosition)
+		{
+			fp = fileStream->stream;
+			if (fp)
+			{
+				ret += (a3ui32)fread(&vertexCount, 1, sizeof(a3ui32), fp);
+				ret += (a3ui32)fread(&data_out->targetCount, 1, sizeof(a3ui32), fp);
+				ret += (a3ui32)fread(&deltaCount, 1, sizeof(a3ui32), fp);
+				ret += (a3ui32)fread(data_out->step, 1, sizeof(data_out->step), fp);
+				if (vertexCount && data_out->targetCount <= a3morph_targetMax && a3morphTargetInternalAlloc(data_out, vertexCount, deltaCount))
+				{
+					ret += (a3ui32)fread(data_out->basePosition, 1, sizeof(a3f32[3]) * vertexCount, fp);
+					ret += (a3ui32)fread(data_out->baseNormal, 1, sizeof(a3f32[3]) * vertexCount, fp);
+					ret += (a3ui32)fread(data_out->range, 1, sizeof(a3ui32) * (vertexCount + 1), fp);
+					ret += (a3ui32)fread(data_out->delta, 1, sizeof(a3_MorphDelta) * deltaCount, fp);
+				}
+			}
+			return ret;
+		}
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3morphTargetLoadPositionsOBJ(a3f32(*position_out_opt)[3], const a3ui32 capacity, const a3byte *filePath, const a3f32 *transform_opt)
+{
+	FILE *fp;
+	a3byte line[1024];
+	a3f32 v[3];
+	a3ui32 count = 0;
+	if (filePath && *filePath)
+	{
+		fp = fopen(filePath, "r");
+		if (fp)
+		{
+			// position lines only; everything else is shared with the base
+			while (fgets(line, sizeof(line), fp))
+				if (line[0] == 'v' && (line[1] == ' ' || line[1] == '\t'))
+				{
+					if (position_out_opt && count < capacity)
+					{
+						v[0] = v[1] = v[2] = 0.0f;
+						sscanf(line + 2, "%f %f %f", v + 0, v + 1, v + 2);
+						if (transform_opt)
+						{
+							position_out_opt[count][0] = transform_opt[0] * v[0] + transform_opt[4] * v[1] + transform_opt[8] * v[2] + transform_opt[12];
+							position_out_opt[count][1] = transform_opt[1] * v[0] + transform_opt[5] * v[1] + transform_opt[9] * v[2] + transform_opt[13];
+							position_out_opt[count][2] = transform_opt[2] * v[0] + transform_opt[6] * v[1] + transform_opt[10] * v[2] + transform_opt[14];
+						}
+						else
+							memcpy(position_out_opt[count], v, sizeof(v));
+					}
+					++count;
+				}
+			fclose(fp);
+			return count;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3morphTargetMapVertices(a3ui32 *map_out, const a3f32 *position, const a3ui32 vertexCount, const a3f32 *sourcePosition, const a3ui32 sourceCount, const a3f32 tolerance)
+{
+	a3_MorphTargetInternalKey *key;
+	const a3f32 *p, *s;
+	a3f32 d[3], distSq, bestSq;
+	a3ui32 v, i, lo, hi, mid, matched = 0;
+
+	if (map_out && position && vertexCount && sourcePosition && sourceCount)
+	{
+		key = (a3_MorphTargetInternalKey *)malloc(sourceCount * sizeof(a3_MorphTargetInternalKey));
+		if (!key)
+			return -1;
+		for (i = 0; i < sourceCount; ++i)
+		{
+			key[i].x = sourcePosition[i * 3];
+			key[i].index = i;
+		}
+		qsort(key, sourceCount, sizeof(a3_MorphTargetInternalKey), a3morphTargetInternalCompareKey);
+
+		for (v = 0, p = position; v < vertexCount; ++v, p += 3)
+		{
+			// first key within tolerance on x, then closest in the slab
+			for (lo = 0, hi = sourceCount; lo < hi; )
+			{
+				mid = (lo + hi) / 2;
+				if (key[mid].x < p[0] - tolerance)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			map_out[v] = sourceCount;
+			for (i = lo, bestSq = tolerance * tolerance; i < sourceCount && key[i].x <= p[0] + tolerance; ++i)
+			{
+				s = sourcePosition + key[i].index * 3;
+				d[0] = s[0] - p[0];
+				d[1] = s[1] - p[1];
+				d[2] = s[2] - p[2];
+				distSq = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+				if (distSq <= bestSq)
+				{
+					bestSq = distSq;
+					map_out[v] = key[i].index;
+				}
+			}
+			matched += (map_out[v] < sourceCount);
+		}
+
+		free(key);
+		return matched;
+	}
+	return -1;
+}
+
+a3ret a3morphTargetCalculateNormals(a3f32(*normal_out)[3], const a3f32 *sourcePosition, const a3ui32 sourceCount, const a3ui32 *map, const void *index_opt, const a3ui32 indexSize, const a3ui32 count)
+{
+	const a3f32 *p0, *p1, *p2;
+	a3f32 e0[3], e1[3], n[3], len;
+	a3ui32 i, j, s[3], triangles = 0;
+
+	if (normal_out && sourcePosition && sourceCount && map)
+	{
+		memset(normal_out, 0, sourceCount * sizeof(a3f32[3]));
+
+		// unnormalized cross product is twice the area, so bigger faces 
+		//	weigh more
+		for (i = 0; i + 2 < count; i += 3)
+		{
+			for (j = 0; j < 3; ++j)
+				s[j] = map[a3morphTargetInternalIndex(index_opt, indexSize, i + j)];
+			if (s[0] >= sourceCount || s[1] >= sourceCount || s[2] >= sourceCount)
+				continue;
+			p0 = sourcePosition + s[0] * 3;
+			p1 = sourcePosition + s[1] * 3;
+			p2 = sourcePosition + s[2] * 3;
+			for (j = 0; j < 3; ++j)
+			{
+				e0[j] = p1[j] - p0[j];
+				e1[j] = p2[j] - p0[j];
+			}
+			n[0] = e0[1] * e1[2] - e0[2] * e1[1];
+			n[1] = e0[2] * e1[0] - e0[0] * e1[2];
+			n[2] = e0[0] * e1[1] - e0[1] * e1[0];
+			for (j = 0; j < 3; ++j)
+			{
+				normal_out[s[j]][0] += n[0];
+				normal_out[s[j]][1] += n[1];
+				normal_out[s[j]][2] += n[2];
+			}
+			++triangles;
+		}
+
+		for (i = 0; i < sourceCount; ++i)
+		{
+			len = normal_out[i][0] * normal_out[i][0] + normal_out[i][1] * normal_out[i][1] + normal_out[i][2] * normal_out[i][2];
+			len = len > 0.0f ? 1.0f / sqrtf(len) : 0.0f;
+			normal_out[i][0] *= len;
+			normal_out[i][1] *= len;
+			normal_out[i][2] *= len;
+		}
+		return triangles;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
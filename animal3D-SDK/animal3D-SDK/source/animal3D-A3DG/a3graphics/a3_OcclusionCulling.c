@@ -0,0 +1,193 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_OcclusionCulling.c
+	Definitions for occlusion culling functions shared by all back ends:
+		pyramid layout and the CPU reference build and test.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_OcclusionCulling.h"
+
+
+//-----------------------------------------------------------------------------
+// internal utilities
+
+// clip w below which a corner counts as crossing the near plane
+#define a3occlusionInternalNearW	1.0e-5f
+
+
+// size of a level, halved and rounded down like texture mip levels
+inline a3ui32 a3occlusionInternalLevelSize(const a3ui32 size, const a3ui32 level)
+{
+	const a3ui32 s = (size >> 1) >> level;
+	return s ? s : 1;
+}
+
+// source range reduced into a target texel: a 2x2 block, widened to take
+//	the leftover row or column when the source is odd
+inline void a3occlusionInternalSourceRange(a3ui32 *first_out, a3ui32 *last_out, const a3ui32 texel, const a3ui32 targetSize, const a3ui32 sourceSize)
+{
+	*first_out = texel * 2;
+	*last_out = texel + 1 < targetSize ? texel * 2 + 1 : sourceSize - 1;
+	if (*last_out < *first_out)
+		*last_out = *first_out;
+}
+
+// texel of a level holding a depth pixel coordinate; level texels cover
+//	2^(level + 1) pixels, the last one any that are left over
+inline a3ui32 a3occlusionInternalTexel(const a3f32 pixel, const a3ui32 level, const a3ui32 levelSize)
+{
+	const a3f32 t = pixel / (a3f32)(2u << level);
+	const a3ui32 i = t > 0.0f ? (a3ui32)t : 0;
+	return i < levelSize ? i : levelSize - 1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ui32 a3occlusionPyramidSize(const a3ui32 depthWidth, const a3ui32 depthHeight, a3ui32 *levelCount_out_opt)
+{
+	a3ui32 size = 0, level = 0, w, h;
+	if (depthWidth && depthHeight)
+	{
+		do
+		{
+			w = a3occlusionInternalLevelSize(depthWidth, level);
+			h = a3occlusionInternalLevelSize(depthHeight, level);
+			size += w * h;
+			++level;
+		} while (w > 1 || h > 1);
+	}
+	if (levelCount_out_opt)
+		*levelCount_out_opt = level;
+	return size;
+}
+
+a3ret a3occlusionBuildPyramidReference(a3f32 *pyramid_out, const a3f32 *depth, const a3ui32 depthWidth, const a3ui32 depthHeight)
+{
+	const a3f32 *source;
+	a3f32 *target, d;
+	a3ui32 levelCount, level, sw, sh, tw, th, x, y, sx, sy, x0, x1, y0, y1;
+	if (pyramid_out && depth && depthWidth && depthHeight)
+	{
+		a3occlusionPyramidSize(depthWidth, depthHeight, &levelCount);
+		for (level = 0, source = depth, target = pyramid_out, sw = depthWidth, sh = depthHeight;
+			level < levelCount; ++level, source = target, target += tw * th, sw = tw, sh = th)
+		{
+			tw = a3occlusionInternalLevelSize(depthWidth, level);
+			th = a3occlusionInternalLevelSize(depthHeight, level);
+			for (y = 0; y < th; ++y)
+			{
+				a3occlusionInternalSourceRange(&y0, &y1, y, th, sh);
+				for (x = 0; x < tw; ++x)
+				{
+					// farthest depth in the block
+					a3occlusionInternalSourceRange(&x0, &x1, x, tw, sw);
+					for (sy = y0, d = 0.0f; sy <= y1; ++sy)
+						for (sx = x0; sx <= x1; ++sx)
+							if (d < source[sy * sw + sx])
+								d = source[sy * sw + sx];
+					target[y * tw + x] = d;
+				}
+			}
+		}
+		return levelCount;
+	}
+	return -1;
+}
+
+a3ret a3occlusionTestReference(a3boolean *visible_out, const a3f32 *pyramid, const a3ui32 depthWidth, const a3ui32 depthHeight, const a3f32(*boundsMin)[4], const a3f32(*boundsMax)[4], const a3ui32 count, const a3f32 *viewProjectionMat)
+{
+	const a3f32 *m = viewProjectionMat, *level;
+	a3f32 corner[3], clip[4], ndcMin[3], ndcMax[3], ndc, x0, x1, y0, y1, extent, z, d;
+	a3ui32 levelCount, i, c, r, l, lw, lh, ix0, ix1, iy0, iy1;
+	a3ret visibleCount = 0;
+	a3boolean visible;
+	if (visible_out && pyramid && depthWidth && depthHeight && boundsMin && boundsMax && viewProjectionMat)
+	{
+		a3occlusionPyramidSize(depthWidth, depthHeight, &levelCount);
+		for (i = 0; i < count; ++i)
+		{
+			// project corners; any behind the near plane makes it visible
+			ndcMin[0] = ndcMin[1] = ndcMin[2] = +1.0e30f;
+			ndcMax[0] = ndcMax[1] = ndcMax[2] = -1.0e30f;
+			for (c = 0, visible = 0; c < 8 && !visible; ++c)
+			{
+				corner[0] = (c & 1) ? boundsMax[i][0] : boundsMin[i][0];
+				corner[1] = (c & 2) ? boundsMax[i][1] : boundsMin[i][1];
+				corner[2] = (c & 4) ? boundsMax[i][2] : boundsMin[i][2];
+				for (r = 0; r < 4; ++r)
+					clip[r] = m[r] * corner[0] + m[4 + r] * corner[1] + m[8 + r] * corner[2] + m[12 + r];
+				if (clip[3] <= a3occlusionInternalNearW)
+					visible = 1;
+				for (r = 0; r < 3 && !visible; ++r)
+				{
+					ndc = clip[r] / clip[3];
+					if (ndcMin[r] > ndc)
+						ndcMin[r] = ndc;
+					if (ndcMax[r] < ndc)
+						ndcMax[r] = ndc;
+				}
+			}
+
+			// screen rect in depth pixels, clipped to the screen
+			if (!visible)
+			{
+				x0 = (ndcMin[0] * 0.5f + 0.5f) * (a3f32)depthWidth;
+				x1 = (ndcMax[0] * 0.5f + 0.5f) * (a3f32)depthWidth;
+				y0 = (ndcMin[1] * 0.5f + 0.5f) * (a3f32)depthHeight;
+				y1 = (ndcMax[1] * 0.5f + 0.5f) * (a3f32)depthHeight;
+				z = ndcMin[2] * 0.5f + 0.5f;
+				if (x1 >= 0.0f && y1 >= 0.0f && x0 <= (a3f32)depthWidth && y0 <= (a3f32)depthHeight && z <= 1.0f)
+				{
+					x0 = x0 > 0.0f ? x0 : 0.0f;
+					y0 = y0 > 0.0f ? y0 : 0.0f;
+					x1 = x1 < (a3f32)depthWidth ? x1 : (a3f32)depthWidth;
+					y1 = y1 < (a3f32)depthHeight ? y1 : (a3f32)depthHeight;
+
+					// coarsest level needed for the rect to span 2x2 texels
+					extent = (x1 - x0) > (y1 - y0) ? (x1 - x0) : (y1 - y0);
+					for (l = 0, level = pyramid; l + 1 < levelCount && extent > (a3f32)(2u << l); ++l)
+						level += a3occlusionInternalLevelSize(depthWidth, l) * a3occlusionInternalLevelSize(depthHeight, l);
+					lw = a3occlusionInternalLevelSize(depthWidth, l);
+					lh = a3occlusionInternalLevelSize(depthHeight, l);
+					ix0 = a3occlusionInternalTexel(x0, l, lw);
+					ix1 = a3occlusionInternalTexel(x1, l, lw);
+					iy0 = a3occlusionInternalTexel(y0, l, lh);
+					iy1 = a3occlusionInternalTexel(y1, l, lh);
+
+					// farthest occluder depth against nearest box depth
+					d = level[iy0 * lw + ix0];
+					d = d > level[iy0 * lw + ix1] ? d : level[iy0 * lw + ix1];
+					d = d > level[iy1 * lw + ix0] ? d : level[iy1 * lw + ix0];
+					d = d > level[iy1 * lw + ix1] ? d : level[iy1 * lw + ix1];
+					visible = z <= d;
+				}
+			}
+			visible_out[i] = visible;
+			visibleCount += visible;
+		}
+		return visibleCount;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,118 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_ParticleSystem.c
+	Definitions for particle system functions shared by all back ends: 
+		emission rate and the CPU reference simulation.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_ParticleSystem.h"
+
+
+//-----------------------------------------------------------------------------
+// internal utilities
+
+// integer hash (PCG output permutation); the shaders use the same one so 
+//	that particle number n gets the same random values everywhere
+inline a3ui32 a3particleInternalHash(const a3ui32 value)
+{
+	const a3ui32 state = value * 747796405u + 2891336453u;
+	const a3ui32 word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+	return (word >> 22u) ^ word;
+}
+
+// next random value in [0, 1) from a hash stream
+inline a3f32 a3particleInternalRandom(a3ui32 *stream)
+{
+	*stream = a3particleInternalHash(*stream);
+	return (a3f32)(*stream >> 8) * (1.0f / 16777216.0f);
+}
+
+// spawn particle number 'index' from emitter
+void a3particleInternalSpawn(a3_Particle *particle, const a3_ParticleEmitter *emitter, const a3ui32 index)
+{
+	a3ui32 stream = index ^ a3particleInternalHash(emitter->seed);
+	a3f32 life;
+	a3ui32 i;
+	for (i = 0; i < 3; ++i)
+		particle->position[i] = emitter->position[i] + (a3particleInternalRandom(&stream) * 2.0f - 1.0f) * emitter->position[3];
+	for (i = 0; i < 3; ++i)
+		particle->velocity[i] = emitter->velocity[i] + (a3particleInternalRandom(&stream) * 2.0f - 1.0f) * emitter->velocity[3];
+	life = emitter->life[0] + (a3particleInternalRandom(&stream) * 2.0f - 1.0f) * emitter->life[1];
+	if (life < 0.001f)
+		life = 0.001f;
+	particle->position[3] = life;
+	particle->velocity[3] = emitter->life[2];
+	particle->color[0] = emitter->color[0];
+	particle->color[1] = emitter->color[1];
+	particle->color[2] = emitter->color[2];
+	particle->color[3] = 1.0f / life;
+}
+
+// integrate particle over time step; returns non-zero if still alive
+a3boolean a3particleInternalIntegrate(a3_Particle *particle, const a3_ParticleEmitter *emitter, const a3f32 dt)
+{
+	a3ui32 i;
+	for (i = 0; i < 3; ++i)
+	{
+		particle->velocity[i] += (emitter->gravity[i] - particle->velocity[i] * emitter->gravity[3]) * dt;
+		particle->position[i] += particle->velocity[i] * dt;
+	}
+	particle->position[3] -= dt;
+	return (particle->position[3] > 0.0f);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3particleSimulateReference(a3_Particle *particle, const a3ui32 count, const a3ui32 capacity, const a3_ParticleEmitter *emitter, const a3ui32 emitIndex, const a3ui32 emitCount, const a3f32 dt)
+{
+	a3ui32 i, n;
+	if (particle && count <= capacity && capacity && emitter && dt > 0.0f)
+	{
+		// compact in place: the write index never passes the read index
+		for (i = n = 0; i < count; ++i)
+			if (a3particleInternalIntegrate(particle + i, emitter, dt))
+				particle[n++] = particle[i];
+
+		// append new particles until full
+		for (i = 0; i < emitCount && n < capacity; ++i, ++n)
+			a3particleInternalSpawn(particle + n, emitter, emitIndex + i);
+		return n;
+	}
+	return -1;
+}
+
+
+a3ui32 a3particleEmitCount(a3f32 *emitCarry, const a3f32 rate, const a3f32 dt)
+{
+	a3ui32 count = 0;
+	if (emitCarry && rate > 0.0f && dt > 0.0f)
+	{
+		*emitCarry += rate * dt;
+		count = (a3ui32)(*emitCarry);
+		*emitCarry -= (a3f32)count;
+	}
+	return count;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,256 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_ShaderPreprocessor.c
+	Definitions for GLSL include expansion and define injection.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_ShaderPreprocessor.h"
+
+#include "animal3D/a3utility/a3_Stream.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+// growable output string
+typedef struct a3_ShaderSourceBuffer
+{
+	a3byte *text;
+	a3ui32 length, capacity;
+} a3_ShaderSourceBuffer;
+
+
+// append characters to output
+void a3shaderSourceInternalAppend(a3_ShaderSourceBuffer *buffer, const a3byte *str, const a3ui32 count)
+{
+	a3ui32 capacity = buffer->capacity;
+	if (buffer->length + count + 1 > capacity)
+	{
+		capacity = capacity ? capacity : 4096;
+		while (buffer->length + count + 1 > capacity)
+			capacity *= 2;
+		buffer->text = (a3byte *)realloc(buffer->text, capacity);
+		buffer->capacity = capacity;
+	}
+	memcpy(buffer->text + buffer->length, str, count);
+	buffer->length += count;
+	buffer->text[buffer->length] = 0;
+}
+
+// append line directive: next line is 'line' of source string 'fileIndex'
+void a3shaderSourceInternalAppendLine(a3_ShaderSourceBuffer *buffer, const a3ui32 line, const a3ui32 fileIndex)
+{
+	a3byte str[32];
+	a3ui32 const count = (a3ui32)sprintf(str, "#line %u %u\n", line, fileIndex);
+	a3shaderSourceInternalAppend(buffer, str, count);
+}
+
+// skip spaces and tabs
+const a3byte *a3shaderSourceInternalSkipSpace(const a3byte *str)
+{
+	while (*str == ' ' || *str == '\t')
+		++str;
+	return str;
+}
+
+// check whether a line is the given directive; returns text after it
+const a3byte *a3shaderSourceInternalDirective(const a3byte *line, const a3byte *directive)
+{
+	const a3ui32 count = (a3ui32)strlen(directive);
+	line = a3shaderSourceInternalSkipSpace(line);
+	if (*line == '#')
+	{
+		line = a3shaderSourceInternalSkipSpace(line + 1);
+		if (!strncmp(line, directive, count))
+			return (line + count);
+	}
+	return 0;
+}
+
+// check whether a file has a version line
+a3boolean a3shaderSourceInternalHasVersion(const a3byte *contents)
+{
+	const a3byte *itr;
+	for (itr = contents; itr; itr = strchr(itr, '\n'), itr = itr ? itr + 1 : 0)
+		if (a3shaderSourceInternalDirective(itr, "version"))
+			return 1;
+	return 0;
+}
+
+
+// expand a file into output
+a3ret a3shaderSourceInternalExpand(a3_ShaderSource *source, a3_ShaderSourceBuffer *buffer, const a3byte *filePath, const a3byte *defines_opt, const a3ui32 depth)
+{
+	a3_Stream fs[1] = { 0 };
+	a3byte includePath[a3shaderSource_pathMax];
+	const a3byte *itr, *lineEnd, *name, *nameEnd;
+	a3ui32 fileIndex, line, directoryLength, nameLength, i;
+	a3ret result = 1;
+
+	if (depth > a3shaderSource_depthMax)
+	{
+		printf("\n A3 ERROR (SHDR \'%s\'): \n\t Includes nested too deeply.", filePath);
+		return 0;
+	}
+	if (source->fileCount >= a3shaderSource_fileMax)
+	{
+		printf("\n A3 ERROR (SHDR \'%s\'): \n\t Too many included files.", filePath);
+		return 0;
+	}
+	if (a3streamLoadContents(fs, filePath) <= 0)
+	{
+		printf("\n A3 ERROR (SHDR \'%s\'): \n\t Cannot read file.", filePath);
+		return 0;
+	}
+
+	// record file; its index is its source string number
+	fileIndex = source->fileCount++;
+	strncpy(source->filePath[fileIndex], filePath, a3shaderSource_pathMax - 1);
+	source->filePath[fileIndex][a3shaderSource_pathMax - 1] = 0;
+
+	// includes are relative to this file's directory
+	for (i = directoryLength = 0; filePath[i]; ++i)
+		if (filePath[i] == '/' || filePath[i] == '\\')
+			directoryLength = i + 1;
+
+	// defines go first if there is no version line to put them after
+	if (!depth && defines_opt && !a3shaderSourceInternalHasVersion(fs->contents))
+	{
+		a3shaderSourceInternalAppend(buffer, defines_opt, (a3ui32)strlen(defines_opt));
+		a3shaderSourceInternalAppendLine(buffer, 1, fileIndex);
+	}
+
+	for (itr = fs->contents, line = 1; *itr; itr = lineEnd, ++line)
+	{
+		lineEnd = strchr(itr, '\n');
+		lineEnd = lineEnd ? lineEnd + 1 : itr + strlen(itr);
+
+		if ((name = a3shaderSourceInternalDirective(itr, "include")))
+		{
+			// file name in quotes or brackets
+			name = a3shaderSourceInternalSkipSpace(name);
+			nameEnd = (*name == '\"' || *name == '<') ? strchr(name + 1, (*name == '<' ? '>' : '\"')) : 0;
+			nameLength = (nameEnd && nameEnd < lineEnd) ? (a3ui32)(nameEnd - name - 1) : 0;
+			if (nameLength && directoryLength + nameLength < a3shaderSource_pathMax)
+			{
+				memcpy(includePath, filePath, directoryLength);
+				memcpy(includePath + directoryLength, name + 1, nameLength);
+				includePath[directoryLength + nameLength] = 0;
+
+				// include each file once
+				for (i = 0; i < source->fileCount; ++i)
+					if (!strcmp(source->filePath[i], includePath))
+						break;
+				if (i == source->fileCount)
+				{
+					a3shaderSourceInternalAppendLine(buffer, 1, source->fileCount);
+					if (a3shaderSourceInternalExpand(source, buffer, includePath, 0, depth + 1) <= 0)
+						result = 0;
+					a3shaderSourceInternalAppendLine(buffer, line + 1, fileIndex);
+				}
+				else
+					a3shaderSourceInternalAppend(buffer, "\n", 1);
+			}
+			else
+			{
+				printf("\n A3 ERROR (SHDR \'%s\'): \n\t Invalid include on line %u.", filePath, line);
+				a3shaderSourceInternalAppend(buffer, "\n", 1);
+				result = 0;
+			}
+			continue;
+		}
+		else if (a3shaderSourceInternalDirective(itr, "version"))
+		{
+			// only the root file's version line counts
+			if (depth)
+			{
+				a3shaderSourceInternalAppend(buffer, "\n", 1);
+				continue;
+			}
+			a3shaderSourceInternalAppend(buffer, itr, (a3ui32)(lineEnd - itr));
+			if (lineEnd[-1] != '\n')
+				a3shaderSourceInternalAppend(buffer, "\n", 1);
+			if (defines_opt)
+			{
+				a3shaderSourceInternalAppend(buffer, defines_opt, (a3ui32)strlen(defines_opt));
+				a3shaderSourceInternalAppendLine(buffer, line + 1, fileIndex);
+			}
+			continue;
+		}
+
+		a3shaderSourceInternalAppend(buffer, itr, (a3ui32)(lineEnd - itr));
+	}
+
+	// make sure the next file starts on its own line
+	if (buffer->length && buffer->text[buffer->length - 1] != '\n')
+		a3shaderSourceInternalAppend(buffer, "\n", 1);
+
+	a3streamReleaseContents(fs);
+	return result;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3shaderSourcePreprocessFile(a3_ShaderSource *source_out, const a3byte *filePath, const a3byte *defines_opt)
+{
+	a3_ShaderSourceBuffer buffer[1] = { 0 };
+	if (source_out && filePath && *filePath)
+	{
+		if (!source_out->text)
+		{
+			// file list is kept even if expanding fails, so that callers 
+			//	can still watch every file involved
+			source_out->length = source_out->fileCount = 0;
+			if (a3shaderSourceInternalExpand(source_out, buffer, filePath, defines_opt, 0) > 0 && buffer->length)
+			{
+				source_out->text = buffer->text;
+				source_out->length = buffer->length;
+				return (a3ret)buffer->length;
+			}
+			free(buffer->text);
+			return 0;
+		}
+	}
+	return -1;
+}
+
+a3ret a3shaderSourceRelease(a3_ShaderSource *source)
+{
+	if (source)
+	{
+		if (source->text)
+		{
+			free(source->text);
+			source->text = 0;
+			source->length = 0;
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,73 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_ShaderProgramParallel.c
+	Common definitions for deferred shader compile and program link.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_ShaderProgramParallel.h"
+
+#include "animal3D/a3utility/a3_Stream.h"
+
+#include <stdlib.h>
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3shaderCreateFromFileListDeferred(a3_Shader *shader_out, const a3byte name_opt[32], const a3_ShaderType type, const a3byte **filePathList, const a3ui32 count)
+{
+	a3ui32 newCount, i;
+	a3i32 result;
+	a3_Stream fs[1] = { 0 };
+	const a3byte **itr, **valid;
+
+	if (shader_out && filePathList && count)
+	{
+		// check for blank file paths
+		valid = (const a3byte **)malloc(count * sizeof(const a3byte *));
+		for (i = newCount = 0, itr = filePathList; i < count; ++i, ++itr)
+		{
+			if (a3streamLoadContents(fs, *itr) > 0)
+			{
+				valid[newCount++] = fs->contents;
+				fs->contents = 0;
+			}
+		}
+
+		// issue compile; the driver has its own copy of the sources after 
+		//	this returns, so file contents can be released right away
+		result = a3shaderCreateFromSourceListDeferred(shader_out, name_opt, type, valid, newCount);
+
+		// release file contents
+		for (i = 0, itr = valid; i < newCount; ++i, ++itr)
+		{
+			fs->contents = *itr;
+			a3streamReleaseContents(fs);
+		}
+
+		// done
+		free((void *)valid);
+		return result;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
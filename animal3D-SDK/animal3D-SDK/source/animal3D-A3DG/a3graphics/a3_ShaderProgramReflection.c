@@ -0,0 +1,190 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_ShaderProgramReflection.c
+	Definitions for reflection table lookup and storage.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_ShaderProgramReflection.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+// file header; size guards against loading a table of another layout
+typedef struct a3_ShaderProgramReflectionFileHeader
+{
+	a3byte identifier[4];
+	a3ui32 size;
+} a3_ShaderProgramReflectionFileHeader;
+
+static const a3byte a3shaderProgramReflectionIdentifier[4] = { 'A', '3', 'R', 'F' };
+
+
+// FNV-1a
+a3ui32 a3shaderReflectInternalHash(const a3byte *name)
+{
+	a3ui32 hash = 2166136261u;
+	while (*name)
+		hash = (hash ^ (a3ubyte)(*(name++))) * 16777619u;
+	return hash;
+}
+
+// add uniform to table; used by reflection implementations
+a3ret a3shaderReflectInternalAddUniform(a3_ShaderProgramReflection *reflection, const a3byte *name, const a3i32 location, const a3ui32 count, const a3ui32 sampler)
+{
+	a3_ShaderProgramReflectEntry *entry;
+	a3ui32 slot;
+	if (reflection->uniformCount < a3shaderReflect_uniformMax && strlen(name) < a3shaderReflect_nameMax)
+	{
+		entry = reflection->uniform + reflection->uniformCount;
+		entry->hash = a3shaderReflectInternalHash(name);
+		entry->location = location;
+		entry->count = count;
+		entry->sampler = sampler;
+		strcpy(entry->name, name);
+		reflection->samplerCount += (sampler != 0);
+
+		// linear probing; table is never more than half full
+		for (slot = entry->hash % a3shaderReflect_slotMax;
+			reflection->slot[slot];
+			slot = (slot + 1) % a3shaderReflect_slotMax);
+		reflection->slot[slot] = (a3ubyte)(++reflection->uniformCount);
+		return reflection->uniformCount;
+	}
+	return -1;
+}
+
+// add block to table
+a3ret a3shaderReflectInternalAddBlock(a3_ShaderProgramReflection *reflection, const a3byte *name, const a3i32 index, const a3ui32 size)
+{
+	a3_ShaderProgramReflectEntry *entry;
+	if (reflection->blockCount < a3shaderReflect_blockMax && strlen(name) < a3shaderReflect_nameMax)
+	{
+		entry = reflection->block + reflection->blockCount;
+		entry->hash = a3shaderReflectInternalHash(name);
+		entry->location = index;
+		entry->count = size;
+		entry->sampler = 0;
+		strcpy(entry->name, name);
+		return ++reflection->blockCount;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+const a3_ShaderProgramReflectEntry *a3shaderProgramReflectionGetUniform(const a3_ShaderProgramReflection *reflection, const a3byte *uniformName)
+{
+	const a3_ShaderProgramReflectEntry *entry;
+	a3ui32 hash, slot;
+	if (reflection && uniformName && *uniformName)
+	{
+		hash = a3shaderReflectInternalHash(uniformName);
+		for (slot = hash % a3shaderReflect_slotMax;
+			reflection->slot[slot];
+			slot = (slot + 1) % a3shaderReflect_slotMax)
+		{
+			entry = reflection->uniform + reflection->slot[slot] - 1;
+			if (entry->hash == hash && !strcmp(entry->name, uniformName))
+				return entry;
+		}
+	}
+	return 0;
+}
+
+a3ret a3shaderProgramReflectionGetLocation(const a3_ShaderProgramReflection *reflection, const a3byte *uniformName)
+{
+	const a3_ShaderProgramReflectEntry *const entry = a3shaderProgramReflectionGetUniform(reflection, uniformName);
+	return (entry ? entry->location : -1);
+}
+
+a3ret a3shaderProgramReflectionGetBlock(const a3_ShaderProgramReflection *reflection, const a3byte *blockName)
+{
+	const a3_ShaderProgramReflectEntry *entry, *end;
+	a3ui32 hash;
+	if (reflection && blockName && *blockName)
+	{
+		// few blocks; compare hashes first
+		hash = a3shaderReflectInternalHash(blockName);
+		for (entry = reflection->block, end = entry + reflection->blockCount; entry < end; ++entry)
+			if (entry->hash == hash && !strcmp(entry->name, blockName))
+				return entry->location;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3shaderProgramReflectionSaveFile(const a3_ShaderProgramReflection *reflection, const a3byte *filePath)
+{
+	FILE *fp;
+	a3_ShaderProgramReflectionFileHeader header;
+	a3ret ret = 0;
+	if (reflection && filePath && *filePath)
+	{
+		fp = fopen(filePath, "wb");
+		if (fp)
+		{
+			memcpy(header.identifier, a3shaderProgramReflectionIdentifier, sizeof(header.identifier));
+			header.size = sizeof(a3_ShaderProgramReflection);
+			ret = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+				fwrite(reflection, sizeof(a3_ShaderProgramReflection), 1, fp) == 1;
+			fclose(fp);
+		}
+		return ret;
+	}
+	return -1;
+}
+
+a3ret a3shaderProgramReflectionLoadFile(a3_ShaderProgramReflection *reflection_out, const a3byte *filePath)
+{
+	FILE *fp;
+	a3_ShaderProgramReflectionFileHeader header;
+	a3ui32 i;
+	a3ret ret = 0;
+	if (reflection_out && filePath && *filePath)
+	{
+		fp = fopen(filePath, "rb");
+		if (fp)
+		{
+			ret = fread(&header, sizeof(header), 1, fp) == 1 &&
+				!memcmp(header.identifier, a3shaderProgramReflectionIdentifier, sizeof(header.identifier)) &&
+				header.size == sizeof(a3_ShaderProgramReflection) &&
+				fread(reflection_out, sizeof(a3_ShaderProgramReflection), 1, fp) == 1 &&
+				reflection_out->uniformCount <= a3shaderReflect_uniformMax &&
+				reflection_out->blockCount <= a3shaderReflect_blockMax;
+			for (i = 0; i < a3shaderReflect_slotMax && ret; ++i)
+				ret = reflection_out->slot[i] <= reflection_out->uniformCount;
+			fclose(fp);
+			if (!ret)
+				memset(reflection_out, 0, sizeof(a3_ShaderProgramReflection));
+		}
+		return ret;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,336 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_Skinning.c
+	Definitions for skinning functions shared by all back ends: skeleton
+		and palette solving, influence packing and CPU reference skinning.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_Skinning.h"
+
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// internal utilities
+
+// value of a packed weight of one
+#define a3skinInternalWeightOne	65535u
+
+
+// column-major product: m_out = mL * mR (output may not alias inputs)
+inline void a3skinInternalConcat(a3f32 *m_out, const a3f32 *mL, const a3f32 *mR)
+{
+	a3ui32 c, r;
+	for (c = 0; c < 4; ++c)
+		for (r = 0; r < 4; ++r)
+			m_out[c * 4 + r] = mL[r] * mR[c * 4] + mL[4 + r] * mR[c * 4 + 1] + mL[8 + r] * mR[c * 4 + 2] + mL[12 + r] * mR[c * 4 + 3];
+}
+
+// inverse of a rigid transform: transposed rotation, rotated negative
+//	translation
+inline void a3skinInternalInvertRigid(a3f32 *m_out, const a3f32 *m)
+{
+	a3ui32 c, r;
+	for (c = 0; c < 3; ++c)
+	{
+		for (r = 0; r < 3; ++r)
+			m_out[c * 4 + r] = m[r * 4 + c];
+		m_out[c * 4 + 3] = 0.0f;
+	}
+	for (r = 0; r < 3; ++r)
+		m_out[12 + r] = -(m[r * 4] * m[12] + m[r * 4 + 1] * m[13] + m[r * 4 + 2] * m[14]);
+	m_out[15] = 1.0f;
+}
+
+// rigid transform to dual quaternion; element (row r, column c) is m[c*4+r]
+inline void a3skinInternalDualQuat(a3f32 real_out[4], a3f32 dual_out[4], const a3f32 *m)
+{
+	const a3f32 trace = m[0] + m[5] + m[10];
+	const a3f32 *t = m + 12;
+	a3f32 s;
+	if (trace > 0.0f)
+	{
+		s = sqrtf(trace + 1.0f) * 2.0f;
+		real_out[0] = (m[6] - m[9]) / s;
+		real_out[1] = (m[8] - m[2]) / s;
+		real_out[2] = (m[1] - m[4]) / s;
+		real_out[3] = 0.25f * s;
+	}
+	else if (m[0] > m[5] && m[0] > m[10])
+	{
+		s = sqrtf(1.0f + m[0] - m[5] - m[10]) * 2.0f;
+		real_out[0] = 0.25f * s;
+		real_out[1] = (m[4] + m[1]) / s;
+		real_out[2] = (m[8] + m[2]) / s;
+		real_out[3] = (m[6] - m[9]) / s;
+	}
+	else if (m[5] > m[10])
+	{
+		s = sqrtf(1.0f + m[5] - m[0] - m[10]) * 2.0f;
+		real_out[0] = (m[4] + m[1]) / s;
+		real_out[1] = 0.25f * s;
+		real_out[2] = (m[9] + m[6]) / s;
+		real_out[3] = (m[8] - m[2]) / s;
+	}
+	else
+	{
+		s = sqrtf(1.0f + m[10] - m[0] - m[5]) * 2.0f;
+		real_out[0] = (m[8] + m[2]) / s;
+		real_out[1] = (m[9] + m[6]) / s;
+		real_out[2] = 0.25f * s;
+		real_out[3] = (m[1] - m[4]) / s;
+	}
+
+	// dual = (t, 0) * real / 2
+	dual_out[0] = 0.5f * (t[0] * real_out[3] + t[1] * real_out[2] - t[2] * real_out[1]);
+	dual_out[1] = 0.5f * (t[1] * real_out[3] + t[2] * real_out[0] - t[0] * real_out[2]);
+	dual_out[2] = 0.5f * (t[2] * real_out[3] + t[0] * real_out[1] - t[1] * real_out[0]);
+	dual_out[3] = -0.5f * (t[0] * real_out[0] + t[1] * real_out[1] + t[2] * real_out[2]);
+}
+
+// cross product
+inline void a3skinInternalCross(a3f32 v_out[3], const a3f32 *a, const a3f32 *b)
+{
+	v_out[0] = a[1] * b[2] - a[2] * b[1];
+	v_out[1] = a[2] * b[0] - a[0] * b[2];
+	v_out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+// rotate vector by unit quaternion: v + 2 q x (q x v + w v)
+inline void a3skinInternalRotate(a3f32 v_out[3], const a3f32 q[4], const a3f32 *v)
+{
+	a3f32 a[3], b[3];
+	a3skinInternalCross(a, q, v);
+	a[0] += q[3] * v[0];
+	a[1] += q[3] * v[1];
+	a[2] += q[3] * v[2];
+	a3skinInternalCross(b, q, a);
+	v_out[0] = v[0] + 2.0f * b[0];
+	v_out[1] = v[1] + 2.0f * b[1];
+	v_out[2] = v[2] + 2.0f * b[2];
+}
+
+// renormalize normal; degenerate normals are kept
+inline void a3skinInternalNormalize(a3f32 v[3])
+{
+	a3f32 lenSq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+	if (lenSq > 0.0f)
+	{
+		lenSq = 1.0f / sqrtf(lenSq);
+		v[0] *= lenSq;
+		v[1] *= lenSq;
+		v[2] *= lenSq;
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3skeletonCreate(a3_Skeleton *skeleton_out, const a3i32 *parentIndex, const a3f32 *bindLocal, const a3ui32 jointCount)
+{
+	a3f32 bindWorld[a3skin_jointMax][16];
+	a3ui32 j;
+	if (skeleton_out && parentIndex && bindLocal && jointCount && jointCount <= a3skin_jointMax)
+	{
+		if (!skeleton_out->jointCount)
+		{
+			// hierarchy must be sorted so that parents are solved first
+			for (j = 0; j < jointCount; ++j)
+				if (parentIndex[j] >= (a3i32)j || parentIndex[j] < -1)
+					return -1;
+
+			for (j = 0; j < jointCount; ++j)
+			{
+				if (parentIndex[j] < 0)
+					memcpy(bindWorld[j], bindLocal + j * 16, sizeof(*bindWorld));
+				else
+					a3skinInternalConcat(bindWorld[j], bindWorld[parentIndex[j]], bindLocal + j * 16);
+				a3skinInternalInvertRigid(skeleton_out->bindInverse[j], bindWorld[j]);
+				memcpy(skeleton_out->bindLocal[j], bindLocal + j * 16, sizeof(*bindWorld));
+				skeleton_out->parentIndex[j] = parentIndex[j];
+			}
+			skeleton_out->jointCount = jointCount;
+			return jointCount;
+		}
+	}
+	return -1;
+}
+
+a3ret a3skeletonSolvePalette(const a3_Skeleton *skeleton, a3f32(*palette_out)[4], const a3f32 *localPose, const a3f32 *root_opt, const a3_SkinningMethod method)
+{
+	a3f32 world[a3skin_jointMax][16], skin[16];
+	a3ui32 j, r;
+	if (skeleton && skeleton->jointCount && palette_out && localPose && (method == a3skin_linear || method == a3skin_dualQuat))
+	{
+		for (j = 0; j < skeleton->jointCount; ++j, palette_out += method)
+		{
+			if (skeleton->parentIndex[j] >= 0)
+				a3skinInternalConcat(world[j], world[skeleton->parentIndex[j]], localPose + j * 16);
+			else if (root_opt)
+				a3skinInternalConcat(world[j], root_opt, localPose + j * 16);
+			else
+				memcpy(world[j], localPose + j * 16, sizeof(*world));
+			a3skinInternalConcat(skin, world[j], skeleton->bindInverse[j]);
+
+			// rows of the 3x4 affine part, or rotation and translation
+			if (method == a3skin_linear)
+				for (r = 0; r < 3; ++r)
+				{
+					palette_out[r][0] = skin[r];
+					palette_out[r][1] = skin[4 + r];
+					palette_out[r][2] = skin[8 + r];
+					palette_out[r][3] = skin[12 + r];
+				}
+			else
+				a3skinInternalDualQuat(palette_out[0], palette_out[1], skin);
+		}
+		return skeleton->jointCount;
+	}
+	return -1;
+}
+
+a3ret a3skinPackInfluences(a3ubyte(*index_out)[4], a3ui16(*weight_out)[4], const a3f32 *weight, const a3i32 *index, const a3ui32 count)
+{
+	a3f32 w[a3skin_influenceMax], sum;
+	a3ui32 i, k, largest, total;
+	a3ret unweighted = 0;
+	if (index_out && weight_out && weight && index)
+	{
+		for (i = 0; i < count; ++i, ++index_out, ++weight_out, weight += a3skin_influenceMax, index += a3skin_influenceMax)
+		{
+			// out-of-range joints and negative weights do not contribute
+			for (k = 0, sum = 0.0f; k < a3skin_influenceMax; ++k)
+			{
+				w[k] = (index[k] >= 0 && index[k] < a3skin_jointMax && weight[k] > 0.0f) ? weight[k] : 0.0f;
+				index_out[0][k] = (a3ubyte)(w[k] > 0.0f ? index[k] : 0);
+				sum += w[k];
+			}
+			if (sum <= 0.0f)
+			{
+				memset(index_out[0], 0, sizeof(*index_out));
+				memset(weight_out[0], 0, sizeof(*weight_out));
+				weight_out[0][0] = a3skinInternalWeightOne;
+				++unweighted;
+				continue;
+			}
+
+			// round each fraction, then give the residual to the largest so
+			//	the weights sum to exactly one after decoding
+			for (k = 0, largest = 0, total = 0; k < a3skin_influenceMax; ++k)
+			{
+				weight_out[0][k] = (a3ui16)(w[k] / sum * (a3f32)a3skinInternalWeightOne + 0.5f);
+				total += weight_out[0][k];
+				if (w[k] > w[largest])
+					largest = k;
+			}
+			weight_out[0][largest] = (a3ui16)((a3i32)weight_out[0][largest] + (a3i32)a3skinInternalWeightOne - (a3i32)total);
+		}
+		return unweighted;
+	}
+	return -1;
+}
+
+a3ret a3skinDeform(const a3f32(*palette)[4], const a3_SkinningMethod method, const a3ubyte(*index)[4], const a3ui16(*weight)[4], const a3f32(*position)[3], const a3f32(*normal_opt)[3], a3f32(*position_out)[3], a3f32(*normal_out_opt)[3], const a3ui32 count)
+{
+	const a3boolean doNormal = normal_opt && normal_out_opt;
+	const a3f32(*joint)[4];
+	a3f32 row[3][4], real[4], dual[4], t[3], w, s, len;
+	a3ui32 i, k, r;
+	if (palette && index && weight && position && position_out && (method == a3skin_linear || method == a3skin_dualQuat))
+	{
+		for (i = 0; i < count; ++i)
+		{
+			if (method == a3skin_linear)
+			{
+				// blend matrix rows, then transform once
+				memset(row, 0, sizeof(row));
+				for (k = 0; k < a3skin_influenceMax; ++k)
+					if (weight[i][k])
+					{
+						w = (a3f32)weight[i][k] / (a3f32)a3skinInternalWeightOne;
+						joint = palette + index[i][k] * a3skin_linear;
+						for (r = 0; r < 3; ++r)
+						{
+							row[r][0] += w * joint[r][0];
+							row[r][1] += w * joint[r][1];
+							row[r][2] += w * joint[r][2];
+							row[r][3] += w * joint[r][3];
+						}
+					}
+				for (r = 0; r < 3; ++r)
+					position_out[i][r] = row[r][0] * position[i][0] + row[r][1] * position[i][1] + row[r][2] * position[i][2] + row[r][3];
+				if (doNormal)
+				{
+					for (r = 0; r < 3; ++r)
+						normal_out_opt[i][r] = row[r][0] * normal_opt[i][0] + row[r][1] * normal_opt[i][1] + row[r][2] * normal_opt[i][2];
+					a3skinInternalNormalize(normal_out_opt[i]);
+				}
+			}
+			else
+			{
+				// blend in the hemisphere of the first influence
+				memset(real, 0, sizeof(real));
+				memset(dual, 0, sizeof(dual));
+				for (k = 0; k < a3skin_influenceMax; ++k)
+					if (weight[i][k])
+					{
+						w = (a3f32)weight[i][k] / (a3f32)a3skinInternalWeightOne;
+						joint = palette + index[i][k] * a3skin_dualQuat;
+						s = palette[index[i][0] * a3skin_dualQuat][0] * joint[0][0] + palette[index[i][0] * a3skin_dualQuat][1] * joint[0][1]
+							+ palette[index[i][0] * a3skin_dualQuat][2] * joint[0][2] + palette[index[i][0] * a3skin_dualQuat][3] * joint[0][3];
+						w = s < 0.0f ? -w : w;
+						for (r = 0; r < 4; ++r)
+						{
+							real[r] += w * joint[0][r];
+							dual[r] += w * joint[1][r];
+						}
+					}
+				len = sqrtf(real[0] * real[0] + real[1] * real[1] + real[2] * real[2] + real[3] * real[3]);
+				len = len > 0.0f ? 1.0f / len : 0.0f;
+				for (r = 0; r < 4; ++r)
+				{
+					real[r] *= len;
+					dual[r] *= len;
+				}
+
+				// translation = 2 * (w d - dw r + r x d)
+				a3skinInternalCross(t, real, dual);
+				for (r = 0; r < 3; ++r)
+					t[r] = 2.0f * (real[3] * dual[r] - dual[3] * real[r] + t[r]);
+				a3skinInternalRotate(position_out[i], real, position[i]);
+				position_out[i][0] += t[0];
+				position_out[i][1] += t[1];
+				position_out[i][2] += t[2];
+				if (doNormal)
+				{
+					a3skinInternalRotate(normal_out_opt[i], real, normal_opt[i]);
+					a3skinInternalNormalize(normal_out_opt[i]);
+				}
+			}
+		}
+		return count;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,707 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_TextureAtlasPacker.c
+	Texture atlas packing and baking.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_TextureAtlasPacker.h"
+#include "animal3D-A3DG/a3graphics/a3_TextureDecoder.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else	// !_WIN32
+#include <dirent.h>
+#endif	// _WIN32
+
+
+//-----------------------------------------------------------------------------
+
+// free rectangle in packing grid (units of alignment)
+typedef struct a3_TextureAtlasPackerRect
+{
+	a3ui32 x, y, w, h;
+} a3_TextureAtlasPackerRect;
+
+// packing order key
+typedef struct a3_TextureAtlasPackerSortKey
+{
+	a3ui32 longSide, area, index;
+} a3_TextureAtlasPackerSortKey;
+
+// list of free rectangles
+typedef struct a3_TextureAtlasPackerFreeList
+{
+	a3_TextureAtlasPackerRect *rect;
+	a3ui32 count, capacity;
+} a3_TextureAtlasPackerFreeList;
+
+
+//-----------------------------------------------------------------------------
+// packing
+
+inline a3boolean a3textureAtlasPackerInternalFreeListPush(a3_TextureAtlasPackerFreeList *list, const a3ui32 x, const a3ui32 y, const a3ui32 w, const a3ui32 h)
+{
+	a3_TextureAtlasPackerRect *rect;
+	if (list->count == list->capacity)
+	{
+		rect = (a3_TextureAtlasPackerRect *)realloc(list->rect, sizeof(a3_TextureAtlasPackerRect) * (list->capacity * 2 + 16));
+		if (!rect)
+			return 0;
+		list->rect = rect;
+		list->capacity = list->capacity * 2 + 16;
+	}
+	rect = list->rect + list->count++;
+	rect->x = x;
+	rect->y = y;
+	rect->w = w;
+	rect->h = h;
+	return 1;
+}
+
+// find free rectangle that leaves the smallest leftover on its short side
+inline a3i32 a3textureAtlasPackerInternalFindBestShortSide(const a3_TextureAtlasPackerFreeList *list, const a3ui32 w, const a3ui32 h)
+{
+	a3ui32 i, shortSide, longSide, bestShort = 0xFFFFFFFF, bestLong = 0xFFFFFFFF, dw, dh;
+	a3i32 best = -1;
+	for (i = 0; i < list->count; ++i)
+	{
+		if (list->rect[i].w >= w && list->rect[i].h >= h)
+		{
+			dw = list->rect[i].w - w;
+			dh = list->rect[i].h - h;
+			shortSide = dw < dh ? dw : dh;
+			longSide = dw < dh ? dh : dw;
+			if (shortSide < bestShort || (shortSide == bestShort && longSide < bestLong))
+			{
+				bestShort = shortSide;
+				bestLong = longSide;
+				best = (a3i32)i;
+			}
+		}
+	}
+	return best;
+}
+
+// split every free rectangle overlapping the placed one into up to four
+//	maximal rectangles around it, then drop rectangles contained in others
+inline a3boolean a3textureAtlasPackerInternalPlace(a3_TextureAtlasPackerFreeList *list, const a3_TextureAtlasPackerRect *placed)
+{
+	const a3ui32 count = list->count;
+	a3_TextureAtlasPackerRect rect;
+	a3ui32 i, j;
+	a3boolean ok = 1;
+	for (i = 0; i < count && ok; ++i)
+	{
+		rect = list->rect[i];
+		if (placed->x < rect.x + rect.w && placed->x + placed->w > rect.x &&
+			placed->y < rect.y + rect.h && placed->y + placed->h > rect.y)
+		{
+			// mark split rectangle for removal
+			list->rect[i].w = 0;
+			if (placed->x > rect.x)
+				ok = ok && a3textureAtlasPackerInternalFreeListPush(list, rect.x, rect.y, placed->x - rect.x, rect.h);
+			if (placed->x + placed->w < rect.x + rect.w)
+				ok = ok && a3textureAtlasPackerInternalFreeListPush(list, placed->x + placed->w, rect.y, rect.x + rect.w - placed->x - placed->w, rect.h);
+			if (placed->y > rect.y)
+				ok = ok && a3textureAtlasPackerInternalFreeListPush(list, rect.x, rect.y, rect.w, placed->y - rect.y);
+			if (placed->y + placed->h < rect.y + rect.h)
+				ok = ok && a3textureAtlasPackerInternalFreeListPush(list, rect.x, placed->y + placed->h, rect.w, rect.y + rect.h - placed->y - placed->h);
+		}
+	}
+
+	// remove split and contained rectangles
+	for (i = 0; i < list->count; ++i)
+	{
+		for (j = 0; j < list->count && list->rect[i].w; ++j)
+		{
+			if (i != j && list->rect[j].w &&
+				list->rect[i].x >= list->rect[j].x && list->rect[i].y >= list->rect[j].y &&
+				list->rect[i].x + list->rect[i].w <= list->rect[j].x + list->rect[j].w &&
+				list->rect[i].y + list->rect[i].h <= list->rect[j].y + list->rect[j].h &&
+				(list->rect[i].x != list->rect[j].x || list->rect[i].y != list->rect[j].y ||
+					list->rect[i].w != list->rect[j].w || list->rect[i].h != list->rect[j].h || i > j))
+				list->rect[i].w = 0;
+		}
+	}
+	for (i = j = 0; i < list->count; ++i)
+		if (list->rect[i].w)
+			list->rect[j++] = list->rect[i];
+	list->count = j;
+	return ok;
+}
+
+// pack slots (in grid units) into an atlas of the given grid size, largest
+//	first; returns number placed
+inline a3ui32 a3textureAtlasPackerInternalPackGrid(a3_TextureAtlasPacker *packer, const a3ui32 *order, const a3ui32 gridW, const a3ui32 gridH)
+{
+	a3_TextureAtlasPackerFreeList list[1] = { 0 };
+	a3_TextureAtlasPackerRect placed;
+	a3_TextureAtlasPackerEntry *entry;
+	a3ui32 i, count = 0;
+	a3i32 best;
+	for (i = 0; i < packer->entryCount; ++i)
+		packer->entry[i].slotX = packer->entry[i].slotY = 0xFFFFFFFF;
+	if (a3textureAtlasPackerInternalFreeListPush(list, 0, 0, gridW, gridH))
+	{
+		for (i = 0; i < packer->entryCount; ++i)
+		{
+			entry = packer->entry + order[i];
+			placed.w = entry->slotW / packer->alignment;
+			placed.h = entry->slotH / packer->alignment;
+			best = a3textureAtlasPackerInternalFindBestShortSide(list, placed.w, placed.h);
+			if (best >= 0)
+			{
+				placed.x = list->rect[best].x;
+				placed.y = list->rect[best].y;
+				if (!a3textureAtlasPackerInternalPlace(list, &placed))
+					break;
+				entry->slotX = placed.x * packer->alignment;
+				entry->slotY = placed.y * packer->alignment;
+				++count;
+			}
+		}
+		free(list->rect);
+	}
+	return count;
+}
+
+// packing order: larger long side first, then larger area, then index
+int a3textureAtlasPackerInternalCompareSlots(const void *a, const void *b)
+{
+	const a3_TextureAtlasPackerSortKey *ka = (const a3_TextureAtlasPackerSortKey *)a, *kb = (const a3_TextureAtlasPackerSortKey *)b;
+	if (ka->longSide != kb->longSide)
+		return ka->longSide > kb->longSide ? -1 : 1;
+	if (ka->area != kb->area)
+		return ka->area > kb->area ? -1 : 1;
+	return ka->index < kb->index ? -1 : 1;
+}
+
+
+//-----------------------------------------------------------------------------
+// baking
+
+// fill slot with image, repeating edge pixels across the gutter
+inline void a3textureAtlasPackerInternalBakeSlot(a3ubyte *atlas, const a3ui32 atlasWidth, const a3_TextureAtlasPackerEntry *entry, const a3ui32 padding)
+{
+	const a3ui32 rowSize = entry->width * 4;
+	const a3ui32 right = padding + entry->width;
+	a3ubyte *dst;
+	const a3ubyte *src;
+	a3ui32 x, y, srcY;
+	for (y = 0; y < entry->slotH; ++y)
+	{
+		srcY = y < padding ? 0 : y - padding < entry->height ? y - padding : entry->height - 1;
+		src = entry->pixels + srcY * rowSize;
+		dst = atlas + ((entry->slotY + y) * atlasWidth + entry->slotX) * 4;
+		for (x = 0; x < padding; ++x, dst += 4)
+			memcpy(dst, src, 4);
+		memcpy(dst, src, rowSize);
+		dst += rowSize;
+		for (x = right; x < entry->slotW; ++x, dst += 4)
+			memcpy(dst, src + rowSize - 4, 4);
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+// files
+
+// convert decoded image to rgba8
+inline a3ubyte *a3textureAtlasPackerInternalConvertRGBA8(const a3_TextureStreamImage *image)
+{
+	const a3ui32 count = image->width * image->height;
+	a3ubyte *ret = (a3ubyte *)malloc(count * 4), *dst = ret;
+	const a3ubyte *src8 = (const a3ubyte *)image->pixels;
+	const a3ui16 *src16 = (const a3ui16 *)image->pixels;
+	a3ui32 i, c;
+	if (ret)
+	{
+		for (i = 0; i < count; ++i, dst += 4)
+		{
+			for (c = 0; c < image->channels; ++c)
+				dst[c] = image->bytes == 2 ? (a3ubyte)(*(src16++) >> 8) : *(src8++);
+			for (; c < 4; ++c)
+				dst[c] = 0xFF;
+		}
+	}
+	return ret;
+}
+
+// copy file name without directory or extension
+inline void a3textureAtlasPackerInternalGetName(a3byte *name_out, const a3byte *filePath)
+{
+	const a3byte *start = filePath, *end, *ptr;
+	a3ui32 len;
+	for (ptr = filePath; *ptr; ++ptr)
+		if (*ptr == '/' || *ptr == '\\')
+			start = ptr + 1;
+	end = strrchr(start, '.');
+	if (!end)
+		end = ptr;
+	len = (a3ui32)(end - start);
+	if (len >= a3textureAtlasPacker_nameLength)
+		len = a3textureAtlasPacker_nameLength - 1;
+	memcpy(name_out, start, len);
+	name_out[len] = 0;
+}
+
+// check for supported extension
+inline a3boolean a3textureAtlasPackerInternalIsImageFile(const a3byte *fileName)
+{
+	const a3byte *ext = strrchr(fileName, '.');
+	return ext && (!strcmp(ext, ".png") || !strcmp(ext, ".PNG") || !strcmp(ext, ".tga") || !strcmp(ext, ".TGA"));
+}
+
+int a3textureAtlasPackerInternalCompareNames(const void *a, const void *b)
+{
+	return strcmp(*(const a3byte *const *)a, *(const a3byte *const *)b);
+}
+
+// append copy of file name to list
+inline a3boolean a3textureAtlasPackerInternalAppendName(a3byte ***names, a3ui32 *count, a3ui32 *capacity, const a3byte *fileName)
+{
+	const a3ui32 len = (a3ui32)strlen(fileName) + 1;
+	a3byte **tmp;
+	if (*count == *capacity)
+	{
+		tmp = (a3byte **)realloc(*names, sizeof(a3byte *) * (*capacity * 2 + 16));
+		if (!tmp)
+			return 0;
+		*names = tmp;
+		*capacity = *capacity * 2 + 16;
+	}
+	(*names)[*count] = (a3byte *)malloc(len);
+	if (!(*names)[*count])
+		return 0;
+	memcpy((*names)[(*count)++], fileName, len);
+	return 1;
+}
+
+// list image files in directory; returns count
+inline a3ui32 a3textureAtlasPackerInternalListDirectory(a3byte ***names_out, const a3byte *directoryPath)
+{
+	a3byte **names = 0;
+	a3ui32 count = 0, capacity = 0;
+	a3boolean ok = 1;
+#ifdef _WIN32
+	WIN32_FIND_DATAA data;
+	HANDLE find;
+	a3byte pattern[512];
+	const a3i32 patternLen = snprintf(pattern, sizeof(pattern), "%s/*", directoryPath);
+	find = (patternLen > 0 && patternLen < (a3i32)sizeof(pattern))
+		? FindFirstFileA(pattern, &data) : INVALID_HANDLE_VALUE;
+	if (find != INVALID_HANDLE_VALUE)
+	{
+		do
+		{
+			if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && a3textureAtlasPackerInternalIsImageFile(data.cFileName))
+				ok = a3textureAtlasPackerInternalAppendName(&names, &count, &capacity, data.cFileName);
+		} while (ok && FindNextFileA(find, &data));
+		FindClose(find);
+	}
+#else	// !_WIN32
+	struct dirent *data;
+	DIR *find = opendir(directoryPath);
+	if (find)
+	{
+		while (ok && (data = readdir(find)) != 0)
+		{
+			if (a3textureAtlasPackerInternalIsImageFile(data->d_name))
+				ok = a3textureAtlasPackerInternalAppendName(&names, &count, &capacity, data->d_name);
+		}
+		closedir(find);
+	}
+#endif	// _WIN32
+
+	// directory order is not defined; sort so cell indices are stable
+	if (count)
+		qsort(names, count, sizeof(a3byte *), a3textureAtlasPackerInternalCompareNames);
+	*names_out = names;
+	return count;
+}
+
+
+// append run-length encoded row of rgba8 pixels as BGRA packets
+inline a3ui32 a3textureAtlasPackerInternalEncodeRowTGA(a3ubyte *out, const a3ubyte *row, const a3ui32 width)
+{
+	a3ubyte *const start = out;
+	a3ui32 i = 0, run, raw;
+	while (i < width)
+	{
+		// length of repeat starting here
+		for (run = 1; i + run < width && run < 128 && !memcmp(row + (i + run) * 4, row + i * 4, 4); ++run);
+		if (run > 1)
+		{
+			*(out++) = (a3ubyte)(0x80 | (run - 1));
+			*(out++) = row[i * 4 + 2];
+			*(out++) = row[i * 4 + 1];
+			*(out++) = row[i * 4 + 0];
+			*(out++) = row[i * 4 + 3];
+			i += run;
+		}
+		else
+		{
+			// raw pixels until the next repeat
+			for (raw = 1; i + raw < width && raw < 128 &&
+				(i + raw + 1 >= width || memcmp(row + (i + raw + 1) * 4, row + (i + raw) * 4, 4)); ++raw);
+			*(out++) = (a3ubyte)(raw - 1);
+			for (run = 0; run < raw; ++run, ++i)
+			{
+				*(out++) = row[i * 4 + 2];
+				*(out++) = row[i * 4 + 1];
+				*(out++) = row[i * 4 + 0];
+				*(out++) = row[i * 4 + 3];
+			}
+		}
+	}
+	return (a3ui32)(out - start);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3textureAtlasPackerCreate(a3_TextureAtlasPacker *packer_out, const a3ui32 widthMax, const a3ui32 heightMax, const a3ui32 padding, const a3ui32 mipLevelsSafe)
+{
+	if (packer_out && widthMax && heightMax && !(widthMax & (widthMax - 1)) && !(heightMax & (heightMax - 1)) && mipLevelsSafe <= a3textureAtlasPacker_mipLevelsMax)
+	{
+		if (!packer_out->entry && !packer_out->pixels)
+		{
+			memset(packer_out, 0, sizeof(a3_TextureAtlasPacker));
+			packer_out->widthMax = widthMax;
+			packer_out->heightMax = heightMax;
+			packer_out->padding = padding;
+			packer_out->alignment = 1 << mipLevelsSafe;
+			return 1;
+		}
+	}
+	return -1;
+}
+
+a3ret a3textureAtlasPackerAddImage(a3_TextureAtlasPacker *packer, const a3byte *name_opt, const a3ubyte *pixels, const a3ui32 width, const a3ui32 height)
+{
+	if (packer && packer->alignment && pixels && width && height)
+	{
+		a3_TextureAtlasPackerEntry *entry;
+		const a3ui32 size = width * height * 4;
+		if (packer->entryCount == packer->entryCapacity)
+		{
+			entry = (a3_TextureAtlasPackerEntry *)realloc(packer->entry, sizeof(a3_TextureAtlasPackerEntry) * (packer->entryCapacity * 2 + 16));
+			if (!entry)
+				return -1;
+			packer->entry = entry;
+			packer->entryCapacity = packer->entryCapacity * 2 + 16;
+		}
+		entry = packer->entry + packer->entryCount;
+		memset(entry, 0, sizeof(a3_TextureAtlasPackerEntry));
+		entry->pixels = (a3ubyte *)malloc(size);
+		if (entry->pixels)
+		{
+			memcpy(entry->pixels, pixels, size);
+			entry->width = width;
+			entry->height = height;
+			if (name_opt)
+				strncpy(entry->name, name_opt, a3textureAtlasPacker_nameLength - 1);
+			else
+				sprintf(entry->name, "cell%u", packer->entryCount);
+			return (packer->entryCount++);
+		}
+	}
+	return -1;
+}
+
+a3ret a3textureAtlasPackerAddFile(a3_TextureAtlasPacker *packer, const a3byte *filePath)
+{
+	if (packer && packer->alignment && filePath && *filePath)
+	{
+		a3_TextureStreamImage image[1] = { 0 };
+		a3byte name[a3textureAtlasPacker_nameLength];
+		a3ubyte *pixels;
+		a3ret ret = -1;
+		if (a3textureDecodeFile(image, filePath) > 0)
+		{
+			pixels = a3textureAtlasPackerInternalConvertRGBA8(image);
+			if (pixels)
+			{
+				a3textureAtlasPackerInternalGetName(name, filePath);
+				ret = a3textureAtlasPackerAddImage(packer, name, pixels, image->width, image->height);
+				free(pixels);
+			}
+			a3textureDecodeRelease(image);
+		}
+		else
+			printf("\n A3 Warning: \n\t Atlas source image \'%s\' could not be decoded.", filePath);
+		return ret;
+	}
+	return -1;
+}
+
+a3ret a3textureAtlasPackerAddDirectory(a3_TextureAtlasPacker *packer, const a3byte *directoryPath)
+{
+	if (packer && packer->alignment && directoryPath && *directoryPath)
+	{
+		a3byte **names = 0;
+		a3byte filePath[512];
+		const a3ui32 count = a3textureAtlasPackerInternalListDirectory(&names, directoryPath);
+		a3ui32 i;
+		a3ret ret = 0;
+		for (i = 0; i < count; ++i)
+		{
+			snprintf(filePath, sizeof(filePath), "%s/%s", directoryPath, names[i]);
+			ret += a3textureAtlasPackerAddFile(packer, filePath) >= 0;
+			free(names[i]);
+		}
+		free(names);
+		return ret;
+	}
+	return -1;
+}
+
+a3ret a3textureAtlasPackerPack(a3_TextureAtlasPacker *packer)
+{
+	if (packer && packer->alignment && packer->entryCount)
+	{
+		a3_TextureAtlasPackerEntry *entry;
+		a3_TextureAtlasPackerSortKey *key = (a3_TextureAtlasPackerSortKey *)malloc(sizeof(a3_TextureAtlasPackerSortKey) * packer->entryCount);
+		a3ui32 *order = (a3ui32 *)malloc(sizeof(a3ui32) * packer->entryCount);
+		const a3ui32 alignMask = packer->alignment - 1;
+		a3ui32 i, w, h, count, slotWMax = 0, slotHMax = 0;
+		a3f64 area = 0.0;
+		if (!key || !order)
+		{
+			free(key);
+			free(order);
+			return -1;
+		}
+
+		// slot sizes: image plus gutter on both sides, rounded up to alignment
+		for (i = 0, entry = packer->entry; i < packer->entryCount; ++i, ++entry)
+		{
+			entry->slotW = (entry->width + packer->padding * 2 + alignMask) & ~alignMask;
+			entry->slotH = (entry->height + packer->padding * 2 + alignMask) & ~alignMask;
+			slotWMax = entry->slotW > slotWMax ? entry->slotW : slotWMax;
+			slotHMax = entry->slotH > slotHMax ? entry->slotH : slotHMax;
+			area += (a3f64)entry->slotW * (a3f64)entry->slotH;
+			key[i].longSide = entry->slotW > entry->slotH ? entry->slotW : entry->slotH;
+			key[i].area = entry->slotW * entry->slotH;
+			key[i].index = i;
+		}
+		qsort(key, packer->entryCount, sizeof(a3_TextureAtlasPackerSortKey), a3textureAtlasPackerInternalCompareSlots);
+		for (i = 0; i < packer->entryCount; ++i)
+			order[i] = key[i].index;
+		free(key);
+
+		// smallest power-of-two atlas holding the largest slot and total area
+		for (w = packer->alignment; w < slotWMax && w < packer->widthMax; w *= 2);
+		for (h = packer->alignment; h < slotHMax && h < packer->heightMax; h *= 2);
+		while ((a3f64)w * (a3f64)h < area && (w < packer->widthMax || h < packer->heightMax))
+		{
+			if ((w <= h && w < packer->widthMax) || h >= packer->heightMax)
+				w *= 2;
+			else
+				h *= 2;
+		}
+
+		// grow alternately until everything fits or size is maxed
+		count = a3textureAtlasPackerInternalPackGrid(packer, order, w / packer->alignment, h / packer->alignment);
+		while (count < packer->entryCount && (w < packer->widthMax || h < packer->heightMax))
+		{
+			if ((w <= h && w < packer->widthMax) || h >= packer->heightMax)
+				w *= 2;
+			else
+				h *= 2;
+			count = a3textureAtlasPackerInternalPackGrid(packer, order, w / packer->alignment, h / packer->alignment);
+		}
+		free(order);
+
+		// bake
+		free(packer->pixels);
+		packer->pixels = (a3ubyte *)malloc(w * h * 4);
+		if (!packer->pixels)
+		{
+			printf("\n A3 ERROR: \n\t Could not allocate atlas (%u x %u).", w, h);
+			packer->packedCount = 0;
+			return 0;
+		}
+		memset(packer->pixels, 0, w * h * 4);
+		packer->width = w;
+		packer->height = h;
+		packer->packedCount = count;
+		for (i = 0, entry = packer->entry; i < packer->entryCount; ++i, ++entry)
+		{
+			if (entry->slotX != 0xFFFFFFFF)
+				a3textureAtlasPackerInternalBakeSlot(packer->pixels, w, entry, packer->padding);
+			else
+			{
+				entry->slotX = entry->slotY = entry->slotW = entry->slotH = 0;
+				printf("\n A3 Warning: \n\t Atlas image \'%s\' does not fit in %u x %u.", entry->name, packer->widthMax, packer->heightMax);
+			}
+		}
+		return count;
+	}
+	return -1;
+}
+
+a3ret a3textureAtlasPackerFindImage(const a3_TextureAtlasPacker *packer, const a3byte *name)
+{
+	if (packer && name)
+	{
+		a3ui32 i;
+		for (i = 0; i < packer->entryCount; ++i)
+			if (!strncmp(packer->entry[i].name, name, a3textureAtlasPacker_nameLength))
+				return i;
+	}
+	return -1;
+}
+
+a3ret a3textureAtlasPackerGetCells(a3_TextureAtlas *textureAtlas_out, const a3_TextureAtlasPacker *packer)
+{
+	if (textureAtlas_out && packer && packer->pixels)
+	{
+		if (a3textureAtlasAllocateCells(textureAtlas_out, packer->entryCount) > 0)
+		{
+			const a3f32 invW = 1.0f / (a3f32)packer->width, invH = 1.0f / (a3f32)packer->height;
+			const a3_TextureAtlasPackerEntry *entry = packer->entry;
+			a3_TextureAtlasCell *cell = textureAtlas_out->cells;
+			a3ui32 i;
+			for (i = 0; i < packer->entryCount; ++i, ++entry, ++cell)
+			{
+				if (entry->slotW)
+				{
+					cell->pixelOffset[0] = (a3i32)(entry->slotX + packer->padding);
+					cell->pixelOffset[1] = (a3i32)(entry->slotY + packer->padding);
+					cell->pixelSize[0] = (a3i32)entry->width;
+					cell->pixelSize[1] = (a3i32)entry->height;
+					cell->relativeOffset[0] = (a3f32)cell->pixelOffset[0] * invW;
+					cell->relativeOffset[1] = (a3f32)cell->pixelOffset[1] * invH;
+					cell->relativeSize[0] = (a3f32)cell->pixelSize[0] * invW;
+					cell->relativeSize[1] = (a3f32)cell->pixelSize[1] * invH;
+				}
+			}
+			return packer->entryCount;
+		}
+	}
+	return -1;
+}
+
+a3ret a3textureAtlasPackerSaveImage(const a3_TextureAtlasPacker *packer, const a3byte *filePath)
+{
+	if (packer && packer->pixels && filePath && *filePath)
+	{
+		FILE *fp = fopen(filePath, "wb");
+		a3ubyte header[18] = { 0 }, *row;
+		a3ui32 y, ret = 0;
+		if (fp)
+		{
+			// run-length encoded true color, 8 alpha bits, bottom-left origin
+			header[2] = 10;
+			header[12] = (a3ubyte)(packer->width);
+			header[13] = (a3ubyte)(packer->width >> 8);
+			header[14] = (a3ubyte)(packer->height);
+			header[15] = (a3ubyte)(packer->height >> 8);
+			header[16] = 32;
+			header[17] = 8;
+			ret += (a3ui32)fwrite(header, 1, sizeof(header), fp);
+
+			// worst case: one raw packet header per 128 pixels
+			row = (a3ubyte *)malloc(packer->width * 4 + packer->width / 128 + 1);
+			for (y = 0; y < packer->height && row; ++y)
+				ret += (a3ui32)fwrite(row, 1, a3textureAtlasPackerInternalEncodeRowTGA(row, packer->pixels + y * packer->width * 4, packer->width), fp);
+			free(row);
+			fclose(fp);
+		}
+		return ret;
+	}
+	return -1;
+}
+
+a3ret a3textureAtlasPackerSaveCells(const a3_TextureAtlasPacker *packer, const a3byte *filePath)
+{
+	if (packer && packer->pixels && filePath && *filePath)
+	{
+		a3_TextureAtlas textureAtlas[1] = { 0 };
+		a3_FileStream fileStream[1] = { 0 };
+		a3ret ret = 0;
+		if (a3textureAtlasPackerGetCells(textureAtlas, packer) > 0)
+		{
+			if (a3fileStreamOpenWrite(fileStream, filePath) > 0)
+			{
+				ret = a3textureAtlasSaveDataBinary(textureAtlas, fileStream);
+				a3fileStreamClose(fileStream);
+			}
+			a3textureAtlasRelease(textureAtlas);
+		}
+		return ret;
+	}
+	return -1;
+}
+
+a3ret a3textureAtlasPackerSaveCellsText(const a3_TextureAtlasPacker *packer, const a3byte *filePath)
+{
+	if (packer && packer->pixels && filePath && *filePath)
+	{
+		const a3_TextureAtlasPackerEntry *entry = packer->entry;
+		FILE *fp = fopen(filePath, "w");
+		a3ui32 i;
+		if (fp)
+		{
+			fprintf(fp, "# atlas %u x %u, padding %u, alignment %u\n", packer->width, packer->height, packer->padding, packer->alignment);
+			fprintf(fp, "# offsetX offsetY sizeW sizeH localX localY name\n");
+			fprintf(fp, "@%u\n", packer->entryCount);
+			for (i = 0; i < packer->entryCount; ++i, ++entry)
+			{
+				if (entry->slotW)
+					fprintf(fp, "@%u %u %u %u 0 0 %s\n", entry->slotX + packer->padding, entry->slotY + packer->padding, entry->width, entry->height, entry->name);
+				else
+					fprintf(fp, "@0 0 0 0 0 0 %s\n", entry->name);
+			}
+			fclose(fp);
+			return packer->entryCount;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3textureAtlasPackerRelease(a3_TextureAtlasPacker *packer)
+{
+	if (packer)
+	{
+		if (packer->entry || packer->pixels)
+		{
+			a3ui32 i;
+			for (i = 0; i < packer->entryCount; ++i)
+				free(packer->entry[i].pixels);
+			free(packer->entry);
+			free(packer->pixels);
+			memset(packer, 0, sizeof(a3_TextureAtlasPacker));
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,742 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_TextureCompressed.c
+	Definitions for texture mip generation, block encoding and container.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_TextureCompressed.h"
+#include "animal3D/a3/a3types_real.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+// limits and constants used by conditioning
+enum
+{
+	a3textureCompressed_tapMax = 12,
+};
+
+#define a3textureCompressedKaiserAlpha	4.0f
+#define a3textureCompressedKaiserWidth	1.5f
+
+
+// container header; each level follows as its size in bytes, then data
+typedef struct a3_TextureCompressedFileHeader
+{
+	a3ubyte identifier[8];
+	a3ui32 format;
+	a3ui32 width, height;
+	a3ui32 levelCount;
+} a3_TextureCompressedFileHeader;
+
+// identifier catches text-mode transfers (line endings) and truncation
+static const a3ubyte a3textureCompressedIdentifier[8] = { 0xAB, 'A', '3', 'T', 'C', '\r', '\n', 0x1A };
+
+
+// filter taps for one destination pixel along one axis
+typedef struct a3_TextureCompressedFilterTaps
+{
+	a3ui32 index[a3textureCompressed_tapMax];
+	a3f32 weight[a3textureCompressed_tapMax];
+	a3ui32 count;
+} a3_TextureCompressedFilterTaps;
+
+
+//-----------------------------------------------------------------------------
+// mip generation
+
+// zeroth-order modified Bessel function of the first kind (series)
+inline a3f32 a3textureCompressedInternalBesselI0(const a3f32 x)
+{
+	const a3f32 q = x * x * 0.25f;
+	a3f32 sum = 1.0f, term = 1.0f, k;
+	for (k = 1.0f; k < 20.0f; k += 1.0f)
+	{
+		term *= q / (k * k);
+		sum += term;
+	}
+	return sum;
+}
+
+// kernel weight at offset x (source pixels) from destination pixel center
+inline a3f32 a3textureCompressedInternalKernel(const a3_TextureMipFilter mipFilter, const a3f32 x, const a3f32 scale, const a3f32 radius)
+{
+	a3f32 t, s;
+	switch (mipFilter)
+	{
+	case a3tex_mipKaiser:
+		// sinc cut off at destination Nyquist rate, Kaiser window
+		t = x / radius;
+		if (t <= -1.0f || t >= 1.0f)
+			return 0.0f;
+		s = 3.14159265f * x / scale;
+		s = (s > 1.0e-4f || s < -1.0e-4f) ? sinf(s) / s : 1.0f;
+		return s * a3textureCompressedInternalBesselI0(a3textureCompressedKaiserAlpha * sqrtf(1.0f - t * t)) / a3textureCompressedInternalBesselI0(a3textureCompressedKaiserAlpha);
+
+	default:
+		// half-open footprint so that shared edges are counted once
+		t = 0.5f * scale;
+		return (x > -t && x <= t) ? 1.0f : 0.0f;
+	}
+}
+
+// build normalized taps for every destination pixel along one axis; 
+//	samples past the edge repeat the edge pixel
+inline void a3textureCompressedInternalBuildTaps(a3_TextureCompressedFilterTaps *taps_out, const a3ui32 dstCount, const a3ui32 srcCount, const a3_TextureMipFilter mipFilter)
+{
+	const a3f32 scale = (a3f32)srcCount / (a3f32)dstCount;
+	const a3f32 radius = mipFilter == a3tex_mipKaiser ? a3textureCompressedKaiserWidth * scale : 0.5f * scale;
+	a3f32 center, weight, total;
+	a3i32 first, last, j;
+	a3ui32 i, k;
+	for (i = 0; i < dstCount; ++i, ++taps_out)
+	{
+		center = ((a3f32)i + 0.5f) * scale - 0.5f;
+		first = (a3i32)floorf(center - radius);
+		last = (a3i32)ceilf(center + radius);
+		total = 0.0f;
+		taps_out->count = 0;
+		for (j = first; j <= last && taps_out->count < a3textureCompressed_tapMax; ++j)
+		{
+			weight = a3textureCompressedInternalKernel(mipFilter, (a3f32)j - center, scale, radius);
+			if (weight != 0.0f)
+			{
+				k = taps_out->count++;
+				taps_out->index[k] = j < 0 ? 0 : j >= (a3i32)srcCount ? srcCount - 1 : (a3ui32)j;
+				taps_out->weight[k] = weight;
+				total += weight;
+			}
+		}
+		for (k = 0; k < taps_out->count; ++k)
+			taps_out->weight[k] /= total;
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+// block encoding
+
+// fetch 4x4 block of rgba8 pixels, repeating edge pixels
+inline void a3textureCompressedInternalFetchBlock(a3ubyte block_out[16][4], const a3ubyte *pixels, const a3ui32 width, const a3ui32 height, const a3ui32 blockX, const a3ui32 blockY)
+{
+	a3ui32 x, y, px, py;
+	for (y = 0; y < 4; ++y)
+	{
+		py = blockY * 4 + y;
+		py = py < height ? py : height - 1;
+		for (x = 0; x < 4; ++x)
+		{
+			px = blockX * 4 + x;
+			px = px < width ? px : width - 1;
+			memcpy(block_out[y * 4 + x], pixels + (py * width + px) * 4, 4);
+		}
+	}
+}
+
+// fit a line through block colors along their principal axis (power 
+//	iteration on covariance); outputs the extremes of the projected colors
+inline void a3textureCompressedInternalFitLine(a3f32 e0_out[4], a3f32 e1_out[4], const a3ubyte block[16][4], const a3ui32 channels)
+{
+	a3f32 mean[4] = { 0.0f }, cov[4][4] = { 0.0f }, axis[4], next[4], d[4];
+	a3f32 t, tMin = 0.0f, tMax = 0.0f, len;
+	a3ui32 i, j, c, iter;
+
+	for (i = 0; i < 16; ++i)
+		for (c = 0; c < channels; ++c)
+			mean[c] += (a3f32)block[i][c];
+	for (c = 0; c < channels; ++c)
+		mean[c] *= (1.0f / 16.0f);
+
+	for (i = 0; i < 16; ++i)
+	{
+		for (c = 0; c < channels; ++c)
+			d[c] = (a3f32)block[i][c] - mean[c];
+		for (c = 0; c < channels; ++c)
+			for (j = c; j < channels; ++j)
+				cov[c][j] += d[c] * d[j];
+	}
+	for (c = 0; c < channels; ++c)
+		for (j = 0; j < c; ++j)
+			cov[c][j] = cov[j][c];
+
+	// start from the diagonal so a flat block converges immediately
+	for (c = 0; c < channels; ++c)
+		axis[c] = cov[c][c] + 1.0f;
+	for (iter = 0; iter < 8; ++iter)
+	{
+		len = 0.0f;
+		for (c = 0; c < channels; ++c)
+		{
+			for (next[c] = 0.0f, j = 0; j < channels; ++j)
+				next[c] += cov[c][j] * axis[j];
+			len = fabsf(next[c]) > len ? fabsf(next[c]) : len;
+		}
+		if (len <= 0.0f)
+			break;
+		for (c = 0; c < channels; ++c)
+			axis[c] = next[c] / len;
+	}
+
+	len = 0.0f;
+	for (c = 0; c < channels; ++c)
+		len += axis[c] * axis[c];
+	if (len > 0.0f)
+	{
+		for (i = 0; i < 16; ++i)
+		{
+			for (t = 0.0f, c = 0; c < channels; ++c)
+				t += ((a3f32)block[i][c] - mean[c]) * axis[c];
+			t /= len;
+			tMin = t < tMin ? t : tMin;
+			tMax = t > tMax ? t : tMax;
+		}
+	}
+	for (c = 0; c < channels; ++c)
+	{
+		e0_out[c] = mean[c] + axis[c] * tMin;
+		e1_out[c] = mean[c] + axis[c] * tMax;
+		e0_out[c] = e0_out[c] < 0.0f ? 0.0f : e0_out[c] > 255.0f ? 255.0f : e0_out[c];
+		e1_out[c] = e1_out[c] < 0.0f ? 0.0f : e1_out[c] > 255.0f ? 255.0f : e1_out[c];
+	}
+}
+
+// squared distance between palette entry and pixel
+inline a3ui32 a3textureCompressedInternalDistance(const a3i32 *a, const a3ubyte *b, const a3ui32 channels)
+{
+	a3ui32 c, sum = 0;
+	a3i32 d;
+	for (c = 0; c < channels; ++c)
+	{
+		d = a[c] - (a3i32)b[c];
+		sum += (a3ui32)(d * d);
+	}
+	return sum;
+}
+
+// nearest palette entry to pixel
+inline a3ui32 a3textureCompressedInternalNearest(const a3i32 palette[][4], const a3ui32 paletteCount, const a3ubyte *pixel, const a3ui32 channels)
+{
+	a3ui32 k, best = 0, dist, bestDist = a3textureCompressedInternalDistance(palette[0], pixel, channels);
+	for (k = 1; k < paletteCount; ++k)
+	{
+		dist = a3textureCompressedInternalDistance(palette[k], pixel, channels);
+		if (dist < bestDist)
+		{
+			bestDist = dist;
+			best = k;
+		}
+	}
+	return best;
+}
+
+// rgb565 packing and expansion
+inline a3ui16 a3textureCompressedInternalPack565(const a3f32 rgb[3])
+{
+	const a3ui32 r = (a3ui32)(rgb[0] * (31.0f / 255.0f) + 0.5f);
+	const a3ui32 g = (a3ui32)(rgb[1] * (63.0f / 255.0f) + 0.5f);
+	const a3ui32 b = (a3ui32)(rgb[2] * (31.0f / 255.0f) + 0.5f);
+	return (a3ui16)((r << 11) | (g << 5) | b);
+}
+
+inline void a3textureCompressedInternalUnpack565(a3i32 rgb_out[4], const a3ui16 c)
+{
+	const a3i32 r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+	rgb_out[0] = (r << 3) | (r >> 2);
+	rgb_out[1] = (g << 2) | (g >> 4);
+	rgb_out[2] = (b << 3) | (b >> 2);
+	rgb_out[3] = 255;
+}
+
+// BC1 color block; with alpha allowed, blocks containing pixels below 
+//	half alpha use the three-color mode and mark those pixels transparent
+inline void a3textureCompressedInternalEncodeBC1(a3ubyte *out, const a3ubyte block[16][4], const a3boolean alphaAllowed)
+{
+	a3f32 e0[4], e1[4];
+	a3i32 palette[4][4];
+	a3ui16 c0, c1, tmp;
+	a3ui32 i, k, indices = 0;
+	a3boolean transparent = 0;
+
+	if (alphaAllowed)
+		for (i = 0; i < 16 && !transparent; ++i)
+			transparent = block[i][3] < 128;
+
+	a3textureCompressedInternalFitLine(e0, e1, block, 3);
+	c0 = a3textureCompressedInternalPack565(e1);
+	c1 = a3textureCompressedInternalPack565(e0);
+
+	// endpoint order selects the mode: c0 > c1 for four colors
+	if (transparent ? c0 > c1 : c0 < c1)
+	{
+		tmp = c0;
+		c0 = c1;
+		c1 = tmp;
+	}
+	a3textureCompressedInternalUnpack565(palette[0], c0);
+	a3textureCompressedInternalUnpack565(palette[1], c1);
+	for (k = 0; k < 3; ++k)
+	{
+		if (c0 > c1)
+		{
+			palette[2][k] = (2 * palette[0][k] + palette[1][k]) / 3;
+			palette[3][k] = (palette[0][k] + 2 * palette[1][k]) / 3;
+		}
+		else
+		{
+			palette[2][k] = (palette[0][k] + palette[1][k]) / 2;
+			palette[3][k] = 0;
+		}
+	}
+
+	// equal endpoints leave every index at zero
+	if (c0 != c1 || transparent)
+	{
+		for (i = 0; i < 16; ++i)
+		{
+			if (transparent && block[i][3] < 128)
+				k = 3;
+			else
+				k = a3textureCompressedInternalNearest(palette, c0 > c1 ? 4 : 3, block[i], 3);
+			indices |= k << (i * 2);
+		}
+	}
+
+	out[0] = (a3ubyte)(c0);
+	out[1] = (a3ubyte)(c0 >> 8);
+	out[2] = (a3ubyte)(c1);
+	out[3] = (a3ubyte)(c1 >> 8);
+	out[4] = (a3ubyte)(indices);
+	out[5] = (a3ubyte)(indices >> 8);
+	out[6] = (a3ubyte)(indices >> 16);
+	out[7] = (a3ubyte)(indices >> 24);
+}
+
+// BC4 single channel block (alpha of BC3, each channel of BC5)
+inline void a3textureCompressedInternalEncodeBC4(a3ubyte *out, const a3ubyte block[16][4], const a3ui32 channel)
+{
+	a3i32 palette[8][4];
+	a3ubyte value[16][4];
+	a3ui32 i, k, lo = 255, hi = 0;
+	a3ui64 indices = 0;
+
+	for (i = 0; i < 16; ++i)
+	{
+		value[i][0] = block[i][channel];
+		lo = value[i][0] < lo ? value[i][0] : lo;
+		hi = value[i][0] > hi ? value[i][0] : hi;
+	}
+
+	// eight-value mode: a0 > a1; a flat block keeps every index at zero
+	if (hi > lo)
+	{
+		palette[0][0] = hi;
+		palette[1][0] = lo;
+		for (k = 2; k < 8; ++k)
+			palette[k][0] = ((8 - k) * hi + (k - 1) * lo + 3) / 7;
+		for (i = 0; i < 16; ++i)
+			indices |= (a3ui64)a3textureCompressedInternalNearest(palette, 8, value[i], 1) << (i * 3);
+	}
+
+	out[0] = (a3ubyte)hi;
+	out[1] = (a3ubyte)lo;
+	for (k = 0; k < 6; ++k)
+		out[2 + k] = (a3ubyte)(indices >> (k * 8));
+}
+
+// append bits to a zeroed block, least significant first
+inline void a3textureCompressedInternalWriteBits(a3ubyte *out, a3ui32 *bit, const a3ui32 value, const a3ui32 count)
+{
+	a3ui32 i;
+	for (i = 0; i < count; ++i, ++(*bit))
+		if ((value >> i) & 1)
+			out[*bit >> 3] |= (a3ubyte)(1 << (*bit & 7));
+}
+
+// BC7 block using mode 6: one subset, rgba endpoints with 7 bits plus a 
+//	shared low bit each, 4-bit indices; good quality for smooth blocks
+inline void a3textureCompressedInternalEncodeBC7(a3ubyte *out, const a3ubyte block[16][4])
+{
+	static const a3i32 weight[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+	a3f32 e[2][4];
+	a3i32 q[2][4], palette[16][4], expanded, d;
+	a3ui32 p[2], index[16], err[2], i, k, c, bit = 0, tmp;
+
+	a3textureCompressedInternalFitLine(e[0], e[1], block, 4);
+
+	// pick the shared bit per endpoint that minimizes quantization error
+	for (k = 0; k < 2; ++k)
+	{
+		for (p[k] = 0; p[k] < 2; ++p[k])
+		{
+			err[p[k]] = 0;
+			for (c = 0; c < 4; ++c)
+			{
+				d = (a3i32)((e[k][c] - (a3f32)p[k]) * 0.5f + 0.5f);
+				d = d < 0 ? 0 : d > 127 ? 127 : d;
+				expanded = (d << 1) | (a3i32)p[k];
+				expanded -= (a3i32)(e[k][c] + 0.5f);
+				err[p[k]] += (a3ui32)(expanded * expanded);
+			}
+		}
+		p[k] = err[1] < err[0];
+		for (c = 0; c < 4; ++c)
+		{
+			d = (a3i32)((e[k][c] - (a3f32)p[k]) * 0.5f + 0.5f);
+			q[k][c] = d < 0 ? 0 : d > 127 ? 127 : d;
+		}
+	}
+
+	for (i = 0; i < 16; ++i)
+		for (c = 0; c < 4; ++c)
+			palette[i][c] = ((64 - weight[i]) * ((q[0][c] << 1) | (a3i32)p[0]) + weight[i] * ((q[1][c] << 1) | (a3i32)p[1]) + 32) >> 6;
+	for (i = 0; i < 16; ++i)
+		index[i] = a3textureCompressedInternalNearest(palette, 16, block[i], 4);
+
+	// the first index is stored with an implicit zero high bit
+	if (index[0] & 8)
+	{
+		for (c = 0; c < 4; ++c)
+		{
+			tmp = q[0][c];
+			q[0][c] = q[1][c];
+			q[1][c] = tmp;
+		}
+		tmp = p[0];
+		p[0] = p[1];
+		p[1] = tmp;
+		for (i = 0; i < 16; ++i)
+			index[i] = 15 - index[i];
+	}
+
+	memset(out, 0, 16);
+	a3textureCompressedInternalWriteBits(out, &bit, 1 << 6, 7);
+	for (c = 0; c < 4; ++c)
+	{
+		a3textureCompressedInternalWriteBits(out, &bit, q[0][c], 7);
+		a3textureCompressedInternalWriteBits(out, &bit, q[1][c], 7);
+	}
+	a3textureCompressedInternalWriteBits(out, &bit, p[0], 1);
+	a3textureCompressedInternalWriteBits(out, &bit, p[1], 1);
+	a3textureCompressedInternalWriteBits(out, &bit, index[0], 3);
+	for (i = 1; i < 16; ++i)
+		a3textureCompressedInternalWriteBits(out, &bit, index[i], 4);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3textureCompressedDownsample(a3ubyte *pixels_out, const a3ui32 dstWidth, const a3ui32 dstHeight, const a3ubyte *pixels, const a3ui32 width, const a3ui32 height, const a3_TextureMipFilter mipFilter)
+{
+	if (pixels_out && dstWidth && dstHeight && pixels && width && height)
+	{
+		a3_TextureCompressedFilterTaps *tapsX = (a3_TextureCompressedFilterTaps *)malloc(sizeof(a3_TextureCompressedFilterTaps) * (dstWidth + dstHeight)), *tapsY = tapsX + dstWidth, *taps;
+		a3f32 *rows = (a3f32 *)malloc(sizeof(a3f32) * 4 * dstWidth * height), *row;
+		a3f32 sum[4];
+		a3ui32 x, y, k, c;
+		const a3ubyte *src;
+		if (tapsX && rows)
+		{
+			a3textureCompressedInternalBuildTaps(tapsX, dstWidth, width, mipFilter);
+			a3textureCompressedInternalBuildTaps(tapsY, dstHeight, height, mipFilter);
+
+			// horizontal pass into float rows
+			for (row = rows, y = 0; y < height; ++y)
+			{
+				src = pixels + y * width * 4;
+				for (taps = tapsX, x = 0; x < dstWidth; ++x, ++taps, row += 4)
+				{
+					row[0] = row[1] = row[2] = row[3] = 0.0f;
+					for (k = 0; k < taps->count; ++k)
+						for (c = 0; c < 4; ++c)
+							row[c] += taps->weight[k] * (a3f32)src[taps->index[k] * 4 + c];
+				}
+			}
+
+			// vertical pass; negative lobes are clamped
+			for (taps = tapsY, y = 0; y < dstHeight; ++y, ++taps)
+			{
+				for (x = 0; x < dstWidth; ++x, pixels_out += 4)
+				{
+					sum[0] = sum[1] = sum[2] = sum[3] = 0.0f;
+					for (k = 0; k < taps->count; ++k)
+					{
+						row = rows + (taps->index[k] * dstWidth + x) * 4;
+						for (c = 0; c < 4; ++c)
+							sum[c] += taps->weight[k] * row[c];
+					}
+					for (c = 0; c < 4; ++c)
+						pixels_out[c] = (a3ubyte)(sum[c] <= 0.0f ? 0 : sum[c] >= 255.0f ? 255 : (a3ui32)(sum[c] + 0.5f));
+				}
+			}
+		}
+		free(rows);
+		free(tapsX);
+		return (tapsX && rows) ? 1 : 0;
+	}
+	return -1;
+}
+
+a3ret a3textureCompressedEncodeLevel(a3ubyte *blocks_out, const a3ubyte *pixels, const a3ui32 width, const a3ui32 height, const a3_TextureBlockFormat format)
+{
+	if (blocks_out && pixels && width && height)
+	{
+		const a3ui32 blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+		const a3ui32 size = a3textureCompressedLevelSize(format, width, height);
+		a3ubyte block[16][4];
+		a3ubyte *out = blocks_out;
+		a3ui32 x, y;
+
+		if (format == a3tex_blockNone)
+		{
+			memcpy(blocks_out, pixels, size);
+			return size;
+		}
+
+		for (y = 0; y < blocksY; ++y)
+		{
+			for (x = 0; x < blocksX; ++x)
+			{
+				a3textureCompressedInternalFetchBlock(block, pixels, width, height, x, y);
+				switch (format)
+				{
+				case a3tex_bc1:
+					a3textureCompressedInternalEncodeBC1(out, block, 1);
+					out += 8;
+					break;
+				case a3tex_bc3:
+					a3textureCompressedInternalEncodeBC4(out, block, 3);
+					a3textureCompressedInternalEncodeBC1(out + 8, block, 0);
+					out += 16;
+					break;
+				case a3tex_bc5:
+					a3textureCompressedInternalEncodeBC4(out, block, 0);
+					a3textureCompressedInternalEncodeBC4(out + 8, block, 1);
+					out += 16;
+					break;
+				case a3tex_bc7:
+					a3textureCompressedInternalEncodeBC7(out, block);
+					out += 16;
+					break;
+				case a3tex_blockNone:
+					// copied above
+					break;
+				}
+			}
+		}
+		return size;
+	}
+	return -1;
+}
+
+a3ui32 a3textureCompressedLevelSize(const a3_TextureBlockFormat format, const a3ui32 width, const a3ui32 height)
+{
+	const a3ui32 blocks = ((width + 3) / 4) * ((height + 3) / 4);
+	switch (format)
+	{
+	case a3tex_blockNone:
+		return (width * height * 4);
+	case a3tex_bc1:
+		return (blocks * 8);
+	case a3tex_bc3:
+	case a3tex_bc5:
+	case a3tex_bc7:
+		return (blocks * 16);
+	}
+	return 0;
+}
+
+a3ret a3textureCompressedCreate(a3_TextureCompressedImage *image_out, const a3ubyte *pixels, const a3ui32 width, const a3ui32 height, const a3_TextureBlockFormat format, const a3_TextureMipFilter mipFilter, const a3ui32 levelCountMax)
+{
+	if (image_out && pixels && width && height && format <= a3tex_bc7)
+	{
+		if (!image_out->data)
+		{
+			a3_TextureCompressedImage ret = { 0 };
+			a3ubyte *level[2] = { 0 };
+			const a3ubyte *src = pixels;
+			a3ui32 w = width, h = height, nextW, nextH, i;
+
+			// count levels down to 1x1 and lay them out
+			ret.format = format;
+			ret.width = width;
+			ret.height = height;
+			do
+			{
+				ret.levelOffset[ret.levelCount] = ret.dataSize;
+				ret.levelSize[ret.levelCount] = a3textureCompressedLevelSize(format, w, h);
+				ret.dataSize += ret.levelSize[ret.levelCount++];
+				if (w == 1 && h == 1)
+					break;
+				w = w > 1 ? w / 2 : 1;
+				h = h > 1 ? h / 2 : 1;
+			} while (ret.levelCount < a3textureCompressed_levelMax && (!levelCountMax || ret.levelCount < levelCountMax));
+
+			ret.data = (a3ubyte *)malloc(ret.dataSize);
+			if (ret.levelCount > 1)
+			{
+				// ping-pong between two scratch levels, each filtered from 
+				//	the previous one
+				w = width > 1 ? width / 2 : 1;
+				h = height > 1 ? height / 2 : 1;
+				level[0] = (a3ubyte *)malloc(w * h * 4 * 2);
+				level[1] = level[0] ? level[0] + w * h * 4 : 0;
+			}
+			if (ret.data && (ret.levelCount == 1 || level[0]))
+			{
+				w = width;
+				h = height;
+				for (i = 0; i < ret.levelCount; ++i)
+				{
+					a3textureCompressedEncodeLevel(ret.data + ret.levelOffset[i], src, w, h, format);
+					if (i + 1 < ret.levelCount)
+					{
+						nextW = w > 1 ? w / 2 : 1;
+						nextH = h > 1 ? h / 2 : 1;
+						a3textureCompressedDownsample(level[i % 2], nextW, nextH, src, w, h, mipFilter);
+						src = level[i % 2];
+						w = nextW;
+						h = nextH;
+					}
+				}
+				free(level[0]);
+				*image_out = ret;
+				return ret.levelCount;
+			}
+			free(level[0]);
+			free(ret.data);
+			printf("\n A3 ERROR: \n\t Could not allocate compressed image (%u bytes).", ret.dataSize);
+			return 0;
+		}
+	}
+	return -1;
+}
+
+a3ret a3textureCompressedSaveFile(const a3_TextureCompressedImage *image, const a3byte *filePath)
+{
+	FILE *fp;
+	a3_TextureCompressedFileHeader header;
+	a3ui32 i, ret = 0;
+	if (image && filePath && *filePath)
+	{
+		if (image->data)
+		{
+			fp = fopen(filePath, "wb");
+			if (fp)
+			{
+				memcpy(header.identifier, a3textureCompressedIdentifier, sizeof(header.identifier));
+				header.format = image->format;
+				header.width = image->width;
+				header.height = image->height;
+				header.levelCount = image->levelCount;
+				ret += (a3ui32)fwrite(&header, 1, sizeof(header), fp);
+				for (i = 0; i < image->levelCount; ++i)
+				{
+					ret += (a3ui32)fwrite(image->levelSize + i, 1, sizeof(a3ui32), fp);
+					ret += (a3ui32)fwrite(image->data + image->levelOffset[i], 1, image->levelSize[i], fp);
+				}
+				fclose(fp);
+			}
+			return ret;
+		}
+	}
+	return -1;
+}
+
+a3ret a3textureCompressedLoadFile(a3_TextureCompressedImage *image_out, const a3byte *filePath)
+{
+	FILE *fp;
+	a3_TextureCompressedFileHeader header;
+	a3_TextureCompressedImage ret = { 0 };
+	a3ui32 i, w, h, size;
+	a3boolean valid;
+	if (image_out && filePath && *filePath)
+	{
+		if (!image_out->data)
+		{
+			fp = fopen(filePath, "rb");
+			if (fp)
+			{
+				valid = fread(&header, sizeof(header), 1, fp) == 1 &&
+					!memcmp(header.identifier, a3textureCompressedIdentifier, sizeof(header.identifier)) &&
+					header.format <= a3tex_bc7 && header.width && header.height &&
+					header.levelCount && header.levelCount <= a3textureCompressed_levelMax;
+				if (valid)
+				{
+					// level sizes follow from the header; stored sizes must agree
+					ret.format = (a3_TextureBlockFormat)header.format;
+					ret.width = w = header.width;
+					ret.height = h = header.height;
+					ret.levelCount = header.levelCount;
+					for (i = 0; i < ret.levelCount; ++i)
+					{
+						ret.levelOffset[i] = ret.dataSize;
+						ret.levelSize[i] = a3textureCompressedLevelSize(ret.format, w, h);
+						ret.dataSize += ret.levelSize[i];
+						w = w > 1 ? w / 2 : 1;
+						h = h > 1 ? h / 2 : 1;
+					}
+					ret.data = (a3ubyte *)malloc(ret.dataSize);
+					valid = ret.data != 0;
+					for (i = 0; i < ret.levelCount && valid; ++i)
+					{
+						valid = fread(&size, sizeof(size), 1, fp) == 1 && size == ret.levelSize[i] &&
+							fread(ret.data + ret.levelOffset[i], 1, size, fp) == size;
+					}
+				}
+				fclose(fp);
+
+				if (valid)
+				{
+					*image_out = ret;
+					return ret.levelCount;
+				}
+				free(ret.data);
+				printf("\n A3 Warning: \n\t Compressed texture file \'%s\' is not valid.", filePath);
+			}
+			return 0;
+		}
+	}
+	return -1;
+}
+
+a3ret a3textureCompressedRelease(a3_TextureCompressedImage *image)
+{
+	if (image)
+	{
+		if (image->data)
+		{
+			free(image->data);
+			memset(image, 0, sizeof(a3_TextureCompressedImage));
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,946 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_TextureDecoder.c
+	Definitions for built-in PNG/TGA decoder.
+*/
+
+#include "animal3D-A3DG/a3graphics/a3_TextureDecoder.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// SSE2 is always available on 64-bit x86 targets
+#if (defined _M_X64 || defined _M_AMD64 || defined __SSE2__)
+#define A3_TEXTUREDECODER_SSE2
+#include <emmintrin.h>
+#endif	// SSE2
+
+
+//-----------------------------------------------------------------------------
+// inflate (RFC 1951)
+
+// limits
+enum
+{
+	a3textureDecoder_fastBits = 10,
+	a3textureDecoder_fastSize = 1 << a3textureDecoder_fastBits,
+	a3textureDecoder_symbolMax = 288,
+};
+
+// canonical Huffman table: codes up to fastBits long resolve with one 
+//	lookup (entry is length << 9 | symbol), longer codes walk by length
+typedef struct a3_TextureDecoderHuffman
+{
+	a3ui16 fast[a3textureDecoder_fastSize];
+	a3ui16 firstCode[16];
+	a3ui16 firstSymbol[16];
+	a3ui32 maxCode[17];
+	a3ubyte size[a3textureDecoder_symbolMax];
+	a3ui16 value[a3textureDecoder_symbolMax];
+} a3_TextureDecoderHuffman;
+
+// inflate state; input is consumed through a 64-bit bit buffer and output 
+//	goes to a buffer of known size (PNG knows its inflated size up front); 
+//	overrun counts zero bytes shifted in past the end of input
+typedef struct a3_TextureDecoderInflate
+{
+	const a3ubyte *in, *inEnd;
+	a3ui64 bits;
+	a3ui32 bitCount, overrun;
+	a3ubyte *out, *outBegin, *outEnd;
+	a3_TextureDecoderHuffman length[1], distance[1];
+} a3_TextureDecoderInflate;
+
+
+// reverse the low n bits
+inline a3ui32 a3textureDecoderInternalReverse(a3ui32 v, const a3ui32 n)
+{
+	v = ((v & 0xAAAA) >> 1) | ((v & 0x5555) << 1);
+	v = ((v & 0xCCCC) >> 2) | ((v & 0x3333) << 2);
+	v = ((v & 0xF0F0) >> 4) | ((v & 0x0F0F) << 4);
+	v = ((v & 0xFF00) >> 8) | ((v & 0x00FF) << 8);
+	return (v >> (16 - n));
+}
+
+inline a3boolean a3textureDecoderInternalBuildHuffman(a3_TextureDecoderHuffman *table, const a3ubyte *sizeList, const a3ui32 count)
+{
+	a3ui32 sizeCount[17] = { 0 }, nextCode[16];
+	a3ui32 i, s, c, j, code = 0, symbol = 0;
+
+	memset(table->fast, 0, sizeof(table->fast));
+	for (i = 0; i < count; ++i)
+		++sizeCount[sizeList[i]];
+	sizeCount[0] = 0;
+	for (i = 1; i < 16; ++i)
+		if (sizeCount[i] > (1u << i))
+			return 0;
+	for (i = 1; i < 16; ++i)
+	{
+		nextCode[i] = code;
+		table->firstCode[i] = (a3ui16)code;
+		table->firstSymbol[i] = (a3ui16)symbol;
+		code += sizeCount[i];
+		if (sizeCount[i] && code - 1 >= (1u << i))
+			return 0;
+		table->maxCode[i] = code << (16 - i);
+		code <<= 1;
+		symbol += sizeCount[i];
+	}
+	table->maxCode[16] = 0x10000;
+
+	for (i = 0; i < count; ++i)
+	{
+		s = sizeList[i];
+		if (s)
+		{
+			c = nextCode[s] - table->firstCode[s] + table->firstSymbol[s];
+			table->size[c] = (a3ubyte)s;
+			table->value[c] = (a3ui16)i;
+			if (s <= a3textureDecoder_fastBits)
+				for (j = a3textureDecoderInternalReverse(nextCode[s], s); j < a3textureDecoder_fastSize; j += (1 << s))
+					table->fast[j] = (a3ui16)((s << 9) | i);
+			++nextCode[s];
+		}
+	}
+	return 1;
+}
+
+// top up bit buffer; past the end of input, zero bits are shifted in 
+//	without advancing the input pointer and the caller catches the overrun 
+//	through its output bounds
+inline void a3textureDecoderInternalRefill(a3_TextureDecoderInflate *z)
+{
+	while (z->bitCount <= 56)
+	{
+		if (z->in < z->inEnd)
+			z->bits |= (a3ui64)(*(z->in++)) << z->bitCount;
+		else
+			++z->overrun;
+		z->bitCount += 8;
+	}
+}
+
+inline a3ui32 a3textureDecoderInternalBits(a3_TextureDecoderInflate *z, const a3ui32 n)
+{
+	a3ui32 v;
+	if (z->bitCount < n)
+		a3textureDecoderInternalRefill(z);
+	v = (a3ui32)(z->bits & ((1ull << n) - 1));
+	z->bits >>= n;
+	z->bitCount -= n;
+	return v;
+}
+
+// decode one symbol; returns symbol or -1 if code is invalid
+inline a3i32 a3textureDecoderInternalDecode(a3_TextureDecoderInflate *z, const a3_TextureDecoderHuffman *table)
+{
+	a3ui32 b, s, k;
+	if (z->bitCount < 16)
+		a3textureDecoderInternalRefill(z);
+	b = table->fast[z->bits & (a3textureDecoder_fastSize - 1)];
+	if (b)
+	{
+		s = b >> 9;
+		z->bits >>= s;
+		z->bitCount -= s;
+		return (b & 511);
+	}
+
+	// slow path: compare reversed code against each length's range
+	k = a3textureDecoderInternalReverse((a3ui32)(z->bits & 0xFFFF), 16);
+	for (s = a3textureDecoder_fastBits + 1; k >= table->maxCode[s]; ++s);
+	if (s >= 16)
+		return -1;
+	b = (k >> (16 - s)) - table->firstCode[s] + table->firstSymbol[s];
+	if (b >= a3textureDecoder_symbolMax || table->size[b] != s)
+		return -1;
+	z->bits >>= s;
+	z->bitCount -= s;
+	return table->value[b];
+}
+
+inline a3boolean a3textureDecoderInternalInflateBlock(a3_TextureDecoderInflate *z)
+{
+	static const a3ui16 lengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	static const a3ubyte lengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	static const a3ui16 distanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+	static const a3ubyte distanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+	a3ubyte *out = z->out, *src;
+	a3i32 symbol;
+	a3ui32 length, distance;
+
+	for (;;)
+	{
+		symbol = a3textureDecoderInternalDecode(z, z->length);
+		if (symbol < 256)
+		{
+			if (symbol < 0 || out >= z->outEnd)
+				return 0;
+			*(out++) = (a3ubyte)symbol;
+		}
+		else if (symbol == 256)
+		{
+			z->out = out;
+			return 1;
+		}
+		else
+		{
+			symbol -= 257;
+			if (symbol >= 29)
+				return 0;
+			length = lengthBase[symbol] + a3textureDecoderInternalBits(z, lengthExtra[symbol]);
+			symbol = a3textureDecoderInternalDecode(z, z->distance);
+			if (symbol < 0 || symbol >= 30)
+				return 0;
+			distance = distanceBase[symbol] + a3textureDecoderInternalBits(z, distanceExtra[symbol]);
+			if (distance > (a3ui32)(out - z->outBegin) || length > (a3ui32)(z->outEnd - out))
+				return 0;
+
+			// run of one byte, non-overlapping copy or overlapping pattern
+			src = out - distance;
+			if (distance == 1)
+				memset(out, *src, length);
+			else if (distance >= length)
+				memcpy(out, src, length);
+			else
+			{
+				a3ui32 i;
+				for (i = 0; i < length; ++i)
+					out[i] = src[i];
+			}
+			out += length;
+		}
+	}
+}
+
+inline a3boolean a3textureDecoderInternalInflateDynamic(a3_TextureDecoderInflate *z)
+{
+	static const a3ubyte lengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+	a3_TextureDecoderHuffman codeLength[1];
+	a3ubyte sizes[286 + 32], codeSizes[19] = { 0 };
+	const a3ui32 hlit = a3textureDecoderInternalBits(z, 5) + 257;
+	const a3ui32 hdist = a3textureDecoderInternalBits(z, 5) + 1;
+	const a3ui32 hclen = a3textureDecoderInternalBits(z, 4) + 4;
+	const a3ui32 total = hlit + hdist;
+	a3ui32 i, n = 0, repeat;
+	a3i32 symbol;
+	a3ubyte fill;
+
+	// counts past the alphabets would overflow the size list
+	if (hlit > 286 || hdist > 30)
+		return 0;
+
+	for (i = 0; i < hclen; ++i)
+		codeSizes[lengthOrder[i]] = (a3ubyte)a3textureDecoderInternalBits(z, 3);
+	if (!a3textureDecoderInternalBuildHuffman(codeLength, codeSizes, 19))
+		return 0;
+
+	while (n < total)
+	{
+		symbol = a3textureDecoderInternalDecode(z, codeLength);
+		if (symbol < 0 || symbol >= 19)
+			return 0;
+		if (symbol < 16)
+		{
+			sizes[n++] = (a3ubyte)symbol;
+			continue;
+		}
+		if (symbol == 16)
+		{
+			if (!n)
+				return 0;
+			repeat = a3textureDecoderInternalBits(z, 2) + 3;
+			fill = sizes[n - 1];
+		}
+		else if (symbol == 17)
+		{
+			repeat = a3textureDecoderInternalBits(z, 3) + 3;
+			fill = 0;
+		}
+		else
+		{
+			repeat = a3textureDecoderInternalBits(z, 7) + 11;
+			fill = 0;
+		}
+		if (n + repeat > total)
+			return 0;
+		memset(sizes + n, fill, repeat);
+		n += repeat;
+	}
+
+	return (a3textureDecoderInternalBuildHuffman(z->length, sizes, hlit) &&
+		a3textureDecoderInternalBuildHuffman(z->distance, sizes + hlit, hdist));
+}
+
+inline a3boolean a3textureDecoderInternalInflateStored(a3_TextureDecoderInflate *z)
+{
+	a3ui32 length, check;
+
+	// align to byte, then drain whole bytes still held in the bit buffer
+	a3textureDecoderInternalBits(z, z->bitCount & 7);
+	length = a3textureDecoderInternalBits(z, 16);
+	check = a3textureDecoderInternalBits(z, 16);
+	if ((length ^ 0xFFFF) != check || length > (a3ui32)(z->outEnd - z->out))
+		return 0;
+	while (length && z->bitCount >= 8)
+	{
+		*(z->out++) = (a3ubyte)a3textureDecoderInternalBits(z, 8);
+		--length;
+	}
+
+	// the top buffered bytes are zero fill if input ran out
+	if (z->bitCount / 8 < z->overrun)
+		return 0;
+	if (length)
+	{
+		if (length > (a3ui32)(z->inEnd - z->in))
+			return 0;
+		memcpy(z->out, z->in, length);
+		z->out += length;
+		z->in += length;
+	}
+	return 1;
+}
+
+inline a3boolean a3textureDecoderInternalInflateFixed(a3_TextureDecoderInflate *z)
+{
+	a3ubyte sizes[a3textureDecoder_symbolMax];
+	memset(sizes + 0, 8, 144);
+	memset(sizes + 144, 9, 112);
+	memset(sizes + 256, 7, 24);
+	memset(sizes + 280, 8, 8);
+	a3textureDecoderInternalBuildHuffman(z->length, sizes, 288);
+	memset(sizes, 5, 30);
+	return a3textureDecoderInternalBuildHuffman(z->distance, sizes, 30);
+}
+
+// inflate zlib stream into a buffer of exactly the expected size
+inline a3boolean a3textureDecoderInternalInflate(a3ubyte *out, const a3ui32 outSize, const a3ubyte *in, const a3ui32 inSize)
+{
+	a3_TextureDecoderInflate z[1];
+	a3ui32 final, type;
+	a3boolean ok = 1;
+
+	// zlib header: deflate, no preset dictionary, valid check bits
+	if (inSize < 2 || (in[0] & 0x0F) != 8 || (in[1] & 0x20) || ((in[0] << 8) | in[1]) % 31)
+		return 0;
+
+	z->in = in + 2;
+	z->inEnd = in + inSize;
+	z->bits = 0;
+	z->bitCount = 0;
+	z->overrun = 0;
+	z->out = z->outBegin = out;
+	z->outEnd = out + outSize;
+	do
+	{
+		final = a3textureDecoderInternalBits(z, 1);
+		type = a3textureDecoderInternalBits(z, 2);
+		switch (type)
+		{
+		case 0:
+			ok = a3textureDecoderInternalInflateStored(z);
+			break;
+		case 1:
+			ok = a3textureDecoderInternalInflateFixed(z) && a3textureDecoderInternalInflateBlock(z);
+			break;
+		case 2:
+			ok = a3textureDecoderInternalInflateDynamic(z) && a3textureDecoderInternalInflateBlock(z);
+			break;
+		default:
+			ok = 0;
+		}
+	} while (ok && !final);
+	return (ok && z->out == z->outEnd);
+}
+
+
+//-----------------------------------------------------------------------------
+// PNG
+
+// filter types
+enum
+{
+	a3textureDecoder_filterNone,
+	a3textureDecoder_filterSub,
+	a3textureDecoder_filterUp,
+	a3textureDecoder_filterAverage,
+	a3textureDecoder_filterPaeth,
+};
+
+inline a3ui32 a3textureDecoderInternalBigEndian(const a3ubyte *p)
+{
+	return (((a3ui32)p[0] << 24) | ((a3ui32)p[1] << 16) | ((a3ui32)p[2] << 8) | (a3ui32)p[3]);
+}
+
+inline a3ubyte a3textureDecoderInternalPaeth(const a3i32 a, const a3i32 b, const a3i32 c)
+{
+	const a3i32 pa = abs(b - c), pb = abs(a - c), pc = abs(a + b - 2 * c);
+	return (a3ubyte)((pa <= pb && pa <= pc) ? a : pb <= pc ? b : c);
+}
+
+#ifdef A3_TEXTUREDECODER_SSE2
+// SSE2 unfiltering for 3 and 4-byte pixels (8-bit rgb/rgba): the filters 
+//	that depend on the previous pixel run one pixel per vector step, the 
+//	up filter runs 16 bytes at a time
+
+// fixed-size accesses so no call to memcpy is made per pixel
+inline __m128i a3textureDecoderInternalLoad(const a3ubyte *p, const a3ui32 bpp)
+{
+	a3i32 v;
+	if (bpp == 4)
+		memcpy(&v, p, 4);
+	else
+		v = p[0] | (p[1] << 8) | (p[2] << 16);
+	return _mm_cvtsi32_si128(v);
+}
+
+inline void a3textureDecoderInternalStore(a3ubyte *p, const __m128i v, const a3ui32 bpp)
+{
+	const a3i32 s = _mm_cvtsi128_si32(v);
+	if (bpp == 4)
+		memcpy(p, &s, 4);
+	else
+	{
+		p[0] = (a3ubyte)s;
+		p[1] = (a3ubyte)(s >> 8);
+		p[2] = (a3ubyte)(s >> 16);
+	}
+}
+
+inline void a3textureDecoderInternalUnfilterSubSSE2(a3ubyte *row, const a3ui32 rowSize, const a3ui32 bpp)
+{
+	__m128i a = _mm_setzero_si128();
+	a3ui32 i;
+	for (i = 0; i < rowSize; i += bpp)
+	{
+		a = _mm_add_epi8(a, a3textureDecoderInternalLoad(row + i, bpp));
+		a3textureDecoderInternalStore(row + i, a, bpp);
+	}
+}
+
+inline void a3textureDecoderInternalUnfilterAverageSSE2(a3ubyte *row, const a3ubyte *prev, const a3ui32 rowSize, const a3ui32 bpp)
+{
+	const __m128i one = _mm_set1_epi8(1);
+	__m128i a = _mm_setzero_si128(), b, avg;
+	a3ui32 i;
+	for (i = 0; i < rowSize; i += bpp)
+	{
+		// avg_epu8 rounds up; remove the carry to get floor((a + b) / 2)
+		b = a3textureDecoderInternalLoad(prev + i, bpp);
+		avg = _mm_avg_epu8(a, b);
+		avg = _mm_sub_epi8(avg, _mm_and_si128(_mm_xor_si128(a, b), one));
+		a = _mm_add_epi8(a3textureDecoderInternalLoad(row + i, bpp), avg);
+		a3textureDecoderInternalStore(row + i, a, bpp);
+	}
+}
+
+inline void a3textureDecoderInternalUnfilterPaethSSE2(a3ubyte *row, const a3ubyte *prev, const a3ui32 rowSize, const a3ui32 bpp)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i a = zero, b = zero, c, pa, pb, pc, smallest, nearest;
+	a3ui32 i;
+	for (i = 0; i < rowSize; i += bpp)
+	{
+		// work in 16-bit lanes: pa = |b - c|, pb = |a - c|, pc = |pa + pb|
+		c = b;
+		b = _mm_unpacklo_epi8(a3textureDecoderInternalLoad(prev + i, bpp), zero);
+		pa = _mm_sub_epi16(b, c);
+		pb = _mm_sub_epi16(a, c);
+		pc = _mm_add_epi16(pa, pb);
+		pa = _mm_max_epi16(pa, _mm_sub_epi16(zero, pa));
+		pb = _mm_max_epi16(pb, _mm_sub_epi16(zero, pb));
+		pc = _mm_max_epi16(pc, _mm_sub_epi16(zero, pc));
+		smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+
+		// ties prefer a, then b
+		nearest = _mm_cmpeq_epi16(smallest, pb);
+		nearest = _mm_or_si128(_mm_and_si128(nearest, b), _mm_andnot_si128(nearest, c));
+		pa = _mm_cmpeq_epi16(smallest, pa);
+		nearest = _mm_or_si128(_mm_and_si128(pa, a), _mm_andnot_si128(pa, nearest));
+
+		a = _mm_add_epi8(_mm_packus_epi16(nearest, nearest), a3textureDecoderInternalLoad(row + i, bpp));
+		a3textureDecoderInternalStore(row + i, a, bpp);
+		a = _mm_unpacklo_epi8(a, zero);
+	}
+}
+#endif	// A3_TEXTUREDECODER_SSE2
+
+// undo row filter in place; prev is the unfiltered previous row or zeros
+inline a3boolean a3textureDecoderInternalUnfilter(a3ubyte *row, const a3ubyte *prev, const a3ui32 rowSize, const a3ui32 bpp, const a3ubyte filter)
+{
+	a3ui32 i = 0;
+	switch (filter)
+	{
+	case a3textureDecoder_filterNone:
+		break;
+
+	case a3textureDecoder_filterSub:
+#ifdef A3_TEXTUREDECODER_SSE2
+		if (bpp == 3 || bpp == 4)
+		{
+			a3textureDecoderInternalUnfilterSubSSE2(row, rowSize, bpp);
+			break;
+		}
+#endif	// A3_TEXTUREDECODER_SSE2
+		for (i = bpp; i < rowSize; ++i)
+			row[i] += row[i - bpp];
+		break;
+
+	case a3textureDecoder_filterUp:
+#ifdef A3_TEXTUREDECODER_SSE2
+		for (; i + 16 <= rowSize; i += 16)
+			_mm_storeu_si128((__m128i *)(row + i), _mm_add_epi8(_mm_loadu_si128((const __m128i *)(row + i)), _mm_loadu_si128((const __m128i *)(prev + i))));
+#endif	// A3_TEXTUREDECODER_SSE2
+		for (; i < rowSize; ++i)
+			row[i] += prev[i];
+		break;
+
+	case a3textureDecoder_filterAverage:
+#ifdef A3_TEXTUREDECODER_SSE2
+		if (bpp == 3 || bpp == 4)
+		{
+			a3textureDecoderInternalUnfilterAverageSSE2(row, prev, rowSize, bpp);
+			break;
+		}
+#endif	// A3_TEXTUREDECODER_SSE2
+		for (; i < bpp; ++i)
+			row[i] += prev[i] >> 1;
+		for (; i < rowSize; ++i)
+			row[i] += (a3ubyte)(((a3ui32)row[i - bpp] + (a3ui32)prev[i]) >> 1);
+		break;
+
+	case a3textureDecoder_filterPaeth:
+#ifdef A3_TEXTUREDECODER_SSE2
+		if (bpp == 3 || bpp == 4)
+		{
+			a3textureDecoderInternalUnfilterPaethSSE2(row, prev, rowSize, bpp);
+			break;
+		}
+#endif	// A3_TEXTUREDECODER_SSE2
+		for (; i < bpp; ++i)
+			row[i] += prev[i];
+		for (; i < rowSize; ++i)
+			row[i] += a3textureDecoderInternalPaeth(row[i - bpp], prev[i], prev[i - bpp]);
+		break;
+
+	default:
+		return 0;
+	}
+	return 1;
+}
+
+// PNG header and ancillary color info
+typedef struct a3_TextureDecoderPNG
+{
+	a3ui32 width, height;
+	a3ubyte depth, colorType, interlace;
+	a3ubyte palette[256][4];
+	a3ui16 key[3];
+	a3boolean hasKey;
+	a3ui32 paletteCount;
+} a3_TextureDecoderPNG;
+
+// sample n of a row of sub-byte, 8 or 16-bit samples, scaled to the 
+//	output depth (8 bits if the source has fewer)
+inline a3ui32 a3textureDecoderInternalSample(const a3ubyte *row, const a3ui32 n, const a3ui32 depth)
+{
+	a3ui32 v;
+	switch (depth)
+	{
+	case 16:
+		return (((a3ui32)row[n * 2] << 8) | row[n * 2 + 1]);
+	case 8:
+		return row[n];
+	default:
+		v = (row[(n * depth) >> 3] >> (8 - depth - ((n * depth) & 7))) & ((1 << depth) - 1);
+		return v;
+	}
+}
+
+// convert one unfiltered row into the output layout
+inline void a3textureDecoderInternalConvertRow(a3ubyte *dst, const a3ubyte *row, const a3_TextureDecoderPNG *png, const a3ui32 channelsOut)
+{
+	const a3ui32 depth = png->depth, w = png->width;
+	const a3ui32 scale = depth < 8 ? 255 / ((1 << depth) - 1) : 1;
+	a3ui16 *dst16 = (a3ui16 *)dst;
+	a3ui32 x, c, v[4], channelsIn;
+	a3boolean keyed;
+
+	// 8-bit rgba is stored as is
+	if (png->colorType == 6 && depth == 8)
+	{
+		memcpy(dst, row, w * 4);
+		return;
+	}
+
+	channelsIn = png->colorType == 0 ? 1 : png->colorType == 2 ? 3 : png->colorType == 3 ? 1 : png->colorType == 4 ? 2 : 4;
+	for (x = 0; x < w; ++x)
+	{
+		for (c = 0; c < channelsIn; ++c)
+			v[c] = a3textureDecoderInternalSample(row, x * channelsIn + c, depth);
+		switch (png->colorType)
+		{
+		case 0:
+			keyed = png->hasKey && v[0] == png->key[0];
+			v[0] *= scale;
+			v[1] = v[2] = v[0];
+			v[3] = keyed ? 0 : depth == 16 ? 0xFFFF : 0xFF;
+			break;
+		case 2:
+			keyed = png->hasKey && v[0] == png->key[0] && v[1] == png->key[1] && v[2] == png->key[2];
+			v[3] = keyed ? 0 : depth == 16 ? 0xFFFF : 0xFF;
+			break;
+		case 3:
+			c = v[0];
+			v[0] = png->palette[c][0];
+			v[1] = png->palette[c][1];
+			v[2] = png->palette[c][2];
+			v[3] = png->palette[c][3];
+			break;
+		case 4:
+			v[3] = v[1];
+			v[1] = v[2] = v[0];
+			break;
+		}
+		if (depth == 16)
+			for (c = 0; c < channelsOut; ++c)
+				*(dst16++) = (a3ui16)v[c];
+		else
+			for (c = 0; c < channelsOut; ++c)
+				*(dst++) = (a3ubyte)v[c];
+	}
+}
+
+// read chunks; IDAT payloads are concatenated into one zlib stream, 
+//	returned in a new buffer (null if there is none)
+inline a3ubyte *a3textureDecoderInternalReadChunks(a3_TextureDecoderPNG *png, a3ui32 *idatSize_out, const a3ubyte *data, const a3ui32 size)
+{
+	const a3ubyte *p = data + 8, *end = data + size, *chunk;
+	a3ubyte *idat = 0, *tmp;
+	a3ui32 idatSize = 0, chunkSize, i;
+	a3boolean done = 0;
+
+	while (!done && p + 12 <= end)
+	{
+		chunkSize = a3textureDecoderInternalBigEndian(p);
+		chunk = p + 8;
+		if (chunkSize > (a3ui32)(end - chunk) - 4)
+			break;
+		switch (a3textureDecoderInternalBigEndian(p + 4))
+		{
+		case 0x49484452:	// IHDR
+			if (chunkSize >= 13)
+			{
+				png->width = a3textureDecoderInternalBigEndian(chunk);
+				png->height = a3textureDecoderInternalBigEndian(chunk + 4);
+				png->depth = chunk[8];
+				png->colorType = chunk[9];
+				png->interlace = chunk[12];
+			}
+			break;
+		case 0x504C5445:	// PLTE
+			png->paletteCount = chunkSize / 3 <= 256 ? chunkSize / 3 : 256;
+			for (i = 0; i < png->paletteCount; ++i)
+			{
+				png->palette[i][0] = chunk[i * 3 + 0];
+				png->palette[i][1] = chunk[i * 3 + 1];
+				png->palette[i][2] = chunk[i * 3 + 2];
+				png->palette[i][3] = 0xFF;
+			}
+			break;
+		case 0x74524E53:	// tRNS
+			if (png->colorType == 3)
+				for (i = 0; i < chunkSize && i < 256; ++i)
+					png->palette[i][3] = chunk[i];
+			else if (png->colorType == 0 && chunkSize >= 2)
+			{
+				png->key[0] = (a3ui16)((chunk[0] << 8) | chunk[1]);
+				png->hasKey = 1;
+			}
+			else if (png->colorType == 2 && chunkSize >= 6)
+			{
+				for (i = 0; i < 3; ++i)
+					png->key[i] = (a3ui16)((chunk[i * 2] << 8) | chunk[i * 2 + 1]);
+				png->hasKey = 1;
+			}
+			break;
+		case 0x49444154:	// IDAT
+			tmp = (a3ubyte *)realloc(idat, idatSize + chunkSize);
+			if (tmp)
+			{
+				idat = tmp;
+				memcpy(idat + idatSize, chunk, chunkSize);
+				idatSize += chunkSize;
+			}
+			else
+				done = 1;
+			break;
+		case 0x49454E44:	// IEND
+			done = 1;
+			break;
+		}
+		p = chunk + chunkSize + 4;
+	}
+	*idatSize_out = idatSize;
+	return idat;
+}
+
+// input channel count if header describes a supported image, otherwise 0; 
+//	interlaced images are left to the image library
+inline a3ui32 a3textureDecoderInternalValidatePNG(const a3_TextureDecoderPNG *png)
+{
+	const a3ui32 d = png->depth;
+	if (!png->width || !png->height || png->width > 0x8000 || png->height > 0x8000 || png->interlace)
+		return 0;
+	switch (png->colorType)
+	{
+	case 0:
+		return (d == 1 || d == 2 || d == 4 || d == 8 || d == 16) ? 1 : 0;
+	case 3:
+		return (png->paletteCount && (d == 1 || d == 2 || d == 4 || d == 8)) ? 1 : 0;
+	case 2:
+		return (d == 8 || d == 16) ? 3 : 0;
+	case 4:
+		return (d == 8 || d == 16) ? 2 : 0;
+	case 6:
+		return (d == 8 || d == 16) ? 4 : 0;
+	}
+	return 0;
+}
+
+inline a3ret a3textureDecoderInternalPNG(a3_TextureStreamImage *image_out, const a3ubyte *data, const a3ui32 size)
+{
+	static const a3ubyte signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	a3_TextureDecoderPNG png[1] = { 0 };
+	a3ubyte *idat, *raw, *pixels, *row = 0, *prev, *zeroRow;
+	a3ui32 idatSize, i, channelsIn, channelsOut, bytesOut, bpp, rowSize, outRowSize, y;
+	a3ret ret = 0;
+
+	if (size < 8 || memcmp(data, signature, 8))
+		return 0;
+
+	idat = a3textureDecoderInternalReadChunks(png, &idatSize, data, size);
+	channelsIn = a3textureDecoderInternalValidatePNG(png);
+	if (idat && channelsIn)
+	{
+		// output matches a3textureCreateFromFile: rgb or rgba, 8 or 16 
+		//	bits; palette alpha counts only if some entry is not opaque
+		channelsOut = png->colorType == 4 || png->colorType == 6 || png->hasKey ? 4 : 3;
+		if (png->colorType == 3)
+			for (i = 0; i < png->paletteCount && channelsOut == 3; ++i)
+				channelsOut = png->palette[i][3] != 0xFF ? 4 : 3;
+		bytesOut = png->depth == 16 ? 2 : 1;
+		bpp = (channelsIn * png->depth + 7) / 8;
+		rowSize = (png->width * channelsIn * png->depth + 7) / 8;
+		outRowSize = png->width * channelsOut * bytesOut;
+
+		raw = (a3ubyte *)malloc((rowSize + 1) * png->height);
+		pixels = (a3ubyte *)malloc(outRowSize * png->height);
+		zeroRow = (a3ubyte *)calloc(rowSize, 1);
+		if (raw && pixels && zeroRow && a3textureDecoderInternalInflate(raw, (rowSize + 1) * png->height, idat, idatSize))
+		{
+			// unfilter in place and write rows bottom first
+			for (prev = zeroRow, y = 0; y < png->height; ++y, prev = row)
+			{
+				row = raw + y * (rowSize + 1) + 1;
+				if (!a3textureDecoderInternalUnfilter(row, prev, rowSize, bpp, row[-1]))
+					break;
+				a3textureDecoderInternalConvertRow(pixels + (png->height - 1 - y) * outRowSize, row, png, channelsOut);
+			}
+			if (y == png->height)
+			{
+				image_out->pixels = (a3byte *)pixels;
+				image_out->width = png->width;
+				image_out->height = png->height;
+				image_out->channels = channelsOut;
+				image_out->bytes = bytesOut;
+				pixels = 0;
+				ret = 1;
+			}
+		}
+		free(zeroRow);
+		free(pixels);
+		free(raw);
+	}
+	free(idat);
+	return ret;
+}
+
+
+//-----------------------------------------------------------------------------
+// TGA
+
+inline a3ret a3textureDecoderInternalTGA(a3_TextureStreamImage *image_out, const a3ubyte *data, const a3ui32 size)
+{
+	const a3ubyte *p, *end = data + size;
+	a3ubyte *pixels, *dst, pixel[4] = { 0 };
+	a3ui32 type, depth, width, height, bpp, channels, count, total, i, n, x, y, packet;
+	a3boolean rle, topFirst;
+
+	if (size < 18)
+		return 0;
+	type = data[2];
+	rle = type >= 9;
+	width = data[12] | (data[13] << 8);
+	height = data[14] | (data[15] << 8);
+	depth = data[16];
+	topFirst = (data[17] >> 5) & 1;
+
+	// true color or grey, no color map use, left-to-right pixels only
+	if ((type != 2 && type != 3 && type != 10 && type != 11) || data[1] > 1 || (data[17] & 0x10) ||
+		!width || !height || (depth != 8 && depth != 24 && depth != 32) || ((type & 3) == 3) != (depth == 8))
+		return 0;
+
+	// skip id and (unused) color map
+	p = data + 18 + data[0];
+	if (data[1])
+		p += (data[5] | (data[6] << 8)) * ((data[7] + 7) / 8);
+	if (p > end)
+		return 0;
+
+	bpp = depth / 8;
+	channels = depth == 32 ? 4 : 3;
+	total = width * height;
+	pixels = (a3ubyte *)malloc(total * channels);
+	if (!pixels)
+		return 0;
+
+	for (i = count = packet = 0; i < total; ++i)
+	{
+		// next raw pixel, or the repeated pixel of a run
+		if (!count)
+		{
+			if (rle)
+			{
+				if (p >= end)
+					break;
+				packet = *(p++);
+				count = (packet & 0x7F) + 1;
+			}
+			else
+				count = total;
+		}
+		if (!rle || !(packet & 0x80) || (packet & 0x7F) + 1 == count)
+		{
+			if (p + bpp > end)
+				break;
+			if (bpp == 1)
+				pixel[0] = pixel[1] = pixel[2] = p[0];
+			else
+			{
+				pixel[0] = p[2];
+				pixel[1] = p[1];
+				pixel[2] = p[0];
+				pixel[3] = bpp == 4 ? p[3] : 0xFF;
+			}
+			p += bpp;
+		}
+		--count;
+
+		x = i % width;
+		y = i / width;
+		dst = pixels + ((topFirst ? height - 1 - y : y) * width + x) * channels;
+		for (n = 0; n < channels; ++n)
+			dst[n] = pixel[n];
+	}
+	if (i < total)
+	{
+		free(pixels);
+		return 0;
+	}
+
+	image_out->pixels = (a3byte *)pixels;
+	image_out->width = width;
+	image_out->height = height;
+	image_out->channels = channels;
+	image_out->bytes = 1;
+	return 1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3textureDecodeMemory(a3_TextureStreamImage *image_out, const a3ubyte *data, const a3ui32 size)
+{
+	if (image_out && data)
+	{
+		if (!image_out->pixels)
+		{
+			// PNG has a signature; anything else is tried as TGA
+			if (size >= 8 && data[0] == 0x89 && data[1] == 'P')
+				return a3textureDecoderInternalPNG(image_out, data, size);
+			return a3textureDecoderInternalTGA(image_out, data, size);
+		}
+	}
+	return -1;
+}
+
+a3ret a3textureDecodeFile(a3_TextureStreamImage *image_out, const a3byte *filePath)
+{
+	FILE *fp;
+	a3ubyte *data;
+	long size;
+	a3ret ret = 0;
+	if (image_out && filePath && *filePath)
+	{
+		if (!image_out->pixels)
+		{
+			fp = fopen(filePath, "rb");
+			if (fp)
+			{
+				fseek(fp, 0, SEEK_END);
+				size = ftell(fp);
+				fseek(fp, 0, SEEK_SET);
+				data = size > 0 ? (a3ubyte *)malloc(size) : 0;
+				if (data)
+				{
+					if (fread(data, 1, size, fp) == (size_t)size)
+						ret = a3textureDecodeMemory(image_out, data, (a3ui32)size);
+					free(data);
+				}
+				fclose(fp);
+			}
+			return ret;
+		}
+	}
+	return -1;
+}
+
+a3ret a3textureDecodeRelease(a3_TextureStreamImage *image)
+{
+	if (image)
+	{
+		if (image->pixels)
+		{
+			free(image->pixels);
+			memset(image, 0, sizeof(a3_TextureStreamImage));
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -99,6 +99,14 @@ void a3demo_loadShaders(a3_DemoState* demoState);
 void a3demo_loadTextures(a3_DemoState* demoState);
 void a3demo_loadFramebuffers(a3_DemoState* demoState);
 void a3demo_refresh(a3_DemoState* demoState);
+void a3demo_benchmarkTextureDecode(a3_DemoState* demoState);
+a3ret a3demo_bakeSceneAtlas();
+void a3demo_randomBenchmark(const a3ui32 count);
+void a3demo_fastMathBenchmark(const a3ui32 count);
+void a3curves_benchmarkPath(a3_DemoState* demoState);
+void a3demo_animationBenchmark(const a3ui32 targetCount);
+void a3demo_sceneGraphBenchmark(const a3ui32 nodeCount);
+void a3demo_bvhBenchmark(const a3ui32 itemCount);
 
 // unloading
 void a3demo_unloadGeometry(a3_DemoState* demoState);
@@ -207,6 +215,7 @@ A3DYLIBSYMBOL a3_DemoState *a3demoCB_load(a3_DemoState *demoState, a3boolean hot
 			a3demo_loadShaders(demoState);
 
 			// textures
+			a3textureStreamCreate(demoState->textureStream, 2 * 1024 * 1024, 3, 0);
 			a3demo_loadTextures(demoState);
 
 			// scene objects
@@ -223,7 +232,9 @@ A3DYLIBSYMBOL a3_DemoState *a3demoCB_unload(a3_DemoState *demoState, a3boolean h
 {
 	// release things that need releasing always, whether hotbuilding or not
 	// e.g. kill thread
-	// nothing in this example, but then...
+	// texture stream worker runs code from this library
+	if (demoState && hotbuild)
+		a3textureStreamWait(demoState->textureStream);
 
 	// release persistent state if not hotbuilding
 	// good idea to release in reverse order that things were loaded...
@@ -236,10 +247,19 @@ A3DYLIBSYMBOL a3_DemoState *a3demoCB_unload(a3_DemoState *demoState, a3boolean h
 		{
 			// free fixed objects
 			a3textRelease(demoState->text);
+			a3curvePathRelease(demoState->curvePath);
+			a3demo_animationBlendTreeRelease(demoState->animationTree);
+			a3demo_animationPoseRelease(demoState->animationPose);
+			a3demo_animationClipRelease(demoState->animationClip + 0);
+			a3demo_animationClipRelease(demoState->animationClip + 1);
+			a3demo_sceneGraphRelease(demoState->sceneGraph);
+			a3demo_bvhRelease(demoState->sceneBVH);
+			a3demo_bvhRelease(demoState->lightBVH);
 
 			// free graphics objects
 			a3demo_unloadGeometry(demoState);
 			a3demo_unloadShaders(demoState);
+			a3textureStreamRelease(demoState->textureStream);
 			a3demo_unloadTextures(demoState);
 			a3demo_unloadFramebuffers(demoState);
 
@@ -281,6 +301,10 @@ A3DYLIBSYMBOL a3i32 a3demoCB_idle(a3_DemoState *demoState)
 			a3demo_input(demoState, demoState->renderTimer->secondsPerTick);
 			a3demo_render(demoState);
 
+			// fence skin palettes written this frame after every draw 
+			//	reading them has been issued
+			a3skinPaletteRingEndFrame(demoState->skinPaletteRing);
+
 			// update input
 			a3mouseUpdate(demoState->mouse);
 			a3keyboardUpdate(demoState->keyboard);
@@ -430,6 +454,47 @@ A3DYLIBSYMBOL void a3demoCB_keyCharPress(a3_DemoState *demoState, a3i32 asciiKey
 		a3demo_unloadShaders(demoState);
 		a3demo_loadShaders(demoState);
 		break;
+
+
+		// bake scene atlases from their sources (offline); used on next load
+	case '0':
+		a3demo_bakeSceneAtlas();
+		break;
+
+		// compare texture decoders (console output)
+	case 'Y':
+		a3demo_benchmarkTextureDecode(demoState);
+		break;
+
+		// compare random number generators (console output)
+	case 'R':
+		a3demo_randomBenchmark(1 << 22);
+		break;
+
+		// compare trig and square root implementations (console output)
+	case 'M':
+		a3demo_fastMathBenchmark(1 << 20);
+		break;
+
+		// compare curve follower placement (console output)
+	case '1':
+		a3curves_benchmarkPath(demoState);
+		break;
+
+		// compare keyframe clip sampling (console output)
+	case '2':
+		a3demo_animationBenchmark(4096);
+		break;
+
+		// compare world transform propagation (console output)
+	case 'H':
+		a3demo_sceneGraphBenchmark(16384);
+		break;
+
+		// compare scans with spatial hierarchy queries (console output)
+	case '3':
+		a3demo_bvhBenchmark(16384);
+		break;
 	}
 
 
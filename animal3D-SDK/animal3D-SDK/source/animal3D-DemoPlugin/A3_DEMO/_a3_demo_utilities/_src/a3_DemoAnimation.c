@@ -0,0 +1,834 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_DemoAnimation.c
+	Keyframe clip compression, sampling and blending implementations.
+*/
+
+#include "../a3_DemoAnimation.h"
+
+#include "../a3_DemoRandom.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+// largest value of the three smallest unit quaternion components
+#define A3_DEMO_ANIMATION_QUAT_RANGE	0.70710678f
+
+// 15-bit scale for smallest-three components
+#define A3_DEMO_ANIMATION_QUAT_SCALE	(32767.0f * 0.5f / A3_DEMO_ANIMATION_QUAT_RANGE)
+#define A3_DEMO_ANIMATION_QUAT_STEP		(1.0f / A3_DEMO_ANIMATION_QUAT_SCALE)
+
+// largest 16-bit value
+#define A3_DEMO_ANIMATION_VALUE_MAX		65535.0f
+
+
+// normalize quaternion
+inline void a3demo_animationQuatNormalize_internal(a3f32 *q)
+{
+	const a3f32 lenSq = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+	const a3f32 lenInv = lenSq > 0.0f ? 1.0f / sqrtf(lenSq) : 0.0f;
+	q[0] *= lenInv;
+	q[1] *= lenInv;
+	q[2] *= lenInv;
+	q[3] *= lenInv;
+}
+
+// normalized linear interpolation along the shorter arc
+inline void a3demo_animationQuatNlerp_internal(a3f32 *q_out, const a3f32 *q0, const a3f32 *q1, const a3f32 u)
+{
+	const a3f32 u0 = 1.0f - u;
+	const a3f32 u1 = (q0[0] * q1[0] + q0[1] * q1[1] + q0[2] * q1[2] + q0[3] * q1[3]) < 0.0f ? -u : u;
+	q_out[0] = q0[0] * u0 + q1[0] * u1;
+	q_out[1] = q0[1] * u0 + q1[1] * u1;
+	q_out[2] = q0[2] * u0 + q1[2] * u1;
+	q_out[3] = q0[3] * u0 + q1[3] * u1;
+	a3demo_animationQuatNormalize_internal(q_out);
+}
+
+// quaternion product; q_out must not alias inputs
+inline void a3demo_animationQuatProduct_internal(a3f32 *q_out, const a3f32 *qL, const a3f32 *qR)
+{
+	q_out[0] = qL[3] * qR[0] + qL[0] * qR[3] + qL[1] * qR[2] - qL[2] * qR[1];
+	q_out[1] = qL[3] * qR[1] - qL[0] * qR[2] + qL[1] * qR[3] + qL[2] * qR[0];
+	q_out[2] = qL[3] * qR[2] + qL[0] * qR[1] - qL[1] * qR[0] + qL[2] * qR[3];
+	q_out[3] = qL[3] * qR[3] - qL[0] * qR[0] - qL[1] * qR[1] - qL[2] * qR[2];
+}
+
+
+// smallest-three encoding: drop the largest component (made positive, so 
+//	it can be rebuilt from the others), store the rest in cyclic order 
+//	after it and its index in the top bits of the first two values
+inline void a3demo_animationEncodeQuat_internal(a3ui16 *value_out, const a3f32 *q)
+{
+	a3ui32 i, m = 0;
+	a3f32 s, c;
+	for (i = 1; i < 4; ++i)
+		if (fabsf(q[i]) > fabsf(q[m]))
+			m = i;
+	s = q[m] < 0.0f ? -1.0f : 1.0f;
+	for (i = 0; i < 3; ++i)
+	{
+		c = (s * q[(m + i + 1) & 3] + A3_DEMO_ANIMATION_QUAT_RANGE) * A3_DEMO_ANIMATION_QUAT_SCALE + 0.5f;
+		c = c < 0.0f ? 0.0f : c > 32767.0f ? 32767.0f : c;
+		value_out[i] = (a3ui16)c;
+	}
+	value_out[0] |= (a3ui16)((m & 1) << 15);
+	value_out[1] |= (a3ui16)((m >> 1) << 15);
+}
+
+inline void a3demo_animationDecodeQuat_internal(a3f32 *q_out, const a3ui16 *value)
+{
+	const a3ui32 m = (value[0] >> 15) | ((value[1] >> 15) << 1);
+	const a3f32 a = (a3f32)(value[0] & 0x7fff) * A3_DEMO_ANIMATION_QUAT_STEP - A3_DEMO_ANIMATION_QUAT_RANGE;
+	const a3f32 b = (a3f32)(value[1] & 0x7fff) * A3_DEMO_ANIMATION_QUAT_STEP - A3_DEMO_ANIMATION_QUAT_RANGE;
+	const a3f32 c = (a3f32)(value[2]) * A3_DEMO_ANIMATION_QUAT_STEP - A3_DEMO_ANIMATION_QUAT_RANGE;
+	const a3f32 d = 1.0f - a * a - b * b - c * c;
+	q_out[m] = d > 0.0f ? sqrtf(d) : 0.0f;
+	q_out[(m + 1) & 3] = a;
+	q_out[(m + 2) & 3] = b;
+	q_out[(m + 3) & 3] = c;
+}
+
+// decode any key value for its track
+inline void a3demo_animationDecode_internal(a3f32 *v_out, const a3_DemoAnimationTrack *track, const a3ui16 *value, const a3ui32 channel)
+{
+	if (channel == a3demo_animationChannel_rotation)
+		a3demo_animationDecodeQuat_internal(v_out, value);
+	else
+	{
+		v_out[0] = track->base[0] + (a3f32)value[0] * track->step[0];
+		v_out[1] = track->base[1] + (a3f32)value[1] * track->step[1];
+		v_out[2] = track->base[2] + (a3f32)value[2] * track->step[2];
+	}
+}
+
+// interpolate between decoded key values
+inline void a3demo_animationInterpolate_internal(a3f32 *v_out, const a3f32 *v0, const a3f32 *v1, const a3f32 u, const a3ui32 channel)
+{
+	if (channel == a3demo_animationChannel_rotation)
+		a3demo_animationQuatNlerp_internal(v_out, v0, v1, u);
+	else
+	{
+		v_out[0] = v0[0] + (v1[0] - v0[0]) * u;
+		v_out[1] = v0[1] + (v1[1] - v0[1]) * u;
+		v_out[2] = v0[2] + (v1[2] - v0[2]) * u;
+	}
+}
+
+// whether an interpolated value is close enough to the source value; 
+//	rotation tolerance is passed as the cosine of half the angle
+inline a3boolean a3demo_animationWithin_internal(const a3f32 *v, const a3f32 *v_src, const a3f32 tolerance, const a3ui32 channel)
+{
+	a3f32 d[3];
+	if (channel == a3demo_animationChannel_rotation)
+		return (fabsf(v[0] * v_src[0] + v[1] * v_src[1] + v[2] * v_src[2] + v[3] * v_src[3]) >= tolerance);
+	d[0] = v[0] - v_src[0];
+	d[1] = v[1] - v_src[1];
+	d[2] = v[2] - v_src[2];
+	return ((d[0] * d[0] + d[1] * d[1] + d[2] * d[2]) <= tolerance);
+}
+
+// reduce one densely sampled track to keys; returns key count
+inline a3ui32 a3demo_animationReduceTrack_internal(a3_DemoAnimationKey *key_out, a3_DemoAnimationTrack *track_out,
+	const a3f32(*source)[4], const a3ui32 stride, a3f32(*decoded)[4], const a3ui32 frameCount, const a3f32 tolerance, const a3ui32 channel)
+{
+	a3ui32 i, j, f, k, e, best, count;
+	a3f32 nMin, nMax, v[4], u;
+	a3ui16 value[3];
+	a3boolean constant = a3true;
+
+	// quantize every frame, keeping the decoded values for the fit
+	if (channel != a3demo_animationChannel_rotation)
+	{
+		for (j = 0; j < 3; ++j)
+		{
+			nMin = nMax = source[0][j];
+			for (f = 1, i = stride; f < frameCount; ++f, i += stride)
+			{
+				nMin = source[i][j] < nMin ? source[i][j] : nMin;
+				nMax = source[i][j] > nMax ? source[i][j] : nMax;
+			}
+			track_out->base[j] = nMin;
+			track_out->step[j] = (nMax - nMin) / A3_DEMO_ANIMATION_VALUE_MAX;
+		}
+	}
+	else
+	{
+		track_out->base[0] = track_out->base[1] = track_out->base[2] = 0.0f;
+		track_out->step[0] = track_out->step[1] = track_out->step[2] = 0.0f;
+	}
+	for (f = 0, i = 0; f < frameCount; ++f, i += stride)
+	{
+		if (channel == a3demo_animationChannel_rotation)
+			a3demo_animationEncodeQuat_internal(value, source[i]);
+		else for (j = 0; j < 3; ++j)
+		{
+			u = track_out->step[j] > 0.0f ? (source[i][j] - track_out->base[j]) / track_out->step[j] + 0.5f : 0.0f;
+			value[j] = (a3ui16)(u < A3_DEMO_ANIMATION_VALUE_MAX ? u : A3_DEMO_ANIMATION_VALUE_MAX);
+		}
+		key_out[f].frame = (a3ui16)f;
+		key_out[f].value[0] = value[0];
+		key_out[f].value[1] = value[1];
+		key_out[f].value[2] = value[2];
+		a3demo_animationDecode_internal(decoded[f], track_out, value, channel);
+		constant = constant && !memcmp(key_out[f].value, key_out->value, sizeof(key_out->value));
+	}
+	if (constant)
+		return 1;
+
+	// greedy fit: from each kept key, reach as far as interpolation stays 
+	//	within tolerance of every source frame in between
+	for (k = 0, count = 1; k < frameCount - 1; k = best)
+	{
+		for (e = best = k + 1; ++e < frameCount; best = e)
+		{
+			for (f = k + 1; f < e; ++f)
+			{
+				a3demo_animationInterpolate_internal(v, decoded[k], decoded[e], (a3f32)(f - k) / (a3f32)(e - k), channel);
+				if (!a3demo_animationWithin_internal(v, source[f * stride], tolerance, channel))
+					break;
+			}
+			if (f < e)
+				break;
+		}
+		key_out[count++] = key_out[best];
+	}
+	return count;
+}
+
+// find the pair of keys around a frame position and the fraction between 
+//	them; constant tracks pair their only key with itself
+inline const a3_DemoAnimationKey *a3demo_animationFindKey_internal(a3f32 *u_out, a3ui32 *next_out, const a3_DemoAnimationKey *key, const a3ui32 last, const a3f32 frame, a3ui16 *cursor_opt)
+{
+	a3ui32 c, lo, hi;
+	if (last)
+	{
+		if (cursor_opt)
+		{
+			// playback mostly moves forward by less than one key
+			c = *cursor_opt;
+			if (c >= last || (a3f32)key[c].frame > frame)
+				c = 0;
+			while (c + 1 < last && (a3f32)key[c + 1].frame <= frame)
+				++c;
+			*cursor_opt = (a3ui16)c;
+		}
+		else
+		{
+			for (lo = 0, hi = last; hi - lo > 1; )
+			{
+				c = (lo + hi) >> 1;
+				if ((a3f32)key[c].frame <= frame)
+					lo = c;
+				else
+					hi = c;
+			}
+			c = lo;
+		}
+		*u_out = (frame - (a3f32)key[c].frame) / (a3f32)(key[c + 1].frame - key[c].frame);
+		*next_out = 1;
+		return (key + c);
+	}
+	*u_out = 0.0f;
+	*next_out = 0;
+	return key;
+}
+
+// sample position or scale track; interpolates quantized values first so 
+//	only the result is decoded
+inline void a3demo_animationSampleVector_internal(a3f32 *v_out, const a3_DemoAnimationClip *clip, const a3ui32 trackIndex, const a3f32 frame, a3ui16 *cursor_opt)
+{
+	const a3_DemoAnimationTrack *track = clip->track + trackIndex;
+	a3ui32 next;
+	a3f32 u;
+	const a3_DemoAnimationKey *key = a3demo_animationFindKey_internal(&u, &next, clip->key + track->first, track->count - 1, frame, cursor_opt ? cursor_opt + trackIndex : 0);
+	const a3ui16 *v0 = key->value, *v1 = key[next].value;
+	v_out[0] = track->base[0] + ((a3f32)v0[0] + (a3f32)((a3i32)v1[0] - (a3i32)v0[0]) * u) * track->step[0];
+	v_out[1] = track->base[1] + ((a3f32)v0[1] + (a3f32)((a3i32)v1[1] - (a3i32)v0[1]) * u) * track->step[1];
+	v_out[2] = track->base[2] + ((a3f32)v0[2] + (a3f32)((a3i32)v1[2] - (a3i32)v0[2]) * u) * track->step[2];
+}
+
+// sample rotation track
+inline void a3demo_animationSampleRotation_internal(a3f32 *q_out, const a3_DemoAnimationClip *clip, const a3ui32 trackIndex, const a3f32 frame, a3ui16 *cursor_opt)
+{
+	const a3_DemoAnimationTrack *track = clip->track + trackIndex;
+	a3ui32 next;
+	a3f32 u, q0[4], q1[4];
+	const a3_DemoAnimationKey *key = a3demo_animationFindKey_internal(&u, &next, clip->key + track->first, track->count - 1, frame, cursor_opt ? cursor_opt + trackIndex : 0);
+	a3demo_animationDecodeQuat_internal(q0, key->value);
+	if (next)
+	{
+		a3demo_animationDecodeQuat_internal(q1, key[next].value);
+		a3demo_animationQuatNlerp_internal(q_out, q0, q1, u);
+	}
+	else
+	{
+		q_out[0] = q0[0];
+		q_out[1] = q0[1];
+		q_out[2] = q0[2];
+		q_out[3] = q0[3];
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_animationPoseCreate(a3_DemoAnimationPose *pose_out, const a3ui32 count)
+{
+	a3ui32 i;
+	if (pose_out && count)
+	{
+		if (!pose_out->position)
+		{
+			pose_out->position = (a3f32(*)[4])malloc(count * 3 * sizeof(a3f32[4]));
+			if (pose_out->position)
+			{
+				pose_out->rotation = pose_out->position + count;
+				pose_out->scale = pose_out->rotation + count;
+				pose_out->count = count;
+				for (i = 0; i < count; ++i)
+				{
+					pose_out->position[i][0] = pose_out->position[i][1] = pose_out->position[i][2] = pose_out->position[i][3] = 0.0f;
+					pose_out->rotation[i][0] = pose_out->rotation[i][1] = pose_out->rotation[i][2] = 0.0f;
+					pose_out->rotation[i][3] = 1.0f;
+					pose_out->scale[i][0] = pose_out->scale[i][1] = pose_out->scale[i][2] = 1.0f;
+					pose_out->scale[i][3] = 0.0f;
+				}
+				return count;
+			}
+			return 0;
+		}
+	}
+	return -1;
+}
+
+a3ret a3demo_animationPoseRelease(a3_DemoAnimationPose *pose)
+{
+	if (pose)
+	{
+		if (pose->position)
+		{
+			free(pose->position);
+			pose->position = pose->rotation = pose->scale = 0;
+			pose->count = 0;
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_animationPoseApply(a3_DemoSceneObject *sceneObject, const a3_DemoAnimationPose *pose, const a3ui32 count)
+{
+	a3ui32 i, j, k;
+	a3f32 r[3][3], x2, y2, z2, s, sInv;
+	const a3f32 *q, *p;
+	if (sceneObject && pose && count <= pose->count)
+	{
+		for (i = 0; i < count; ++i, ++sceneObject)
+		{
+			// rotation matrix columns from quaternion
+			q = pose->rotation[i];
+			x2 = q[0] + q[0];
+			y2 = q[1] + q[1];
+			z2 = q[2] + q[2];
+			r[0][0] = 1.0f - q[1] * y2 - q[2] * z2;
+			r[0][1] = q[0] * y2 + q[3] * z2;
+			r[0][2] = q[0] * z2 - q[3] * y2;
+			r[1][0] = q[0] * y2 - q[3] * z2;
+			r[1][1] = 1.0f - q[0] * x2 - q[2] * z2;
+			r[1][2] = q[1] * z2 + q[3] * x2;
+			r[2][0] = q[0] * z2 + q[3] * y2;
+			r[2][1] = q[1] * z2 - q[3] * x2;
+			r[2][2] = 1.0f - q[0] * x2 - q[1] * y2;
+
+			// model = translate * rotate * scale, inverse is the reverse: 
+			//	rows of the rotation divided by scale, then undo translation
+			p = pose->position[i];
+			for (j = 0; j < 3; ++j)
+			{
+				s = pose->scale[i][j];
+				sInv = s != 0.0f ? 1.0f / s : 0.0f;
+				for (k = 0; k < 3; ++k)
+				{
+					sceneObject->modelMat.m[j][k] = r[j][k] * s;
+					sceneObject->modelMatInv.m[k][j] = r[j][k] * sInv;
+				}
+				sceneObject->modelMat.m[j][3] = sceneObject->modelMatInv.m[j][3] = 0.0f;
+				sceneObject->modelMat.m[3][j] = p[j];
+				sceneObject->modelMatInv.m[3][j] = -(r[j][0] * p[0] + r[j][1] * p[1] + r[j][2] * p[2]) * sInv;
+			}
+			sceneObject->modelMat.m[3][3] = sceneObject->modelMatInv.m[3][3] = 1.0f;
+			sceneObject->position.x = p[0];
+			sceneObject->position.y = p[1];
+			sceneObject->position.z = p[2];
+		}
+		return count;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_animationClipCreate(a3_DemoAnimationClip *clip_out, const a3_DemoAnimationPose *source, const a3ui32 frameCount, const a3f32 frameRate,
+	const a3f32 tolerancePosition, const a3f32 toleranceRotation, const a3f32 toleranceScale)
+{
+	a3_DemoAnimationKey *keys;
+	a3_DemoAnimationTrack *tracks;
+	a3f32(*decoded)[4], tolerance[a3demo_animationChannel_max];
+	const a3f32(*channelSource)[4];
+	a3ui32 targetCount, trackCount, keyCount, i, c, t;
+
+	if (clip_out && source && source->position && frameCount >= 2 && frameCount <= 65536 && frameRate > 0.0f
+		&& source->count >= frameCount && source->count % frameCount == 0)
+	{
+		if (!clip_out->track)
+		{
+			targetCount = source->count / frameCount;
+			trackCount = targetCount * a3demo_animationChannel_max;
+
+			// worst case every frame is a key; compacted after
+			tracks = (a3_DemoAnimationTrack *)malloc(trackCount * sizeof(a3_DemoAnimationTrack));
+			keys = (a3_DemoAnimationKey *)malloc(trackCount * frameCount * sizeof(a3_DemoAnimationKey));
+			decoded = (a3f32(*)[4])malloc(frameCount * sizeof(a3f32[4]));
+			if (tracks && keys && decoded)
+			{
+				tolerance[a3demo_animationChannel_position] = tolerancePosition * tolerancePosition;
+				tolerance[a3demo_animationChannel_rotation] = cosf(toleranceRotation * 0.5f);
+				tolerance[a3demo_animationChannel_scale] = toleranceScale * toleranceScale;
+				for (i = t = keyCount = 0; i < targetCount; ++i)
+				{
+					for (c = 0; c < a3demo_animationChannel_max; ++c, ++t)
+					{
+						channelSource = (c == a3demo_animationChannel_position ? source->position
+							: c == a3demo_animationChannel_rotation ? source->rotation : source->scale) + i;
+						tracks[t].first = keyCount;
+						tracks[t].count = a3demo_animationReduceTrack_internal(keys + keyCount, tracks + t,
+							channelSource, targetCount, decoded, frameCount, tolerance[c], c);
+						keyCount += tracks[t].count;
+					}
+				}
+
+				// tracks and keys in one block
+				clip_out->track = (a3_DemoAnimationTrack *)malloc(trackCount * sizeof(a3_DemoAnimationTrack) + keyCount * sizeof(a3_DemoAnimationKey));
+				if (clip_out->track)
+				{
+					clip_out->key = (a3_DemoAnimationKey *)(clip_out->track + trackCount);
+					memcpy(clip_out->track, tracks, trackCount * sizeof(a3_DemoAnimationTrack));
+					memcpy(clip_out->key, keys, keyCount * sizeof(a3_DemoAnimationKey));
+					clip_out->frameRate = frameRate;
+					clip_out->duration = (a3f32)(frameCount - 1) / frameRate;
+					clip_out->frameCount = frameCount;
+					clip_out->targetCount = targetCount;
+					clip_out->keyCount = keyCount;
+				}
+			}
+			free(tracks);
+			free(keys);
+			free(decoded);
+			return (clip_out->track ? clip_out->keyCount : 0);
+		}
+	}
+	return -1;
+}
+
+a3ret a3demo_animationClipRelease(a3_DemoAnimationClip *clip)
+{
+	if (clip)
+	{
+		if (clip->track)
+		{
+			free(clip->track);
+			memset(clip, 0, sizeof(a3_DemoAnimationClip));
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_animationClipSample(a3_DemoAnimationPose *pose_out, const a3_DemoAnimationClip *clip, const a3f32 time, a3ui16 *cursor_opt)
+{
+	a3ui32 i, t;
+	a3f32 frame;
+	if (pose_out && clip && clip->track && pose_out->count >= clip->targetCount)
+	{
+		// wrap time into the loop
+		frame = fmodf(time, clip->duration);
+		frame = (frame < 0.0f ? frame + clip->duration : frame) * clip->frameRate;
+		if (!(frame < (a3f32)(clip->frameCount - 1)))
+			frame = 0.0f;
+
+		for (i = t = 0; i < clip->targetCount; ++i, t += a3demo_animationChannel_max)
+		{
+			a3demo_animationSampleVector_internal(pose_out->position[i], clip, t + a3demo_animationChannel_position, frame, cursor_opt);
+			a3demo_animationSampleRotation_internal(pose_out->rotation[i], clip, t + a3demo_animationChannel_rotation, frame, cursor_opt);
+			a3demo_animationSampleVector_internal(pose_out->scale[i], clip, t + a3demo_animationChannel_scale, frame, cursor_opt);
+		}
+		return clip->targetCount;
+	}
+	return -1;
+}
+
+a3ret a3demo_animationClipSaveBinary(const a3_DemoAnimationClip *clip, const a3_FileStream *fileStream)
+{
+	FILE *fp;
+	a3ui32 ret = 0;
+	if (clip && fileStream)
+	{
+		if (clip->track)
+		{
+			fp = fileStream->stream;
+			if (fp)
+			{
+				ret += (a3ui32)fwrite(&clip->frameRate, 1, sizeof(a3f32), fp);
+				ret += (a3ui32)fwrite(&clip->frameCount, 1, sizeof(a3ui32), fp);
+				ret += (a3ui32)fwrite(&clip->targetCount, 1, sizeof(a3ui32), fp);
+				ret += (a3ui32)fwrite(&clip->keyCount, 1, sizeof(a3ui32), fp);
+				ret += (a3ui32)fwrite(clip->track, 1, sizeof(a3_DemoAnimationTrack) * clip->targetCount * a3demo_animationChannel_max, fp);
+				ret += (a3ui32)fwrite(clip->key, 1, sizeof(a3_DemoAnimationKey) * clip->keyCount, fp);
+			}
+			return ret;
+		}
+	}
+	return -1;
+}
+
+a3ret a3demo_animationClipLoadBinary(a3_DemoAnimationClip *clip, const a3_FileStream *fileStream)
+{
+	FILE *fp;
+	a3ui32 ret = 0, trackCount;
+	if (clip && fileStream)
+	{
+		if (!clip->track)
+		{
+			fp = fileStream->stream;
+			if (fp)
+			{
+				ret += (a3ui32)fread(&clip->frameRate, 1, sizeof(a3f32), fp);
+				ret += (a3ui32)fread(&clip->frameCount, 1, sizeof(a3ui32), fp);
+				ret += (a3ui32)fread(&clip->targetCount, 1, sizeof(a3ui32), fp);
+				ret += (a3ui32)fread(&clip->keyCount, 1, sizeof(a3ui32), fp);
+				trackCount = clip->targetCount * a3demo_animationChannel_max;
+				if (clip->frameRate > 0.0f && clip->frameCount >= 2 && clip->keyCount >= trackCount)
+				{
+					clip->track = (a3_DemoAnimationTrack *)malloc(trackCount * sizeof(a3_DemoAnimationTrack) + clip->keyCount * sizeof(a3_DemoAnimationKey));
+					if (clip->track)
+					{
+						clip->key = (a3_DemoAnimationKey *)(clip->track + trackCount);
+						clip->duration = (a3f32)(clip->frameCount - 1) / clip->frameRate;
+						ret += (a3ui32)fread(clip->track, 1, sizeof(a3_DemoAnimationTrack) * trackCount, fp);
+						ret += (a3ui32)fread(clip->key, 1, sizeof(a3_DemoAnimationKey) * clip->keyCount, fp);
+					}
+				}
+			}
+			return ret;
+		}
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// blend every target from one pose to another
+inline void a3demo_animationBlend_internal(a3_DemoAnimationPose *pose_out, const a3_DemoAnimationPose *pose0, const a3_DemoAnimationPose *pose1, const a3f32 u, const a3ui32 count)
+{
+	a3ui32 i, j;
+	for (i = 0; i < count; ++i)
+	{
+		for (j = 0; j < 3; ++j)
+		{
+			pose_out->position[i][j] = pose0->position[i][j] + (pose1->position[i][j] - pose0->position[i][j]) * u;
+			pose_out->scale[i][j] = pose0->scale[i][j] + (pose1->scale[i][j] - pose0->scale[i][j]) * u;
+		}
+		a3demo_animationQuatNlerp_internal(pose_out->rotation[i], pose0->rotation[i], pose1->rotation[i], u);
+	}
+}
+
+// layer a pose on top of another: offset position, multiply scale, 
+//	rotate in the base's local frame
+inline void a3demo_animationAdd_internal(a3_DemoAnimationPose *pose_out, const a3_DemoAnimationPose *pose0, const a3_DemoAnimationPose *pose1, const a3f32 u, const a3ui32 count)
+{
+	const a3f32 identity[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+	a3f32 q[4];
+	a3ui32 i, j;
+	for (i = 0; i < count; ++i)
+	{
+		for (j = 0; j < 3; ++j)
+		{
+			pose_out->position[i][j] = pose0->position[i][j] + pose1->position[i][j] * u;
+			pose_out->scale[i][j] = pose0->scale[i][j] * (1.0f + (pose1->scale[i][j] - 1.0f) * u);
+		}
+		a3demo_animationQuatNlerp_internal(q, identity, pose1->rotation[i], u);
+		a3demo_animationQuatProduct_internal(pose_out->rotation[i], pose0->rotation[i], q);
+	}
+}
+
+
+a3ret a3demo_animationBlendTreeCreate(a3_DemoAnimationBlendTree *tree_out, const a3ui32 targetCount)
+{
+	if (tree_out && targetCount)
+	{
+		if (!tree_out->targetCount)
+		{
+			memset(tree_out, 0, sizeof(a3_DemoAnimationBlendTree));
+			tree_out->targetCount = targetCount;
+			return 1;
+		}
+	}
+	return -1;
+}
+
+a3ret a3demo_animationBlendTreeAddClip(a3_DemoAnimationBlendTree *tree, const a3_DemoAnimationClip *clip, const a3f32 rate)
+{
+	a3_DemoAnimationNode *node;
+	if (tree && tree->targetCount && clip && clip->track && clip->targetCount == tree->targetCount)
+	{
+		if (tree->nodeCount < a3demo_animationNodeMax)
+		{
+			node = tree->node + tree->nodeCount;
+			node->cursor = (a3ui16 *)calloc(clip->targetCount * a3demo_animationChannel_max, sizeof(a3ui16));
+			if (node->cursor && a3demo_animationPoseCreate(tree->pose + tree->nodeCount, tree->targetCount) > 0)
+			{
+				node->clip = clip;
+				node->time = 0.0f;
+				node->rate = rate;
+				node->weight = 1.0f;
+				node->type = a3demo_animationNode_clip;
+				return tree->nodeCount++;
+			}
+			free(node->cursor);
+			node->cursor = 0;
+			return 0;
+		}
+	}
+	return -1;
+}
+
+a3ret a3demo_animationBlendTreeAddBlend(a3_DemoAnimationBlendTree *tree, const a3_DemoAnimationNodeType type, const a3ui32 input0, const a3ui32 input1, const a3f32 weight)
+{
+	a3_DemoAnimationNode *node;
+	if (tree && tree->targetCount && type != a3demo_animationNode_clip && input0 < tree->nodeCount && input1 < tree->nodeCount)
+	{
+		if (tree->nodeCount < a3demo_animationNodeMax)
+		{
+			node = tree->node + tree->nodeCount;
+			if (a3demo_animationPoseCreate(tree->pose + tree->nodeCount, tree->targetCount) > 0)
+			{
+				node->clip = 0;
+				node->cursor = 0;
+				node->input[0] = input0;
+				node->input[1] = input1;
+				node->weight = weight;
+				node->type = type;
+				return tree->nodeCount++;
+			}
+			return 0;
+		}
+	}
+	return -1;
+}
+
+a3ret a3demo_animationBlendTreeEvaluate(a3_DemoAnimationBlendTree *tree, a3_DemoAnimationPose *pose_out, const a3f64 dt)
+{
+	a3_DemoAnimationNode *node;
+	a3_DemoAnimationPose *pose;
+	a3ui32 i;
+	if (tree && tree->nodeCount && pose_out && pose_out->count >= tree->targetCount)
+	{
+		// inputs come first, so one pass in order evaluates everything; 
+		//	the root writes straight to the output
+		for (i = 0, node = tree->node; i < tree->nodeCount; ++i, ++node)
+		{
+			pose = i + 1 < tree->nodeCount ? tree->pose + i : pose_out;
+			switch (node->type)
+			{
+			case a3demo_animationNode_clip:
+				node->time = fmodf(node->time + (a3f32)dt * node->rate, node->clip->duration);
+				node->time = node->time < 0.0f ? node->time + node->clip->duration : node->time;
+				a3demo_animationClipSample(pose, node->clip, node->time, node->cursor);
+				break;
+			case a3demo_animationNode_blend:
+				a3demo_animationBlend_internal(pose, tree->pose + node->input[0], tree->pose + node->input[1], node->weight, tree->targetCount);
+				break;
+			case a3demo_animationNode_add:
+				a3demo_animationAdd_internal(pose, tree->pose + node->input[0], tree->pose + node->input[1], node->weight, tree->targetCount);
+				break;
+			}
+		}
+		return tree->targetCount;
+	}
+	return -1;
+}
+
+a3ret a3demo_animationBlendTreeRelease(a3_DemoAnimationBlendTree *tree)
+{
+	a3ui32 i;
+	if (tree)
+	{
+		if (tree->targetCount)
+		{
+			for (i = 0; i < tree->nodeCount; ++i)
+			{
+				free(tree->node[i].cursor);
+				a3demo_animationPoseRelease(tree->pose + i);
+			}
+			memset(tree, 0, sizeof(a3_DemoAnimationBlendTree));
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+void a3demo_animationBenchmark(const a3ui32 targetCount)
+{
+	const a3ui32 frameCount = 121, sampleCount = 240;
+	const a3f32 frameRate = 30.0f, sampleStep = 1.0f / 60.0f;
+	a3_DemoAnimationPose source[1] = { 0 }, pose[2][1] = { 0 };
+	a3_DemoAnimationClip clip[1] = { 0 };
+	a3_DemoRandom rng[1];
+	a3_DemoRandomLanes lanes[1];
+	a3_Timer timer[1] = { 0 };
+	a3ui16 *cursor = 0;
+	a3f32 param[12], axis[3], angle, phase, s, frame, u, error[2] = { 0.0f }, d;
+	a3f64 time[4];
+	a3ui32 i, j, f, k, n;
+
+	if (!targetCount
+		|| a3demo_animationPoseCreate(source, targetCount * frameCount) <= 0
+		|| a3demo_animationPoseCreate(pose[0], targetCount) <= 0
+		|| a3demo_animationPoseCreate(pose[1], targetCount) <= 0
+		|| !(cursor = (a3ui16 *)calloc(targetCount * a3demo_animationChannel_max, sizeof(a3ui16))))
+	{
+		a3demo_animationPoseRelease(source);
+		a3demo_animationPoseRelease(pose[0]);
+		a3demo_animationPoseRelease(pose[1]);
+		return;
+	}
+
+	// looping motion per target: whole numbers of bobs and turns per 
+	//	loop around a random axis, some targets never scale
+	a3demo_randomSeed(rng, 2048);
+	a3demo_randomLanesCreate(lanes, rng);
+	for (i = 0; i < targetCount; ++i)
+	{
+		a3demo_randomFillReal(lanes, param, 12, -1.0f, 1.0f);
+		s = 1.0f / sqrtf(param[0] * param[0] + param[1] * param[1] + param[2] * param[2] + 1.0e-6f);
+		axis[0] = param[0] * s;
+		axis[1] = param[1] * s;
+		axis[2] = param[2] * s;
+		for (f = 0; f < frameCount; ++f)
+		{
+			phase = 6.2831853f * (a3f32)f / (a3f32)(frameCount - 1);
+			n = f * targetCount + i;
+			for (j = 0; j < 3; ++j)
+				source->position[n][j] = param[3 + j] * 16.0f + param[6 + j] * sinf(phase * (a3f32)(j + 1) + param[9]);
+			angle = 0.5f * (phase * (a3f32)(1 + (i & 3)) + 0.5f * sinf(phase + param[10]));
+			s = sinf(angle);
+			source->rotation[n][0] = axis[0] * s;
+			source->rotation[n][1] = axis[1] * s;
+			source->rotation[n][2] = axis[2] * s;
+			source->rotation[n][3] = cosf(angle);
+			source->scale[n][0] = source->scale[n][1] = source->scale[n][2] = (i & 1) ? 1.0f + 0.25f * sinf(phase + param[11]) : 1.0f;
+		}
+	}
+
+	a3timerSet(timer, 0.0);
+	a3timerStart(timer);
+	a3demo_animationClipCreate(clip, source, frameCount, frameRate, 0.001f, 0.002f, 0.001f);
+	a3timerUpdate(timer);
+	time[3] = timer->totalTime;
+
+	// same playback three ways: raw frames, compressed with search, 
+	//	compressed with cursors; errors are against the raw frames
+	for (k = 0; k < 3; ++k)
+	{
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		for (j = 0; j < sampleCount; ++j)
+		{
+			if (k == 0)
+			{
+				frame = fmodf((a3f32)j * sampleStep, clip->duration) * frameRate;
+				f = (a3ui32)frame;
+				u = frame - (a3f32)f;
+				if (f >= frameCount - 1)
+					f = 0;
+				for (i = 0, n = f * targetCount; i < targetCount; ++i, ++n)
+				{
+					a3demo_animationInterpolate_internal(pose[0]->position[i], source->position[n], source->position[n + targetCount], u, a3demo_animationChannel_position);
+					a3demo_animationInterpolate_internal(pose[0]->rotation[i], source->rotation[n], source->rotation[n + targetCount], u, a3demo_animationChannel_rotation);
+					a3demo_animationInterpolate_internal(pose[0]->scale[i], source->scale[n], source->scale[n + targetCount], u, a3demo_animationChannel_scale);
+				}
+			}
+			else
+			{
+				a3demo_animationClipSample(pose[1], clip, (a3f32)j * sampleStep, k == 2 ? cursor : 0);
+			}
+		}
+		a3timerUpdate(timer);
+		time[k] = timer->totalTime;
+	}
+
+	// error at the last sampled time
+	for (i = 0; i < targetCount; ++i)
+	{
+		for (j = 0, d = 0.0f; j < 3; ++j)
+			d += (pose[1]->position[i][j] - pose[0]->position[i][j]) * (pose[1]->position[i][j] - pose[0]->position[i][j]);
+		error[0] = d > error[0] ? d : error[0];
+		d = fabsf(pose[1]->rotation[i][0] * pose[0]->rotation[i][0] + pose[1]->rotation[i][1] * pose[0]->rotation[i][1]
+			+ pose[1]->rotation[i][2] * pose[0]->rotation[i][2] + pose[1]->rotation[i][3] * pose[0]->rotation[i][3]);
+		d = 2.0f * acosf(d < 1.0f ? d : 1.0f);
+		error[1] = d > error[1] ? d : error[1];
+	}
+
+	printf("\n\n A3 animation clip benchmark (%u targets, %u frames, %u samples): ", targetCount, frameCount, sampleCount);
+	printf("\n\t raw frames       %9u bytes", (a3ui32)(frameCount * targetCount * 10 * sizeof(a3f32)));
+	printf("\n\t compressed clip  %9u bytes, %u keys (%.1lf%% of frames kept), built in %.1lf ms",
+		(a3ui32)(clip->targetCount * a3demo_animationChannel_max * sizeof(a3_DemoAnimationTrack) + clip->keyCount * sizeof(a3_DemoAnimationKey)),
+		clip->keyCount, 100.0 * (a3f64)clip->keyCount / (a3f64)(frameCount * targetCount * a3demo_animationChannel_max), time[3] * 1000.0);
+	printf("\n\t sample raw       %8.3lf ms", time[0] * 1000.0);
+	printf("\n\t sample search    %8.3lf ms", time[1] * 1000.0);
+	printf("\n\t sample cursor    %8.3lf ms", time[2] * 1000.0);
+	printf("\n\t max error        %.2e units, %.2e radians", sqrtf(error[0]), error[1]);
+	printf("\n");
+
+	a3demo_animationClipRelease(clip);
+	a3demo_animationPoseRelease(source);
+	a3demo_animationPoseRelease(pose[0]);
+	a3demo_animationPoseRelease(pose[1]);
+	free(cursor);
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,925 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoBVH.c
+	Bounding volume hierarchy build, refit and queries.
+*/
+
+#include "../a3_DemoBVH.h"
+
+#include "../a3_DemoRandom.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+// SSE is always available on 64-bit x86 targets
+#if (defined _M_X64 || defined _M_AMD64 || defined __SSE2__)
+#define A3_DEMOBVH_SSE
+#include <xmmintrin.h>
+#endif	// SSE
+
+
+//-----------------------------------------------------------------------------
+
+// items waiting to become a node during build
+typedef struct a3_DemoBVHTask_internal
+{
+	a3ui32 node, first, count, depth;
+} a3_DemoBVHTask_internal;
+
+// node waiting to be visited by a query, and where the ray enters it
+typedef struct a3_DemoBVHVisit_internal
+{
+	a3ui32 node;
+	a3f32 t;
+} a3_DemoBVHVisit_internal;
+
+// frustum planes as four lanes of each component, padded with planes
+//	that every box is inside of
+typedef struct a3_DemoBVHPlanes_internal
+{
+	a3f32 x[a3demo_bvhPlaneMax], y[a3demo_bvhPlaneMax], z[a3demo_bvhPlaneMax], w[a3demo_bvhPlaneMax];
+	a3ui32 packCount;
+} a3_DemoBVHPlanes_internal;
+
+
+// half surface area; only ever compared
+inline a3f32 a3demo_bvhArea_internal(const a3f32 *bMin, const a3f32 *bMax)
+{
+	const a3f32 x = bMax[0] - bMin[0], y = bMax[1] - bMin[1], z = bMax[2] - bMin[2];
+	return (x * y + y * z + z * x);
+}
+
+inline void a3demo_bvhEmpty_internal(a3f32 *bMin, a3f32 *bMax)
+{
+	bMin[0] = bMin[1] = bMin[2] = +FLT_MAX;
+	bMax[0] = bMax[1] = bMax[2] = -FLT_MAX;
+	bMin[3] = bMax[3] = 0.0f;
+}
+
+inline void a3demo_bvhGrow_internal(a3f32 *bMin, a3f32 *bMax, const a3f32 *pMin, const a3f32 *pMax)
+{
+	a3ui32 j;
+	for (j = 0; j < 3; ++j)
+	{
+		bMin[j] = pMin[j] < bMin[j] ? pMin[j] : bMin[j];
+		bMax[j] = pMax[j] > bMax[j] ? pMax[j] : bMax[j];
+	}
+}
+
+// leaves weigh their area by item count, inner nodes by one traversal;
+//	relative to the root so trees of any size compare
+inline a3f32 a3demo_bvhCost_internal(const a3_DemoBVH *bvh)
+{
+	const a3_DemoBVHNode *node = bvh->node;
+	const a3f32 rootArea = a3demo_bvhArea_internal(node->boundsMin, node->boundsMax);
+	a3f32 cost = 0.0f;
+	a3ui32 i;
+	for (i = 0; i < bvh->nodeCount; ++i, ++node)
+		cost += a3demo_bvhArea_internal(node->boundsMin, node->boundsMax) * (node->count ? (a3f32)node->count : 1.0f);
+	return (rootArea > 0.0f ? cost / rootArea : 0.0f);
+}
+
+inline void a3demo_bvhSwap_internal(a3_DemoBVH *bvh, const a3ui32 i, const a3ui32 j)
+{
+	a3f32 b[4];
+	a3ui32 k = bvh->item[i];
+	bvh->item[i] = bvh->item[j];
+	bvh->item[j] = k;
+	memcpy(b, bvh->itemMin[i], sizeof(b));
+	memcpy(bvh->itemMin[i], bvh->itemMin[j], sizeof(b));
+	memcpy(bvh->itemMin[j], b, sizeof(b));
+	memcpy(b, bvh->itemMax[i], sizeof(b));
+	memcpy(bvh->itemMax[i], bvh->itemMax[j], sizeof(b));
+	memcpy(bvh->itemMax[j], b, sizeof(b));
+}
+
+inline void a3demo_bvhPlanes_internal(a3_DemoBVHPlanes_internal *planes, const a3f32(*plane)[4], const a3ui32 planeCount)
+{
+	a3ui32 i;
+	for (i = 0; i < a3demo_bvhPlaneMax; ++i)
+	{
+		planes->x[i] = i < planeCount ? plane[i][0] : 0.0f;
+		planes->y[i] = i < planeCount ? plane[i][1] : 0.0f;
+		planes->z[i] = i < planeCount ? plane[i][2] : 0.0f;
+		planes->w[i] = i < planeCount ? plane[i][3] : 1.0f;
+	}
+	planes->packCount = (planeCount + 3) / 4;
+}
+
+
+#ifdef A3_DEMOBVH_SSE
+
+inline a3f32 a3demo_bvhMax4_internal(__m128 v)
+{
+	v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+	v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+	return _mm_cvtss_f32(v);
+}
+
+inline a3f32 a3demo_bvhMin4_internal(__m128 v)
+{
+	v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+	v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+	return _mm_cvtss_f32(v);
+}
+
+// box against four planes per step: 0 if outside any, 2 if inside all,
+//	1 otherwise; the corner farthest along each normal decides outside,
+//	the nearest decides inside
+inline a3ui32 a3demo_bvhTestFrustum_internal(const a3f32 *bMin, const a3f32 *bMax, const a3_DemoBVHPlanes_internal *planes)
+{
+	const __m128 minX = _mm_set1_ps(bMin[0]), minY = _mm_set1_ps(bMin[1]), minZ = _mm_set1_ps(bMin[2]);
+	const __m128 maxX = _mm_set1_ps(bMax[0]), maxY = _mm_set1_ps(bMax[1]), maxZ = _mm_set1_ps(bMax[2]);
+	const __m128 zero = _mm_setzero_ps();
+	__m128 nx, ny, nz, nw, ax, ay, az, bx, by, bz, d;
+	a3ui32 i, inside = 2;
+	for (i = 0; i < planes->packCount * 4; i += 4)
+	{
+		nx = _mm_loadu_ps(planes->x + i);
+		ny = _mm_loadu_ps(planes->y + i);
+		nz = _mm_loadu_ps(planes->z + i);
+		nw = _mm_loadu_ps(planes->w + i);
+		ax = _mm_mul_ps(nx, minX);
+		bx = _mm_mul_ps(nx, maxX);
+		ay = _mm_mul_ps(ny, minY);
+		by = _mm_mul_ps(ny, maxY);
+		az = _mm_mul_ps(nz, minZ);
+		bz = _mm_mul_ps(nz, maxZ);
+		d = _mm_add_ps(_mm_add_ps(nw, _mm_max_ps(ax, bx)), _mm_add_ps(_mm_max_ps(ay, by), _mm_max_ps(az, bz)));
+		if (_mm_movemask_ps(_mm_cmplt_ps(d, zero)))
+			return 0;
+		d = _mm_add_ps(_mm_add_ps(nw, _mm_min_ps(ax, bx)), _mm_add_ps(_mm_min_ps(ay, by), _mm_min_ps(az, bz)));
+		if (_mm_movemask_ps(_mm_cmplt_ps(d, zero)))
+			inside = 1;
+	}
+	return inside;
+}
+
+// squared distance from sphere center to box, three axes at once;
+//	fourth components are zero on both sides
+inline a3boolean a3demo_bvhTestSphere_internal(const a3f32 *bMin, const a3f32 *bMax, const __m128 center, const a3f32 radiusSq)
+{
+	__m128 d = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(bMin), center), _mm_sub_ps(center, _mm_loadu_ps(bMax))), _mm_setzero_ps());
+	d = _mm_mul_ps(d, d);
+	d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)));
+	d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(1, 0, 3, 2)));
+	return (_mm_cvtss_f32(d) <= radiusSq);
+}
+
+// slab test, three axes at once; fourth lane holds the ray's own range
+//	so it joins the reductions; returns entry distance or FLT_MAX
+inline a3f32 a3demo_bvhTestRay_internal(const a3f32 *bMin, const a3f32 *bMax, const __m128 origin, const __m128 dirInv, const __m128 maskXYZ, const __m128 range)
+{
+	const __m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(bMin), origin), dirInv);
+	const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(bMax), origin), dirInv);
+	const a3f32 tNear = a3demo_bvhMax4_internal(_mm_and_ps(_mm_min_ps(t0, t1), maskXYZ));
+	const a3f32 tFar = a3demo_bvhMin4_internal(_mm_or_ps(_mm_and_ps(_mm_max_ps(t0, t1), maskXYZ), range));
+	return (tNear <= tFar ? tNear : FLT_MAX);
+}
+
+#else	// !A3_DEMOBVH_SSE
+
+inline a3ui32 a3demo_bvhTestFrustum_internal(const a3f32 *bMin, const a3f32 *bMax, const a3_DemoBVHPlanes_internal *planes)
+{
+	a3f32 a, b, dMax, dMin;
+	a3ui32 i, inside = 2;
+	for (i = 0; i < planes->packCount * 4; ++i)
+	{
+		dMax = dMin = planes->w[i];
+		a = planes->x[i] * bMin[0];
+		b = planes->x[i] * bMax[0];
+		dMax += a > b ? a : b;
+		dMin += a < b ? a : b;
+		a = planes->y[i] * bMin[1];
+		b = planes->y[i] * bMax[1];
+		dMax += a > b ? a : b;
+		dMin += a < b ? a : b;
+		a = planes->z[i] * bMin[2];
+		b = planes->z[i] * bMax[2];
+		dMax += a > b ? a : b;
+		dMin += a < b ? a : b;
+		if (dMax < 0.0f)
+			return 0;
+		if (dMin < 0.0f)
+			inside = 1;
+	}
+	return inside;
+}
+
+inline a3boolean a3demo_bvhTestSphere_internal(const a3f32 *bMin, const a3f32 *bMax, const a3f32 *center, const a3f32 radiusSq)
+{
+	a3f32 d, distSq = 0.0f;
+	a3ui32 j;
+	for (j = 0; j < 3; ++j)
+	{
+		d = center[j] < bMin[j] ? bMin[j] - center[j] : center[j] > bMax[j] ? center[j] - bMax[j] : 0.0f;
+		distSq += d * d;
+	}
+	return (distSq <= radiusSq);
+}
+
+inline a3f32 a3demo_bvhTestRay_internal(const a3f32 *bMin, const a3f32 *bMax, const a3f32 *origin, const a3f32 *dirInv, const a3f32 distanceMax)
+{
+	a3f32 t0, t1, tNear = 0.0f, tFar = distanceMax;
+	a3ui32 j;
+	for (j = 0; j < 3; ++j)
+	{
+		t0 = (bMin[j] - origin[j]) * dirInv[j];
+		t1 = (bMax[j] - origin[j]) * dirInv[j];
+		tNear = (t0 < t1 ? t0 : t1) > tNear ? (t0 < t1 ? t0 : t1) : tNear;
+		tFar = (t0 > t1 ? t0 : t1) < tFar ? (t0 > t1 ? t0 : t1) : tFar;
+	}
+	return (tNear <= tFar ? tNear : FLT_MAX);
+}
+
+#endif	// A3_DEMOBVH_SSE
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_bvhCreate(a3_DemoBVH *bvh_out, const a3ui32 capacity)
+{
+	if (bvh_out && capacity)
+	{
+		if (!bvh_out->node)
+		{
+			// at most one node fewer than twice the items
+			bvh_out->node = (a3_DemoBVHNode *)malloc(capacity * 2 * sizeof(a3_DemoBVHNode) + capacity * (2 * sizeof(a3f32[4]) + sizeof(a3ui32)));
+			if (bvh_out->node)
+			{
+				bvh_out->itemMin = (a3f32(*)[4])(bvh_out->node + capacity * 2);
+				bvh_out->itemMax = bvh_out->itemMin + capacity;
+				bvh_out->item = (a3ui32 *)(bvh_out->itemMax + capacity);
+				bvh_out->nodeCount = bvh_out->itemCount = 0;
+				bvh_out->capacity = capacity;
+				bvh_out->cost = bvh_out->costBuilt = 0.0f;
+				return capacity;
+			}
+			return 0;
+		}
+	}
+	return -1;
+}
+
+a3ret a3demo_bvhRelease(a3_DemoBVH *bvh)
+{
+	if (bvh)
+	{
+		if (bvh->node)
+		{
+			free(bvh->node);
+			memset(bvh, 0, sizeof(a3_DemoBVH));
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_bvhBuild(a3_DemoBVH *bvh, const a3f32(*boundsMin)[4], const a3f32(*boundsMax)[4], const a3ui32 count)
+{
+	a3_DemoBVHTask_internal task[a3demo_bvhDepthMax], t;
+	a3_DemoBVHNode *node;
+	a3f32 binMin[a3demo_bvhBinCount][4], binMax[a3demo_bvhBinCount][4];
+	a3f32 rightArea[a3demo_bvhBinCount];
+	a3ui32 binItems[a3demo_bvhBinCount], rightItems[a3demo_bvhBinCount];
+	a3f32 cMin[4], cMax[4], bMin[4], bMax[4], c, scale, cost, costBest;
+	a3ui32 i, j, b, n, axis, split, left, top;
+
+	if (bvh && bvh->node && boundsMin && boundsMax && count && count <= bvh->capacity)
+	{
+		for (i = 0; i < count; ++i)
+		{
+			bvh->item[i] = i;
+			for (j = 0; j < 3; ++j)
+			{
+				bvh->itemMin[i][j] = boundsMin[i][j];
+				bvh->itemMax[i][j] = boundsMax[i][j];
+			}
+			bvh->itemMin[i][3] = bvh->itemMax[i][3] = 0.0f;
+		}
+		bvh->itemCount = count;
+		bvh->nodeCount = 1;
+
+		task[0].node = task[0].first = task[0].depth = 0;
+		task[0].count = count;
+		top = 1;
+		while (top)
+		{
+			t = task[--top];
+			node = bvh->node + t.node;
+			a3demo_bvhEmpty_internal(node->boundsMin, node->boundsMax);
+			a3demo_bvhEmpty_internal(cMin, cMax);
+			for (i = t.first; i < t.first + t.count; ++i)
+			{
+				a3demo_bvhGrow_internal(node->boundsMin, node->boundsMax, bvh->itemMin[i], bvh->itemMax[i]);
+				for (j = 0; j < 3; ++j)
+				{
+					c = bvh->itemMin[i][j] + bvh->itemMax[i][j];
+					cMin[j] = c < cMin[j] ? c : cMin[j];
+					cMax[j] = c > cMax[j] ? c : cMax[j];
+				}
+			}
+			node->first = t.first;
+			node->count = t.count;
+
+			// split along the widest spread of centers (doubled), unless
+			//	the node is small, too deep or its centers all coincide
+			axis = (cMax[1] - cMin[1] > cMax[0] - cMin[0]) ? 1 : 0;
+			axis = (cMax[2] - cMin[2] > cMax[axis] - cMin[axis]) ? 2 : axis;
+			if (t.count <= a3demo_bvhLeafMax || t.depth + 1 >= a3demo_bvhDepthMax || cMax[axis] <= cMin[axis])
+				continue;
+
+			// bin item centers, then sweep the candidate splits: areas and
+			//	counts to the right first, then to the left
+			scale = (a3f32)a3demo_bvhBinCount / (cMax[axis] - cMin[axis]);
+			for (b = 0; b < a3demo_bvhBinCount; ++b)
+			{
+				a3demo_bvhEmpty_internal(binMin[b], binMax[b]);
+				binItems[b] = 0;
+			}
+			for (i = t.first; i < t.first + t.count; ++i)
+			{
+				b = (a3ui32)((bvh->itemMin[i][axis] + bvh->itemMax[i][axis] - cMin[axis]) * scale);
+				b = b < a3demo_bvhBinCount ? b : a3demo_bvhBinCount - 1;
+				a3demo_bvhGrow_internal(binMin[b], binMax[b], bvh->itemMin[i], bvh->itemMax[i]);
+				++binItems[b];
+			}
+			a3demo_bvhEmpty_internal(bMin, bMax);
+			for (b = a3demo_bvhBinCount - 1, n = 0; b > 0; --b)
+			{
+				a3demo_bvhGrow_internal(bMin, bMax, binMin[b], binMax[b]);
+				n += binItems[b];
+				rightItems[b - 1] = n;
+				rightArea[b - 1] = n ? a3demo_bvhArea_internal(bMin, bMax) : 0.0f;
+			}
+			a3demo_bvhEmpty_internal(bMin, bMax);
+			costBest = FLT_MAX;
+			for (b = split = 0, n = 0; b + 1 < a3demo_bvhBinCount; ++b)
+			{
+				a3demo_bvhGrow_internal(bMin, bMax, binMin[b], binMax[b]);
+				n += binItems[b];
+				cost = (n ? a3demo_bvhArea_internal(bMin, bMax) * (a3f32)n : 0.0f) + rightArea[b] * (a3f32)rightItems[b];
+				if (n && rightItems[b] && cost < costBest)
+				{
+					costBest = cost;
+					split = b;
+				}
+			}
+
+			// partition around the split; if binning could not separate
+			//	anything, halve the range instead
+			for (i = t.first, j = t.first + t.count; i < j;)
+			{
+				b = (a3ui32)((bvh->itemMin[i][axis] + bvh->itemMax[i][axis] - cMin[axis]) * scale);
+				b = b < a3demo_bvhBinCount ? b : a3demo_bvhBinCount - 1;
+				if (b <= split)
+					++i;
+				else
+					a3demo_bvhSwap_internal(bvh, i, --j);
+			}
+			left = i - t.first;
+			if (!left || left == t.count)
+				left = t.count / 2;
+
+			// children are the next two nodes; left is built first
+			node->first = bvh->nodeCount;
+			node->count = 0;
+			bvh->nodeCount += 2;
+			task[top].node = node->first + 1;
+			task[top].first = t.first + left;
+			task[top].count = t.count - left;
+			task[top].depth = t.depth + 1;
+			++top;
+			task[top].node = node->first;
+			task[top].first = t.first;
+			task[top].count = left;
+			task[top].depth = t.depth + 1;
+			++top;
+		}
+
+		bvh->cost = bvh->costBuilt = a3demo_bvhCost_internal(bvh);
+		return bvh->nodeCount;
+	}
+	return -1;
+}
+
+a3ret a3demo_bvhRefit(a3_DemoBVH *bvh, const a3f32(*boundsMin)[4], const a3f32(*boundsMax)[4])
+{
+	a3_DemoBVHNode *node;
+	a3ui32 i, j;
+	if (bvh && bvh->node && boundsMin && boundsMax)
+	{
+		for (i = 0; i < bvh->itemCount; ++i)
+			for (j = 0; j < 3; ++j)
+			{
+				bvh->itemMin[i][j] = boundsMin[bvh->item[i]][j];
+				bvh->itemMax[i][j] = boundsMax[bvh->item[i]][j];
+			}
+
+		// children are always later than their parent
+		for (i = bvh->nodeCount, node = bvh->node + i; i > 0; --i)
+		{
+			--node;
+			a3demo_bvhEmpty_internal(node->boundsMin, node->boundsMax);
+			if (node->count)
+			{
+				for (j = node->first; j < node->first + node->count; ++j)
+					a3demo_bvhGrow_internal(node->boundsMin, node->boundsMax, bvh->itemMin[j], bvh->itemMax[j]);
+			}
+			else
+			{
+				a3demo_bvhGrow_internal(node->boundsMin, node->boundsMax, bvh->node[node->first].boundsMin, bvh->node[node->first].boundsMax);
+				a3demo_bvhGrow_internal(node->boundsMin, node->boundsMax, bvh->node[node->first + 1].boundsMin, bvh->node[node->first + 1].boundsMax);
+			}
+		}
+
+		bvh->cost = a3demo_bvhCost_internal(bvh);
+		return bvh->nodeCount;
+	}
+	return -1;
+}
+
+a3ret a3demo_bvhSphereBounds(a3f32 *boundsMin_out, a3f32 *boundsMax_out, const a3f32 *center, const a3f32 radius)
+{
+	if (boundsMin_out && boundsMax_out && center)
+	{
+		boundsMin_out[0] = center[0] - radius;
+		boundsMin_out[1] = center[1] - radius;
+		boundsMin_out[2] = center[2] - radius;
+		boundsMax_out[0] = center[0] + radius;
+		boundsMax_out[1] = center[1] + radius;
+		boundsMax_out[2] = center[2] + radius;
+		boundsMin_out[3] = boundsMax_out[3] = 0.0f;
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3demo_bvhFrustumPlanes(a3f32(*plane_out)[4], const a3real4x4p viewProjectionMat)
+{
+	// rows of clip transform: -w <= x, y, z <= +w
+	const a3f32 sign[6] = { +1.0f, -1.0f, +1.0f, -1.0f, -1.0f, +1.0f };
+	const a3ui32 row[6] = { 0, 0, 1, 1, 2, 2 };
+	a3f32 lenInv;
+	a3ui32 i, j;
+	if (plane_out && viewProjectionMat)
+	{
+		for (i = 0; i < 6; ++i)
+		{
+			for (j = 0; j < 4; ++j)
+				plane_out[i][j] = (a3f32)(viewProjectionMat[j][3] + sign[i] * viewProjectionMat[j][row[i]]);
+			lenInv = sqrtf(plane_out[i][0] * plane_out[i][0] + plane_out[i][1] * plane_out[i][1] + plane_out[i][2] * plane_out[i][2]);
+			lenInv = lenInv > 0.0f ? 1.0f / lenInv : 0.0f;
+			for (j = 0; j < 4; ++j)
+				plane_out[i][j] *= lenInv;
+		}
+		return 6;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_bvhQueryFrustum(const a3_DemoBVH *bvh, a3ui32 *item_out, const a3ui32 itemMax, const a3f32(*plane)[4], const a3ui32 planeCount)
+{
+	a3_DemoBVHPlanes_internal planes[1];
+	a3_DemoBVHVisit_internal stack[a3demo_bvhDepthMax];
+	const a3_DemoBVHNode *node;
+	a3ui32 i, top, inside, found = 0;
+
+	if (bvh && bvh->node && item_out && plane && planeCount <= a3demo_bvhPlaneMax)
+	{
+		if (!bvh->nodeCount)
+			return 0;
+		a3demo_bvhPlanes_internal(planes, plane, planeCount);
+
+		// once a node is inside every plane, so is everything below it;
+		//	't' carries that flag
+		stack[0].node = 0;
+		stack[0].t = 0.0f;
+		top = 1;
+		while (top)
+		{
+			--top;
+			node = bvh->node + stack[top].node;
+			inside = stack[top].t > 0.0f ? 2 : a3demo_bvhTestFrustum_internal(node->boundsMin, node->boundsMax, planes);
+			if (!inside)
+				continue;
+			if (node->count)
+			{
+				for (i = node->first; i < node->first + node->count; ++i)
+					if (inside == 2 || a3demo_bvhTestFrustum_internal(bvh->itemMin[i], bvh->itemMax[i], planes))
+					{
+						if (found < itemMax)
+							item_out[found] = bvh->item[i];
+						++found;
+					}
+			}
+			else
+			{
+				stack[top].node = node->first + 1;
+				stack[top].t = inside == 2 ? 1.0f : 0.0f;
+				++top;
+				stack[top].node = node->first;
+				stack[top].t = inside == 2 ? 1.0f : 0.0f;
+				++top;
+			}
+		}
+		return found;
+	}
+	return -1;
+}
+
+a3ret a3demo_bvhQuerySphere(const a3_DemoBVH *bvh, a3ui32 *item_out, const a3ui32 itemMax, const a3f32 *center, const a3f32 radius)
+{
+	a3ui32 stack[a3demo_bvhDepthMax];
+	const a3_DemoBVHNode *node;
+	const a3f32 radiusSq = radius * radius;
+	a3ui32 i, top, found = 0;
+#ifdef A3_DEMOBVH_SSE
+	__m128 c;
+#else	// !A3_DEMOBVH_SSE
+	const a3f32 *c = center;
+#endif	// A3_DEMOBVH_SSE
+
+	if (bvh && bvh->node && item_out && center)
+	{
+		if (!bvh->nodeCount)
+			return 0;
+#ifdef A3_DEMOBVH_SSE
+		c = _mm_set_ps(0.0f, center[2], center[1], center[0]);
+#endif	// A3_DEMOBVH_SSE
+
+		stack[0] = 0;
+		top = 1;
+		while (top)
+		{
+			node = bvh->node + stack[--top];
+			if (!a3demo_bvhTestSphere_internal(node->boundsMin, node->boundsMax, c, radiusSq))
+				continue;
+			if (node->count)
+			{
+				for (i = node->first; i < node->first + node->count; ++i)
+					if (a3demo_bvhTestSphere_internal(bvh->itemMin[i], bvh->itemMax[i], c, radiusSq))
+					{
+						if (found < itemMax)
+							item_out[found] = bvh->item[i];
+						++found;
+					}
+			}
+			else
+			{
+				stack[top++] = node->first + 1;
+				stack[top++] = node->first;
+			}
+		}
+		return found;
+	}
+	return -1;
+}
+
+a3ret a3demo_bvhQueryRay(const a3_DemoBVH *bvh, a3f32 *distance_out_opt, const a3f32 *origin, const a3f32 *direction, const a3f32 distanceMax)
+{
+	a3_DemoBVHVisit_internal stack[a3demo_bvhDepthMax], v0, v1, v;
+	const a3_DemoBVHNode *node;
+	a3f32 dirInv[4], tBest = distanceMax, t;
+	a3ui32 i, top;
+	a3ret hit = -1;
+#ifdef A3_DEMOBVH_SSE
+	__m128 o, d, maskXYZ;
+#define a3demo_bvhRay_internal(bMin, bMax, tMax) a3demo_bvhTestRay_internal(bMin, bMax, o, d, maskXYZ, _mm_set_ps(tMax, 0.0f, 0.0f, 0.0f))
+#else	// !A3_DEMOBVH_SSE
+#define a3demo_bvhRay_internal(bMin, bMax, tMax) a3demo_bvhTestRay_internal(bMin, bMax, origin, dirInv, tMax)
+#endif	// A3_DEMOBVH_SSE
+
+	if (bvh && bvh->node && origin && direction)
+	{
+		if (!bvh->nodeCount)
+			return -1;
+
+		// axis-parallel rays get a huge finite slope instead of infinity
+		for (i = 0; i < 3; ++i)
+			dirInv[i] = 1.0f / (direction[i] > 1.0e-20f || direction[i] < -1.0e-20f ? direction[i] : 1.0e-20f);
+		dirInv[3] = 0.0f;
+#ifdef A3_DEMOBVH_SSE
+		o = _mm_set_ps(0.0f, origin[2], origin[1], origin[0]);
+		d = _mm_loadu_ps(dirInv);
+		maskXYZ = _mm_cmpneq_ps(_mm_set_ps(0.0f, 1.0f, 1.0f, 1.0f), _mm_setzero_ps());
+#endif	// A3_DEMOBVH_SSE
+
+		// nearer child is visited first; anything entered beyond the
+		//	best hit so far is skipped
+		stack[0].node = 0;
+		stack[0].t = a3demo_bvhRay_internal(bvh->node->boundsMin, bvh->node->boundsMax, tBest);
+		top = stack[0].t < FLT_MAX ? 1 : 0;
+		while (top)
+		{
+			v = stack[--top];
+			if (v.t > tBest)
+				continue;
+			node = bvh->node + v.node;
+			if (node->count)
+			{
+				for (i = node->first; i < node->first + node->count; ++i)
+				{
+					t = a3demo_bvhRay_internal(bvh->itemMin[i], bvh->itemMax[i], tBest);
+					if (t < FLT_MAX && (hit < 0 || t < tBest))
+					{
+						tBest = t;
+						hit = bvh->item[i];
+					}
+				}
+			}
+			else
+			{
+				v0.node = node->first;
+				v0.t = a3demo_bvhRay_internal(bvh->node[v0.node].boundsMin, bvh->node[v0.node].boundsMax, tBest);
+				v1.node = node->first + 1;
+				v1.t = a3demo_bvhRay_internal(bvh->node[v1.node].boundsMin, bvh->node[v1.node].boundsMax, tBest);
+				if (v0.t > v1.t)
+				{
+					v = v0;
+					v0 = v1;
+					v1 = v;
+				}
+				if (v1.t < FLT_MAX)
+					stack[top++] = v1;
+				if (v0.t < FLT_MAX)
+					stack[top++] = v0;
+			}
+		}
+#undef a3demo_bvhRay_internal
+
+		if (hit >= 0 && distance_out_opt)
+			*distance_out_opt = tBest;
+		return hit;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+void a3demo_bvhBenchmark(const a3ui32 itemCount)
+{
+	const a3ui32 viewCount = 64, lightCount = itemCount / 4, rayCount = 4096;
+	const a3f32 worldSize = 256.0f;
+	a3_DemoBVH bvh[1] = { 0 }, lightBVH[1] = { 0 };
+	a3_DemoRandom rng[1];
+	a3_DemoRandomLanes lanes[1];
+	a3_Timer timer[1] = { 0 };
+	a3f32(*bMin)[4] = 0, (*bMax)[4], (*light)[4], (*ray)[4];
+	a3ui32 *hit = 0;
+	a3f32 param[8], plane[6][4], view[2][3], d, t, tBest, s;
+	a3f64 time[10];
+	a3ui32 i, j, k, found[2][3] = { 0 }, mismatch = 0;
+	a3i32 best, pick;
+
+	if (!itemCount
+		|| !(bMin = (a3f32(*)[4])malloc((itemCount * 2 + lightCount + rayCount * 2) * sizeof(a3f32[4])))
+		|| !(hit = (a3ui32 *)malloc((itemCount > rayCount ? itemCount : rayCount) * sizeof(a3ui32)))
+		|| a3demo_bvhCreate(bvh, itemCount) <= 0
+		|| a3demo_bvhCreate(lightBVH, lightCount ? lightCount : 1) <= 0)
+	{
+		free(bMin);
+		free(hit);
+		a3demo_bvhRelease(bvh);
+		return;
+	}
+	bMax = bMin + itemCount;
+	light = bMax + itemCount;
+	ray = light + lightCount;
+
+	// boxes scattered through a cube, most small, some large; lights are
+	//	spheres of moderate radius; rays start anywhere and go anywhere
+	a3demo_randomSeed(rng, 2048);
+	a3demo_randomLanesCreate(lanes, rng);
+	for (i = 0; i < itemCount; ++i)
+	{
+		a3demo_randomFillReal(lanes, param, 8, 0.0f, 1.0f);
+		s = 0.25f + 4.0f * param[3] * param[3] * param[4];
+		for (j = 0; j < 3; ++j)
+		{
+			bMin[i][j] = param[j] * worldSize - s * param[5 + j];
+			bMax[i][j] = param[j] * worldSize + s * param[5 + j] + 0.01f;
+		}
+	}
+	for (i = 0; i < lightCount; ++i)
+	{
+		a3demo_randomFillReal(lanes, light[i], 4, 0.0f, worldSize);
+		light[i][3] = 2.0f + light[i][3] / worldSize * 8.0f;
+	}
+	for (i = 0; i < rayCount; ++i)
+	{
+		a3demo_randomFillReal(lanes, ray[i * 2], 4, 0.0f, worldSize);
+		a3demo_randomFillReal(lanes, ray[i * 2 + 1], 4, -1.0f, 1.0f);
+	}
+
+	// build and refit (everything nudged a little)
+	a3timerSet(timer, 0.0);
+	a3timerStart(timer);
+	a3demo_bvhBuild(bvh, bMin, bMax, itemCount);
+	a3timerUpdate(timer);
+	time[0] = timer->totalTime;
+	for (i = 0; i < itemCount; ++i)
+		for (j = 0; j < 3; ++j)
+		{
+			d = (a3f32)((i * 7 + j * 3) % 5) - 2.0f;
+			bMin[i][j] += d;
+			bMax[i][j] += d;
+		}
+	a3timerSet(timer, 0.0);
+	a3timerStart(timer);
+	a3demo_bvhRefit(bvh, bMin, bMax);
+	a3timerUpdate(timer);
+	time[1] = timer->totalTime;
+
+	// culling: views from the middle looking along each axis, perspective
+	//	with a quarter of the world in range
+	for (k = 0; k < 2; ++k)
+	{
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		for (i = 0, found[k][0] = 0; i < viewCount; ++i)
+		{
+			// ninety degree view turning about the vertical, out to a quarter
+			//	of the world: sides through the eye, then far and near
+			s = (a3f32)i / (a3f32)viewCount * 6.2831853f;
+			view[0][0] = sinf(s);
+			view[0][1] = 0.0f;
+			view[0][2] = -cosf(s);
+			view[1][0] = cosf(s);
+			view[1][1] = 0.0f;
+			view[1][2] = sinf(s);
+			for (j = 0; j < 4; ++j)
+			{
+				pick = j / 2;
+				d = (j % 2) ? -1.0f : +1.0f;
+				plane[j][0] = (view[0][0] + d * (pick ? 0.0f : view[1][0])) * 0.70710678f;
+				plane[j][1] = (pick ? d : 0.0f) * 0.70710678f;
+				plane[j][2] = (view[0][2] + d * (pick ? 0.0f : view[1][2])) * 0.70710678f;
+			}
+			for (j = 0; j < 3; ++j)
+			{
+				plane[4][j] = -view[0][j];
+				plane[5][j] = +view[0][j];
+			}
+			for (j = 0; j < 6; ++j)
+				plane[j][3] = -(plane[j][0] + plane[j][1] + plane[j][2]) * worldSize * 0.5f;
+			plane[4][3] += worldSize * 0.25f;
+			plane[5][3] -= 0.1f;
+			if (k == 0)
+			{
+				for (j = 0; j < itemCount; ++j)
+				{
+					for (pick = 0; pick < 6; ++pick)
+					{
+						d = plane[pick][3];
+						d += plane[pick][0] * (plane[pick][0] > 0.0f ? bMax[j][0] : bMin[j][0]);
+						d += plane[pick][1] * (plane[pick][1] > 0.0f ? bMax[j][1] : bMin[j][1]);
+						d += plane[pick][2] * (plane[pick][2] > 0.0f ? bMax[j][2] : bMin[j][2]);
+						if (d < 0.0f)
+							break;
+					}
+					found[k][0] += pick == 6;
+				}
+			}
+			else
+				found[k][0] += a3demo_bvhQueryFrustum(bvh, hit, itemCount, plane, 6);
+		}
+		a3timerUpdate(timer);
+		time[2 + k] = timer->totalTime;
+	}
+
+	// light assignment: every light against every box, or each light
+	//	queried; and the other way, boxes against a tree of lights
+	for (k = 0; k < 2; ++k)
+	{
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		for (i = 0, found[k][1] = 0; i < lightCount; ++i)
+		{
+			if (k == 0)
+			{
+				for (j = 0; j < itemCount; ++j)
+				{
+					for (pick = 0, t = 0.0f; pick < 3; ++pick)
+					{
+						d = light[i][pick] < bMin[j][pick] ? bMin[j][pick] - light[i][pick] : light[i][pick] > bMax[j][pick] ? light[i][pick] - bMax[j][pick] : 0.0f;
+						t += d * d;
+					}
+					found[k][1] += t <= light[i][3] * light[i][3];
+				}
+			}
+			else
+				found[k][1] += a3demo_bvhQuerySphere(bvh, hit, itemCount, light[i], light[i][3]);
+		}
+		a3timerUpdate(timer);
+		time[4 + k] = timer->totalTime;
+	}
+	for (i = 0; i < lightCount; ++i)
+		a3demo_bvhSphereBounds(bMin[i], bMax[i], light[i], light[i][3]);
+	a3timerSet(timer, 0.0);
+	a3timerStart(timer);
+	a3demo_bvhBuild(lightBVH, bMin, bMax, lightCount);
+	a3timerUpdate(timer);
+	time[8] = timer->totalTime;
+
+	// restore boxes for picking
+	a3demo_randomSeed(rng, 2048);
+	a3demo_randomLanesCreate(lanes, rng);
+	for (i = 0; i < itemCount; ++i)
+	{
+		a3demo_randomFillReal(lanes, param, 8, 0.0f, 1.0f);
+		s = 0.25f + 4.0f * param[3] * param[3] * param[4];
+		for (j = 0; j < 3; ++j)
+		{
+			d = (a3f32)((i * 7 + j * 3) % 5) - 2.0f;
+			bMin[i][j] = param[j] * worldSize - s * param[5 + j] + d;
+			bMax[i][j] = param[j] * worldSize + s * param[5 + j] + 0.01f + d;
+		}
+	}
+
+	// picking: nearest box along each ray
+	for (k = 0; k < 2; ++k)
+	{
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		for (i = 0, found[k][2] = 0; i < rayCount; ++i)
+		{
+			if (k == 0)
+			{
+				for (j = 0, best = -1, tBest = worldSize * 4.0f; j < itemCount; ++j)
+				{
+					a3f32 tNear = 0.0f, tFar = tBest, t0, t1;
+					for (pick = 0; pick < 3; ++pick)
+					{
+						d = ray[i * 2 + 1][pick];
+						d = 1.0f / (d > 1.0e-20f || d < -1.0e-20f ? d : 1.0e-20f);
+						t0 = (bMin[j][pick] - ray[i * 2][pick]) * d;
+						t1 = (bMax[j][pick] - ray[i * 2][pick]) * d;
+						tNear = (t0 < t1 ? t0 : t1) > tNear ? (t0 < t1 ? t0 : t1) : tNear;
+						tFar = (t0 > t1 ? t0 : t1) < tFar ? (t0 > t1 ? t0 : t1) : tFar;
+					}
+					if (tNear <= tFar && tNear < tBest)
+					{
+						tBest = tNear;
+						best = j;
+					}
+				}
+				hit[i] = (a3ui32)best;
+			}
+			else
+			{
+				pick = a3demo_bvhQueryRay(bvh, &t, ray[i * 2], ray[i * 2 + 1], worldSize * 4.0f);
+				mismatch += (pick != (a3i32)hit[i]);
+			}
+			found[k][2] += (k ? pick : (a3i32)hit[i]) >= 0;
+		}
+		a3timerUpdate(timer);
+		time[6 + k] = timer->totalTime;
+	}
+
+	printf("\n\n A3 BVH benchmark (%u boxes, %u nodes, %u lights): ", itemCount, bvh->nodeCount, lightCount);
+	printf("\n\t build            %8.3lf ms, cost %.1f; refit %.3lf ms, cost %.1f; lights built in %.3lf ms",
+		time[0] * 1000.0, bvh->costBuilt, time[1] * 1000.0, bvh->cost, time[8] * 1000.0);
+	printf("\n\t cull %2u views    scan %8.3lf ms | tree %8.3lf ms (x%6.1lf) | visible %u / %u",
+		viewCount, time[2] * 1000.0, time[3] * 1000.0, time[2] / time[3], found[0][0], found[1][0]);
+	printf("\n\t assign lights    scan %8.3lf ms | tree %8.3lf ms (x%6.1lf) | pairs %u / %u",
+		time[4] * 1000.0, time[5] * 1000.0, time[4] / time[5], found[0][1], found[1][1]);
+	printf("\n\t pick %4u rays   scan %8.3lf ms | tree %8.3lf ms (x%6.1lf) | hits %u / %u, %u differ",
+		rayCount, time[6] * 1000.0, time[7] * 1000.0, time[6] / time[7], found[0][2], found[1][2], mismatch);
+	printf("\n");
+
+	a3demo_bvhRelease(bvh);
+	a3demo_bvhRelease(lightBVH);
+	free(bMin);
+	free(hit);
+}
+
+
+//-----------------------------------------------------------------------------
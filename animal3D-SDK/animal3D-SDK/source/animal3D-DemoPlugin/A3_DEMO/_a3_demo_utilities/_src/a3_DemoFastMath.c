@@ -0,0 +1,557 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_DemoFastMath.c
+	Polynomial trig and inverse square root implementations.
+*/
+
+#include "../a3_DemoFastMath.h"
+
+#include "../a3_DemoRandom.h"
+#include "animal3D-A3DM/a3math/a3trig.h"
+#include "animal3D-A3DM/a3math/a3sqrt.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// widest vector set the build targets; SSE2 is always available on 
+//	64-bit x86 targets, AVX2 only when enabled (/arch:AVX2, -mavx2)
+#if (defined __AVX2__)
+#define A3_DEMOFASTMATH_AVX2
+#define A3_DEMOFASTMATH_SIMD
+#include <immintrin.h>
+#elif (defined _M_X64 || defined _M_AMD64 || defined __SSE2__)
+#define A3_DEMOFASTMATH_SSE2
+#define A3_DEMOFASTMATH_SIMD
+#include <emmintrin.h>
+#endif	// AVX2 or SSE2
+
+
+//-----------------------------------------------------------------------------
+
+// 2/pi and pi/2 split in three so that q * part is exact for |q| < 2^13
+#define A3_DEMO_FASTMATH_2_PI		0.636619772367581343f
+#define A3_DEMO_FASTMATH_PI_2_A		1.5703125f
+#define A3_DEMO_FASTMATH_PI_2_B		4.837512969970703125e-4f
+#define A3_DEMO_FASTMATH_PI_2_C		7.54978995489188216e-8f
+#define A3_DEMO_FASTMATH_PI			3.14159265358979324f
+#define A3_DEMO_FASTMATH_PI_2		1.57079632679489662f
+#define A3_DEMO_FASTMATH_PI_4		0.785398163397448310f
+#define A3_DEMO_FASTMATH_TAN_PI_8	0.414213562373095049f
+
+// minimax coefficients for sin and cos on [-pi/4, +pi/4]
+#define A3_DEMO_FASTMATH_SIN_1		-1.6666654611e-1f
+#define A3_DEMO_FASTMATH_SIN_2		+8.3321608736e-3f
+#define A3_DEMO_FASTMATH_SIN_3		-1.9515295891e-4f
+#define A3_DEMO_FASTMATH_COS_1		+4.166664568298827e-2f
+#define A3_DEMO_FASTMATH_COS_2		-1.388731625493765e-3f
+#define A3_DEMO_FASTMATH_COS_3		+2.443315711809948e-5f
+
+// minimax coefficients for atan on [-tan(pi/8), +tan(pi/8)]
+#define A3_DEMO_FASTMATH_ATAN_1		-3.33329491539e-1f
+#define A3_DEMO_FASTMATH_ATAN_2		+1.99777106478e-1f
+#define A3_DEMO_FASTMATH_ATAN_3		-1.38776856032e-1f
+#define A3_DEMO_FASTMATH_ATAN_4		+8.05374449538e-2f
+
+
+// vector operations for the widest available set; each kernel below is 
+//	written once against these
+#if (defined A3_DEMOFASTMATH_AVX2)
+#define A3_DEMO_FASTMATH_WIDTH		8
+typedef __m256	a3_fmv;
+typedef __m256i	a3_fmvi;
+#define a3fmv_load(p)				_mm256_loadu_ps(p)
+#define a3fmv_store(p, a)			_mm256_storeu_ps(p, a)
+#define a3fmv_set(s)				_mm256_set1_ps(s)
+#define a3fmv_add(a, b)				_mm256_add_ps(a, b)
+#define a3fmv_sub(a, b)				_mm256_sub_ps(a, b)
+#define a3fmv_mul(a, b)				_mm256_mul_ps(a, b)
+#define a3fmv_div(a, b)				_mm256_div_ps(a, b)
+#define a3fmv_min(a, b)				_mm256_min_ps(a, b)
+#define a3fmv_max(a, b)				_mm256_max_ps(a, b)
+#define a3fmv_and(a, b)				_mm256_and_ps(a, b)
+#define a3fmv_andnot(a, b)			_mm256_andnot_ps(a, b)
+#define a3fmv_or(a, b)				_mm256_or_ps(a, b)
+#define a3fmv_xor(a, b)				_mm256_xor_ps(a, b)
+#define a3fmv_lt(a, b)				_mm256_cmp_ps(a, b, _CMP_LT_OQ)
+#define a3fmv_eq(a, b)				_mm256_cmp_ps(a, b, _CMP_EQ_OQ)
+#define a3fmv_rsqrt(a)				_mm256_rsqrt_ps(a)
+#define a3fmv_round(a)				_mm256_cvtps_epi32(a)
+#define a3fmv_fromInt(a)			_mm256_cvtepi32_ps(a)
+#define a3fmv_fromBits(a)			_mm256_castsi256_ps(a)
+#define a3fmvi_set(s)				_mm256_set1_epi32(s)
+#define a3fmvi_add(a, b)			_mm256_add_epi32(a, b)
+#define a3fmvi_and(a, b)			_mm256_and_si256(a, b)
+#define a3fmvi_eq(a, b)				_mm256_cmpeq_epi32(a, b)
+#define a3fmvi_shl(a, n)			_mm256_slli_epi32(a, n)
+#elif (defined A3_DEMOFASTMATH_SSE2)
+#define A3_DEMO_FASTMATH_WIDTH		4
+typedef __m128	a3_fmv;
+typedef __m128i	a3_fmvi;
+#define a3fmv_load(p)				_mm_loadu_ps(p)
+#define a3fmv_store(p, a)			_mm_storeu_ps(p, a)
+#define a3fmv_set(s)				_mm_set1_ps(s)
+#define a3fmv_add(a, b)				_mm_add_ps(a, b)
+#define a3fmv_sub(a, b)				_mm_sub_ps(a, b)
+#define a3fmv_mul(a, b)				_mm_mul_ps(a, b)
+#define a3fmv_div(a, b)				_mm_div_ps(a, b)
+#define a3fmv_min(a, b)				_mm_min_ps(a, b)
+#define a3fmv_max(a, b)				_mm_max_ps(a, b)
+#define a3fmv_and(a, b)				_mm_and_ps(a, b)
+#define a3fmv_andnot(a, b)			_mm_andnot_ps(a, b)
+#define a3fmv_or(a, b)				_mm_or_ps(a, b)
+#define a3fmv_xor(a, b)				_mm_xor_ps(a, b)
+#define a3fmv_lt(a, b)				_mm_cmplt_ps(a, b)
+#define a3fmv_eq(a, b)				_mm_cmpeq_ps(a, b)
+#define a3fmv_rsqrt(a)				_mm_rsqrt_ps(a)
+#define a3fmv_round(a)				_mm_cvtps_epi32(a)
+#define a3fmv_fromInt(a)			_mm_cvtepi32_ps(a)
+#define a3fmv_fromBits(a)			_mm_castsi128_ps(a)
+#define a3fmvi_set(s)				_mm_set1_epi32(s)
+#define a3fmvi_add(a, b)			_mm_add_epi32(a, b)
+#define a3fmvi_and(a, b)			_mm_and_si128(a, b)
+#define a3fmvi_eq(a, b)				_mm_cmpeq_epi32(a, b)
+#define a3fmvi_shl(a, n)			_mm_slli_epi32(a, n)
+#else	// !A3_DEMOFASTMATH_SIMD
+#define A3_DEMO_FASTMATH_WIDTH		1
+#endif	// A3_DEMOFASTMATH_SIMD
+
+
+//-----------------------------------------------------------------------------
+
+// sin and cos of reduced argument r in [-pi/4, +pi/4]
+inline a3f32 a3demo_sinReduced_internal(const a3f32 r, const a3f32 z)
+{
+	return r + r * z * (A3_DEMO_FASTMATH_SIN_1 + z * (A3_DEMO_FASTMATH_SIN_2 + z * A3_DEMO_FASTMATH_SIN_3));
+}
+
+inline a3f32 a3demo_cosReduced_internal(const a3f32 z)
+{
+	return 1.0f - 0.5f * z + z * z * (A3_DEMO_FASTMATH_COS_1 + z * (A3_DEMO_FASTMATH_COS_2 + z * A3_DEMO_FASTMATH_COS_3));
+}
+
+// reduce x by the nearest multiple q of pi/2
+inline a3f32 a3demo_reduce_internal(const a3f32 x, a3i32 *q_out)
+{
+	const a3f32 k = x * A3_DEMO_FASTMATH_2_PI;
+	const a3i32 q = (a3i32)(k + (k >= 0.0f ? 0.5f : -0.5f));
+	const a3f32 qf = (a3f32)q;
+	*q_out = q;
+	return x - qf * A3_DEMO_FASTMATH_PI_2_A - qf * A3_DEMO_FASTMATH_PI_2_B - qf * A3_DEMO_FASTMATH_PI_2_C;
+}
+
+
+#ifdef A3_DEMOFASTMATH_SIMD
+// blend: mask ? a : b
+#define a3fmv_select(mask, a, b)	a3fmv_or(a3fmv_and(mask, a), a3fmv_andnot(mask, b))
+
+// sin and cos of every lane; quadrant bits pick the polynomial and sign
+inline void a3demo_sincosVector_internal(a3_fmv *sin_out, a3_fmv *cos_out, const a3_fmv x)
+{
+	const a3_fmvi q = a3fmv_round(a3fmv_mul(x, a3fmv_set(A3_DEMO_FASTMATH_2_PI)));
+	const a3_fmv qf = a3fmv_fromInt(q);
+	a3_fmv r, z, s, c, swap;
+	r = a3fmv_sub(x, a3fmv_mul(qf, a3fmv_set(A3_DEMO_FASTMATH_PI_2_A)));
+	r = a3fmv_sub(r, a3fmv_mul(qf, a3fmv_set(A3_DEMO_FASTMATH_PI_2_B)));
+	r = a3fmv_sub(r, a3fmv_mul(qf, a3fmv_set(A3_DEMO_FASTMATH_PI_2_C)));
+	z = a3fmv_mul(r, r);
+
+	s = a3fmv_add(a3fmv_mul(z, a3fmv_set(A3_DEMO_FASTMATH_SIN_3)), a3fmv_set(A3_DEMO_FASTMATH_SIN_2));
+	s = a3fmv_add(a3fmv_mul(z, s), a3fmv_set(A3_DEMO_FASTMATH_SIN_1));
+	s = a3fmv_add(a3fmv_mul(a3fmv_mul(r, z), s), r);
+
+	c = a3fmv_add(a3fmv_mul(z, a3fmv_set(A3_DEMO_FASTMATH_COS_3)), a3fmv_set(A3_DEMO_FASTMATH_COS_2));
+	c = a3fmv_add(a3fmv_mul(z, c), a3fmv_set(A3_DEMO_FASTMATH_COS_1));
+	c = a3fmv_mul(a3fmv_mul(z, z), c);
+	c = a3fmv_add(a3fmv_sub(a3fmv_set(1.0f), a3fmv_mul(z, a3fmv_set(0.5f))), c);
+
+	// odd quadrants swap; sin flips in quadrants 2-3, cos in 1-2
+	swap = a3fmv_fromBits(a3fmvi_eq(a3fmvi_and(q, a3fmvi_set(1)), a3fmvi_set(1)));
+	*sin_out = a3fmv_xor(a3fmv_select(swap, c, s),
+		a3fmv_fromBits(a3fmvi_shl(a3fmvi_and(q, a3fmvi_set(2)), 30)));
+	*cos_out = a3fmv_xor(a3fmv_select(swap, s, c),
+		a3fmv_fromBits(a3fmvi_shl(a3fmvi_and(a3fmvi_add(q, a3fmvi_set(1)), a3fmvi_set(2)), 30)));
+}
+
+// atan2 of every lane: reduce to a ratio in [0, 1], then to 
+//	[-tan(pi/8), +tan(pi/8)], then undo each reduction
+inline a3_fmv a3demo_atan2Vector_internal(const a3_fmv y, const a3_fmv x)
+{
+	const a3_fmv sign = a3fmv_set(-0.0f), zero = a3fmv_set(0.0f);
+	const a3_fmv ax = a3fmv_andnot(sign, x), ay = a3fmv_andnot(sign, y);
+	const a3_fmv mn = a3fmv_min(ax, ay), mx = a3fmv_max(ax, ay);
+	const a3_fmv big = a3fmv_lt(a3fmv_mul(mx, a3fmv_set(A3_DEMO_FASTMATH_TAN_PI_8)), mn);
+	a3_fmv num, den, t, z, r;
+
+	// one division covers both branches: mn/mx or (mn - mx)/(mn + mx)
+	num = a3fmv_select(big, a3fmv_sub(mn, mx), mn);
+	den = a3fmv_select(big, a3fmv_add(mn, mx), mx);
+	t = a3fmv_andnot(a3fmv_eq(den, zero), a3fmv_div(num, den));
+	z = a3fmv_mul(t, t);
+
+	r = a3fmv_add(a3fmv_mul(z, a3fmv_set(A3_DEMO_FASTMATH_ATAN_4)), a3fmv_set(A3_DEMO_FASTMATH_ATAN_3));
+	r = a3fmv_add(a3fmv_mul(z, r), a3fmv_set(A3_DEMO_FASTMATH_ATAN_2));
+	r = a3fmv_add(a3fmv_mul(z, r), a3fmv_set(A3_DEMO_FASTMATH_ATAN_1));
+	r = a3fmv_add(a3fmv_mul(a3fmv_mul(z, t), r), t);
+	r = a3fmv_add(r, a3fmv_and(big, a3fmv_set(A3_DEMO_FASTMATH_PI_4)));
+
+	r = a3fmv_select(a3fmv_lt(ax, ay), a3fmv_sub(a3fmv_set(A3_DEMO_FASTMATH_PI_2), r), r);
+	r = a3fmv_select(a3fmv_lt(x, zero), a3fmv_sub(a3fmv_set(A3_DEMO_FASTMATH_PI), r), r);
+	return a3fmv_or(r, a3fmv_and(sign, y));
+}
+
+// hardware estimate refined by one Newton step
+inline a3_fmv a3demo_invsqrtVector_internal(const a3_fmv x)
+{
+	const a3_fmv y = a3fmv_rsqrt(x);
+	return a3fmv_mul(y, a3fmv_sub(a3fmv_set(1.5f), a3fmv_mul(a3fmv_mul(a3fmv_set(0.5f), x), a3fmv_mul(y, y))));
+}
+#endif	// A3_DEMOFASTMATH_SIMD
+
+
+//-----------------------------------------------------------------------------
+
+a3f32 a3demo_sinPoly(const a3f32 x)
+{
+	a3f32 s;
+	a3demo_sincosPoly(x, &s, 0);
+	return s;
+}
+
+a3f32 a3demo_cosPoly(const a3f32 x)
+{
+	a3f32 c;
+	a3demo_sincosPoly(x, 0, &c);
+	return c;
+}
+
+void a3demo_sincosPoly(const a3f32 x, a3f32 *sin_out, a3f32 *cos_out)
+{
+	// quadrant picks by bit masks rather than branches: the quadrant of 
+	//	consecutive inputs is unpredictable and mispredicts cost more 
+	//	than the polynomials
+	union { a3f32 f; a3ui32 i; } s, c;
+	a3i32 q;
+	a3ui32 swap;
+	const a3f32 r = a3demo_reduce_internal(x, &q), z = r * r;
+	s.f = a3demo_sinReduced_internal(r, z);
+	c.f = a3demo_cosReduced_internal(z);
+	swap = (s.i ^ c.i) & (0u - (a3ui32)(q & 1));
+	s.i ^= swap;
+	c.i ^= swap;
+	s.i ^= (a3ui32)(q & 2) << 30;
+	c.i ^= (a3ui32)((q + 1) & 2) << 30;
+	if (sin_out)
+		*sin_out = s.f;
+	if (cos_out)
+		*cos_out = c.f;
+}
+
+a3f32 a3demo_atan2Poly(const a3f32 y, const a3f32 x)
+{
+	const a3f32 ax = x < 0.0f ? -x : x, ay = y < 0.0f ? -y : y;
+	const a3f32 mn = ax < ay ? ax : ay, mx = ax < ay ? ay : ax;
+	const a3boolean big = mx * A3_DEMO_FASTMATH_TAN_PI_8 < mn;
+	const a3f32 num = big ? mn - mx : mn, den = big ? mn + mx : mx;
+	const a3f32 t = den != 0.0f ? num / den : 0.0f, z = t * t;
+	a3f32 r = ((((A3_DEMO_FASTMATH_ATAN_4 * z + A3_DEMO_FASTMATH_ATAN_3) * z
+		+ A3_DEMO_FASTMATH_ATAN_2) * z + A3_DEMO_FASTMATH_ATAN_1) * z * t + t);
+	if (big)
+		r += A3_DEMO_FASTMATH_PI_4;
+	if (ax < ay)
+		r = A3_DEMO_FASTMATH_PI_2 - r;
+	if (x < 0.0f)
+		r = A3_DEMO_FASTMATH_PI - r;
+	return (y < 0.0f || (y == 0.0f && 1.0f / y < 0.0f)) ? -r : r;
+}
+
+a3f32 a3demo_invsqrtPoly(const a3f32 x)
+{
+#ifdef A3_DEMOFASTMATH_SIMD
+	const __m128 v = _mm_set_ss(x), y = _mm_rsqrt_ss(v);
+	return _mm_cvtss_f32(_mm_mul_ss(y, _mm_sub_ss(_mm_set_ss(1.5f), _mm_mul_ss(_mm_mul_ss(_mm_set_ss(0.5f), v), _mm_mul_ss(y, y)))));
+#else	// !A3_DEMOFASTMATH_SIMD
+	// tuned magic constant, then two Newton steps
+	union { a3f32 f; a3ui32 i; } u;
+	u.f = x;
+	u.i = 0x5f375a86 - (u.i >> 1);
+	u.f *= 1.5f - 0.5f * x * u.f * u.f;
+	u.f *= 1.5f - 0.5f * x * u.f * u.f;
+	return u.f;
+#endif	// A3_DEMOFASTMATH_SIMD
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_sincosBatch(a3f32 *sin_out, a3f32 *cos_out, const a3f32 *x, const a3ui32 count)
+{
+	a3ui32 i = 0;
+	if (sin_out && cos_out && x)
+	{
+#ifdef A3_DEMOFASTMATH_SIMD
+		a3f32 pad[3][A3_DEMO_FASTMATH_WIDTH] = { 0 };
+		a3_fmv s, c;
+		for (; i + A3_DEMO_FASTMATH_WIDTH <= count; i += A3_DEMO_FASTMATH_WIDTH)
+		{
+			a3demo_sincosVector_internal(&s, &c, a3fmv_load(x + i));
+			a3fmv_store(sin_out + i, s);
+			a3fmv_store(cos_out + i, c);
+		}
+
+		// remainder runs through a padded vector so results match exactly
+		if (i < count)
+		{
+			memcpy(pad[0], x + i, (count - i) * sizeof(a3f32));
+			a3demo_sincosVector_internal(&s, &c, a3fmv_load(pad[0]));
+			a3fmv_store(pad[1], s);
+			a3fmv_store(pad[2], c);
+			memcpy(sin_out + i, pad[1], (count - i) * sizeof(a3f32));
+			memcpy(cos_out + i, pad[2], (count - i) * sizeof(a3f32));
+		}
+#else	// !A3_DEMOFASTMATH_SIMD
+		for (; i < count; ++i)
+			a3demo_sincosPoly(x[i], sin_out + i, cos_out + i);
+#endif	// A3_DEMOFASTMATH_SIMD
+		return count;
+	}
+	return -1;
+}
+
+a3ret a3demo_atan2Batch(a3f32 *angle_out, const a3f32 *y, const a3f32 *x, const a3ui32 count)
+{
+	a3ui32 i = 0;
+	if (angle_out && y && x)
+	{
+#ifdef A3_DEMOFASTMATH_SIMD
+		a3f32 pad[3][A3_DEMO_FASTMATH_WIDTH] = { 0 };
+		for (; i + A3_DEMO_FASTMATH_WIDTH <= count; i += A3_DEMO_FASTMATH_WIDTH)
+			a3fmv_store(angle_out + i, a3demo_atan2Vector_internal(a3fmv_load(y + i), a3fmv_load(x + i)));
+		if (i < count)
+		{
+			memcpy(pad[0], y + i, (count - i) * sizeof(a3f32));
+			memcpy(pad[1], x + i, (count - i) * sizeof(a3f32));
+			a3fmv_store(pad[2], a3demo_atan2Vector_internal(a3fmv_load(pad[0]), a3fmv_load(pad[1])));
+			memcpy(angle_out + i, pad[2], (count - i) * sizeof(a3f32));
+		}
+#else	// !A3_DEMOFASTMATH_SIMD
+		for (; i < count; ++i)
+			angle_out[i] = a3demo_atan2Poly(y[i], x[i]);
+#endif	// A3_DEMOFASTMATH_SIMD
+		return count;
+	}
+	return -1;
+}
+
+a3ret a3demo_invsqrtBatch(a3f32 *invsqrt_out, const a3f32 *x, const a3ui32 count)
+{
+	a3ui32 i = 0;
+	if (invsqrt_out && x)
+	{
+#ifdef A3_DEMOFASTMATH_SIMD
+		a3f32 pad[2][A3_DEMO_FASTMATH_WIDTH];
+		for (; i + A3_DEMO_FASTMATH_WIDTH <= count; i += A3_DEMO_FASTMATH_WIDTH)
+			a3fmv_store(invsqrt_out + i, a3demo_invsqrtVector_internal(a3fmv_load(x + i)));
+		if (i < count)
+		{
+			// pad with ones so unused lanes stay finite
+			a3fmv_store(pad[0], a3fmv_set(1.0f));
+			memcpy(pad[0], x + i, (count - i) * sizeof(a3f32));
+			a3fmv_store(pad[1], a3demo_invsqrtVector_internal(a3fmv_load(pad[0])));
+			memcpy(invsqrt_out + i, pad[1], (count - i) * sizeof(a3f32));
+		}
+#else	// !A3_DEMOFASTMATH_SIMD
+		for (; i < count; ++i)
+			invsqrt_out[i] = a3demo_invsqrtPoly(x[i]);
+#endif	// A3_DEMOFASTMATH_SIMD
+		return count;
+	}
+	return -1;
+}
+
+a3ui32 a3demo_fastMathWidth()
+{
+	return A3_DEMO_FASTMATH_WIDTH;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// error of approximation in units of the last place of the exact result
+inline a3f64 a3demo_fastMathUlp_internal(const a3f32 approx, const a3f64 exact)
+{
+	a3i32 e;
+	frexp(exact, &e);
+	return fabs((a3f64)approx - exact) / ldexp(1.0, (exact != 0.0 ? e : -125) - 24);
+}
+
+void a3demo_fastMathBenchmark(const a3ui32 count)
+{
+	a3f32 *buffer = (a3f32 *)malloc(count * 4 * sizeof(a3f32));
+	a3f32 *in0 = buffer, *in1 = buffer + count, *out0 = buffer + count * 2, *out1 = buffer + count * 3;
+	a3_DemoRandom rng[1];
+	a3_DemoRandomLanes lanes[1];
+	a3_Timer timer[1] = { 0 };
+	a3f64 time, ulp, ulpMax, errMax, exact;
+	a3ui32 i, k, f;
+	const a3byte *function[] = {
+		"sin + cos, x in [-2pi, +2pi]",
+		"atan2, y and x in [-100, +100]",
+		"invsqrt, x in [1e-3, 1e+3]",
+	};
+	const a3byte *name[] = {
+		"table (a3trig)",
+		"Taylor (a3trig)",
+		"C library",
+		"polynomial",
+		"polynomial batch",
+	};
+
+	if (!buffer || !count)
+	{
+		free(buffer);
+		return;
+	}
+
+	a3demo_randomSeed(rng, 2048);
+	a3demo_randomLanesCreate(lanes, rng);
+
+	printf("\n\n A3 fast math benchmark (%u values each, batch width %u): ", count, A3_DEMO_FASTMATH_WIDTH);
+	for (f = 0; f < 3; ++f)
+	{
+		switch (f)
+		{
+		case 0:
+			a3demo_randomFillReal(lanes, in0, count, -2.0f * A3_DEMO_FASTMATH_PI, +2.0f * A3_DEMO_FASTMATH_PI);
+			break;
+		case 1:
+			a3demo_randomFillReal(lanes, in0, count, -100.0f, +100.0f);
+			a3demo_randomFillReal(lanes, in1, count, -100.0f, +100.0f);
+			break;
+		case 2:
+			// log-uniform so every binade in range is covered
+			a3demo_randomFillReal(lanes, in0, count, -3.0f, +3.0f);
+			for (i = 0; i < count; ++i)
+				in0[i] = (a3f32)pow(10.0, in0[i]);
+			break;
+		}
+
+		printf("\n\t %s:", function[f]);
+		for (k = 0; k < 5; ++k)
+		{
+			// only sin and cos have a series version; invsqrt has no table, 
+			//	so the library's fast inverse stands in for it
+			if (f != 0 && k == 1)
+				continue;
+
+			a3timerSet(timer, 0.0);
+			a3timerStart(timer);
+			switch (f * 5 + k)
+			{
+			case 0:
+				for (i = 0; i < count; ++i)
+				{
+					out0[i] = a3sinr(in0[i]);
+					out1[i] = a3cosr(in0[i]);
+				}
+				break;
+			case 1:
+				for (i = 0; i < count; ++i)
+				{
+					out0[i] = a3sinrTaylor(in0[i]);
+					out1[i] = a3cosrTaylor(in0[i]);
+				}
+				break;
+			case 2:
+				for (i = 0; i < count; ++i)
+				{
+					out0[i] = sinf(in0[i]);
+					out1[i] = cosf(in0[i]);
+				}
+				break;
+			case 3:
+				for (i = 0; i < count; ++i)
+					a3demo_sincosPoly(in0[i], out0 + i, out1 + i);
+				break;
+			case 4:
+				a3demo_sincosBatch(out0, out1, in0, count);
+				break;
+			case 5:
+				for (i = 0; i < count; ++i)
+					out0[i] = a3atan2r(in0[i], in1[i]);
+				break;
+			case 7:
+				for (i = 0; i < count; ++i)
+					out0[i] = atan2f(in0[i], in1[i]);
+				break;
+			case 8:
+				for (i = 0; i < count; ++i)
+					out0[i] = a3demo_atan2Poly(in0[i], in1[i]);
+				break;
+			case 9:
+				a3demo_atan2Batch(out0, in0, in1, count);
+				break;
+			case 10:
+				for (i = 0; i < count; ++i)
+					out0[i] = a3sqrtf0xInverse(in0[i]);
+				break;
+			case 12:
+				for (i = 0; i < count; ++i)
+					out0[i] = 1.0f / sqrtf(in0[i]);
+				break;
+			case 13:
+				for (i = 0; i < count; ++i)
+					out0[i] = a3demo_invsqrtPoly(in0[i]);
+				break;
+			case 14:
+				a3demo_invsqrtBatch(out0, in0, count);
+				break;
+			}
+			a3timerUpdate(timer);
+			time = timer->totalTime;
+
+			// accuracy against double precision; sin and cos both count
+			for (i = 0, ulpMax = errMax = 0.0; i < count; ++i)
+			{
+				exact = f == 0 ? sin(in0[i]) : f == 1 ? atan2(in0[i], in1[i]) : 1.0 / sqrt(in0[i]);
+				ulp = a3demo_fastMathUlp_internal(out0[i], exact);
+				ulpMax = ulp > ulpMax ? ulp : ulpMax;
+				errMax = fabs(out0[i] - exact) > errMax ? fabs(out0[i] - exact) : errMax;
+				if (f == 0)
+				{
+					exact = cos(in0[i]);
+					ulp = a3demo_fastMathUlp_internal(out1[i], exact);
+					ulpMax = ulp > ulpMax ? ulp : ulpMax;
+					errMax = fabs(out1[i] - exact) > errMax ? fabs(out1[i] - exact) : errMax;
+				}
+			}
+			printf("\n\t\t %-18s %8.2lf ms (%7.1lf M/s), max error %.2e (%.1lf ulp)", (f == 2 && k == 0) ? "fast (a3sqrt)" : name[k],
+				time * 1000.0, (a3f64)count / time * 1.0e-6, errMax, ulpMax);
+		}
+	}
+	printf("\n");
+	free(buffer);
+}
+
+
+//-----------------------------------------------------------------------------
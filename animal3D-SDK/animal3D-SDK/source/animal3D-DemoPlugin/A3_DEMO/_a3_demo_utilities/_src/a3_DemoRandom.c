@@ -0,0 +1,401 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_DemoRandom.c
+	Explicit-state random number generator implementations.
+*/
+
+#include "../a3_DemoRandom.h"
+
+#include "animal3D-A3DM/a3math/a3random.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// SSE2 is always available on 64-bit x86 targets
+#if (defined _M_X64 || defined _M_AMD64 || defined __SSE2__)
+#define A3_DEMORANDOM_SSE2
+#include <emmintrin.h>
+#endif	// SSE2
+
+
+//-----------------------------------------------------------------------------
+
+// PCG32 multiplier
+#define A3_DEMO_RANDOM_PCG_MULT	6364136223846793005ull
+
+// scale from top 24 bits to [0, 1)
+#define A3_DEMO_RANDOM_REAL_SCALE	(1.0f / 16777216.0f)
+
+
+// rotate left
+inline a3ui32 a3demo_randomRotl_internal(const a3ui32 x, const a3ui32 k)
+{
+	return (x << k) | (x >> (32 - k));
+}
+
+// SplitMix64 step, used to expand a seed into generator state
+inline a3ui64 a3demo_randomSplitMix_internal(a3ui64 *x)
+{
+	a3ui64 z = (*x += 0x9e3779b97f4a7c15ull);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return z ^ (z >> 31);
+}
+
+// xoshiro128++ step on loose state words
+inline a3ui32 a3demo_randomStep_internal(a3ui32 *s0, a3ui32 *s1, a3ui32 *s2, a3ui32 *s3)
+{
+	const a3ui32 result = a3demo_randomRotl_internal(*s0 + *s3, 7) + *s0;
+	const a3ui32 t = *s1 << 9;
+	*s2 ^= *s0;
+	*s3 ^= *s1;
+	*s1 ^= *s2;
+	*s0 ^= *s3;
+	*s2 ^= t;
+	*s3 = a3demo_randomRotl_internal(*s3, 11);
+	return result;
+}
+
+// generate one random integer per lane
+#ifdef A3_DEMORANDOM_SSE2
+inline __m128i a3demo_randomLanesStep_internal(a3_DemoRandomLanes *lanes)
+{
+	__m128i s0 = _mm_loadu_si128((const __m128i *)lanes->s[0]);
+	__m128i s1 = _mm_loadu_si128((const __m128i *)lanes->s[1]);
+	__m128i s2 = _mm_loadu_si128((const __m128i *)lanes->s[2]);
+	__m128i s3 = _mm_loadu_si128((const __m128i *)lanes->s[3]);
+	__m128i result = _mm_add_epi32(s0, s3), t = _mm_slli_epi32(s1, 9);
+	result = _mm_add_epi32(_mm_or_si128(_mm_slli_epi32(result, 7), _mm_srli_epi32(result, 25)), s0);
+	s2 = _mm_xor_si128(s2, s0);
+	s3 = _mm_xor_si128(s3, s1);
+	s1 = _mm_xor_si128(s1, s2);
+	s0 = _mm_xor_si128(s0, s3);
+	s2 = _mm_xor_si128(s2, t);
+	s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+	_mm_storeu_si128((__m128i *)lanes->s[0], s0);
+	_mm_storeu_si128((__m128i *)lanes->s[1], s1);
+	_mm_storeu_si128((__m128i *)lanes->s[2], s2);
+	_mm_storeu_si128((__m128i *)lanes->s[3], s3);
+	return result;
+}
+#else	// !A3_DEMORANDOM_SSE2
+inline void a3demo_randomLanesStep_internal(a3_DemoRandomLanes *lanes, a3ui32 result_out[4])
+{
+	a3ui32 i;
+	for (i = 0; i < 4; ++i)
+		result_out[i] = a3demo_randomStep_internal(lanes->s[0] + i, lanes->s[1] + i, lanes->s[2] + i, lanes->s[3] + i);
+}
+#endif	// A3_DEMORANDOM_SSE2
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_randomSeed(a3_DemoRandom *rng, const a3ui64 seed)
+{
+	a3ui64 x = seed, z;
+	if (rng)
+	{
+		// SplitMix64 output is never zero twice in a row, so state is valid
+		z = a3demo_randomSplitMix_internal(&x);
+		rng->s[0] = (a3ui32)z;
+		rng->s[1] = (a3ui32)(z >> 32);
+		z = a3demo_randomSplitMix_internal(&x);
+		rng->s[2] = (a3ui32)z;
+		rng->s[3] = (a3ui32)(z >> 32);
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3demo_randomJump(a3_DemoRandom *rng)
+{
+	// jump polynomial for 2^64 steps
+	static const a3ui32 jump[4] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+	a3ui32 s[4] = { 0 }, i, b;
+	if (rng)
+	{
+		for (i = 0; i < 4; ++i)
+			for (b = 0; b < 32; ++b)
+			{
+				if (jump[i] & (1u << b))
+				{
+					s[0] ^= rng->s[0];
+					s[1] ^= rng->s[1];
+					s[2] ^= rng->s[2];
+					s[3] ^= rng->s[3];
+				}
+				a3demo_randomNext(rng);
+			}
+		rng->s[0] = s[0];
+		rng->s[1] = s[1];
+		rng->s[2] = s[2];
+		rng->s[3] = s[3];
+		return 1;
+	}
+	return -1;
+}
+
+a3ui32 a3demo_randomNext(a3_DemoRandom *rng)
+{
+	return a3demo_randomStep_internal(rng->s + 0, rng->s + 1, rng->s + 2, rng->s + 3);
+}
+
+a3f32 a3demo_randomNormalized(a3_DemoRandom *rng)
+{
+	return (a3f32)(a3demo_randomNext(rng) >> 8) * A3_DEMO_RANDOM_REAL_SCALE;
+}
+
+a3f32 a3demo_randomRange(a3_DemoRandom *rng, const a3f32 nMin, const a3f32 nMax)
+{
+	return nMin + (nMax - nMin) * a3demo_randomNormalized(rng);
+}
+
+a3i32 a3demo_randomRangeInt(a3_DemoRandom *rng, const a3i32 nMin, const a3i32 nMax)
+{
+	// scale to range with a multiply instead of modulo
+	const a3ui32 range = (a3ui32)(nMax - nMin);
+	return nMin + (a3i32)(((a3ui64)a3demo_randomNext(rng) * range) >> 32);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_randomPCGSeed(a3_DemoRandomPCG *rng, const a3ui64 seed, const a3ui64 stream)
+{
+	if (rng)
+	{
+		rng->state = 0;
+		rng->inc = (stream << 1) | 1;
+		a3demo_randomPCGNext(rng);
+		rng->state += seed;
+		a3demo_randomPCGNext(rng);
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3demo_randomPCGAdvance(a3_DemoRandomPCG *rng, const a3ui64 delta)
+{
+	// compose the LCG step with itself by squaring
+	a3ui64 multiply = A3_DEMO_RANDOM_PCG_MULT, increment, accMultiply = 1, accIncrement = 0, d = delta;
+	if (rng)
+	{
+		increment = rng->inc;
+		while (d)
+		{
+			if (d & 1)
+			{
+				accMultiply *= multiply;
+				accIncrement = accIncrement * multiply + increment;
+			}
+			increment = (multiply + 1) * increment;
+			multiply *= multiply;
+			d >>= 1;
+		}
+		rng->state = accMultiply * rng->state + accIncrement;
+		return 1;
+	}
+	return -1;
+}
+
+a3ui32 a3demo_randomPCGNext(a3_DemoRandomPCG *rng)
+{
+	// XSH RR output of the old state
+	const a3ui64 state = rng->state;
+	const a3ui32 xorshifted = (a3ui32)(((state >> 18) ^ state) >> 27);
+	const a3ui32 rot = (a3ui32)(state >> 59);
+	rng->state = state * A3_DEMO_RANDOM_PCG_MULT + rng->inc;
+	return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31));
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_randomLanesCreate(a3_DemoRandomLanes *lanes, a3_DemoRandom *rng)
+{
+	a3ui32 i;
+	if (lanes && rng)
+	{
+		for (i = 0; i < 4; ++i)
+		{
+			lanes->s[0][i] = rng->s[0];
+			lanes->s[1][i] = rng->s[1];
+			lanes->s[2][i] = rng->s[2];
+			lanes->s[3][i] = rng->s[3];
+			a3demo_randomJump(rng);
+		}
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3demo_randomFillReal(a3_DemoRandomLanes *lanes, a3f32 *values_out, const a3ui32 count, const a3f32 nMin, const a3f32 nMax)
+{
+	const a3f32 scale = (nMax - nMin) * A3_DEMO_RANDOM_REAL_SCALE;
+	a3ui32 i, j;
+#ifdef A3_DEMORANDOM_SSE2
+	const __m128 vScale = _mm_set1_ps(scale), vMin = _mm_set1_ps(nMin);
+	__m128 v;
+	a3f32 tail[4];
+#else	// !A3_DEMORANDOM_SSE2
+	a3ui32 result[4];
+#endif	// A3_DEMORANDOM_SSE2
+
+	if (lanes && values_out)
+	{
+		for (i = 0; i < count; i += 4)
+		{
+#ifdef A3_DEMORANDOM_SSE2
+			// top 24 bits convert to float exactly
+			v = _mm_cvtepi32_ps(_mm_srli_epi32(a3demo_randomLanesStep_internal(lanes), 8));
+			v = _mm_add_ps(_mm_mul_ps(v, vScale), vMin);
+			if (i + 4 <= count)
+				_mm_storeu_ps(values_out + i, v);
+			else
+			{
+				_mm_storeu_ps(tail, v);
+				for (j = i; j < count; ++j)
+					values_out[j] = tail[j - i];
+			}
+#else	// !A3_DEMORANDOM_SSE2
+			a3demo_randomLanesStep_internal(lanes, result);
+			for (j = 0; j < 4 && i + j < count; ++j)
+				values_out[i + j] = (a3f32)(result[j] >> 8) * scale + nMin;
+#endif	// A3_DEMORANDOM_SSE2
+		}
+		return count;
+	}
+	return -1;
+}
+
+a3ret a3demo_randomFillInt(a3_DemoRandomLanes *lanes, a3i32 *values_out, const a3ui32 count, const a3i32 nMin, const a3i32 nMax)
+{
+	const a3ui32 range = (a3ui32)(nMax - nMin);
+	a3ui32 i, j;
+#ifdef A3_DEMORANDOM_SSE2
+	const __m128i vRange = _mm_set1_epi32((a3i32)range), vMin = _mm_set1_epi32(nMin);
+	const __m128i maskHigh = _mm_set_epi32(-1, 0, -1, 0);
+	__m128i r, even, odd;
+	a3i32 tail[4];
+#else	// !A3_DEMORANDOM_SSE2
+	a3ui32 result[4];
+#endif	// A3_DEMORANDOM_SSE2
+
+	if (lanes && values_out)
+	{
+		for (i = 0; i < count; i += 4)
+		{
+#ifdef A3_DEMORANDOM_SSE2
+			// high half of the 64-bit product with the range; SSE2 only 
+			//	multiplies even lanes, so odd lanes are shifted down first
+			r = a3demo_randomLanesStep_internal(lanes);
+			even = _mm_srli_epi64(_mm_mul_epu32(r, vRange), 32);
+			odd = _mm_and_si128(_mm_mul_epu32(_mm_srli_epi64(r, 32), vRange), maskHigh);
+			r = _mm_add_epi32(_mm_or_si128(even, odd), vMin);
+			if (i + 4 <= count)
+				_mm_storeu_si128((__m128i *)(values_out + i), r);
+			else
+			{
+				_mm_storeu_si128((__m128i *)tail, r);
+				for (j = i; j < count; ++j)
+					values_out[j] = tail[j - i];
+			}
+#else	// !A3_DEMORANDOM_SSE2
+			a3demo_randomLanesStep_internal(lanes, result);
+			for (j = 0; j < 4 && i + j < count; ++j)
+				values_out[i + j] = nMin + (a3i32)(((a3ui64)result[j] * range) >> 32);
+#endif	// A3_DEMORANDOM_SSE2
+		}
+		return count;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+void a3demo_randomBenchmark(const a3ui32 count)
+{
+	a3f32 *values = (a3f32 *)malloc(count * sizeof(a3f32));
+	a3_DemoRandom rng[1];
+	a3_DemoRandomPCG pcg[1];
+	a3_DemoRandomLanes lanes[1];
+	a3_Timer timer[1] = { 0 };
+	a3f64 time, sum;
+	a3ui32 i, k;
+	const a3byte *name[] = {
+		"a3random (global seed)",
+		"xoshiro128++",
+		"PCG32",
+		"xoshiro128++ x4 fill",
+	};
+
+	if (!values || !count)
+	{
+		free(values);
+		return;
+	}
+
+	a3demo_randomSeed(rng, 2048);
+	a3demo_randomPCGSeed(pcg, 2048, 0);
+	a3demo_randomLanesCreate(lanes, rng);
+
+	// same work for each: write normalized reals to an array, then take 
+	//	the mean to check the distribution and keep the writes alive
+	printf("\n\n A3 random number benchmark (%u normalized reals each): ", count);
+	for (k = 0; k < 4; ++k)
+	{
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		switch (k)
+		{
+		case 0:
+			a3randomSetSeed(2048);
+			for (i = 0; i < count; ++i)
+				values[i] = (a3f32)a3randomNormalized();
+			break;
+		case 1:
+			for (i = 0; i < count; ++i)
+				values[i] = a3demo_randomNormalized(rng);
+			break;
+		case 2:
+			for (i = 0; i < count; ++i)
+				values[i] = (a3f32)(a3demo_randomPCGNext(pcg) >> 8) * A3_DEMO_RANDOM_REAL_SCALE;
+			break;
+		case 3:
+			a3demo_randomFillReal(lanes, values, count, 0.0f, 1.0f);
+			break;
+		}
+		a3timerUpdate(timer);
+		time = timer->totalTime;
+
+		for (i = 0, sum = 0.0; i < count; ++i)
+			sum += values[i];
+		printf("\n\t %-24s %8.2lf ms (%7.1lf M/s), mean %.4lf", name[k],
+			time * 1000.0, (a3f64)count / time * 1.0e-6, sum / (a3f64)count);
+	}
+	printf("\n");
+	free(values);
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,422 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoSceneGraph.c
+	Scene hierarchy sorting and world transform propagation.
+*/
+
+#include "../a3_DemoSceneGraph.h"
+
+#include "../a3_DemoRandom.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+// one worker's share of the hierarchy: whole root trees only
+typedef struct a3_DemoSceneGraphRange_internal
+{
+	a3_DemoSceneGraph *graph;
+	a3ui32 first, end;
+} a3_DemoSceneGraphRange_internal;
+
+
+// forward pass over a range that starts at a root; a dirty node takes
+//	its whole subtree with it, so one bound covers every dirty ancestor
+inline a3ui32 a3demo_sceneGraphPropagate_internal(a3_DemoSceneGraph *graph, const a3ui32 first, const a3ui32 end)
+{
+	a3ui32 i, dirtyEnd = first, updated = 0;
+	a3i32 p;
+	for (i = first; i < end; ++i)
+	{
+		if (graph->dirty[i] || i < dirtyEnd)
+		{
+			if (graph->subtreeEnd[i] > dirtyEnd)
+				dirtyEnd = graph->subtreeEnd[i];
+
+			// parent comes first, so its world transform is already final
+			p = graph->parent[i];
+			if (p >= 0)
+				a3real4x4ProductTransform(graph->worldMat[i].m, graph->worldMat[p].m, graph->localMat[i].m);
+			else
+				graph->worldMat[i] = graph->localMat[i];
+			a3real4x4TransformInverse(graph->worldMatInv[i].m, graph->worldMat[i].m);
+			graph->dirty[i] = 0;
+			++updated;
+		}
+	}
+	return updated;
+}
+
+a3ret a3demo_sceneGraphWorker_internal(void *args)
+{
+	a3_DemoSceneGraphRange_internal *range = (a3_DemoSceneGraphRange_internal *)args;
+	return a3demo_sceneGraphPropagate_internal(range->graph, range->first, range->end);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_sceneGraphCreate(a3_DemoSceneGraph *graph_out, const a3i32 *parentIndex, const a3ui32 count)
+{
+	a3ui32 *first, *child, *stack;
+	a3ui32 i, j, k, n, top;
+	if (graph_out && parentIndex && count)
+	{
+		if (!graph_out->localMat)
+		{
+			for (i = 0; i < count; ++i)
+				if (parentIndex[i] >= (a3i32)count || parentIndex[i] == (a3i32)i)
+					return -1;
+
+			// children grouped by parent in object order: children of
+			//	object i are child[first[i]] up to child[first[i + 1]]
+			first = (a3ui32 *)calloc(count * 3 + 1, sizeof(a3ui32));
+			if (!first)
+				return 0;
+			child = first + count + 1;
+			stack = child + count;
+			for (i = 0; i < count; ++i)
+				if (parentIndex[i] >= 0)
+					++first[parentIndex[i] + 1];
+			for (i = 0; i < count; ++i)
+				first[i + 1] += first[i];
+			for (i = 0; i < count; ++i)
+				stack[i] = first[i];
+			for (i = 0; i < count; ++i)
+				if (parentIndex[i] >= 0)
+					child[stack[parentIndex[i]]++] = i;
+
+			graph_out->localMat = (a3mat4 *)malloc(count * (3 * sizeof(a3mat4) + 4 * sizeof(a3ui32) + sizeof(a3ubyte)));
+			if (!graph_out->localMat)
+			{
+				free(first);
+				return 0;
+			}
+			graph_out->worldMat = graph_out->localMat + count;
+			graph_out->worldMatInv = graph_out->worldMat + count;
+			graph_out->parent = (a3i32 *)(graph_out->worldMatInv + count);
+			graph_out->subtreeEnd = (a3ui32 *)(graph_out->parent + count);
+			graph_out->object = graph_out->subtreeEnd + count;
+			graph_out->node = graph_out->object + count;
+			graph_out->dirty = (a3ubyte *)(graph_out->node + count);
+
+			// depth-first from each root; children are pushed last to
+			//	first so siblings come out in object order
+			for (i = n = 0; i < count; ++i)
+			{
+				if (parentIndex[i] < 0)
+				{
+					stack[0] = i;
+					top = 1;
+					while (top)
+					{
+						j = stack[--top];
+						graph_out->node[j] = n;
+						graph_out->object[n] = j;
+						graph_out->parent[n] = parentIndex[j] >= 0 ? (a3i32)graph_out->node[parentIndex[j]] : -1;
+						++n;
+						for (k = first[j + 1]; k > first[j]; --k)
+							stack[top++] = child[k - 1];
+					}
+				}
+			}
+			free(first);
+
+			// objects not reached from a root are on a cycle
+			if (n < count)
+			{
+				free(graph_out->localMat);
+				memset(graph_out, 0, sizeof(a3_DemoSceneGraph));
+				return -1;
+			}
+
+			// children end their subtrees no later than the parent does,
+			//	and are all visited before it going backwards
+			for (i = 0; i < count; ++i)
+			{
+				graph_out->subtreeEnd[i] = i + 1;
+				graph_out->localMat[i] = graph_out->worldMat[i] = graph_out->worldMatInv[i] = a3mat4_identity;
+				graph_out->dirty[i] = 1;
+			}
+			for (i = count - 1; i > 0; --i)
+				if (graph_out->parent[i] >= 0 && graph_out->subtreeEnd[i] > graph_out->subtreeEnd[graph_out->parent[i]])
+					graph_out->subtreeEnd[graph_out->parent[i]] = graph_out->subtreeEnd[i];
+			graph_out->count = count;
+			return count;
+		}
+	}
+	return -1;
+}
+
+a3ret a3demo_sceneGraphRelease(a3_DemoSceneGraph *graph)
+{
+	if (graph)
+	{
+		if (graph->localMat)
+		{
+			free(graph->localMat);
+			memset(graph, 0, sizeof(a3_DemoSceneGraph));
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_sceneGraphSetLocal(a3_DemoSceneGraph *graph, const a3ui32 object, a3real4x4p const localMat)
+{
+	a3ui32 i;
+	if (graph && graph->localMat && object < graph->count && localMat)
+	{
+		i = graph->node[object];
+		if (memcmp(graph->localMat[i].m, localMat, sizeof(a3mat4)))
+		{
+			memcpy(graph->localMat[i].m, localMat, sizeof(a3mat4));
+			graph->dirty[i] = 1;
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_sceneGraphUpdate(a3_DemoSceneGraph *graph)
+{
+	if (graph && graph->localMat)
+		return a3demo_sceneGraphPropagate_internal(graph, 0, graph->count);
+	return -1;
+}
+
+a3ret a3demo_sceneGraphUpdateParallel(a3_DemoSceneGraph *graph, const a3ui32 threadCount)
+{
+	a3_Thread thread[a3demo_sceneGraphThreadMax] = { 0 };
+	a3_DemoSceneGraphRange_internal range[a3demo_sceneGraphThreadMax];
+	a3ui32 i, n, g, limit, launched = 0;
+	a3ret updated = 0;
+
+	if (graph && graph->localMat && threadCount)
+	{
+		// consecutive root trees until each share reaches its node count;
+		//	the last share takes whatever is left
+		n = threadCount < a3demo_sceneGraphThreadMax ? threadCount : a3demo_sceneGraphThreadMax;
+		for (g = i = 0; g < n && i < graph->count; ++g)
+		{
+			range[g].graph = graph;
+			range[g].first = i;
+			limit = graph->count / n * (g + 1);
+			do
+				i = graph->subtreeEnd[i];
+			while (i < graph->count && (i < limit || g + 1 == n));
+			range[g].end = i;
+		}
+
+		// trees are independent, so workers write without locking; a
+		//	range whose thread fails to launch is done here instead
+		for (i = 0; i + 1 < g; ++i)
+			if (a3threadLaunch(thread + i, a3demo_sceneGraphWorker_internal, range + i, "a3sceneGraph") > 0)
+				launched |= (1u << i);
+			else
+				updated += a3demo_sceneGraphWorker_internal(range + i);
+		updated += a3demo_sceneGraphWorker_internal(range + i);
+		for (i = 0; i + 1 < g; ++i)
+			if (launched & (1u << i))
+			{
+				a3threadWait(thread + i);
+				updated += thread[i].result;
+			}
+		return updated;
+	}
+	return -1;
+}
+
+a3ret a3demo_sceneGraphApply(const a3_DemoSceneGraph *graph, a3_DemoSceneObject *sceneObject)
+{
+	a3ui32 i;
+	if (graph && graph->localMat && sceneObject)
+	{
+		for (i = 0; i < graph->count; ++i)
+		{
+			sceneObject[graph->object[i]].modelMat = graph->worldMat[i];
+			sceneObject[graph->object[i]].modelMatInv = graph->worldMatInv[i];
+		}
+		return graph->count;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+void a3demo_sceneGraphBenchmark(const a3ui32 nodeCount)
+{
+	// characters: spine of 16 joints with four limbs of 12 hanging off it
+	enum { spineCount = 16, limbCount = 4, limbLength = 12, jointCount = spineCount + limbCount * limbLength, repeatCount = 16 };
+	const a3ui32 limbRoot[limbCount] = { 3, 3, 13, 13 };
+	const a3ui32 threadCount[] = { 2, 4, 8 };
+	const a3ui32 threadCountCount = sizeof(threadCount) / sizeof(*threadCount);
+	const a3ui32 characterCount = (nodeCount + jointCount - 1) / jointCount, count = characterCount * jointCount;
+	a3_DemoSceneGraph graph[1] = { 0 };
+	a3_DemoRandom rng[1];
+	a3_DemoRandomLanes lanes[1];
+	a3_Timer timer[1] = { 0 };
+	a3mat4 *local = 0, *world, *worldInv, m, tmp;
+	a3i32 *parentIndex = 0;
+	a3f32 param[6], d, error = 0.0f;
+	a3f64 time[3], timeThread[sizeof(threadCount) / sizeof(*threadCount)];
+	a3ui32 i, j, k, c, updated[2] = { 0 };
+	a3i32 p;
+
+	if (!nodeCount
+		|| !(local = (a3mat4 *)malloc(count * 3 * sizeof(a3mat4)))
+		|| !(parentIndex = (a3i32 *)malloc(count * sizeof(a3i32))))
+	{
+		free(local);
+		return;
+	}
+	world = local + count;
+	worldInv = world + count;
+
+	// joints listed spine first, so sorting has to move every limb up
+	//	next to its attachment
+	for (c = 0; c < characterCount; ++c)
+	{
+		for (j = 0; j < jointCount; ++j)
+		{
+			i = c * jointCount + j;
+			if (j < spineCount)
+				parentIndex[i] = j ? (a3i32)(i - 1) : -1;
+			else if ((j - spineCount) % limbLength)
+				parentIndex[i] = (a3i32)(i - 1);
+			else
+				parentIndex[i] = (a3i32)(c * jointCount + limbRoot[(j - spineCount) / limbLength]);
+		}
+	}
+	if (a3demo_sceneGraphCreate(graph, parentIndex, count) <= 0)
+	{
+		free(local);
+		free(parentIndex);
+		return;
+	}
+
+	// joints are a small twist and an offset from the parent, characters
+	//	are spread out
+	a3demo_randomSeed(rng, 2048);
+	a3demo_randomLanesCreate(lanes, rng);
+	for (i = 0; i < count; ++i)
+	{
+		a3demo_randomFillReal(lanes, param, 6, -1.0f, 1.0f);
+		a3real4x4SetRotateXYZ(local[i].m, param[0] * 15.0f, param[1] * 15.0f, param[2] * 15.0f);
+		if (parentIndex[i] >= 0)
+			a3real3Set(local[i].v3.v, param[3] * 0.05f, param[4] * 0.05f, 0.25f);
+		else
+			a3real3Set(local[i].v3.v, param[3] * 64.0f, param[4] * 64.0f, param[5] * 4.0f);
+		a3demo_sceneGraphSetLocal(graph, i, local[i].m);
+	}
+
+	// every object on its own: walk up to the root, concatenating
+	a3timerSet(timer, 0.0);
+	a3timerStart(timer);
+	for (k = 0; k < repeatCount; ++k)
+	{
+		for (i = 0; i < count; ++i)
+		{
+			m = local[i];
+			for (p = parentIndex[i]; p >= 0; p = parentIndex[p])
+			{
+				a3real4x4ProductTransform(tmp.m, local[p].m, m.m);
+				m = tmp;
+			}
+			world[i] = m;
+			a3real4x4TransformInverse(worldInv[i].m, m.m);
+		}
+	}
+	a3timerUpdate(timer);
+	time[0] = timer->totalTime;
+
+	// sorted pass, everything changed
+	a3timerSet(timer, 0.0);
+	a3timerStart(timer);
+	for (k = 0; k < repeatCount; ++k)
+	{
+		memset(graph->dirty, 1, count);
+		updated[0] = a3demo_sceneGraphUpdate(graph);
+	}
+	a3timerUpdate(timer);
+	time[1] = timer->totalTime;
+	for (i = 0; i < count; ++i)
+		for (j = 0; j < 16; ++j)
+		{
+			d = (a3f32)fabs(graph->worldMat[graph->node[i]].m[j / 4][j % 4] - world[i].m[j / 4][j % 4]);
+			error = d > error ? d : error;
+		}
+
+	// sorted pass, one character in sixteen turns at the hips
+	a3timerSet(timer, 0.0);
+	a3timerStart(timer);
+	for (k = 0; k < repeatCount; ++k)
+	{
+		for (c = 0; c < characterCount; c += 16)
+		{
+			i = c * jointCount + 1;
+			a3real4x4SetRotateZ(m.m, (a3real)(k + 1));
+			m.v3 = local[i].v3;
+			a3demo_sceneGraphSetLocal(graph, i, m.m);
+		}
+		updated[1] = a3demo_sceneGraphUpdate(graph);
+	}
+	a3timerUpdate(timer);
+	time[2] = timer->totalTime;
+
+	// sorted pass split by character, everything changed
+	for (j = 0; j < threadCountCount; ++j)
+	{
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		for (k = 0; k < repeatCount; ++k)
+		{
+			memset(graph->dirty, 1, count);
+			a3demo_sceneGraphUpdateParallel(graph, threadCount[j]);
+		}
+		a3timerUpdate(timer);
+		timeThread[j] = timer->totalTime;
+	}
+
+	printf("\n\n A3 scene graph benchmark (%u characters, %u joints each, depth %u, %u updates): ",
+		characterCount, jointCount, limbRoot[limbCount - 1] + limbLength + 1, repeatCount);
+	printf("\n\t parent walk per object  %8.3lf ms", time[0] * 1000.0);
+	printf("\n\t sorted, all dirty       %8.3lf ms (x%6.2lf) | %u nodes | max error %.2e", time[1] * 1000.0, time[0] / time[1], updated[0], error);
+	printf("\n\t sorted, 1/16 dirty      %8.3lf ms (x%6.2lf) | %u nodes", time[2] * 1000.0, time[0] / time[2], updated[1]);
+	for (j = 0; j < threadCountCount; ++j)
+		printf("\n\t sorted, %u threads       %8.3lf ms (x%6.2lf)", threadCount[j], timeThread[j] * 1000.0, time[0] / timeThread[j]);
+	printf("\n");
+
+	a3demo_sceneGraphRelease(graph);
+	free(local);
+	free(parentIndex);
+}
+
+
+//-----------------------------------------------------------------------------
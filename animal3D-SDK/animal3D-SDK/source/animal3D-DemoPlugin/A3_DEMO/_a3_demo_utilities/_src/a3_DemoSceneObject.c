@@ -26,6 +26,8 @@
 
 #include "../a3_DemoRenderUtils.h"
 
+#include <math.h>
+
 
 //-----------------------------------------------------------------------------
 
@@ -99,6 +101,7 @@ extern inline void a3demo_initProjector(a3_DemoProjector *projector)
 	projector->ctrlMoveSpeed = a3real_zero;
 	projector->ctrlRotateSpeed = a3real_zero;
 	projector->ctrlZoomSpeed = a3real_zero;
+	projector->cascadeCount = 0;
 }
 
 extern inline void a3demo_updateProjectorProjectionMat(a3_DemoProjector *projector)
@@ -116,6 +119,115 @@ extern inline void a3demo_updateProjectorViewProjectionMat(a3_DemoProjector *pro
 	a3real4x4Product(projector->viewProjectionMat.m, projector->projectionMat.m, projector->sceneObject->modelMatInv.m);
 }
 
+extern inline void a3demo_updateProjectorShadowCascades(a3_DemoProjector *projector, a3_DemoProjector const *viewer, const a3ui32 cascadeCount, const a3real shadowDist, const a3real splitBlend, const a3ui32 tileSize)
+{
+	// bias into a tile of the atlas: clip [-1,+1] -> tile [0,1/n] + offset
+	const a3real tileScale = a3recip((a3real)a3demo_shadowCascadeAtlasTiles);
+	a3mat4 tileBias = a3mat4_identity, proj, view = a3mat4_identity;
+	a3real3 axis[3], center, centerLight;
+	a3real farDist = a3minimum(viewer->zfar, shadowDist), nearDist = viewer->znear;
+	a3real d0, d1, dc, k0, k1, radius, texel, t;
+	a3ui32 i, j;
+
+	projector->cascadeCount = a3minimum(cascadeCount, a3demo_shadowCascadeMax);
+
+	// cascades look along the projector's forward axis; ignore its position
+	for (j = 0; j < 3; ++j)
+		a3real3GetUnit(axis[j], projector->sceneObject->modelMat.m[j]);
+
+	// squared spread of the viewer's frustum per unit depth (persp) or 
+	//	constant squared half-diagonal (ortho)
+	if (viewer->perspective)
+	{
+		t = a3tand(viewer->fovy * a3real_half);
+		t *= t * (a3real_one + viewer->aspect * viewer->aspect);
+	}
+	else
+	{
+		t = viewer->fovy * a3real_half;
+		t *= t * (a3real_one + viewer->aspect * viewer->aspect);
+	}
+
+	for (i = 0, d0 = nearDist; i < projector->cascadeCount; ++i, d0 = d1)
+	{
+		// split: blend of logarithmic and uniform distribution
+		d1 = (a3real)(i + 1) / (a3real)projector->cascadeCount;
+		d1 = a3lerp(nearDist + (farDist - nearDist) * d1, nearDist * (a3real)pow(farDist / nearDist, d1), splitBlend);
+		projector->cascadeSplit[i] = d1;
+
+		// bounding sphere of slice, centered on view axis: depends only on 
+		//	depths and lens, so it does not change as the viewer turns
+		if (viewer->perspective)
+		{
+			k0 = d0 * d0 * t;
+			k1 = d1 * d1 * t;
+			dc = a3minimum((d0 + d1) * (a3real_one + t) * a3real_half, d1);
+		}
+		else
+		{
+			k0 = k1 = t;
+			dc = (d0 + d1) * a3real_half;
+		}
+		radius = a3maximum((a3real)sqrt((dc - d0) * (dc - d0) + k0), (a3real)sqrt((d1 - dc) * (d1 - dc) + k1));
+
+		// round radius up to whole texels so the tile is an integer grid
+		texel = (radius + radius) / (a3real)tileSize;
+		radius = texel * (a3real)ceil(radius / texel);
+		texel = (radius + radius) / (a3real)tileSize;
+
+		// center in world, then in light space
+		a3real3ProductS(center, viewer->sceneObject->modelMat.m[2], -dc);
+		a3real3Add(center, viewer->sceneObject->modelMat.m[3]);
+		for (j = 0; j < 3; ++j)
+			centerLight[j] = a3real3Dot(axis[j], center);
+
+		// snap to texel grid: moving the viewer shifts the cascade by whole 
+		//	texels only, which keeps shadow edges from shimmering
+		centerLight[0] = texel * (a3real)floor(centerLight[0] / texel);
+		centerLight[1] = texel * (a3real)floor(centerLight[1] / texel);
+
+		// view: rows are light axes, sphere sits in front of near plane
+		for (j = 0; j < 3; ++j)
+		{
+			view.m[0][j] = axis[j][0];
+			view.m[1][j] = axis[j][1];
+			view.m[2][j] = axis[j][2];
+			view.m[3][j] = -centerLight[j];
+		}
+		view.m[3][2] -= radius;
+
+		a3real4x4MakeOrthographicProjection(proj.m, 0, radius + radius, radius + radius, a3real_zero, radius + radius);
+		a3real4x4Product(projector->cascadeViewProjectionMat[i].m, proj.m, view.m);
+
+		// atlas: cascade i goes in tile (i % n, i / n)
+		tileBias.m[0][0] = tileBias.m[1][1] = tileScale * a3real_half;
+		tileBias.m[2][2] = a3real_half;
+		tileBias.m[3][0] = tileScale * ((a3real)(i % a3demo_shadowCascadeAtlasTiles) + a3real_half);
+		tileBias.m[3][1] = tileScale * ((a3real)(i / a3demo_shadowCascadeAtlasTiles) + a3real_half);
+		tileBias.m[3][2] = a3real_half;
+		a3real4x4Product(projector->cascadeAtlasMat[i].m, tileBias.m, projector->cascadeViewProjectionMat[i].m);
+	}
+}
+
+extern inline a3boolean a3demo_testProjectorShadowCascade(a3_DemoProjector const *projector, const a3ui32 cascade, a3real3p const center, const a3real radius)
+{
+	// cascade projection is orthographic: sphere stays a sphere in clip, 
+	//	scaled per axis by length of the matrix row
+	const a3real4 *m = projector->cascadeViewProjectionMat[cascade].m;
+	a3real c, r;
+	a3ui32 j;
+	for (j = 0; j < 3; ++j)
+	{
+		c = m[0][j] * center[0] + m[1][j] * center[1] + m[2][j] * center[2] + m[3][j];
+		r = radius * (a3real)sqrt(m[0][j] * m[0][j] + m[1][j] * m[1][j] + m[2][j] * m[2][j]);
+
+		// casters in front of near plane still cast; depth is clamped
+		if (c - r > a3real_one || (j < 2 && c + r < -a3real_one))
+			return a3false;
+	}
+	return a3true;
+}
+
 
 extern inline void a3demo_resetModelMatrixStack(a3_DemoModelMatrixStack* model)
 {
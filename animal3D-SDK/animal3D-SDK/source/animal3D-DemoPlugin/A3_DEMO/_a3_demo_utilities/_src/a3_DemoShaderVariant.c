@@ -0,0 +1,298 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_DemoShaderVariant.c
+	Shader permutation and variant cache implementations.
+*/
+
+#include "../a3_DemoShaderVariant.h"
+#include "animal3D-A3DG/a3graphics/a3_ShaderProgramParallel.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_shaderCreatePreprocessed(a3_Shader *shader_out, const a3byte name[32], const a3_ShaderType type, const a3byte **filePathList, const a3ui32 count, const a3byte *defines_opt, a3_DemoShaderDepend *depend_opt, const a3boolean deferred)
+{
+	a3_ShaderSource source[a3demo_shaderSourceFileMax] = { 0 };
+	const a3byte *text[a3demo_shaderSourceFileMax];
+	a3ui32 i, textCount = 0;
+	a3ret result = 0;
+
+	if (shader_out && filePathList && count && count <= a3demo_shaderSourceFileMax)
+	{
+		// expand all files; defines go in the first, which has the version
+		for (i = 0; i < count; ++i)
+		{
+			if (a3shaderSourcePreprocessFile(source + i, filePathList[i], i ? 0 : defines_opt) > 0)
+				text[textCount++] = source[i].text;
+
+			// files are watched even if they could not be read
+			if (depend_opt)
+			{
+				a3demo_shaderDependAddFile(depend_opt, filePathList[i]);
+				a3demo_shaderDependAddSource(depend_opt, source + i);
+			}
+		}
+
+		// compile only if every file expanded
+		if (textCount == count)
+			result = deferred
+				? a3shaderCreateFromSourceListDeferred(shader_out, name, type, text, textCount)
+				: a3shaderCreateFromSourceList(shader_out, name, type, text, textCount);
+
+		for (i = 0; i < count; ++i)
+			a3shaderSourceRelease(source + i);
+		return (result > 0 ? result : 0);
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// write defines for feature key
+void a3demo_shaderVariantInternalDefines(a3byte *defines, const a3ui32 features)
+{
+	a3ui32 const mrtCount = (features >> a3demo_shaderFeatureMRTShift) & a3demo_shaderFeatureCountMask;
+	a3ui32 const lightCount = (features >> a3demo_shaderFeatureLightShift) & a3demo_shaderFeatureCountMask;
+	*defines = 0;
+	if (features & a3demo_shaderFeatureInstanced)
+		defines += sprintf(defines, "#define A3_INSTANCED 1\n");
+	if (features & a3demo_shaderFeatureShadow)
+		defines += sprintf(defines, "#define A3_SHADOW 1\n");
+	if (features & a3demo_shaderFeatureDualQuat)
+		defines += sprintf(defines, "#define A3_DUAL_QUAT 1\n");
+	if (mrtCount)
+		defines += sprintf(defines, "#define A3_MRT_COUNT %u\n", mrtCount);
+	if (lightCount)
+		defines += sprintf(defines, "#define A3_LIGHT_COUNT %u\n", lightCount);
+}
+
+// build variant program from binary or source
+a3ret a3demo_shaderVariantInternalBuild(a3_DemoShaderVariantCache *cache, a3_DemoShaderVariant *variant, a3_DemoStateShaderProgram *program_out)
+{
+	a3_ShaderSource source[a3shader_compute + 1] = { 0 };
+	a3_Shader shader[a3shader_compute + 1] = { 0 };
+	a3_ShaderProgramReflection reflection[1] = { 0 };
+	a3byte defines[128], name[32], binaryPath[a3shaderSource_pathMax + 32], reflectionPath[a3shaderSource_pathMax + 32];
+	a3boolean reflected = 0;
+	a3byte const *const baseName = cache->base[variant->baseIndex].name;
+	a3byte const *text;
+	a3i64 newestTime = 0;
+	a3ui32 i;
+	a3ret result = 1;
+
+	a3demo_shaderVariantInternalDefines(defines, variant->features);
+	sprintf(name, "var:%.18s:%04x", baseName, variant->features);
+
+	// expand every stage first so that all files involved are known
+	variant->depend->count = 0;
+	for (i = 0; i <= a3shader_compute; ++i)
+	{
+		if (*cache->base[variant->baseIndex].filePath[i])
+		{
+			if (a3shaderSourcePreprocessFile(source + i, cache->base[variant->baseIndex].filePath[i], defines) <= 0)
+				result = 0;
+			a3demo_shaderDependAddFile(variant->depend, cache->base[variant->baseIndex].filePath[i]);
+			a3demo_shaderDependAddSource(variant->depend, source + i);
+		}
+	}
+	for (i = 0; i < variant->depend->count; ++i)
+		if (newestTime < variant->depend->fileTime[i])
+			newestTime = variant->depend->fileTime[i];
+
+	if (result && a3shaderProgramCreate(program_out->program, name) > 0)
+	{
+		// a binary newer than every source file is as good as compiling
+		if (*cache->binaryDirectory)
+		{
+			sprintf(binaryPath, "%s%s-%04x.bin", cache->binaryDirectory, baseName, variant->features);
+			sprintf(reflectionPath, "%s%s-%04x.ref", cache->binaryDirectory, baseName, variant->features);
+			if (a3demo_getFileModifiedTime(binaryPath) >= newestTime &&
+				a3shaderProgramLoadBinary(program_out->program, binaryPath) > 0)
+			{
+				// uniform layout was stored with the binary
+				reflected = a3shaderProgramReflectionLoadFile(reflection, reflectionPath) > 0;
+				++cache->binaryCount;
+			}
+		}
+
+		// otherwise compile, link and store binary for next time
+		if (!program_out->program->linked)
+		{
+			for (i = 0; i <= a3shader_compute && result; ++i)
+			{
+				if ((text = source[i].text) != 0)
+				{
+					if (a3shaderCreateFromSourceList(shader + i, name, (a3_ShaderType)i, &text, 1) > 0)
+						a3shaderProgramAttachShader(program_out->program, shader + i);
+					else
+						result = 0;
+				}
+			}
+			if (result && a3shaderProgramLink(program_out->program) > 0)
+			{
+				++cache->compileCount;
+				if (*cache->binaryDirectory)
+					a3shaderProgramSaveBinary(program_out->program, binaryPath);
+			}
+			else
+				result = 0;
+
+			// program keeps what it needs once linked
+			for (i = 0; i <= a3shader_compute; ++i)
+				a3shaderRelease(shader + i);
+		}
+
+		// query uniforms once and keep them with the binary
+		if (result && !reflected)
+		{
+			a3shaderProgramReflect(reflection, program_out->program);
+			if (*cache->binaryDirectory)
+				a3shaderProgramReflectionSaveFile(reflection, reflectionPath);
+		}
+
+		if (result && cache->initFunc)
+			cache->initFunc(program_out, reflection);
+		else if (!result)
+			a3shaderProgramRelease(program_out->program);
+	}
+	else
+		result = 0;
+
+	for (i = 0; i <= a3shader_compute; ++i)
+		a3shaderSourceRelease(source + i);
+	return result;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_shaderVariantCacheCreate(a3_DemoShaderVariantCache *cache, const a3_DemoShaderVariantBase *baseList, const a3ui32 baseCount, const a3_DemoShaderVariantInitFunc initFunc, const a3byte *binaryDirectory_opt)
+{
+	a3ui32 i, j;
+	if (cache && baseList && baseCount && baseCount <= a3demo_shaderVariantBaseMax)
+	{
+		memset(cache, 0, sizeof(a3_DemoShaderVariantCache));
+		for (i = 0; i < baseCount; ++i)
+		{
+			strncpy(cache->base[i].name, baseList[i].name, a3demo_shaderVariantNameMax - 1);
+			for (j = 0; j <= a3shader_compute; ++j)
+				if (baseList[i].filePath[j])
+					strncpy(cache->base[i].filePath[j], baseList[i].filePath[j], a3shaderSource_pathMax - 1);
+		}
+		if (binaryDirectory_opt)
+			strncpy(cache->binaryDirectory, binaryDirectory_opt, a3shaderSource_pathMax - 1);
+		cache->initFunc = initFunc;
+		cache->baseCount = baseCount;
+		return baseCount;
+	}
+	return -1;
+}
+
+const a3_DemoStateShaderProgram *a3demo_shaderVariantRequest(a3_DemoShaderVariantCache *cache, const a3ui32 baseIndex, const a3ui32 features)
+{
+	a3_DemoShaderVariant *variant;
+	a3ui32 i;
+	if (cache && baseIndex < cache->baseCount)
+	{
+		for (i = 0, variant = cache->variant; i < cache->variantCount; ++i, ++variant)
+			if (variant->baseIndex == baseIndex && variant->features == features)
+				return (variant->failed ? 0 : variant->program);
+
+		// first request: build now
+		if (i < a3demo_shaderVariantMax)
+		{
+			variant->baseIndex = baseIndex;
+			variant->features = features;
+			variant->failed = !a3demo_shaderVariantInternalBuild(cache, variant, variant->program);
+			++cache->variantCount;
+			if (variant->failed)
+				printf("\n ^^^^ SHADER VARIANT '%s' (%04x) FAILED TO BUILD \n\n", cache->base[baseIndex].name, features);
+			return (variant->failed ? 0 : variant->program);
+		}
+	}
+	return 0;
+}
+
+a3ret a3demo_shaderVariantCacheReload(a3_DemoShaderVariantCache *cache)
+{
+	a3_DemoStateShaderProgram program[1];
+	a3_DemoShaderVariant *variant;
+	a3ui32 i, count = 0;
+	if (cache)
+	{
+		for (i = 0, variant = cache->variant; i < cache->variantCount; ++i, ++variant)
+		{
+			if (a3demo_shaderDependUpdate(variant->depend) > 0)
+			{
+				memset(program, 0, sizeof(program));
+				if (a3demo_shaderVariantInternalBuild(cache, variant, program))
+				{
+					if (!variant->failed)
+						a3shaderProgramRelease(variant->program->program);
+					*variant->program = *program;
+					variant->failed = 0;
+					++count;
+				}
+				else
+					printf("\n ^^^^ SHADER VARIANT '%s' (%04x) FAILED TO REBUILD; KEEPING PREVIOUS \n\n", cache->base[variant->baseIndex].name, variant->features);
+			}
+		}
+		return count;
+	}
+	return -1;
+}
+
+a3ret a3demo_shaderVariantCacheRelease(a3_DemoShaderVariantCache *cache)
+{
+	a3_DemoShaderVariant *variant;
+	a3ui32 i, count = 0;
+	if (cache)
+	{
+		for (i = 0, variant = cache->variant; i < cache->variantCount; ++i, ++variant)
+			if (!variant->failed)
+				count += (a3shaderProgramRelease(variant->program->program) >= 0);
+		memset(cache->variant, 0, sizeof(cache->variant));
+		cache->variantCount = 0;
+		return count;
+	}
+	return -1;
+}
+
+a3ret a3demo_shaderVariantCacheHandleUpdateReleaseCallbacks(a3_DemoShaderVariantCache *cache, const a3_DemoShaderVariantInitFunc initFunc)
+{
+	a3ui32 i;
+	if (cache)
+	{
+		for (i = 0; i < cache->variantCount; ++i)
+			if (!cache->variant[i].failed)
+				a3shaderProgramHandleUpdateReleaseCallback(cache->variant[i].program->program);
+		cache->initFunc = initFunc;
+		return cache->variantCount;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
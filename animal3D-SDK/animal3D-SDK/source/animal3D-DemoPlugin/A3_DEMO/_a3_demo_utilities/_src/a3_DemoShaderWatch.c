@@ -0,0 +1,192 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_DemoShaderWatch.c
+	Shader directory watching implementations.
+*/
+
+#include "../a3_DemoShaderWatch.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif	// _WIN32
+
+
+// seconds between polls without notifications, and after a change
+#define A3_DEMO_SHADERWATCH_POLL	0.5
+#define A3_DEMO_SHADERWATCH_SETTLE	0.1
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_shaderWatchCreate(a3_DemoShaderWatch *watch, const a3byte *directory)
+{
+	if (watch && directory && *directory)
+	{
+		watch->notify = 0;
+		watch->pollTime = A3_DEMO_SHADERWATCH_POLL;
+		watch->settleTime = -1.0;
+#ifdef _WIN32
+		// signaled when any file in the tree is written, created or renamed
+		watch->notify = FindFirstChangeNotificationA(directory, TRUE,
+			FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+		if (watch->notify == INVALID_HANDLE_VALUE)
+			watch->notify = 0;
+#endif	// _WIN32
+		return (watch->notify != 0);
+	}
+	return -1;
+}
+
+a3ret a3demo_shaderWatchPoll(a3_DemoShaderWatch *watch, const a3f64 dt)
+{
+	a3boolean changed = 0;
+	if (watch)
+	{
+#ifdef _WIN32
+		// non-blocking check; re-arm after each signal
+		if (watch->notify)
+		{
+			while (WaitForSingleObject(watch->notify, 0) == WAIT_OBJECT_0)
+			{
+				changed = 1;
+				if (!FindNextChangeNotification(watch->notify))
+					break;
+			}
+		}
+		else
+#endif	// _WIN32
+		{
+			// no notifications: report a possible change periodically
+			watch->pollTime -= dt;
+			if (watch->pollTime <= 0.0)
+			{
+				watch->pollTime = A3_DEMO_SHADERWATCH_POLL;
+				changed = 1;
+			}
+		}
+
+		// restart settle timer on each change; report once it expires
+		if (changed)
+			watch->settleTime = A3_DEMO_SHADERWATCH_SETTLE;
+		else if (watch->settleTime >= 0.0)
+		{
+			watch->settleTime -= dt;
+			if (watch->settleTime < 0.0)
+				return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_shaderWatchRelease(a3_DemoShaderWatch *watch)
+{
+	if (watch)
+	{
+#ifdef _WIN32
+		if (watch->notify)
+			FindCloseChangeNotification(watch->notify);
+#endif	// _WIN32
+		watch->notify = 0;
+		watch->settleTime = -1.0;
+		return 1;
+	}
+	return -1;
+}
+
+a3i64 a3demo_getFileModifiedTime(const a3byte *filePath)
+{
+#ifdef _WIN32
+	struct _stat64 fileStat[1];
+	if (filePath && !_stat64(filePath, fileStat))
+		return (a3i64)fileStat->st_mtime;
+#else	// !_WIN32
+	struct stat fileStat[1];
+	if (filePath && !stat(filePath, fileStat))
+		return (a3i64)fileStat->st_mtime;
+#endif	// _WIN32
+	return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_shaderDependAddFile(a3_DemoShaderDepend *depend, const a3byte *filePath)
+{
+	a3ui32 i;
+	if (depend && filePath && *filePath)
+	{
+		for (i = 0; i < depend->count; ++i)
+			if (!strcmp(depend->filePath[i], filePath))
+				return i;
+		if (i < a3shaderSource_fileMax)
+		{
+			strncpy(depend->filePath[i], filePath, a3shaderSource_pathMax - 1);
+			depend->filePath[i][a3shaderSource_pathMax - 1] = 0;
+			depend->fileTime[i] = a3demo_getFileModifiedTime(filePath);
+			return depend->count++;
+		}
+	}
+	return -1;
+}
+
+a3ret a3demo_shaderDependAddSource(a3_DemoShaderDepend *depend, const a3_ShaderSource *source)
+{
+	a3ui32 i;
+	if (depend && source)
+	{
+		for (i = 0; i < source->fileCount; ++i)
+			a3demo_shaderDependAddFile(depend, source->filePath[i]);
+		return depend->count;
+	}
+	return -1;
+}
+
+a3ret a3demo_shaderDependUpdate(a3_DemoShaderDepend *depend)
+{
+	a3i64 fileTime;
+	a3ui32 i, changed = 0;
+	if (depend)
+	{
+		for (i = 0; i < depend->count; ++i)
+		{
+			fileTime = a3demo_getFileModifiedTime(depend->filePath[i]);
+			if (fileTime != depend->fileTime[i])
+			{
+				depend->fileTime[i] = fileTime;
+				++changed;
+			}
+		}
+		return changed;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,216 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_DemoAnimation.h
+	Keyframe animation clips for many scene objects at once: densely 
+		sampled motion is reduced to the keys needed to reproduce it within 
+		a tolerance, rotations are stored as 48-bit smallest-three 
+		quaternions and positions/scales as 16-bit values in per-track 
+		ranges. A small blend tree samples and mixes clips for every target 
+		in one pass per node.
+*/
+
+#ifndef __ANIMAL3D_DEMOANIMATION_H
+#define __ANIMAL3D_DEMOANIMATION_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+
+#include "a3_DemoSceneObject.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoAnimationPose			a3_DemoAnimationPose;
+	typedef struct a3_DemoAnimationKey			a3_DemoAnimationKey;
+	typedef struct a3_DemoAnimationTrack		a3_DemoAnimationTrack;
+	typedef struct a3_DemoAnimationClip			a3_DemoAnimationClip;
+	typedef struct a3_DemoAnimationNode			a3_DemoAnimationNode;
+	typedef struct a3_DemoAnimationBlendTree	a3_DemoAnimationBlendTree;
+	typedef enum a3_DemoAnimationChannel		a3_DemoAnimationChannel;
+	typedef enum a3_DemoAnimationNodeType		a3_DemoAnimationNodeType;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// blend tree limits
+	enum
+	{
+		a3demo_animationNodeMax = 16,
+	};
+
+	// channels animated per target; each target owns one track of each, 
+	//	stored in this order
+	enum a3_DemoAnimationChannel
+	{
+		a3demo_animationChannel_position,
+		a3demo_animationChannel_rotation,
+		a3demo_animationChannel_scale,
+
+		a3demo_animationChannel_max
+	};
+
+	// blend tree node types
+	enum a3_DemoAnimationNodeType
+	{
+		a3demo_animationNode_clip,		// sample clip at node's own time
+		a3demo_animationNode_blend,		// interpolate from first input to second by weight
+		a3demo_animationNode_add,		// layer second input on top of first, scaled by weight
+	};
+
+
+	// transforms for a batch of targets, one array per channel; 
+	//	rotations are unit quaternions (x, y, z, w), fourth component of 
+	//	position and scale is padding
+	struct a3_DemoAnimationPose
+	{
+		a3f32(*position)[4];
+		a3f32(*rotation)[4];
+		a3f32(*scale)[4];
+		a3ui32 count;
+	};
+
+	// compressed key: frame index and three quantized values; rotations 
+	//	keep the three smallest components with the index of the largest 
+	//	in their top bits, positions and scales are fractions of the track 
+	//	range
+	struct a3_DemoAnimationKey
+	{
+		a3ui16 frame;
+		a3ui16 value[3];
+	};
+
+	// keys of one channel of one target; decoded value = base + value * step
+	struct a3_DemoAnimationTrack
+	{
+		a3f32 base[3];
+		a3f32 step[3];
+		a3ui32 first;		// index of first key in clip
+		a3ui32 count;		// number of keys; one for constant tracks
+	};
+
+	// compressed clip; tracks are target-major and keys are grouped by 
+	//	track in the same order, so sampling every target walks memory 
+	//	front to back; tracks and keys share one allocation
+	struct a3_DemoAnimationClip
+	{
+		a3_DemoAnimationTrack *track;
+		a3_DemoAnimationKey *key;
+		a3f32 frameRate;
+		a3f32 duration;		// loop length; last frame is the first again
+		a3ui32 frameCount;
+		a3ui32 targetCount;
+		a3ui32 keyCount;
+	};
+
+	// blend tree node; inputs always come before the node that uses them
+	struct a3_DemoAnimationNode
+	{
+		const a3_DemoAnimationClip *clip;
+		a3ui16 *cursor;		// last key used per track, makes forward playback O(1)
+		a3f32 time, rate;
+		a3f32 weight;
+		a3ui32 input[2];
+		a3_DemoAnimationNodeType type;
+	};
+
+	// blend tree with one pose per node; the last node added is the root
+	struct a3_DemoAnimationBlendTree
+	{
+		a3_DemoAnimationNode node[a3demo_animationNodeMax];
+		a3_DemoAnimationPose pose[a3demo_animationNodeMax];
+		a3ui32 nodeCount;
+		a3ui32 targetCount;
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// allocate pose for a number of targets, all set to identity
+	a3ret a3demo_animationPoseCreate(a3_DemoAnimationPose *pose_out, const a3ui32 count);
+
+	// release pose
+	a3ret a3demo_animationPoseRelease(a3_DemoAnimationPose *pose);
+
+	// write poses to scene objects' model matrices and their inverses, 
+	//	and copy positions back so other systems can follow them
+	a3ret a3demo_animationPoseApply(a3_DemoSceneObject *sceneObject, const a3_DemoAnimationPose *pose, const a3ui32 count);
+
+
+	// compress densely sampled motion into a clip; source holds frameCount 
+	//	frames of targetCount transforms each, frame-major, and should loop 
+	//	(last frame equal to first); keys are only kept where interpolating 
+	//	would stray further than the tolerance (position and scale in 
+	//	units, rotation in radians); returns number of keys kept
+	a3ret a3demo_animationClipCreate(a3_DemoAnimationClip *clip_out, const a3_DemoAnimationPose *source, const a3ui32 frameCount, const a3f32 frameRate,
+		const a3f32 tolerancePosition, const a3f32 toleranceRotation, const a3f32 toleranceScale);
+
+	// release clip
+	a3ret a3demo_animationClipRelease(a3_DemoAnimationClip *clip);
+
+	// sample all targets at a time, wrapped to the clip duration; cursor 
+	//	is optional, holds one entry per track and should start zeroed
+	a3ret a3demo_animationClipSample(a3_DemoAnimationPose *pose_out, const a3_DemoAnimationClip *clip, const a3f32 time, a3ui16 *cursor_opt);
+
+	// file streaming for clips, with the same signatures as the stream 
+	//	read and write functions; clip must be unused when loading
+	a3ret a3demo_animationClipSaveBinary(const a3_DemoAnimationClip *clip, const a3_FileStream *fileStream);
+	a3ret a3demo_animationClipLoadBinary(a3_DemoAnimationClip *clip, const a3_FileStream *fileStream);
+
+
+	// create empty blend tree for a number of targets
+	a3ret a3demo_animationBlendTreeCreate(a3_DemoAnimationBlendTree *tree_out, const a3ui32 targetCount);
+
+	// add clip node playing at a rate; returns node index
+	a3ret a3demo_animationBlendTreeAddClip(a3_DemoAnimationBlendTree *tree, const a3_DemoAnimationClip *clip, const a3f32 rate);
+
+	// add blend or add node combining two earlier nodes; returns node index
+	a3ret a3demo_animationBlendTreeAddBlend(a3_DemoAnimationBlendTree *tree, const a3_DemoAnimationNodeType type, const a3ui32 input0, const a3ui32 input1, const a3f32 weight);
+
+	// advance clip nodes by dt and evaluate every node in order, writing 
+	//	the root into pose_out; returns number of targets
+	a3ret a3demo_animationBlendTreeEvaluate(a3_DemoAnimationBlendTree *tree, a3_DemoAnimationPose *pose_out, const a3f64 dt);
+
+	// release blend tree
+	a3ret a3demo_animationBlendTreeRelease(a3_DemoAnimationBlendTree *tree);
+
+
+	// compare compressed clip sampling against raw frames (console)
+	void a3demo_animationBenchmark(const a3ui32 targetCount);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOANIMATION_H
@@ -0,0 +1,141 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoBVH.h
+	Bounding volume hierarchy over axis-aligned boxes (scene objects,
+		light volumes): binned surface area build, refit for moving items
+		and frustum, sphere and ray queries that test a box against four
+		planes or three axes at a time.
+*/
+
+#ifndef __ANIMAL3D_DEMOBVH_H
+#define __ANIMAL3D_DEMOBVH_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoBVHNode				a3_DemoBVHNode;
+	typedef struct a3_DemoBVH					a3_DemoBVH;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// hierarchy limits
+	enum
+	{
+		a3demo_bvhLeafMax = 4,		// items per leaf, unless they cannot be told apart
+		a3demo_bvhBinCount = 16,	// candidate splits per axis during build
+		a3demo_bvhDepthMax = 64,	// traversal stack
+		a3demo_bvhPlaneMax = 8,		// planes per frustum query
+	};
+
+
+	// node: bounds, then either a range of items (leaf) or the index of
+	//	the first of two children (count is zero); fourth component of
+	//	bounds is zero so boxes can be loaded four floats at a time
+	struct a3_DemoBVHNode
+	{
+		a3f32 boundsMin[4];
+		a3f32 boundsMax[4];
+		a3ui32 first, count;
+	};
+
+	// hierarchy; children always come after their parent, so refitting
+	//	walks nodes backwards; item bounds are copied in leaf order and
+	//	share one allocation with the nodes
+	struct a3_DemoBVH
+	{
+		a3_DemoBVHNode *node;
+		a3f32(*itemMin)[4];
+		a3f32(*itemMax)[4];
+		a3ui32 *item;			// caller's index of each item in leaf order
+		a3ui32 nodeCount, itemCount, capacity;
+		a3f32 cost;				// surface area cost after last build or refit
+		a3f32 costBuilt;		// surface area cost after last build
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// allocate hierarchy for up to capacity items; empty until built
+	a3ret a3demo_bvhCreate(a3_DemoBVH *bvh_out, const a3ui32 capacity);
+
+	// release hierarchy
+	a3ret a3demo_bvhRelease(a3_DemoBVH *bvh);
+
+	// build from item boxes (xyz used), choosing the split with the lowest
+	//	surface area cost at every node; returns number of nodes
+	a3ret a3demo_bvhBuild(a3_DemoBVH *bvh, const a3f32(*boundsMin)[4], const a3f32(*boundsMax)[4], const a3ui32 count);
+
+	// refit to moved item boxes without changing the tree; cost grows as
+	//	items drift from where they were at build time, rebuild when it
+	//	gets too large; returns number of nodes
+	a3ret a3demo_bvhRefit(a3_DemoBVH *bvh, const a3f32(*boundsMin)[4], const a3f32(*boundsMax)[4]);
+
+	// box of a sphere, for items bounded by spheres
+	a3ret a3demo_bvhSphereBounds(a3f32 *boundsMin_out, a3f32 *boundsMax_out, const a3f32 *center, const a3f32 radius);
+
+	// normalized planes of a view-projection frustum, facing inward, in
+	//	order left, right, bottom, top, far, near; pass five to a query
+	//	to keep everything in front of the near plane
+	a3ret a3demo_bvhFrustumPlanes(a3f32(*plane_out)[4], const a3real4x4p viewProjectionMat);
+
+
+	// items whose boxes are not fully outside any plane (xyz normal and
+	//	distance, inside where positive); writes up to itemMax indices
+	//	and returns how many were found
+	a3ret a3demo_bvhQueryFrustum(const a3_DemoBVH *bvh, a3ui32 *item_out, const a3ui32 itemMax, const a3f32(*plane)[4], const a3ui32 planeCount);
+
+	// items whose boxes overlap a sphere; writes up to itemMax indices
+	//	and returns how many were found
+	a3ret a3demo_bvhQuerySphere(const a3_DemoBVH *bvh, a3ui32 *item_out, const a3ui32 itemMax, const a3f32 *center, const a3f32 radius);
+
+	// item whose box the ray enters first within a distance (in units of
+	//	direction); returns item index, -1 if none
+	a3ret a3demo_bvhQueryRay(const a3_DemoBVH *bvh, a3f32 *distance_out_opt, const a3f32 *origin, const a3f32 *direction, const a3f32 distanceMax);
+
+
+	// compare brute-force culling, light assignment and picking against
+	//	queries (console)
+	void a3demo_bvhBenchmark(const a3ui32 itemCount);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOBVH_H
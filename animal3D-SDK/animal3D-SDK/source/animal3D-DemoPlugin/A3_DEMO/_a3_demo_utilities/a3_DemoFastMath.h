@@ -0,0 +1,88 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_DemoFastMath.h
+	Polynomial trig and inverse square root kernels: no lookup table, so 
+		they stay out of the data cache and run several values per 
+		instruction through the batch entry points (8 lanes with AVX2, 4 
+		with SSE2, scalar otherwise). Error bounds below were measured 
+		against double precision over the stated domain.
+*/
+
+#ifndef __ANIMAL3D_DEMOFASTMATH_H
+#define __ANIMAL3D_DEMOFASTMATH_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// single values
+	// sin/cos take radians, |x| <= 8192; max absolute error 9.3e-8 
+	//	(1.6 ulp at magnitude 1)
+	a3f32 a3demo_sinPoly(const a3f32 x);
+	a3f32 a3demo_cosPoly(const a3f32 x);
+	void a3demo_sincosPoly(const a3f32 x, a3f32 *sin_out, a3f32 *cos_out);
+
+	// full-circle arctangent of y/x in radians [-pi, +pi]; max error 3 ulp
+	a3f32 a3demo_atan2Poly(const a3f32 y, const a3f32 x);
+
+	// 1/sqrt(x) for x > 0; max error 4 ulp (hardware estimate plus one 
+	//	Newton step), 9e-6 relative without SSE
+	a3f32 a3demo_invsqrtPoly(const a3f32 x);
+
+
+	// batches: any count, arrays need no alignment; outputs may alias 
+	//	inputs; return count processed or -1 if invalid
+	a3ret a3demo_sincosBatch(a3f32 *sin_out, a3f32 *cos_out, const a3f32 *x, const a3ui32 count);
+	a3ret a3demo_atan2Batch(a3f32 *angle_out, const a3f32 *y, const a3f32 *x, const a3ui32 count);
+	a3ret a3demo_invsqrtBatch(a3f32 *invsqrt_out, const a3f32 *x, const a3ui32 count);
+
+	// number of values each batch step handles in this build
+	a3ui32 a3demo_fastMathWidth();
+
+
+	// compare table, Taylor, C library and polynomial versions for speed 
+	//	and accuracy (console)
+	void a3demo_fastMathBenchmark(const a3ui32 count);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOFASTMATH_H
@@ -0,0 +1,132 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_DemoRandom.h
+	Random number generators with explicit state, so that each thread or 
+		system can own its own sequence instead of sharing the hidden 
+		global seed behind a3random: xoshiro128++ with jump-ahead for 
+		independent streams, PCG32 with arbitrary advance, and a 4-lane 
+		xoshiro128++ that fills arrays with SIMD where available.
+*/
+
+#ifndef __ANIMAL3D_DEMORANDOM_H
+#define __ANIMAL3D_DEMORANDOM_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoRandom				a3_DemoRandom;
+	typedef struct a3_DemoRandomPCG				a3_DemoRandomPCG;
+	typedef struct a3_DemoRandomLanes			a3_DemoRandomLanes;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// xoshiro128++ state; period 2^128 - 1, never all zero
+	struct a3_DemoRandom
+	{
+		a3ui32 s[4];
+	};
+
+	// PCG32 state; inc selects one of 2^63 streams and must be odd
+	struct a3_DemoRandomPCG
+	{
+		a3ui64 state;
+		a3ui64 inc;
+	};
+
+	// four xoshiro128++ generators stored word-major (s[word][lane]) so 
+	//	that one vector holds the same word of every lane; lanes are 2^64 
+	//	steps apart so their sequences never overlap
+	struct a3_DemoRandomLanes
+	{
+		a3ui32 s[4][4];
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// seed generator; any seed is valid, nearby seeds give unrelated sequences
+	a3ret a3demo_randomSeed(a3_DemoRandom *rng, const a3ui64 seed);
+
+	// advance generator by 2^64 steps; copy then jump once per thread to 
+	//	give each its own non-overlapping stream
+	a3ret a3demo_randomJump(a3_DemoRandom *rng);
+
+	// next random integer in [0, 2^32)
+	a3ui32 a3demo_randomNext(a3_DemoRandom *rng);
+
+	// next random real in [0, 1)
+	a3f32 a3demo_randomNormalized(a3_DemoRandom *rng);
+
+	// next random real in [nMin, nMax)
+	a3f32 a3demo_randomRange(a3_DemoRandom *rng, const a3f32 nMin, const a3f32 nMax);
+
+	// next random integer in [nMin, nMax); unbiased enough for ranges far 
+	//	below 2^32 and uses no division
+	a3i32 a3demo_randomRangeInt(a3_DemoRandom *rng, const a3i32 nMin, const a3i32 nMax);
+
+
+	// seed PCG32 generator on one of its streams
+	a3ret a3demo_randomPCGSeed(a3_DemoRandomPCG *rng, const a3ui64 seed, const a3ui64 stream);
+
+	// advance PCG32 generator by any number of steps in logarithmic time
+	a3ret a3demo_randomPCGAdvance(a3_DemoRandomPCG *rng, const a3ui64 delta);
+
+	// next PCG32 random integer in [0, 2^32)
+	a3ui32 a3demo_randomPCGNext(a3_DemoRandomPCG *rng);
+
+
+	// split generator into four lanes; the generator itself is jumped past 
+	//	them so it can keep being used or split again
+	a3ret a3demo_randomLanesCreate(a3_DemoRandomLanes *lanes, a3_DemoRandom *rng);
+
+	// fill array with random reals in [nMin, nMax); returns count
+	a3ret a3demo_randomFillReal(a3_DemoRandomLanes *lanes, a3f32 *values_out, const a3ui32 count, const a3f32 nMin, const a3f32 nMax);
+
+	// fill array with random integers in [nMin, nMax); returns count
+	a3ret a3demo_randomFillInt(a3_DemoRandomLanes *lanes, a3i32 *values_out, const a3ui32 count, const a3i32 nMin, const a3i32 nMax);
+
+
+	// compare throughput of legacy and explicit-state generators (console)
+	void a3demo_randomBenchmark(const a3ui32 count);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMORANDOM_H
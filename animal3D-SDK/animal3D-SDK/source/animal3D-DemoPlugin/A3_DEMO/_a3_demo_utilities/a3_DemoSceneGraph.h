@@ -0,0 +1,118 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoSceneGraph.h
+	Parent/child hierarchy of scene objects stored depth-first: every node
+		comes after its parent and every subtree is one contiguous range,
+		so world transforms propagate in a single forward pass, subtrees
+		whose transforms did not change are skipped and separate trees can
+		be handed to separate workers.
+*/
+
+#ifndef __ANIMAL3D_DEMOSCENEGRAPH_H
+#define __ANIMAL3D_DEMOSCENEGRAPH_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+
+#include "a3_DemoSceneObject.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoSceneGraph			a3_DemoSceneGraph;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// scene graph limits
+	enum
+	{
+		a3demo_sceneGraphThreadMax = 8,
+	};
+
+
+	// hierarchy in depth-first order; nodes are indexed in that order,
+	//	objects are the caller's own indices (e.g. into an array of scene
+	//	objects); all arrays share one allocation
+	struct a3_DemoSceneGraph
+	{
+		a3mat4 *localMat;		// transform relative to parent
+		a3mat4 *worldMat;		// transform relative to scene
+		a3mat4 *worldMatInv;	// scene relative to node
+		a3i32 *parent;			// node index of parent, -1 for roots
+		a3ui32 *subtreeEnd;		// one past the last node of the subtree
+		a3ui32 *object;			// object index of each node
+		a3ui32 *node;			// node index of each object
+		a3ubyte *dirty;			// local transform changed since last update
+		a3ui32 count;
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// create hierarchy from the parent object of each object (-1 for
+	//	roots); siblings keep their object order, locals start as identity
+	//	and every node is dirty; returns number of nodes, -1 if a parent
+	//	is out of range or the parents form a cycle
+	a3ret a3demo_sceneGraphCreate(a3_DemoSceneGraph *graph_out, const a3i32 *parentIndex, const a3ui32 count);
+
+	// release hierarchy
+	a3ret a3demo_sceneGraphRelease(a3_DemoSceneGraph *graph);
+
+	// set local transform of an object; marks it dirty only if the
+	//	transform differs from the current one; returns 1 if dirty
+	a3ret a3demo_sceneGraphSetLocal(a3_DemoSceneGraph *graph, const a3ui32 object, a3real4x4p const localMat);
+
+	// recompute world transforms and inverses of dirty nodes and their
+	//	descendants in one pass; returns number of nodes recomputed
+	a3ret a3demo_sceneGraphUpdate(a3_DemoSceneGraph *graph);
+
+	// same as update, with root trees split between up to threadCount
+	//	workers by node count; one tree is never split
+	a3ret a3demo_sceneGraphUpdateParallel(a3_DemoSceneGraph *graph, const a3ui32 threadCount);
+
+	// copy world transforms and inverses to scene objects, indexed by
+	//	object; returns number of objects
+	a3ret a3demo_sceneGraphApply(const a3_DemoSceneGraph *graph, a3_DemoSceneObject *sceneObject);
+
+
+	// compare per-object parent walks with propagation (console)
+	void a3demo_sceneGraphBenchmark(const a3ui32 nodeCount);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOSCENEGRAPH_H
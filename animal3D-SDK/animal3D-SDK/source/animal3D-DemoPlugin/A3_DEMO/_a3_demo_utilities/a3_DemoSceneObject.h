@@ -46,6 +46,15 @@ extern "C"
 	
 //-----------------------------------------------------------------------------
 
+	// shadow cascade limits
+	//	-> cascades are packed into a square atlas of tiles
+	enum
+	{
+		a3demo_shadowCascadeMax = 4,
+		a3demo_shadowCascadeAtlasTiles = 2,
+	};
+
+
 	// matrix stack for a single object
 	struct a3_DemoModelMatrixStack
 	{
@@ -97,6 +106,12 @@ extern "C"
 		a3real ctrlMoveSpeed;				// how fast controlled camera moves
 		a3real ctrlRotateSpeed;				// control rotate speed (degrees)
 		a3real ctrlZoomSpeed;				// control zoom speed (degrees)
+
+		// directional shadow cascades fit to another projector's view
+		a3mat4 cascadeViewProjectionMat[a3demo_shadowCascadeMax];	// world -> cascade clip
+		a3mat4 cascadeAtlasMat[a3demo_shadowCascadeMax];			// world -> biased cascade tile in atlas
+		a3real cascadeSplit[a3demo_shadowCascadeMax];				// viewer depth at far end of each cascade
+		a3ui32 cascadeCount;										// number of cascades in use
 	};
 
 	// simple point light
@@ -124,6 +139,8 @@ extern "C"
 	inline void a3demo_initProjector(a3_DemoProjector *projector);
 	inline void a3demo_updateProjectorProjectionMat(a3_DemoProjector *projector);
 	inline void a3demo_updateProjectorViewProjectionMat(a3_DemoProjector *projector);
+	inline void a3demo_updateProjectorShadowCascades(a3_DemoProjector *projector, a3_DemoProjector const *viewer, const a3ui32 cascadeCount, const a3real shadowDist, const a3real splitBlend, const a3ui32 tileSize);
+	inline a3boolean a3demo_testProjectorShadowCascade(a3_DemoProjector const *projector, const a3ui32 cascade, a3real3p const center, const a3real radius);
 
 	inline void a3demo_resetModelMatrixStack(a3_DemoModelMatrixStack* model);
 	inline void a3demo_resetViewerMatrixStack(a3_DemoViewerMatrixStack* viewer);
@@ -31,6 +31,8 @@
 
 #include "animal3D-A3DG/a3graphics/a3_ShaderProgram.h"
 
+#include "a3_DemoShaderWatch.h"
+
 
 //-----------------------------------------------------------------------------
 
@@ -40,6 +42,8 @@ extern "C"
 #else	// !__cplusplus
 	typedef struct a3_DemoStateShader			a3_DemoStateShader;
 	typedef struct a3_DemoStateShaderProgram	a3_DemoStateShaderProgram;
+	typedef struct a3_DemoStateShaderSource		a3_DemoStateShaderSource;
+	typedef struct a3_DemoStateShaderProgramSource	a3_DemoStateShaderProgramSource;
 #endif	// __cplusplus
 
 
@@ -57,6 +61,39 @@ extern "C"
 	};
 
 
+	// limits for kept shader sources
+	enum a3_DemoStateShaderSourceMax
+	{
+		a3demo_shaderSourceFileMax = 4,		// source files per kept shader
+		a3demo_shaderSourcePathMax = 128,	// characters per file path
+	};
+
+
+	// compiled shader kept after loading, with the files it came from, so 
+	//	that it can be recompiled alone when one of them (or a file they 
+	//	include) changes; encoded files are not preprocessed
+	struct a3_DemoStateShaderSource
+	{
+		a3_Shader shader[1];
+		a3byte shaderName[32];
+
+		a3_ShaderType shaderType;
+		a3ui32 srcCount;
+		a3byte filePath[a3demo_shaderSourceFileMax][a3demo_shaderSourcePathMax];
+		a3boolean encoded;
+		a3_DemoShaderDepend depend[1];
+	};
+
+
+	// shaders used by a program, as indices into the kept shader list per 
+	//	stage (negative if stage is unused), so that only dependent programs 
+	//	are relinked
+	struct a3_DemoStateShaderProgramSource
+	{
+		a3i8 shaderIndex[a3shader_compute + 1];
+	};
+
+
 	// structure to help with shader program and uniform management
 	struct a3_DemoStateShaderProgram
 	{
@@ -84,7 +121,9 @@ extern "C"
 				uLightSzInvSq,				// light size inverse squared
 				uLightPos,					// light position (in whatever space makes sense)
 				uLightCol,					// light color
-				uColor;						// uniform color (used in whatever context is needed)
+				uColor,						// uniform color (used in whatever context is needed)
+				uShadowCascade,				// view-to-atlas transform per shadow cascade (view -> biased atlas)
+				uShadowSplit;				// view depth at far end of each shadow cascade
 
 			a3i32
 				// common texture handles
@@ -119,6 +158,10 @@ extern "C"
 			a3i32
 				// animation uniform block handles
 				ubCurveWaypoint;	// waypoints for interpolation
+
+			a3i32
+				// instancing uniform block handles
+				ubInstance;			// per-instance records of a batch
 		};
 	};
 
@@ -0,0 +1,159 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_DemoShaderVariant.h
+	Shader permutations: a program is declared once as base source files 
+		plus feature bits, and each combination actually requested is 
+		compiled on demand into a variant cache.
+*/
+
+#ifndef __ANIMAL3D_DEMOSHADERVARIANT_H
+#define __ANIMAL3D_DEMOSHADERVARIANT_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DG/a3graphics/a3_ShaderProgramReflection.h"
+
+#include "a3_DemoShaderProgram.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoShaderVariantBase		a3_DemoShaderVariantBase;
+	typedef struct a3_DemoShaderVariant			a3_DemoShaderVariant;
+	typedef struct a3_DemoShaderVariantCache	a3_DemoShaderVariantCache;
+	typedef enum a3_DemoShaderFeature			a3_DemoShaderFeature;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// permutation features; each becomes a define in every stage: 
+	//	flags are defined as 1 if set, counts are defined if non-zero
+	enum a3_DemoShaderFeature
+	{
+		a3demo_shaderFeatureInstanced = 0x0001,		// A3_INSTANCED
+		a3demo_shaderFeatureShadow = 0x0002,		// A3_SHADOW
+		a3demo_shaderFeatureDualQuat = 0x0004,		// A3_DUAL_QUAT
+		a3demo_shaderFeatureFlagMask = 0x000f,
+
+		a3demo_shaderFeatureMRTShift = 4,			// A3_MRT_COUNT
+		a3demo_shaderFeatureLightShift = 8,			// A3_LIGHT_COUNT
+		a3demo_shaderFeatureCountMask = 0x000f,
+	};
+
+	// build a feature key from flags and counts
+#define a3demo_shaderFeatures(flags, mrtCount, lightCount)	((flags) | ((mrtCount) << a3demo_shaderFeatureMRTShift) | ((lightCount) << a3demo_shaderFeatureLightShift))
+
+
+	// cache limits
+	enum a3_DemoShaderVariantMax
+	{
+		a3demo_shaderVariantMax = 32,
+		a3demo_shaderVariantBaseMax = 8,
+		a3demo_shaderVariantNameMax = 24,
+	};
+
+
+	// program declared as one source file per stage (null if unused)
+	struct a3_DemoShaderVariantBase
+	{
+		a3byte name[a3demo_shaderVariantNameMax];
+		const a3byte *filePath[a3shader_compute + 1];
+	};
+
+	// compiled combination of base and features
+	//	member failed: set if build failed, so it is not retried every 
+	//		request; cleared when one of its files changes
+	struct a3_DemoShaderVariant
+	{
+		a3_DemoStateShaderProgram program[1];
+		a3ui32 baseIndex, features;
+		a3boolean failed;
+		a3_DemoShaderDepend depend[1];
+	};
+
+	// called after a variant links to get uniform locations and defaults 
+	//	from the variant's reflection
+	typedef void(*a3_DemoShaderVariantInitFunc)(a3_DemoStateShaderProgram *program, const a3_ShaderProgramReflection *reflection);
+
+	// variant cache; bases and paths are copied so that the cache stays 
+	//	valid when the demo library is reloaded
+	//	member binaryDirectory: optional directory for program binaries and 
+	//		their uniform reflection; a binary is used instead of compiling 
+	//		if it is newer than every file the variant is built from
+	//	member compileCount, binaryCount: variants compiled from source or 
+	//		loaded as binaries
+	struct a3_DemoShaderVariantCache
+	{
+		a3_DemoShaderVariant variant[a3demo_shaderVariantMax];
+		struct {
+			a3byte name[a3demo_shaderVariantNameMax];
+			a3byte filePath[a3shader_compute + 1][a3shaderSource_pathMax];
+		} base[a3demo_shaderVariantBaseMax];
+		a3byte binaryDirectory[a3shaderSource_pathMax];
+		a3_DemoShaderVariantInitFunc initFunc;
+		a3ui32 baseCount, variantCount;
+		a3ui32 compileCount, binaryCount;
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// create shader from files through the preprocessor with optional 
+	//	defines; files read are added to the optional dependency list
+	//	returns > 0 if compiled (or issued, if deferred), 0 if failed
+	a3ret a3demo_shaderCreatePreprocessed(a3_Shader *shader_out, const a3byte name[32], const a3_ShaderType type, const a3byte **filePathList, const a3ui32 count, const a3byte *defines_opt, a3_DemoShaderDepend *depend_opt, const a3boolean deferred);
+
+	// set up cache for list of bases
+	a3ret a3demo_shaderVariantCacheCreate(a3_DemoShaderVariantCache *cache, const a3_DemoShaderVariantBase *baseList, const a3ui32 baseCount, const a3_DemoShaderVariantInitFunc initFunc, const a3byte *binaryDirectory_opt);
+
+	// get program for base and features, building it if this is the first 
+	//	request; returns null if the build failed
+	const a3_DemoStateShaderProgram *a3demo_shaderVariantRequest(a3_DemoShaderVariantCache *cache, const a3ui32 baseIndex, const a3ui32 features);
+
+	// rebuild variants whose files changed; a rebuilt program replaces the 
+	//	old one only if it links; returns number replaced
+	a3ret a3demo_shaderVariantCacheReload(a3_DemoShaderVariantCache *cache);
+
+	// release all variants
+	a3ret a3demo_shaderVariantCacheRelease(a3_DemoShaderVariantCache *cache);
+
+	// update release callbacks and init function after the demo library 
+	//	is reloaded
+	a3ret a3demo_shaderVariantCacheHandleUpdateReleaseCallbacks(a3_DemoShaderVariantCache *cache, const a3_DemoShaderVariantInitFunc initFunc);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOSHADERVARIANT_H
@@ -0,0 +1,111 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_DemoShaderWatch.h
+	Watch shader source directory for changes so that programs can be 
+		reloaded while the demo runs; track which files each shader was 
+		built from, including preprocessor includes.
+*/
+
+#ifndef __ANIMAL3D_DEMOSHADERWATCH_H
+#define __ANIMAL3D_DEMOSHADERWATCH_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DG/a3graphics/a3_ShaderPreprocessor.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoShaderWatch			a3_DemoShaderWatch;
+	typedef struct a3_DemoShaderDepend			a3_DemoShaderDepend;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// directory watcher; change notifications where the platform has them, 
+	//	timed polling otherwise
+	//	member notify: platform change notification handle; null if polling
+	//	member pollTime: seconds until the next poll
+	//	member settleTime: seconds to wait after a change before reporting, 
+	//		since editors save in several writes; negative if none pending
+	struct a3_DemoShaderWatch
+	{
+		void *notify;
+		a3f64 pollTime;
+		a3f64 settleTime;
+	};
+
+
+	// files a shader was built from with their modification times; 
+	//	includes are listed too so that editing one rebuilds its users
+	//	member count: number of files
+	//	member filePath: file paths
+	//	member fileTime: modification time of each file when last built
+	struct a3_DemoShaderDepend
+	{
+		a3ui32 count;
+		a3byte filePath[a3shaderSource_fileMax][a3shaderSource_pathMax];
+		a3i64 fileTime[a3shaderSource_fileMax];
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// start watching a directory and its subdirectories
+	a3ret a3demo_shaderWatchCreate(a3_DemoShaderWatch *watch, const a3byte *directory);
+
+	// check for changes; returns 1 once per settled burst of changes
+	a3ret a3demo_shaderWatchPoll(a3_DemoShaderWatch *watch, const a3f64 dt);
+
+	// stop watching
+	a3ret a3demo_shaderWatchRelease(a3_DemoShaderWatch *watch);
+
+	// get last modification time of a file; zero if it does not exist
+	a3i64 a3demo_getFileModifiedTime(const a3byte *filePath);
+
+	// add a file to a dependency list, recording its time; returns index
+	a3ret a3demo_shaderDependAddFile(a3_DemoShaderDepend *depend, const a3byte *filePath);
+
+	// add every file read by the preprocessor to a dependency list
+	a3ret a3demo_shaderDependAddSource(a3_DemoShaderDepend *depend, const a3_ShaderSource *source);
+
+	// re-read file times; returns number of files changed since recorded
+	a3ret a3demo_shaderDependUpdate(a3_DemoShaderDepend *depend);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOSHADERWATCH_H
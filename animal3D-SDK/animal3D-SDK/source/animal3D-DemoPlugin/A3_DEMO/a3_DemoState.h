@@ -35,6 +35,21 @@
 
 #include "animal3D/animal3D.h"
 #include "animal3D-A3DG/animal3D-A3DG.h"
+#include "animal3D-A3DG/a3graphics/a3_TextureStream.h"
+#include "animal3D-A3DG/a3graphics/a3_TextureCompressed.h"
+#include "animal3D-A3DG/a3graphics/a3_TextureDecoder.h"
+#include "animal3D-A3DG/a3graphics/a3_TextureAtlasPacker.h"
+#include "animal3D-A3DG/a3graphics/a3_FramebufferMixed.h"
+#include "animal3D-A3DG/a3graphics/a3_FramebufferPool.h"
+#include "animal3D-A3DG/a3graphics/a3_ShaderProgramParallel.h"
+#include "animal3D-A3DG/a3graphics/a3_ShaderProgramReflection.h"
+#include "animal3D-A3DG/a3graphics/a3_ParticleSystem.h"
+#include "animal3D-A3DG/a3graphics/a3_MorphTargets.h"
+#include "animal3D-A3DG/a3graphics/a3_Skinning.h"
+#include "animal3D-A3DG/a3graphics/a3_OcclusionCulling.h"
+#include "animal3D-A3DG/a3graphics/a3_InstanceBatch.h"
+#include "animal3D-A3DG/a3graphics/a3_CurveTessellation.h"
+#include "animal3D-A3DG/a3graphics/a3_CurvePath.h"
 
 
 //-----------------------------------------------------------------------------
@@ -42,6 +57,12 @@
 
 #include "_a3_demo_utilities/a3_DemoSceneObject.h"
 #include "_a3_demo_utilities/a3_DemoShaderProgram.h"
+#include "_a3_demo_utilities/a3_DemoShaderWatch.h"
+#include "_a3_demo_utilities/a3_DemoShaderVariant.h"
+#include "_a3_demo_utilities/a3_DemoRandom.h"
+#include "_a3_demo_utilities/a3_DemoAnimation.h"
+#include "_a3_demo_utilities/a3_DemoSceneGraph.h"
+#include "_a3_demo_utilities/a3_DemoBVH.h"
 
 #include "a3_Demo_Shading.h"
 #include "a3_Demo_Pipelines.h"
@@ -57,6 +78,7 @@ extern "C"
 	typedef struct a3_DemoState					a3_DemoState;
 	typedef enum a3_DemoState_ModeName			a3_DemoState_ModeName;
 	typedef enum a3_DemoState_TextDisplayName	a3_DemoState_TextDisplayName;
+	typedef enum a3_DemoState_ShaderVariantName	a3_DemoState_ShaderVariantName;
 #endif	// __cplusplus
 
 
@@ -85,6 +107,18 @@ extern "C"
 	};
 
 
+	// shader variant base names; variants are requested with feature bits
+	enum a3_DemoState_ShaderVariantName
+	{
+		demoStateShaderVariant_drawPhong_multi,	// forward Phong, optional shadow atlas and MRT
+		demoStateShaderVariant_drawPhong_skin,	// forward Phong on skinned instances, optional dual quaternions
+		demoStateShaderVariant_transform,		// position only, optional instance records
+		demoStateShaderVariant_drawGBuffer_packed,	// packed g-buffer, optional instance records
+
+		demoStateShaderVariant_max
+	};
+
+
 	// object maximum counts for easy array storage
 	// good idea to make these numbers greater than what you actually need 
 	//	and if you end up needing more just increase the count... there's 
@@ -102,21 +136,40 @@ extern "C"
 		demoStateMaxCount_lightVolumePerBlock = a3index_countMaxShort / sizeof(a3_DemoPointLight),
 		demoStateMaxCount_lightVolume = demoStateMaxCount_lightVolumeBlock * demoStateMaxCount_lightVolumePerBlock,
 		demoStateMaxCount_lightUniformBuffer = demoStateMaxCount_lightUniformBufferType * demoStateMaxCount_lightVolumeBlock,
+		demoStateMaxCount_sceneObjectLight = 64,
 		demoStateMaxCount_transformUniformBuffer = 4,
 		demoStateMaxCount_miscUniformBuffer = 4,
 
 		demoStateMaxCount_timer = 1,
 
-		demoStateMaxCount_drawDataBuffer = 1,
+		demoStateMaxCount_drawDataBuffer = 3,
 		demoStateMaxCount_vertexArray = 8,
 		demoStateMaxCount_drawable = 16,
 
-		demoStateMaxCount_shaderProgram = 32,
+		demoStateMaxCount_shader = 56,
+		demoStateMaxCount_shaderProgram = 48,
 		demoStateMaxCount_uniformBuffer = demoStateMaxCount_lightUniformBuffer + demoStateMaxCount_transformUniformBuffer + demoStateMaxCount_miscUniformBuffer,
 
 		demoStateMaxCount_texture = 16,
+		demoStateMaxCount_textureStreamBudget = 4 * 1024 * 1024,	// bytes uploaded per frame
+
+		demoStateMaxCount_framebuffer = 4,
+		demoStateMaxCount_framebufferPoolIdle = 120,	// frames before unused pooled targets are freed
+
+		demoStateMaxCount_particle = 64 * 1024,
+		demoStateMaxCount_particleBenchmark = 1024 * 1024,
 
-		demoStateMaxCount_framebuffer = 16,
+		demoStateMaxCount_morphInstance = 8,
+
+		demoStateMaxCount_skinJoint = 8,
+		demoStateMaxCount_skinCharacter = 16,
+		demoStateMaxCount_skinCharacterBenchmark = 4096,
+
+		demoStateMaxCount_occlusionBenchmark = 64 * 1024,
+
+		demoStateMaxCount_instanceBuffer = 64 * 1024,	// bytes of records per pass
+		demoStateMaxCount_instanceAlignment = 256,		// largest record offset alignment batched
+		demoStateMaxCount_instanceBenchmark = 4096,
 	};
 
 	
@@ -138,6 +191,7 @@ extern "C"
 		const a3_DemoSceneObject* obj;
 		const a3_VertexDrawable* mesh;
 		const a4_Material* texture;
+		a3real radius;	// bounding sphere radius before scale, for culling
 	} a4_SceneModel;
 
 	struct a3_DemoState
@@ -215,6 +269,12 @@ extern "C"
 
 		a3mat4 deferredLightMVP[demoStateMaxCount_lightVolume], deferredLightMVPB[demoStateMaxCount_lightVolume];
 
+		// deferred light volumes as boxes, lights the camera can see and 
+		//	lights touching each scene object (up to a limit, count is total)
+		a3f32 deferredLightBoundsMin[demoStateMaxCount_lightVolume][4], deferredLightBoundsMax[demoStateMaxCount_lightVolume][4];
+		a3ui32 deferredLightVisible[demoStateMaxCount_lightVolume], deferredLightVisibleCount;
+		a3ui32 sceneObjectLight[demoStateMaxCount_sceneObject][demoStateMaxCount_sceneObjectLight], sceneObjectLightCount[demoStateMaxCount_sceneObject];
+
 
 
 
@@ -225,6 +285,28 @@ extern "C"
 		a3vec4 curveWaypoint[demoStateMaxCount_waypoint];
 		a3vec4 curveHandle[demoStateMaxCount_waypoint];
 
+		// arc-length tables for the waypoint curve, rebuilt when the 
+		//	interpolation mode changes, and distance travelled along it
+		a3_CurvePath curvePath[1];
+		a3real curveDistance;
+
+		// keyframe clips for the display objects (spin and bob), the blend 
+		//	tree that layers them and the pose it produces each update
+		a3_DemoAnimationClip animationClip[2];
+		a3_DemoAnimationBlendTree animationTree[1];
+		a3_DemoAnimationPose animationPose[1];
+
+		// hierarchy of scene objects; transforms computed by the update 
+		//	are local to the parent and become world transforms here
+		a3_DemoSceneGraph sceneGraph[1];
+
+		// spatial indices over scene object bounding spheres (refit every 
+		//	update, rebuilt once that has degraded it) and over the active 
+		//	deferred light volumes (rebuilt when the count changes)
+		a3_DemoBVH sceneBVH[1], lightBVH[1];
+		a3real sceneObjectRadius[demoStateMaxCount_sceneObject];
+		a3f32 sceneObjectSphere[demoStateMaxCount_sceneObject][4];	// world center and radius
+
 
 		//---------------------------------------------------------------------
 		// object arrays: organized as anonymous unions for two reasons: 
@@ -294,7 +376,9 @@ extern "C"
 			a3_VertexBuffer drawDataBuffer[demoStateMaxCount_drawDataBuffer];
 			struct {
 				a3_VertexBuffer
-					vbo_staticSceneObjectDrawBuffer[1];			// buffer to hold all data for static scene objects (e.g. grid)
+					vbo_staticSceneObjectDrawBuffer[1],			// buffer to hold all data for static scene objects (e.g. grid)
+					vbo_morphTeapotDrawBuffer[1],				// buffer for morph target base mesh (own indices)
+					vbo_skinTentacleDrawBuffer[1];				// buffer for skinned tentacle (own format and indices)
 			};
 		};
 
@@ -307,7 +391,9 @@ extern "C"
 					vao_position_texcoord_normal[1],			// VAO for vertex format with position, texture coordinates and normal
 					vao_position_texcoord[1],					// VAO for vertex format with position and texture coordinates
 					vao_position_color[1],						// VAO for vertex format with position and color
-					vao_position[1];							// VAO for vertex format with only position
+					vao_position[1],							// VAO for vertex format with only position
+					vao_tangentbasis_morph[1],					// VAO for morph target base mesh (full tangent basis)
+					vao_tangentbasis_skin[1];					// VAO for full tangent basis with packed joint indices and weights
 			};
 		};
 
@@ -329,6 +415,9 @@ extern "C"
 					draw_cylinder[1],							// procedural cylinder
 					draw_torus[1],								// procedural torus
 					draw_teapot[1];								// can't not have a Utah teapot
+				a3_VertexDrawable
+					draw_teapot_morph[1],						// teapot morph base mesh, instanced with blended targets
+					draw_tentacle_skin[1];						// skinned tentacle, instanced per character
 			};
 		};
 
@@ -364,18 +453,46 @@ extern "C"
 					prog_drawTexture_brightPass[1],				// draw texture with bright-pass or tone-mapping
 					prog_drawTexture_blurGaussian[1],			// draw texture with Gaussian blurring
 					prog_drawTexture_blendScreen4[1];			// draw texture with 4-layer screen blend
+				a3_DemoStateShaderProgram
+					prog_postBloomDownsample_compute[1],		// bright pass and downsample pyramid (compute)
+					prog_postBloomBlur_compute[1],				// separable Gaussian blur in shared memory (compute)
+					prog_postBloomComposite_compute[1];			// upsample and screen blend bloom levels (compute)
+				a3_DemoStateShaderProgram
+					prog_particleSimulate_compute[1],			// integrate and compact live particles (compute)
+					prog_particleEmit_compute[1],				// append new particles (compute)
+					prog_particleFinalize_compute[1],			// write particle dispatch and draw counts (compute)
+					prog_drawParticle_instanced[1];				// draw particle billboards from storage buffer
+				a3_DemoStateShaderProgram
+					prog_drawPhong_morph_instanced[1];			// draw Phong shading model on blended morph targets
+				a3_DemoStateShaderProgram
+					prog_hizReduce_compute[1],					// build one level of the depth pyramid (compute)
+					prog_occlusionTest_compute[1];				// test object boxes against the depth pyramid (compute)
 				a3_DemoStateShaderProgram
 					prog_drawLightingData[1],					// draw attributes passed from vertex shader (g-buffers)
 					prog_drawPhong_multi_deferred[1],			// draw Phong shading model, multiple lights, in deferred pass
 					prog_drawPhongVolume_instanced[1],			// draw Phong light volume (point light)
 					prog_drawPhongComposite[1];					// draw Phong shading model by compositing light volumes
+				a3_DemoStateShaderProgram
+					prog_drawGBuffer_packed[1],					// draw packed g-buffers (albedo/specular, octahedral normal)
+					prog_drawPhong_multi_deferred_packed[1];	// draw Phong shading model from packed g-buffers and depth
 				a3_DemoStateShaderProgram
 					prog_drawCurveSegment[1],					// draw curve segment using interpolation
+					prog_drawCurveSegment_tessellated[1],		// draw curve segment with adaptive tessellation
 					prog_drawPhong_multi_forward_mrt[1],		// draw Phong with forward point lights and MRT
 					prog_drawOverlays_tangents_wireframe[1];	// draw tangent bases using geometry shader
 			};
 		};
 
+		// compiled shaders kept for incremental reloading, the shaders each 
+		//	program uses, and the watcher that triggers reloading
+		a3_DemoStateShaderSource shaderSource[demoStateMaxCount_shader];
+		a3_DemoStateShaderProgramSource shaderProgramSource[demoStateMaxCount_shaderProgram];
+		a3ui32 shaderSourceCount;
+		a3_DemoShaderWatch shaderWatch[1];
+
+		// programs built on first use from a base and feature bits
+		a3_DemoShaderVariantCache shaderVariantCache[1];
+
 
 		// textures
 		union {
@@ -397,6 +514,9 @@ extern "C"
 			};
 		};
 
+		// background texture loader
+		a3_TextureStream textureStream[1];
+
 		// texture atlas transforms
 		union {
 			a3mat4 atlasTransform[4];
@@ -411,14 +531,11 @@ extern "C"
 			a3_Framebuffer framebuffer[demoStateMaxCount_framebuffer];
 			struct {
 				a3_Framebuffer
-					fbo_scene_c16d24s8_mrt[1];					// framebuffer for capturing scene
+					fbo_scene_c16d24s8_mrt[1],					// framebuffer for capturing scene
+					fbo_scene_gbuffer_packed[1];				// framebuffer for capturing packed g-buffers
 				a3_Framebuffer
-					fbo_shadow_d32[1];							// framebuffer for capturing shadow map
-				a3_Framebuffer
-					fbo_post_c16_2fr[3],						// framebuffers for post-processing, half frame size
-					fbo_post_c16_4fr[3],						// framebuffers for post-processing, quarter frame size
-					fbo_post_c16_8fr[3],						// framebuffers for post-processing, eighth frame size
-					fbo_composite_c16[3];						// framebuffers for composition
+					fbo_shadow_d32[1],							// framebuffer for capturing shadow map
+					fbo_shadowCascade_d32[1];					// framebuffer for capturing shadow cascade atlas
 			};
 		};
 
@@ -447,6 +564,46 @@ extern "C"
 		};
 
 
+		// pool of per-frame composite and post-processing targets
+		a3_FramebufferPool framebufferPool[1];
+
+		// GPU particles drawn in the forward scene pass, and their emitter
+		a3_ParticleSystem particleSystem[1];
+		a3_ParticleEmitter particleEmitter[1];
+
+		// dynamic lines for curves tessellated on the CPU; its vertex array 
+		//	also carries the patches drawn for hardware tessellation
+		a3_CurveTessellation curveTessellation[1];
+
+		// teapot morph targets: sparse deltas kept for the CPU blend, their 
+		//	GPU copy and the per-instance weights of the forward pass
+		a3_MorphTargetData morphTargetData[1];
+		a3_MorphTargets morphTargets[1];
+		a3f32 morphWeight[demoStateMaxCount_morphInstance * a3morph_targetMax];
+
+		// skinned tentacles: one skeleton shared by every character, the 
+		//	palettes solved this frame and where they were written in the 
+		//	ring, and a CPU copy of the bind mesh for the reference skinning
+		a3_Skeleton skeleton[1];
+		a3_SkinPaletteRing skinPaletteRing[1];
+		a3f32 skinPalette[demoStateMaxCount_skinCharacter * demoStateMaxCount_skinJoint * a3skin_linear][4];
+		a3i32 skinPaletteOffset;
+		a3ui32 skinPaletteSize;
+		a3f32(*skinPosition)[3], (*skinNormal)[3];
+		a3ubyte(*skinIndex)[4];
+		a3ui16(*skinWeight)[4];
+		a3ui32 skinVertexCount;
+
+		// occlusion culling: depth pyramid built after the scene pass, and 
+		//	the latest finished test of scene object bounds against it
+		a3_OcclusionCuller occlusionCuller[1];
+		a3boolean sceneObjectUnoccluded[demoStateMaxCount_sceneObject];
+
+		// instance batching: records of the pass being drawn, replaced by 
+		//	every pass that draws scene models in groups
+		a3_InstanceBuffer instanceBuffer[1];
+
+
 		// managed objects, no touchie
 		a3_VertexDrawable dummyDrawable[1];
 
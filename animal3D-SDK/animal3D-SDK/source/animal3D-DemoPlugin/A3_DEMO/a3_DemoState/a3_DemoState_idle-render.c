@@ -97,6 +97,10 @@ void a3demo_render_controls(a3_DemoState const* demoState,
 		"Toggle text display:        't' (toggle) | 'T' (alloc/dealloc) ");
 	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"Reload all shader programs: 'P' ****CHECK CONSOLE FOR ERRORS!**** ");
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"Bake scene atlases:         '0' (used on next load) ");
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"Compare texture decoders:   'Y' (console output) ");
 }
 
 
@@ -137,6 +141,10 @@ void a3demo_render_controls_gen(a3_DemoState const* demoState,
 		"Toggle text display:        't' (toggle) | 'T' (alloc/dealloc) ");
 	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"Reload all shader programs: 'P' ****CHECK CONSOLE FOR ERRORS!**** ");
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"Bake scene atlases:         '0' (used on next load) ");
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"Compare texture decoders:   'Y' (console output) ");
 
 	// input-dependent controls
 	textOffset = -0.6f;
@@ -164,6 +172,22 @@ void a3demo_render_data(const a3_DemoState* demoState,
 	// text color
 	const a3vec4 col = { a3real_half, a3real_zero, a3real_half, a3real_one };
 
+	// transient target storage: pooled vs. one target per pass
+	const a3f64 mebibyte = 1.0 / (1024.0 * 1024.0);
+	const a3f64 transientAllocated = (a3f64)demoState->framebufferPool->sizeAllocated * mebibyte;
+	a3f64 transientRequested = 0.0;
+	switch (demoState->demoMode)
+	{
+	case demoState_shading:
+		break;
+	case demoState_pipelines:
+		transientRequested = (a3f64)demoState->demoMode_pipelines->transientSize * mebibyte;
+		break;
+	case demoState_curves:
+		transientRequested = (a3f64)demoState->demoMode_curves->transientSize * mebibyte;
+		break;
+	}
+
 	// display some general data
 	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"t_render = %+.4lf ", demoState->renderTimer->totalTime);
@@ -173,6 +197,8 @@ void a3demo_render_data(const a3_DemoState* demoState,
 		"fps_actual = %.4lf ", __a3recipF64(demoState->renderTimer->previousTick));
 	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"fps_target = %.4lf ", (a3f64)demoState->renderTimer->ticks / demoState->renderTimer->totalTime);
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"fbo_pool = %.2lf MiB (%u targets) | unaliased = %.2lf MiB | saved = %+.2lf MiB ", transientAllocated, demoState->framebufferPool->count, transientRequested, transientRequested - transientAllocated);
 
 	// global controls
 	textOffset = -0.8f;
@@ -180,6 +206,10 @@ void a3demo_render_data(const a3_DemoState* demoState,
 		"Toggle text display:        't' (toggle) | 'T' (alloc/dealloc) ");
 	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"Reload all shader programs: 'P' ****CHECK CONSOLE FOR ERRORS!**** ");
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"Bake scene atlases:         '0' (used on next load) ");
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"Compare texture decoders:   'Y' (console output) ");
 }
 
 
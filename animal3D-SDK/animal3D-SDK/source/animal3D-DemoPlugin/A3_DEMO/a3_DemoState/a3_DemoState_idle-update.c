@@ -68,8 +68,6 @@ void a3demo_update_scene(a3_DemoState *demoState, a3f64 dt)
 {
 	a3ui32 i;
 
-	const a3f32 dr = demoState->updateAnimation ? (a3f32)dt * 15.0f : 0.0f;
-
 	const a3i32 useVerticalY = demoState->verticalAxis;
 
 	// model transformations (if needed)
@@ -108,36 +106,21 @@ void a3demo_update_scene(a3_DemoState *demoState, a3f64 dt)
 	// active camera
 	a3_DemoProjector *activeCamera = demoState->projector + demoState->activeCamera;
 	a3_DemoSceneObject *activeCameraObject = activeCamera->sceneObject;
-	a3_DemoSceneObject *currentSceneObject;
 
 	// light pointers
 	a3_DemoPointLight* pointLight;
 
-
-	// do simple animation
-	if (useVerticalY)
-	{
-		for (i = 0, currentSceneObject = demoState->sphereObject;
-			i < 4; ++i, ++currentSceneObject)
-		{
-			currentSceneObject->euler.y += dr;
-			currentSceneObject->euler.y = a3trigValid_sind(currentSceneObject->euler.y);
-		}
-	}
-	else
-	{
-		for (i = 0, currentSceneObject = demoState->sphereObject;
-			i < 4; ++i, ++currentSceneObject)
-		{
-			currentSceneObject->euler.z += dr;
-			currentSceneObject->euler.z = a3trigValid_sind(currentSceneObject->euler.z);
-		}
-	}
+	// scene object bounds
+	a3f32 boundsMin[demoStateMaxCount_sceneObject][4], boundsMax[demoStateMaxCount_sceneObject][4];
 
 
 	// update scene objects
 	for (i = 0; i < demoStateMaxCount_sceneObject; ++i)
 		a3demo_updateSceneObject(demoState->sceneObject + i, 0);
+
+	// animate display objects; their transforms come from the blend tree
+	a3demo_animationBlendTreeEvaluate(demoState->animationTree, demoState->animationPose, demoState->updateAnimation ? dt : 0.0);
+	a3demo_animationPoseApply(demoState->sphereObject, demoState->animationPose, demoState->animationPose->count);
 	for (i = 0; i < demoStateMaxCount_cameraObject; ++i)
 		a3demo_updateSceneObject(demoState->cameraObject + i, 1);
 	for (i = 0; i < demoStateMaxCount_lightObject; ++i)
@@ -204,6 +187,33 @@ void a3demo_update_scene(a3_DemoState *demoState, a3f64 dt)
 	a3demo_applyScale_internal(demoState->cylinderObject, scaleMat.m);
 	a3demo_applyScale_internal(demoState->torusObject, scaleMat.m);
 	a3demo_applyScale_internal(demoState->teapotObject, scaleMat.m);
+
+
+	// propagate through the hierarchy; objects whose transforms did not 
+	//	change, and none of whose parents did, keep last update's result
+	for (i = 0; i < demoStateMaxCount_sceneObject; ++i)
+		a3demo_sceneGraphSetLocal(demoState->sceneGraph, i, demoState->sceneObject[i].modelMat.m);
+	a3demo_sceneGraphUpdate(demoState->sceneGraph);
+	a3demo_sceneGraphApply(demoState->sceneGraph, demoState->sceneObject);
+
+	// bounds follow the objects, scaled by their largest axis; the 
+	//	hierarchy is refit to them and only rebuilt once objects have 
+	//	drifted far enough from where it was built to double its cost
+	for (i = 0; i < demoStateMaxCount_sceneObject; ++i)
+	{
+		const a3mat4* m = &demoState->sceneObject[i].modelMat;
+		a3real r = a3maximum(a3real3Length(m->m[0]), a3real3Length(m->m[1]));
+		r = a3maximum(r, a3real3Length(m->m[2])) * demoState->sceneObjectRadius[i];
+		demoState->sceneObjectSphere[i][0] = (a3f32)m->m30;
+		demoState->sceneObjectSphere[i][1] = (a3f32)m->m31;
+		demoState->sceneObjectSphere[i][2] = (a3f32)m->m32;
+		demoState->sceneObjectSphere[i][3] = (a3f32)r;
+		a3demo_bvhSphereBounds(boundsMin[i], boundsMax[i], demoState->sceneObjectSphere[i], demoState->sceneObjectSphere[i][3]);
+	}
+	if (!demoState->sceneBVH->nodeCount || demoState->sceneBVH->cost > demoState->sceneBVH->costBuilt * 2.0f)
+		a3demo_bvhBuild(demoState->sceneBVH, (const a3f32(*)[4])boundsMin, (const a3f32(*)[4])boundsMax, demoStateMaxCount_sceneObject);
+	else
+		a3demo_bvhRefit(demoState->sceneBVH, (const a3f32(*)[4])boundsMin, (const a3f32(*)[4])boundsMax);
 }
 
 
@@ -212,12 +222,44 @@ void a3demo_update_scene(a3_DemoState *demoState, a3f64 dt)
 
 void a3pipelines_update(a3_DemoState* demoState, a3_Demo_Pipelines* demoMode, a3f64 dt);
 void a3curves_update(a3_DemoState* demoState, a3_Demo_Curves* demoMode, a3f64 dt);
+void a3pipelines_updateFramebuffers(a3_DemoState* demoState, a3_Demo_Pipelines* demoMode);
+void a3curves_updateFramebuffers(a3_DemoState* demoState, a3_Demo_Curves* demoMode);
+a3ui32 a3demo_reloadShadersChanged(a3_DemoState* demoState);
 
 void a3demo_update(a3_DemoState *demoState, a3f64 dt)
 {
+	// reload shaders once edits to their files have settled
+	if (a3demo_shaderWatchPoll(demoState->shaderWatch, dt) > 0)
+		a3demo_reloadShadersChanged(demoState);
+
+	// continue streaming textures
+	a3textureStreamUpdate(demoState->textureStream, demoStateMaxCount_textureStreamBudget);
+
 	// update scene
 	a3demo_update_scene(demoState, dt);
 
+	// acquire transient targets for every mode that post-processes, since 
+	//	input may switch modes before rendering; inactive modes go first 
+	//	and hand theirs back, so the active mode aliases all of them
+	a3framebufferPoolBeginFrame(demoState->framebufferPool);
+	if (demoState->demoMode != demoState_pipelines)
+		a3pipelines_updateFramebuffers(demoState, demoState->demoMode_pipelines);
+	if (demoState->demoMode != demoState_curves)
+		a3curves_updateFramebuffers(demoState, demoState->demoMode_curves);
+	a3framebufferPoolReturnAll(demoState->framebufferPool);
+	switch (demoState->demoMode)
+	{
+	case demoState_shading:
+		break;
+	case demoState_pipelines:
+		a3pipelines_updateFramebuffers(demoState, demoState->demoMode_pipelines);
+		break;
+	case demoState_curves:
+		a3curves_updateFramebuffers(demoState, demoState->demoMode_curves);
+		break;
+	}
+	a3framebufferPoolTrim(demoState->framebufferPool, demoStateMaxCount_framebufferPoolIdle);
+
 	// update for specific mode
 	switch (demoState->demoMode)
 	{
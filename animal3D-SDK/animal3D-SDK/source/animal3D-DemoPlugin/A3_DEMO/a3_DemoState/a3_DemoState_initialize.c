@@ -49,12 +49,89 @@ void a3curves_init(a3_DemoState const* demoState, a3_Demo_Curves* demoMode);
 //-----------------------------------------------------------------------------
 // INITIALIZE
 
+// animation clips for the display objects: load them if streaming, 
+//	otherwise sample the motion densely and compress it
+void a3demo_initSceneAnimation(a3_DemoState *demoState)
+{
+	// file streaming (if requested); clips depend on the vertical axis
+	a3_FileStream fileStream[1] = { 0 };
+	const a3byte *const animationStream = demoState->verticalAxis
+		? "./data/anim_data_gpro_coursebase_y.dat" : "./data/anim_data_gpro_coursebase_z.dat";
+
+	// spin: one turn every 24 seconds, same as the old euler update
+	// bob: rise and tilt every 2 seconds, each object a quarter out of phase
+	const a3ui32 targetCount = 4, spinFrameCount = 721, bobFrameCount = 61;
+	const a3f32 frameRate = 30.0f;
+	const a3ui32 up = demoState->verticalAxis ? 1 : 2;
+	const a3ui32 side = demoState->verticalAxis ? 2 : 1;
+	const a3_DemoSceneObject *sceneObject = demoState->sphereObject;
+	a3_DemoAnimationPose source[1] = { 0 };
+	a3f32 angle;
+	a3ui32 f, i, n;
+
+	if (demoState->streaming && a3fileStreamOpenRead(fileStream, animationStream))
+	{
+		a3fileStreamReadObject(fileStream, demoState->animationClip + 0, (a3_FileStreamReadFunc)a3demo_animationClipLoadBinary);
+		a3fileStreamReadObject(fileStream, demoState->animationClip + 1, (a3_FileStreamReadFunc)a3demo_animationClipLoadBinary);
+		a3fileStreamClose(fileStream);
+	}
+	else
+	{
+		a3demo_animationPoseCreate(source, targetCount * spinFrameCount);
+		for (f = n = 0; f < spinFrameCount; ++f)
+		{
+			angle = a3real_pi * (a3f32)f / (a3f32)(spinFrameCount - 1);
+			for (i = 0; i < targetCount; ++i, ++n)
+			{
+				a3real3SetReal3(source->position[n], sceneObject[i].position.v);
+				source->rotation[n][up] = a3sinr(angle);
+				source->rotation[n][3] = a3cosr(angle);
+			}
+		}
+		a3demo_animationClipCreate(demoState->animationClip + 0, source, spinFrameCount, frameRate, 0.001f, 0.001f, 0.001f);
+		a3demo_animationPoseRelease(source);
+
+		a3demo_animationPoseCreate(source, targetCount * bobFrameCount);
+		for (f = n = 0; f < bobFrameCount; ++f)
+		{
+			for (i = 0; i < targetCount; ++i, ++n)
+			{
+				angle = a3real_twopi * ((a3f32)f / (a3f32)(bobFrameCount - 1) + (a3f32)i * 0.25f);
+				source->position[n][up] = 0.25f * a3sinr(angle);
+				source->rotation[n][side] = a3sinr(a3real_pi * 0.025f * a3cosr(angle));
+				source->rotation[n][3] = a3cosr(a3real_pi * 0.025f * a3cosr(angle));
+			}
+		}
+		a3demo_animationClipCreate(demoState->animationClip + 1, source, bobFrameCount, frameRate, 0.001f, 0.001f, 0.001f);
+		a3demo_animationPoseRelease(source);
+
+		if (demoState->streaming && a3fileStreamOpenWrite(fileStream, animationStream))
+		{
+			a3fileStreamWriteObject(fileStream, demoState->animationClip + 0, (a3_FileStreamWriteFunc)a3demo_animationClipSaveBinary);
+			a3fileStreamWriteObject(fileStream, demoState->animationClip + 1, (a3_FileStreamWriteFunc)a3demo_animationClipSaveBinary);
+			a3fileStreamClose(fileStream);
+		}
+	}
+
+	// layer bob on top of spin
+	a3demo_animationBlendTreeCreate(demoState->animationTree, targetCount);
+	a3demo_animationBlendTreeAddClip(demoState->animationTree, demoState->animationClip + 0, a3real_one);
+	a3demo_animationBlendTreeAddClip(demoState->animationTree, demoState->animationClip + 1, a3real_one);
+	a3demo_animationBlendTreeAddBlend(demoState->animationTree, a3demo_animationNode_add, 0, 1, a3real_one);
+	a3demo_animationPoseCreate(demoState->animationPose, targetCount);
+}
+
 // initialize non-asset objects
 void a3demo_initScene(a3_DemoState *demoState)
 {
 	a3ui32 i;
 	a3_DemoProjector* projector;
 	a3_DemoPointLight* pointLight;
+	a3_DemoRandom rng[1];
+	a3_DemoRandomLanes lanes[1];
+	a3f32 batch[8];
+	a3_ParticleEmitter* particleEmitter;
+	a3i32 sceneObjectParent[demoStateMaxCount_sceneObject];
 
 	// camera's starting orientation depends on "vertical" axis
 	// we want the exact same view in either case
@@ -185,36 +262,78 @@ void a3demo_initScene(a3_DemoState *demoState)
 		pointLight->radiusInv = a3recip(pointLight->radius);
 	}
 
-	// deferred lights
+	// deferred lights: thousands of them, so they come from their own 
+	//	generator in batches instead of the shared global sequence
+	a3demo_randomSeed(rng, 2048);
+	a3demo_randomLanesCreate(lanes, rng);
 	for (i = 0, pointLight = demoState->deferredPointLight + i;
 		i < demoStateMaxCount_lightVolume;
 		++i, ++pointLight)
 	{
+		// 7 values per light (position, color, radius), padded to full lanes
+		a3demo_randomFillReal(lanes, batch, 8, 0.0f, 1.0f);
+
 		// set to zero vector
 		pointLight->worldPos = a3vec4_w;
 
 		// random positions
-		pointLight->worldPos.x = a3randomRange(-6.0f, +6.0f);
+		pointLight->worldPos.x = a3lerp(-6.0f, +6.0f, batch[0]);
 		if (demoState->verticalAxis)
 		{
-			pointLight->worldPos.z = -a3randomRange(-6.0f, +6.0f);
-			pointLight->worldPos.y = -a3randomRange(-2.0f, +4.0f);
+			pointLight->worldPos.z = -a3lerp(-6.0f, +6.0f, batch[1]);
+			pointLight->worldPos.y = -a3lerp(-2.0f, +4.0f, batch[2]);
 		}
 		else
 		{
-			pointLight->worldPos.y = a3randomRange(-6.0f, +6.0f);
-			pointLight->worldPos.z = a3randomRange(-2.0f, +4.0f);
+			pointLight->worldPos.y = a3lerp(-6.0f, +6.0f, batch[1]);
+			pointLight->worldPos.z = a3lerp(-2.0f, +4.0f, batch[2]);
 		}
 
 		// random colors
-		pointLight->color.r = a3randomNormalized();
-		pointLight->color.g = a3randomNormalized();
-		pointLight->color.b = a3randomNormalized();
+		pointLight->color.r = batch[3];
+		pointLight->color.g = batch[4];
+		pointLight->color.b = batch[5];
 		pointLight->color.a = a3real_one;
 
 		// random radius: they should be small!
-		pointLight->radius = a3randomRange(0.25f, 0.50f);
+		pointLight->radius = a3lerp(0.25f, 0.50f, batch[6]);
 		pointLight->radiusInvSq = a3recip(pointLight->radius * pointLight->radius);
+
+		// lights do not move, so neither do their volumes
+		batch[0] = (a3f32)pointLight->worldPos.x;
+		batch[1] = (a3f32)pointLight->worldPos.y;
+		batch[2] = (a3f32)pointLight->worldPos.z;
+		a3demo_bvhSphereBounds(demoState->deferredLightBoundsMin[i], demoState->deferredLightBoundsMax[i], batch, (a3f32)pointLight->radius);
+	}
+	a3demo_bvhCreate(demoState->lightBVH, demoStateMaxCount_lightVolume);
+
+
+	// particle fountain between the objects: shoots up and falls back 
+	//	down; about rate * life particles are alive at once
+	particleEmitter = demoState->particleEmitter;
+	particleEmitter->position[3] = 0.25f;
+	particleEmitter->velocity[3] = 1.5f;
+	particleEmitter->color[0] = 1.0f;
+	particleEmitter->color[1] = 0.5f;
+	particleEmitter->color[2] = 0.125f;
+	particleEmitter->color[3] = 1.0f;
+	particleEmitter->life[0] = 2.5f;
+	particleEmitter->life[1] = 0.5f;
+	particleEmitter->life[2] = 0.05f;
+	particleEmitter->gravity[3] = 0.25f;
+	particleEmitter->rate = 16000.0f;
+	particleEmitter->seed = 2048;
+	if (demoState->verticalAxis)
+	{
+		particleEmitter->position[1] = -1.0f;
+		particleEmitter->velocity[1] = +7.0f;
+		particleEmitter->gravity[1] = -9.8f;
+	}
+	else
+	{
+		particleEmitter->position[2] = -1.0f;
+		particleEmitter->velocity[2] = +7.0f;
+		particleEmitter->gravity[2] = -9.8f;
 	}
 
 
@@ -267,6 +386,31 @@ void a3demo_initScene(a3_DemoState *demoState)
 		demoState->curveHandle[i] = demoState->curveWaypoint[i];
 		a3real3ProductS(demoState->curveHandle[i].v, demoState->curveWaypoint[i].v, a3real_two);
 	}
+	a3curvePathCreate(demoState->curvePath, demoStateMaxCount_waypoint);
+	a3curvePathUpdate(demoState->curvePath, (const a3f32(*)[4])demoState->curveWaypoint, (const a3f32(*)[4])demoState->curveHandle,
+		demoState->segmentCount, a3curve_linear);
+	a3demo_initSceneAnimation(demoState);
+
+	// scene hierarchy: every object is currently placed in the scene
+	for (i = 0; i < demoStateMaxCount_sceneObject; ++i)
+		sceneObjectParent[i] = -1;
+	a3demo_sceneGraphCreate(demoState->sceneGraph, sceneObjectParent, demoStateMaxCount_sceneObject);
+
+	// bounding sphere of each model before scale (skybox and spare 
+	//	objects have none); the hierarchy over them is built by the first 
+	//	update, once world transforms exist, and nothing is occluded 
+	//	until it has been tested
+	for (i = 0; i < demoStateMaxCount_sceneObject; ++i)
+	{
+		demoState->sceneObjectRadius[i] = a3real_zero;
+		demoState->sceneObjectUnoccluded[i] = a3true;
+	}
+	demoState->sceneObjectRadius[demoState->planeObject - demoState->sceneObject] = 17.0f;
+	demoState->sceneObjectRadius[demoState->torusObject - demoState->sceneObject] = 1.25f;
+	demoState->sceneObjectRadius[demoState->teapotObject - demoState->sceneObject] = 6.5f;
+	demoState->sceneObjectRadius[demoState->sphereObject - demoState->sceneObject] = 1.0f;
+	demoState->sceneObjectRadius[demoState->cylinderObject - demoState->sceneObject] = 2.25f;
+	a3demo_bvhCreate(demoState->sceneBVH, demoStateMaxCount_sceneObject);
 
 
 	// demo modes
@@ -284,6 +428,10 @@ void a3demo_initSceneRefresh(a3_DemoState *demoState)
 {
 	a3demo_setProjectorSceneObject(demoState->sceneCamera, demoState->mainCameraObject);
 	a3demo_setProjectorSceneObject(demoState->shadowLight, demoState->mainLightObject);
+
+	// clip nodes point into the state
+	demoState->animationTree->node[0].clip = demoState->animationClip + 0;
+	demoState->animationTree->node[1].clip = demoState->animationClip + 1;
 }
 
 
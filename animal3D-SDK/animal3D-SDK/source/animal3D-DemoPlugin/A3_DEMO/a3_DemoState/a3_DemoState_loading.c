@@ -77,27 +77,15 @@
 #include "../a3_DemoState.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
 #include <A3_DEMO/a3_DemoStateModern/shader.h>
 
 
 //-----------------------------------------------------------------------------
 // GENERAL UTILITIES
 
-inline a3real4x4r a3demo_setAtlasTransform_internal(a3real4x4p m_out,
-	const a3ui16 atlasWidth, const a3ui16 atlasHeight,
-	const a3ui16 subTexturePosX, const a3ui16 subTexturePosY,
-	const a3ui16 subTextureWidth, const a3ui16 subTextureHeight,
-	const a3ui16 subTextureBorderPadding, const a3ui16 subTextureAdditionalPadding)
-{
-	a3real4x4SetIdentity(m_out);
-	m_out[0][0] = (a3real)(subTextureWidth) / (a3real)(atlasWidth);
-	m_out[1][1] = (a3real)(subTextureHeight) / (a3real)(atlasHeight);
-	m_out[3][0] = (a3real)(subTexturePosX + subTextureBorderPadding + subTextureAdditionalPadding) / (a3real)(atlasWidth);
-	m_out[3][1] = (a3real)(subTexturePosY + subTextureBorderPadding + subTextureAdditionalPadding) / (a3real)(atlasHeight);
-	return m_out;
-}
-
-
 // initialize dummy drawable
 inline void a3demo_initDummyDrawable_internal(a3_DemoState *demoState)
 {
@@ -110,41 +98,408 @@ inline void a3demo_initDummyDrawable_internal(a3_DemoState *demoState)
 }
 
 
+// textures streamed in the background instead of loaded on the spot, 
+//	in request order (so requests can be re-linked by index after hotload)
+inline a3ui32 a3demo_getStreamedTextures_internal(a3_DemoState* demoState, a3_Texture* textureList_out[])
+{
+	textureList_out[0] = demoState->tex_atlas_dm;
+	textureList_out[1] = demoState->tex_atlas_sm;
+	textureList_out[2] = demoState->tex_earth_dm;
+	textureList_out[3] = demoState->tex_earth_sm;
+	return 4;
+}
+
+// load block-compressed texture with mip chain; when streaming, the
+//	conditioned image is cached in the data directory like geometry
+inline void a3demo_loadTextureCompressed_internal(a3_DemoState const* demoState, a3_Texture* texture, const a3byte* textureName, const a3byte* filePath, const a3_TextureBlockFormat blockFormat)
+{
+	a3_TextureCompressedImage image[1] = { 0 };
+	a3byte cachePath[64] = "./data/";
+	a3byte* cachePtr = cachePath + strlen(cachePath);
+	const a3byte* namePtr;
+
+	// cache file named after texture ("tex:name" -> "tex_name.a3tc")
+	for (namePtr = textureName; *namePtr && cachePtr < cachePath + sizeof(cachePath) - 6; ++namePtr, ++cachePtr)
+		*cachePtr = *namePtr == ':' ? '_' : *namePtr;
+	strcpy(cachePtr, ".a3tc");
+
+	if (!demoState->streaming || a3textureCompressedLoadFile(image, cachePath) <= 0)
+		if (a3textureCompressedCreateFromFile(image, filePath, blockFormat, a3tex_mipKaiser) > 0 && demoState->streaming)
+			a3textureCompressedSaveFile(image, cachePath);
+
+	// fall back to uncompressed if the format is not supported
+	if (a3textureCreateFromCompressed(texture, textureName, image) <= 0)
+		a3textureCreateFromFileNative(texture, textureName, filePath);
+	a3textureCompressedRelease(image);
+}
+
+
+// baked scene atlases and their shared cell table
+#define A3_DEMO_ATLAS_DM	"./data/atlas_scene_dm.tga"
+#define A3_DEMO_ATLAS_SM	"./data/atlas_scene_sm.tga"
+#define A3_DEMO_ATLAS_CELLS	"./data/atlas_scene.a3cells"
+
+// scene atlas sources in cell order; each image is scaled to its size in 
+//	the atlas, so both atlases pack to the same layout and share one table
+typedef struct a3_TAG_DEMOSTATEATLASSOURCE {
+	a3byte name[32];
+	const a3byte* filePath[2];	// diffuse, specular (null to reuse diffuse)
+	a3ui16 width, height;
+} a3_DemoStateAtlasSource;
+
+static const a3_DemoStateAtlasSource a3demo_sceneAtlasSource[] = {
+	{ "stone",		{ A3_DEMO_TEX"stone/stone_dm.png",			0 },								256, 256 },
+	{ "earth",		{ A3_DEMO_TEX"earth/2k/earth_dm_2k.png",	A3_DEMO_TEX"earth/2k/earth_sm_2k.png" },	1024, 512 },
+	{ "mars",		{ A3_DEMO_TEX"mars/1k/mars_1k_dm.png",		A3_DEMO_TEX"mars/1k/mars_1k_sm.png" },	1024, 512 },
+	{ "checker",	{ A3_DEMO_TEX"sprite/checker.png",			0 },								128, 128 },
+};
+
+// decode atlas source and scale it to its size in the atlas as rgba8
+inline a3boolean a3demo_decodeAtlasSource_internal(a3ubyte* pixels_out, const a3ui32 width, const a3ui32 height, const a3byte* filePath)
+{
+	a3_TextureStreamImage image[1] = { 0 };
+	a3ubyte* pixels, * dst;
+	const a3ubyte* src8;
+	const a3ui16* src16;
+	a3ui32 i, c, count;
+	if (!filePath || a3textureDecodeFile(image, filePath) <= 0)
+		return a3false;
+
+	count = image->width * image->height;
+	pixels = (image->width == width && image->height == height) ? pixels_out : (a3ubyte*)malloc(count * 4);
+	if (pixels)
+	{
+		src8 = (const a3ubyte*)image->pixels;
+		src16 = (const a3ui16*)image->pixels;
+		for (i = 0, dst = pixels; i < count; ++i, dst += 4)
+		{
+			for (c = 0; c < image->channels; ++c)
+				dst[c] = image->bytes == 2 ? (a3ubyte)(*(src16++) >> 8) : *(src8++);
+			for (; c < 4; ++c)
+				dst[c] = 0xFF;
+		}
+		if (pixels != pixels_out)
+		{
+			a3textureCompressedDownsample(pixels_out, width, height, pixels, image->width, image->height, a3tex_mipKaiser);
+			free(pixels);
+		}
+	}
+	a3textureDecodeRelease(image);
+	return (pixels != 0);
+}
+
+
 //-----------------------------------------------------------------------------
-// uniform helpers
-
-#define a3demo_getUniformLocation(demoProgram, handleName, getLocFunc) (demoProgram->handleName = getLocFunc(demoProgram->program, #handleName))
-#define a3demo_getUniformLocationValid(demoProgram, handleName, getLocFunc) if (a3demo_getUniformLocation(demoProgram, handleName, getLocFunc) >= 0)
-#define a3demo_setUniformDefault(demoProgram, handleName, sendFunc, type, value) \
-	a3demo_getUniformLocationValid(demoProgram, handleName, a3shaderUniformGetLocation) \
-		sendFunc(type, demoProgram->handleName, 1, value)
-#define a3demo_setUniformDefaultMat(demoProgram, handleName, sendFunc, type, value) \
-	a3demo_getUniformLocationValid(demoProgram, handleName, a3shaderUniformGetLocation) \
-		sendFunc(type, 0, demoProgram->handleName, 1, value)
-#define a3demo_setUniformDefaultBlock(demoProgram, handleName, value) \
-	a3demo_getUniformLocationValid(demoProgram, handleName, a3shaderUniformBlockGetLocation) \
-		a3shaderUniformBlockBind(demoProgram->program, demoProgram->handleName, value)
-
-#define a3demo_setUniformDefaultFloat(demoProgram, handleName, value) a3demo_setUniformDefault(demoProgram, handleName, a3shaderUniformSendFloat, a3unif_single, value)
-#define a3demo_setUniformDefaultVec2(demoProgram, handleName, value) a3demo_setUniformDefault(demoProgram, handleName, a3shaderUniformSendFloat, a3unif_vec2, value)
-#define a3demo_setUniformDefaultVec3(demoProgram, handleName, value) a3demo_setUniformDefault(demoProgram, handleName, a3shaderUniformSendFloat, a3unif_vec3, value)
-#define a3demo_setUniformDefaultVec4(demoProgram, handleName, value) a3demo_setUniformDefault(demoProgram, handleName, a3shaderUniformSendFloat, a3unif_vec4, value)
-#define a3demo_setUniformDefaultDouble(demoProgram, handleName, value) a3demo_setUniformDefault(demoProgram, handleName, a3shaderUniformSendDouble, a3unif_single, value)
-#define a3demo_setUniformDefaultDVec2(demoProgram, handleName, value) a3demo_setUniformDefault(demoProgram, handleName, a3shaderUniformSendDouble, a3unif_vec2, value)
-#define a3demo_setUniformDefaultDVec3(demoProgram, handleName, value) a3demo_setUniformDefault(demoProgram, handleName, a3shaderUniformSendDouble, a3unif_vec3, value)
-#define a3demo_setUniformDefaultDVec4(demoProgram, handleName, value) a3demo_setUniformDefault(demoProgram, handleName, a3shaderUniformSendDouble, a3unif_vec4, value)
-#define a3demo_setUniformDefaultInteger(demoProgram, handleName, value) a3demo_setUniformDefault(demoProgram, handleName, a3shaderUniformSendInt, a3unif_single, value)
-#define a3demo_setUniformDefaultIVec2(demoProgram, handleName, value) a3demo_setUniformDefault(demoProgram, handleName, a3shaderUniformSendInt, a3unif_vec2, value)
-#define a3demo_setUniformDefaultIVec3(demoProgram, handleName, value) a3demo_setUniformDefault(demoProgram, handleName, a3shaderUniformSendInt, a3unif_vec3, value)
-#define a3demo_setUniformDefaultIVec4(demoProgram, handleName, value) a3demo_setUniformDefault(demoProgram, handleName, a3shaderUniformSendInt, a3unif_vec4, value)
-#define a3demo_setUniformDefaultMat2(demoProgram, handleName) a3demo_setUniformDefaultMat(demoProgram, handleName, a3shaderUniformSendFloatMat, a3unif_mat2, a3mat2_identity.mm)
-#define a3demo_setUniformDefaultMat3(demoProgram, handleName) a3demo_setUniformDefaultMat(demoProgram, handleName, a3shaderUniformSendFloatMat, a3unif_mat3, a3mat3_identity.mm)
-#define a3demo_setUniformDefaultMat4(demoProgram, handleName) a3demo_setUniformDefaultMat(demoProgram, handleName, a3shaderUniformSendFloatMat, a3unif_mat4, a3mat4_identity.mm)
+// uniform layout
+
+// default given to a uniform handle after linking; values that are zero 
+//	are not sent since linking already initializes every uniform to zero
+typedef enum a3_DemoUniformDefault
+{
+	a3demo_uniformZero,			// value left as linked
+	a3demo_uniformMat4,			// matrix value
+	a3demo_uniformVec4,			// vector value
+	a3demo_uniformSampler,		// texture unit
+	a3demo_uniformBlock,		// uniform block binding
+} a3_DemoUniformDefault;
+
+// uniform layout entry: name of handle, where the handle is stored in a 
+//	demo program, and its default
+typedef struct a3_DemoUniformLayout
+{
+	const a3byte* name;
+	a3ui32 offset;
+	a3_DemoUniformDefault kind;
+	a3i32 unit;
+	const a3f32* value;
+} a3_DemoUniformLayout;
+
+#define a3demo_uniformLayout(handleName, kind, unit, value) { #handleName, (a3ui32)offsetof(a3_DemoStateShaderProgram, handleName), kind, unit, value }
+#define a3demo_uniformLayoutZero(handleName) a3demo_uniformLayout(handleName, a3demo_uniformZero, 0, 0)
+#define a3demo_uniformLayoutMat4(handleName) a3demo_uniformLayout(handleName, a3demo_uniformMat4, 0, a3demo_uniformIdentity)
+#define a3demo_uniformLayoutVec4(handleName, value) a3demo_uniformLayout(handleName, a3demo_uniformVec4, 0, value)
+#define a3demo_uniformLayoutSampler(handleName, unit) a3demo_uniformLayout(handleName, a3demo_uniformSampler, unit, 0)
+#define a3demo_uniformLayoutBlock(handleName, binding) a3demo_uniformLayout(handleName, a3demo_uniformBlock, binding, 0)
+
+const a3f32 a3demo_uniformIdentity[16] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+const a3f32 a3demo_uniformOne[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+const a3f32 a3demo_uniformW[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+// every handle in a demo program; adding a uniform only needs an entry here 
+//	and a handle in the program structure
+const a3_DemoUniformLayout a3demo_uniformLayoutList[] = {
+	// common VS
+	a3demo_uniformLayoutMat4(uMVP),
+	a3demo_uniformLayoutMat4(uMV),
+	a3demo_uniformLayoutMat4(uP),
+	a3demo_uniformLayoutMat4(uP_inv),
+	a3demo_uniformLayoutMat4(uPB),
+	a3demo_uniformLayoutMat4(uPB_inv),
+	a3demo_uniformLayoutMat4(uMV_nrm),
+	a3demo_uniformLayoutMat4(uMVPB),
+	a3demo_uniformLayoutMat4(uMVPB_other),
+	a3demo_uniformLayoutMat4(uAtlas),
+
+	// common FS
+	a3demo_uniformLayoutZero(uLightCt),
+	a3demo_uniformLayoutZero(uLightSz),
+	a3demo_uniformLayoutZero(uLightSzInvSq),
+	a3demo_uniformLayoutVec4(uLightPos, a3demo_uniformW),
+	a3demo_uniformLayoutVec4(uLightCol, a3demo_uniformOne),
+	a3demo_uniformLayoutVec4(uColor, a3demo_uniformOne),
+	a3demo_uniformLayoutMat4(uShadowCascade),
+	a3demo_uniformLayoutZero(uShadowSplit),
+
+	// common texture
+	a3demo_uniformLayoutSampler(uTex_dm, a3tex_unit00),
+	a3demo_uniformLayoutSampler(uTex_sm, a3tex_unit01),
+	a3demo_uniformLayoutSampler(uTex_nm, a3tex_unit02),
+	a3demo_uniformLayoutSampler(uTex_hm, a3tex_unit03),
+	a3demo_uniformLayoutSampler(uTex_dm_ramp, a3tex_unit04),
+	a3demo_uniformLayoutSampler(uTex_sm_ramp, a3tex_unit05),
+	a3demo_uniformLayoutSampler(uTex_shadow, a3tex_unit06),
+	a3demo_uniformLayoutSampler(uTex_proj, a3tex_unit07),
+	a3demo_uniformLayoutSampler(uImage00, a3tex_unit00),
+	a3demo_uniformLayoutSampler(uImage01, a3tex_unit01),
+	a3demo_uniformLayoutSampler(uImage02, a3tex_unit02),
+	a3demo_uniformLayoutSampler(uImage03, a3tex_unit03),
+	a3demo_uniformLayoutSampler(uImage04, a3tex_unit04),
+	a3demo_uniformLayoutSampler(uImage05, a3tex_unit05),
+	a3demo_uniformLayoutSampler(uImage06, a3tex_unit06),
+	a3demo_uniformLayoutSampler(uImage07, a3tex_unit07),
+
+	// common general
+	a3demo_uniformLayoutZero(uIndex),
+	a3demo_uniformLayoutZero(uCount),
+	a3demo_uniformLayoutZero(uFlag),
+	a3demo_uniformLayoutZero(uAxis),
+	a3demo_uniformLayoutZero(uSize),
+	a3demo_uniformLayoutZero(uTime),
+
+	// transformation uniform blocks
+	a3demo_uniformLayoutBlock(ubTransformStack, 0),
+	a3demo_uniformLayoutBlock(ubTransformMVP, 0),
+	a3demo_uniformLayoutBlock(ubTransformMVPB, 1),
+
+	// lighting uniform blocks
+	a3demo_uniformLayoutBlock(ubPointLight, 4),
+
+	// animation uniform blocks
+	a3demo_uniformLayoutBlock(ubCurveWaypoint, 4),
+
+	// instancing uniform blocks
+	a3demo_uniformLayoutBlock(ubInstance, 2),
+};
 
 
 //-----------------------------------------------------------------------------
 // LOADING
 
+// morphing teapot: the loader splits OBJ positions at seams, so each mesh
+//	vertex is mapped back to its file position; target deltas are taken in
+//	file space and normals are recomputed there so seams stay closed
+//	-> the base mesh gets its own buffer so vertex IDs index the deltas
+inline void a3demo_loadMorphTargets_internal(a3_DemoState* demoState, const a3real* transform)
+{
+	const a3byte* const morphStream = "./data/morph_data_gpro_coursebase.dat";
+	const a3byte* const baseFile = A3_DEMO_OBJ"teapot/morph/teapot_base.obj";
+	const a3byte* const targetFile[] = {
+		A3_DEMO_OBJ"teapot/morph/teapot_scale.obj",
+		A3_DEMO_OBJ"teapot/morph/teapot_scale_x.obj",
+		A3_DEMO_OBJ"teapot/morph/teapot_scale_y.obj",
+		A3_DEMO_OBJ"teapot/morph/teapot_scale_z.obj",
+	};
+	enum { targetCount = sizeof(targetFile) / sizeof(*targetFile) };
+
+	a3_FileStream fileStream[1] = { 0 };
+	a3_GeometryData baseData[1] = { 0 };
+	a3f32(*sourcePosition)[3], (*sourceNormal)[3], (*targetPosition)[3], (*targetNormal)[3];
+	const a3f32* targetPositionList[targetCount], * targetNormalList[targetCount];
+	const a3f32(*basePosition)[3], (*baseNormal)[3];
+	a3ui32* map;
+	a3ui32 sourceCount, vertexCount, i, j, k, m;
+	a3f32 lenSq;
+
+	if (demoState->streaming && a3fileStreamOpenRead(fileStream, morphStream))
+	{
+		a3fileStreamReadObject(fileStream, baseData, (a3_FileStreamReadFunc)a3geometryLoadDataBinary);
+		a3fileStreamReadObject(fileStream, demoState->morphTargetData, (a3_FileStreamReadFunc)a3morphTargetDataLoadBinary);
+		a3fileStreamClose(fileStream);
+	}
+	else if (!demoState->streaming || a3fileStreamOpenWrite(fileStream, morphStream))
+	{
+		a3modelLoadOBJ(baseData, baseFile, a3model_calculateVertexTangents, transform);
+		sourceCount = a3morphTargetLoadPositionsOBJ(0, 0, baseFile, transform);
+		vertexCount = baseData->numVertices;
+		basePosition = (const a3f32(*)[3])baseData->attribData[a3attrib_geomPosition];
+		baseNormal = (const a3f32(*)[3])baseData->attribData[a3attrib_geomNormal];
+		if (sourceCount > 0 && vertexCount > 0)
+		{
+			// one block: file positions and normals for base and targets,
+			//	the vertex map, then per-vertex target positions and normals
+			sourcePosition = (a3f32(*)[3])malloc(((targetCount + 1) * sourceCount * 2 + targetCount * vertexCount * 2) * sizeof(*sourcePosition) + vertexCount * sizeof(*map));
+			sourceNormal = sourcePosition + (targetCount + 1) * sourceCount;
+			targetPosition = sourceNormal + (targetCount + 1) * sourceCount;
+			targetNormal = targetPosition + targetCount * vertexCount;
+			map = (a3ui32*)(targetNormal + targetCount * vertexCount);
+
+			a3morphTargetLoadPositionsOBJ(sourcePosition, sourceCount, baseFile, transform);
+			a3morphTargetMapVertices(map, *basePosition, vertexCount, *sourcePosition, sourceCount, 1.0e-4f);
+			a3morphTargetCalculateNormals(sourceNormal, *sourcePosition, sourceCount, map, baseData->indexData, baseData->indexFormat->indexSize, baseData->numIndices);
+			for (j = 0; j < targetCount; ++j)
+			{
+				// targets must come from the same mesh as the base
+				k = (j + 1) * sourceCount;
+				if (a3morphTargetLoadPositionsOBJ(sourcePosition + k, sourceCount, targetFile[j], transform) != (a3i32)sourceCount)
+					memcpy(sourcePosition + k, sourcePosition, sourceCount * sizeof(*sourcePosition));
+				a3morphTargetCalculateNormals(sourceNormal + k, *(sourcePosition + k), sourceCount, map, baseData->indexData, baseData->indexFormat->indexSize, baseData->numIndices);
+
+				// apply file-space differences to the loaded vertices
+				for (i = 0; i < vertexCount; ++i)
+				{
+					m = map[i];
+					for (lenSq = 0.0f, k = 0; k < 3; ++k)
+					{
+						targetPosition[j * vertexCount + i][k] = basePosition[i][k];
+						targetNormal[j * vertexCount + i][k] = baseNormal[i][k];
+						if (m < sourceCount)
+						{
+							targetPosition[j * vertexCount + i][k] += sourcePosition[(j + 1) * sourceCount + m][k] - sourcePosition[m][k];
+							targetNormal[j * vertexCount + i][k] += sourceNormal[(j + 1) * sourceCount + m][k] - sourceNormal[m][k];
+						}
+						lenSq += targetNormal[j * vertexCount + i][k] * targetNormal[j * vertexCount + i][k];
+					}
+					if (lenSq > 0.0f)
+						for (lenSq = a3sqrtfInverse(lenSq), k = 0; k < 3; ++k)
+							targetNormal[j * vertexCount + i][k] *= lenSq;
+				}
+				targetPositionList[j] = *(targetPosition + j * vertexCount);
+				targetNormalList[j] = *(targetNormal + j * vertexCount);
+			}
+			a3morphTargetDataCreate(demoState->morphTargetData, *basePosition, *baseNormal, vertexCount,
+				targetPositionList, targetNormalList, targetCount, 0.0f);
+			free(sourcePosition);
+		}
+
+		a3fileStreamWriteObject(fileStream, baseData, (a3_FileStreamWriteFunc)a3geometrySaveDataBinary);
+		a3fileStreamWriteObject(fileStream, demoState->morphTargetData, (a3_FileStreamWriteFunc)a3morphTargetDataSaveBinary);
+		a3fileStreamClose(fileStream);
+	}
+
+	a3geometryGenerateDrawableSelfContained(demoState->draw_teapot_morph, demoState->vao_tangentbasis_morph, demoState->vbo_morphTeapotDrawBuffer, baseData);
+	a3morphTargetsCreate(demoState->morphTargets, "ssbo:morph-teapot", demoState->morphTargetData, demoStateMaxCount_morphInstance);
+	a3geometryReleaseData(baseData);
+}
+
+// internal utility to build the skinned tentacle: a long cylinder with a
+//	chain of joints along its axis; no rigged model ships with the demo, so
+//	influences are weighted here in the same layout as loaded skin weights
+//	(four float weights, then four integer joints per vertex) and packed
+//	-> each vertex blends the joints whose segment centers are nearest
+//		along the axis, falling off linearly over one and a quarter segments
+//	-> cheap to generate, so it is not streamed
+inline void a3demo_loadSkinning_internal(a3_DemoState* demoState)
+{
+	enum { jointCount = demoStateMaxCount_skinJoint };
+	const a3real tentacleRadius = 0.5f, tentacleLength = 8.0f;
+
+	a3_ProceduralGeometryDescriptor tentacleShape[1] = { a3geomShape_none };
+	a3_GeometryData tentacleData[1] = { 0 };
+	a3_VertexAttributeDescriptor attrib[5];
+	a3_VertexAttributeDataDescriptor attribData[5];
+	a3_VertexFormatDescriptor vertexFormat[1];
+	a3i32 parentIndex[jointCount];
+	a3mat4 bindLocal[jointCount];
+	const a3f32(*position)[3], (*normal)[3];
+	const void* bitangent;
+	a3f32(*weight)[4];
+	a3i32(*index)[4];
+	a3f32 zMin, zMax, u, w;
+	a3ui32 vertexCount, vertexStorage, indexStorage, indexOffset, i, k;
+	a3i32 j;
+
+	a3proceduralCreateDescriptorCylinder(tentacleShape, a3geomFlag_tangents, a3geomAxis_default, tentacleRadius, tentacleLength, 16, 64, 1);
+	a3proceduralGenerateGeometryData(tentacleData, tentacleShape, 0);
+	vertexCount = tentacleData->numVertices;
+	position = (const a3f32(*)[3])tentacleData->attribData[a3attrib_geomPosition];
+	normal = (const a3f32(*)[3])tentacleData->attribData[a3attrib_geomNormal];
+	a3geometryGetAddressBitangent(&bitangent, tentacleData);
+	if (!vertexCount || !tentacleData->numIndices)
+	{
+		a3geometryReleaseData(tentacleData);
+		return;
+	}
+
+	// joints evenly spaced along the axis, each child one segment further
+	for (i = 0, zMin = zMax = position[0][2]; i < vertexCount; ++i)
+	{
+		zMin = a3minimum(zMin, position[i][2]);
+		zMax = a3maximum(zMax, position[i][2]);
+	}
+	for (j = 0; j < jointCount; ++j)
+	{
+		parentIndex[j] = j - 1;
+		bindLocal[j] = a3mat4_identity;
+		bindLocal[j].m32 = j ? (zMax - zMin) / (a3real)jointCount : zMin;
+	}
+	a3skeletonCreate(demoState->skeleton, parentIndex, *bindLocal->m, jointCount);
+
+	// weights and joints as loaded, released when packed; bind positions, 
+	//	normals and packed influences are kept for the CPU reference
+	weight = (a3f32(*)[4])malloc(vertexCount * (sizeof(*weight) + sizeof(*index)));
+	index = (a3i32(*)[4])(weight + vertexCount);
+	demoState->skinPosition = (a3f32(*)[3])malloc(vertexCount * (sizeof(*demoState->skinPosition) * 2 + sizeof(*demoState->skinWeight) + sizeof(*demoState->skinIndex)));
+	demoState->skinNormal = demoState->skinPosition + vertexCount;
+	demoState->skinWeight = (a3ui16(*)[4])(demoState->skinNormal + vertexCount);
+	demoState->skinIndex = (a3ubyte(*)[4])(demoState->skinWeight + vertexCount);
+	demoState->skinVertexCount = vertexCount;
+	memcpy(demoState->skinPosition, position, vertexCount * sizeof(*position));
+	memcpy(demoState->skinNormal, normal, vertexCount * sizeof(*normal));
+	for (i = 0; i < vertexCount; ++i)
+	{
+		u = (position[i][2] - zMin) / (zMax - zMin) * (a3real)jointCount;
+		for (k = 0, j = (a3i32)(u - a3real_half) - 1; k < a3skin_influenceMax; ++k, ++j)
+		{
+			w = a3real_one - a3absolute(u - ((a3real)j + a3real_half)) / 1.25f;
+			index[i][k] = j < 0 ? 0 : j < jointCount ? j : jointCount - 1;
+			weight[i][k] = (j >= 0 && j < jointCount && w > a3real_zero) ? w : a3real_zero;
+		}
+	}
+	a3skinPackInfluences(demoState->skinIndex, demoState->skinWeight, *weight, *index, vertexCount);
+
+	// full tangent basis; packed influences are attached by skinning
+	a3vertexAttribCreateDescriptor(attrib + 0, a3attrib_position, a3attrib_vec3);
+	a3vertexAttribCreateDescriptor(attrib + 1, a3attrib_normal, a3attrib_vec3);
+	a3vertexAttribCreateDescriptor(attrib + 2, a3attrib_texcoord, a3attrib_vec2);
+	a3vertexAttribCreateDescriptor(attrib + 3, a3attrib_tangent, a3attrib_vec3);
+	a3vertexAttribCreateDescriptor(attrib + 4, a3attrib_bitangent, a3attrib_vec3);
+	a3vertexAttribDataCreateDescriptor(attribData + 0, a3attrib_position, position);
+	a3vertexAttribDataCreateDescriptor(attribData + 1, a3attrib_normal, normal);
+	a3vertexAttribDataCreateDescriptor(attribData + 2, a3attrib_texcoord, tentacleData->attribData[a3attrib_geomTexcoord]);
+	a3vertexAttribDataCreateDescriptor(attribData + 3, a3attrib_tangent, tentacleData->attribData[a3attrib_geomTangent]);
+	a3vertexAttribDataCreateDescriptor(attribData + 4, a3attrib_bitangent, bitangent);
+	a3vertexFormatCreateDescriptor(vertexFormat, attrib, 5);
+
+	// own buffer: vertices then influences in the first section, indices 
+	//	in the second
+	vertexStorage = a3vertexFormatGetStorageSpaceRequired(vertexFormat, vertexCount)
+		+ vertexCount * (sizeof(*demoState->skinWeight) + sizeof(*demoState->skinIndex));
+	indexStorage = a3indexFormatGetStorageSpaceRequired(tentacleData->indexFormat, tentacleData->numIndices);
+	a3bufferCreateSplit(demoState->vbo_skinTentacleDrawBuffer, "vbo/ibo:skin", a3buffer_vertex, vertexStorage, indexStorage, 0, 0);
+	a3vertexBufferStore(demoState->vbo_skinTentacleDrawBuffer, vertexFormat, attribData, vertexCount, 0);
+	a3indexBufferStore(demoState->vbo_skinTentacleDrawBuffer, tentacleData->indexFormat, tentacleData->indexData, tentacleData->numIndices, 0, &indexOffset, 0);
+	a3vertexArrayCreateDescriptor(demoState->vao_tangentbasis_skin, "vao:tangentbasis+skin", demoState->vbo_skinTentacleDrawBuffer, vertexFormat, 0);
+	a3skinVertexArrayStoreInfluences(demoState->vao_tangentbasis_skin, demoState->skinIndex, demoState->skinWeight, vertexCount);
+	a3vertexDrawableCreateIndexed(demoState->draw_tentacle_skin, demoState->vao_tangentbasis_skin, demoState->vbo_skinTentacleDrawBuffer,
+		tentacleData->indexFormat, tentacleData->primType, indexOffset, tentacleData->numIndices);
+
+	// palettes of every character, rewritten each frame
+	a3skinPaletteRingCreate(demoState->skinPaletteRing, sizeof(demoState->skinPalette), 3);
+
+	free(weight);
+	a3geometryReleaseData(tentacleData);
+}
+
 // utility to load geometry
 void a3demo_loadGeometry(a3_DemoState *demoState)
 {
@@ -378,30 +733,130 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 
 	// dummy
 	a3demo_initDummyDrawable_internal(demoState);
+
+	// particle pools; every particle is an instance of the unit quad
+	a3particleSystemCreate(demoState->particleSystem, "ssbo:particles", demoStateMaxCount_particle, demoState->draw_unitquad);
+
+	// curve lines rewritten every frame; one segment per waypoint
+	a3curveTessellationCreate(demoState->curveTessellation, "vbo:curve-tess", demoStateMaxCount_waypoint);
+
+	// morphing teapot, same scale as the scene teapot
+	a3demo_loadMorphTargets_internal(demoState, downscale20x.mm);
+
+	// skinned tentacles
+	a3demo_loadSkinning_internal(demoState);
+
+	// occlusion tests of scene object bounds; the pyramid is sized to the 
+	//	scene depth when first used, results may lag up to two frames
+	a3occlusionCullerCreate(demoState->occlusionCuller, demoStateMaxCount_sceneObject, 3);
+
+	// records of scene models drawn in groups, rewritten every pass
+	a3instanceBufferCreate(demoState->instanceBuffer, demoStateMaxCount_instanceBuffer);
 }
 
 
+// internal utility to activate a program, get its uniform and uniform block 
+//	locations from reflection, and set defaults from the layout table; used 
+//	after every link or binary load
+//	- reflection is queried here unless one was stored with a binary
+inline void a3demo_initShaderProgramUniforms_internal(a3_DemoStateShaderProgram* currentDemoProg, const a3_ShaderProgramReflection* reflection_opt)
+{
+	a3_ShaderProgramReflection reflection[1] = { 0 };
+	const a3_DemoUniformLayout* layout = a3demo_uniformLayoutList,
+		* const endLayout = layout + sizeof(a3demo_uniformLayoutList) / sizeof(*a3demo_uniformLayoutList);
+	a3i32* handle;
+
+	// one pass over the driver's list of active uniforms and blocks
+	if (!reflection_opt)
+	{
+		a3shaderProgramReflect(reflection, currentDemoProg->program);
+		reflection_opt = reflection;
+	}
+
+	// activate program
+	a3shaderProgramActivate(currentDemoProg->program);
+
+	// fill handles and send non-zero defaults
+	for (; layout < endLayout; ++layout)
+	{
+		handle = (a3i32*)((a3byte*)currentDemoProg + layout->offset);
+		if (layout->kind == a3demo_uniformBlock)
+		{
+			if ((*handle = a3shaderProgramReflectionGetBlock(reflection_opt, layout->name)) >= 0)
+				a3shaderUniformBlockBind(currentDemoProg->program, *handle, layout->unit);
+		}
+		else if ((*handle = a3shaderProgramReflectionGetLocation(reflection_opt, layout->name)) >= 0)
+		{
+			switch (layout->kind)
+			{
+			case a3demo_uniformZero:	// already zero after linking
+			case a3demo_uniformBlock:	// bound above
+				break;
+			case a3demo_uniformMat4:
+				a3shaderUniformSendFloatMat(a3unif_mat4, 0, *handle, 1, layout->value);
+				break;
+			case a3demo_uniformVec4:
+				a3shaderUniformSendFloat(a3unif_vec4, *handle, 1, layout->value);
+				break;
+			case a3demo_uniformSampler:
+				if (layout->unit)
+					a3shaderUniformSendInt(a3unif_single, *handle, 1, &layout->unit);
+				break;
+			}
+		}
+	}
+}
+
+// internal utility to keep a compiled shader and copies of its file paths 
+//	for incremental reloading; dependencies were recorded when compiling
+inline void a3demo_keepShaderSource_internal(a3_DemoStateShaderSource* source, a3_DemoStateShader* shaderPtr, const a3boolean encoded)
+{
+	a3ui32 i;
+	*source->shader = *shaderPtr->shader;
+	strncpy(source->shaderName, shaderPtr->shaderName, sizeof(source->shaderName) - 1);
+	source->shaderType = shaderPtr->shaderType;
+	source->srcCount = a3minimum(shaderPtr->srcCount, a3demo_shaderSourceFileMax);
+	source->encoded = encoded;
+	for (i = 0; i < source->srcCount; ++i)
+		strncpy(source->filePath[i], shaderPtr->filePath[i], a3demo_shaderSourcePathMax - 1);
+}
+
+// internal utility to check whether a shader comes from encoded files, 
+//	which by convention live in an 'e' subdirectory
+inline a3boolean a3demo_shaderIsEncoded_internal(const a3_DemoStateShader* shaderPtr)
+{
+	a3ui32 i;
+	for (i = 0; i < shaderPtr->srcCount; ++i)
+		if (strstr(shaderPtr->filePath[i], "/e/"))
+			return a3true;
+	return a3false;
+}
+
+
+// shader variant bases, in order of variant names; each stage is expanded 
+//	with the feature defines of the requested variant
+static const a3_DemoShaderVariantBase shaderVariantBaseList[demoStateShaderVariant_max] = {
+	{ "draw-Phong-multi",{ A3_DEMO_VS"04-multipass/passLightingData_shadowCascade_transform_vs4x.glsl", 0, 0, 0, A3_DEMO_FS"04-multipass/drawPhong_multi_variant_fs4x.glsl" } },
+	{ "draw-Phong-skin",{ A3_DEMO_VS"10-skin/passTangentBasis_skin_transform_instanced_vs4x.glsl", 0, 0, 0, A3_DEMO_FS"07-curves/drawPhong_multi_forward_mrt_fs4x.glsl" } },
+	{ "transform",{ A3_DEMO_VS"passthru_transform_vs4x.glsl" } },
+	{ "draw-GBuffer-packed",{ A3_DEMO_VS"04-multipass/passLightingData_shadowCascade_transform_vs4x.glsl", 0, 0, 0, A3_DEMO_FS"06-deferred/drawGBuffer_packed_fs4x.glsl" } },
+};
+
+
 // utility to load shaders
 void a3demo_loadShaders(a3_DemoState *demoState)
 {
 	// direct to demo programs
 	a3_DemoStateShaderProgram *currentDemoProg;
-	a3i32 flag;
-	a3ui32 i;
+	a3i32 flag, parallel;
+	a3ui32 i, j, deferredCount = 0;
+
+	// build timing
+	a3_Timer timer[1] = { 0 };
+	a3f64 timeSubmit, timeComplete;
 
 	// maximum uniform buffer size
 	const a3ui32 uBlockSzMax = a3shaderUniformBlockMaxSize();
-
-	// some default uniform values
-	const a3f32 defaultFloat[] = { 0.0f, 0.0f, 0.0f, 1.0f };
-	const a3f64 defaultDouble[] = { 0.0, 0.0, 0.0, 1.0 };
-	const a3i32 defaultInt[] = { 0, 0, 0, 1 };
-	const a3i32 defaultTexUnits[] = {
-		a3tex_unit00, a3tex_unit01, a3tex_unit02, a3tex_unit03,
-		a3tex_unit04, a3tex_unit05, a3tex_unit06, a3tex_unit07,
-		a3tex_unit08, a3tex_unit09, a3tex_unit10, a3tex_unit11,
-		a3tex_unit12, a3tex_unit13, a3tex_unit14, a3tex_unit15
-	};
 	
 	// list of all unique shaders
 	// this is a good idea to avoid multi-loading 
@@ -422,7 +877,8 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 				passLightingData_transform_vs[1];
 			// 04-multipass
 			a3_DemoStateShader
-				passLightingData_shadowCoord_transform_vs[1];
+				passLightingData_shadowCoord_transform_vs[1],
+				passLightingData_shadowCascade_transform_vs[1];
 			// 06-deferred
 			a3_DemoStateShader
 				passAtlasTexcoord_transform_vs[1],
@@ -430,7 +886,20 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 				passBiasedClipCoord_transform_instanced_vs[1];
 			// 07-curves
 			a3_DemoStateShader
-				passTangentBasis_transform_instanced_vs[1];
+				passTangentBasis_transform_instanced_vs[1],
+				passCurveSegment_vs[1];
+			// 08-particles
+			a3_DemoStateShader
+				passParticle_billboard_instanced_vs[1];
+			// 09-morph
+			a3_DemoStateShader
+				passTangentBasis_morph_transform_instanced_vs[1];
+
+			// tessellation shaders
+			// 07-curves
+			a3_DemoStateShader
+				drawCurveSegment_tcs[1],
+				drawCurveSegment_tes[1];
 
 			// geometry shaders
 			// 07-curves
@@ -471,10 +940,31 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 				drawLightingData_fs[1],
 				drawPhong_multi_deferred_fs[1],
 				drawPhongVolume_fs[1],
-				drawPhongComposite_fs[1];
+				drawPhongComposite_fs[1],
+				drawGBuffer_packed_fs[1],
+				drawPhong_multi_deferred_packed_fs[1];
 			// 07-curves
 			a3_DemoStateShader
 				drawPhong_multi_forward_mrt_fs[1];
+			// 08-particles
+			a3_DemoStateShader
+				drawParticle_fs[1];
+
+			// compute shaders
+			// 05-bloom
+			a3_DemoStateShader
+				bloomDownsample_cs[1],
+				bloomBlur_cs[1],
+				bloomComposite_cs[1];
+			// 08-particles
+			a3_DemoStateShader
+				particleSimulate_cs[1],
+				particleEmit_cs[1],
+				particleFinalize_cs[1];
+			// 11-occlusion
+			a3_DemoStateShader
+				hizReduce_cs[1],
+				occlusionTest_cs[1];
 		};
 	} shaderList = {
 		{
@@ -494,12 +984,23 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 			{ { { 0 },	"shdr-vs:pass-light-trans",			a3shader_vertex  ,	1,{ A3_DEMO_VS"02-shading/e/passLightingData_transform_vs4x.glsl" } } },
 			// 04-multipass
 			{ { { 0 },	"shdr-vs:pass-light-shadow-trans",	a3shader_vertex  ,	1,{ A3_DEMO_VS"04-multipass/e/passLightingData_shadowCoord_transform_vs4x.glsl" } } },
+			{ { { 0 },	"shdr-vs:pass-light-cascade-trans",	a3shader_vertex  ,	1,{ A3_DEMO_VS"04-multipass/passLightingData_shadowCascade_transform_vs4x.glsl" } } },
 			// 06-deferred
 			{ { { 0 },	"shdr-vs:pass-atlas-tex-trans",		a3shader_vertex  ,	1,{ A3_DEMO_VS"06-deferred/e/passAtlasTexcoord_transform_vs4x.glsl" } } },
 			{ { { 0 },	"shdr-vs:pass-light-trans-bias",	a3shader_vertex  ,	1,{ A3_DEMO_VS"06-deferred/e/passLightingData_transform_bias_vs4x.glsl" } } },
 			{ { { 0 },	"shdr-vs:pass-biasedclip-inst",		a3shader_vertex  ,	1,{ A3_DEMO_VS"06-deferred/e/passBiasedClipCoord_transform_instanced_vs4x.glsl" } } },
 			// 07-curves
 			{ { { 0 },	"shdr-vs:pass-tangent-trans-inst",	a3shader_vertex  ,	1,{ A3_DEMO_VS"07-curves/passTangentBasis_transform_instanced_vs4x.glsl" } } },
+			{ { { 0 },	"shdr-vs:pass-curve-segment",		a3shader_vertex  ,	1,{ A3_DEMO_VS"07-curves/passCurveSegment_vs4x.glsl" } } },
+			// 08-particles
+			{ { { 0 },	"shdr-vs:pass-particle-inst",		a3shader_vertex  ,	1,{ A3_DEMO_VS"08-particles/passParticle_billboard_instanced_vs4x.glsl" } } },
+			// 09-morph
+			{ { { 0 },	"shdr-vs:pass-tangent-morph-inst",	a3shader_vertex  ,	1,{ A3_DEMO_VS"09-morph/passTangentBasis_morph_transform_instanced_vs4x.glsl" } } },
+
+			// ts
+			// 07-curves
+			{ { { 0 },	"shdr-tcs:draw-curve-segment",		a3shader_tessellationControl,	1,{ A3_DEMO_TS"07-curves/drawCurveSegment_tcs4x.glsl" } } },
+			{ { { 0 },	"shdr-tes:draw-curve-segment",		a3shader_tessellationEvaluation,	1,{ A3_DEMO_TS"07-curves/drawCurveSegment_tes4x.glsl" } } },
 
 			// gs
 			// 07-curves
@@ -534,8 +1035,25 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 			{ { { 0 },	"shdr-fs:draw-Phong-multi-def",		a3shader_fragment,	1,{ A3_DEMO_FS"06-deferred/e/drawPhong_multi_deferred_fs4x.glsl" } } },
 			{ { { 0 },	"shdr-fs:draw-Phong-volume",		a3shader_fragment,	1,{ A3_DEMO_FS"06-deferred/e/drawPhongVolume_fs4x.glsl" } } },
 			{ { { 0 },	"shdr-fs:draw-Phong-composite",		a3shader_fragment,	1,{ A3_DEMO_FS"06-deferred/e/drawPhongComposite_fs4x.glsl" } } },
+			{ { { 0 },	"shdr-fs:draw-gbuffer-packed",		a3shader_fragment,	1,{ A3_DEMO_FS"06-deferred/drawGBuffer_packed_fs4x.glsl" } } },
+			{ { { 0 },	"shdr-fs:draw-Phong-multi-def-pk",	a3shader_fragment,	1,{ A3_DEMO_FS"06-deferred/drawPhong_multi_deferred_packed_fs4x.glsl" } } },
 			// 07-curves
 			{ { { 0 },	"shdr-fs:draw-Phong-mul-fwd-mrt",	a3shader_fragment,	1,{ A3_DEMO_FS"07-curves/drawPhong_multi_forward_mrt_fs4x.glsl" } } },
+			// 08-particles
+			{ { { 0 },	"shdr-fs:draw-particle",			a3shader_fragment,	1,{ A3_DEMO_FS"08-particles/drawParticle_fs4x.glsl" } } },
+
+			// cs
+			// 05-bloom
+			{ { { 0 },	"shdr-cs:bloom-downsample",			a3shader_compute ,	1,{ A3_DEMO_CS"05-bloom/bloomDownsample_cs4x.glsl" } } },
+			{ { { 0 },	"shdr-cs:bloom-blur",				a3shader_compute ,	1,{ A3_DEMO_CS"05-bloom/bloomBlur_cs4x.glsl" } } },
+			{ { { 0 },	"shdr-cs:bloom-composite",			a3shader_compute ,	1,{ A3_DEMO_CS"05-bloom/bloomComposite_cs4x.glsl" } } },
+			// 08-particles
+			{ { { 0 },	"shdr-cs:particle-simulate",		a3shader_compute ,	1,{ A3_DEMO_CS"08-particles/particleSimulate_cs4x.glsl" } } },
+			{ { { 0 },	"shdr-cs:particle-emit",			a3shader_compute ,	1,{ A3_DEMO_CS"08-particles/particleEmit_cs4x.glsl" } } },
+			{ { { 0 },	"shdr-cs:particle-finalize",		a3shader_compute ,	1,{ A3_DEMO_CS"08-particles/particleFinalize_cs4x.glsl" } } },
+			// 11-occlusion
+			{ { { 0 },	"shdr-cs:hiz-reduce",				a3shader_compute ,	1,{ A3_DEMO_CS"11-occlusion/hizReduce_cs4x.glsl" } } },
+			{ { { 0 },	"shdr-cs:occlusion-test",			a3shader_compute ,	1,{ A3_DEMO_CS"11-occlusion/occlusionTest_cs4x.glsl" } } },
 		}
 	};
 	a3_DemoStateShader *const shaderListPtr = (a3_DemoStateShader *)(&shaderList), *shaderPtr;
@@ -545,18 +1063,44 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 	printf("\n\n---------------- LOAD SHADERS STARTED  ---------------- \n");
 
 
+	// let the driver compile and link on its own threads if it can; every 
+	//	compile and link below is issued up front and its result is only 
+	//	checked once all of them have been submitted
+	parallel = a3shaderParallelInitialize(a3shader_parallelThreadsDefault);
+	a3timerSet(timer, 0.0);
+	a3timerStart(timer);
+
 	// load unique shaders: 
-	//	- load file contents
-	//	- create and compile shader object
+	//	- load file contents and expand includes
+	//	- create shader object and issue compile
 	//	- release file contents
+	//	- record every file read so that edits to includes trigger reloads
+	// encoded shaders can only be decoded by the utility library, which 
+	//	compiles them immediately and cannot expand includes
+	memset(demoState->shaderSource, 0, sizeof(demoState->shaderSource));
 	for (i = 0; i < numUniqueShaders; ++i)
 	{
+		a3_DemoShaderDepend* const depend = i < demoStateMaxCount_shader ? demoState->shaderSource[i].depend : 0;
 		shaderPtr = shaderListPtr + i;
-		flag = a3shaderCreateFromFileList(shaderPtr->shader,
-			shaderPtr->shaderName, shaderPtr->shaderType,
-			shaderPtr->filePath, shaderPtr->srcCount);
-		if (flag == 0)
-			printf("\n ^^^^ SHADER %u '%s' FAILED TO COMPILE \n\n", i, shaderPtr->shader->handle->name);
+		if (a3demo_shaderIsEncoded_internal(shaderPtr))
+		{
+			flag = a3shaderCreateFromFileList(shaderPtr->shader,
+				shaderPtr->shaderName, shaderPtr->shaderType,
+				shaderPtr->filePath, shaderPtr->srcCount);
+			if (flag == 0)
+				printf("\n ^^^^ SHADER %u '%s' FAILED TO COMPILE \n\n", i, shaderPtr->shaderName);
+			for (j = 0; depend && j < shaderPtr->srcCount; ++j)
+				a3demo_shaderDependAddFile(depend, shaderPtr->filePath[j]);
+		}
+		else
+		{
+			flag = a3demo_shaderCreatePreprocessed(shaderPtr->shader,
+				shaderPtr->shaderName, shaderPtr->shaderType,
+				shaderPtr->filePath, shaderPtr->srcCount, 0, depend, a3true);
+			if (flag == 0)
+				printf("\n ^^^^ SHADER %u '%s' FAILED TO PREPROCESS \n\n", i, shaderPtr->shaderName);
+			deferredCount += (flag > 0);
+		}
 	}
 
 	
@@ -569,6 +1113,9 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 		a3_DemoStateShader* geometryShader;
 		a3_DemoStateShader* fragmentShader;
 		const char* shaderName;
+		a3_DemoStateShader* computeShader;
+		a3_DemoStateShader* tessControlShader;
+		a3_DemoStateShader* tessEvalShader;
 	} a4_ShaderProgram; 
 
 	a4_ShaderProgram exampleProgram = { demoState->prog_transform,
@@ -631,12 +1178,40 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 		{ demoState->prog_drawPhongVolume_instanced, shaderList.passBiasedClipCoord_transform_instanced_vs, NULL, shaderList.drawPhongVolume_fs, "prog:draw-Phong-volume-inst" },
 		// draw composited Phong shading model
 		{ demoState->prog_drawPhongComposite, shaderList.passAtlasTexcoord_transform_vs, NULL, shaderList.drawPhongComposite_fs, "prog:draw-Phong-composite" },
+		// draw packed g-buffers (no position target)
+		{ demoState->prog_drawGBuffer_packed, shaderList.passLightingData_shadowCascade_transform_vs, NULL, shaderList.drawGBuffer_packed_fs, "prog:draw-gbuffer-packed" },
+		// draw Phong shading deferred from packed g-buffers
+		{ demoState->prog_drawPhong_multi_deferred_packed, shaderList.passAtlasTexcoord_transform_vs, NULL, shaderList.drawPhong_multi_deferred_packed_fs, "prog:draw-Phong-multi-def-pk" },
 		// 07-curves programs: 
 		// draw Phong forward MRT
 		{ demoState->prog_drawPhong_multi_forward_mrt, shaderList.passTangentBasis_transform_instanced_vs, NULL, shaderList.drawPhong_multi_forward_mrt_fs, "prog:draw-Phong-mul-fwd-mrt" },
 		// draw overlays (tangents & wireframe)
 		{ demoState->prog_drawOverlays_tangents_wireframe, shaderList.passTangentBasis_transform_instanced_vs, shaderList.drawOverlays_tangents_wireframe_gs, shaderList.drawColorAttrib_fs, "prog:draw-overlays-tb-wire" },
 		{ demoState->prog_drawCurveSegment, shaderList.passthru_vs, shaderList.drawCurveSegment_gs, shaderList.drawColorAttrib_fs, "prog:draw-curve-segment" },
+		// draw curve segments with adaptive hardware tessellation
+		{ demoState->prog_drawCurveSegment_tessellated, shaderList.passCurveSegment_vs, NULL, shaderList.drawColorAttrib_fs, "prog:draw-curve-segment-ts", NULL, shaderList.drawCurveSegment_tcs, shaderList.drawCurveSegment_tes },
+
+		// 05-bloom compute path: no graphics stages
+		{ demoState->prog_postBloomDownsample_compute, NULL, NULL, NULL, "prog:bloom-downsample-cs", shaderList.bloomDownsample_cs },
+		{ demoState->prog_postBloomBlur_compute, NULL, NULL, NULL, "prog:bloom-blur-cs", shaderList.bloomBlur_cs },
+		{ demoState->prog_postBloomComposite_compute, NULL, NULL, NULL, "prog:bloom-composite-cs", shaderList.bloomComposite_cs },
+
+		// 08-particles programs: 
+		// simulate, emit and finalize particles on the GPU
+		{ demoState->prog_particleSimulate_compute, NULL, NULL, NULL, "prog:particle-simulate-cs", shaderList.particleSimulate_cs },
+		{ demoState->prog_particleEmit_compute, NULL, NULL, NULL, "prog:particle-emit-cs", shaderList.particleEmit_cs },
+		{ demoState->prog_particleFinalize_compute, NULL, NULL, NULL, "prog:particle-finalize-cs", shaderList.particleFinalize_cs },
+		// draw particle billboards
+		{ demoState->prog_drawParticle_instanced, shaderList.passParticle_billboard_instanced_vs, NULL, shaderList.drawParticle_fs, "prog:draw-particle-inst" },
+
+		// 09-morph programs: 
+		// Phong with morph deltas blended per instance in the vertex shader
+		{ demoState->prog_drawPhong_morph_instanced, shaderList.passTangentBasis_morph_transform_instanced_vs, NULL, shaderList.drawPhong_multi_forward_mrt_fs, "prog:draw-Phong-morph-inst" },
+
+		// 11-occlusion programs: 
+		// reduce depth into the pyramid and test object bounds against it
+		{ demoState->prog_hizReduce_compute, NULL, NULL, NULL, "prog:hiz-reduce-cs", shaderList.hizReduce_cs },
+		{ demoState->prog_occlusionTest_compute, NULL, NULL, NULL, "prog:occlusion-test-cs", shaderList.occlusionTest_cs },
 	};
 
 	const a3ui32 programCount = sizeof(programList) / sizeof(a4_ShaderProgram);
@@ -645,7 +1220,10 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 	{
 		currentDemoProg = programList[i].program;
 		a3shaderProgramCreate(currentDemoProg->program, programList[i].shaderName); //create
-		a3shaderProgramAttachShader(currentDemoProg->program, programList[i].vertexShader->shader); //attach
+		if (programList[i].vertexShader != NULL)
+		{
+			a3shaderProgramAttachShader(currentDemoProg->program, programList[i].vertexShader->shader); //attach if exist
+		}
 		if (programList[i].fragmentShader != NULL)
 		{
 			a3shaderProgramAttachShader(currentDemoProg->program, programList[i].fragmentShader->shader); //attach if exist
@@ -654,6 +1232,15 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 		{
 			a3shaderProgramAttachShader(currentDemoProg->program, programList[i].geometryShader->shader); //attach if exist
 		}
+		if (programList[i].computeShader != NULL)
+		{
+			a3shaderProgramAttachShader(currentDemoProg->program, programList[i].computeShader->shader); //attach if exist
+		}
+		if (programList[i].tessControlShader != NULL && programList[i].tessEvalShader != NULL)
+		{
+			a3shaderProgramAttachShader(currentDemoProg->program, programList[i].tessControlShader->shader); //attach if exist
+			a3shaderProgramAttachShader(currentDemoProg->program, programList[i].tessEvalShader->shader);
+		}
 	}
 
 
@@ -662,11 +1249,42 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 	// good idea to activate the drawable with the most attributes
 	a3vertexDrawableActivate(demoState->draw_axes);
 
-	// link and validate all programs
+	// issue all links; shaders still compiling are waited on by the driver
+	for (i = 0; i < demoStateMaxCount_shaderProgram; ++i)
+		a3shaderProgramLinkDeferred(demoState->shaderProgram[i].program);
+	a3timerUpdate(timer);
+	timeSubmit = timer->totalTime;
+
+	// poll until everything is done; without driver support this finishes 
+	//	on the first pass since every request completed when issued
+	do
+	{
+		for (i = 0, flag = 1; i < numUniqueShaders && flag; ++i)
+			if (shaderListPtr[i].shader->handle->handle)
+				flag = a3shaderCompileIsComplete(shaderListPtr[i].shader);
+		for (i = 0; i < demoStateMaxCount_shaderProgram && flag; ++i)
+			flag = a3shaderProgramLinkIsComplete(demoState->shaderProgram[i].program);
+	} while (!flag);
+	a3timerUpdate(timer);
+	timeComplete = timer->totalTime;
+
+	// check compile results
+	for (i = 0; i < numUniqueShaders; ++i)
+	{
+		shaderPtr = shaderListPtr + i;
+		if (shaderPtr->shader->handle->handle)
+		{
+			flag = a3shaderCompileFinish(shaderPtr->shader);
+			if (flag == 0)
+				printf("\n ^^^^ SHADER %u '%s' FAILED TO COMPILE \n\n", i, shaderPtr->shaderName);
+		}
+	}
+
+	// check link results and validate all programs
 	for (i = 0; i < demoStateMaxCount_shaderProgram; ++i)
 	{
 		currentDemoProg = demoState->shaderProgram + i;
-		flag = a3shaderProgramLink(currentDemoProg->program);
+		flag = a3shaderProgramLinkFinish(currentDemoProg->program);
 		if (flag == 0)
 			printf("\n ^^^^ PROGRAM %u '%s' FAILED TO LINK \n\n", i, currentDemoProg->program->handle->name);
 
@@ -674,83 +1292,60 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 		if (flag == 0)
 			printf("\n ^^^^ PROGRAM %u '%s' FAILED TO VALIDATE \n\n", i, currentDemoProg->program->handle->name);
 	}
+	a3timerUpdate(timer);
+	printf("\n A3 shader build (%s, %u/%u compiles deferred): submit %.2lf ms, complete %.2lf ms, total %.2lf ms \n",
+		parallel > 0 ? "parallel" : "serial", deferredCount, numUniqueShaders,
+		timeSubmit * 1000.0, (timeComplete - timeSubmit) * 1000.0, timer->totalTime * 1000.0);
 
 	// if linking fails, contingency plan goes here
-	// otherwise, release shaders
+	// otherwise, keep shaders so that changed files can be recompiled and 
+	//	only dependent programs relinked; release any that do not fit
+	demoState->shaderSourceCount = a3minimum(numUniqueShaders, demoStateMaxCount_shader);
 	for (i = 0; i < numUniqueShaders; ++i)
 	{
 		shaderPtr = shaderListPtr + i;
-		a3shaderRelease(shaderPtr->shader);
+		if (i < demoState->shaderSourceCount)
+			a3demo_keepShaderSource_internal(demoState->shaderSource + i, shaderPtr, a3demo_shaderIsEncoded_internal(shaderPtr));
+		else
+			a3shaderRelease(shaderPtr->shader);
 	}
 
+	// record which kept shaders each program uses
+	for (i = 0; i < demoStateMaxCount_shaderProgram; ++i)
+		memset(demoState->shaderProgramSource[i].shaderIndex, -1, sizeof(demoState->shaderProgramSource[i].shaderIndex));
+	for (i = 0; i < programCount; ++i)
+	{
+		a3i8* const shaderIndex = demoState->shaderProgramSource[programList[i].program - demoState->shaderProgram].shaderIndex;
+		if (programList[i].vertexShader && programList[i].vertexShader - shaderListPtr < (a3i32)demoState->shaderSourceCount)
+			shaderIndex[a3shader_vertex] = (a3i8)(programList[i].vertexShader - shaderListPtr);
+		if (programList[i].geometryShader && programList[i].geometryShader - shaderListPtr < (a3i32)demoState->shaderSourceCount)
+			shaderIndex[a3shader_geometry] = (a3i8)(programList[i].geometryShader - shaderListPtr);
+		if (programList[i].fragmentShader && programList[i].fragmentShader - shaderListPtr < (a3i32)demoState->shaderSourceCount)
+			shaderIndex[a3shader_fragment] = (a3i8)(programList[i].fragmentShader - shaderListPtr);
+		if (programList[i].computeShader && programList[i].computeShader - shaderListPtr < (a3i32)demoState->shaderSourceCount)
+			shaderIndex[a3shader_compute] = (a3i8)(programList[i].computeShader - shaderListPtr);
+		if (programList[i].tessControlShader && programList[i].tessControlShader - shaderListPtr < (a3i32)demoState->shaderSourceCount)
+			shaderIndex[a3shader_tessellationControl] = (a3i8)(programList[i].tessControlShader - shaderListPtr);
+		if (programList[i].tessEvalShader && programList[i].tessEvalShader - shaderListPtr < (a3i32)demoState->shaderSourceCount)
+			shaderIndex[a3shader_tessellationEvaluation] = (a3i8)(programList[i].tessEvalShader - shaderListPtr);
+	}
+
+	// watch shader directory for changes
+	a3demo_shaderWatchCreate(demoState->shaderWatch, A3_DEMO_GLSL"4x/");
+
+	// variants are built the first time they are requested; binaries are 
+	//	kept next to other generated data so unchanged variants load fast
+	a3demo_shaderVariantCacheCreate(demoState->shaderVariantCache,
+		shaderVariantBaseList, demoStateShaderVariant_max,
+		a3demo_initShaderProgramUniforms_internal, "./data/");
+
 
 	// prepare uniforms algorithmically instead of manually for all programs
 	// get uniform and uniform block locations and set default values for all 
 	//	programs that have a uniform that will either never change or is
 	//	consistent for all programs
 	for (i = 0; i < demoStateMaxCount_shaderProgram; ++i)
-	{
-		// activate program
-		currentDemoProg = demoState->shaderProgram + i;
-		a3shaderProgramActivate(currentDemoProg->program);
-
-		// common VS
-		a3demo_setUniformDefaultMat4(currentDemoProg, uMVP);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uMV);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uP);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uP_inv);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uPB);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uPB_inv);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uMV_nrm);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uMVPB);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uMVPB_other);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uAtlas);
-		
-		// common FS
-		a3demo_setUniformDefaultInteger(currentDemoProg, uLightCt, defaultInt);
-		a3demo_setUniformDefaultFloat(currentDemoProg, uLightSz, defaultFloat);
-		a3demo_setUniformDefaultFloat(currentDemoProg, uLightSzInvSq, defaultFloat);
-		a3demo_setUniformDefaultVec4(currentDemoProg, uLightPos, a3vec4_w.v);
-		a3demo_setUniformDefaultVec4(currentDemoProg, uLightCol, a3vec4_one.v);
-		a3demo_setUniformDefaultVec4(currentDemoProg, uColor, a3vec4_one.v);
-
-		// common texture
-		a3demo_setUniformDefaultInteger(currentDemoProg, uTex_dm, defaultTexUnits + 0);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uTex_sm, defaultTexUnits + 1);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uTex_nm, defaultTexUnits + 2);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uTex_hm, defaultTexUnits + 3);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uTex_dm_ramp, defaultTexUnits + 4);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uTex_sm_ramp, defaultTexUnits + 5);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uTex_shadow, defaultTexUnits + 6);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uTex_proj, defaultTexUnits + 7);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uImage00, defaultTexUnits + 0);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uImage01, defaultTexUnits + 1);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uImage02, defaultTexUnits + 2);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uImage03, defaultTexUnits + 3);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uImage04, defaultTexUnits + 4);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uImage05, defaultTexUnits + 5);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uImage06, defaultTexUnits + 6);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uImage07, defaultTexUnits + 7);
-
-		// common general
-		a3demo_setUniformDefaultInteger(currentDemoProg, uIndex, defaultInt);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uCount, defaultInt);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uFlag, defaultInt);
-		a3demo_setUniformDefaultDouble(currentDemoProg, uAxis, defaultDouble);
-		a3demo_setUniformDefaultDouble(currentDemoProg, uSize, defaultDouble);
-		a3demo_setUniformDefaultDouble(currentDemoProg, uTime, defaultDouble);
-
-		// transformation uniform blocks
-		a3demo_setUniformDefaultBlock(currentDemoProg, ubTransformStack, 0);
-		a3demo_setUniformDefaultBlock(currentDemoProg, ubTransformMVP, 0);
-		a3demo_setUniformDefaultBlock(currentDemoProg, ubTransformMVPB, 1);
-
-		// lighting uniform blocks
-		a3demo_setUniformDefaultBlock(currentDemoProg, ubPointLight, 4);
-
-		// animation uniform blocks
-		a3demo_setUniformDefaultBlock(currentDemoProg, ubCurveWaypoint, 4);
-	}
+		a3demo_initShaderProgramUniforms_internal(demoState->shaderProgram + i, 0);
 
 
 	// set up lighting uniform buffers
@@ -779,12 +1374,174 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 }
 
 
+// utility to reload shaders whose files or includes changed since they 
+//	were compiled
+//	- recompile only the changed shaders, keeping the previous shader if 
+//		the new one fails to compile
+//	- relink only programs that use a recompiled shader; the new program 
+//		replaces the old one only if it links, then uniforms are re-queried
+//	- rebuild variants whose files changed
+//	returns number of programs replaced
+a3ui32 a3demo_reloadShadersChanged(a3_DemoState* demoState)
+{
+	a3_DemoStateShaderSource* source;
+	a3_DemoStateShaderProgram* currentDemoProg;
+	a3_ShaderProgram program[1];
+	a3_Shader shader[1];
+	a3_DemoShaderDepend depend[1];
+	const a3byte* filePath[a3demo_shaderSourceFileMax];
+	a3byte programName[32];
+	a3boolean changed[demoStateMaxCount_shader] = { 0 };
+	a3ui32 i, j, changedCount = 0, relinkCount = 0;
+	a3i32 flag, k;
+
+	// variants track their own files
+	relinkCount = a3demo_shaderVariantCacheReload(demoState->shaderVariantCache);
+
+	// find and recompile changed shaders; times are updated even if 
+	//	compiling fails so that the same broken file is not recompiled 
+	//	every poll
+	for (i = 0; i < demoState->shaderSourceCount; ++i)
+	{
+		source = demoState->shaderSource + i;
+		if (a3demo_shaderDependUpdate(source->depend) > 0)
+		{
+			for (j = 0; j < source->srcCount; ++j)
+				filePath[j] = source->filePath[j];
+
+			// includes may have been added or removed, so plain shaders 
+			//	collect their files again
+			memset(shader, 0, sizeof(shader));
+			if (source->encoded)
+				flag = a3shaderCreateFromFileList(shader, source->shaderName, source->shaderType, filePath, source->srcCount);
+			else
+			{
+				memset(depend, 0, sizeof(depend));
+				flag = a3demo_shaderCreatePreprocessed(shader, source->shaderName, source->shaderType, filePath, source->srcCount, 0, depend, a3false);
+				*source->depend = *depend;
+			}
+			if (flag > 0)
+			{
+				a3shaderRelease(source->shader);
+				*source->shader = *shader;
+				changed[i] = a3true;
+				++changedCount;
+				printf("\n shader %u '%s' recompiled", i, source->shaderName);
+			}
+			else
+				printf("\n ^^^^ SHADER %u '%s' FAILED TO RECOMPILE; KEEPING PREVIOUS \n\n", i, source->shaderName);
+		}
+	}
+	if (!changedCount)
+		return relinkCount;
+
+	// relink dependent programs with the same drawable used for validation 
+	//	when loading
+	a3vertexDrawableActivate(demoState->draw_axes);
+	for (i = 0; i < demoStateMaxCount_shaderProgram; ++i)
+	{
+		const a3i8* const shaderIndex = demoState->shaderProgramSource[i].shaderIndex;
+		for (j = flag = 0; j <= a3shader_compute; ++j)
+			flag |= (shaderIndex[j] >= 0 && changed[shaderIndex[j]]);
+		if (!flag)
+			continue;
+
+		// build new program alongside the old one
+		currentDemoProg = demoState->shaderProgram + i;
+		strncpy(programName, currentDemoProg->program->handle->name, sizeof(programName) - 1);
+		programName[sizeof(programName) - 1] = 0;
+		memset(program, 0, sizeof(program));
+		a3shaderProgramCreate(program, programName);
+		for (j = 0; j <= a3shader_compute; ++j)
+			if ((k = shaderIndex[j]) >= 0)
+				a3shaderProgramAttachShader(program, demoState->shaderSource[k].shader);
+
+		// swap only if the new program links
+		if (a3shaderProgramLink(program) > 0)
+		{
+			if (a3shaderProgramValidate(program) <= 0)
+				printf("\n ^^^^ PROGRAM %u '%s' FAILED TO VALIDATE \n\n", i, programName);
+			a3shaderProgramRelease(currentDemoProg->program);
+			*currentDemoProg->program = *program;
+			a3demo_initShaderProgramUniforms_internal(currentDemoProg, 0);
+			++relinkCount;
+		}
+		else
+		{
+			a3shaderProgramRelease(program);
+			printf("\n ^^^^ PROGRAM %u '%s' FAILED TO RELINK; KEEPING PREVIOUS \n\n", i, programName);
+		}
+	}
+	a3shaderProgramDeactivate();
+	a3vertexDrawableDeactivate();
+
+	printf("\n shaders reloaded: %u recompiled, %u programs relinked \n", changedCount, relinkCount);
+	return relinkCount;
+}
+
+
 // utility to load textures
+// pack scene atlas sources; writes both atlases as TGA and the cell table 
+//	in the binary atlas format to the data directory
+a3ret a3demo_bakeSceneAtlas()
+{
+	const a3ui32 atlasSize = 2048, atlasPadding = 8, atlasMipLevelsSafe = 4;
+	const a3ui32 numSources = sizeof(a3demo_sceneAtlasSource) / sizeof(*a3demo_sceneAtlasSource);
+	const a3byte* const atlasPath[2] = { A3_DEMO_ATLAS_DM, A3_DEMO_ATLAS_SM };
+	const a3_DemoStateAtlasSource* source;
+	a3_TextureAtlasPacker packer[1] = { 0 };
+	a3ubyte* pixels;
+	a3ui32 i, j;
+	a3ret baked = 0;
+
+	printf("\n\n A3 scene atlas bake: ");
+	for (j = 0; j < 2; ++j)
+	{
+		a3textureAtlasPackerCreate(packer, atlasSize, atlasSize, atlasPadding, atlasMipLevelsSafe);
+		for (i = 0, source = a3demo_sceneAtlasSource; i < numSources; ++i, ++source)
+		{
+			// missing maps become flat grey so the layout does not change
+			pixels = (a3ubyte*)malloc(source->width * source->height * 4);
+			if (pixels)
+			{
+				if (!a3demo_decodeAtlasSource_internal(pixels, source->width, source->height, source->filePath[j]) &&
+					!a3demo_decodeAtlasSource_internal(pixels, source->width, source->height, source->filePath[0]))
+				{
+					printf("\n\t %s: source not found; filled grey", source->name);
+					memset(pixels, 0x80, source->width * source->height * 4);
+				}
+				a3textureAtlasPackerAddImage(packer, source->name, pixels, source->width, source->height);
+				free(pixels);
+			}
+		}
+
+		if (a3textureAtlasPackerPack(packer) == (a3ret)numSources &&
+			a3textureAtlasPackerSaveImage(packer, atlasPath[j]) > 0 &&
+			(j || a3textureAtlasPackerSaveCells(packer, A3_DEMO_ATLAS_CELLS) > 0))
+		{
+			printf("\n\t %s: %u x %u, %u cells", atlasPath[j], packer->width, packer->height, packer->packedCount);
+			++baked;
+		}
+		else
+			printf("\n\t %s: not written", atlasPath[j]);
+		a3textureAtlasPackerRelease(packer);
+	}
+	printf("\n");
+	return baked;
+}
+
+
 void a3demo_loadTextures(a3_DemoState* demoState)
 {
 	// utilities
-	const a3ui16 atlasSceneWidth = 2048, atlasSceneHeight = 2048, atlasSceneBorderPad = 8, atlasSceneAdditionalPad = 8;
-	
+	a3_TextureAtlas atlasScene[1] = { 0 };
+	a3_FileStream fileStream[1] = { 0 };
+	a3mat4* const atlasSceneTransform[] = {
+		demoState->atlas_stone, demoState->atlas_earth, demoState->atlas_mars, demoState->atlas_checker,
+	};
+	const a3ui32 numAtlasSceneTransforms = sizeof(atlasSceneTransform) / sizeof(*atlasSceneTransform);
+	const a3_TextureAtlasCell* cell;
+
 	// indexing
 	a3_Texture* tex;
 	a3ui32 i;
@@ -794,6 +1551,7 @@ void a3demo_loadTextures(a3_DemoState* demoState)
 		a3_Texture* texture;
 		a3byte textureName[32];
 		const a3byte* filePath;
+		a3_TextureBlockFormat blockFormat;
 	} a3_DemoStateTexture;
 
 	// texture objects
@@ -814,30 +1572,74 @@ void a3demo_loadTextures(a3_DemoState* demoState)
 		};
 	} textureList = {
 		{
-			{ demoState->tex_skybox_clouds,	"tex:sky-clouds",	"../../../../resource/tex/bg/sky_clouds.png" },
-			{ demoState->tex_skybox_water,	"tex:sky-water",	"../../../../resource/tex/bg/sky_water.png" },
-			{ demoState->tex_atlas_dm,		"tex:atlas-dm",		"../../../../resource/tex/atlas/atlas_scene_dm.png" },
-			{ demoState->tex_atlas_sm,		"tex:atlas-sm",		"../../../../resource/tex/atlas/atlas_scene_sm.png" },
-			{ demoState->tex_earth_dm,		"tex:earth-dm",		"../../../../resource/tex/earth/2k/earth_dm_2k.png" },
-			{ demoState->tex_earth_sm,		"tex:earth-sm",		"../../../../resource/tex/earth/2k/earth_sm_2k.png" },
-			{ demoState->tex_mars_dm,		"tex:mars-dm",		"../../../../resource/tex/mars/1k/mars_1k_dm.png" },
-			{ demoState->tex_mars_sm,		"tex:mars-sm",		"../../../../resource/tex/mars/1k/mars_1k_sm.png" },
-			{ demoState->tex_stone_dm,		"tex:stone-dm",		"../../../../resource/tex/stone/stone_dm.png" },
-			{ demoState->tex_ramp_dm,		"tex:ramp-dm",		"../../../../resource/tex/sprite/celRamp_dm.png" },
-			{ demoState->tex_ramp_sm,		"tex:ramp-sm",		"../../../../resource/tex/sprite/celRamp_sm.png" },
-			{ demoState->tex_checker,		"tex:checker",		"../../../../resource/tex/sprite/checker.png" },
+			{ demoState->tex_skybox_clouds,	"tex:sky-clouds",	"../../../../resource/tex/bg/sky_clouds.png",	a3tex_bc1 },
+			{ demoState->tex_skybox_water,	"tex:sky-water",	"../../../../resource/tex/bg/sky_water.png",	a3tex_bc1 },
+			{ demoState->tex_atlas_dm,		"tex:atlas-dm",		A3_DEMO_ATLAS_DM,	a3tex_bc1 },
+			{ demoState->tex_atlas_sm,		"tex:atlas-sm",		A3_DEMO_ATLAS_SM,	a3tex_bc1 },
+			{ demoState->tex_earth_dm,		"tex:earth-dm",		"../../../../resource/tex/earth/2k/earth_dm_2k.png",	a3tex_blockNone },
+			{ demoState->tex_earth_sm,		"tex:earth-sm",		"../../../../resource/tex/earth/2k/earth_sm_2k.png",	a3tex_blockNone },
+			{ demoState->tex_mars_dm,		"tex:mars-dm",		"../../../../resource/tex/mars/1k/mars_1k_dm.png",	a3tex_bc1 },
+			{ demoState->tex_mars_sm,		"tex:mars-sm",		"../../../../resource/tex/mars/1k/mars_1k_sm.png",	a3tex_bc1 },
+			{ demoState->tex_stone_dm,		"tex:stone-dm",		"../../../../resource/tex/stone/stone_dm.png",	a3tex_bc7 },
+			{ demoState->tex_ramp_dm,		"tex:ramp-dm",		"../../../../resource/tex/sprite/celRamp_dm.png",	a3tex_blockNone },
+			{ demoState->tex_ramp_sm,		"tex:ramp-sm",		"../../../../resource/tex/sprite/celRamp_sm.png",	a3tex_blockNone },
+			{ demoState->tex_checker,		"tex:checker",		"../../../../resource/tex/sprite/checker.png",	a3tex_blockNone },
 		}
 	};
 	const a3ui32 numTextures = sizeof(textureList) / sizeof(a3_DemoStateTexture);
 	a3_DemoStateTexture* const textureListPtr = (a3_DemoStateTexture*)(&textureList), * texturePtr;
+	a3_Texture* streamedTextureList[demoStateMaxCount_texture];
+	const a3ui32 numStreamedTextures = a3demo_getStreamedTextures_internal(demoState, streamedTextureList);
+	a3ui32 j;
+
+	// scene atlases are only baked offline ('0' key); if either atlas is 
+	//	missing, the atlas slots fall back to the individual stone textures 
+	//	and every atlas transform stays identity, so sampling through the 
+	//	atlas transform reads whichever individual texture is bound
+	for (i = 0; i < 2 && a3fileStreamOpenRead(fileStream, i ? A3_DEMO_ATLAS_SM : A3_DEMO_ATLAS_DM); ++i)
+		a3fileStreamClose(fileStream);
+	if (i == 2 && a3fileStreamOpenRead(fileStream, A3_DEMO_ATLAS_CELLS))
+	{
+		a3fileStreamReadObject(fileStream, atlasScene, (a3_FileStreamReadFunc)a3textureAtlasLoadDataBinary);
+		a3fileStreamClose(fileStream);
+	}
+	if (!atlasScene->numCells)
+	{
+		printf("\n scene atlas not baked; using individual textures (press '0' to bake) \n");
+		textureList.texAtlasDM->filePath = textureList.texStoneDM->filePath;
+		textureList.texAtlasSM->filePath = textureList.texStoneDM->filePath;
+		textureList.texAtlasDM->blockFormat = textureList.texAtlasSM->blockFormat = textureList.texStoneDM->blockFormat;
+	}
 
-	// load all textures
+	// load small textures immediately; the image library is not re-entrant 
+	//	and is still used for unsupported files, so this must finish before 
+	//	any streamed texture is requested
 	for (i = 0; i < numTextures; ++i)
 	{
 		texturePtr = textureListPtr + i;
-		a3textureCreateFromFile(texturePtr->texture, texturePtr->textureName, texturePtr->filePath);
-		a3textureActivate(texturePtr->texture, a3tex_unit00);
-		a3textureDefaultSettings();
+		for (j = 0; j < numStreamedTextures && streamedTextureList[j] != texturePtr->texture; ++j);
+		if (j == numStreamedTextures)
+		{
+			if (texturePtr->blockFormat != a3tex_blockNone)
+				a3demo_loadTextureCompressed_internal(demoState, texturePtr->texture, texturePtr->textureName, texturePtr->filePath, texturePtr->blockFormat);
+			else
+				a3textureCreateFromFileNative(texturePtr->texture, texturePtr->textureName, texturePtr->filePath);
+			a3textureActivate(texturePtr->texture, a3tex_unit00);
+			a3textureDefaultSettings();
+		}
+	}
+
+	// request large textures in order; each shows a placeholder until its 
+	//	upload completes, and keeps the settings applied below; compressed 
+	//	ones get their mip chain built on the worker, the rest generate it 
+	//	once resident
+	for (j = 0; j < numStreamedTextures; ++j)
+	{
+		for (texturePtr = textureListPtr; texturePtr->texture != streamedTextureList[j]; ++texturePtr);
+		if (texturePtr->blockFormat != a3tex_blockNone)
+			a3textureStreamRequestCompressed(demoState->textureStream, texturePtr->texture, texturePtr->textureName, texturePtr->filePath, texturePtr->blockFormat, a3tex_mipKaiser);
+		else
+			a3textureStreamRequest(demoState->textureStream, texturePtr->texture, texturePtr->textureName, texturePtr->filePath);
 	}
 
 	// change settings on a per-texture or per-type basis
@@ -846,19 +1648,19 @@ void a3demo_loadTextures(a3_DemoState* demoState)
 	for (i = 0; i < 2; ++i, ++tex)
 	{
 		a3textureActivate(tex, a3tex_unit00);
-		a3textureChangeFilterMode(a3tex_filterLinear);	// linear pixel blending
+		a3textureChangeFilterModeMipmap(a3tex_filterLinear);	// linear pixel and mip level blending
 	}
 	// atlases
 	for (i = 0; i < 2; ++i, ++tex)
 	{
 		a3textureActivate(tex, a3tex_unit00);
-		a3textureChangeFilterMode(a3tex_filterLinear);
+		a3textureChangeFilterModeMipmap(a3tex_filterLinear);
 	}
 	// stone and planets
 	for (i = 0; i < 5; ++i, ++tex)
 	{
 		a3textureActivate(tex, a3tex_unit00);
-		a3textureChangeFilterMode(a3tex_filterLinear);
+		a3textureChangeFilterModeMipmap(a3tex_filterLinear);
 	}
 	// ramps
 	for (i = 0; i < 2; ++i, ++tex)
@@ -868,15 +1670,20 @@ void a3demo_loadTextures(a3_DemoState* demoState)
 	}
 
 
-	// set up texture atlas transforms
-	a3demo_setAtlasTransform_internal(demoState->atlas_stone->m, atlasSceneWidth, atlasSceneHeight,
-		1600, 0, 256, 256, atlasSceneBorderPad, atlasSceneAdditionalPad);
-	a3demo_setAtlasTransform_internal(demoState->atlas_earth->m, atlasSceneWidth, atlasSceneHeight,
-		0, 0, 1024, 512, atlasSceneBorderPad, atlasSceneAdditionalPad);
-	a3demo_setAtlasTransform_internal(demoState->atlas_mars->m, atlasSceneWidth, atlasSceneHeight,
-		0, 544, 1024, 512, atlasSceneBorderPad, atlasSceneAdditionalPad);
-	a3demo_setAtlasTransform_internal(demoState->atlas_checker->m, atlasSceneWidth, atlasSceneHeight,
-		1888, 0, 128, 128, atlasSceneBorderPad, atlasSceneAdditionalPad);
+	// set up texture atlas transforms from baked cells, in source order
+	for (i = 0; i < numAtlasSceneTransforms; ++i)
+	{
+		a3real4x4SetIdentity(atlasSceneTransform[i]->m);
+		if (i < atlasScene->numCells)
+		{
+			cell = atlasScene->cells + i;
+			atlasSceneTransform[i]->m[0][0] = (a3real)cell->relativeSize[0];
+			atlasSceneTransform[i]->m[1][1] = (a3real)cell->relativeSize[1];
+			atlasSceneTransform[i]->m[3][0] = (a3real)cell->relativeOffset[0];
+			atlasSceneTransform[i]->m[3][1] = (a3real)cell->relativeOffset[1];
+		}
+	}
+	a3textureAtlasRelease(atlasScene);
 
 
 	// done
@@ -884,6 +1691,59 @@ void a3demo_loadTextures(a3_DemoState* demoState)
 }
 
 
+// compare built-in decoder against image library on all scene textures
+void a3demo_benchmarkTextureDecode(a3_DemoState* demoState)
+{
+	const a3byte* filePath[] = {
+		"../../../../resource/tex/bg/sky_clouds.png",
+		"../../../../resource/tex/bg/sky_water.png",
+		"../../../../resource/tex/earth/2k/earth_dm_2k.png",
+		"../../../../resource/tex/earth/2k/earth_sm_2k.png",
+		"../../../../resource/tex/mars/1k/mars_1k_dm.png",
+		"../../../../resource/tex/mars/1k/mars_1k_sm.png",
+		"../../../../resource/tex/stone/stone_dm.png",
+		"../../../../resource/tex/sprite/celRamp_dm.png",
+		"../../../../resource/tex/sprite/celRamp_sm.png",
+		"../../../../resource/tex/sprite/checker.png",
+	};
+	const a3ui32 numFiles = sizeof(filePath) / sizeof(*filePath);
+	a3_TextureStreamImage image[1] = { 0 };
+	a3_Timer timer[1] = { 0 };
+	a3f64 timeNative, timeLibrary, totalNative = 0.0, totalLibrary = 0.0, size, totalSize = 0.0;
+	a3ui32 i;
+
+	// image library is not re-entrant; finish pending decodes first
+	a3textureStreamWait(demoState->textureStream);
+
+	printf("\n\n A3 texture decode benchmark (built-in vs. image library): ");
+	for (i = 0; i < numFiles; ++i)
+	{
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		a3textureDecodeFile(image, filePath[i]);
+		a3timerUpdate(timer);
+		timeNative = timer->totalTime;
+		size = (a3f64)(image->width * image->height * image->channels * image->bytes);
+		a3textureDecodeRelease(image);
+
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		a3textureDecodeFileImageLibrary(image, filePath[i]);
+		a3timerUpdate(timer);
+		timeLibrary = timer->totalTime;
+		a3textureDecodeRelease(image);
+
+		printf("\n\t %-48s %8.2lf ms (%7.1lf MB/s) | %8.2lf ms (%7.1lf MB/s)", filePath[i] + 25,
+			timeNative * 1000.0, size / timeNative * 1.0e-6, timeLibrary * 1000.0, size / timeLibrary * 1.0e-6);
+		totalNative += timeNative;
+		totalLibrary += timeLibrary;
+		totalSize += size;
+	}
+	printf("\n\t %-48s %8.2lf ms (%7.1lf MB/s) | %8.2lf ms (%7.1lf MB/s)\n", "total",
+		totalNative * 1000.0, totalSize / totalNative * 1.0e-6, totalLibrary * 1000.0, totalSize / totalLibrary * 1.0e-6);
+}
+
+
 // utility to load framebuffers
 void a3demo_loadFramebuffers(a3_DemoState* demoState)
 {
@@ -893,23 +1753,23 @@ void a3demo_loadFramebuffers(a3_DemoState* demoState)
 
 	// frame sizes
 	const a3ui16 frameWidth1 = demoState->frameWidth, frameHeight1 = demoState->frameHeight;
-	const a3ui16 frameWidth2 = frameWidth1 / 2, frameHeight2 = frameHeight1 / 2;
-	const a3ui16 frameWidth4 = frameWidth2 / 2, frameHeight4 = frameHeight2 / 2;
-	const a3ui16 frameWidth8 = frameWidth4 / 2, frameHeight8 = frameHeight4 / 2;
 
 	// storage precision and targets
 	const a3_FramebufferColorType colorType_scene = a3fbo_colorRGBA16;
 	const a3_FramebufferDepthType depthType_scene = a3fbo_depth24_stencil8;
 	const a3ui32 targets_scene = 8;
 
+	// packed g-buffers: albedo with specular, octahedral normal; position 
+	//	comes from depth, so 12 bytes per pixel instead of 68
+	const a3_FramebufferTargetType targetType_packed[] = {
+		a3fbo_targetRGBA8,
+		a3fbo_targetRG16,
+	};
+	const a3ui32 targets_packed = sizeof(targetType_packed) / sizeof(*targetType_packed);
+
 	const a3_FramebufferDepthType depthType_shadow = a3fbo_depth32;
 	const a3ui16 shadowMapSz = 2048;
-
-	const a3_FramebufferColorType colorType_composite = a3fbo_colorRGBA8;//a3fbo_colorRGBA16;
-	const a3ui32 targets_composite = 8;
-
-	const a3_FramebufferColorType colorType_post = colorType_composite;
-	const a3ui32 targets_post = 2;
+	const a3ui16 shadowAtlasSz = shadowMapSz * a3demo_shadowCascadeAtlasTiles;
 
 
 	// initialize framebuffers: 
@@ -919,34 +1779,26 @@ void a3demo_loadFramebuffers(a3_DemoState* demoState)
 		targets_scene, colorType_scene, depthType_scene,
 		frameWidth1, frameHeight1);
 
+	//	-> packed scene, same depth as scene
+	fbo = demoState->fbo_scene_gbuffer_packed;
+	a3framebufferCreateMixed(fbo, "fbo:scene-packed",
+		targets_packed, targetType_packed, depthType_scene,
+		frameWidth1, frameHeight1);
+
 	//	-> shadow map, depth only
 	fbo = demoState->fbo_shadow_d32;
 	a3framebufferCreate(fbo, "fbo:shadow",
 		0, a3fbo_colorDisable, depthType_shadow,
 		shadowMapSz, shadowMapSz);
 
-	for (i = 0; i < 3; ++i)
-	{
-		//	-> compositing, color only
-		fbo = demoState->fbo_composite_c16 + i;
-		a3framebufferCreate(fbo, "fbo:composite",
-			targets_composite, colorType_composite, a3fbo_depthDisable,
-			frameWidth1, frameHeight1);
-		
-		//	-> post-processing, color only
-		fbo = demoState->fbo_post_c16_2fr + i;
-		a3framebufferCreate(fbo, "fbo:post-half",
-			targets_post, colorType_post, a3fbo_depthDisable,
-			frameWidth2, frameHeight2);
-		fbo = demoState->fbo_post_c16_4fr + i;
-		a3framebufferCreate(fbo, "fbo:post-quarter",
-			targets_post, colorType_post, a3fbo_depthDisable,
-			frameWidth4, frameHeight4);
-		fbo = demoState->fbo_post_c16_8fr + i;
-		a3framebufferCreate(fbo, "fbo:post-eighth",
-			targets_post, colorType_post, a3fbo_depthDisable,
-			frameWidth8, frameHeight8);
-	}
+	//	-> shadow cascade atlas, depth only; one shadow map sized tile per cascade
+	fbo = demoState->fbo_shadowCascade_d32;
+	a3framebufferCreate(fbo, "fbo:shadow-cascade",
+		0, a3fbo_colorDisable, depthType_shadow,
+		shadowAtlasSz, shadowAtlasSz);
+
+	//	-> compositing and post-processing targets are transient; they are 
+	//		acquired from the framebuffer pool per frame by each demo mode
 
 
 	// change texture settings for all framebuffers
@@ -1006,6 +1858,8 @@ void a3demo_refresh(a3_DemoState* demoState)
 		* const endTex = currentTex + demoStateMaxCount_texture;
 	a3_Framebuffer* currentFBO = demoState->framebuffer,
 		* const endFBO = currentFBO + demoStateMaxCount_framebuffer;
+	a3_Texture* currentTexList[demoStateMaxCount_texture];
+	a3ui32 i;
 
 	// set pointers to appropriate release callback for different asset types
 	while (currentBuff < endBuff)
@@ -1020,6 +1874,18 @@ void a3demo_refresh(a3_DemoState* demoState)
 		a3textureHandleUpdateReleaseCallback(currentTex++);
 	while (currentFBO < endFBO)
 		a3framebufferHandleUpdateReleaseCallback(currentFBO++);
+	for (i = 0; i < demoState->shaderSourceCount; ++i)
+		a3shaderHandleUpdateReleaseCallback(demoState->shaderSource[i].shader);
+	a3demo_shaderVariantCacheHandleUpdateReleaseCallbacks(demoState->shaderVariantCache, a3demo_initShaderProgramUniforms_internal);
+	a3framebufferPoolHandleUpdateReleaseCallbacks(demoState->framebufferPool);
+	a3particleSystemHandleUpdateReleaseCallbacks(demoState->particleSystem);
+	a3curveTessellationHandleUpdateReleaseCallbacks(demoState->curveTessellation);
+	a3morphTargetsHandleUpdateReleaseCallbacks(demoState->morphTargets);
+
+	// re-link streamed textures
+	a3demo_getStreamedTextures_internal(demoState, currentTexList);
+	for (i = 0; i < demoState->textureStream->requestCount; ++i)
+		demoState->textureStream->request[i].texture = currentTexList[i];
 
 	// re-link specific object pointers for different asset types
 	currentBuff = demoState->vbo_staticSceneObjectDrawBuffer;
@@ -1049,6 +1915,16 @@ void a3demo_refresh(a3_DemoState* demoState)
 	a3_refreshDrawable_internal(demoState->draw_torus, currentVAO, currentBuff);
 	a3_refreshDrawable_internal(demoState->draw_teapot, currentVAO, currentBuff);
 
+	currentBuff = demoState->vbo_morphTeapotDrawBuffer;
+	currentVAO = demoState->vao_tangentbasis_morph;
+	currentVAO->vertexBuffer = currentBuff;
+	a3_refreshDrawable_internal(demoState->draw_teapot_morph, currentVAO, currentBuff);
+
+	currentBuff = demoState->vbo_skinTentacleDrawBuffer;
+	currentVAO = demoState->vao_tangentbasis_skin;
+	currentVAO->vertexBuffer = currentBuff;
+	a3_refreshDrawable_internal(demoState->draw_tentacle_skin, currentVAO, currentBuff);
+
 	a3demo_initDummyDrawable_internal(demoState);
 }
 
@@ -33,6 +33,7 @@
 #include "../a3_DemoState.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 
 
 //-----------------------------------------------------------------------------
@@ -56,6 +57,20 @@ void a3demo_unloadGeometry(a3_DemoState* demoState)
 		a3vertexArrayReleaseDescriptor(currentVAO++);
 	while (currentDraw < endDraw)
 		a3vertexDrawableRelease(currentDraw++);
+	a3particleSystemRelease(demoState->particleSystem);
+	a3curveTessellationRelease(demoState->curveTessellation);
+	a3morphTargetsRelease(demoState->morphTargets);
+	a3morphTargetDataRelease(demoState->morphTargetData);
+	a3skinPaletteRingRelease(demoState->skinPaletteRing);
+	a3occlusionCullerRelease(demoState->occlusionCuller);
+	a3instanceBufferRelease(demoState->instanceBuffer);
+
+	// CPU copy of skinned vertices is one block
+	free(demoState->skinPosition);
+	demoState->skinPosition = demoState->skinNormal = 0;
+	demoState->skinWeight = 0;
+	demoState->skinIndex = 0;
+	demoState->skinVertexCount = 0;
 }
 
 // utility to unload shaders
@@ -66,10 +81,18 @@ void a3demo_unloadShaders(a3_DemoState* demoState)
 	a3_UniformBuffer* currentUBO = demoState->uniformBuffer,
 		* const endUBO = currentUBO + demoStateMaxCount_uniformBuffer;
 
+	a3_DemoStateShaderSource* currentShader = demoState->shaderSource,
+		* const endShader = currentShader + demoState->shaderSourceCount;
+
 	while (currentProg < endProg)
 		a3shaderProgramRelease((currentProg++)->program);
 	while (currentUBO < endUBO)
 		a3bufferRelease(currentUBO++);
+	while (currentShader < endShader)
+		a3shaderRelease((currentShader++)->shader);
+	demoState->shaderSourceCount = 0;
+	a3demo_shaderWatchRelease(demoState->shaderWatch);
+	a3demo_shaderVariantCacheRelease(demoState->shaderVariantCache);
 }
 
 
@@ -92,6 +115,9 @@ void a3demo_unloadFramebuffers(a3_DemoState* demoState)
 
 	while (currentFBO < endFBO)
 		a3framebufferRelease(currentFBO++);
+
+	// pooled targets are recreated on demand at the new frame size
+	a3framebufferPoolReleaseAll(demoState->framebufferPool);
 }
 
 
@@ -109,6 +135,8 @@ void a3demo_validateUnload(const a3_DemoState* demoState)
 		* const endProg = currentProg + demoStateMaxCount_shaderProgram;
 	const a3_UniformBuffer* currentUBO = demoState->uniformBuffer,
 		* const endUBO = currentUBO + demoStateMaxCount_uniformBuffer;
+	const a3_DemoStateShaderSource* currentShader = demoState->shaderSource,
+		* const endShader = currentShader + demoStateMaxCount_shader;
 	const a3_Texture* currentTex = demoState->texture,
 		* const endTex = currentTex + demoStateMaxCount_texture;
 	const a3_Framebuffer* currentFBO = demoState->framebuffer,
@@ -132,6 +160,15 @@ void a3demo_validateUnload(const a3_DemoState* demoState)
 	if (handle)
 		printf("\n A3 Warning: One or more shader programs not released.");
 
+	handle = 0;
+	while (currentShader < endShader)
+		handle += (currentShader++)->shader->handle->handle;
+	if (handle)
+		printf("\n A3 Warning: One or more shaders not released.");
+
+	if (demoState->shaderVariantCache->variantCount)
+		printf("\n A3 Warning: One or more shader variants not released.");
+
 	handle = 0;
 	while (currentUBO < endUBO)
 		handle += (currentUBO++)->handle->handle;
@@ -149,7 +186,27 @@ void a3demo_validateUnload(const a3_DemoState* demoState)
 		handle += (currentFBO++)->handle->handle;
 	if (handle)
 		printf("\n A3 Warning: One or more framebuffers not released.");
-}
+
+	if (demoState->framebufferPool->count)
+		printf("\n A3 Warning: One or more pooled framebuffers not released.");
+
+	if (demoState->particleSystem->state->handle->handle)
+		printf("\n A3 Warning: Particle system not released.");
+
+	if (demoState->curveTessellation->vertexBuffer->handle->handle)
+		printf("\n A3 Warning: Curve tessellation not released.");
+
+	if (demoState->morphTargets->range->handle->handle)
+		printf("\n A3 Warning: Morph targets not released.");
+
+	if (demoState->skinPaletteRing->buffer)
+		printf("\n A3 Warning: Skin palette ring not released.");
+
+	if (demoState->occlusionCuller->bounds)
+		printf("\n A3 Warning: Occlusion culler not released.");
+
+	if (demoState->instanceBuffer->buffer)
+		printf("\n A3 Warning: Instance buffer not released.");}
 
 
 //-----------------------------------------------------------------------------
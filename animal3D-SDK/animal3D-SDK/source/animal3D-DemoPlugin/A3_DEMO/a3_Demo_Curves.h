@@ -33,6 +33,7 @@
 //-----------------------------------------------------------------------------
 
 #include "animal3D/animal3D.h"
+#include "animal3D-A3DG/a3graphics/a3_Framebuffer.h"
 
 
 //-----------------------------------------------------------------------------
@@ -49,6 +50,7 @@ extern "C"
 	typedef enum a3_Demo_Curves_PassName				a3_Demo_Curves_PassName;
 	typedef enum a3_Demo_Curves_TargetName				a3_Demo_Curves_TargetName;
 	typedef enum a3_Demo_Curves_InterpolationModeName	a3_Demo_Curves_InterpolationModeName;
+	typedef enum a3_Demo_Curves_TessellationModeName	a3_Demo_Curves_TessellationModeName;
 #endif	// __cplusplus
 
 
@@ -156,6 +158,16 @@ extern "C"
 		curves_interp_max
 	};
 
+	// curve drawing mode
+	enum a3_Demo_Curves_TessellationModeName
+	{
+		curves_tessHardware,		// adaptive tessellation shaders
+		curves_tessSoftware,		// adaptive tessellation on CPU
+		curves_tessGeometry,		// fixed samples in geometry shader
+
+		curves_tess_max
+	};
+
 
 //-----------------------------------------------------------------------------
 
@@ -170,7 +182,16 @@ extern "C"
 		a3_Demo_Curves_PassName pass;
 		a3_Demo_Curves_TargetName targetIndex[curves_pass_max], targetCount[curves_pass_max];
 
+		// transient targets acquired from the framebuffer pool this frame, 
+		//	and the storage they would need without aliasing
+		const a3_Framebuffer* transientFBO[curves_pass_max];
+		a3ui32 transientSize;
+
 		a3_Demo_Curves_InterpolationModeName interp;
+
+		// how curves are drawn, and how many lines were drawn last frame
+		a3_Demo_Curves_TessellationModeName tessellate;
+		a3ui32 tessellateLineCount;
 	};
 
 
@@ -56,6 +56,9 @@ void a3curvesCB_input_keyCharPress(a3_DemoState const* demoState, a3_Demo_Curves
 		// toggle interpolation mode
 		a3demoCtrlCasesLoop(demoMode->interp, curves_interp_max, 'V', 'C');
 
+		// toggle curve tessellation mode
+		a3demoCtrlCasesLoop(demoMode->tessellate, curves_tess_max, '=', '-');
+
 		// toggle pipeline mode
 		a3demoCtrlCasesLoop(demoMode->pipeline, curves_pipeline_max, ']', '[');
 
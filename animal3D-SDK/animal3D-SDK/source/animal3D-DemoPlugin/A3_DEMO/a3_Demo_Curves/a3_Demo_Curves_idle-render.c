@@ -135,6 +135,11 @@ void a3curves_render_controls(a3_DemoState const* demoState, a3_Demo_Curves cons
 		"Catmull-Rom interpolation",
 		"Cubic Hermite interpolation",
 	};
+	a3byte const* tessellateText[curves_tess_max] = {
+		"Hardware tessellation (adaptive)",
+		"CPU tessellation (adaptive)",
+		"Geometry shader (fixed)",
+	};
 
 	// text color
 	a3vec4 const col = { a3real_half, a3real_zero, a3real_half, a3real_one };
@@ -148,6 +153,7 @@ void a3curves_render_controls(a3_DemoState const* demoState, a3_Demo_Curves cons
 	a3_Demo_Curves_TargetName const targetIndex = demoMode->targetIndex[pass];
 	a3_Demo_Curves_TargetName const targetCount = demoMode->targetCount[pass];
 	a3_Demo_Curves_InterpolationModeName const interp = demoMode->interp;
+	a3_Demo_Curves_TessellationModeName const tessellate = demoMode->tessellate;
 
 	// demo modes
 	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
@@ -170,6 +176,8 @@ void a3curves_render_controls(a3_DemoState const* demoState, a3_Demo_Curves cons
 		"    Interpolation mode (%u / %u) ('C' | 'V'): %s", interp + 1, curves_interp_max, interpText[interp]);
 	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"        Interpolation data: PARAM %.3f = %.3f / %.3f; SEGMENT %u / %u", (a3f32)demoState->segmentParam, (a3f32)demoState->segmentTime, (a3f32)demoState->segmentDuration, (a3ui32)demoState->segmentIndex + 1, (a3ui32)demoState->segmentCount);
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"    Curve drawing (%u / %u) ('-' | '='): %s; %u lines", tessellate + 1, curves_tess_max, tessellateText[tessellate], demoMode->tessellateLineCount);
 }
 
 
@@ -264,21 +272,22 @@ void a3curves_render(a3_DemoState const* demoState, a3_Demo_Curves const* demoMo
 		demoState->prog_drawTexture_outline,
 	};
 
-	// framebuffers to which to write based on pipeline mode
+	// framebuffers to which to write based on pipeline mode; composite and 
+	//	post-processing targets are transient, acquired from the pool in update
 	const a3_Framebuffer* writeFBO[curves_pass_max] = {
 		demoState->fbo_shadow_d32,
 		demoState->fbo_scene_c16d24s8_mrt,
-		demoState->fbo_composite_c16 + 2,
-		demoState->fbo_post_c16_2fr + 0,
-		demoState->fbo_post_c16_2fr + 1,
-		demoState->fbo_post_c16_2fr + 2,
-		demoState->fbo_post_c16_4fr + 0,
-		demoState->fbo_post_c16_4fr + 1,
-		demoState->fbo_post_c16_4fr + 2,
-		demoState->fbo_post_c16_8fr + 0,
-		demoState->fbo_post_c16_8fr + 1,
-		demoState->fbo_post_c16_8fr + 2,
-		demoState->fbo_composite_c16 + 0,
+		demoMode->transientFBO[curves_passComposite],
+		demoMode->transientFBO[curves_passBright_2],
+		demoMode->transientFBO[curves_passBlurH_2],
+		demoMode->transientFBO[curves_passBlurV_2],
+		demoMode->transientFBO[curves_passBright_4],
+		demoMode->transientFBO[curves_passBlurH_4],
+		demoMode->transientFBO[curves_passBlurV_4],
+		demoMode->transientFBO[curves_passBright_8],
+		demoMode->transientFBO[curves_passBlurH_8],
+		demoMode->transientFBO[curves_passBlurV_8],
+		demoMode->transientFBO[curves_passBlend],
 	};
 
 	// framebuffers from which to read based on pipeline mode
@@ -286,16 +295,16 @@ void a3curves_render(a3_DemoState const* demoState, a3_Demo_Curves const* demoMo
 		{ 0, },
 		{ 0, demoState->fbo_shadow_d32, 0, },
 		{ demoState->fbo_scene_c16d24s8_mrt, 0, },
-		{ demoState->fbo_composite_c16 + 2, 0, },
-		{ demoState->fbo_post_c16_2fr + 0, 0, },
-		{ demoState->fbo_post_c16_2fr + 1, 0, },
-		{ demoState->fbo_post_c16_2fr + 2, 0, },
-		{ demoState->fbo_post_c16_4fr + 0, 0, },
-		{ demoState->fbo_post_c16_4fr + 1, 0, },
-		{ demoState->fbo_post_c16_4fr + 2, 0, },
-		{ demoState->fbo_post_c16_8fr + 0, 0, },
-		{ demoState->fbo_post_c16_8fr + 1, 0, },
-		{ demoState->fbo_post_c16_8fr + 2, demoState->fbo_post_c16_4fr + 2, demoState->fbo_post_c16_2fr + 2, demoState->fbo_composite_c16 + 2, },
+		{ demoMode->transientFBO[curves_passComposite], 0, },
+		{ demoMode->transientFBO[curves_passBright_2], 0, },
+		{ demoMode->transientFBO[curves_passBlurH_2], 0, },
+		{ demoMode->transientFBO[curves_passBlurV_2], 0, },
+		{ demoMode->transientFBO[curves_passBright_4], 0, },
+		{ demoMode->transientFBO[curves_passBlurH_4], 0, },
+		{ demoMode->transientFBO[curves_passBlurV_4], 0, },
+		{ demoMode->transientFBO[curves_passBright_8], 0, },
+		{ demoMode->transientFBO[curves_passBlurH_8], 0, },
+		{ demoMode->transientFBO[curves_passBlurV_8], demoMode->transientFBO[curves_passBlurV_4], demoMode->transientFBO[curves_passBlurV_2], demoMode->transientFBO[curves_passComposite], },
 	};
 
 	// target info
@@ -805,10 +814,21 @@ void a3curves_render(a3_DemoState const* demoState, a3_Demo_Curves const* demoMo
 
 
 		// draw curves
-		if (demoState->segmentCount)
+		if (demoState->segmentCount && (demoMode->tessellate == curves_tessSoftware ||
+			(demoMode->tessellate == curves_tessHardware && !a3curveTessellationHardwareSupported())))
+		{
+			// lines were tessellated during update
+			currentDemoProgram = demoState->prog_drawColorUnif;
+			a3shaderProgramActivate(currentDemoProgram->program);
+			a3shaderUniformSendFloat(a3unif_vec4, currentDemoProgram->uColor, 1, skyblue);
+			a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMVP, 1, activeCamera->viewProjectionMat.mm);
+			a3curveTessellationRender(demoState->curveTessellation);
+		}
+		else if (demoState->segmentCount)
 		{
 			a3ui32* kptr = &k;
-			currentDemoProgram = demoState->prog_drawCurveSegment;
+			a3vec2 const viewportSize = { (a3real)demoState->frameWidth, (a3real)demoState->frameHeight };
+			currentDemoProgram = demoMode->tessellate == curves_tessHardware ? demoState->prog_drawCurveSegment_tessellated : demoState->prog_drawCurveSegment;
 			a3shaderProgramActivate(currentDemoProgram->program);
 			k = demoMode->interp;
 			a3shaderUniformSendInt(a3unif_single, currentDemoProgram->uFlag, 1, kptr);
@@ -817,10 +837,14 @@ void a3curves_render(a3_DemoState const* demoState, a3_Demo_Curves const* demoMo
 			k = demoState->segmentCount;
 			a3shaderUniformSendInt(a3unif_single, currentDemoProgram->uCount, 1, kptr);
 			a3shaderUniformSendFloat(a3unif_single, currentDemoProgram->uTime, 1, &demoState->segmentParam);
+			a3shaderUniformSendFloat(a3unif_vec2, currentDemoProgram->uSize, 1, viewportSize.v);
 			a3shaderUniformSendFloat(a3unif_vec4, currentDemoProgram->uColor, 1, skyblue);
 			a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMVP, 1, activeCamera->viewProjectionMat.mm);
 			a3shaderUniformBufferActivate(demoState->ubo_curveWaypoint, 4);
-			a3vertexDrawableActivateAndRenderInstanced(demoState->dummyDrawable, demoState->segmentCount);
+			if (demoMode->tessellate == curves_tessHardware)
+				a3curveTessellationRenderHardware(demoState->curveTessellation, demoState->segmentCount);
+			else
+				a3vertexDrawableActivateAndRenderInstanced(demoState->dummyDrawable, demoState->segmentCount);
 		}
 	}
 
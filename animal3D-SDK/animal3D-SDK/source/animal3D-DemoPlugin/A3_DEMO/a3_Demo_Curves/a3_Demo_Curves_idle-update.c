@@ -35,10 +35,53 @@
 
 #include "../_a3_demo_utilities/a3_DemoMacros.h"
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
 
 //-----------------------------------------------------------------------------
 // UPDATE
 
+// tessellate curves for the current view: the CPU path writes its lines 
+//	here, while the hardware path picks the same line counts per patch on 
+//	the GPU so they are only counted for display
+void a3curves_updateTessellation(a3_DemoState* demoState, a3_Demo_Curves* demoMode, const a3_DemoProjector* activeCamera)
+{
+	const a3f32(*const waypoint)[4] = (const a3f32(*)[4])demoState->curveWaypoint;
+	const a3f32(*const handle)[4] = (const a3f32(*)[4])demoState->curveHandle;
+	const a3_CurveSegmentType type = demoMode->interp > curves_interpLerp ? (a3_CurveSegmentType)(demoMode->interp - curves_interpLerp) : a3curve_linear;
+	const a3f32 width = (a3f32)demoState->frameWidth, height = (a3f32)demoState->frameHeight;
+	a3f32 control[4][4];
+	a3ui32 i;
+
+	switch (demoMode->tessellate)
+	{
+	case curves_tessHardware:
+		if (a3curveTessellationHardwareSupported())
+		{
+			for (i = 0, demoMode->tessellateLineCount = 0; i < demoState->segmentCount; ++i)
+			{
+				a3curveSegmentControl(control, waypoint, handle, demoState->segmentCount, i, type);
+				demoMode->tessellateLineCount += a3curveSegmentLevel(control, activeCamera->viewProjectionMat.mm, width, height);
+			}
+			break;
+		}
+		// no tessellation stages: fall back to CPU
+	case curves_tessSoftware:
+		demoMode->tessellateLineCount = a3curveTessellationUpdate(demoState->curveTessellation, waypoint, handle, demoState->segmentCount,
+			type, activeCamera->viewProjectionMat.mm, width, height) / 2;
+		break;
+	case curves_tessGeometry:
+		// fixed samples per segment regardless of size
+		demoMode->tessellateLineCount = demoState->segmentCount * 15;
+		break;
+	case curves_tess_max:
+		demoMode->tessellateLineCount = 0;
+		break;
+	}
+}
+
 void a3curves_update(a3_DemoState* demoState, a3_Demo_Curves* demoMode, a3f64 dt)
 {
 	a3ui32 i;
@@ -67,74 +110,38 @@ void a3curves_update(a3_DemoState* demoState, a3_Demo_Curves* demoMode, a3f64 dt
 	// send curve data
 	i = a3bufferRefill(demoState->ubo_curveWaypoint, 0, sizeof(demoState->curveWaypoint), demoState->curveWaypoint);
 	a3bufferRefillOffset(demoState->ubo_curveWaypoint, 0, i, sizeof(demoState->curveHandle), demoState->curveHandle);
+	a3curves_updateTessellation(demoState, demoMode, activeCamera);
 
 
-	// update animation
+	// update animation: move at constant speed along the curve, one lap 
+	//	per segment count times segment duration, and derive the segment 
+	//	and its parameter from where that lands
 	if (demoMode->interp)
 	{
-		a3ui32 k[4] = { 0 };
-	//	a3vec4 m[2] = { 0 };
-
-		// ****TO-DO: 
-		//	-> update segment parameter
-		//		-> if animating, increment segment time in range [0, duration)
-		//		-> check if current segment time exceeded duration
-		//			-> correct segment time & index accordingly
-		//		-> update parameter in range [0, 1)
-		// update controller
-
-		// set key indices
-		k[0] = i = demoState->segmentIndex;
-		k[1] = (i + 1) % demoState->segmentCount;
-		k[2] = (i + 2) % demoState->segmentCount;
-		k[3] = (i + demoState->segmentCount - 1) % demoState->segmentCount;
-
-		// ****TO-DO: 
-		//	-> uncomment interpolation
-		/*
-		// perform position interpolation on current segment
-		switch (demoMode->interp)
+		a3_CurvePath* const curvePath = demoState->curvePath;
+		const a3_CurveSegmentType type = (a3_CurveSegmentType)(demoMode->interp - curves_interpLerp);
+		a3vec4 position;
+		a3real param;
+
+		// tables only change with the curve
+		if (curvePath->type != type || curvePath->segmentCount != demoState->segmentCount)
+			a3curvePathUpdate(curvePath, (const a3f32(*)[4])demoState->curveWaypoint, (const a3f32(*)[4])demoState->curveHandle,
+				demoState->segmentCount, type);
+
+		if (demoState->updateAnimation)
 		{
-		case curves_interpLerp:
-			a3real3Lerp(demoState->sphereObject->position.v,
-				demoState->curveWaypoint[k[0]].v,
-				demoState->curveWaypoint[k[1]].v,
-				demoState->segmentParam);
-			break;
-		case curves_interpBezier:
-			a3real3Bezier3(demoState->sphereObject->position.v,
-				demoState->curveWaypoint[k[0]].v,
-				demoState->curveWaypoint[k[1]].v,
-				demoState->curveWaypoint[k[2]].v,
-				demoState->curveWaypoint[k[3]].v,
-				demoState->segmentParam);
-			break;
-		case curves_interpCatmullRom:
-			a3real3CatmullRom(demoState->sphereObject->position.v,
-				demoState->curveWaypoint[k[3]].v,
-				demoState->curveWaypoint[k[0]].v,
-				demoState->curveWaypoint[k[1]].v,
-				demoState->curveWaypoint[k[2]].v,
-				demoState->segmentParam);
-			break;
-		case curves_interpCubicHermite:
-			a3real3HermiteControl(demoState->sphereObject->position.v,
-				demoState->curveWaypoint[k[0]].v,
-				demoState->curveWaypoint[k[1]].v,
-				demoState->curveHandle[k[0]].v,
-				demoState->curveHandle[k[1]].v,
-				demoState->segmentParam);
-		//	a3real4Diff(m[0].v, demoState->curveHandle[k[0]].v, demoState->curveWaypoint[k[0]].v);
-		//	a3real4Diff(m[1].v, demoState->curveHandle[k[1]].v, demoState->curveWaypoint[k[1]].v);
-		//	a3real3HermiteTangent(demoState->sphereObject->position.v,
-		//		demoState->curveWaypoint[k[0]].v,
-		//		demoState->curveWaypoint[k[1]].v,
-		//		m[0].v,
-		//		m[1].v,
-		//		demoState->segmentParam);
-			break;
+			demoState->curveDistance += (a3real)dt * curvePath->length * demoState->segmentDurationInv / (a3real)demoState->segmentCount;
+			while (demoState->curveDistance >= curvePath->length)
+				demoState->curveDistance -= curvePath->length;
 		}
-		*/
+
+		param = a3curvePathParam(curvePath, demoState->curveDistance);
+		demoState->segmentIndex = (a3ui32)param;
+		demoState->segmentParam = param - (a3real)demoState->segmentIndex;
+		demoState->segmentTime = demoState->segmentParam * demoState->segmentDuration;
+
+		a3curvePathEvaluate((a3f32(*)[4])position.v, 0, curvePath, &demoState->curveDistance, 1);
+		demoState->sphereObject->position = position.xyz;
 	}
 	else
 	{
@@ -144,4 +151,170 @@ void a3curves_update(a3_DemoState* demoState, a3_Demo_Curves* demoMode, a3f64 dt
 }
 
 
+
+// acquire composite and post-processing targets for this frame; each is 
+//	returned to the pool after its last reader so later passes can alias it
+void a3curves_updateFramebuffers(a3_DemoState* demoState, a3_Demo_Curves* demoMode)
+{
+	a3_FramebufferPoolRequest request[curves_pass_max] = { 0 };
+	a3ui32 const sizeRequested = demoState->framebufferPool->sizeRequested;
+	a3ui32 i, j;
+
+	// storage precision and targets
+	const a3_FramebufferColorType colorType_composite = a3fbo_colorRGBA8;
+	const a3ui32 targets_composite = 8;
+
+	const a3_FramebufferColorType colorType_post = colorType_composite;
+	const a3ui32 targets_post = 2;
+
+	// composite and bloom composite, full size
+	request[curves_passComposite].colorTargets = request[curves_passBlend].colorTargets = targets_composite;
+	request[curves_passComposite].colorType = request[curves_passBlend].colorType = colorType_composite;
+	request[curves_passComposite].frameWidth = request[curves_passBlend].frameWidth = demoState->frameWidth;
+	request[curves_passComposite].frameHeight = request[curves_passBlend].frameHeight = demoState->frameHeight;
+	request[curves_passComposite].lastUse = curves_passBlend;
+	request[curves_passBlend].lastUse = -1;
+
+	// bloom levels, half size per level
+	for (i = curves_passBright_2, j = 2; i < curves_passBlend; i += 3, j *= 2)
+	{
+		request[i + 0].colorTargets = request[i + 1].colorTargets = request[i + 2].colorTargets = targets_post;
+		request[i + 0].colorType = request[i + 1].colorType = request[i + 2].colorType = colorType_post;
+		request[i + 0].frameWidth = request[i + 1].frameWidth = request[i + 2].frameWidth = demoState->frameWidth / j;
+		request[i + 0].frameHeight = request[i + 1].frameHeight = request[i + 2].frameHeight = demoState->frameHeight / j;
+		request[i + 0].lastUse = i + 1;
+		request[i + 1].lastUse = i + 2;
+		request[i + 2].lastUse = curves_passBlend;
+	}
+
+	// hold displayed target
+	request[demoMode->pass].lastUse = -1;
+
+	a3framebufferPoolAcquireSequence(demoState->framebufferPool, demoMode->transientFBO, request, curves_pass_max, "fbo:post");
+	demoMode->transientSize = demoState->framebufferPool->sizeRequested - sizeRequested;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// compare ways of placing many followers at given distances along the 
+//	current curve (console output): integrating from the start of the 
+//	curve for each follower, binary search in the arc-length table, and 
+//	the batched uniform-distance lookup
+void a3curves_benchmarkPath(a3_DemoState* demoState)
+{
+	enum { followerCount = 1 << 16, stepsPerSegment = a3curvePath_samplesPerSegment };
+	const a3_CurvePath* curvePath = demoState->curvePath;
+	a3f32(*position)[4] = (a3f32(*)[4])malloc(followerCount * 2 * sizeof(a3f32[4]));
+	a3f32(*reference)[4] = position + followerCount;
+	a3f32* distance = (a3f32*)malloc(followerCount * sizeof(a3f32));
+	a3f32 const* control;
+	a3f32 prev[3], next[3], s, d, t, u, b[4], error, errorMax[3] = { 0.0f };
+	a3f64 time[3];
+	a3_DemoRandom rng[1];
+	a3_DemoRandomLanes lanes[1];
+	a3_Timer timer[1] = { 0 };
+	a3ui32 i, j, k, n;
+
+	if (position && distance && curvePath->length > 0.0f)
+	{
+		a3demo_randomSeed(rng, 2048);
+		a3demo_randomLanesCreate(lanes, rng);
+		a3demo_randomFillReal(lanes, distance, followerCount, 0.0f, curvePath->length);
+
+		// per follower: walk the curve summing chords until the distance is 
+		//	covered, then place it within the last chord
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		for (i = 0; i < followerCount; ++i)
+		{
+			// chords are slightly shorter than the curve, so the very end 
+			//	may never be reached
+			control = curvePath->control[curvePath->segmentCount - 1][3];
+			reference[i][0] = control[0];
+			reference[i][1] = control[1];
+			reference[i][2] = control[2];
+			for (j = 0, s = 0.0f, d = distance[i]; j < curvePath->segmentCount; ++j)
+			{
+				control = curvePath->control[j][0];
+				prev[0] = control[0];
+				prev[1] = control[1];
+				prev[2] = control[2];
+				for (k = 1; k <= stepsPerSegment; ++k)
+				{
+					t = (a3f32)k / (a3f32)stepsPerSegment;
+					u = 1.0f - t;
+					b[0] = u * u * u;
+					b[1] = 3.0f * u * u * t;
+					b[2] = 3.0f * u * t * t;
+					b[3] = t * t * t;
+					for (n = 0; n < 3; ++n)
+						next[n] = b[0] * control[n] + b[1] * control[4 + n] + b[2] * control[8 + n] + b[3] * control[12 + n];
+					t = sqrtf((next[0] - prev[0]) * (next[0] - prev[0]) + (next[1] - prev[1]) * (next[1] - prev[1]) + (next[2] - prev[2]) * (next[2] - prev[2]));
+					if (s + t >= d)
+					{
+						t = t > 0.0f ? (d - s) / t : 0.0f;
+						for (n = 0; n < 3; ++n)
+							reference[i][n] = prev[n] + (next[n] - prev[n]) * t;
+						j = curvePath->segmentCount;
+						break;
+					}
+					s += t;
+					prev[0] = next[0];
+					prev[1] = next[1];
+					prev[2] = next[2];
+				}
+			}
+		}
+		a3timerUpdate(timer);
+		time[0] = timer->totalTime;
+
+		// binary search per follower, same evaluation as the batch
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		for (i = 0; i < followerCount; ++i)
+		{
+			t = a3curvePathParamBinary(curvePath, distance[i]);
+			j = (a3ui32)t;
+			t -= (a3f32)j;
+			u = 1.0f - t;
+			control = curvePath->control[j][0];
+			b[0] = u * u * u;
+			b[1] = 3.0f * u * u * t;
+			b[2] = 3.0f * u * t * t;
+			b[3] = t * t * t;
+			for (n = 0; n < 3; ++n)
+				position[i][n] = b[0] * control[n] + b[1] * control[4 + n] + b[2] * control[8 + n] + b[3] * control[12 + n];
+		}
+		a3timerUpdate(timer);
+		time[1] = timer->totalTime;
+		for (i = 0; i < followerCount; ++i)
+		{
+			error = (position[i][0] - reference[i][0]) * (position[i][0] - reference[i][0]) + (position[i][1] - reference[i][1]) * (position[i][1] - reference[i][1]) + (position[i][2] - reference[i][2]) * (position[i][2] - reference[i][2]);
+			errorMax[1] = error > errorMax[1] ? error : errorMax[1];
+		}
+
+		// batch
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		a3curvePathEvaluate(position, 0, curvePath, distance, followerCount);
+		a3timerUpdate(timer);
+		time[2] = timer->totalTime;
+		for (i = 0; i < followerCount; ++i)
+		{
+			error = (position[i][0] - reference[i][0]) * (position[i][0] - reference[i][0]) + (position[i][1] - reference[i][1]) * (position[i][1] - reference[i][1]) + (position[i][2] - reference[i][2]) * (position[i][2] - reference[i][2]);
+			errorMax[2] = error > errorMax[2] ? error : errorMax[2];
+		}
+
+		printf("\n\n A3 curve path benchmark (%u followers, %u segments, length %.3f): ", followerCount, curvePath->segmentCount, curvePath->length);
+		printf("\n\t integrate per follower  %8.3lf ms (reference)", time[0] * 1000.0);
+		printf("\n\t binary search           %8.3lf ms (%5.1lfx), max offset %.2e", time[1] * 1000.0, time[0] / time[1], sqrtf(errorMax[1]));
+		printf("\n\t uniform-distance batch  %8.3lf ms (%5.1lfx), max offset %.2e", time[2] * 1000.0, time[0] / time[2], sqrtf(errorMax[2]));
+		printf("\n");
+	}
+	free(position);
+	free(distance);
+}
+
+
 //-----------------------------------------------------------------------------
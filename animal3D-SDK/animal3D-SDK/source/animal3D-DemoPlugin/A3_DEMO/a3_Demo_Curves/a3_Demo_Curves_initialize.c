@@ -74,6 +74,9 @@ void a3curves_init(a3_DemoState const* demoState, a3_Demo_Curves* demoMode)
 	demoMode->targetCount[curves_passBlend] = curves_target_display_max;
 
 	demoMode->interp = curves_interpNone;
+
+	demoMode->tessellate = curves_tessHardware;
+	demoMode->tessellateLineCount = 0;
 }
 
 
@@ -33,6 +33,9 @@
 //-----------------------------------------------------------------------------
 
 #include "animal3D/animal3D.h"
+#include "animal3D-A3DG/a3graphics/a3_Framebuffer.h"
+
+#include "_a3_demo_utilities/a3_DemoShaderProgram.h"
 
 
 //-----------------------------------------------------------------------------
@@ -46,8 +49,10 @@ extern "C"
 	typedef enum a3_Demo_Pipelines_DisplayProgramName	a3_Demo_Pipelines_DisplayProgramName;
 	typedef enum a3_Demo_Pipelines_ActiveCameraName		a3_Demo_Pipelines_ActiveCameraName;
 	typedef enum a3_Demo_Pipelines_PipelineName			a3_Demo_Pipelines_PipelineName;
+	typedef enum a3_Demo_Pipelines_BloomName			a3_Demo_Pipelines_BloomName;
 	typedef enum a3_Demo_Pipelines_PassName				a3_Demo_Pipelines_PassName;
 	typedef enum a3_Demo_Pipelines_TargetName			a3_Demo_Pipelines_TargetName;
+	typedef enum a3_Demo_Pipelines_SkinningName			a3_Demo_Pipelines_SkinningName;
 #endif	// __cplusplus
 
 
@@ -58,6 +63,7 @@ extern "C"
 	{
 		pipelines_renderPhong,			// Phong shading
 		pipelines_renderPhongShadow,	// Phong shading with shadows
+		pipelines_renderPhongCascade,	// Phong shading with cascaded shadows
 
 		pipelines_render_max
 	};
@@ -85,10 +91,30 @@ extern "C"
 	enum a3_Demo_Pipelines_PipelineName
 	{
 		pipelines_forward,				// forward lighting pipeline
+		pipelines_deferredPacked,		// deferred shading from packed g-buffers
 
 		pipelines_pipeline_max
 	};
 
+	// bloom implementation names
+	enum a3_Demo_Pipelines_BloomName
+	{
+		pipelines_bloomFragment,		// full-screen fragment passes per level
+		pipelines_bloomCompute,			// compute dispatches with shared-memory blur
+
+		pipelines_bloom_max
+	};
+
+	// skinned character modes
+	enum a3_Demo_Pipelines_SkinningName
+	{
+		pipelines_skinOff,				// no skinned characters
+		pipelines_skinLinear,			// linear blend skinning
+		pipelines_skinDualQuat,			// dual quaternion skinning
+
+		pipelines_skin_max
+	};
+
 	// render passes
 	enum a3_Demo_Pipelines_PassName
 	{
@@ -147,6 +173,11 @@ extern "C"
 		pipelines_scene_fragdepth,			// fragment depth
 		pipelines_target_scene_max, 
 
+		pipelines_scene_packed_albedoSpecular = 0,	// albedo with specular intensity (rgba8)
+		pipelines_scene_packed_normal,				// octahedral view normal (rg16)
+		pipelines_scene_packed_fragdepth,			// fragment depth (position source)
+		pipelines_target_scene_packed_max,
+
 		pipelines_composite_finalcolor = 0,	// final display color
 		pipelines_composite_position,		// position attribute
 		pipelines_composite_normal,			// normal attribute
@@ -179,8 +210,44 @@ extern "C"
 		a3_Demo_Pipelines_ActiveCameraName activeCamera;
 
 		a3_Demo_Pipelines_PipelineName pipeline;
+		a3_Demo_Pipelines_BloomName bloom;
 		a3_Demo_Pipelines_PassName pass;
 		a3_Demo_Pipelines_TargetName targetIndex[pipelines_pass_max], targetCount[pipelines_pass_max];
+
+		// transient targets acquired from the framebuffer pool this frame, 
+		//	and the storage they would need without aliasing
+		const a3_Framebuffer* transientFBO[pipelines_pass_max];
+		a3ui32 transientSize;
+
+		// forward cascade program variant requested this frame (null if 
+		//	not used or failed to build)
+		const a3_DemoStateShaderProgram* cascadeProgram;
+
+		// skinning program variant requested this frame (null if not used 
+		//	or failed to build)
+		const a3_DemoStateShaderProgram* skinProgram;
+
+		// instanced program variants requested this frame for batched 
+		//	depth and scene models (null if not batching or failed to build)
+		const a3_DemoStateShaderProgram* batchDepthProgram, * batchSceneProgram;
+
+		// simulate and draw GPU particles in the forward scene pass
+		a3boolean particles;
+
+		// draw a row of morphing teapots in the forward scene pass
+		a3boolean morphTargets;
+
+		// draw a grid of skinned tentacles in the forward scene pass
+		a3_Demo_Pipelines_SkinningName skinning;
+
+		// fill scene depth with visible models before shading them
+		a3boolean depthPrepass;
+
+		// skip models hidden behind last frame's depth
+		a3boolean occlusion;
+
+		// draw models sharing a mesh and material with one instanced call
+		a3boolean instancing;
 	};
 
 
@@ -36,6 +36,18 @@
 #include "../_a3_demo_utilities/a3_DemoMacros.h"
 
 
+//-----------------------------------------------------------------------------
+// UTILITIES
+
+void a3pipelines_benchmarkGBuffer(a3_DemoState const* demoState);
+void a3pipelines_benchmarkParticles(a3_DemoState const* demoState);
+void a3pipelines_benchmarkMorphTargets(a3_DemoState const* demoState);
+void a3pipelines_benchmarkSkinning(a3_DemoState const* demoState, a3_Demo_Pipelines const* demoMode);
+void a3pipelines_benchmarkOcclusion(a3_DemoState const* demoState, a3_Demo_Pipelines const* demoMode);
+void a3pipelines_benchmarkInstancing(a3_DemoState const* demoState, a3_Demo_Pipelines const* demoMode);
+void a3pipelines_benchmarkBloom(a3_DemoState const* demoState, a3_Demo_Pipelines const* demoMode);
+
+
 //-----------------------------------------------------------------------------
 // CALLBACKS
 
@@ -56,6 +68,27 @@ void a3pipelinesCB_input_keyCharPress(a3_DemoState const* demoState, a3_Demo_Pip
 		// toggle pipeline mode
 		a3demoCtrlCasesLoop(demoMode->pipeline, pipelines_pipeline_max, ']', '[');
 
+		// toggle bloom implementation
+		a3demoCtrlCasesLoop(demoMode->bloom, pipelines_bloom_max, 'u', 'U');
+
+		// toggle particles
+		a3demoCtrlCaseToggle(demoMode->particles, 'Z');
+
+		// toggle morph targets
+		a3demoCtrlCaseToggle(demoMode->morphTargets, 'n');
+
+		// toggle skinning method
+		a3demoCtrlCaseIncLoop(demoMode->skinning, pipelines_skin_max, 'r');
+
+		// toggle depth prepass
+		a3demoCtrlCaseToggle(demoMode->depthPrepass, 'p');
+
+		// toggle occlusion culling
+		a3demoCtrlCaseToggle(demoMode->occlusion, 'y');
+
+		// toggle instance batching
+		a3demoCtrlCaseToggle(demoMode->instancing, 'f');
+
 		// toggle target
 		a3demoCtrlCasesLoop(demoMode->targetIndex[demoMode->pass], demoMode->targetCount[demoMode->pass], '}', '{');
 
@@ -98,6 +131,52 @@ void a3pipelinesCB_input_keyCharPress(a3_DemoState const* demoState, a3_Demo_Pip
 			demoMode->pass = pipelines_passScene;
 		break;
 	}
+
+	// packed g-buffers have fewer scene targets
+	switch (asciiKey)
+	{
+	case ']':
+	case '[':
+		demoMode->targetCount[pipelines_passScene] = demoMode->pipeline == pipelines_deferredPacked
+			? pipelines_target_scene_packed_max : pipelines_target_scene_max;
+		demoMode->targetIndex[pipelines_passScene] = pipelines_scene_finalcolor;
+		break;
+
+		// compare g-buffer layouts (console output)
+	case 'G':
+		a3pipelines_benchmarkGBuffer(demoState);
+		break;
+
+		// scale GPU particles and validate against CPU (console output)
+	case '4':
+		a3pipelines_benchmarkParticles(demoState);
+		break;
+
+		// compare morph target blending on GPU and CPU (console output)
+	case '5':
+		a3pipelines_benchmarkMorphTargets(demoState);
+		break;
+
+		// scale skinned characters on GPU and CPU (console output)
+	case 'X':
+		a3pipelines_benchmarkSkinning(demoState, demoMode);
+		break;
+
+		// compare occlusion tests on GPU and CPU (console output)
+	case '6':
+		a3pipelines_benchmarkOcclusion(demoState, demoMode);
+		break;
+
+		// compare per-object and batched draws of repeated models (console output)
+	case 'O':
+		a3pipelines_benchmarkInstancing(demoState, demoMode);
+		break;
+
+		// compare compute bloom against fragment bloom (console output)
+	case '7':
+		a3pipelines_benchmarkBloom(demoState, demoMode);
+		break;
+	}
 }
 
 
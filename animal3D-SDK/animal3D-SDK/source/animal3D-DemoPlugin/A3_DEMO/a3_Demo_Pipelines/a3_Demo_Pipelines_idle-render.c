@@ -34,6 +34,10 @@
 
 #include "../_a3_demo_utilities/a3_DemoRenderUtils.h"
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 
 // OpenGL
 #ifdef _WIN32
@@ -47,6 +51,15 @@
 
 //-----------------------------------------------------------------------------
 
+// number of scene objects the last occlusion result hid
+inline a3ui32 a3pipelines_countOccluded_internal(a3_DemoState const* demoState)
+{
+	a3ui32 i, count = 0;
+	for (i = 0; i < demoStateMaxCount_sceneObject; ++i)
+		count += !demoState->sceneObjectUnoccluded[i];
+	return count;
+}
+
 // controls for pipelines mode
 void a3pipelines_render_controls(a3_DemoState const* demoState, a3_Demo_Pipelines const* demoMode,
 	a3f32 const textAlign, a3f32 const textDepth, a3f32 const textOffsetDelta, a3f32 textOffset)
@@ -54,12 +67,20 @@ void a3pipelines_render_controls(a3_DemoState const* demoState, a3_Demo_Pipeline
 	// display mode info
 	a3byte const* pipelineText[pipelines_pipeline_max] = {
 		"Forward rendering",
+		"Deferred shading (packed g-buffers)",
+	};
+
+	// bloom implementation names
+	a3byte const* bloomText[pipelines_bloom_max] = {
+		"Fragment passes",
+		"Compute dispatches",
 	};
 
 	// forward pipeline names
 	a3byte const* renderProgramName[pipelines_render_max] = {
 		"Phong shading",
 		"Phong shading with shadow mapping",
+		"Phong shading with cascaded shadow maps",
 	};
 
 	// forward display names
@@ -74,6 +95,13 @@ void a3pipelines_render_controls(a3_DemoState const* demoState, a3_Demo_Pipeline
 		"Shadow map light",
 	};
 
+	// skinning method names
+	a3byte const* skinningText[pipelines_skin_max] = {
+		"OFF",
+		"Linear blend",
+		"Dual quaternion",
+	};
+
 	// pass names
 	a3byte const* passName[pipelines_pass_max] = {
 		"Pass: Capture shadow map",
@@ -105,6 +133,11 @@ void a3pipelines_render_controls(a3_DemoState const* demoState, a3_Demo_Pipeline
 		"Color target 7: Lighting: specular total",
 		"Depth buffer",
 	};
+	a3byte const* targetText_scenePacked[pipelines_target_scene_packed_max] = {
+		"Color target 0: Albedo (rgb) and specular (a)",
+		"Color target 1: Octahedral view normal",
+		"Depth buffer (position source)",
+	};
 	a3byte const* targetText_composite[pipelines_target_composite_max] = {
 		"Color target 0: FINAL DISPLAY COLOR",
 		"Color target 1: Attrib data: view position",
@@ -124,7 +157,7 @@ void a3pipelines_render_controls(a3_DemoState const* demoState, a3_Demo_Pipeline
 	};
 	a3byte const* const* targetText[pipelines_pass_max] = {
 		targetText_shadow,
-		targetText_scene,
+		demoMode->pipeline == pipelines_deferredPacked ? targetText_scenePacked : targetText_scene,
 		targetText_composite,
 		targetText_composite,
 		targetText_bright,
@@ -147,6 +180,7 @@ void a3pipelines_render_controls(a3_DemoState const* demoState, a3_Demo_Pipeline
 	a3_Demo_Pipelines_DisplayProgramName const display = demoMode->display;
 	a3_Demo_Pipelines_ActiveCameraName const activeCamera = demoMode->activeCamera;
 	a3_Demo_Pipelines_PipelineName const pipeline = demoMode->pipeline;
+	a3_Demo_Pipelines_BloomName const bloom = demoMode->bloom;
 	a3_Demo_Pipelines_PassName const pass = demoMode->pass;
 	a3_Demo_Pipelines_TargetName const targetIndex = demoMode->targetIndex[pass];
 	a3_Demo_Pipelines_TargetName const targetCount = demoMode->targetCount[pass];
@@ -154,6 +188,12 @@ void a3pipelines_render_controls(a3_DemoState const* demoState, a3_Demo_Pipeline
 	// demo modes
 	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"    Pipeline (%u / %u) ('[' | ']'): %s", pipeline + 1, pipelines_pipeline_max, pipelineText[pipeline]);
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"        Compare g-buffer layouts ('G'): console output");
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"    Bloom (%u / %u) ('U' | 'u'): %s", bloom + 1, pipelines_bloom_max, bloomText[bloom]);
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"        Compare compute and fragment bloom ('7'): console output");
 	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"    Display pass (%u / %u) ('(' | ')'): %s", pass + 1, pipelines_pass_max, passName[pass]);
 	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
@@ -166,11 +206,306 @@ void a3pipelines_render_controls(a3_DemoState const* demoState, a3_Demo_Pipeline
 		"    Display mode (%u / %u) ('J' | 'K'): %s", display + 1, pipelines_display_max, displayProgramName[display]);
 	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"    Active camera (%u / %u) ('c' prev | next 'v'): %s", activeCamera + 1, pipelines_camera_max, cameraText[activeCamera]);
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"    GPU particles, forward only ('Z'): %s", demoMode->particles ? "ON" : "OFF");
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"        Scale and validate particles ('4'): console output");
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"    Morph target teapots, forward only ('n'): %s", demoMode->morphTargets ? "ON" : "OFF");
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"        Compare morph blending ('5'): console output");
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"    Skinned tentacles, forward only ('r'): %s", skinningText[demoMode->skinning]);
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"        Scale skinned characters ('X'): console output");
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"    Deferred lights in view: %u / %u; on teapot: %u", demoState->deferredLightVisibleCount, demoState->deferredLightCount,
+		demoState->sceneObjectLightCount[demoState->teapotObject - demoState->sceneObject]);
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"    Depth prepass ('p'): %s", demoMode->depthPrepass ? "ON" : "OFF");
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"    Occlusion culling ('y'): %s; hidden: %u / %u", demoMode->occlusion ? "ON" : "OFF",
+		a3pipelines_countOccluded_internal(demoState), demoStateMaxCount_sceneObject);
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"        Compare occlusion tests ('6'): console output");
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"    Instance batching ('f'): %s", !demoMode->instancing ? "OFF"
+		: demoMode->batchSceneProgram ? "ON" : demoMode->batchDepthProgram ? "ON, depth passes only" : "unavailable");
+	a3textDraw(demoState->text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"        Compare per-object and batched draws ('O'): console output");
 }
 
 
 //-----------------------------------------------------------------------------
 
+// bloom using compute shaders: the same pass graph as the fragment chain 
+//	(per level: bright pass from the scene composite or the previous 
+//	level's vertical blur, then horizontal and vertical blur), one 
+//	dispatch per pass, so both paths write the same targets and agree 
+//	within filtering tolerance
+//	-> blur loads each strip of a line along the axis into shared memory 
+//		once instead of fetching every tap from the texture
+//	-> returns 1 if dispatched, 0 if compute is unavailable
+inline a3ret a3pipelines_renderBloomCompute_internal(a3_DemoState const* demoState,
+	a3_Framebuffer const* const writeFBO[pipelines_pass_max], a3_Framebuffer const* const readFBO[pipelines_pass_max][4],
+	a3vec2 const sampleAxisH, a3vec2 const sampleAxisV)
+{
+	const a3ui32 tileSize = 16, stripSize = 64;
+
+	const a3_DemoStateShaderProgram* currentDemoProgram;
+	const a3_Framebuffer* currentWriteFBO;
+	const a3_Framebuffer* currentReadFBO;
+	a3_Demo_Pipelines_PassName currentPass;
+	a3vec2 pixelSize, sampleAxis;
+	a3ui32 w, h, lineLength, lineCount;
+	a3ui32 i, j;
+
+	// requires compute shaders and image load/store (GL 4.3)
+	if (!glDispatchCompute || !glBindImageTexture || !glMemoryBarrier)
+		return 0;
+
+	for (i = 0; i < 3; ++i)
+	{
+		// bright pass and downsample: sample at the previous level's size
+		//	-> image format must match post-processing color type
+		currentDemoProgram = demoState->prog_postBloomDownsample_compute;
+		a3shaderProgramActivate(currentDemoProgram->program);
+		currentPass = (a3_Demo_Pipelines_PassName)(pipelines_passBright_2 + i * 3);
+		currentWriteFBO = writeFBO[currentPass];
+		currentReadFBO = readFBO[currentPass][0];
+		a3real2Set(pixelSize.v, a3recip((a3real)currentReadFBO->frameWidth), a3recip((a3real)currentReadFBO->frameHeight));
+		a3shaderUniformSendFloat(a3unif_vec2, currentDemoProgram->uSize, 1, pixelSize.v);
+		a3framebufferBindColorTexture(currentReadFBO, a3tex_unit00, 0);
+		glBindImageTexture(0, currentWriteFBO->colorTextureHandle[0], 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+		glDispatchCompute((currentWriteFBO->frameWidth + tileSize - 1) / tileSize, (currentWriteFBO->frameHeight + tileSize - 1) / tileSize, 1);
+		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+		// blur along each axis, same size as bright pass
+		currentDemoProgram = demoState->prog_postBloomBlur_compute;
+		a3shaderProgramActivate(currentDemoProgram->program);
+		a3real2Set(pixelSize.v, a3recip((a3real)currentWriteFBO->frameWidth), a3recip((a3real)currentWriteFBO->frameHeight));
+		a3shaderUniformSendFloat(a3unif_vec2, currentDemoProgram->uSize, 1, pixelSize.v);
+		for (j = 1; j < 3; ++j)
+		{
+			currentPass = (a3_Demo_Pipelines_PassName)(pipelines_passBright_2 + i * 3 + j);
+			currentWriteFBO = writeFBO[currentPass];
+			currentReadFBO = readFBO[currentPass][0];
+			sampleAxis = j == 1 ? sampleAxisH : sampleAxisV;
+			a3shaderUniformSendFloat(a3unif_vec2, currentDemoProgram->uAxis, 1, sampleAxis.v);
+			a3framebufferBindColorTexture(currentReadFBO, a3tex_unit00, 0);
+			glBindImageTexture(0, currentWriteFBO->colorTextureHandle[0], 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+
+			// one work group per strip, strips laid out along each line
+			w = currentWriteFBO->frameWidth;
+			h = currentWriteFBO->frameHeight;
+			lineLength = sampleAxis.x == a3real_zero ? h : sampleAxis.y == a3real_zero ? w : w < h ? w : h;
+			lineCount = sampleAxis.x == a3real_zero ? w : sampleAxis.y == a3real_zero ? h : w + h - 1;
+			glDispatchCompute((lineLength + stripSize - 1) / stripSize, lineCount, 1);
+			glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+		}
+	}
+
+	// composite: scene first, then blurred levels
+	currentDemoProgram = demoState->prog_postBloomComposite_compute;
+	a3shaderProgramActivate(currentDemoProgram->program);
+	currentWriteFBO = writeFBO[pipelines_passBlend];
+	a3real2Set(pixelSize.v, a3recip((a3real)currentWriteFBO->frameWidth), a3recip((a3real)currentWriteFBO->frameHeight));
+	a3shaderUniformSendFloat(a3unif_vec2, currentDemoProgram->uSize, 1, pixelSize.v);
+	a3framebufferBindColorTexture(readFBO[pipelines_passBright_2][0], a3tex_unit00, 0);
+	for (i = 0; i < 3; ++i)
+		a3framebufferBindColorTexture(writeFBO[pipelines_passBlurV_2 + i * 3], a3tex_unit01 + i, 0);
+	glBindImageTexture(0, currentWriteFBO->colorTextureHandle[0], 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+	glDispatchCompute((currentWriteFBO->frameWidth + tileSize - 1) / tileSize, (currentWriteFBO->frameHeight + tileSize - 1) / tileSize, 1);
+
+	// result is displayed as a texture
+	glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+	return 1;
+}
+
+
+// bloom using fragment passes: draw FSQ per pass of the same graph
+//	-> FSQ drawable must be active
+inline void a3pipelines_renderBloomFragment_internal(a3_DemoState const* demoState,
+	a3_Framebuffer const* const writeFBO[pipelines_pass_max], a3_Framebuffer const* const readFBO[pipelines_pass_max][4],
+	a3vec2 const sampleAxisH, a3vec2 const sampleAxisV)
+{
+	const a3_DemoStateShaderProgram* currentDemoProgram;
+	const a3_Framebuffer* currentWriteFBO;
+	const a3_Framebuffer* currentReadFBO;
+	a3_Demo_Pipelines_PassName currentPass;
+	a3vec2 pixelSize;
+	a3ui32 i, j;
+
+	for (i = 0; i < 3; ++i)
+	{
+		// bright pass at this level's size
+		currentDemoProgram = demoState->prog_drawTexture_brightPass;
+		a3shaderProgramActivate(currentDemoProgram->program);
+
+		currentPass = (a3_Demo_Pipelines_PassName)(pipelines_passBright_2 + i * 3);
+		currentWriteFBO = writeFBO[currentPass];
+		currentReadFBO = readFBO[currentPass][0];
+		a3framebufferActivate(currentWriteFBO);
+		a3framebufferBindColorTexture(currentReadFBO, a3tex_unit00, 0);
+		a3vertexDrawableRenderActive();
+
+		// blur along each axis
+		currentDemoProgram = demoState->prog_drawTexture_blurGaussian;
+		a3shaderProgramActivate(currentDemoProgram->program);
+		a3real2Set(pixelSize.v, a3recip((a3real)currentWriteFBO->frameWidth), a3recip((a3real)currentWriteFBO->frameHeight));
+		a3shaderUniformSendFloat(a3unif_vec2, currentDemoProgram->uSize, 1, pixelSize.v);
+		for (j = 1; j < 3; ++j)
+		{
+			currentPass = (a3_Demo_Pipelines_PassName)(pipelines_passBright_2 + i * 3 + j);
+			currentWriteFBO = writeFBO[currentPass];
+			currentReadFBO = readFBO[currentPass][0];
+			a3framebufferActivate(currentWriteFBO);
+			a3framebufferBindColorTexture(currentReadFBO, a3tex_unit00, 0);
+			a3shaderUniformSendFloat(a3unif_vec2, currentDemoProgram->uAxis, 1, j == 1 ? sampleAxisH.v : sampleAxisV.v);
+			a3vertexDrawableRenderActive();
+		}
+	}
+
+	// bloom composite
+	currentDemoProgram = demoState->prog_drawTexture_blendScreen4;
+	a3shaderProgramActivate(currentDemoProgram->program);
+
+	currentPass = pipelines_passBlend;
+	currentWriteFBO = writeFBO[currentPass];
+	a3framebufferActivate(currentWriteFBO);
+	for (i = 0; i < 4; ++i)
+		a3framebufferBindColorTexture(readFBO[currentPass][i], a3tex_unit00 + i, 0);
+	a3vertexDrawableRenderActive();
+}
+
+
+// flag scene objects whose bounds are not outside a view's frustum
+inline void a3pipelines_cullSceneObjects_internal(a3_DemoState const* demoState, a3real4x4p const viewProjectionMat, a3boolean* visible_out)
+{
+	a3f32 plane[6][4];
+	a3ui32 object[demoStateMaxCount_sceneObject];
+	a3ret i, count;
+
+	// everything is visible until the first update builds the hierarchy
+	a3demo_bvhFrustumPlanes(plane, viewProjectionMat);
+	count = demoState->sceneBVH->nodeCount
+		? a3demo_bvhQueryFrustum(demoState->sceneBVH, object, demoStateMaxCount_sceneObject, (const a3f32(*)[4])plane, 6) : -1;
+	for (i = 0; i < demoStateMaxCount_sceneObject; ++i)
+		visible_out[i] = count < 0;
+	for (i = 0; i < count; ++i)
+		visible_out[object[i]] = a3true;
+}
+
+
+// record of a batched lit model; std140 layout of the instance record in 
+//	the lighting data vertex shader (depth records are only the MVP)
+typedef struct a3_Demo_Pipelines_InstanceRecord
+{
+	a3mat4 modelViewMat, modelViewNormalMat, modelViewProjectionMat;
+	a3vec4 color;
+} a3_Demo_Pipelines_InstanceRecord;
+
+// uniform block binding of instance records (see uniform layout)
+#define a3pipelines_instanceBinding	2
+
+// draw included models with the active batch program: models sharing a 
+//	mesh (and material, if lit) form a group, each writes its record to 
+//	the instance buffer, then each group is drawn with one instanced call 
+//	per chunk; lit records need the view matrix and model colors
+//	-> returns the number of draws
+inline a3ui32 a3pipelines_drawModelsBatched_internal(a3_DemoState const* demoState, a4_SceneModel const* models, a3ui32 const modelCount, a3boolean const* include,
+	a3real4x4p const viewProjectionMat, a3real4x4p const viewMat_opt, a3vec4 const* color_opt)
+{
+	a3_InstanceBatchGroup group[demoStateMaxCount_sceneObject];
+	a3ui32 order[demoStateMaxCount_sceneObject], first[demoStateMaxCount_sceneObject];
+	const void* key[demoStateMaxCount_sceneObject][a3instance_keyCount];
+	a3f32 data[demoStateMaxCount_sceneObject * (sizeof(a3_Demo_Pipelines_InstanceRecord) + demoStateMaxCount_instanceAlignment) / sizeof(a3f32)];
+	a3ubyte* const base = (a3ubyte*)data;
+	a3_Demo_Pipelines_InstanceRecord* record;
+	a3mat4* depthRecord;
+	a4_SceneModel const* model;
+	const a3ui32 stride = viewMat_opt ? sizeof(a3_Demo_Pipelines_InstanceRecord) : sizeof(a3mat4);
+	a3ui32 groupCount, size = 0, draws = 0, g, i, k;
+	a3ret ret;
+
+	// depth only needs the mesh; lit models also need the material
+	for (k = 0; k < modelCount && k < demoStateMaxCount_sceneObject; ++k)
+	{
+		key[k][0] = models[k].mesh;
+		key[k][1] = viewMat_opt ? models[k].texture : 0;
+	}
+	groupCount = (a3ui32)a3instanceBatchGroup(group, order, (const void* const(*)[a3instance_keyCount])key, include, k);
+
+	// each group's records start on an aligned offset; alignment was 
+	//	checked against the padding when the batch programs were chosen
+	for (g = 0; g < groupCount; ++g)
+	{
+		first[g] = a3instanceBufferAlign(demoState->instanceBuffer, size);
+		size = first[g] + group[g].count * stride;
+		for (i = 0; i < group[g].count; ++i)
+		{
+			model = models + order[group[g].first + i];
+			if (viewMat_opt)
+			{
+				record = (a3_Demo_Pipelines_InstanceRecord*)(base + first[g]) + i;
+				a3real4x4Product(record->modelViewMat.m, viewMat_opt, model->obj->modelMat.m);
+				a3real4x4SetReal4x4(record->modelViewNormalMat.m, record->modelViewMat.m);
+				a3demo_quickInvertTranspose_internal(record->modelViewNormalMat.m);
+				a3real4SetReal4(record->modelViewNormalMat.m[3], a3vec4_zero.v);
+				a3real4x4Product(record->modelViewProjectionMat.m, viewProjectionMat, model->obj->modelMat.m);
+				record->color = color_opt[model - models];
+			}
+			else
+			{
+				depthRecord = (a3mat4*)(base + first[g]) + i;
+				a3real4x4Product(depthRecord->m, viewProjectionMat, model->obj->modelMat.m);
+			}
+		}
+	}
+
+	// one upload for the pass, then one call per group and chunk
+	if (groupCount && a3instanceBufferUpload(demoState->instanceBuffer, data, size) > 0)
+	{
+		for (g = 0; g < groupCount; ++g)
+		{
+			model = models + order[group[g].first];
+			if (viewMat_opt)
+			{
+				a3textureActivate(model->texture->tex_dm, a3tex_unit00);
+				a3textureActivate(model->texture->tex_sm, a3tex_unit01);
+			}
+			ret = a3instanceBufferRender(demoState->instanceBuffer, model->mesh, a3pipelines_instanceBinding, first[g], stride, group[g].count);
+			if (ret > 0)
+				draws += ret;
+		}
+	}
+	return draws;
+}
+
+// draw included models to depth: in groups if the batch variant is 
+//	available, otherwise one at a time with the plain transform program
+inline void a3pipelines_drawModelsDepth_internal(a3_DemoState const* demoState, a3_Demo_Pipelines const* demoMode, a4_SceneModel const* models, a3ui32 const modelCount, a3boolean const* include,
+	a3real4x4p const viewProjectionMat)
+{
+	const a3_DemoStateShaderProgram* program = demoMode->batchDepthProgram;
+	a3mat4 modelViewProjectionMat;
+	a3ui32 k;
+	if (program)
+	{
+		a3shaderProgramActivate(program->program);
+		a3pipelines_drawModelsBatched_internal(demoState, models, modelCount, include, viewProjectionMat, 0, 0);
+	}
+	else
+	{
+		program = demoState->prog_transform;
+		a3shaderProgramActivate(program->program);
+		for (k = 0; k < modelCount; ++k)
+			if (include[k])
+				a3demo_drawModelSimple_activateModel(modelViewProjectionMat.m, viewProjectionMat, models[k].obj->modelMat.m, program, models[k].mesh);
+	}
+}
+
+
 // sub-routine for rendering the demo state using the shading pipeline
 void a3pipelines_render(a3_DemoState const* demoState, a3_Demo_Pipelines const* demoMode)
 {
@@ -231,11 +566,11 @@ void a3pipelines_render(a3_DemoState const* demoState, a3_Demo_Pipelines const*
 
 	// Initialize models with textures here
 	const a4_SceneModel models[] = {
-		{demoState->planeObject, demoState->draw_plane, &textures[0]},
-		{demoState->torusObject, demoState->draw_torus, &textures[1]},
-		{demoState->teapotObject, demoState->draw_teapot, &textures[2]},
-		{demoState->sphereObject, demoState->draw_sphere, &textures[3]},
-		{demoState->cylinderObject, demoState->draw_cylinder, &textures[0]}
+		{demoState->planeObject, demoState->draw_plane, &textures[0], 17.0f},
+		{demoState->torusObject, demoState->draw_torus, &textures[1], 1.25f},
+		{demoState->teapotObject, demoState->draw_teapot, &textures[2], 6.5f},
+		{demoState->sphereObject, demoState->draw_sphere, &textures[3], 1.0f},
+		{demoState->cylinderObject, demoState->draw_cylinder, &textures[0], 2.25f}
 	};
 	//NOTE Position does not work, but i was wondering if this would be the defn of instancing? 
 
@@ -247,7 +582,14 @@ void a3pipelines_render(a3_DemoState const* demoState, a3_Demo_Pipelines const*
 		{
 			demoState->prog_drawPhong_multi_mrt,
 			demoState->prog_drawPhong_multi_shadow_mrt,
-		}
+			demoMode->batchSceneProgram ? demoMode->batchSceneProgram
+				: demoMode->cascadeProgram ? demoMode->cascadeProgram : demoState->prog_drawPhong_multi_shadow_mrt,
+		},
+		{
+			demoMode->batchSceneProgram ? demoMode->batchSceneProgram : demoState->prog_drawGBuffer_packed,
+			demoMode->batchSceneProgram ? demoMode->batchSceneProgram : demoState->prog_drawGBuffer_packed,
+			demoMode->batchSceneProgram ? demoMode->batchSceneProgram : demoState->prog_drawGBuffer_packed,
+		},
 	};
 
 	// display shader programs
@@ -256,40 +598,49 @@ void a3pipelines_render(a3_DemoState const* demoState, a3_Demo_Pipelines const*
 		demoState->prog_drawTexture_outline,
 	};
 
-	// framebuffers to which to write based on pipeline mode
+	// scene framebuffer depends on g-buffer layout
+	const a3_Framebuffer* sceneFBO = demoMode->pipeline == pipelines_deferredPacked
+		? demoState->fbo_scene_gbuffer_packed : demoState->fbo_scene_c16d24s8_mrt;
+
+	// shadow framebuffer depends on whether cascades are rendered
+	const a3_Framebuffer* shadowFBO = demoMode->render == pipelines_renderPhongCascade
+		? demoState->fbo_shadowCascade_d32 : demoState->fbo_shadow_d32;
+
+	// framebuffers to which to write based on pipeline mode; composite and 
+	//	post-processing targets are transient, acquired from the pool in update
 	const a3_Framebuffer* writeFBO[pipelines_pass_max] = {
-		demoState->fbo_shadow_d32,
-		demoState->fbo_scene_c16d24s8_mrt,
-		demoState->fbo_composite_c16 + 1,
-		demoState->fbo_composite_c16 + 2,
-		demoState->fbo_post_c16_2fr + 0,
-		demoState->fbo_post_c16_2fr + 1,
-		demoState->fbo_post_c16_2fr + 2,
-		demoState->fbo_post_c16_4fr + 0,
-		demoState->fbo_post_c16_4fr + 1,
-		demoState->fbo_post_c16_4fr + 2,
-		demoState->fbo_post_c16_8fr + 0,
-		demoState->fbo_post_c16_8fr + 1,
-		demoState->fbo_post_c16_8fr + 2,
-		demoState->fbo_composite_c16 + 0,
+		shadowFBO,
+		sceneFBO,
+		demoMode->transientFBO[pipelines_passLighting],
+		demoMode->transientFBO[pipelines_passComposite],
+		demoMode->transientFBO[pipelines_passBright_2],
+		demoMode->transientFBO[pipelines_passBlurH_2],
+		demoMode->transientFBO[pipelines_passBlurV_2],
+		demoMode->transientFBO[pipelines_passBright_4],
+		demoMode->transientFBO[pipelines_passBlurH_4],
+		demoMode->transientFBO[pipelines_passBlurV_4],
+		demoMode->transientFBO[pipelines_passBright_8],
+		demoMode->transientFBO[pipelines_passBlurH_8],
+		demoMode->transientFBO[pipelines_passBlurV_8],
+		demoMode->transientFBO[pipelines_passBlend],
 	};
 
 	// framebuffers from which to read based on pipeline mode
 	const a3_Framebuffer* readFBO[pipelines_pass_max][4] = {
 		{ 0, },
-		{ 0, demoState->fbo_shadow_d32, 0, },
-		{ demoState->fbo_scene_c16d24s8_mrt, 0, },
-		{ demoState->fbo_scene_c16d24s8_mrt, demoState->fbo_composite_c16 + 1, 0, },
-		{ demoState->fbo_composite_c16 + 2, 0, },
-		{ demoState->fbo_post_c16_2fr + 0, 0, },
-		{ demoState->fbo_post_c16_2fr + 1, 0, },
-		{ demoState->fbo_post_c16_2fr + 2, 0, },
-		{ demoState->fbo_post_c16_4fr + 0, 0, },
-		{ demoState->fbo_post_c16_4fr + 1, 0, },
-		{ demoState->fbo_post_c16_4fr + 2, 0, },
-		{ demoState->fbo_post_c16_8fr + 0, 0, },
-		{ demoState->fbo_post_c16_8fr + 1, 0, },
-		{ demoState->fbo_post_c16_8fr + 2, demoState->fbo_post_c16_4fr + 2, demoState->fbo_post_c16_2fr + 2, demoState->fbo_composite_c16 + 2, },
+		{ 0, shadowFBO, 0, },
+		{ sceneFBO, 0, },
+		{ sceneFBO, demoMode->transientFBO[pipelines_passLighting], 0, },
+		{ demoMode->transientFBO[pipelines_passComposite], 0, },
+		{ demoMode->transientFBO[pipelines_passBright_2], 0, },
+		{ demoMode->transientFBO[pipelines_passBlurH_2], 0, },
+		{ demoMode->transientFBO[pipelines_passBlurV_2], 0, },
+		{ demoMode->transientFBO[pipelines_passBright_4], 0, },
+		{ demoMode->transientFBO[pipelines_passBlurH_4], 0, },
+		{ demoMode->transientFBO[pipelines_passBlurV_4], 0, },
+		{ demoMode->transientFBO[pipelines_passBright_8], 0, },
+		{ demoMode->transientFBO[pipelines_passBlurH_8], 0, },
+		{ demoMode->transientFBO[pipelines_passBlurV_8], demoMode->transientFBO[pipelines_passBlurV_4], demoMode->transientFBO[pipelines_passBlurV_2], demoMode->transientFBO[pipelines_passComposite], },
 	};
 
 	// target info
@@ -306,6 +657,15 @@ void a3pipelines_render(a3_DemoState const* demoState, a3_Demo_Pipelines const*
 	a3vec4 lightPos[demoStateMaxCount_lightObject];
 	a3vec4 lightCol[demoStateMaxCount_lightObject];
 
+	// tmp shadow cascade data
+	a3mat4 shadowCascadeMat[a3demo_shadowCascadeMax];
+	a3real modelRadius;
+
+	// scene objects in view of the camera and of the shadow caster, and 
+	//	models drawn by the current pass
+	a3boolean visibleCamera[demoStateMaxCount_sceneObject], visibleShadow[demoStateMaxCount_sceneObject];
+	a3boolean include[demoStateMaxCount_sceneObject];
+
 
 	// pixel size and effect axis
 	a3vec2 pixelSize = a3vec2_one;
@@ -344,6 +704,14 @@ void a3pipelines_render(a3_DemoState const* demoState, a3_Demo_Pipelines const*
 	//a3real4x4ConcatL(projectionBiasMat_inv.m, unbias.m);
 	a3real4x4Product(projectionBiasMat.m, bias.m, activeCamera->projectionMat.m);
 	a3real4x4Product(projectionBiasMat_inv.m, activeCamera->projectionMatInv.m, unbias.m);
+	a3pipelines_cullSceneObjects_internal(demoState, viewProjectionMat.m, visibleCamera);
+	a3pipelines_cullSceneObjects_internal(demoState, (a3real(*)[4])activeShadowCaster->viewProjectionMat.m, visibleShadow);
+
+	// the camera also skips models hidden behind the scene (shadows are 
+	//	cast from elsewhere, so the shadow pass cannot)
+	if (demoMode->occlusion)
+		for (i = 0; i < demoStateMaxCount_sceneObject; ++i)
+			visibleCamera[i] = visibleCamera[i] && demoState->sceneObjectUnoccluded[i];
 
 
 	//-------------------------------------------------------------------------
@@ -364,8 +732,6 @@ void a3pipelines_render(a3_DemoState const* demoState, a3_Demo_Pipelines const*
 
 	// draw objects inverted
 	glCullFace(GL_FRONT);
-	currentDemoProgram = demoState->prog_transform;
-	a3shaderProgramActivate(currentDemoProgram->program);
 
 	/* // Original Dan Loop // 
 		for (k = 0,
@@ -375,14 +741,31 @@ void a3pipelines_render(a3_DemoState const* demoState, a3_Demo_Pipelines const*
 		a3demo_drawModelSimple_activateModel(modelViewProjectionMat.m, activeShadowCaster->viewProjectionMat.m, currentSceneObject->modelMat.m, currentDemoProgram, drawable[k]);
 	*/
 
-	//changed this loop - JAKE
-	// This loop works fine - Connor
-	for (k = 0; k < modelCount; ++k)
+	if (render == pipelines_renderPhongCascade)
 	{
-		//a3real4* mat[4] = models[k].obj->modelMat.m;
-		//mat = (models[k]).pos.x;
-
-		a3demo_drawModelSimple_activateModel(modelViewProjectionMat.m, activeShadowCaster->viewProjectionMat.m, models[k].obj->modelMat.m, currentDemoProgram, models[k].mesh);
+		// cascades: one atlas tile each, drawing only models that overlap
+		//	-> depth clamp keeps casters in front of the near plane
+		glEnable(GL_DEPTH_CLAMP);
+		for (i = 0, j = currentWriteFBO->frameWidth / a3demo_shadowCascadeAtlasTiles;
+			i < activeShadowCaster->cascadeCount; ++i)
+		{
+			glViewport((i % a3demo_shadowCascadeAtlasTiles) * j, (i / a3demo_shadowCascadeAtlasTiles) * j, j, j);
+			for (k = 0; k < modelCount; ++k)
+			{
+				// scale radius by largest axis scale
+				modelRadius = a3maximum(a3real3Length(models[k].obj->modelMat.m[0]), a3real3Length(models[k].obj->modelMat.m[1]));
+				modelRadius = a3maximum(modelRadius, a3real3Length(models[k].obj->modelMat.m[2])) * models[k].radius;
+				include[k] = a3demo_testProjectorShadowCascade(activeShadowCaster, i, models[k].obj->modelMat.m[3], modelRadius);
+			}
+			a3pipelines_drawModelsDepth_internal(demoState, demoMode, models, modelCount, include, activeShadowCaster->cascadeViewProjectionMat[i].m);
+		}
+		glDisable(GL_DEPTH_CLAMP);
+	}
+	else
+	{
+		for (k = 0; k < modelCount; ++k)
+			include[k] = visibleShadow[models[k].obj - demoState->sceneObject];
+		a3pipelines_drawModelsDepth_internal(demoState, demoMode, models, modelCount, include, activeShadowCaster->viewProjectionMat.m);
 	}
 		
 	glCullFace(GL_BACK);
@@ -403,6 +786,7 @@ void a3pipelines_render(a3_DemoState const* demoState, a3_Demo_Pipelines const*
 	{
 		// shading with MRT
 	case pipelines_forward:
+	case pipelines_deferredPacked:
 		// target scene framebuffer
 		a3demo_setSceneState(currentWriteFBO, demoState->displaySkybox);
 		break;
@@ -414,6 +798,19 @@ void a3pipelines_render(a3_DemoState const* demoState, a3_Demo_Pipelines const*
 	if (demoState->stencilTest)
 		a3demo_drawStencilTest(modelViewProjectionMat.m, viewProjectionMat.m, modelMat.m, demoState->prog_drawColorUnif, demoState->draw_sphere);
 
+	// optional depth prepass: visible models fill depth first without 
+	//	color, then each pixel is shaded once, by the surface whose depth 
+	//	matches; depth writes stay off until the models are drawn
+	for (k = 0; k < modelCount; ++k)
+		include[k] = visibleCamera[models[k].obj - demoState->sceneObject];
+	if (demoMode->depthPrepass)
+	{
+		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+		a3pipelines_drawModelsDepth_internal(demoState, demoMode, models, modelCount, include, viewProjectionMat.m);
+		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+		glDepthMask(GL_FALSE);
+	}
+
 
 	// copy temp light data
 	for (k = 0, pointLight = demoState->forwardPointLight;
@@ -454,7 +851,7 @@ void a3pipelines_render(a3_DemoState const* demoState, a3_Demo_Pipelines const*
 		// scene pass using forward pipeline
 	case pipelines_forward: {
 		// activate shadow map and other relevant textures
-		currentReadFBO = demoState->fbo_shadow_d32;
+		currentReadFBO = readFBO[pipelines_passScene][1];
 		a3framebufferBindDepthTexture(currentReadFBO, a3tex_unit06);
 		a3textureActivate(demoState->tex_earth_dm, a3tex_unit07);
 
@@ -465,20 +862,136 @@ void a3pipelines_render(a3_DemoState const* demoState, a3_Demo_Pipelines const*
 		a3shaderUniformSendFloat(a3unif_vec4, currentDemoProgram->uLightPos, demoState->forwardLightCount, lightPos->v);
 		a3shaderUniformSendFloat(a3unif_vec4, currentDemoProgram->uLightCol, demoState->forwardLightCount, lightCol->v);
 
+		// cascades: transform from view space straight to the atlas
+		if (render == pipelines_renderPhongCascade)
+		{
+			// uniform is a signed int
+			const a3i32 cascadeCount = (a3i32)activeShadowCaster->cascadeCount;
+			for (i = 0; i < activeShadowCaster->cascadeCount; ++i)
+				a3real4x4Product(shadowCascadeMat[i].m, activeShadowCaster->cascadeAtlasMat[i].m, activeCameraObject->modelMat.m);
+			a3shaderUniformSendInt(a3unif_single, currentDemoProgram->uCount, 1, &cascadeCount);
+			a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uShadowCascade, activeShadowCaster->cascadeCount, shadowCascadeMat->mm);
+			a3shaderUniformSendFloat(a3unif_vec4, currentDemoProgram->uShadowSplit, 1, activeShadowCaster->cascadeSplit);
+		}
+
 		// individual object requirements: 
 		//	- modelviewprojection
 		//	- modelview
 		//	- modelview for normals
 		//	- per-object animation data
-		for (k = 0; k < modelCount; k++)
+		//	-> batched, these are instance records instead of uniforms
+		if (currentDemoProgram == demoMode->batchSceneProgram)
+			a3pipelines_drawModelsBatched_internal(demoState, models, modelCount, include, viewProjectionMat.m, viewMat.m, rgba4 + 3);
+		else
+			for (k = 0; k < modelCount; k++)
+			{
+				if (!include[k])
+					continue;
+				a3textureActivate(models[k].texture->tex_dm, a3tex_unit00);
+				a3textureActivate(models[k].texture->tex_sm, a3tex_unit01);
+				a3demo_drawModelLighting_bias_other(modelViewProjectionBiasMat_other.m, modelViewProjectionMat.m, modelViewMat.m, viewProjectionBiasMat_other.m, viewProjectionMat.m, viewMat.m, models[k].obj->modelMat.m, currentDemoProgram, models[k].mesh, rgba4[k + 3].v);
+			}
+		glDepthMask(GL_TRUE);
+
+		// morphing teapots in a row behind the scene teapot: one instanced
+		//	call, deltas and per-instance weights come from storage buffers
+		//	-> instances are spaced along object X in the vertex shader
+		if (demoMode->morphTargets && demoState->morphTargets->targetCount)
+		{
+			const a3real morphScale = 0.25f;
+			const a3vec2 morphSpacing = { 16.0f, a3real_zero };
+
+			a3real4x4SetScale(modelMat.m, morphScale);
+			if (!demoState->verticalAxis)
+				a3real4x4ConcatL(modelMat.m, a3real4x4SetRotateX(modelViewMat.m, (a3real)90.0));
+			a3real3ProductS(modelMat.v3.v, demoState->teapotObject->position.v, a3real_two);
+			modelMat.m30 -= morphSpacing.x * morphScale * (a3real)(demoStateMaxCount_morphInstance - 1) * a3real_half;
+			a3real4x4Product(modelViewMat.m, viewMat.m, modelMat.m);
+
+			currentDemoProgram = demoState->prog_drawPhong_morph_instanced;
+			a3shaderProgramActivate(currentDemoProgram->program);
+			a3shaderUniformBufferActivate(demoState->ubo_pointLight, 4);
+			a3shaderUniformSendInt(a3unif_single, currentDemoProgram->uLightCt, 1, &demoState->forwardLightCount);
+			a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uP, 1, activeCamera->projectionMat.mm);
+			a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uAtlas, 1, a3mat4_identity.mm);
+			a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMV, 1, modelViewMat.mm);
+			a3demo_quickInvertTranspose_internal(modelViewMat.m);
+			a3real4SetReal4(modelViewMat.m[3], a3vec4_zero.v);
+			a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMV_nrm, 1, modelViewMat.mm);
+			a3shaderUniformSendFloat(a3unif_vec4, currentDemoProgram->uColor, 1, orange);
+			a3shaderUniformSendFloat(a3unif_vec2, currentDemoProgram->uSize, 1, morphSpacing.v);
+			a3textureActivate(demoState->tex_checker, a3tex_unit00);
+			a3textureActivate(demoState->tex_checker, a3tex_unit01);
+			a3morphTargetsRender(demoState->morphTargets, demoState->draw_teapot_morph, demoStateMaxCount_morphInstance);
+			modelMat = a3mat4_identity;
+		}
+
+		// skinned tentacles: one instanced call, each instance reads its 
+		//	character's palette from this frame's ring segment
+		//	-> tentacles are modeled along Z; characters are placed by root
+		if (demoState->skinPaletteOffset >= 0 && demoMode->skinProgram)
+		{
+			currentDemoProgram = demoMode->skinProgram;
+			if (demoState->verticalAxis)
+				a3real4x4SetRotateX(modelMat.m, -(a3real)90.0);
+			a3real4x4Product(modelViewMat.m, viewMat.m, modelMat.m);
+
+			a3shaderProgramActivate(currentDemoProgram->program);
+			a3shaderUniformBufferActivate(demoState->ubo_pointLight, 4);
+			a3shaderUniformSendInt(a3unif_single, currentDemoProgram->uLightCt, 1, &demoState->forwardLightCount);
+			a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uP, 1, activeCamera->projectionMat.mm);
+			a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uAtlas, 1, a3mat4_identity.mm);
+			a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMV, 1, modelViewMat.mm);
+			a3demo_quickInvertTranspose_internal(modelViewMat.m);
+			a3real4SetReal4(modelViewMat.m[3], a3vec4_zero.v);
+			a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMV_nrm, 1, modelViewMat.mm);
+			a3shaderUniformSendFloat(a3unif_vec4, currentDemoProgram->uColor, 1, demoMode->skinning == pipelines_skinDualQuat ? skyblue : green);
+			a3textureActivate(demoState->tex_checker, a3tex_unit00);
+			a3textureActivate(demoState->tex_checker, a3tex_unit01);
+			a3skinPaletteRingRender(demoState->skinPaletteRing, demoState->draw_tentacle_skin, demoState->skinPaletteOffset, demoState->skinPaletteSize,
+				demoState->skeleton->jointCount, demoStateMaxCount_skinCharacter);
+			modelMat = a3mat4_identity;
+		}
+
+		// particles after opaque objects: additive billboards, depth 
+		//	tested but not written; only the display color is touched
+		//	-> instance count comes from the GPU, never from here
+		if (demoMode->particles)
 		{
-			a3textureActivate(models[k].texture->tex_dm, a3tex_unit00);
-			a3textureActivate(models[k].texture->tex_sm, a3tex_unit01);
-			a3demo_drawModelLighting_bias_other(modelViewProjectionBiasMat_other.m, modelViewProjectionMat.m, modelViewMat.m, viewProjectionBiasMat_other.m, viewProjectionMat.m, viewMat.m, models[k].obj->modelMat.m, currentDemoProgram, models[k].mesh, rgba4[k + 3].v);
+			currentDemoProgram = demoState->prog_drawParticle_instanced;
+			a3shaderProgramActivate(currentDemoProgram->program);
+			a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMV, 1, viewMat.mm);
+			a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uP, 1, activeCamera->projectionMat.mm);
+			for (i = 1; i < currentWriteFBO->color; ++i)
+				glColorMaski(i, GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+			a3demo_enableAdditiveBlending();
+			glDepthMask(GL_FALSE);
+			a3particleSystemRender(demoState->particleSystem, demoState->draw_unitquad);
+			glDepthMask(GL_TRUE);
+			glDisable(GL_BLEND);
+			glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 		}
 	}	break;
 		// end forward scene pass
 
+		// scene pass writing packed g-buffers
+	case pipelines_deferredPacked: {
+		// attributes only; lighting happens in composite
+		if (currentDemoProgram == demoMode->batchSceneProgram)
+			a3pipelines_drawModelsBatched_internal(demoState, models, modelCount, include, viewProjectionMat.m, viewMat.m, rgba4 + 3);
+		else
+			for (k = 0; k < modelCount; k++)
+			{
+				if (!include[k])
+					continue;
+				a3textureActivate(models[k].texture->tex_dm, a3tex_unit00);
+				a3textureActivate(models[k].texture->tex_sm, a3tex_unit01);
+				a3demo_drawModelLighting(modelViewProjectionMat.m, modelViewMat.m, viewProjectionMat.m, viewMat.m, models[k].obj->modelMat.m, currentDemoProgram, models[k].mesh, rgba4[k + 3].v);
+			}
+		glDepthMask(GL_TRUE);
+	}	break;
+		// end packed scene pass
+
 		/*
 		// scene pass using deferred shading
 	case pipelines_deferred_shading: {
@@ -542,6 +1055,11 @@ void a3pipelines_render(a3_DemoState const* demoState, a3_Demo_Pipelines const*
 	if (demoState->stencilTest)
 		glDisable(GL_STENCIL_TEST);
 
+	// reduce the finished scene depth into the occlusion pyramid; next 
+	//	frame's update tests against it
+	if (demoMode->occlusion && demoState->occlusionCuller->bounds)
+		a3occlusionCullerBuildPyramid(demoState->occlusionCuller, demoState->prog_hizReduce_compute->program, sceneFBO);
+
 
 	//-------------------------------------------------------------------------
 	// COMPOSITE PASS
@@ -572,6 +1090,24 @@ void a3pipelines_render(a3_DemoState const* demoState, a3_Demo_Pipelines const*
 		currentReadFBO = readFBO[currentPass][0];
 		a3framebufferBindColorTexture(currentReadFBO, a3tex_unit00, 0);
 		break;
+	case pipelines_deferredPacked:
+		// light packed g-buffers; empty pixels are discarded
+		currentDemoProgram = demoState->prog_drawPhong_multi_deferred_packed;
+		a3shaderProgramActivate(currentDemoProgram->program);
+		// scene (g-buffers)
+		currentReadFBO = readFBO[currentPass][0];
+		a3framebufferBindDepthTexture(currentReadFBO, a3tex_unit00);
+		a3framebufferBindColorTexture(currentReadFBO, a3tex_unit01, pipelines_scene_packed_albedoSpecular);
+		a3framebufferBindColorTexture(currentReadFBO, a3tex_unit02, pipelines_scene_packed_normal);
+		// uniforms
+		a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uPB_inv, 1, projectionBiasMat_inv.mm);
+		a3shaderUniformSendFloat(a3unif_vec4, currentDemoProgram->uColor, 1, skyblue);
+		a3shaderUniformSendInt(a3unif_single, currentDemoProgram->uLightCt, 1, &demoState->forwardLightCount);
+		a3shaderUniformSendFloat(a3unif_single, currentDemoProgram->uLightSz, demoState->forwardLightCount, lightSz);
+		a3shaderUniformSendFloat(a3unif_single, currentDemoProgram->uLightSzInvSq, demoState->forwardLightCount, lightSzInvSq);
+		a3shaderUniformSendFloat(a3unif_vec4, currentDemoProgram->uLightPos, demoState->forwardLightCount, lightPos->v);
+		a3shaderUniformSendFloat(a3unif_vec4, currentDemoProgram->uLightCol, demoState->forwardLightCount, lightCol->v);
+		break;
 	/*
 	case pipelines_deferred_shading:
 		// use deferred shading program
@@ -647,115 +1183,11 @@ void a3pipelines_render(a3_DemoState const* demoState, a3_Demo_Pipelines const*
 	//	-> the blur passes iteratively flood the brightest areas over the 
 	//		image; composite with original scene to mix detail with light
 
-	// bright-pass half-size
-	currentDemoProgram = demoState->prog_drawTexture_brightPass;
-	a3shaderProgramActivate(currentDemoProgram->program);
-
-	currentPass = pipelines_passBright_2;
-	currentWriteFBO = writeFBO[currentPass];
-	currentReadFBO = readFBO[currentPass][0];
-	a3framebufferActivate(currentWriteFBO);
-	a3framebufferBindColorTexture(currentReadFBO, a3tex_unit00, 0);
-	a3vertexDrawableRenderActive();
-
-	// blur half-size
-	currentDemoProgram = demoState->prog_drawTexture_blurGaussian;
-	a3shaderProgramActivate(currentDemoProgram->program);
-	a3real2Set(pixelSize.v, a3recip((a3real)currentWriteFBO->frameWidth), a3recip((a3real)currentWriteFBO->frameHeight));
-	a3shaderUniformSendFloat(a3unif_vec2, currentDemoProgram->uSize, 1, pixelSize.v);
-
-	currentPass = pipelines_passBlurH_2;
-	currentWriteFBO = writeFBO[currentPass];
-	currentReadFBO = readFBO[currentPass][0];
-	a3framebufferActivate(currentWriteFBO);
-	a3framebufferBindColorTexture(currentReadFBO, a3tex_unit00, 0);
-	a3shaderUniformSendFloat(a3unif_vec2, currentDemoProgram->uAxis, 1, sampleAxisH.v);
-	a3vertexDrawableRenderActive();
-
-	currentPass = pipelines_passBlurV_2;
-	currentWriteFBO = writeFBO[currentPass];
-	currentReadFBO = readFBO[currentPass][0];
-	a3framebufferActivate(currentWriteFBO);
-	a3framebufferBindColorTexture(currentReadFBO, a3tex_unit00, 0);
-	a3shaderUniformSendFloat(a3unif_vec2, currentDemoProgram->uAxis, 1, sampleAxisV.v);
-	a3vertexDrawableRenderActive();
-
-	// bright-pass quarter-size
-	currentDemoProgram = demoState->prog_drawTexture_brightPass;
-	a3shaderProgramActivate(currentDemoProgram->program);
-
-	currentPass = pipelines_passBright_4;
-	currentWriteFBO = writeFBO[currentPass];
-	currentReadFBO = readFBO[currentPass][0];
-	a3framebufferActivate(currentWriteFBO);
-	a3framebufferBindColorTexture(currentReadFBO, a3tex_unit00, 0);
-	a3vertexDrawableRenderActive();
-
-	// blur quarter-size
-	currentDemoProgram = demoState->prog_drawTexture_blurGaussian;
-	a3shaderProgramActivate(currentDemoProgram->program);
-	a3real2Set(pixelSize.v, a3recip((a3real)currentWriteFBO->frameWidth), a3recip((a3real)currentWriteFBO->frameHeight));
-	a3shaderUniformSendFloat(a3unif_vec2, currentDemoProgram->uSize, 1, pixelSize.v);
-
-	currentPass = pipelines_passBlurH_4;
-	currentWriteFBO = writeFBO[currentPass];
-	currentReadFBO = readFBO[currentPass][0];
-	a3framebufferActivate(currentWriteFBO);
-	a3framebufferBindColorTexture(currentReadFBO, a3tex_unit00, 0);
-	a3shaderUniformSendFloat(a3unif_vec2, currentDemoProgram->uAxis, 1, sampleAxisH.v);
-	a3vertexDrawableRenderActive();
-
-	currentPass = pipelines_passBlurV_4;
-	currentWriteFBO = writeFBO[currentPass];
-	currentReadFBO = readFBO[currentPass][0];
-	a3framebufferActivate(currentWriteFBO);
-	a3framebufferBindColorTexture(currentReadFBO, a3tex_unit00, 0);
-	a3shaderUniformSendFloat(a3unif_vec2, currentDemoProgram->uAxis, 1, sampleAxisV.v);
-	a3vertexDrawableRenderActive();
-
-	// bright-pass eighth-size
-	currentDemoProgram = demoState->prog_drawTexture_brightPass;
-	a3shaderProgramActivate(currentDemoProgram->program);
-
-	currentPass = pipelines_passBright_8;
-	currentWriteFBO = writeFBO[currentPass];
-	currentReadFBO = readFBO[currentPass][0];
-	a3framebufferActivate(currentWriteFBO);
-	a3framebufferBindColorTexture(currentReadFBO, a3tex_unit00, 0);
-	a3vertexDrawableRenderActive();
-
-	// blur eighth-size
-	currentDemoProgram = demoState->prog_drawTexture_blurGaussian;
-	a3shaderProgramActivate(currentDemoProgram->program);
-	a3real2Set(pixelSize.v, a3recip((a3real)currentWriteFBO->frameWidth), a3recip((a3real)currentWriteFBO->frameHeight));
-	a3shaderUniformSendFloat(a3unif_vec2, currentDemoProgram->uSize, 1, pixelSize.v);
-
-	currentPass = pipelines_passBlurH_8;
-	currentWriteFBO = writeFBO[currentPass];
-	currentReadFBO = readFBO[currentPass][0];
-	a3framebufferActivate(currentWriteFBO);
-	a3framebufferBindColorTexture(currentReadFBO, a3tex_unit00, 0);
-	a3shaderUniformSendFloat(a3unif_vec2, currentDemoProgram->uAxis, 1, sampleAxisH.v);
-	a3vertexDrawableRenderActive();
-
-	currentPass = pipelines_passBlurV_8;
-	currentWriteFBO = writeFBO[currentPass];
-	currentReadFBO = readFBO[currentPass][0];
-	a3framebufferActivate(currentWriteFBO);
-	a3framebufferBindColorTexture(currentReadFBO, a3tex_unit00, 0);
-	a3shaderUniformSendFloat(a3unif_vec2, currentDemoProgram->uAxis, 1, sampleAxisV.v);
-	a3vertexDrawableRenderActive();
-
-	// bloom composite
-	currentDemoProgram = demoState->prog_drawTexture_blendScreen4;
-	a3shaderProgramActivate(currentDemoProgram->program);
-
-	currentPass = pipelines_passBlend;
-	currentWriteFBO = writeFBO[currentPass];
-	a3framebufferActivate(currentWriteFBO);
-	for (i = 0, j = 4; i < j; ++i)
-		a3framebufferBindColorTexture(readFBO[currentPass][i], a3tex_unit00 + i, 0);
-	a3vertexDrawableRenderActive();
+	// compute path dispatches the same passes; fall back to fragment 
+	//	passes if selected or unavailable
+	if (demoMode->bloom != pipelines_bloomCompute ||
+		!a3pipelines_renderBloomCompute_internal(demoState, writeFBO, readFBO, sampleAxisH, sampleAxisV))
+		a3pipelines_renderBloomFragment_internal(demoState, writeFBO, readFBO, sampleAxisH, sampleAxisV);
 
 
 	//-------------------------------------------------------------------------
@@ -851,7 +1283,7 @@ void a3pipelines_render(a3_DemoState const* demoState, a3_Demo_Pipelines const*
 	if (demoState->displayGrid || demoState->displayTangentBases)
 	{
 		// activate scene FBO and clear color; reuse depth
-		currentWriteFBO = demoState->fbo_scene_c16d24s8_mrt;
+		currentWriteFBO = sceneFBO;
 		a3framebufferActivate(currentWriteFBO);
 		glDisable(GL_STENCIL_TEST);
 		glClear(GL_COLOR_BUFFER_BIT);
@@ -939,4 +1371,784 @@ void a3pipelines_render(a3_DemoState const* demoState, a3_Demo_Pipelines const*
 }
 
 
+//-----------------------------------------------------------------------------
+
+// storage size of one pixel across all targets of a framebuffer, as 
+//	reported by the driver
+inline a3ui32 a3pipelines_getPixelSize_internal(a3_Framebuffer const* fbo)
+{
+#ifdef _WIN32
+	const a3ui32 sizeQuery[] = {
+		GL_TEXTURE_RED_SIZE, GL_TEXTURE_GREEN_SIZE, GL_TEXTURE_BLUE_SIZE, GL_TEXTURE_ALPHA_SIZE,
+		GL_TEXTURE_DEPTH_SIZE, GL_TEXTURE_STENCIL_SIZE,
+	};
+	a3ui32 i, j, bits = 0;
+	a3i32 size;
+	for (i = 0; i <= fbo->color; ++i)
+	{
+		if (i < fbo->color)
+			a3framebufferBindColorTexture(fbo, a3tex_unit00, i);
+		else if (fbo->depthStencil)
+			a3framebufferBindDepthTexture(fbo, a3tex_unit00);
+		else
+			break;
+		for (j = 0; j < sizeof(sizeQuery) / sizeof(*sizeQuery); ++j)
+		{
+			glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, sizeQuery[j], &size);
+			bits += size;
+		}
+	}
+	a3textureDeactivate(a3tex_unit00);
+	return (bits + 7) / 8;
+#else	// !_WIN32
+	return 0;
+#endif	// _WIN32
+}
+
+
+// compare scene g-buffer layouts: fill every target of each with a 
+//	full-frame quad many times and time it on the GPU (console output)
+//	-> no lights are sent, so fill bandwidth dominates shading
+void a3pipelines_benchmarkGBuffer(a3_DemoState const* demoState)
+{
+#ifdef _WIN32
+	const a3_Framebuffer* layoutFBO[] = {
+		demoState->fbo_scene_c16d24s8_mrt,
+		demoState->fbo_scene_gbuffer_packed,
+	};
+	const a3_DemoStateShaderProgram* layoutProgram[] = {
+		demoState->prog_drawPhong_multi_mrt,
+		demoState->prog_drawGBuffer_packed,
+	};
+	const a3byte* layoutName[] = {
+		"forward MRT (8 x rgba16, d24s8)",
+		"packed (rgba8 + rg16, d24s8)",
+	};
+	const a3ui32 layoutCount = sizeof(layoutFBO) / sizeof(*layoutFBO);
+	const a3ui32 fillCount = 64;
+	const a3i32 lightCount = 0;
+
+	const a3_Framebuffer* fbo;
+	const a3_DemoStateShaderProgram* currentDemoProgram;
+	a3ui32 query, i, j, pixelSize;
+	GLuint64 elapsed;
+	a3f64 fillTime, fillSize;
+
+	// timer queries are core since GL 3.3
+	if (!glGenQueries || !glBeginQuery || !glGetQueryObjectui64v)
+		return;
+	glGenQueries(1, &query);
+
+	printf("\n\n A3 g-buffer layout benchmark (%u full-frame fills each): ", fillCount);
+	a3vertexDrawableActivate(demoState->draw_unitquad);
+	for (i = 0; i < layoutCount; ++i)
+	{
+		fbo = layoutFBO[i];
+		pixelSize = a3pipelines_getPixelSize_internal(fbo);
+
+		// every fill writes color and depth
+		a3framebufferActivate(fbo);
+		glDisable(GL_STENCIL_TEST);
+		glDisable(GL_BLEND);
+		glDepthFunc(GL_ALWAYS);
+
+		currentDemoProgram = layoutProgram[i];
+		a3shaderProgramActivate(currentDemoProgram->program);
+		a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMVP, 1, a3mat4_identity.mm);
+		a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMV, 1, a3mat4_identity.mm);
+		a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMV_nrm, 1, a3mat4_identity.mm);
+		a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uAtlas, 1, a3mat4_identity.mm);
+		a3shaderUniformSendInt(a3unif_single, currentDemoProgram->uLightCt, 1, &lightCount);
+		a3textureActivate(demoState->tex_checker, a3tex_unit00);
+		a3textureActivate(demoState->tex_checker, a3tex_unit01);
+
+		// warm up, then time the batch
+		a3vertexDrawableRenderActive();
+		glFinish();
+		glBeginQuery(GL_TIME_ELAPSED, query);
+		for (j = 0; j < fillCount; ++j)
+			a3vertexDrawableRenderActive();
+		glEndQuery(GL_TIME_ELAPSED);
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+
+		fillTime = (a3f64)elapsed * 1.0e-9 / (a3f64)fillCount;
+		fillSize = (a3f64)pixelSize * (a3f64)fbo->frameWidth * (a3f64)fbo->frameHeight;
+		printf("\n\t %-36s %3u B/px %7.1lf MB/fill %8.3lf ms/fill (%6.1lf GB/s)", layoutName[i],
+			pixelSize, fillSize * 1.0e-6, fillTime * 1000.0, fillSize / fillTime * 1.0e-9);
+	}
+	printf("\n");
+
+	// done; scene targets are rewritten next frame
+	glDepthFunc(GL_LEQUAL);
+	glDeleteQueries(1, &query);
+	a3shaderProgramDeactivate();
+	a3vertexDrawableDeactivate();
+	a3framebufferDeactivate();
+#endif	// _WIN32
+}
+
+
+// scale GPU particles from a thousand to a million: a burst fills the pool, 
+//	then a second of updates (with deaths and emission) is timed on the GPU 
+//	and repeated by the CPU reference; results are compared by live count 
+//	and sums, since compaction order on the GPU is not deterministic 
+//	(console output)
+void a3pipelines_benchmarkParticles(a3_DemoState const* demoState)
+{
+#ifdef _WIN32
+	const a3ui32 particleCount[] = { 1024, 16 * 1024, 256 * 1024, demoStateMaxCount_particleBenchmark };
+	const a3ui32 sizeCount = sizeof(particleCount) / sizeof(*particleCount);
+	const a3f32 dt = 1.0f / 60.0f;
+	enum { frameCount = 60 };
+
+	a3_ParticleSystem system[1] = { 0 };
+	a3_ParticleEmitter emitter[1];
+	a3_Particle* particleCPU, * particleGPU;
+	a3ui32 emitIndex[frameCount], emitCount[frameCount];
+	a3ui32 query, capacity, i, j, k;
+	a3i32 countCPU, countGPU;
+	a3_Timer timer[1] = { 0 };
+	GLuint64 elapsed;
+	a3f64 timeGPU, timeCPU, sumGPU, sumCPU, diff, error;
+
+	// timer queries are core since GL 3.3
+	if (!glGenQueries || !glBeginQuery || !glGetQueryObjectui64v)
+		return;
+	glGenQueries(1, &query);
+
+	printf("\n\n A3 GPU particle benchmark (%u updates each, simulate + emit + compact): ", frameCount);
+	for (i = 0; i < sizeCount; ++i)
+	{
+		// pool fits the burst plus everything emitted after it
+		capacity = particleCount[i] + particleCount[i] / 2;
+		if (a3particleSystemCreate(system, "ssbo:particles-bench", capacity, demoState->draw_unitquad) <= 0)
+		{
+			printf("\n\t particle system not supported");
+			break;
+		}
+		particleCPU = (a3_Particle*)malloc(capacity * sizeof(a3_Particle));
+		particleGPU = (a3_Particle*)malloc(capacity * sizeof(a3_Particle));
+
+		// short lives so that particles die and compaction does work
+		*emitter = *demoState->particleEmitter;
+		emitter->life[0] = 1.0f;
+		emitter->life[1] = 0.5f;
+
+		// burst: fill the pool in one update (not timed)
+		emitter->rate = (a3f32)particleCount[i] / dt;
+		emitIndex[0] = system->emitted;
+		emitCount[0] = a3particleSystemUpdate(system, demoState->prog_particleSimulate_compute->program,
+			demoState->prog_particleEmit_compute->program, demoState->prog_particleFinalize_compute->program, emitter, dt);
+		glFinish();
+
+		// steady state: a quarter of the burst per second
+		emitter->rate = (a3f32)particleCount[i] * 0.25f;
+		glBeginQuery(GL_TIME_ELAPSED, query);
+		for (j = 1; j < frameCount; ++j)
+		{
+			emitIndex[j] = system->emitted;
+			emitCount[j] = a3particleSystemUpdate(system, demoState->prog_particleSimulate_compute->program,
+				demoState->prog_particleEmit_compute->program, demoState->prog_particleFinalize_compute->program, emitter, dt);
+		}
+		glEndQuery(GL_TIME_ELAPSED);
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+		timeGPU = (a3f64)elapsed * 1.0e-9 / (a3f64)(frameCount - 1);
+		countGPU = a3particleSystemReadback(system, particleGPU);
+
+		// same updates on the CPU, burst included
+		countCPU = a3particleSimulateReference(particleCPU, 0, capacity, emitter, emitIndex[0], emitCount[0], dt);
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		for (j = 1; j < frameCount; ++j)
+			countCPU = a3particleSimulateReference(particleCPU, countCPU, capacity, emitter, emitIndex[j], emitCount[j], dt);
+		a3timerUpdate(timer);
+		timeCPU = timer->totalTime / (a3f64)(frameCount - 1);
+
+		// order-independent comparison: mean position and life
+		for (k = 0, error = 0.0; k < 4 && countGPU == countCPU && countCPU > 0; ++k)
+		{
+			for (j = 0, sumGPU = sumCPU = 0.0; j < (a3ui32)countCPU; ++j)
+			{
+				sumGPU += particleGPU[j].position[k];
+				sumCPU += particleCPU[j].position[k];
+			}
+			diff = (sumGPU - sumCPU) / (a3f64)countCPU;
+			if (diff < 0.0)
+				diff = -diff;
+			if (error < diff)
+				error = diff;
+		}
+
+		printf("\n\t %8u: GPU %8.3lf ms | CPU %8.3lf ms (x%6.1lf) | alive %8d / %8d | mean error %.2e %s",
+			particleCount[i], timeGPU * 1000.0, timeCPU * 1000.0, timeCPU / timeGPU,
+			countGPU, countCPU, error, (countGPU == countCPU && error < 1.0e-3) ? "PASS" : "FAIL");
+
+		free(particleGPU);
+		free(particleCPU);
+		a3particleSystemRelease(system);
+	}
+	printf("\n");
+
+	glDeleteQueries(1, &query);
+	a3shaderProgramDeactivate();
+#endif	// _WIN32
+}
+
+
+// compare morph blending: the instanced vertex shader (rasterizer
+//	discarded so only vertex work is timed) against the CPU fallback on
+//	one to eight threads, each blending every instance's weights; thread
+//	results are checked against the single-threaded blend (console output)
+void a3pipelines_benchmarkMorphTargets(a3_DemoState const* demoState)
+{
+#ifdef _WIN32
+	const a3ui32 threadCount[] = { 1, 2, 4, 8 };
+	const a3ui32 threadCountCount = sizeof(threadCount) / sizeof(*threadCount);
+	enum { frameCount = 60 };
+
+	a3_MorphTargetData const* data = demoState->morphTargetData;
+	a3_MorphTargets const* morph = demoState->morphTargets;
+	a3f32(*position)[3], (*normal)[3], (*positionRef)[3];
+	a3ui32 query, i, j, k;
+	a3_Timer timer[1] = { 0 };
+	GLuint64 elapsed;
+	a3f64 timeGPU, timeCPU, timeRef, diff, error;
+
+	if (!data->deltaCount || !morph->targetCount)
+		return;
+	if (!glGenQueries || !glBeginQuery || !glGetQueryObjectui64v)
+		return;
+	glGenQueries(1, &query);
+
+	printf("\n\n A3 morph target benchmark (%u vertices, %u targets, %u instances, %u frames): ",
+		data->vertexCount, data->targetCount, demoStateMaxCount_morphInstance, frameCount);
+	printf("\n\t storage: %u sparse deltas (%u bytes) vs %u dense (%u bytes as floats)",
+		data->deltaCount, data->deltaCount * (a3ui32)sizeof(a3_MorphDelta),
+		data->vertexCount * data->targetCount, data->vertexCount * data->targetCount * 6 * (a3ui32)sizeof(a3f32));
+
+	// GPU: weights are already resident from the last update
+	a3shaderProgramActivate(demoState->prog_drawPhong_morph_instanced->program);
+	glEnable(GL_RASTERIZER_DISCARD);
+	a3morphTargetsRender(morph, demoState->draw_teapot_morph, demoStateMaxCount_morphInstance);
+	glFinish();
+	glBeginQuery(GL_TIME_ELAPSED, query);
+	for (j = 0; j < frameCount; ++j)
+		a3morphTargetsRender(morph, demoState->draw_teapot_morph, demoStateMaxCount_morphInstance);
+	glEndQuery(GL_TIME_ELAPSED);
+	glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+	glDisable(GL_RASTERIZER_DISCARD);
+	timeGPU = (a3f64)elapsed * 1.0e-9 / (a3f64)frameCount;
+	printf("\n\t GPU instanced:   %8.3lf ms", timeGPU * 1000.0);
+
+	// CPU: blend every instance per frame into the same output
+	position = (a3f32(*)[3])malloc(data->vertexCount * sizeof(*position) * 3);
+	normal = position + data->vertexCount;
+	positionRef = normal + data->vertexCount;
+	for (i = 0, timeRef = 0.0; i < threadCountCount; ++i)
+	{
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		for (j = 0; j < frameCount; ++j)
+			for (k = 0; k < demoStateMaxCount_morphInstance; ++k)
+				if (threadCount[i] > 1)
+					a3morphTargetDataBlendParallel(data, demoState->morphWeight + k * data->targetCount, position, normal, threadCount[i]);
+				else
+					a3morphTargetDataBlend(data, demoState->morphWeight + k * data->targetCount, position, normal, 0, data->vertexCount);
+		a3timerUpdate(timer);
+		timeCPU = timer->totalTime / (a3f64)frameCount;
+
+		// last instance's blend is the reference for the threaded runs
+		if (i == 0)
+		{
+			timeRef = timeCPU;
+			memcpy(positionRef, position, data->vertexCount * sizeof(*position));
+		}
+		for (k = 0, error = 0.0; k < data->vertexCount * 3; ++k)
+		{
+			diff = (a3f64)(position[k / 3][k % 3] - positionRef[k / 3][k % 3]);
+			if (diff < 0.0)
+				diff = -diff;
+			if (error < diff)
+				error = diff;
+		}
+
+		printf("\n\t CPU %u thread(s): %8.3lf ms (x%6.2lf vs 1, x%6.1lf vs GPU) | max error %.2e %s",
+			threadCount[i], timeCPU * 1000.0, timeRef / timeCPU, timeCPU / timeGPU,
+			error, error == 0.0 ? "PASS" : "FAIL");
+	}
+	printf("\n");
+
+	free(position);
+	glDeleteQueries(1, &query);
+	a3shaderProgramDeactivate();
+#endif	// _WIN32
+}
+
+
+
+// scale skinned characters: for each character count, solve every
+//	palette on the CPU, draw all characters with the current skinning
+//	variant (rasterizer discarded so only vertex work is timed) from a
+//	temporary palette ring, and skin every character on the CPU with both
+//	methods; the largest distance between the two shows how far linear
+//	blending collapses under twist (console output)
+void a3pipelines_benchmarkSkinning(a3_DemoState const* demoState, a3_Demo_Pipelines const* demoMode)
+{
+#ifdef _WIN32
+	const a3ui32 characterCount[] = { 1, 16, 256, 1024, demoStateMaxCount_skinCharacterBenchmark };
+	const a3ui32 characterCountCount = sizeof(characterCount) / sizeof(*characterCount);
+	enum { frameCount = 60 };
+
+	a3_Skeleton const* skeleton = demoState->skeleton;
+	const a3ui32 jointCount = skeleton->jointCount, vertexCount = demoState->skinVertexCount;
+	const a3_SkinningMethod method = demoMode->skinning == pipelines_skinDualQuat ? a3skin_dualQuat : a3skin_linear;
+	a3_SkinPaletteRing ring[1] = { 0 };
+	a3mat4 localPose[a3skin_jointMax], root = a3mat4_identity, rotate;
+	a3f32(*palette)[4], (*paletteLinear)[4], (*paletteDualQuat)[4], (*position)[3], (*normal)[3], (*positionRef)[3];
+	a3ui32 query, paletteSize, i, j, k, c;
+	a3i32 offset;
+	a3_Timer timer[1] = { 0 };
+	GLuint64 elapsed;
+	a3f64 timeSolve, timeGPU, timeLinear, timeDualQuat, diff, error;
+	a3real s;
+
+	if (!jointCount || !vertexCount || !demoMode->skinProgram)
+	{
+		printf("\n\n A3 skinning benchmark: select a skinning method in the forward pipeline first ('r').");
+		return;
+	}
+	if (!glGenQueries || !glBeginQuery || !glGetQueryObjectui64v)
+		return;
+	if (a3skinPaletteRingCreate(ring, demoStateMaxCount_skinCharacterBenchmark * jointCount * a3skin_linear * sizeof(*palette), 2) < 0 || !ring->buffer)
+		return;
+	glGenQueries(1, &query);
+
+	// palettes of both methods for the largest count, then CPU outputs
+	palette = (a3f32(*)[4])malloc(demoStateMaxCount_skinCharacterBenchmark * jointCount * (a3skin_linear + a3skin_dualQuat) * sizeof(*palette) + vertexCount * sizeof(*position) * 3);
+	paletteLinear = palette;
+	paletteDualQuat = paletteLinear + demoStateMaxCount_skinCharacterBenchmark * jointCount * a3skin_linear;
+	position = (a3f32(*)[3])(paletteDualQuat + demoStateMaxCount_skinCharacterBenchmark * jointCount * a3skin_dualQuat);
+	normal = position + vertexCount;
+	positionRef = normal + vertexCount;
+
+	printf("\n\n A3 skinning benchmark (%u vertices, %u joints, %u influences, GPU: %s, %u frames): ",
+		vertexCount, jointCount, a3skin_influenceMax, method == a3skin_dualQuat ? "dual quaternion" : "linear blend", frameCount);
+	printf("\n\t vertex influences: %u bytes packed vs %u as floats and integers",
+		(a3ui32)(sizeof(*demoState->skinIndex) + sizeof(*demoState->skinWeight)), a3skin_influenceMax * (a3ui32)(sizeof(a3f32) + sizeof(a3i32)));
+	printf("\n\t palette per joint: %u bytes linear vs %u bytes dual quaternion",
+		a3skin_linear * (a3ui32)sizeof(*palette), a3skin_dualQuat * (a3ui32)sizeof(*palette));
+
+	for (i = 0; i < characterCountCount; ++i)
+	{
+		// CPU: pose and solve every character with both methods
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		for (c = 0; c < characterCount[i]; ++c)
+		{
+			root.m30 = 2.5f * (a3real)(c % 64);
+			root.m31 = 2.5f * (a3real)(c / 64);
+			for (j = 0; j < jointCount; ++j)
+			{
+				s = a3sinr((a3real)c * 0.9f + (a3real)j * 0.6f);
+				a3real4x4SetRotateZYX(rotate.m, 15.0f * s, a3real_zero, 20.0f * s);
+				a3real4x4ConcatL(a3real4x4SetReal4x4(localPose[j].m, (a3real(*)[4])skeleton->bindLocal[j]), rotate.m);
+			}
+			a3skeletonSolvePalette(skeleton, paletteLinear + c * jointCount * a3skin_linear, *localPose->m, root.mm, a3skin_linear);
+			a3skeletonSolvePalette(skeleton, paletteDualQuat + c * jointCount * a3skin_dualQuat, *localPose->m, root.mm, a3skin_dualQuat);
+		}
+		a3timerUpdate(timer);
+		timeSolve = timer->totalTime;
+
+		// GPU: one ring upload, then every character drawn per frame
+		paletteSize = characterCount[i] * jointCount * method * sizeof(*palette);
+		a3skinPaletteRingBeginFrame(ring);
+		offset = a3skinPaletteRingUpload(ring, method == a3skin_dualQuat ? paletteDualQuat : paletteLinear, paletteSize);
+		a3shaderProgramActivate(demoMode->skinProgram->program);
+		glEnable(GL_RASTERIZER_DISCARD);
+		a3skinPaletteRingRender(ring, demoState->draw_tentacle_skin, offset, paletteSize, jointCount, characterCount[i]);
+		glFinish();
+		glBeginQuery(GL_TIME_ELAPSED, query);
+		for (j = 0; j < frameCount; ++j)
+			a3skinPaletteRingRender(ring, demoState->draw_tentacle_skin, offset, paletteSize, jointCount, characterCount[i]);
+		glEndQuery(GL_TIME_ELAPSED);
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+		glDisable(GL_RASTERIZER_DISCARD);
+		a3skinPaletteRingEndFrame(ring);
+		timeGPU = (a3f64)elapsed * 1.0e-9 / (a3f64)frameCount;
+
+		// CPU reference: every character, once per method
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		for (c = 0; c < characterCount[i]; ++c)
+			a3skinDeform(paletteLinear + c * jointCount * a3skin_linear, a3skin_linear, demoState->skinIndex, demoState->skinWeight,
+				demoState->skinPosition, demoState->skinNormal, positionRef, normal, vertexCount);
+		a3timerUpdate(timer);
+		timeLinear = timer->totalTime;
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		for (c = 0; c < characterCount[i]; ++c)
+			a3skinDeform(paletteDualQuat + c * jointCount * a3skin_dualQuat, a3skin_dualQuat, demoState->skinIndex, demoState->skinWeight,
+				demoState->skinPosition, demoState->skinNormal, position, normal, vertexCount);
+		a3timerUpdate(timer);
+		timeDualQuat = timer->totalTime;
+
+		// last character of both methods
+		for (k = 0, error = 0.0; k < vertexCount * 3; ++k)
+		{
+			diff = (a3f64)(position[k / 3][k % 3] - positionRef[k / 3][k % 3]);
+			if (diff < 0.0)
+				diff = -diff;
+			if (error < diff)
+				error = diff;
+		}
+
+		printf("\n\t %4u characters: solve %8.3lf ms | GPU %8.3lf ms | CPU linear %9.3lf ms, dual quaternion %9.3lf ms (x%6.1lf vs GPU) | linear vs dual quaternion %.3f",
+			characterCount[i], timeSolve * 1000.0, timeGPU * 1000.0, timeLinear * 1000.0, timeDualQuat * 1000.0,
+			(method == a3skin_dualQuat ? timeDualQuat : timeLinear) / timeGPU, error);
+	}
+	printf("\n");
+
+	free(palette);
+	a3skinPaletteRingRelease(ring);
+	glDeleteQueries(1, &query);
+	a3shaderProgramDeactivate();
+#endif	// _WIN32
+}
+
+
+// compare occlusion culling: read the scene depth back, build its pyramid
+//	on the GPU and the CPU and compare them, then test growing sets of
+//	random boxes around the active camera both ways and count where the
+//	two disagree (console output)
+void a3pipelines_benchmarkOcclusion(a3_DemoState const* demoState, a3_Demo_Pipelines const* demoMode)
+{
+#ifdef _WIN32
+	const a3ui32 boxCount[] = { 1024, 4 * 1024, 16 * 1024, demoStateMaxCount_occlusionBenchmark };
+	const a3ui32 boxCountCount = sizeof(boxCount) / sizeof(*boxCount);
+
+	const a3_Framebuffer* fbo = demoMode->pipeline == pipelines_deferredPacked
+		? demoState->fbo_scene_gbuffer_packed : demoState->fbo_scene_c16d24s8_mrt;
+	const a3_DemoProjector* activeCamera = demoState->projector + demoState->activeCamera;
+	const a3real* eye = activeCamera->sceneObject->modelMat.v3.v;
+	const a3ui32 w = fbo->frameWidth, h = fbo->frameHeight;
+	a3_OcclusionCuller culler[1] = { 0 };
+	a3f32* depth, * pyramidCPU, * pyramidGPU, (*boundsMin)[4], (*boundsMax)[4];
+	a3boolean* visibleCPU, * visibleGPU;
+	a3ui32 query, pyramidSize, levelCount, mismatch, i, j;
+	a3i32 countCPU, countGPU;
+	a3_Timer timer[1] = { 0 };
+	GLuint64 elapsed;
+	a3f64 timeGPU, timeCPU, diff, error;
+	a3f32 r;
+
+	if (!glGenQueries || !glBeginQuery || !glGetQueryObjectui64v)
+		return;
+	if (a3occlusionCullerCreate(culler, demoStateMaxCount_occlusionBenchmark, 1) <= 0)
+	{
+		printf("\n\n A3 occlusion benchmark: not supported");
+		return;
+	}
+	a3occlusionCullerBeginFrame(culler, w, h);
+	glGenQueries(1, &query);
+
+	pyramidSize = a3occlusionPyramidSize(w, h, &levelCount);
+	depth = (a3f32*)malloc((w * h + pyramidSize * 2) * sizeof(*depth));
+	pyramidCPU = depth + w * h;
+	pyramidGPU = pyramidCPU + pyramidSize;
+	boundsMin = (a3f32(*)[4])malloc(demoStateMaxCount_occlusionBenchmark * (sizeof(*boundsMin) * 2 + sizeof(*visibleCPU) * 2));
+	boundsMax = boundsMin + demoStateMaxCount_occlusionBenchmark;
+	visibleCPU = (a3boolean*)(boundsMax + demoStateMaxCount_occlusionBenchmark);
+	visibleGPU = visibleCPU + demoStateMaxCount_occlusionBenchmark;
+
+	printf("\n\n A3 occlusion benchmark (%u x %u depth, %u levels, %u texels): ", w, h, levelCount, pyramidSize);
+
+	// pyramid: last frame's scene depth, reduced both ways
+	a3framebufferBindDepthTexture(fbo, a3tex_unit00);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glGetTexImage(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, GL_FLOAT, depth);
+	a3textureDeactivate(a3tex_unit00);
+	glFinish();
+	glBeginQuery(GL_TIME_ELAPSED, query);
+	a3occlusionCullerBuildPyramid(culler, demoState->prog_hizReduce_compute->program, fbo);
+	glEndQuery(GL_TIME_ELAPSED);
+	glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+	timeGPU = (a3f64)elapsed * 1.0e-9;
+	a3timerSet(timer, 0.0);
+	a3timerStart(timer);
+	a3occlusionBuildPyramidReference(pyramidCPU, depth, w, h);
+	a3timerUpdate(timer);
+	timeCPU = timer->totalTime;
+	a3occlusionCullerReadPyramid(culler, pyramidGPU);
+	for (j = 0, error = 0.0; j < pyramidSize; ++j)
+	{
+		diff = (a3f64)(pyramidGPU[j] - pyramidCPU[j]);
+		if (diff < 0.0)
+			diff = -diff;
+		if (error < diff)
+			error = diff;
+	}
+	printf("\n\t pyramid: GPU %8.3lf ms | CPU %8.3lf ms (x%6.1lf) | max error %.2e %s",
+		timeGPU * 1000.0, timeCPU * 1000.0, timeCPU / timeGPU, error, error == 0.0 ? "PASS" : "FAIL");
+
+	// boxes of varied size scattered around the camera
+	a3randomSetSeed(2048);
+	for (j = 0; j < demoStateMaxCount_occlusionBenchmark; ++j)
+	{
+		r = a3randomRange(0.1f, 2.0f);
+		for (i = 0; i < 3; ++i)
+		{
+			boundsMin[j][i] = (a3f32)eye[i] + a3randomRange(-40.0f, +40.0f);
+			boundsMax[j][i] = boundsMin[j][i] + r;
+		}
+		boundsMin[j][3] = boundsMax[j][3] = 1.0f;
+	}
+
+	for (i = 0; i < boxCountCount; ++i)
+	{
+		// GPU: one dispatch, waited on and read back
+		glFinish();
+		glBeginQuery(GL_TIME_ELAPSED, query);
+		a3occlusionCullerTest(culler, demoState->prog_occlusionTest_compute->program,
+			(const a3f32(*)[4])boundsMin, (const a3f32(*)[4])boundsMax, boxCount[i], activeCamera->viewProjectionMat.mm);
+		glEndQuery(GL_TIME_ELAPSED);
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+		timeGPU = (a3f64)elapsed * 1.0e-9;
+		a3occlusionCullerReadback(culler, visibleGPU, boxCount[i], a3true);
+
+		// CPU reference against its own pyramid
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		countCPU = a3occlusionTestReference(visibleCPU, pyramidCPU, w, h,
+			(const a3f32(*)[4])boundsMin, (const a3f32(*)[4])boundsMax, boxCount[i], activeCamera->viewProjectionMat.mm);
+		a3timerUpdate(timer);
+		timeCPU = timer->totalTime;
+
+		// rounding in the projection may flip boxes right on an edge
+		for (j = 0, countGPU = 0, mismatch = 0; j < boxCount[i]; ++j)
+		{
+			countGPU += visibleGPU[j];
+			mismatch += visibleGPU[j] != visibleCPU[j];
+		}
+
+		printf("\n\t %6u boxes: GPU %8.3lf ms | CPU %8.3lf ms (x%6.1lf) | visible %6d / %6d | mismatched %4u %s",
+			boxCount[i], timeGPU * 1000.0, timeCPU * 1000.0, timeCPU / timeGPU,
+			countGPU, countCPU, mismatch, mismatch * 1000 <= boxCount[i] ? "PASS" : "FAIL");
+	}
+	printf("\n");
+
+	free(boundsMin);
+	free(depth);
+	a3occlusionCullerRelease(culler);
+	glDeleteQueries(1, &query);
+	a3shaderProgramDeactivate();
+#endif	// _WIN32
+}
+
+
+
+// compare per-object and batched draws of a repeated model: for each copy
+//	count, a grid of spheres is drawn to depth (rasterizer discarded, so 
+//	only submission and vertex work are timed) once with one draw per copy 
+//	and the plain transform program, then as one group of records from a 
+//	temporary instance buffer with the batch variant; CPU time includes 
+//	writing and uploading the records (console output)
+void a3pipelines_benchmarkInstancing(a3_DemoState const* demoState, a3_Demo_Pipelines const* demoMode)
+{
+#ifdef _WIN32
+	const a3ui32 copyCount[] = { 16, 64, 256, 1024, demoStateMaxCount_instanceBenchmark };
+	const a3ui32 copyCountCount = sizeof(copyCount) / sizeof(*copyCount);
+	enum { frameCount = 60 };
+
+	const a3_DemoProjector* activeCamera = demoState->projector + demoState->activeCamera;
+	const a3_VertexDrawable* drawable = demoState->draw_sphere;
+	const a3_DemoStateShaderProgram* program = demoState->prog_transform;
+	a3_InstanceBuffer buffer[1] = { 0 };
+	a3mat4* record, modelMat = a3mat4_identity, modelViewProjectionMat;
+	a3ui32 query, drawsObject, drawsBatch, i, j, c;
+	a3_Timer timer[1] = { 0 };
+	GLuint64 elapsed;
+	a3f64 timeObjectCPU, timeObjectGPU, timeBatchCPU, timeBatchGPU;
+
+	if (!demoMode->batchDepthProgram)
+	{
+		printf("\n\n A3 instancing benchmark: turn on instance batching first ('f').");
+		return;
+	}
+	if (!glGenQueries || !glBeginQuery || !glGetQueryObjectui64v)
+		return;
+
+	// records for the largest count plus a whole block after the last chunk
+	if (a3instanceBufferCreate(buffer, (demoStateMaxCount_instanceBenchmark + a3instance_countMax) * sizeof(*record)) < 0 || !buffer->buffer)
+		return;
+	glGenQueries(1, &query);
+	record = (a3mat4*)malloc(demoStateMaxCount_instanceBenchmark * sizeof(*record));
+
+	printf("\n\n A3 instancing benchmark (%u vertices per copy, up to %u copies per draw, %u frames): ",
+		drawable->count, a3instance_countMax, frameCount);
+
+	glEnable(GL_RASTERIZER_DISCARD);
+	for (i = 0; i < copyCountCount; ++i)
+	{
+		// per object: one transform uniform and one draw per copy
+		a3shaderProgramActivate(program->program);
+		glFinish();
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		glBeginQuery(GL_TIME_ELAPSED, query);
+		for (j = 0; j < frameCount; ++j)
+			for (c = 0; c < copyCount[i]; ++c)
+			{
+				modelMat.m30 = 2.5f * (a3real)(c % 64);
+				modelMat.m31 = 2.5f * (a3real)(c / 64);
+				a3demo_drawModelSimple_activateModel(modelViewProjectionMat.m, activeCamera->viewProjectionMat.m, modelMat.m, program, drawable);
+			}
+		glEndQuery(GL_TIME_ELAPSED);
+		a3timerUpdate(timer);
+		timeObjectCPU = timer->totalTime / (a3f64)frameCount;
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+		timeObjectGPU = (a3f64)elapsed * 1.0e-9 / (a3f64)frameCount;
+		drawsObject = copyCount[i];
+
+		// batched: every record written and uploaded, then one draw per chunk
+		a3shaderProgramActivate(demoMode->batchDepthProgram->program);
+		glFinish();
+		a3timerSet(timer, 0.0);
+		a3timerStart(timer);
+		glBeginQuery(GL_TIME_ELAPSED, query);
+		for (j = 0, drawsBatch = 0; j < frameCount; ++j)
+		{
+			for (c = 0; c < copyCount[i]; ++c)
+			{
+				modelMat.m30 = 2.5f * (a3real)(c % 64);
+				modelMat.m31 = 2.5f * (a3real)(c / 64);
+				a3real4x4Product(record[c].m, activeCamera->viewProjectionMat.m, modelMat.m);
+			}
+			a3instanceBufferUpload(buffer, record, copyCount[i] * sizeof(*record));
+			drawsBatch = a3instanceBufferRender(buffer, drawable, a3pipelines_instanceBinding, 0, sizeof(*record), copyCount[i]);
+		}
+		glEndQuery(GL_TIME_ELAPSED);
+		a3timerUpdate(timer);
+		timeBatchCPU = timer->totalTime / (a3f64)frameCount;
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+		timeBatchGPU = (a3f64)elapsed * 1.0e-9 / (a3f64)frameCount;
+
+		printf("\n\t %4u copies: per object %4u draws, CPU %8.3lf ms, GPU %8.3lf ms | batched %3u draws, CPU %8.3lf ms (x%6.1lf), GPU %8.3lf ms (x%6.1lf)",
+			copyCount[i], drawsObject, timeObjectCPU * 1000.0, timeObjectGPU * 1000.0,
+			drawsBatch, timeBatchCPU * 1000.0, timeObjectCPU / timeBatchCPU, timeBatchGPU * 1000.0, timeObjectGPU / timeBatchGPU);
+	}
+	glDisable(GL_RASTERIZER_DISCARD);
+	printf("\n");
+
+	free(record);
+	a3instanceBufferRelease(buffer);
+	glDeleteQueries(1, &query);
+	a3shaderProgramDeactivate();
+#endif	// _WIN32
+}
+
+
+// compare bloom paths: run the fragment chain and the compute dispatches on 
+//	the current scene composite, time each on the GPU and read back both 
+//	bloom composites; the compute result must match the fragment result 
+//	within a tolerance per channel (console output)
+//	-> tolerance allows for bright-pass and kernel rounding differences 
+//		between the shader stages, not for a different pass graph
+void a3pipelines_benchmarkBloom(a3_DemoState const* demoState, a3_Demo_Pipelines const* demoMode)
+{
+#ifdef _WIN32
+	enum { runCount = 32 };
+	const a3ui32 toleranceMax = 8, toleranceMean = 1;
+	const a3vec2 sampleAxisH = { +a3real_one, +a3real_one };
+	const a3vec2 sampleAxisV = { +a3real_one, -a3real_one };
+
+	// same targets as render
+	const a3_Framebuffer* writeFBO[pipelines_pass_max] = { 0 };
+	const a3_Framebuffer* readFBO[pipelines_pass_max][4] = { { 0 } };
+	const a3_Framebuffer* fbo;
+
+	a3ubyte* pixels[2];
+	a3ui32 query, i, j, count, diff, diffMax;
+	GLuint64 elapsed;
+	a3f64 timeFragment, timeCompute, diffMean;
+	a3ret dispatched;
+
+	for (i = pipelines_passComposite; i < pipelines_pass_max; ++i)
+		writeFBO[i] = demoMode->transientFBO[i];
+	// each bloom pass reads the one before it; bright pass reads composite
+	for (i = pipelines_passBright_2; i < pipelines_passBlend; ++i)
+		readFBO[i][0] = writeFBO[i - 1];
+	readFBO[pipelines_passBlend][0] = writeFBO[pipelines_passBlurV_8];
+	readFBO[pipelines_passBlend][1] = writeFBO[pipelines_passBlurV_4];
+	readFBO[pipelines_passBlend][2] = writeFBO[pipelines_passBlurV_2];
+	readFBO[pipelines_passBlend][3] = writeFBO[pipelines_passComposite];
+	fbo = writeFBO[pipelines_passBlend];
+	if (!fbo || !readFBO[pipelines_passBright_2][0])
+		return;
+	if (!glGenQueries || !glBeginQuery || !glGetQueryObjectui64v)
+		return;
+	glGenQueries(1, &query);
+	count = fbo->frameWidth * fbo->frameHeight * 4;
+	pixels[0] = (a3ubyte*)malloc(count * 2);
+	pixels[1] = pixels[0] + count;
+
+	printf("\n\n A3 bloom benchmark (%u x %u, %u runs): ", fbo->frameWidth, fbo->frameHeight, runCount);
+	glDisable(GL_BLEND);
+	a3vertexDrawableActivate(demoState->draw_unitquad);
+
+	// fragment passes
+	a3pipelines_renderBloomFragment_internal(demoState, writeFBO, readFBO, sampleAxisH, sampleAxisV);
+	glFinish();
+	glBeginQuery(GL_TIME_ELAPSED, query);
+	for (j = 0; j < runCount; ++j)
+		a3pipelines_renderBloomFragment_internal(demoState, writeFBO, readFBO, sampleAxisH, sampleAxisV);
+	glEndQuery(GL_TIME_ELAPSED);
+	glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+	timeFragment = (a3f64)elapsed * 1.0e-9 / (a3f64)runCount;
+	a3framebufferActivate(fbo);
+	glReadBuffer(GL_COLOR_ATTACHMENT0);
+	glReadPixels(0, 0, fbo->frameWidth, fbo->frameHeight, GL_RGBA, GL_UNSIGNED_BYTE, pixels[0]);
+	printf("\n\t fragment passes:    %8.3lf ms", timeFragment * 1000.0);
+
+	// compute dispatches
+	dispatched = a3pipelines_renderBloomCompute_internal(demoState, writeFBO, readFBO, sampleAxisH, sampleAxisV);
+	if (dispatched)
+	{
+		glFinish();
+		glBeginQuery(GL_TIME_ELAPSED, query);
+		for (j = 0; j < runCount; ++j)
+			a3pipelines_renderBloomCompute_internal(demoState, writeFBO, readFBO, sampleAxisH, sampleAxisV);
+		glEndQuery(GL_TIME_ELAPSED);
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+		timeCompute = (a3f64)elapsed * 1.0e-9 / (a3f64)runCount;
+		a3framebufferActivate(fbo);
+		glReadBuffer(GL_COLOR_ATTACHMENT0);
+		glReadPixels(0, 0, fbo->frameWidth, fbo->frameHeight, GL_RGBA, GL_UNSIGNED_BYTE, pixels[1]);
+
+		// per-channel difference of the bloom composites
+		for (j = 0, diffMax = 0, diffMean = 0.0; j < count; ++j)
+		{
+			diff = pixels[0][j] > pixels[1][j] ? pixels[0][j] - pixels[1][j] : pixels[1][j] - pixels[0][j];
+			if (diffMax < diff)
+				diffMax = diff;
+			diffMean += (a3f64)diff;
+		}
+		diffMean /= (a3f64)count;
+		printf("\n\t compute dispatches: %8.3lf ms (x%6.2lf) | difference max %u, mean %.3lf / 255 (tolerance %u, %u) %s",
+			timeCompute * 1000.0, timeFragment / timeCompute, diffMax, diffMean, toleranceMax, toleranceMean,
+			diffMax <= toleranceMax && diffMean <= (a3f64)toleranceMean ? "PASS" : "FAIL");
+	}
+	else
+		printf("\n\t compute dispatches: unavailable");
+	printf("\n");
+
+	// done; bloom targets are rewritten next frame
+	free(pixels[0]);
+	glDeleteQueries(1, &query);
+	a3shaderProgramDeactivate();
+	a3vertexDrawableDeactivate();
+	a3framebufferDeactivate();
+#endif	// _WIN32
+}
+
+
 //-----------------------------------------------------------------------------
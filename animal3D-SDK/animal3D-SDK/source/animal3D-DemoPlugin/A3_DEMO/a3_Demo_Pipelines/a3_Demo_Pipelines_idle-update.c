@@ -41,11 +41,20 @@
 
 void a3pipelines_update(a3_DemoState* demoState, a3_Demo_Pipelines* demoMode, a3f64 dt)
 {
-	a3ui32 i;
+	a3ui32 i, k;
 
 	a3mat4* lightMVPptr, * lightMVPBptr;
 	a3ui32 tmpLightCount;
 
+	// light culling and assignment
+	a3f32 cullPlane[6][4];
+	a3ui32 lightCandidate[demoStateMaxCount_lightVolume];
+	a3ret found;
+
+	// occlusion culling
+	a3_OcclusionCuller* occlusionCuller = demoState->occlusionCuller;
+	a3f32 boundsMin[demoStateMaxCount_sceneObject][4], boundsMax[demoStateMaxCount_sceneObject][4];
+
 	a3_DemoPointLight* pointLight;
 
 	// bias matrix
@@ -61,18 +70,125 @@ void a3pipelines_update(a3_DemoState* demoState, a3_Demo_Pipelines* demoMode, a3
 	a3_DemoSceneObject* activeCameraObject = activeCamera->sceneObject;
 
 
+	// fit shadow cascades to the scene camera, not the active one, so 
+	//	the atlas can be inspected from the light's point of view
+	a3demo_updateProjectorShadowCascades(demoState->shadowLight, demoState->sceneCamera,
+		a3demo_shadowCascadeMax, 200.0f, 0.75f, demoState->fbo_shadowCascade_d32->frameWidth / a3demo_shadowCascadeAtlasTiles);
+
+	// forward cascade shading uses a variant with shadows and all eight 
+	//	targets; it is only compiled the first time it is selected
+	demoMode->cascadeProgram = (demoMode->pipeline == pipelines_forward && demoMode->render == pipelines_renderPhongCascade)
+		? a3demo_shaderVariantRequest(demoState->shaderVariantCache, demoStateShaderVariant_drawPhong_multi,
+			a3demo_shaderFeatures(a3demo_shaderFeatureShadow, 8, demoStateMaxCount_lightObject))
+		: 0;
+
+	// instance batching: depth passes take transforms from records in any 
+	//	mode; scene models only in the modes whose shaders have a record 
+	//	variant (cascade forward and packed g-buffers)
+	demoMode->batchDepthProgram = demoMode->batchSceneProgram = 0;
+	if (demoMode->instancing && demoState->instanceBuffer->buffer &&
+		demoState->instanceBuffer->alignment <= demoStateMaxCount_instanceAlignment)
+	{
+		demoMode->batchDepthProgram = a3demo_shaderVariantRequest(demoState->shaderVariantCache, demoStateShaderVariant_transform,
+			a3demo_shaderFeatures(a3demo_shaderFeatureInstanced, 0, 0));
+		if (demoMode->pipeline == pipelines_deferredPacked)
+			demoMode->batchSceneProgram = a3demo_shaderVariantRequest(demoState->shaderVariantCache, demoStateShaderVariant_drawGBuffer_packed,
+				a3demo_shaderFeatures(a3demo_shaderFeatureInstanced, 0, 0));
+		else if (demoMode->render == pipelines_renderPhongCascade)
+			demoMode->batchSceneProgram = a3demo_shaderVariantRequest(demoState->shaderVariantCache, demoStateShaderVariant_drawPhong_multi,
+				a3demo_shaderFeatures(a3demo_shaderFeatureInstanced | a3demo_shaderFeatureShadow, 8, demoStateMaxCount_lightObject));
+	}
+
+	// advance particles on the GPU; only the forward pipeline draws them, 
+	//	and nothing is read back, so this does not stall
+	if (demoMode->particles && demoMode->pipeline == pipelines_forward && dt > 0.0)
+		a3particleSystemUpdate(demoState->particleSystem,
+			demoState->prog_particleSimulate_compute->program, demoState->prog_particleEmit_compute->program,
+			demoState->prog_particleFinalize_compute->program, demoState->particleEmitter, (a3f32)dt);
+
+	// morph weights: each teapot sweeps through the targets out of phase
+	//	with its neighbours, so at most two targets are active at once
+	if (demoMode->morphTargets && demoMode->pipeline == pipelines_forward && demoState->morphTargets->targetCount)
+	{
+		const a3ui32 targetCount = demoState->morphTargets->targetCount;
+		const a3real phase = (a3real)demoState->renderTimer->totalTime * a3real_half;
+		a3real w;
+		a3ui32 j;
+		for (i = 0; i < demoStateMaxCount_morphInstance; ++i)
+			for (j = 0; j < targetCount; ++j)
+			{
+				w = a3sinr(phase + (a3real)i * 0.75f - (a3real)j * a3real_twopi / (a3real)targetCount);
+				demoState->morphWeight[i * targetCount + j] = (a3f32)(w > a3real_zero ? w : a3real_zero);
+			}
+		a3morphTargetsUpdateWeights(demoState->morphTargets, demoState->morphWeight, demoStateMaxCount_morphInstance);
+	}
+
+	// skinned tentacles: every joint bends and twists out of phase with 
+	//	its neighbours and with the other characters; the root of each 
+	//	character places it on a grid, so all palettes go to this frame's 
+	//	ring segment together and are drawn with one instanced call
+	//	-> twist is what collapses linear blending and not dual quaternions
+	demoMode->skinProgram = 0;
+	demoState->skinPaletteOffset = -1;
+	if (demoMode->skinning && demoMode->pipeline == pipelines_forward && demoState->skeleton->jointCount && demoState->skinPaletteRing->buffer)
+	{
+		const a3_SkinningMethod method = demoMode->skinning == pipelines_skinDualQuat ? a3skin_dualQuat : a3skin_linear;
+		const a3ui32 jointCount = demoState->skeleton->jointCount;
+		const a3real phase = (a3real)demoState->renderTimer->totalTime * a3real_two;
+		const a3real skinSpacing = 2.5f, skinBend = 15.0f, skinTwist = 20.0f;
+		const a3vec2 skinCenter = { -8.0f, +8.0f };
+		a3mat4 localPose[a3skin_jointMax], root = a3mat4_identity, rotate;
+		a3real s;
+		a3ui32 j;
+
+		demoMode->skinProgram = a3demo_shaderVariantRequest(demoState->shaderVariantCache, demoStateShaderVariant_drawPhong_skin,
+			a3demo_shaderFeatures(method == a3skin_dualQuat ? a3demo_shaderFeatureDualQuat : 0, 0, 0));
+		for (i = 0; i < demoStateMaxCount_skinCharacter; ++i)
+		{
+			root.m30 = skinCenter.x + skinSpacing * ((a3real)(i % 4) - 1.5f);
+			root.m31 = skinCenter.y + skinSpacing * ((a3real)(i / 4) - 1.5f);
+			for (j = 0; j < jointCount; ++j)
+			{
+				s = a3sinr(phase + (a3real)i * 0.9f + (a3real)j * 0.6f);
+				a3real4x4SetRotateZYX(rotate.m, skinBend * s, a3real_zero, skinTwist * s);
+				a3real4x4ConcatL(a3real4x4SetReal4x4(localPose[j].m, (a3real(*)[4])demoState->skeleton->bindLocal[j]), rotate.m);
+			}
+			a3skeletonSolvePalette(demoState->skeleton, demoState->skinPalette + i * jointCount * method, *localPose->m, root.mm, method);
+		}
+		demoState->skinPaletteSize = demoStateMaxCount_skinCharacter * jointCount * method * sizeof(*demoState->skinPalette);
+		a3skinPaletteRingBeginFrame(demoState->skinPaletteRing);
+		demoState->skinPaletteOffset = a3skinPaletteRingUpload(demoState->skinPaletteRing, demoState->skinPalette, demoState->skinPaletteSize);
+	}
+
+
 	// send point light data
 	pointLight = demoState->forwardPointLight;
 	a3bufferRefill(demoState->ubo_pointLight, 0, demoState->forwardLightCount * sizeof(a3_DemoPointLight), pointLight);
 
 
+	// deferred lights: the hierarchy covers the active ones, so it is 
+	//	rebuilt whenever the count changes; only lights the camera can see 
+	//	get transforms, each at its own index
+	demoState->deferredLightVisibleCount = 0;
+	if (demoState->deferredLightCount)
+	{
+		if (demoState->lightBVH->itemCount != demoState->deferredLightCount)
+			a3demo_bvhBuild(demoState->lightBVH, (const a3f32(*)[4])demoState->deferredLightBoundsMin,
+				(const a3f32(*)[4])demoState->deferredLightBoundsMax, demoState->deferredLightCount);
+		a3demo_bvhFrustumPlanes(cullPlane, activeCamera->viewProjectionMat.m);
+		found = a3demo_bvhQueryFrustum(demoState->lightBVH, demoState->deferredLightVisible, demoStateMaxCount_lightVolume,
+			(const a3f32(*)[4])cullPlane, 6);
+		demoState->deferredLightVisibleCount = found > 0 ? found : 0;
+	}
+
 	// update lights
-	for (i = 0, pointLight = demoState->deferredPointLight + i,
-		lightMVPptr = demoState->deferredLightMVP + i,
-		lightMVPBptr = demoState->deferredLightMVPB + i;
-		i < demoState->deferredLightCount;
-		++i, ++pointLight, ++lightMVPptr, ++lightMVPBptr)
+	for (i = 0; i < demoState->deferredLightVisibleCount; ++i)
 	{
+		k = demoState->deferredLightVisible[i];
+		pointLight = demoState->deferredPointLight + k;
+		lightMVPptr = demoState->deferredLightMVP + k;
+		lightMVPBptr = demoState->deferredLightMVPB + k;
+
 		// set light scale and world position
 		a3real4x4SetScale(lightMVPptr->m, pointLight->radius);
 		lightMVPptr->v3 = pointLight->worldPos;
@@ -88,6 +204,59 @@ void a3pipelines_update(a3_DemoState* demoState, a3_Demo_Pipelines* demoMode, a3
 		a3real4x4Product(lightMVPBptr->m, bias.m, lightMVPptr->m);
 	}
 
+	// lights touching each scene object: lights whose boxes overlap the 
+	//	object's sphere, kept if the spheres themselves overlap
+	for (i = 0; i < demoStateMaxCount_sceneObject; ++i)
+	{
+		const a3f32* sphere = demoState->sceneObjectSphere[i];
+		a3ui32* objectLight = demoState->sceneObjectLight[i];
+		a3f32 dx, dy, dz, r;
+		demoState->sceneObjectLightCount[i] = 0;
+		if (!demoState->deferredLightCount || sphere[3] <= 0.0f)
+			continue;
+		found = a3demo_bvhQuerySphere(demoState->lightBVH, lightCandidate, demoStateMaxCount_lightVolume, sphere, sphere[3]);
+		for (k = 0; k < (a3ui32)(found > 0 ? found : 0); ++k)
+		{
+			pointLight = demoState->deferredPointLight + lightCandidate[k];
+			dx = (a3f32)pointLight->worldPos.x - sphere[0];
+			dy = (a3f32)pointLight->worldPos.y - sphere[1];
+			dz = (a3f32)pointLight->worldPos.z - sphere[2];
+			r = (a3f32)pointLight->radius + sphere[3];
+			if (dx * dx + dy * dy + dz * dz <= r * r)
+			{
+				if (demoState->sceneObjectLightCount[i] < demoStateMaxCount_sceneObjectLight)
+					objectLight[demoState->sceneObjectLightCount[i]] = lightCandidate[k];
+				++demoState->sceneObjectLightCount[i];
+			}
+		}
+	}
+
+	// occlusion: take the newest finished test without waiting (flags 
+	//	stay as they were until one is), then test this frame's bounds 
+	//	from this frame's camera against the depth of the last frame, 
+	//	whose pyramid render built after the scene pass
+	if (demoMode->occlusion && occlusionCuller->bounds)
+	{
+		const a3_Framebuffer* sceneFBO = demoMode->pipeline == pipelines_deferredPacked
+			? demoState->fbo_scene_gbuffer_packed : demoState->fbo_scene_c16d24s8_mrt;
+		a3occlusionCullerReadback(occlusionCuller, demoState->sceneObjectUnoccluded, demoStateMaxCount_sceneObject, a3false);
+		if (a3occlusionCullerBeginFrame(occlusionCuller, sceneFBO->frameWidth, sceneFBO->frameHeight) > 0)
+		{
+			for (i = 0; i < demoStateMaxCount_sceneObject; ++i)
+				a3demo_bvhSphereBounds(boundsMin[i], boundsMax[i], demoState->sceneObjectSphere[i], demoState->sceneObjectSphere[i][3]);
+			a3occlusionCullerTest(occlusionCuller, demoState->prog_occlusionTest_compute->program,
+				(const a3f32(*)[4])boundsMin, (const a3f32(*)[4])boundsMax, demoStateMaxCount_sceneObject, activeCamera->viewProjectionMat.mm);
+		}
+	}
+	else
+	{
+		// pyramid is no longer built, so tests would be stale when enabled
+		if (occlusionCuller->bounds)
+			a3occlusionCullerReset(occlusionCuller);
+		for (i = 0; i < demoStateMaxCount_sceneObject; ++i)
+			demoState->sceneObjectUnoccluded[i] = a3true;
+	}
+
 	
 	// upload buffer data
 	tmpLightCount = demoState->deferredLightCount;
@@ -118,4 +287,54 @@ void a3pipelines_update(a3_DemoState* demoState, a3_Demo_Pipelines* demoMode, a3
 }
 
 
+
+// acquire composite and post-processing targets for this frame; each is 
+//	returned to the pool after its last reader so later passes can alias it
+//	-> bright pass lives until its horizontal blur reads it; fragment and 
+//		compute bloom run the same pass graph
+//	-> vertical blur lives until the bloom composite reads it
+//	-> light pre-pass is unused; displayed pass is held for display
+//	-> every pass gets a target so that switching bloom or display in 
+//		input before rendering never finds a missing one
+void a3pipelines_updateFramebuffers(a3_DemoState* demoState, a3_Demo_Pipelines* demoMode)
+{
+	a3_FramebufferPoolRequest request[pipelines_pass_max] = { 0 };
+	a3ui32 const sizeRequested = demoState->framebufferPool->sizeRequested;
+	a3ui32 i, j;
+
+	// storage precision and targets
+	const a3_FramebufferColorType colorType_composite = a3fbo_colorRGBA8;//a3fbo_colorRGBA16;
+	const a3ui32 targets_composite = 8;
+
+	const a3_FramebufferColorType colorType_post = colorType_composite;
+	const a3ui32 targets_post = 2;
+
+	// composite and bloom composite, full size
+	request[pipelines_passComposite].colorTargets = request[pipelines_passBlend].colorTargets = targets_composite;
+	request[pipelines_passComposite].colorType = request[pipelines_passBlend].colorType = colorType_composite;
+	request[pipelines_passComposite].frameWidth = request[pipelines_passBlend].frameWidth = demoState->frameWidth;
+	request[pipelines_passComposite].frameHeight = request[pipelines_passBlend].frameHeight = demoState->frameHeight;
+	request[pipelines_passComposite].lastUse = pipelines_passBlend;
+	request[pipelines_passBlend].lastUse = -1;
+
+	// bloom levels, half size per level
+	for (i = pipelines_passBright_2, j = 2; i < pipelines_passBlend; i += 3, j *= 2)
+	{
+		request[i + 0].colorTargets = request[i + 1].colorTargets = request[i + 2].colorTargets = targets_post;
+		request[i + 0].colorType = request[i + 1].colorType = request[i + 2].colorType = colorType_post;
+		request[i + 0].frameWidth = request[i + 1].frameWidth = request[i + 2].frameWidth = demoState->frameWidth / j;
+		request[i + 0].frameHeight = request[i + 1].frameHeight = request[i + 2].frameHeight = demoState->frameHeight / j;
+		request[i + 0].lastUse = i + 1;
+		request[i + 1].lastUse = i + 2;
+		request[i + 2].lastUse = pipelines_passBlend;
+	}
+
+	// hold displayed target
+	request[demoMode->pass].lastUse = -1;
+
+	a3framebufferPoolAcquireSequence(demoState->framebufferPool, demoMode->transientFBO, request, pipelines_pass_max, "fbo:post");
+	demoMode->transientSize = demoState->framebufferPool->sizeRequested - sizeRequested;
+}
+
+
 //-----------------------------------------------------------------------------
@@ -43,6 +43,13 @@ void a3pipelines_init(a3_DemoState const* demoState, a3_Demo_Pipelines* demoMode
 	demoMode->activeCamera = pipelines_cameraSceneViewer;
 
 	demoMode->pipeline = pipelines_forward;
+	demoMode->bloom = pipelines_bloomFragment;
+	demoMode->particles = 1;
+	demoMode->morphTargets = 1;
+	demoMode->skinning = pipelines_skinLinear;
+	demoMode->depthPrepass = 0;
+	demoMode->occlusion = 1;
+	demoMode->instancing = 1;
 	demoMode->pass = pipelines_passScene;
 
 	demoMode->targetIndex[pipelines_passShadow] = pipelines_shadow_fragdepth;